@@ -0,0 +1,172 @@
+/****************************************************************************************************
+* @file     Adc.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the ADC driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           sampling one analog input per ADC instance, continuously or on a hardware trigger,
+*           with calibration and hardware averaging. Every result is moved by DMA into a circular
+*           RAM buffer that the application reads without interrupts or locks.
+* @version  1.0.0
+* @date     2024-11-03
+* @note     Use one instance per signal, e.g. ADC0 for the ambient light sensor and ADC1 for the
+*           supply divider.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef ADC_H
+#define ADC_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Adc_Registers.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define ADC_CAL_WAIT_LOOPS                  (200000u)          /* Calibration timeout */
+#define ADC_BUFFER_MAX                      (0x7FFFu)          /* Largest DMA major loop */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     ADC Return Status Type
+ */
+typedef enum
+{
+			ADC_OK              = 0U,       /**< Operation completed successfully. */
+			ADC_ERR_PARA        = 1U,       /**< Parameter error */
+			ADC_ERR_TIMEOUT     = 2U,       /**< Calibration did not complete */
+} Adc_ret_t;
+
+/**
+ * @brief     Conversion resolution.
+ */
+typedef enum
+{
+			ADC_RESOLUTION_8BIT  = 0U,      /**< 8-bit conversion */
+			ADC_RESOLUTION_12BIT = 1U,      /**< 12-bit conversion */
+			ADC_RESOLUTION_10BIT = 2U,      /**< 10-bit conversion */
+} Adc_resolution_t;
+
+/**
+ * @brief     Hardware averaging.
+ */
+typedef enum
+{
+			ADC_AVERAGE_NONE    = 0U,       /**< One sample per result */
+			ADC_AVERAGE_4       = 1U,       /**< 4 samples per result */
+			ADC_AVERAGE_8       = 2U,       /**< 8 samples per result */
+			ADC_AVERAGE_16      = 3U,       /**< 16 samples per result */
+			ADC_AVERAGE_32      = 4U,       /**< 32 samples per result */
+} Adc_average_t;
+
+/**
+ * @brief     Conversion start.
+ */
+typedef enum
+{
+			ADC_TRIGGER_CONTINUOUS = 0U,    /**< Software start, back-to-back conversions */
+			ADC_TRIGGER_PDB        = 1U,    /**< Hardware trigger from the PDB */
+			ADC_TRIGGER_TRGMUX     = 2U,    /**< Hardware trigger routed by TRGMUX (LPIT, LPTMR) */
+} Adc_trigger_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for an ADC instance.
+ */
+typedef struct
+{
+			unsigned char                   instance;       /*!< ADC instance (0-1) */
+			peripheral_clock_source_t       clkSrc;         /*!< PCC functional clock source */
+			unsigned char                   clockDivider;   /*!< Divide-by-2^clockDivider (0-3) */
+			Adc_resolution_t                resolution;     /*!< Conversion resolution */
+			unsigned char                   sampleTime;     /*!< Sample phase of sampleTime + 1 ADC clocks */
+			Adc_average_t                   average;        /*!< Hardware averaging */
+			Adc_trigger_t                   trigger;        /*!< Conversion start */
+			unsigned char                   trgmuxSource;   /*!< TRGMUX_SOURCE_xxx, with ADC_TRIGGER_TRGMUX */
+			unsigned char                   input;          /*!< Analog input channel (ADCH) */
+			unsigned char                   calibrate;      /*!< Run the calibration in Adc_Init() */
+			unsigned char                   dmaChannel;     /*!< DMA channel moving the results */
+			volatile unsigned short *       buffer;         /*!< Circular result buffer */
+			unsigned short                  bufferLength;   /*!< Results in the buffer (2 to ADC_BUFFER_MAX) */
+} Adc_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes an ADC instance and its DMA channel.
+ *
+ * @param[in] ConfigPtr Pointer to the ADC configuration structure.
+ * @return ADC_OK on success, ADC_ERR_PARA or ADC_ERR_TIMEOUT on error.
+ * @note Conversions start with Adc_Start().
+ */
+Adc_ret_t Adc_Init(const Adc_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Stops an ADC instance and releases its clock.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return void.
+ */
+void Adc_Deinit(unsigned char instance);
+
+/*!
+ * @brief Calibrates an ADC instance.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return ADC_OK on success, ADC_ERR_PARA or ADC_ERR_TIMEOUT on error.
+ * @note Conversions must be stopped.
+ */
+Adc_ret_t Adc_Calibrate(unsigned char instance);
+
+/*!
+ * @brief Starts the conversions, or arms the input for hardware triggers.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return ADC_OK on success, ADC_ERR_PARA on parameter error.
+ */
+Adc_ret_t Adc_Start(unsigned char instance);
+
+/*!
+ * @brief Stops the conversions.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return void.
+ */
+void Adc_Stop(unsigned char instance);
+
+/*!
+ * @brief Gets the number of results not read yet.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return Unread results.
+ * @note The reader must keep up: after bufferLength results the old ones are overwritten.
+ */
+unsigned short Adc_GetAvailable(unsigned char instance);
+
+/*!
+ * @brief Reads results from the circular buffer.
+ *
+ * Only the read position is written here and only the DMA writes the results, so no lock
+ * is needed. Call from one context only.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @param[out] DataPtr Destination of the results.
+ * @param[in] maxCount Largest number of results to read.
+ * @return Number of results read.
+ */
+unsigned short Adc_Read(unsigned char instance, unsigned short * DataPtr, unsigned short maxCount);
+
+#endif  /* ADC_H */
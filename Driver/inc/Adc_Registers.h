@@ -0,0 +1,98 @@
+/****************************************************************************************************
+* @file     Adc_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for ADC peripheral registers.
+* @details  This header file contains the definitions and structures for the 12-bit SAR Analog-to-
+*           Digital Converters (ADC0, ADC1) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-03
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef ADC_REG_H
+#define ADC_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral ADC base addresses ***/
+#define ADC0_BASE_ADDRESS                   (0x4003B000u)
+#define ADC1_BASE_ADDRESS                   (0x40027000u)
+
+/*** Sizes ***/
+#define ADC_INSTANCE_COUNT                  (2u)
+#define ADC_SC1_COUNT                       (16u)
+
+/*** SC1 - Status and Control Register 1 ***/
+#define ADC_SC1_ADCH_SHIFT                  (0u)               /* Input channel select */
+#define ADC_SC1_ADCH_MASK                   (0x3Fu)
+#define ADC_SC1_ADCH_DISABLED               (0x3Fu)            /* Module disabled */
+#define ADC_SC1_AIEN_SHIFT                  (6u)               /* Interrupt enable */
+#define ADC_SC1_COCO_SHIFT                  (7u)               /* Conversion complete flag */
+
+/*** CFG1 - Configuration Register 1 ***/
+#define ADC_CFG1_ADICLK_SHIFT               (0u)               /* Input clock select (ALTCLK1 = PCC clock) */
+#define ADC_CFG1_MODE_SHIFT                 (2u)               /* Conversion mode selection */
+#define ADC_CFG1_ADIV_SHIFT                 (5u)               /* Clock divide select */
+
+/*** CFG2 - Configuration Register 2 ***/
+#define ADC_CFG2_SMPLTS_SHIFT               (0u)               /* Sample time select, SMPLTS + 1 cycles */
+
+/*** SC2 - Status and Control Register 2 ***/
+#define ADC_SC2_REFSEL_SHIFT                (0u)               /* Voltage reference selection */
+#define ADC_SC2_DMAEN_SHIFT                 (2u)               /* DMA enable */
+#define ADC_SC2_ADTRG_SHIFT                 (6u)               /* Conversion trigger select */
+#define ADC_SC2_ADACT_SHIFT                 (7u)               /* Conversion active */
+
+/*** SC3 - Status and Control Register 3 ***/
+#define ADC_SC3_AVGS_SHIFT                  (0u)               /* Hardware average select */
+#define ADC_SC3_AVGE_SHIFT                  (2u)               /* Hardware average enable */
+#define ADC_SC3_ADCO_SHIFT                  (3u)               /* Continuous conversion enable */
+#define ADC_SC3_CAL_SHIFT                   (7u)               /* Calibration */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief ADC Register Structure.
+ *
+ * This structure represents the ADC registers up to the calibration values.
+ */
+typedef struct {
+			volatile unsigned int SC1[ADC_SC1_COUNT];   /**< Status and Control Registers 1, Address offset: 0x0 */
+			volatile unsigned int CFG1;         /**< Configuration Register 1, Address offset: 0x40 */
+			volatile unsigned int CFG2;         /**< Configuration Register 2, Address offset: 0x44 */
+			volatile unsigned int R[ADC_SC1_COUNT];     /**< Data Result Registers, Address offset: 0x48 */
+			volatile unsigned int CV1;          /**< Compare Value Register 1, Address offset: 0x88 */
+			volatile unsigned int CV2;          /**< Compare Value Register 2, Address offset: 0x8C */
+			volatile unsigned int SC2;          /**< Status and Control Register 2, Address offset: 0x90 */
+			volatile unsigned int SC3;          /**< Status and Control Register 3, Address offset: 0x94 */
+			volatile unsigned int BASE_OFS;     /**< BASE Offset Register, Address offset: 0x98 */
+			volatile unsigned int OFS;          /**< Offset Correction Value Register, Address offset: 0x9C */
+			volatile unsigned int USR_OFS;      /**< USER Offset Correction Register, Address offset: 0xA0 */
+			volatile unsigned int XOFS;         /**< ADC X Offset Correction Register, Address offset: 0xA4 */
+			volatile unsigned int YOFS;         /**< ADC Y Offset Correction Register, Address offset: 0xA8 */
+			volatile unsigned int G;            /**< ADC Gain Register, Address offset: 0xAC */
+			volatile unsigned int UG;           /**< ADC User Gain Register, Address offset: 0xB0 */
+			volatile unsigned int CLPS;         /**< ADC General Calibration Value Register S, Address offset: 0xB4 */
+			volatile unsigned int CLP3;         /**< ADC Plus-Side General Calibration Value Register 3, Address offset: 0xB8 */
+			volatile unsigned int CLP2;         /**< ADC Plus-Side General Calibration Value Register 2, Address offset: 0xBC */
+			volatile unsigned int CLP1;         /**< ADC Plus-Side General Calibration Value Register 1, Address offset: 0xC0 */
+			volatile unsigned int CLP0;         /**< ADC Plus-Side General Calibration Value Register 0, Address offset: 0xC4 */
+			volatile unsigned int CLPX;         /**< ADC Plus-Side General Calibration Value Register X, Address offset: 0xC8 */
+			volatile unsigned int CLP9;         /**< ADC Plus-Side General Calibration Value Register 9, Address offset: 0xCC */
+} ADC_Type;
+
+/** Peripheral ADC base pointers */
+#define ADC0 ((ADC_Type *)ADC0_BASE_ADDRESS)
+#define ADC1 ((ADC_Type *)ADC1_BASE_ADDRESS)
+
+#endif  /* ADC_REG_H */
@@ -0,0 +1,241 @@
+/****************************************************************************************************
+* @file     Can.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the FlexCAN driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           classic CAN on CAN0 - CAN2. Frames are received in message buffers with one filter
+*           each, or in the 6-frame Rx FIFO with up to 8 filters, and transmitted from a pool of
+*           message buffers. Every received and transmitted frame carries the value of the 16-bit
+*           free-running timer, which counts bit times and is captured by the hardware at the
+*           identifier field, so the moment a frame was on the bus is known independently of the
+*           interrupt latency. Loopback mode receives the own frames without a transceiver.
+*           With CAN_HOST defined the same interface is implemented by Can_Host.c on a simulated
+*           bus.
+* @version  1.0.0
+* @date     2024-11-14
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CAN_H
+#define CAN_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Message buffer plan, MAXMB = 15 ***/
+#define CAN_RX_MB_FIRST                     (8u)               /* Receive message buffers, one per filter */
+#define CAN_RX_MB_COUNT                     (4u)
+#define CAN_TX_MB_FIRST                     (12u)              /* Transmit message buffers */
+#define CAN_TX_MB_COUNT                     (4u)
+#define CAN_MB_LAST                         (CAN_TX_MB_FIRST + CAN_TX_MB_COUNT - 1u)
+
+/*** Bit timing ***/
+#define CAN_TQ_MAX                          (16u)              /* Time quanta per bit, tried downwards */
+#define CAN_TQ_MIN                          (8u)
+#define CAN_FREEZE_WAIT_LOOPS               (100000u)          /* Freeze and low power acknowledge timeout */
+#define CAN_TIMER_MASK                      (0xFFFFu)          /* Free-running timer width */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     CAN Return Status Type
+ */
+typedef enum
+{
+			CAN_OK              = 0U,       /**< Operation completed successfully. */
+			CAN_ERR_PARA        = 1U,       /**< Parameter error */
+			CAN_ERR_BITRATE     = 2U,       /**< Bit rate not reachable from the protocol engine clock */
+			CAN_ERR_TIMEOUT     = 3U,       /**< Freeze mode or module enable not acknowledged */
+			CAN_ERR_BUSY        = 4U,       /**< Every transmit message buffer is in use */
+} Can_ret_t;
+
+/**
+ * @brief     Protocol engine clock.
+ */
+typedef enum
+{
+			CAN_CLK_SOSCDIV2    = 0U,       /**< Oscillator, SOSCDIV2_CLK: lowest jitter */
+			CAN_CLK_SYS         = 1U,       /**< System clock */
+} Can_clock_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   CAN frame.
+ */
+typedef struct
+{
+			unsigned int            id;             /*!< Standard (11-bit) or extended (29-bit) identifier */
+			unsigned short          timestamp;      /*!< Free-running timer at the identifier field, received frames */
+			unsigned char           extended;       /*!< Extended identifier */
+			unsigned char           length;         /*!< Data length, 0 - 8 */
+			unsigned char           data[8];        /*!< Data */
+} Can_FrameType;
+
+/**
+ * @brief   Acceptance filter.
+ * @details A frame is accepted when (frame id & mask) == (id & mask) and the format matches.
+ */
+typedef struct
+{
+			unsigned int            id;             /*!< Identifier */
+			unsigned int            mask;           /*!< Identifier bits that must match */
+			unsigned char           extended;       /*!< Extended identifier */
+} Can_FilterType;
+
+/**
+ * @brief   Receive callback.
+ * @details Called from the interrupt for every accepted frame.
+ */
+typedef void (*Can_RxCallbackType)(unsigned char instance, const Can_FrameType * FramePtr);
+
+/**
+ * @brief   Transmit complete callback.
+ * @details Called from the interrupt when a frame was sent, with the free-running timer captured
+ *          when its identifier field was on the bus.
+ */
+typedef void (*Can_TxCallbackType)(unsigned char instance, unsigned int id, unsigned short timestamp);
+
+/**
+ * @brief   Configuration structure for a FlexCAN instance.
+ */
+typedef struct
+{
+			unsigned char           instance;       /*!< FlexCAN instance (0-2) */
+			Can_clock_t             clkSrc;         /*!< Protocol engine clock */
+			unsigned int            bitrate;        /*!< Bit rate in bit/s */
+			unsigned char           loopback;       /*!< Receive the own frames internally, the TX pin stays recessive */
+			unsigned char           rxFifo;         /*!< Receive in the Rx FIFO instead of message buffers */
+			unsigned char           filterCount;    /*!< Filters, at most 4, or 8 with the Rx FIFO; 0 accepts every frame */
+			const Can_FilterType *  filters;        /*!< Filter table */
+			Can_RxCallbackType      rxCallback;     /*!< Receive callback, may be NULL */
+			Can_TxCallbackType      txCallback;     /*!< Transmit complete callback, may be NULL */
+} Can_ConfigType;
+
+/**
+ * @brief   CAN statistics.
+ */
+typedef struct
+{
+			unsigned int   rxFrames;            /*!< Frames received */
+			unsigned int   txFrames;            /*!< Frames transmitted */
+			unsigned int   rxOverruns;          /*!< Frames lost in a full message buffer or Rx FIFO */
+} Can_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes a FlexCAN instance.
+ *
+ * The module is reset in freeze mode, the bit timing is derived from the protocol engine clock
+ * with 8 to 16 time quanta per bit and the sample point at 75 %, the filters are written, and the
+ * module joins the bus.
+ *
+ * @param[in] ConfigPtr Pointer to the CAN configuration structure.
+ * @return CAN_OK on success, CAN_ERR_PARA, CAN_ERR_BITRATE or CAN_ERR_TIMEOUT on error.
+ * @note Enable CANn_ORed_0_15_MB_IRQn in the NVIC.
+ */
+Can_ret_t Can_Init(const Can_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Disables a FlexCAN instance and releases its clock.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return void.
+ */
+void Can_Deinit(unsigned char instance);
+
+/*!
+ * @brief Queues a frame for transmission.
+ *
+ * The frame goes into a free transmit message buffer; buffers are sent in identifier priority.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] FramePtr Frame; the timestamp is ignored.
+ * @return CAN_OK on success, CAN_ERR_PARA or CAN_ERR_BUSY on error.
+ * @note May be called from a receive or transmit callback.
+ */
+Can_ret_t Can_Send(unsigned char instance, const Can_FrameType * FramePtr);
+
+/*!
+ * @brief Reads the free-running timer.
+ *
+ * Comparing it with a frame timestamp tells how many bit times ago the frame was on the bus.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return Timer value, counting bit times modulo 2^16.
+ */
+unsigned short Can_GetTimer(unsigned char instance);
+
+/*!
+ * @brief Retrieves the statistics of a FlexCAN instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return CAN_OK on success, CAN_ERR_PARA on parameter error.
+ */
+Can_ret_t Can_GetStats(unsigned char instance, Can_StatsType * StatsPtr);
+
+#if defined(CAN_HOST)
+/*!
+ * @brief Sets the oscillator of a simulated node.
+ *
+ * The node clock runs at (1 + ppb / 10^9) times the bus time, from offsetNs; its free-running
+ * timer counts bit times of this clock and is resynchronized to the bus at every start of frame.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] ppb Oscillator error in parts per billion.
+ * @param[in] offsetNs Node clock at bus time 0.
+ * @return void.
+ */
+void Can_HostSetNode(unsigned char instance, int ppb, uint64 offsetNs);
+
+/*!
+ * @brief Sets the simulated interrupt latency.
+ *
+ * Callbacks run a pseudo-random delay of 0 to maxNs after the end of their frame.
+ *
+ * @param[in] maxNs Largest latency.
+ * @return void.
+ */
+void Can_HostSetLatency(unsigned int maxNs);
+
+/*!
+ * @brief Gets the clock of a simulated node at the current bus time.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return Node clock in nanoseconds.
+ */
+uint64 Can_HostNodeNs(unsigned char instance);
+
+/*!
+ * @brief Gets the bus time.
+ *
+ * @return Nanoseconds since the start of the simulation.
+ */
+uint64 Can_HostNow(void);
+
+/*!
+ * @brief Runs the bus for a while, calling the callbacks that fall due.
+ *
+ * @param[in] ns Bus time to advance.
+ * @return void.
+ */
+void Can_HostAdvance(uint64 ns);
+#endif
+
+#endif  /* CAN_H */
@@ -0,0 +1,153 @@
+/****************************************************************************************************
+* @file     Can_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for FlexCAN peripheral registers.
+* @details  This header file contains the definitions and structures for the FlexCAN modules
+*           (CAN0 - CAN2) of the S32K144, with the message buffer layout for 8-byte payloads.
+* @version  1.0.0
+* @date     2024-11-14
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CAN_REG_H
+#define CAN_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral FlexCAN base addresses ***/
+#define CAN0_BASE_ADDRESS                   (0x40024000u)
+#define CAN1_BASE_ADDRESS                   (0x40025000u)
+#define CAN2_BASE_ADDRESS                   (0x4002B000u)
+
+/*** Sizes ***/
+#define CAN_INSTANCE_COUNT                  (3u)
+#define CAN_MB_COUNT                        (16u)              /* Message buffers on every instance (CAN0 has 32) */
+#define CAN_MB_WORDS                        (4u)               /* CS, ID, DATA0, DATA1 */
+#define CAN_RAM_WORDS                       (128u)
+
+/*** MCR - Module Configuration Register ***/
+#define CAN_MCR_MAXMB_SHIFT                 (0u)               /* Last message buffer in use */
+#define CAN_MCR_AEN_SHIFT                   (12u)              /* Abort enable */
+#define CAN_MCR_IRMQ_SHIFT                  (16u)              /* Individual RX masking and queue */
+#define CAN_MCR_SRXDIS_SHIFT                (17u)              /* Self reception disable */
+#define CAN_MCR_LPMACK_SHIFT                (20u)              /* Low power mode acknowledge */
+#define CAN_MCR_SUPV_SHIFT                  (23u)              /* Supervisor mode */
+#define CAN_MCR_FRZACK_SHIFT                (24u)              /* Freeze mode acknowledge */
+#define CAN_MCR_SOFTRST_SHIFT               (25u)              /* Soft reset */
+#define CAN_MCR_NOTRDY_SHIFT                (27u)              /* Not ready: disabled, stopped or frozen */
+#define CAN_MCR_HALT_SHIFT                  (28u)              /* Halt, enters freeze mode when FRZ is set */
+#define CAN_MCR_RFEN_SHIFT                  (29u)              /* Rx FIFO enable */
+#define CAN_MCR_FRZ_SHIFT                   (30u)              /* Freeze enable */
+#define CAN_MCR_MDIS_SHIFT                  (31u)              /* Module disable */
+
+/*** CTRL1 - Control 1 Register ***/
+#define CAN_CTRL1_PROPSEG_SHIFT             (0u)               /* Propagation segment - 1, in time quanta */
+#define CAN_CTRL1_LOM_SHIFT                 (3u)               /* Listen-only mode */
+#define CAN_CTRL1_LBUF_SHIFT                (4u)               /* Lowest buffer transmitted first */
+#define CAN_CTRL1_TSYN_SHIFT                (5u)               /* Timer reset by the reception in MB0 */
+#define CAN_CTRL1_BOFFREC_SHIFT             (6u)               /* Bus off automatic recovery disable */
+#define CAN_CTRL1_SMP_SHIFT                 (7u)               /* Three samples per bit */
+#define CAN_CTRL1_LPB_SHIFT                 (12u)              /* Loopback mode */
+#define CAN_CTRL1_CLKSRC_SHIFT              (13u)              /* Protocol engine clock: 0 SOSCDIV2, 1 system clock */
+#define CAN_CTRL1_PSEG2_SHIFT               (16u)              /* Phase segment 2 - 1 */
+#define CAN_CTRL1_PSEG1_SHIFT               (19u)              /* Phase segment 1 - 1 */
+#define CAN_CTRL1_RJW_SHIFT                 (22u)              /* Resync jump width - 1 */
+#define CAN_CTRL1_PRESDIV_SHIFT             (24u)              /* Prescaler - 1 */
+#define CAN_CTRL1_PRESDIV_MAX               (0xFFu)
+
+/*** CTRL2 - Control 2 Register ***/
+#define CAN_CTRL2_EACEN_SHIFT               (16u)              /* Compare IDE and RTR of RX message buffers */
+#define CAN_CTRL2_RRS_SHIFT                 (17u)              /* Remote request storing */
+#define CAN_CTRL2_MRP_SHIFT                 (18u)              /* Message buffers matched before the Rx FIFO */
+#define CAN_CTRL2_RFFN_SHIFT                (24u)              /* Rx FIFO filters: 8 * (RFFN + 1) */
+
+/*** IFLAG1 bits of the Rx FIFO ***/
+#define CAN_IFLAG1_BUF5I_SHIFT              (5u)               /* Frame available in the Rx FIFO */
+#define CAN_IFLAG1_BUF6I_SHIFT              (6u)               /* Rx FIFO warning: 5 frames */
+#define CAN_IFLAG1_BUF7I_SHIFT              (7u)               /* Rx FIFO overflow */
+
+/*** Message buffer CS word ***/
+#define CAN_CS_TIMESTAMP_MASK               (0xFFFFu)          /* Free-running timer at the identifier field */
+#define CAN_CS_DLC_SHIFT                    (16u)
+#define CAN_CS_DLC_MASK                     (0xFu)
+#define CAN_CS_RTR_SHIFT                    (20u)
+#define CAN_CS_IDE_SHIFT                    (21u)
+#define CAN_CS_SRR_SHIFT                    (22u)
+#define CAN_CS_CODE_SHIFT                   (24u)
+#define CAN_CS_CODE_MASK                    (0xFu)
+
+/*** Message buffer codes ***/
+#define CAN_CODE_RX_INACTIVE                (0x0u)
+#define CAN_CODE_RX_FULL                    (0x2u)
+#define CAN_CODE_RX_EMPTY                   (0x4u)
+#define CAN_CODE_RX_OVERRUN                 (0x6u)
+#define CAN_CODE_TX_INACTIVE                (0x8u)
+#define CAN_CODE_TX_DATA                    (0xCu)
+
+/*** Message buffer ID word ***/
+#define CAN_ID_STD_SHIFT                    (18u)
+#define CAN_ID_STD_MASK                     (0x7FFu)
+#define CAN_ID_EXT_MASK                     (0x1FFFFFFFu)
+
+/*** Rx FIFO filter element, format A ***/
+#define CAN_FIFO_STD_SHIFT                  (19u)
+#define CAN_FIFO_EXT_SHIFT                  (1u)
+#define CAN_FIFO_IDE_SHIFT                  (30u)
+#define CAN_FIFO_RTR_SHIFT                  (31u)
+#define CAN_FIFO_FILTERS                    (8u)               /* RFFN = 0: filter table in MB6 - MB7 */
+#define CAN_FIFO_TABLE_MB                   (6u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief FlexCAN Register Structure.
+ */
+typedef struct {
+			volatile unsigned int MCR;          /**< Module Configuration Register, Address offset: 0x0 */
+			volatile unsigned int CTRL1;        /**< Control 1 Register, Address offset: 0x4 */
+			volatile unsigned int TIMER;        /**< Free Running Timer, Address offset: 0x8 */
+			unsigned int RESERVED_0;
+			volatile unsigned int RXMGMASK;     /**< Rx Mailboxes Global Mask Register, Address offset: 0x10 */
+			volatile unsigned int RX14MASK;     /**< Rx 14 Mask Register, Address offset: 0x14 */
+			volatile unsigned int RX15MASK;     /**< Rx 15 Mask Register, Address offset: 0x18 */
+			volatile unsigned int ECR;          /**< Error Counter, Address offset: 0x1C */
+			volatile unsigned int ESR1;         /**< Error and Status 1 Register, Address offset: 0x20 */
+			unsigned int RESERVED_1;
+			volatile unsigned int IMASK1;       /**< Interrupt Masks 1 Register, Address offset: 0x28 */
+			unsigned int RESERVED_2;
+			volatile unsigned int IFLAG1;       /**< Interrupt Flags 1 Register, Address offset: 0x30 */
+			volatile unsigned int CTRL2;        /**< Control 2 Register, Address offset: 0x34 */
+			volatile unsigned int ESR2;         /**< Error and Status 2 Register, Address offset: 0x38 */
+			unsigned int RESERVED_3[2];
+			volatile unsigned int CRCR;         /**< CRC Register, Address offset: 0x44 */
+			volatile unsigned int RXFGMASK;     /**< Rx FIFO Global Mask Register, Address offset: 0x48 */
+			volatile unsigned int RXFIR;        /**< Rx FIFO Information Register, Address offset: 0x4C */
+			volatile unsigned int CBT;          /**< CAN Bit Timing Register, Address offset: 0x50 */
+			unsigned int RESERVED_4[11];
+			volatile unsigned int RAMn[CAN_RAM_WORDS];  /**< Message buffers, Address offset: 0x80 */
+			unsigned int RESERVED_5[384];
+			volatile unsigned int RXIMR[32];    /**< Rx Individual Mask Registers, Address offset: 0x880 */
+} CAN_Type;
+
+/** Message buffer words */
+#define CAN_MB_CS(CAN, MB)                  ((CAN)->RAMn[((MB) * CAN_MB_WORDS) + 0u])
+#define CAN_MB_ID(CAN, MB)                  ((CAN)->RAMn[((MB) * CAN_MB_WORDS) + 1u])
+#define CAN_MB_DATA(CAN, MB, WORD)          ((CAN)->RAMn[((MB) * CAN_MB_WORDS) + 2u + (WORD)])
+
+/** Peripheral FlexCAN base pointers */
+#define CAN0 ((CAN_Type *)CAN0_BASE_ADDRESS)
+#define CAN1 ((CAN_Type *)CAN1_BASE_ADDRESS)
+#define CAN2 ((CAN_Type *)CAN2_BASE_ADDRESS)
+
+
+#endif /* CAN_REG_H */
@@ -16,6 +16,45 @@
 #include "Clock.h"
 
 
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Apply an asynchronous clock divider field (xxxDIV1 / xxxDIV2).
+ * 
+ * @param[in] freq Frequency of the divided clock in Hz.
+ * @param[in] field Register value shifted so that the divider field is in the low bits.
+ * @return Divided frequency in Hz, 0 when the output is disabled.
+ */
+static unsigned int Clock_AsyncDivide(unsigned int freq, unsigned int field)
+{
+		field &= SCG_ASYNC_DIV_MASK;
+		
+		/* 0 disables the output, n selects divide-by-2^(n-1) */
+		return (field == (unsigned int)SCG_CLOCK_DISABLE) ? 0u : (freq >> (field - 1u));
+}
+
+/*!
+ * @brief Clear the lock of an SCG clock and set its enable.
+ * 
+ * LK makes the register read only, so the lock is cleared in a write of its own; the enable
+ * write reuses the value read: one read, two writes. ERR is written as 0, so it is not cleared.
+ * A clock that is reprogrammed is disabled with a RESET store instead, which clears the lock in
+ * the same way, and enabled by a single store once configured.
+ * 
+ * @param[in] csr Clock control status register (SOSCCSR, FIRCCSR, SPLLCSR).
+ * @param[in] enable 1 to enable the clock, 0 to disable it.
+ * @return void.
+ */
+static void Clock_WriteScgEnable(volatile unsigned int * csr, unsigned int enable)
+{
+		unsigned int value = FIELDS_APPLY(*csr & ~SCG_OSCCSR_W1C, FIELD_SET(SCG_OSCCSR_LK, 0u));
+		
+		*csr = value;
+		*csr = FIELDS_APPLY(value, FIELD_SET(SCG_OSCCSR_EN, enable));
+}
+
+
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
@@ -32,8 +71,10 @@
  */
 void Clock_SetPccConfig(const Pcc_ConfigType* ConfigPtr)
 {
+		unsigned int value = FIELDS_APPLY(PCC->PCCn[ConfigPtr->clockName], FIELD_SET(PCC_PCCn_CGC, 0u));
+		
 		/* 1. Disable the peripheral clock */
-		PCC->PCCn[ConfigPtr->clockName] &=~ (ENABLEMENT << PCC_CGC_SHIFT);
+		PCC->PCCn[ConfigPtr->clockName] = value;
 		
 		/* 2. Check whether Clock Gate Control is enable or disable */
 		if( ConfigPtr->clkGate == CLK_GATE_ENABLE )
@@ -41,12 +82,32 @@ void Clock_SetPccConfig(const Pcc_ConfigType* ConfigPtr)
 			/* 2.1. Check whether Peripheral Clock Source Select is off or set */
 			if(ConfigPtr->clkSrc != CLK_SRC_OFF)
 			{
-				/* Set Peripheral Clock Source Select */
-				PCC->PCCn[ConfigPtr->clockName] |= ((unsigned int)ConfigPtr->clkSrc << PCC_PCS_SHIFT);
+				/* Set Peripheral Clock Source Select, replacing the previous source */
+				value = FIELDS_APPLY(value, FIELD_SET(PCC_PCCn_PCS, ConfigPtr->clkSrc));
 			}
 			
-			/* 2.2. Enable the peripheral clock */
-			PCC->PCCn[ConfigPtr->clockName] |= (ENABLEMENT << PCC_CGC_SHIFT);
+			/* 2.2. Enable the peripheral clock, in the same write as the source */
+			PCC->PCCn[ConfigPtr->clockName] = FIELDS_APPLY(value, FIELD_SET(PCC_PCCn_CGC, 1u));
+		}
+}
+
+/*!
+ * @brief Set several Peripheral Clock Control (PCC) configurations.
+ * 
+ * This function applies Clock_SetPccConfig() to every entry of a configuration table, e.g. the
+ * PCC table of the board configuration at start-up.
+ * 
+ * @param[in] ConfigPtr Pointer to the first PCC configuration structure.
+ * @param[in] count Number of entries in the table.
+ * @return void.
+ */
+void Clock_SetPccConfigs(const Pcc_ConfigType* ConfigPtr, unsigned int count)
+{
+		unsigned int index;
+		
+		for (index = 0u; index < count; index++)
+		{
+			Clock_SetPccConfig(&ConfigPtr[index]);
 		}
 }
 
@@ -62,11 +123,8 @@ void Clock_SetPccConfig(const Pcc_ConfigType* ConfigPtr)
  */
 void Clock_SetScgFircConfig(const Scg_Firc_ConfigType * ConfigPtr)
 {
-		/* Step 1. Setup dividers 1. */
-		SCG->FIRCDIV |= ((unsigned int)(ConfigPtr->div1)<< SCG_FIRCDIV_FIRCDIV1_SHIFT);
-		
-		/* Step 2. Setup dividers 2. */
-		SCG->FIRCDIV |= ((unsigned int)(ConfigPtr->div2)<< SCG_FIRCDIV_FIRCDIV2_SHIFT);
+		/* Step 1. Setup dividers 1 and 2 with one store, clearing stale divider bits. */
+		REG_WRITE(SCG->FIRCDIV, FIELD_SET(SCG_OSCDIV_DIV1, ConfigPtr->div1), FIELD_SET(SCG_OSCDIV_DIV2, ConfigPtr->div2));
 }
 
 /*!
@@ -81,11 +139,8 @@ void Clock_SetScgFircConfig(const Scg_Firc_ConfigType * ConfigPtr)
  */
 void Clock_SetScgSircConfig(const Scg_Sirc_ConfigType * ConfigPtr)
 {
-		/* Step 1. Setup dividers 1 */
-		SCG->SIRCDIV |= ((unsigned int)(ConfigPtr->div1)<< SCG_SIRCDIV_SIRCDIV1_SHIFT);
-		
-		/* Step 2. Setup dividers 2. */
-		SCG->SIRCDIV |= ((unsigned int)(ConfigPtr->div2)<< SCG_SIRCDIV_SIRCDIV2_SHIFT);
+		/* Step 1. Setup dividers 1 and 2 with one store, clearing stale divider bits. */
+		REG_WRITE(SCG->SIRCDIV, FIELD_SET(SCG_OSCDIV_DIV1, ConfigPtr->div1), FIELD_SET(SCG_OSCDIV_DIV2, ConfigPtr->div2));
 }
 
 /*!
@@ -100,28 +155,62 @@ void Clock_SetScgSircConfig(const Scg_Sirc_ConfigType * ConfigPtr)
  */
 void Clock_SetScgSoscConfig(const Scg_Sosc_ConfigType * ConfigPtr)
 {
-		/* Step 1. Setup dividers 1 */
-		SCG->SOSCDIV |= ((unsigned int)(ConfigPtr->div1) << SCG_SOSCDIV_SOSCDIV1_SHIFT);
-		
-		/* Step 2. Setup dividers 2. */
-		SCG->SOSCDIV |= ((unsigned int)(ConfigPtr->div2) << SCG_SOSCDIV_SOSCDIV2_SHIFT);
+		/* Step 1 - 4. Configure and enable SOSC */
+		Clock_EnableScgSosc(ConfigPtr);
 		
-		/* Step 3. Set SOSC configuration. */
-		SCG->SOSCCFG = ((unsigned int)(ConfigPtr->range) << SCG_SOSCCFG_RANGE_SHIFT)|(SCG_SOSCCFG_EREFS_IOSC << SCG_SOSCCFG_EREFS_SHIFT);
-		
-		/* Step 4. Clear Lock Register */
-		SCG->SOSCCSR &= ((unsigned int) ~(ENABLEMENT << SCG_CSR_LK_SHIFT));
-		
-		/* Step 5. Enable SOSC clock*/
-		SCG->SOSCCSR |= ((unsigned int)ENABLEMENT << BIT0);
-		
-		/* Step 6. Wait for System OSC to initialize */
-		while(((SCG->SOSCCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT) != VALUE_CHECK_BIT)
+		/* Step 5. Wait for System OSC to initialize */
+		while(Clock_IsScgSoscValid() == 0u)
 		{
 			/* Empty */
 		}
 }
 
+/*!
+ * @brief Start the SOSC without waiting for it.
+ * 
+ * This function performs the configuration steps of Clock_SetScgSoscConfig() and enables the
+ * oscillator, but returns immediately. Use Clock_IsScgSoscValid() to poll for start-up.
+ * 
+ * @param[in] ConfigPtr Pointer to the SOSC configuration structure.
+ * @return void.
+ */
+void Clock_EnableScgSosc(const Scg_Sosc_ConfigType * ConfigPtr)
+{
+		/* Step 1. Clear Lock Register and disable SOSC, DIV and CFG can only be written while it is off */
+		SCG->SOSCCSR = RESET;
+
+		/* Step 2. Setup dividers 1 and 2 with one store, clearing stale divider bits. */
+		REG_WRITE(SCG->SOSCDIV, FIELD_SET(SCG_OSCDIV_DIV1, ConfigPtr->div1), FIELD_SET(SCG_OSCDIV_DIV2, ConfigPtr->div2));
+		
+		/* Step 3. Set SOSC configuration. */
+		REG_WRITE(SCG->SOSCCFG, FIELD_SET(SCG_SOSCCFG_RANGE, ConfigPtr->range), FIELD_SET(SCG_SOSCCFG_EREFS, SCG_SOSCCFG_EREFS_IOSC));
+		
+		/* Step 4. Enable SOSC clock, the lock was cleared in step 1 */
+		REG_WRITE(SCG->SOSCCSR, FIELD_SET(SCG_OSCCSR_EN, 1u));
+}
+
+/*!
+ * @brief Check whether the SOSC output is valid.
+ * 
+ * @return 1 when the SOSC is enabled and valid, 0 otherwise.
+ */
+unsigned char Clock_IsScgSoscValid(void)
+{
+		return (unsigned char)((SCG->SOSCCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT);
+}
+
+/*!
+ * @brief Disable the SOSC.
+ * 
+ * @return void.
+ * @note The SOSC must not be the system clock or the SPLL source when it is disabled.
+ */
+void Clock_DisableScgSosc(void)
+{
+		/* Step 1 - 2. Clear Lock Register and disable SOSC clock */
+		Clock_WriteScgEnable(&SCG->SOSCCSR, 0u);
+}
+
 /*!
  * @brief Set SPLL configuration.
  * 
@@ -134,33 +223,62 @@ void Clock_SetScgSoscConfig(const Scg_Sosc_ConfigType * ConfigPtr)
  */
 void Clock_SetScgSpllConfig(const Scg_Spll_ConfigType * ConfigPtr)
 {
-		/* Step 1. Disable SPLL */
-		SCG->SPLLCSR &= (unsigned int) ~(ENABLEMENT);
-
-		/* Step 2. Setup dividers 1 */
-		SCG->SPLLDIV |= ((unsigned int)(ConfigPtr->div1) << SCG_SPLLDIV_SPLLDIV1_SHIFT);
+		/* Step 1 - 4. Configure and enable SPLL */
+		Clock_EnableScgSpll(ConfigPtr);
 		
-		/* Step 2. Setup dividers 2. */
-		SCG->SPLLDIV |= ((unsigned int)(ConfigPtr->div2) << SCG_SPLLDIV_SPLLDIV2_SHIFT);
+		/* Step 5. Wait for SPLL to initialize */
+		while(Clock_IsScgSpllValid() == 0u)
+		{
+			/* Empty */
+		}
+}
+
+/*!
+ * @brief Start the SPLL without waiting for lock.
+ * 
+ * This function performs the configuration steps of Clock_SetScgSpllConfig() and enables the
+ * PLL, but returns immediately. Use Clock_IsScgSpllValid() to poll for lock.
+ * 
+ * @param[in] ConfigPtr Pointer to the SPLL configuration structure.
+ * @return void.
+ */
+void Clock_EnableScgSpll(const Scg_Spll_ConfigType * ConfigPtr)
+{
+		/* Step 1. Clear Lock Register and disable SPLL */
+		SCG->SPLLCSR = RESET;
+
+		/* Step 2. Setup dividers 1 and 2 with one store, clearing stale divider bits. */
+		REG_WRITE(SCG->SPLLDIV, FIELD_SET(SCG_OSCDIV_DIV1, ConfigPtr->div1), FIELD_SET(SCG_OSCDIV_DIV2, ConfigPtr->div2));
 		
 		/* Step 3. Set PLL configuration. */
-		SCG->SPLLCFG |= ((unsigned int)(ConfigPtr->src) << SCG_SPLLCFG_SOURCE_SHIFT);			/* System PLL source. */
-
-		SCG->SPLLCFG |= ((unsigned int)(ConfigPtr->prediv) << SCG_SPLLCFG_PREDIV_SHIFT);	/* PLL Reference Clock Divider. */
+		REG_WRITE(SCG->SPLLCFG, FIELD_SET(SCG_SPLLCFG_SOURCE, ConfigPtr->src),			/* System PLL source. */
+		          FIELD_SET(SCG_SPLLCFG_PREDIV, ConfigPtr->prediv),					/* PLL Reference Clock Divider. */
+		          FIELD_SET(SCG_SPLLCFG_MULT, ConfigPtr->mult));					/* System PLL Multiplier. */
 
-		SCG->SPLLCFG |= ((unsigned int)(ConfigPtr->mult)  << SCG_SPLLCFG_MULT_SHIFT);		/* System PLL Multiplier. */
+		/* Step 4. Enable SPLL clock, the lock was cleared in step 1 */
+		REG_WRITE(SCG->SPLLCSR, FIELD_SET(SCG_OSCCSR_EN, 1u));
+}
 
-		/* Step 4. Clear Lock Register */
-		SCG->SPLLCSR &= ((unsigned int) ~(ENABLEMENT << SCG_CSR_LK_SHIFT));
+/*!
+ * @brief Check whether the SPLL output is valid.
+ * 
+ * @return 1 when the SPLL is enabled and locked, 0 otherwise.
+ */
+unsigned char Clock_IsScgSpllValid(void)
+{
+		return (unsigned char)((SCG->SPLLCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT);
+}
 
-		/* Step 5. Enable SOSC clock*/
-		SCG->SPLLCSR |= ((unsigned int)ENABLEMENT << BIT0);
-		
-		/* Step 6. Wait for SPLL to initialize */
-		while(((SCG->SPLLCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT) != VALUE_CHECK_BIT)
-		{
-			/* Empty */
-		}
+/*!
+ * @brief Disable the SPLL.
+ * 
+ * @return void.
+ * @note The SPLL must not be the system clock when it is disabled.
+ */
+void Clock_DisableScgSpll(void)
+{
+		/* Step 1 - 2. Clear Lock Register and disable SPLL clock */
+		Clock_WriteScgEnable(&SCG->SPLLCSR, 0u);
 }
 
 /*!
@@ -175,30 +293,45 @@ void Clock_SetScgSpllConfig(const Scg_Spll_ConfigType * ConfigPtr)
  */
 void Clock_SetScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
 {
-		/*** Step1. Sets the RUN clock control (system clock source, bus, core and slow dividers ***/
-		unsigned int value = 0;
-		
-			/* Step1.1. Set system clock source */
-			value |= ((unsigned int)ConfigPtr->sys_clk_src << SCG_RCCR_SCS_SHIFT);
-		
-			/* Step1.2. Set Core Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->core_div << SCG_RCCR_DIVCORE_SHIFT);
-		
-			/* Step1.3. Set Bus Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->bus_div << SCG_RCCR_DIVBUS_SHIFT);
-
-			/* Step1.4. Set Slow Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->slow_div << SCG_RCCR_DIVSLOW_SHIFT);
-		
-		SCG->RCCR = value;
+		/*** Step 1. Sets the RUN clock control (system clock source, bus, core and slow dividers ***/
+		Clock_WriteScgRunModeConfig(ConfigPtr);
 		
 		/*** Step 2. Cormfirm: System Clock Source as config ***/
-		while(SCG->RCCR != value)
+		while(Clock_GetSysClockSource() != ConfigPtr->sys_clk_src)
 		{
 			/* Empty */
 		}
 }
 
+/*!
+ * @brief Write the Run Mode configuration without waiting for the switch.
+ * 
+ * @param[in] ConfigPtr Pointer to the Run Mode configuration structure.
+ * @return void.
+ */
+void Clock_WriteScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
+{
+		unsigned int value = FIELDS_VAL(FIELD_SET(SCG_CCR_SCS, ConfigPtr->sys_clk_src),		/* System clock source */
+		                                FIELD_SET(SCG_CCR_DIVCORE, ConfigPtr->core_div),	/* Core Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVBUS, ConfigPtr->bus_div),		/* Bus Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVSLOW, ConfigPtr->slow_div));	/* Slow Clock Divide Ratio */
+		
+		SCG->RCCR = value;
+}
+
+/*!
+ * @brief Get the system clock source currently in use.
+ * 
+ * This function reads the SCG Clock Status Register, which reflects the clock source actually
+ * driving the core after a mode or source switch has completed.
+ * 
+ * @return System clock source.
+ */
+system_clock_source_t Clock_GetSysClockSource(void)
+{
+		return (system_clock_source_t)((SCG->CSR & SCG_CSR_SCS_MASK) >> SCG_CSR_SCS_SHIFT);
+}
+
 /*!
  * @brief Set High Speed Run Mode configuration.
  * 
@@ -212,19 +345,10 @@ void Clock_SetScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
 void Clock_SetScgHSRunModeConfig(const Scg_HSRunMode_ConfigType * ConfigPtr)
 {
 		/*** Step1. Sets the HSRUN clock control (system clock source, bus, core and slow dividers ***/
-		unsigned int value = 0;
-		
-			/* Step1.1. Set system clock source */
-			value |= ((unsigned int)ConfigPtr->sys_clk_src << SCG_HCCR_SCS_SHIFT);
-		
-			/* Step1.2. Set Core Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->core_div << SCG_HCCR_DIVCORE_SHIFT);
-		
-			/* Step1.3. Set Bus Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->bus_div << SCG_HCCR_DIVBUS_SHIFT);
-
-			/* Step1.4. Set Slow Clock Divide Ratio */
-			value |= ((unsigned int)ConfigPtr->slow_div << SCG_HCCR_DIVSLOW_SHIFT);
+		unsigned int value = FIELDS_VAL(FIELD_SET(SCG_CCR_SCS, ConfigPtr->sys_clk_src),		/* System clock source */
+		                                FIELD_SET(SCG_CCR_DIVCORE, ConfigPtr->core_div),	/* Core Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVBUS, ConfigPtr->bus_div),		/* Bus Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVSLOW, ConfigPtr->slow_div));	/* Slow Clock Divide Ratio */
 		
 		SCG->HCCR = value;
 		
@@ -234,3 +358,297 @@ void Clock_SetScgHSRunModeConfig(const Scg_HSRunMode_ConfigType * ConfigPtr)
 			/* Empty */
 		}
 }
+
+/*!
+ * @brief Set VLPR Mode configuration.
+ * 
+ * This function writes the VLPR clock control register. The configuration takes effect when the
+ * SMC enters VLPR mode.
+ * 
+ * @param[in] ConfigPtr Pointer to the VLPR Mode configuration structure.
+ * @return void.
+ */
+void Clock_SetScgVlprModeConfig(const Scg_VlprMode_ConfigType * ConfigPtr)
+{
+		unsigned int value = FIELDS_VAL(FIELD_SET(SCG_CCR_SCS, ConfigPtr->sys_clk_src),		/* System clock source */
+		                                FIELD_SET(SCG_CCR_DIVCORE, ConfigPtr->core_div),	/* Core Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVBUS, ConfigPtr->bus_div),		/* Bus Clock Divide Ratio */
+		                                FIELD_SET(SCG_CCR_DIVSLOW, ConfigPtr->slow_div));	/* Slow Clock Divide Ratio */
+		
+		SCG->VCCR = value;
+}
+
+/*!
+ * @brief Enable the FIRC.
+ * 
+ * @return void.
+ */
+void Clock_EnableScgFirc(void)
+{
+		/* Step 1 - 2. Clear Lock Register and enable FIRC clock */
+		Clock_WriteScgEnable(&SCG->FIRCCSR, 1u);
+}
+
+/*!
+ * @brief Check whether the FIRC output is valid.
+ * 
+ * @return 1 when the FIRC is enabled and valid, 0 otherwise.
+ */
+unsigned char Clock_IsScgFircValid(void)
+{
+		return (unsigned char)((SCG->FIRCCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT);
+}
+
+/*!
+ * @brief Disable the FIRC.
+ * 
+ * @return void.
+ * @note The FIRC must not be the system clock or the SPLL source when it is disabled.
+ */
+void Clock_DisableScgFirc(void)
+{
+		/* Step 1 - 2. Clear Lock Register and disable FIRC clock */
+		Clock_WriteScgEnable(&SCG->FIRCCSR, 0u);
+}
+
+/*!
+ * @brief Get the frequency of a clock.
+ * 
+ * This function computes the frequency from the SCG registers. Core, bus and slow clocks are
+ * read from SCG_CSR, so they reflect the power mode in use (RUN, HSRUN or VLPR).
+ * 
+ * @param[in] name Clock to query.
+ * @return Frequency in Hz, 0 when the clock is disabled or not valid.
+ */
+unsigned int Clock_GetFreq(clock_freq_names_t name)
+{
+		unsigned int freq = 0u;
+		unsigned int csr;
+		
+		switch (name)
+		{
+			case CLOCK_FREQ_CORE:
+			case CLOCK_FREQ_BUS:
+			case CLOCK_FREQ_SLOW:
+				/* Step 1. Frequency of the system clock source in use */
+				csr = SCG->CSR;
+				switch ((csr & SCG_CSR_SCS_MASK) >> SCG_CSR_SCS_SHIFT)
+				{
+					case SOSC_CLK: freq = Clock_GetFreq(CLOCK_FREQ_SOSC); break;
+					case SIRC_CLK: freq = Clock_GetFreq(CLOCK_FREQ_SIRC); break;
+					case FIRC_CLK: freq = Clock_GetFreq(CLOCK_FREQ_FIRC); break;
+					case SPLL_CLK: freq = Clock_GetFreq(CLOCK_FREQ_SPLL); break;
+					default: freq = 0u; break;
+				}
+				
+				/* Step 2. Core divider applies to all three */
+				freq /= (((csr >> SCG_RCCR_DIVCORE_SHIFT) & SCG_CCR_DIV_MASK) + 1u);
+				
+				/* Step 3. Bus and slow clocks are divided from the core clock */
+				if (name == CLOCK_FREQ_BUS)
+				{
+					freq /= (((csr >> SCG_RCCR_DIVBUS_SHIFT) & SCG_CCR_DIV_MASK) + 1u);
+				}
+				else if (name == CLOCK_FREQ_SLOW)
+				{
+					freq /= (((csr >> SCG_RCCR_DIVSLOW_SHIFT) & SCG_CCR_DIV_MASK) + 1u);
+				}
+				break;
+				
+			case CLOCK_FREQ_SOSC:
+				if (Clock_IsScgSoscValid() != 0u)
+				{
+					freq = CLOCK_SOSC_FREQ_HZ;
+				}
+				break;
+				
+			case CLOCK_FREQ_SIRC:
+				if (((SCG->SIRCCSR >> SCG_CSR_VLD_SHIFT) & VALUE_CHECK_BIT) != 0u)
+				{
+					freq = (((SCG->SIRCCFG >> SCG_SIRCCFG_RANGE_SHIFT) & VALUE_CHECK_BIT) != 0u) ?
+					       CLOCK_SIRC_HIGH_FREQ_HZ : CLOCK_SIRC_LOW_FREQ_HZ;
+				}
+				break;
+				
+			case CLOCK_FREQ_FIRC:
+				if (Clock_IsScgFircValid() != 0u)
+				{
+					freq = CLOCK_FIRC_FREQ_HZ;
+				}
+				break;
+				
+			case CLOCK_FREQ_SPLL:
+				if (Clock_IsScgSpllValid() != 0u)
+				{
+					Scg_Spll_ConfigType spll;
+					unsigned int cfg = SCG->SPLLCFG;
+					spll.src    = (unsigned char)((cfg >> SCG_SPLLCFG_SOURCE_SHIFT) & SCG_SPLLCFG_SOURCE_MASK);
+					spll.prediv = (unsigned char)((cfg >> SCG_SPLLCFG_PREDIV_SHIFT) & SCG_SPLLCFG_PREDIV_MASK);
+					spll.mult   = (unsigned char)((cfg >> SCG_SPLLCFG_MULT_SHIFT) & SCG_SPLLCFG_MULT_MASK);
+					freq = Clock_CalcSpllFreq(&spll);
+				}
+				break;
+				
+			case CLOCK_FREQ_SOSCDIV1:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SOSC), SCG->SOSCDIV >> SCG_SOSCDIV_SOSCDIV1_SHIFT);
+				break;
+			case CLOCK_FREQ_SOSCDIV2:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SOSC), SCG->SOSCDIV >> SCG_SOSCDIV_SOSCDIV2_SHIFT);
+				break;
+			case CLOCK_FREQ_SIRCDIV1:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SIRC), SCG->SIRCDIV >> SCG_SIRCDIV_SIRCDIV1_SHIFT);
+				break;
+			case CLOCK_FREQ_SIRCDIV2:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SIRC), SCG->SIRCDIV >> SCG_SIRCDIV_SIRCDIV2_SHIFT);
+				break;
+			case CLOCK_FREQ_FIRCDIV1:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_FIRC), SCG->FIRCDIV >> SCG_FIRCDIV_FIRCDIV1_SHIFT);
+				break;
+			case CLOCK_FREQ_FIRCDIV2:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_FIRC), SCG->FIRCDIV >> SCG_FIRCDIV_FIRCDIV2_SHIFT);
+				break;
+			case CLOCK_FREQ_SPLLDIV1:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SPLL), SCG->SPLLDIV >> SCG_SPLLDIV_SPLLDIV1_SHIFT);
+				break;
+			case CLOCK_FREQ_SPLLDIV2:
+				freq = Clock_AsyncDivide(Clock_GetFreq(CLOCK_FREQ_SPLL), SCG->SPLLDIV >> SCG_SPLLDIV_SPLLDIV2_SHIFT);
+				break;
+				
+			default:
+				freq = 0u;
+				break;
+		}
+		
+		return freq;
+}
+
+/*!
+ * @brief Compute the SPLL output frequency of a configuration.
+ * 
+ * @param[in] ConfigPtr Pointer to the SPLL configuration structure.
+ * @return SPLL_CLK frequency in Hz.
+ */
+unsigned int Clock_CalcSpllFreq(const Scg_Spll_ConfigType * ConfigPtr)
+{
+		unsigned int ref = (ConfigPtr->src == 0u) ? CLOCK_SOSC_FREQ_HZ : CLOCK_FIRC_FREQ_HZ;
+		
+		/* SPLL_CLK = (ref / (PREDIV + 1)) * (MULT + 16) / 2 */
+		ref /= ((unsigned int)ConfigPtr->prediv + 1u);
+		return (ref * ((unsigned int)ConfigPtr->mult + CLOCK_SPLL_MULT_OFFSET)) / CLOCK_SPLL_POST_DIV;
+}
+
+/*!
+ * @brief Apply a precomputed clock configuration image.
+ * 
+ * This function brings up the clock tree from a register image built at compile time (see
+ * Clock_Cfg.h). Every SCG register is written with one store, in the order required by the
+ * reference manual: SOSC, SIRC and FIRC dividers, SPLL, the HSRUN and VLPR controls, and finally
+ * the RUN clock control. Each wait is bounded by CLOCK_WAIT_LOOPS.
+ * 
+ * @param[in] ImagePtr Pointer to the clock configuration image.
+ * @return CLOCK_OK on success, CLOCK_ERR_PARA or CLOCK_ERR_TIMEOUT on error.
+ * @note The system clock must be FIRC (the reset default) when this function is called.
+ */
+Clock_ret_t Clock_ApplyConfig(const Clock_ConfigImageType * ImagePtr)
+{
+		unsigned int loops;
+		
+		/* Check parameter */
+		if (ImagePtr == NULL)
+		{
+			return CLOCK_ERR_PARA;
+		}
+		
+		/* Step 1. SOSC: disable and unlock with RESET, configure, enable */
+		if (ImagePtr->soscEnable != 0u)
+		{
+			SCG->SOSCCSR = RESET;
+			SCG->SOSCDIV = ImagePtr->soscDiv;
+			SCG->SOSCCFG = ImagePtr->soscCfg;
+			REG_WRITE(SCG->SOSCCSR, FIELD_SET(SCG_OSCCSR_EN, 1u));
+			for (loops = 0u; Clock_IsScgSoscValid() == 0u; loops++)
+			{
+				if (loops >= CLOCK_WAIT_LOOPS)
+				{
+					return CLOCK_ERR_TIMEOUT;
+				}
+			}
+		}
+		
+		/* Step 2. SIRC and FIRC dividers */
+		SCG->SIRCDIV = ImagePtr->sircDiv;
+		SCG->FIRCDIV = ImagePtr->fircDiv;
+		
+		/* Step 3. SPLL: disable and unlock with RESET, configure, enable and wait for lock */
+		if (ImagePtr->spllEnable != 0u)
+		{
+			SCG->SPLLCSR = RESET;
+			SCG->SPLLDIV = ImagePtr->spllDiv;
+			SCG->SPLLCFG = ImagePtr->spllCfg;
+			REG_WRITE(SCG->SPLLCSR, FIELD_SET(SCG_OSCCSR_EN, 1u));
+			for (loops = 0u; Clock_IsScgSpllValid() == 0u; loops++)
+			{
+				if (loops >= CLOCK_WAIT_LOOPS)
+				{
+					return CLOCK_ERR_TIMEOUT;
+				}
+			}
+		}
+		
+		/* Step 4. Mode controls that only take effect on a power mode change */
+		SCG->HCCR = ImagePtr->hccr;
+		SCG->VCCR = ImagePtr->vccr;
+		
+		/* Step 5. Switch the RUN system clock and confirm the source */
+		SCG->RCCR = ImagePtr->rccr;
+		for (loops = 0u; (SCG->CSR & SCG_CSR_SCS_MASK) != (ImagePtr->rccr & SCG_CSR_SCS_MASK); loops++)
+		{
+			if (loops >= CLOCK_WAIT_LOOPS)
+			{
+				return CLOCK_ERR_TIMEOUT;
+			}
+		}
+		
+		return CLOCK_OK;
+}
+
+/*!
+ * @brief Get the functional clock frequency of a peripheral.
+ * 
+ * This function decodes the PCS field of the peripheral PCC slot and returns the frequency of
+ * the selected asynchronous divider output (SOSCDIV2, SIRCDIV2, FIRCDIV2 or SPLLDIV2).
+ * 
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return Frequency in Hz, 0 when the clock is gated, off, or the source is not valid.
+ */
+unsigned int Clock_GetPccFunctionalFreq(clock_names_t clockName)
+{
+		unsigned int pcc = PCC->PCCn[clockName];
+		unsigned int freq;
+		
+		if (((pcc >> PCC_CGC_SHIFT) & VALUE_CHECK_BIT) == 0u)
+		{
+			return 0u;
+		}
+		
+		switch ((pcc & PCC_PCS_MASK) >> PCC_PCS_SHIFT)
+		{
+			case CLK_SRC_OP_1:
+				freq = Clock_GetFreq(CLOCK_FREQ_SOSCDIV2);
+				break;
+			case CLK_SRC_OP_2:
+				freq = Clock_GetFreq(CLOCK_FREQ_SIRCDIV2);
+				break;
+			case CLK_SRC_OP_3:
+				freq = Clock_GetFreq(CLOCK_FREQ_FIRCDIV2);
+				break;
+			case CLK_SRC_OP_6:
+				freq = Clock_GetFreq(CLOCK_FREQ_SPLLDIV2);
+				break;
+			default:
+				freq = 0u;
+				break;
+		}
+		
+		return freq;
+}
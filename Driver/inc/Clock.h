@@ -27,10 +27,36 @@
 #define SCG_SOSCCFG_EREFS_ERC              (0u)               /* External reference clock selected */
 #define SCG_SOSCCFG_EREFS_IOSC             (1u)               /* Internal crystal oscillator of OSC selected */
 
+/***  Oscillator frequencies ***/
+#ifndef CLOCK_SOSC_FREQ_HZ
+#define CLOCK_SOSC_FREQ_HZ                 (8000000u)         /* External crystal on the board */
+#endif
+#define CLOCK_FIRC_FREQ_HZ                 (48000000u)        /* Fast IRC */
+#define CLOCK_SIRC_HIGH_FREQ_HZ            (8000000u)         /* Slow IRC, high range */
+#define CLOCK_SIRC_LOW_FREQ_HZ             (2000000u)         /* Slow IRC, low range */
+
+/***  SPLL ***/
+#define CLOCK_SPLL_MULT_OFFSET             (16u)              /* MULT field 0 selects multiply-by-16 */
+#define CLOCK_SPLL_POST_DIV                (2u)               /* SPLL_CLK = VCO / 2 */
+
+/***  Clock_ApplyConfig ***/
+#define CLOCK_WAIT_LOOPS                   (200000u)          /* Polls before a step times out */
+
 
 /*==================================================================================================
 *                                             ENUMS
 ==================================================================================================*/
+/**
+ * @brief   Clock return codes.
+ * @details Enumeration of the status returned by Clock_ApplyConfig().
+ */
+typedef enum {
+			CLOCK_OK          = 0u,             /*!< Success */
+			CLOCK_ERR_PARA    = 1u,             /*!< Parameter error */
+			CLOCK_ERR_TIMEOUT = 2u,             /*!< A clock did not become valid in time */
+}Clock_ret_t;
+
+
 /**
  * @brief   System clock sources.
  * @details Enumeration for the available system clock sources.
@@ -53,6 +79,38 @@ typedef enum {
 }system_hsrun_clock_source_t;
 
 
+/**
+ * @brief   System clock sources for VLPR.
+ * @details Only SIRC can clock the system in VLPR mode.
+ */
+typedef enum {
+			VLPR_SIRC_CLK = 2u,              /*!< SIRC clock */
+}system_vlpr_clock_source_t;
+
+
+/**
+ * @brief   Clock frequency names.
+ * @details Enumeration of the clocks whose frequency can be queried with Clock_GetFreq().
+ */
+typedef enum {
+			CLOCK_FREQ_CORE       = 0u,          /*!< Core / system clock */
+			CLOCK_FREQ_BUS        = 1u,          /*!< Bus clock */
+			CLOCK_FREQ_SLOW       = 2u,          /*!< Slow (flash) clock */
+			CLOCK_FREQ_SOSC       = 3u,          /*!< SOSC output */
+			CLOCK_FREQ_SIRC       = 4u,          /*!< SIRC output */
+			CLOCK_FREQ_FIRC       = 5u,          /*!< FIRC output */
+			CLOCK_FREQ_SPLL       = 6u,          /*!< SPLL output */
+			CLOCK_FREQ_SOSCDIV1   = 7u,          /*!< SOSCDIV1_CLK */
+			CLOCK_FREQ_SOSCDIV2   = 8u,          /*!< SOSCDIV2_CLK */
+			CLOCK_FREQ_SIRCDIV1   = 9u,          /*!< SIRCDIV1_CLK */
+			CLOCK_FREQ_SIRCDIV2   = 10u,         /*!< SIRCDIV2_CLK */
+			CLOCK_FREQ_FIRCDIV1   = 11u,         /*!< FIRCDIV1_CLK */
+			CLOCK_FREQ_FIRCDIV2   = 12u,         /*!< FIRCDIV2_CLK */
+			CLOCK_FREQ_SPLLDIV1   = 13u,         /*!< SPLLDIV1_CLK */
+			CLOCK_FREQ_SPLLDIV2   = 14u,         /*!< SPLLDIV2_CLK */
+}clock_freq_names_t;
+
+
 /**
  * @brief   Core clock divide ratios.
  * @details Enumeration for different core clock divide ratios.
@@ -123,19 +181,38 @@ typedef enum {
  */
 typedef enum {
 			/* PCC clocks */
+			FTFC_CLK                     = 32u,      	/*!< FTFC clock source */
+			DMAMUX_CLK                   = 33u,      	/*!< DMAMUX clock source */
+			FlexCAN0_CLK                 = 36u,      	/*!< FlexCAN0 clock source */
+			FlexCAN1_CLK                 = 37u,      	/*!< FlexCAN1 clock source */
+			FTM3_CLK                     = 38u,      	/*!< FTM3 clock source */
+			ADC1_CLK                     = 39u,      	/*!< ADC1 clock source */
+			FlexCAN2_CLK                 = 43u,      	/*!< FlexCAN2 clock source */
 			LPSPI0_CLK                   = 44u,     	/*!< LPSPI0 clock source */
 			LPSPI1_CLK                   = 45u,     	/*!< LPSPI1 clock source */
 			LPSPI2_CLK                   = 46u,      	/*!< LPSPI2 clock source */
+			PDB1_CLK                     = 49u,      	/*!< PDB1 clock source */
+			CRC_CLK                      = 50u,      	/*!< CRC clock source */
+			PDB0_CLK                     = 54u,      	/*!< PDB0 clock source */
 			LPIT0_CLK                    = 55u,      	/*!< LPIT0 clock source */
+			FTM0_CLK                     = 56u,      	/*!< FTM0 clock source */
+			FTM1_CLK                     = 57u,      	/*!< FTM1 clock source */
+			FTM2_CLK                     = 58u,      	/*!< FTM2 clock source */
 			ADC0_CLK                     = 59u,      	/*!< ADC0 clock source */
+			RTC_CLK                      = 61u,      	/*!< RTC clock source */
+			LPTMR0_CLK                   = 64u,      	/*!< LPTMR0 clock source */
 			PORTA_CLK                    = 73u,      	/*!< PORTA clock source */
 			PORTB_CLK                    = 74u,      	/*!< PORTB clock source */
 			PORTC_CLK                    = 75u,      	/*!< PORTC clock source */
 			PORTD_CLK                    = 76u,      	/*!< PORTD clock source */
 			PORTE_CLK                    = 77u,      	/*!< PORTE clock source */
+			FlexIO_CLK                   = 90u,      	/*!< FlexIO clock source */
+			EWM_CLK                      = 97u,      	/*!< EWM clock source */
+			LPI2C0_CLK                   = 102u,      /*!< LPI2C0 clock source */
 			LPUART0_CLK                  = 106u,      /*!< LPUART0 clock source */
 			LPUART1_CLK                  = 107u,      /*!< LPUART1 clock source */
 			LPUART2_CLK                  = 108u,      /*!< LPUART2 clock source */
+			CMP0_CLK                     = 115u,      /*!< CMP0 clock source */
 } clock_names_t;
 
 
@@ -287,6 +364,40 @@ typedef struct
 } Scg_HSRunMode_ConfigType;
 
 
+/**
+ * @brief   Configuration structure for VLPR Mode clock settings.
+ * @details This structure holds configuration for Very Low Power Run mode clock settings.
+ */
+typedef struct
+{
+			system_vlpr_clock_source_t       sys_clk_src;         /*!<  System Clock Source */
+			core_clock_divide_ratio_t        core_div;            /*!<  Core Clock Divide Ratio */
+			bus_clock_divide_ratio_t         bus_div;             /*!<  Bus Clock Divide Ratio */
+			slow_clock_divide_ratio_t        slow_div;            /*!<  Slow Clock Divide Ratio */
+} Scg_VlprMode_ConfigType;
+
+
+/**
+ * @brief   Clock configuration image.
+ * @details Final SCG register values, built at compile time by the CLOCK_CFG_*_IMAGE macros of
+ *          Clock_Cfg.h and applied by Clock_ApplyConfig().
+ */
+typedef struct
+{
+			unsigned int   soscDiv;             /*!< SCG_SOSCDIV */
+			unsigned int   soscCfg;             /*!< SCG_SOSCCFG */
+			unsigned int   sircDiv;             /*!< SCG_SIRCDIV */
+			unsigned int   fircDiv;             /*!< SCG_FIRCDIV */
+			unsigned int   spllDiv;             /*!< SCG_SPLLDIV */
+			unsigned int   spllCfg;             /*!< SCG_SPLLCFG */
+			unsigned int   rccr;                /*!< SCG_RCCR */
+			unsigned int   hccr;                /*!< SCG_HCCR */
+			unsigned int   vccr;                /*!< SCG_VCCR */
+			unsigned char  soscEnable;          /*!< Start the SOSC */
+			unsigned char  spllEnable;          /*!< Start the SPLL */
+} Clock_ConfigImageType;
+
+
 /*==================================================================================================
 *                                    FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -303,6 +414,18 @@ typedef struct
  */
 void Clock_SetPccConfig(const Pcc_ConfigType* ConfigPtr);
 
+/*!
+ * @brief Set several Peripheral Clock Control (PCC) configurations.
+ * 
+ * This function applies Clock_SetPccConfig() to every entry of a configuration table, e.g. the
+ * PCC table of the board configuration at start-up.
+ * 
+ * @param[in] ConfigPtr Pointer to the first PCC configuration structure.
+ * @param[in] count Number of entries in the table.
+ * @return void.
+ */
+void Clock_SetPccConfigs(const Pcc_ConfigType* ConfigPtr, unsigned int count);
+
 /*!
  * @brief Set FIRC configuration.
  * 
@@ -336,6 +459,7 @@ void Clock_SetScgSircConfig(const Scg_Sirc_ConfigType * ConfigPtr);
  * @param[in] ConfigPtr Pointer to the SOSC configuration structure.
  * @return void.
  * @note Ensure that the SOSC settings are appropriate for your application before calling this function.
+ *       This function blocks until the clock is valid; use ClockMgr for a bounded, non-blocking start-up.
  */
 void Clock_SetScgSoscConfig(const Scg_Sosc_ConfigType * ConfigPtr);
 
@@ -348,9 +472,80 @@ void Clock_SetScgSoscConfig(const Scg_Sosc_ConfigType * ConfigPtr);
  * @param[in] ConfigPtr Pointer to the SPLL configuration structure.
  * @return void.
  * @note Ensure that the SPLL settings are appropriate for your application before calling this function.
+ *       This function blocks until the clock is valid; use ClockMgr for a bounded, non-blocking start-up.
  */
 void Clock_SetScgSpllConfig(const Scg_Spll_ConfigType * ConfigPtr);
 
+/*!
+ * @brief Start the SOSC without waiting for it.
+ * 
+ * This function performs the configuration steps of Clock_SetScgSoscConfig() and enables the
+ * oscillator, but returns immediately. Use Clock_IsScgSoscValid() to poll for start-up.
+ * 
+ * @param[in] ConfigPtr Pointer to the SOSC configuration structure.
+ * @return void.
+ */
+void Clock_EnableScgSosc(const Scg_Sosc_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Check whether the SOSC output is valid.
+ * 
+ * @return 1 when the SOSC is enabled and valid, 0 otherwise.
+ */
+unsigned char Clock_IsScgSoscValid(void);
+
+/*!
+ * @brief Disable the SOSC.
+ * 
+ * @return void.
+ * @note The SOSC must not be the system clock or the SPLL source when it is disabled.
+ */
+void Clock_DisableScgSosc(void);
+
+/*!
+ * @brief Start the SPLL without waiting for lock.
+ * 
+ * This function performs the configuration steps of Clock_SetScgSpllConfig() and enables the
+ * PLL, but returns immediately. Use Clock_IsScgSpllValid() to poll for lock.
+ * 
+ * @param[in] ConfigPtr Pointer to the SPLL configuration structure.
+ * @return void.
+ */
+void Clock_EnableScgSpll(const Scg_Spll_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Check whether the SPLL output is valid.
+ * 
+ * @return 1 when the SPLL is enabled and locked, 0 otherwise.
+ */
+unsigned char Clock_IsScgSpllValid(void);
+
+/*!
+ * @brief Disable the SPLL.
+ * 
+ * @return void.
+ * @note The SPLL must not be the system clock when it is disabled.
+ */
+void Clock_DisableScgSpll(void);
+
+/*!
+ * @brief Write the Run Mode configuration without waiting for the switch.
+ * 
+ * @param[in] ConfigPtr Pointer to the Run Mode configuration structure.
+ * @return void.
+ */
+void Clock_WriteScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Get the system clock source currently in use.
+ * 
+ * This function reads the SCG Clock Status Register, which reflects the clock source actually
+ * driving the core after a mode or source switch has completed.
+ * 
+ * @return System clock source.
+ */
+system_clock_source_t Clock_GetSysClockSource(void);
+
 /*!
  * @brief Set Run Mode configuration.
  * 
@@ -375,4 +570,81 @@ void Clock_SetScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr);
  */
 void Clock_SetScgHSRunModeConfig(const Scg_HSRunMode_ConfigType * ConfigPtr);
 
+/*!
+ * @brief Set VLPR Mode configuration.
+ * 
+ * This function writes the VLPR clock control register. The configuration takes effect when the
+ * SMC enters VLPR mode.
+ * 
+ * @param[in] ConfigPtr Pointer to the VLPR Mode configuration structure.
+ * @return void.
+ */
+void Clock_SetScgVlprModeConfig(const Scg_VlprMode_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Enable the FIRC.
+ * 
+ * @return void.
+ */
+void Clock_EnableScgFirc(void);
+
+/*!
+ * @brief Check whether the FIRC output is valid.
+ * 
+ * @return 1 when the FIRC is enabled and valid, 0 otherwise.
+ */
+unsigned char Clock_IsScgFircValid(void);
+
+/*!
+ * @brief Disable the FIRC.
+ * 
+ * @return void.
+ * @note The FIRC must not be the system clock or the SPLL source when it is disabled.
+ */
+void Clock_DisableScgFirc(void);
+
+/*!
+ * @brief Get the frequency of a clock.
+ * 
+ * This function computes the frequency from the SCG registers. Core, bus and slow clocks are
+ * read from SCG_CSR, so they reflect the power mode in use (RUN, HSRUN or VLPR).
+ * 
+ * @param[in] name Clock to query.
+ * @return Frequency in Hz, 0 when the clock is disabled or not valid.
+ */
+unsigned int Clock_GetFreq(clock_freq_names_t name);
+
+/*!
+ * @brief Compute the SPLL output frequency of a configuration.
+ * 
+ * @param[in] ConfigPtr Pointer to the SPLL configuration structure.
+ * @return SPLL_CLK frequency in Hz.
+ */
+unsigned int Clock_CalcSpllFreq(const Scg_Spll_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Apply a precomputed clock configuration image.
+ * 
+ * This function brings up the clock tree from a register image built at compile time (see
+ * Clock_Cfg.h). Every SCG register is written with one store, in the order required by the
+ * reference manual: SOSC, SIRC and FIRC dividers, SPLL, the HSRUN and VLPR controls, and finally
+ * the RUN clock control. Each wait is bounded by CLOCK_WAIT_LOOPS.
+ * 
+ * @param[in] ImagePtr Pointer to the clock configuration image.
+ * @return CLOCK_OK on success, CLOCK_ERR_PARA or CLOCK_ERR_TIMEOUT on error.
+ * @note The system clock must be FIRC (the reset default) when this function is called.
+ */
+Clock_ret_t Clock_ApplyConfig(const Clock_ConfigImageType * ImagePtr);
+
+/*!
+ * @brief Get the functional clock frequency of a peripheral.
+ * 
+ * This function decodes the PCS field of the peripheral PCC slot and returns the frequency of
+ * the selected asynchronous divider output (SOSCDIV2, SIRCDIV2, FIRCDIV2 or SPLLDIV2).
+ * 
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return Frequency in Hz, 0 when the clock is gated, off, or the source is not valid.
+ */
+unsigned int Clock_GetPccFunctionalFreq(clock_names_t clockName);
+
 #endif  /* CLOCK_H */
@@ -0,0 +1,114 @@
+/****************************************************************************************************
+* @file     ClockGate.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the reference-counted peripheral clock gating manager.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           sharing PCC clock gates between drivers. A clock is enabled when its first user requests
+*           it and gated again when its last user releases it. The active set and an estimated
+*           current draw can be reported to find clocks that are left running.
+* @version  1.0.0
+* @date     2024-10-29
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CLOCKGATE_H
+#define CLOCKGATE_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define CLOCKGATE_MAX_REFS                  (255u)             /* Maximum users of one clock */
+#define CLOCKGATE_SET_WORDS                 ((PCC_SLOT_COUNT + 31u) / 32u)   /* Words of a slot bit set */
+
+/*** Slot bit set access, bit n is PCC slot n ***/
+#define CLOCKGATE_SET_CHECK(SET, SLOT)      (((SET)[(SLOT) >> 5u] >> ((SLOT) & 31u)) & VALUE_CHECK_BIT)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Clock Gate Return Status Type
+ */
+typedef enum
+{
+			CLOCKGATE_OK          = 0U,       /**< Operation completed successfully. */
+			CLOCKGATE_ERR_PARA    = 1U,       /**< Unknown PCC slot or invalid clock source */
+			CLOCKGATE_ERR_SOURCE  = 2U,       /**< Clock already running from another source */
+			CLOCKGATE_ERR_COUNT   = 3U,       /**< Reference count overflow or release without request */
+} ClockGate_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Clock gating report.
+ * @details Snapshot of the PCC gates, built from the hardware registers so that clocks enabled
+ *          outside this manager are also seen.
+ */
+typedef struct
+{
+			unsigned int   active[CLOCKGATE_SET_WORDS];   /*!< Slots whose clock gate is enabled */
+			unsigned int   leaked[CLOCKGATE_SET_WORDS];   /*!< Enabled slots without a reference */
+			unsigned char  activeCount;                   /*!< Number of enabled slots */
+			unsigned char  leakedCount;                   /*!< Number of leaked slots */
+			unsigned int   currentUa;                     /*!< Estimated current of the enabled slots in uA */
+} ClockGate_ReportType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Request a peripheral clock.
+ *
+ * The first request selects the functional clock source and enables the clock gate. Later
+ * requests only increment the reference count and must ask for the same source.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @param[in] clkSrc Functional clock source, CLK_SRC_OFF for peripherals without one.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA, CLOCKGATE_ERR_SOURCE or CLOCKGATE_ERR_COUNT on error.
+ * @note Call from thread context; the reference counts are not protected against interrupts.
+ */
+ClockGate_ret_t ClockGate_Request(clock_names_t clockName, peripheral_clock_source_t clkSrc);
+
+/*!
+ * @brief Release a peripheral clock.
+ *
+ * The clock gate is disabled when the last user releases the clock.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA or CLOCKGATE_ERR_COUNT on error.
+ * @note The peripheral must be idle before its last user releases it.
+ */
+ClockGate_ret_t ClockGate_Release(clock_names_t clockName);
+
+/*!
+ * @brief Get the reference count of a peripheral clock.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return Number of users, 0 for unknown slots.
+ */
+unsigned char ClockGate_GetRefCount(clock_names_t clockName);
+
+/*!
+ * @brief Report the active clocks and the estimated current draw.
+ *
+ * The current is estimated from per-peripheral figures in uA/MHz at the bus clock and is meant
+ * to compare configurations, not to replace a measurement.
+ *
+ * @param[out] ReportPtr Pointer to the report structure.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA on parameter error.
+ */
+ClockGate_ret_t ClockGate_GetReport(ClockGate_ReportType * ReportPtr);
+
+#endif  /* CLOCKGATE_H */
@@ -0,0 +1,137 @@
+/****************************************************************************************************
+* @file     ClockMgr.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the non-blocking clock bring-up manager.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           starting the SOSC and the SPLL in the background while the system keeps running on
+*           FIRC, switching to the PLL once it is valid, and falling back to a safe clock when an
+*           oscillator does not start within its timeout.
+* @version  1.0.0
+* @date     2024-10-24
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CLOCKMGR_H
+#define CLOCKMGR_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** SPLL reference selection (Scg_Spll_ConfigType.src) ***/
+#define CLOCKMGR_SPLL_SRC_SOSC              (0u)               /* SPLL fed by SOSC */
+#define CLOCKMGR_SPLL_SRC_FIRC              (1u)               /* SPLL fed by FIRC */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Clock Manager Return Status Type
+ */
+typedef enum
+{
+			CLOCKMGR_OK         = 0U,       /**< Operation completed successfully. */
+			CLOCKMGR_ERR_PARA   = 1U,       /**< Parameter error */
+			CLOCKMGR_ERR_BUSY   = 2U,       /**< A bring-up sequence is already running */
+} ClockMgr_ret_t;
+
+/**
+ * @brief     Clock Manager State
+ */
+typedef enum
+{
+			CLOCKMGR_STATE_IDLE          = 0U,  /**< Not started, running on the reset clock. */
+			CLOCKMGR_STATE_SOSC_STARTUP  = 1U,  /**< Waiting for the SOSC to become valid. */
+			CLOCKMGR_STATE_SPLL_LOCK     = 2U,  /**< Waiting for the SPLL to lock. */
+			CLOCKMGR_STATE_SWITCHING     = 3U,  /**< Waiting for the system clock switch. */
+			CLOCKMGR_STATE_RUN_TARGET    = 4U,  /**< Running on the target configuration. */
+			CLOCKMGR_STATE_RUN_FALLBACK  = 5U,  /**< Running on the fallback configuration. */
+} ClockMgr_state_t;
+
+/**
+ * @brief     Clock Manager Fault
+ */
+typedef enum
+{
+			CLOCKMGR_FAULT_NONE          = 0U,  /**< No fault. */
+			CLOCKMGR_FAULT_SOSC_TIMEOUT  = 1U,  /**< SOSC did not become valid in time (dead crystal). */
+			CLOCKMGR_FAULT_SPLL_TIMEOUT  = 2U,  /**< SPLL did not lock in time. */
+			CLOCKMGR_FAULT_SWITCH_TIMEOUT= 3U,  /**< System clock did not switch in time. */
+} ClockMgr_fault_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Clock change notification.
+ * @details Called once the final clock configuration is in use, so that SysTick and other
+ *          peripherals can be retuned.
+ */
+typedef void (*ClockMgr_NotifyType)(ClockMgr_state_t state, ClockMgr_fault_t fault);
+
+/**
+ * @brief   Configuration structure for the clock manager.
+ */
+typedef struct
+{
+			const Scg_Sosc_ConfigType *      soscConfig;       /*!< SOSC configuration, NULL when not used */
+			const Scg_Spll_ConfigType *      spllConfig;       /*!< SPLL configuration */
+			const Scg_RunMode_ConfigType *   targetConfig;     /*!< RUN configuration using the SPLL */
+			const Scg_RunMode_ConfigType *   fallbackConfig;   /*!< RUN configuration used on failure (FIRC) */
+			unsigned int                     soscTimeoutMs;    /*!< SOSC start-up timeout */
+			unsigned int                     spllTimeoutMs;    /*!< SPLL lock timeout */
+			unsigned int                     switchTimeoutMs;  /*!< System clock switch timeout */
+			ClockMgr_NotifyType              notify;           /*!< Completion notification, may be NULL */
+} ClockMgr_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Starts the clock bring-up sequence.
+ *
+ * This function enables the SOSC (or the SPLL directly when it is fed by FIRC) and returns
+ * immediately. The system keeps running on its current clock until ClockMgr_Process() switches.
+ *
+ * @param[in] ConfigPtr Pointer to the clock manager configuration structure.
+ * @param[in] nowMs Current time in milliseconds, used for the timeouts.
+ * @return CLOCKMGR_OK on success, CLOCKMGR_ERR_PARA or CLOCKMGR_ERR_BUSY on error.
+ */
+ClockMgr_ret_t ClockMgr_Start(const ClockMgr_ConfigType * ConfigPtr, unsigned int nowMs);
+
+/*!
+ * @brief Advances the clock bring-up sequence.
+ *
+ * Call this from the main loop during initialization, or from SCG_IRQHandler. Every call returns
+ * without waiting.
+ *
+ * @param[in] nowMs Current time in milliseconds.
+ * @return Current state.
+ */
+ClockMgr_state_t ClockMgr_Process(unsigned int nowMs);
+
+/*!
+ * @brief Retrieves the current state.
+ *
+ * @return Current state.
+ */
+ClockMgr_state_t ClockMgr_GetState(void);
+
+/*!
+ * @brief Retrieves the fault that caused the fallback.
+ *
+ * @return Fault, CLOCKMGR_FAULT_NONE when none occurred.
+ */
+ClockMgr_fault_t ClockMgr_GetFault(void);
+
+#endif  /* CLOCKMGR_H */
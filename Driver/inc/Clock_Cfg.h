@@ -0,0 +1,198 @@
+/****************************************************************************************************
+* @file     Clock_Cfg.h
+* @author   Ma Hien Nhan
+* @brief    Compile-time clock configuration.
+* @details  This header file describes the clock tree (sources, dividers, SPLL pre-divider and
+*           multiplier, RUN / HSRUN / VLPR dividers) with macros, checks the resulting frequencies
+*           against the data sheet limits at compile time, and reduces the description to the final
+*           SCG register images used by Clock_ApplyConfig().
+* @version  1.0.0
+* @date     2024-10-28
+* @note     Override any CLOCK_CFG_* macro from the compiler command line to change the clock tree.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CLOCK_CFG_H
+#define CLOCK_CFG_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock.h"
+#include "Perf.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/***  SOSC ***/
+#ifndef CLOCK_CFG_SOSC_ENABLE
+#define CLOCK_CFG_SOSC_ENABLE              (1u)
+#endif
+#ifndef CLOCK_CFG_SOSC_RANGE
+#define CLOCK_CFG_SOSC_RANGE               (SCG_RANGE_MCS)    /* 8 MHz crystal */
+#endif
+#ifndef CLOCK_CFG_SOSC_DIV1
+#define CLOCK_CFG_SOSC_DIV1                (SCG_CLOCK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_SOSC_DIV2
+#define CLOCK_CFG_SOSC_DIV2                (SCG_CLOCK_DIV_BY_1)
+#endif
+
+/***  SIRC / FIRC ***/
+#ifndef CLOCK_CFG_SIRC_DIV1
+#define CLOCK_CFG_SIRC_DIV1                (SCG_CLOCK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_SIRC_DIV2
+#define CLOCK_CFG_SIRC_DIV2                (SCG_CLOCK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_FIRC_DIV1
+#define CLOCK_CFG_FIRC_DIV1                (SCG_CLOCK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_FIRC_DIV2
+#define CLOCK_CFG_FIRC_DIV2                (SCG_CLOCK_DIV_BY_1)
+#endif
+
+/***  SPLL ***/
+#ifndef CLOCK_CFG_SPLL_ENABLE
+#define CLOCK_CFG_SPLL_ENABLE              (1u)
+#endif
+#ifndef CLOCK_CFG_SPLL_SRC
+#define CLOCK_CFG_SPLL_SRC                 (0u)               /* 0: SOSC, 1: FIRC */
+#endif
+#ifndef CLOCK_CFG_SPLL_PREDIV
+#define CLOCK_CFG_SPLL_PREDIV              (0u)               /* Divide-by-(PREDIV + 1) */
+#endif
+#ifndef CLOCK_CFG_SPLL_MULT
+#define CLOCK_CFG_SPLL_MULT                (12u)              /* Multiply-by-(MULT + 16) */
+#endif
+#ifndef CLOCK_CFG_SPLL_DIV1
+#define CLOCK_CFG_SPLL_DIV1                (SCG_CLOCK_DIV_BY_2)
+#endif
+#ifndef CLOCK_CFG_SPLL_DIV2
+#define CLOCK_CFG_SPLL_DIV2                (SCG_CLOCK_DIV_BY_4)
+#endif
+
+/***  RUN ***/
+#ifndef CLOCK_CFG_RUN_SRC
+#define CLOCK_CFG_RUN_SRC                  (SPLL_CLK)
+#endif
+#ifndef CLOCK_CFG_RUN_DIVCORE
+#define CLOCK_CFG_RUN_DIVCORE              (CORE_CLK_DIV_BY_2)
+#endif
+#ifndef CLOCK_CFG_RUN_DIVBUS
+#define CLOCK_CFG_RUN_DIVBUS               (BUS_CLK_DIV_BY_2)
+#endif
+#ifndef CLOCK_CFG_RUN_DIVSLOW
+#define CLOCK_CFG_RUN_DIVSLOW              (SLOW_CLK_DIV_BY_3)
+#endif
+
+/***  HSRUN ***/
+#ifndef CLOCK_CFG_HSRUN_SRC
+#define CLOCK_CFG_HSRUN_SRC                (HSRUN_SPLL_CLK)
+#endif
+#ifndef CLOCK_CFG_HSRUN_DIVCORE
+#define CLOCK_CFG_HSRUN_DIVCORE            (CORE_CLK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_HSRUN_DIVBUS
+#define CLOCK_CFG_HSRUN_DIVBUS             (BUS_CLK_DIV_BY_2)
+#endif
+#ifndef CLOCK_CFG_HSRUN_DIVSLOW
+#define CLOCK_CFG_HSRUN_DIVSLOW            (SLOW_CLK_DIV_BY_4)
+#endif
+
+/***  VLPR ***/
+#ifndef CLOCK_CFG_VLPR_DIVCORE
+#define CLOCK_CFG_VLPR_DIVCORE             (CORE_CLK_DIV_BY_2)
+#endif
+#ifndef CLOCK_CFG_VLPR_DIVBUS
+#define CLOCK_CFG_VLPR_DIVBUS              (BUS_CLK_DIV_BY_1)
+#endif
+#ifndef CLOCK_CFG_VLPR_DIVSLOW
+#define CLOCK_CFG_VLPR_DIVSLOW             (SLOW_CLK_DIV_BY_4)
+#endif
+
+/***  Derived frequencies ***/
+#define CLOCK_CFG_SPLL_REF_HZ              (((CLOCK_CFG_SPLL_SRC == 0u) ? CLOCK_SOSC_FREQ_HZ : CLOCK_FIRC_FREQ_HZ) / \
+                                            (CLOCK_CFG_SPLL_PREDIV + 1u))
+#define CLOCK_CFG_SPLL_VCO_HZ              (CLOCK_CFG_SPLL_REF_HZ * (CLOCK_CFG_SPLL_MULT + CLOCK_SPLL_MULT_OFFSET))
+#define CLOCK_CFG_SPLL_HZ                  (CLOCK_CFG_SPLL_VCO_HZ / CLOCK_SPLL_POST_DIV)
+
+/* Frequency of a system clock source (SCS encoding) */
+#define CLOCK_CFG_SRC_HZ(SCS)              (((unsigned int)(SCS) == (unsigned int)SOSC_CLK) ? CLOCK_SOSC_FREQ_HZ :      \
+                                            ((unsigned int)(SCS) == (unsigned int)SIRC_CLK) ? CLOCK_SIRC_HIGH_FREQ_HZ : \
+                                            ((unsigned int)(SCS) == (unsigned int)FIRC_CLK) ? CLOCK_FIRC_FREQ_HZ :      \
+                                            CLOCK_CFG_SPLL_HZ)
+
+#define CLOCK_CFG_RUN_CORE_HZ              (CLOCK_CFG_SRC_HZ(CLOCK_CFG_RUN_SRC) / (CLOCK_CFG_RUN_DIVCORE + 1u))
+#define CLOCK_CFG_RUN_BUS_HZ               (CLOCK_CFG_RUN_CORE_HZ / (CLOCK_CFG_RUN_DIVBUS + 1u))
+#define CLOCK_CFG_RUN_SLOW_HZ              (CLOCK_CFG_RUN_CORE_HZ / (CLOCK_CFG_RUN_DIVSLOW + 1u))
+#define CLOCK_CFG_HSRUN_CORE_HZ            (CLOCK_CFG_SRC_HZ(CLOCK_CFG_HSRUN_SRC) / (CLOCK_CFG_HSRUN_DIVCORE + 1u))
+#define CLOCK_CFG_HSRUN_BUS_HZ             (CLOCK_CFG_HSRUN_CORE_HZ / (CLOCK_CFG_HSRUN_DIVBUS + 1u))
+#define CLOCK_CFG_HSRUN_SLOW_HZ            (CLOCK_CFG_HSRUN_CORE_HZ / (CLOCK_CFG_HSRUN_DIVSLOW + 1u))
+#define CLOCK_CFG_VLPR_CORE_HZ             (CLOCK_SIRC_HIGH_FREQ_HZ / (CLOCK_CFG_VLPR_DIVCORE + 1u))
+#define CLOCK_CFG_VLPR_BUS_HZ              (CLOCK_CFG_VLPR_CORE_HZ / (CLOCK_CFG_VLPR_DIVBUS + 1u))
+#define CLOCK_CFG_VLPR_SLOW_HZ             (CLOCK_CFG_VLPR_CORE_HZ / (CLOCK_CFG_VLPR_DIVSLOW + 1u))
+
+/***  SPLL data sheet limits ***/
+#define CLOCK_CFG_SPLL_REF_MIN_HZ          (8000000u)
+#define CLOCK_CFG_SPLL_REF_MAX_HZ          (16000000u)
+#define CLOCK_CFG_SPLL_VCO_MIN_HZ          (180000000u)
+#define CLOCK_CFG_SPLL_VCO_MAX_HZ          (320000000u)
+
+/***  Register images ***/
+#define CLOCK_CFG_DIV_IMAGE(DIV1, DIV2)    (((unsigned int)(DIV1) << SCG_SOSCDIV_SOSCDIV1_SHIFT) | \
+                                            ((unsigned int)(DIV2) << SCG_SOSCDIV_SOSCDIV2_SHIFT))
+#define CLOCK_CFG_CCR_IMAGE(SCS, CORE, BUS, SLOW) \
+                                           (((unsigned int)(SCS)  << SCG_RCCR_SCS_SHIFT)     | \
+                                            ((unsigned int)(CORE) << SCG_RCCR_DIVCORE_SHIFT) | \
+                                            ((unsigned int)(BUS)  << SCG_RCCR_DIVBUS_SHIFT)  | \
+                                            ((unsigned int)(SLOW) << SCG_RCCR_DIVSLOW_SHIFT))
+
+#define CLOCK_CFG_SOSCDIV_IMAGE            CLOCK_CFG_DIV_IMAGE(CLOCK_CFG_SOSC_DIV1, CLOCK_CFG_SOSC_DIV2)
+#define CLOCK_CFG_SOSCCFG_IMAGE            (((unsigned int)CLOCK_CFG_SOSC_RANGE << SCG_SOSCCFG_RANGE_SHIFT) | \
+                                            (SCG_SOSCCFG_EREFS_IOSC << SCG_SOSCCFG_EREFS_SHIFT))
+#define CLOCK_CFG_SIRCDIV_IMAGE            CLOCK_CFG_DIV_IMAGE(CLOCK_CFG_SIRC_DIV1, CLOCK_CFG_SIRC_DIV2)
+#define CLOCK_CFG_FIRCDIV_IMAGE            CLOCK_CFG_DIV_IMAGE(CLOCK_CFG_FIRC_DIV1, CLOCK_CFG_FIRC_DIV2)
+#define CLOCK_CFG_SPLLDIV_IMAGE            CLOCK_CFG_DIV_IMAGE(CLOCK_CFG_SPLL_DIV1, CLOCK_CFG_SPLL_DIV2)
+#define CLOCK_CFG_SPLLCFG_IMAGE            (((unsigned int)CLOCK_CFG_SPLL_SRC    << SCG_SPLLCFG_SOURCE_SHIFT) | \
+                                            ((unsigned int)CLOCK_CFG_SPLL_PREDIV << SCG_SPLLCFG_PREDIV_SHIFT) | \
+                                            ((unsigned int)CLOCK_CFG_SPLL_MULT   << SCG_SPLLCFG_MULT_SHIFT))
+#define CLOCK_CFG_RCCR_IMAGE               CLOCK_CFG_CCR_IMAGE(CLOCK_CFG_RUN_SRC, CLOCK_CFG_RUN_DIVCORE, \
+                                                               CLOCK_CFG_RUN_DIVBUS, CLOCK_CFG_RUN_DIVSLOW)
+#define CLOCK_CFG_HCCR_IMAGE               CLOCK_CFG_CCR_IMAGE(CLOCK_CFG_HSRUN_SRC, CLOCK_CFG_HSRUN_DIVCORE, \
+                                                               CLOCK_CFG_HSRUN_DIVBUS, CLOCK_CFG_HSRUN_DIVSLOW)
+#define CLOCK_CFG_VCCR_IMAGE               CLOCK_CFG_CCR_IMAGE(VLPR_SIRC_CLK, CLOCK_CFG_VLPR_DIVCORE, \
+                                                               CLOCK_CFG_VLPR_DIVBUS, CLOCK_CFG_VLPR_DIVSLOW)
+
+/***  Compile-time checks ***/
+STATIC_ASSERT((CLOCK_CFG_SPLL_ENABLE == 0u) || (CLOCK_CFG_SPLL_SRC != 0u) || (CLOCK_CFG_SOSC_ENABLE != 0u),
+              clock_cfg_spll_needs_sosc);
+STATIC_ASSERT((CLOCK_CFG_SPLL_PREDIV <= SCG_SPLLCFG_PREDIV_MASK) && (CLOCK_CFG_SPLL_MULT <= SCG_SPLLCFG_MULT_MASK),
+              clock_cfg_spll_field_range);
+STATIC_ASSERT((CLOCK_CFG_SPLL_ENABLE == 0u) ||
+              ((CLOCK_CFG_SPLL_REF_HZ >= CLOCK_CFG_SPLL_REF_MIN_HZ) && (CLOCK_CFG_SPLL_REF_HZ <= CLOCK_CFG_SPLL_REF_MAX_HZ)),
+              clock_cfg_spll_reference);
+STATIC_ASSERT((CLOCK_CFG_SPLL_ENABLE == 0u) ||
+              ((CLOCK_CFG_SPLL_VCO_HZ >= CLOCK_CFG_SPLL_VCO_MIN_HZ) && (CLOCK_CFG_SPLL_VCO_HZ <= CLOCK_CFG_SPLL_VCO_MAX_HZ)),
+              clock_cfg_spll_vco);
+STATIC_ASSERT(((unsigned int)CLOCK_CFG_RUN_SRC != (unsigned int)SPLL_CLK) || (CLOCK_CFG_SPLL_ENABLE != 0u),
+              clock_cfg_run_source);
+STATIC_ASSERT(((unsigned int)CLOCK_CFG_RUN_SRC != (unsigned int)SOSC_CLK) || (CLOCK_CFG_SOSC_ENABLE != 0u),
+              clock_cfg_run_sosc);
+STATIC_ASSERT((CLOCK_CFG_RUN_CORE_HZ <= PERF_RUN_MAX_CORE_HZ) && (CLOCK_CFG_RUN_BUS_HZ <= PERF_RUN_MAX_BUS_HZ) &&
+              (CLOCK_CFG_RUN_SLOW_HZ <= PERF_RUN_MAX_SLOW_HZ), clock_cfg_run_limits);
+STATIC_ASSERT((CLOCK_CFG_HSRUN_CORE_HZ <= PERF_HSRUN_MAX_CORE_HZ) && (CLOCK_CFG_HSRUN_BUS_HZ <= PERF_HSRUN_MAX_BUS_HZ) &&
+              (CLOCK_CFG_HSRUN_SLOW_HZ <= PERF_HSRUN_MAX_SLOW_HZ), clock_cfg_hsrun_limits);
+STATIC_ASSERT((CLOCK_CFG_VLPR_CORE_HZ <= PERF_VLPR_MAX_CORE_HZ) && (CLOCK_CFG_VLPR_BUS_HZ <= PERF_VLPR_MAX_BUS_HZ) &&
+              (CLOCK_CFG_VLPR_SLOW_HZ <= PERF_VLPR_MAX_SLOW_HZ), clock_cfg_vlpr_limits);
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+extern const Clock_ConfigImageType Clock_CfgImage;      /* Image built from the CLOCK_CFG_* macros */
+
+#endif  /* CLOCK_CFG_H */
@@ -25,16 +25,32 @@
 /***  Peripheral Clock Control (PCC) ***/
 #define PCC_CGC_SHIFT                       (30u)
 #define PCC_PCS_SHIFT                       (24u)
+#define PCC_PCS_MASK                        (0x07000000u)      /* Peripheral Clock Source Select */
+#define PCC_PR_SHIFT                        (31u)              /* Present */
+#define PCC_SLOT_COUNT                      (122u)             /* Number of PCC slots */
 
 /***  System Clock Generator (SCG) ***/
 #define SCG_CSR_LK_SHIFT                    (23u)              /* Lock Register */
 #define SCG_CSR_VLD_SHIFT                   (24u)              /* Valid */
+#define SCG_CSR_EN_SHIFT                    (0u)               /* Clock enable */
+
+/* CSR - Clock Status Register */
+#define SCG_CSR_SCS_SHIFT                   (24u)              /* System Clock Source */
+#define SCG_CSR_SCS_MASK                    (0x0F000000u)      /* System Clock Source mask */
+
+/* Asynchronous clock divider fields (xxxDIV1, xxxDIV2) */
+#define SCG_ASYNC_DIV_MASK                  (0x7u)             /* Width mask of one divider field */
+
+/* Run clock control fields (CSR, RCCR, VCCR, HCCR share one layout) */
+#define SCG_CCR_DIV_MASK                    (0xFu)             /* Width mask of DIVCORE, DIVBUS, DIVSLOW */
 
 /* FIRC - Fast IRC */
 #define SCG_FIRCDIV_FIRCDIV1_SHIFT          (0u)               /* Fast IRC Clock Divide 1 */
 #define SCG_FIRCDIV_FIRCDIV2_SHIFT          (8u)               /* Fast IRC Clock Divide 2 */
 
 /* SIRC - Slow IRC */
+#define SCG_SIRCCSR_SIRCSTEN_SHIFT          (1u)               /* SIRC enabled in Stop modes */
+#define SCG_SIRCCSR_SIRCLPEN_SHIFT          (2u)               /* SIRC enabled in VLP modes */
 #define SCG_SIRCCFG_RANGE_SHIFT             (0u)               /* Frequency Range */
 #define SCG_SIRCDIV_SIRCDIV1_SHIFT          (0u)               /* Slow IRC Clock Divide 1 */
 #define SCG_SIRCDIV_SIRCDIV2_SHIFT          (8u)               /* Slow IRC Clock Divide 2 */
@@ -49,6 +65,9 @@
 #define SCG_SPLLCFG_SOURCE_SHIFT            (0u)               /* Clock Source */
 #define SCG_SPLLCFG_PREDIV_SHIFT            (8u)               /* PLL Reference Clock Divider */
 #define SCG_SPLLCFG_MULT_SHIFT              (16u)              /* System PLL Multiplier */
+#define SCG_SPLLCFG_SOURCE_MASK             (0x1u)             /* Clock Source width mask */
+#define SCG_SPLLCFG_PREDIV_MASK             (0x7u)             /* PLL Reference Clock Divider width mask */
+#define SCG_SPLLCFG_MULT_MASK               (0x1Fu)            /* System PLL Multiplier width mask */
 #define SCG_SPLLDIV_SPLLDIV1_SHIFT          (0u)               /* System PLL Clock Divide 1 */
 #define SCG_SPLLDIV_SPLLDIV2_SHIFT          (8u)               /* System PLL Clock Divide 2 */
 
@@ -70,6 +89,38 @@
 #define SCG_HCCR_DIVCORE_SHIFT              (16u)              /* Core Clock Divide Ratio */
 #define SCG_HCCR_SCS_SHIFT                  (24u)              /* System Clock Source */
 
+/****** Fields, (shift, width, access) for FIELD_SET() and REG_UPDATE() ******/
+/* PCCn */
+#define PCC_PCCn_PCS                        (24u, 3u, FIELD_RW)  /* Peripheral Clock Source Select */
+#define PCC_PCCn_CGC                        (30u, 1u, FIELD_RW)  /* Clock Gate Control */
+#define PCC_PCCn_PR                         (31u, 1u, FIELD_RO)  /* Present */
+
+/* SOSCCSR, SIRCCSR, FIRCCSR, SPLLCSR share one layout */
+#define SCG_OSCCSR_EN                       (0u, 1u, FIELD_RW)   /* Clock enable */
+#define SCG_OSCCSR_LK                       (23u, 1u, FIELD_RW)  /* Lock Register */
+#define SCG_OSCCSR_VLD                      (24u, 1u, FIELD_RO)  /* Valid */
+#define SCG_OSCCSR_ERR                      (26u, 1u, FIELD_W1C) /* Clock error, SOSC and SPLL monitors */
+#define SCG_OSCCSR_W1C                      FIELD_MASK(SCG_OSCCSR_ERR)
+
+/* SOSCDIV, SIRCDIV, FIRCDIV, SPLLDIV share one layout */
+#define SCG_OSCDIV_DIV1                     (0u, 3u, FIELD_RW)   /* Clock Divide 1 */
+#define SCG_OSCDIV_DIV2                     (8u, 3u, FIELD_RW)   /* Clock Divide 2 */
+
+/* SOSCCFG */
+#define SCG_SOSCCFG_EREFS                   (2u, 1u, FIELD_RW)   /* External Reference Select */
+#define SCG_SOSCCFG_RANGE                   (4u, 2u, FIELD_RW)   /* Frequency Range */
+
+/* SPLLCFG */
+#define SCG_SPLLCFG_SOURCE                  (0u, 1u, FIELD_RW)   /* Clock Source */
+#define SCG_SPLLCFG_PREDIV                  (8u, 3u, FIELD_RW)   /* PLL Reference Clock Divider */
+#define SCG_SPLLCFG_MULT                    (16u, 5u, FIELD_RW)  /* System PLL Multiplier */
+
+/* CSR, RCCR, VCCR, HCCR share one layout */
+#define SCG_CCR_DIVSLOW                     (0u, 4u, FIELD_RW)   /* Slow Clock Divide Ratio */
+#define SCG_CCR_DIVBUS                      (4u, 4u, FIELD_RW)   /* Bus Clock Divide Ratio */
+#define SCG_CCR_DIVCORE                     (16u, 4u, FIELD_RW)  /* Core Clock Divide Ratio */
+#define SCG_CCR_SCS                         (24u, 4u, FIELD_RW)  /* System Clock Source */
+
 /*** Peripheral PCC base address ***/
 #define PCC_BASE_ADDRESS                    (0x40065000u)
 
@@ -84,7 +135,7 @@
  * @details This structure represents the PCC register set.
  */
 typedef struct {
-			volatile unsigned int PCCn[122];
+			volatile unsigned int PCCn[PCC_SLOT_COUNT];
 } PCC_Type;
 
 
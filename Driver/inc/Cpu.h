@@ -0,0 +1,139 @@
+/****************************************************************************************************
+* @file     Cpu.h
+* @author   Ma Hien Nhan
+* @brief    Header file for Cortex-M4 core instructions.
+* @details  This header file contains the barrier, sleep and interrupt masking instructions used by
+*           the drivers. They are inline so that a critical section costs two instructions.
+* @version  1.0.0
+* @date     2024-10-30
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CPU_H
+#define CPU_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Barriers ***/
+#define CPU_DSB()                   __asm volatile ("dsb" : : : "memory")     /* Data synchronization barrier */
+#define CPU_ISB()                   __asm volatile ("isb" : : : "memory")     /* Instruction synchronization barrier */
+#define CPU_COMPILER_BARRIER()      __asm volatile ("" : : : "memory")        /* Keep memory accesses in program order */
+
+/*** Sleep ***/
+#define CPU_WFI()                   __asm volatile ("wfi" : : : "memory")     /* Wait for interrupt */
+
+/*** Interrupt masking ***/
+#define CPU_DISABLE_IRQ()           __asm volatile ("cpsid i" : : : "memory") /* Set PRIMASK */
+#define CPU_ENABLE_IRQ()            __asm volatile ("cpsie i" : : : "memory") /* Clear PRIMASK */
+
+/*** Priority masking: S32K144 implements the upper 4 bits of each priority byte ***/
+#define CPU_NVIC_PRIO_BITS          (4u)
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Enters a critical section.
+ *
+ * @return PRIMASK before the call, to be passed to Cpu_ExitCritical().
+ * @note Critical sections may nest.
+ */
+static inline unsigned int Cpu_EnterCritical(void)
+{
+		unsigned int primask;
+
+		__asm volatile ("mrs %0, primask" : "=r" (primask));
+		CPU_DISABLE_IRQ();
+		return primask;
+}
+
+/*!
+ * @brief Leaves a critical section.
+ *
+ * @param[in] primask Value returned by the matching Cpu_EnterCritical().
+ * @return void.
+ */
+static inline void Cpu_ExitCritical(unsigned int primask)
+{
+		__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/*!
+ * @brief Raises BASEPRI, never lowers it.
+ *
+ * Interrupts whose priority value is greater than or equal to basepri are masked; the others
+ * keep running. 0 leaves the masking unchanged.
+ *
+ * @param[in] basepri New masking level, priority byte format.
+ * @return BASEPRI before the call, to be passed to Cpu_SetBasepri().
+ */
+static inline unsigned int Cpu_RaiseBasepri(unsigned int basepri)
+{
+		unsigned int previous;
+
+		__asm volatile ("mrs %0, basepri" : "=r" (previous));
+		__asm volatile ("msr basepri_max, %0" : : "r" (basepri) : "memory");
+		return previous;
+}
+
+/*!
+ * @brief Restores BASEPRI.
+ *
+ * @param[in] basepri Value returned by the matching Cpu_RaiseBasepri().
+ * @return void.
+ */
+static inline void Cpu_SetBasepri(unsigned int basepri)
+{
+		__asm volatile ("msr basepri, %0" : : "r" (basepri) : "memory");
+}
+
+/*!
+ * @brief Loads a word and marks the address for exclusive access.
+ *
+ * @param[in] AddrPtr Word to load.
+ * @return Loaded value.
+ */
+static inline unsigned int Cpu_LoadExclusive(volatile unsigned int * AddrPtr)
+{
+		unsigned int value;
+
+		__asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (AddrPtr) : "memory");
+		return value;
+}
+
+/*!
+ * @brief Stores a word if nothing interrupted the access since Cpu_LoadExclusive().
+ *
+ * @param[in] value Value to store.
+ * @param[in] AddrPtr Word to store to.
+ * @return 0 when the store was done, 1 when it must be retried.
+ */
+static inline unsigned int Cpu_StoreExclusive(unsigned int value, volatile unsigned int * AddrPtr)
+{
+		unsigned int failed;
+
+		__asm volatile ("strex %0, %1, [%2]" : "=&r" (failed) : "r" (value), "r" (AddrPtr) : "memory");
+		return failed;
+}
+
+/*!
+ * @brief Drops the exclusive access mark, when a Cpu_LoadExclusive() is not followed by a store.
+ *
+ * @return void.
+ */
+static inline void Cpu_ClearExclusive(void)
+{
+		__asm volatile ("clrex" : : : "memory");
+}
+
+#endif  /* CPU_H */
@@ -0,0 +1,164 @@
+/****************************************************************************************************
+* @file     Dma.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the eDMA driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           routing peripheral requests through the DMAMUX and programming eDMA channels with a
+*           single transfer control descriptor, either one-shot or as a circular buffer.
+* @version  1.0.0
+* @date     2024-11-03
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef DMA_H
+#define DMA_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Dma_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** DMAMUX request sources ***/
+#define DMA_SOURCE_LPUART0_RX               (2u)
+#define DMA_SOURCE_LPUART0_TX               (3u)
+#define DMA_SOURCE_LPUART1_RX               (4u)
+#define DMA_SOURCE_LPUART1_TX               (5u)
+#define DMA_SOURCE_LPUART2_RX               (6u)
+#define DMA_SOURCE_LPUART2_TX               (7u)
+#define DMA_SOURCE_ADC0                     (42u)
+#define DMA_SOURCE_ADC1                     (43u)
+#define DMA_SOURCE_ALWAYS_ON                (62u)              /* Always enabled, e.g. paced by the LPIT trigger */
+
+#define DMA_MAJOR_COUNT_MAX                 (DMA_TCD_CITER_MASK)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     DMA Return Status Type
+ */
+typedef enum
+{
+			DMA_OK              = 0U,       /**< Operation completed successfully. */
+			DMA_ERR_PARA        = 1U,       /**< Parameter error */
+			DMA_ERR_BUSY        = 2U,       /**< Channel active, the descriptor can only change while idle */
+} Dma_ret_t;
+
+/**
+ * @brief     Transfer size of one source read or destination write.
+ */
+typedef enum
+{
+			DMA_SIZE_8BIT       = 0U,       /**< 1 byte */
+			DMA_SIZE_16BIT      = 1U,       /**< 2 bytes */
+			DMA_SIZE_32BIT      = 2U,       /**< 4 bytes */
+} Dma_size_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for a DMA channel.
+ * @details Every request moves minorBytes; after majorCount requests the addresses are adjusted
+ *          by the last adjustments. A circular channel keeps its request enabled and restarts
+ *          from the reloaded major count, a one-shot channel stops at the end of the major loop.
+ */
+typedef struct
+{
+			unsigned char       channel;            /*!< DMA channel (0-15) */
+			unsigned char       source;             /*!< DMAMUX request source, DMA_SOURCE_xxx */
+			unsigned char       periodicTrigger;    /*!< Gate requests with LPIT channel n (DMA channels 0-3) */
+			unsigned char       circular;           /*!< Keep running after the major loop */
+			unsigned int        srcAddr;            /*!< Source address */
+			short               srcOffset;          /*!< Source increment after each read */
+			Dma_size_t          srcSize;            /*!< Source read size */
+			int                 srcLastAdjust;      /*!< Source adjustment after the major loop */
+			unsigned int        destAddr;           /*!< Destination address */
+			short               destOffset;         /*!< Destination increment after each write */
+			Dma_size_t          destSize;           /*!< Destination write size */
+			int                 destLastAdjust;     /*!< Destination adjustment after the major loop */
+			unsigned int        minorBytes;         /*!< Bytes per request */
+			unsigned short      majorCount;         /*!< Requests per major loop (1 to DMA_MAJOR_COUNT_MAX) */
+} Dma_ChannelConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the eDMA controller and the DMAMUX.
+ *
+ * Later calls only return; every driver using DMA calls this first.
+ *
+ * @return void.
+ */
+void Dma_Init(void);
+
+/*!
+ * @brief Programs a DMA channel and routes its request source.
+ *
+ * @param[in] ConfigPtr Pointer to the channel configuration structure.
+ * @return DMA_OK on success, DMA_ERR_PARA or DMA_ERR_BUSY on error.
+ * @note The request is left disabled, see Dma_StartChannel().
+ */
+Dma_ret_t Dma_ConfigChannel(const Dma_ChannelConfigType * ConfigPtr);
+
+/*!
+ * @brief Reloads a one-shot channel with new addresses and count.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @param[in] srcAddr Source address.
+ * @param[in] destAddr Destination address.
+ * @param[in] majorCount Requests per major loop (1 to DMA_MAJOR_COUNT_MAX).
+ * @return DMA_OK on success, DMA_ERR_PARA or DMA_ERR_BUSY on error.
+ */
+Dma_ret_t Dma_SetTransfer(unsigned char channel, unsigned int srcAddr, unsigned int destAddr, unsigned short majorCount);
+
+/*!
+ * @brief Enables the hardware request of a channel.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return void.
+ */
+void Dma_StartChannel(unsigned char channel);
+
+/*!
+ * @brief Disables the hardware request of a channel.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return void.
+ */
+void Dma_StopChannel(unsigned char channel);
+
+/*!
+ * @brief Gets the requests left in the current major loop.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return Current major count; equals the programmed count before the first request.
+ */
+unsigned short Dma_GetRemaining(unsigned char channel);
+
+/*!
+ * @brief Checks whether the major loop of a channel completed.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return 1 when done, 0 otherwise.
+ */
+unsigned char Dma_IsDone(unsigned char channel);
+
+/*!
+ * @brief Gets the error status of the controller.
+ *
+ * @return ES register, 0 when no error was recorded.
+ */
+unsigned int Dma_GetErrorStatus(void);
+
+#endif  /* DMA_H */
@@ -0,0 +1,132 @@
+/****************************************************************************************************
+* @file     Dma_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for eDMA and DMAMUX peripheral registers.
+* @details  This header file contains the definitions and structures for the enhanced Direct Memory
+*           Access controller (eDMA) and its request multiplexer (DMAMUX) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-03
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef DMA_REG_H
+#define DMA_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral base addresses ***/
+#define DMA_BASE_ADDRESS                    (0x40008000u)
+#define DMAMUX_BASE_ADDRESS                 (0x40021000u)
+
+/*** Sizes ***/
+#define DMA_CHANNEL_COUNT                   (16u)
+#define DMAMUX_PERIODIC_CHANNEL_COUNT       (4u)               /* Channels with an LPIT periodic trigger */
+
+/*** DCHPRI - registers are byte-swapped in groups of four: DCHPRI3 at 0x100, DCHPRI0 at 0x103 ***/
+#define DMA_DCHPRI_INDEX(CH)                ((CH) ^ 3u)
+
+/*** CR - Control Register ***/
+#define DMA_CR_EDBG_SHIFT                   (1u)               /* Stall in debug mode */
+#define DMA_CR_ERCA_SHIFT                   (2u)               /* Round robin channel arbitration */
+#define DMA_CR_HALT_SHIFT                   (5u)               /* Halt DMA operations */
+
+/*** CERR / CINT - Clear Error / Interrupt Request ***/
+#define DMA_CERR_CAER_SHIFT                 (6u)               /* Clear all error indicators */
+#define DMA_CINT_CAIR_SHIFT                 (6u)               /* Clear all interrupt requests */
+
+/*** TCD ATTR - Transfer Attributes ***/
+#define DMA_TCD_ATTR_DSIZE_SHIFT            (0u)               /* Destination data transfer size */
+#define DMA_TCD_ATTR_DMOD_SHIFT             (3u)               /* Destination address modulo */
+#define DMA_TCD_ATTR_SSIZE_SHIFT            (8u)               /* Source data transfer size */
+#define DMA_TCD_ATTR_SMOD_SHIFT             (11u)              /* Source address modulo */
+
+/*** TCD CSR - Control and Status ***/
+#define DMA_TCD_CSR_START_SHIFT             (0u)               /* Channel start */
+#define DMA_TCD_CSR_INTMAJOR_SHIFT          (1u)               /* Interrupt at major loop completion */
+#define DMA_TCD_CSR_INTHALF_SHIFT           (2u)               /* Interrupt at half major loop */
+#define DMA_TCD_CSR_DREQ_SHIFT              (3u)               /* Disable request at major loop completion */
+#define DMA_TCD_CSR_ACTIVE_SHIFT            (6u)               /* Channel active */
+#define DMA_TCD_CSR_DONE_SHIFT              (7u)               /* Channel done */
+
+/*** TCD CITER / BITER - Major loop count (ELINK = 0) ***/
+#define DMA_TCD_CITER_MASK                  (0x7FFFu)
+
+/*** DMAMUX CHCFG - Channel Configuration ***/
+#define DMAMUX_CHCFG_SOURCE_SHIFT           (0u)               /* DMA channel source (slot) */
+#define DMAMUX_CHCFG_SOURCE_MASK            (0x3Fu)
+#define DMAMUX_CHCFG_TRIG_SHIFT             (6u)               /* DMA channel trigger enable (LPIT) */
+#define DMAMUX_CHCFG_ENBL_SHIFT             (7u)               /* DMA channel enable */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief eDMA Transfer Control Descriptor Structure.
+ */
+typedef struct {
+			volatile unsigned int SADDR;        /**< Source Address, Address offset: 0x0 */
+			volatile unsigned short SOFF;       /**< Signed Source Address Offset, Address offset: 0x4 */
+			volatile unsigned short ATTR;       /**< Transfer Attributes, Address offset: 0x6 */
+			volatile unsigned int NBYTES;       /**< Minor Byte Count (minor loop mapping disabled), Address offset: 0x8 */
+			volatile unsigned int SLAST;        /**< Last Source Address Adjustment, Address offset: 0xC */
+			volatile unsigned int DADDR;        /**< Destination Address, Address offset: 0x10 */
+			volatile unsigned short DOFF;       /**< Signed Destination Address Offset, Address offset: 0x14 */
+			volatile unsigned short CITER;      /**< Current Minor Loop Link, Major Loop Count, Address offset: 0x16 */
+			volatile unsigned int DLASTSGA;     /**< Last Destination Address Adjustment / Scatter Gather, Address offset: 0x18 */
+			volatile unsigned short CSR;        /**< Control and Status, Address offset: 0x1C */
+			volatile unsigned short BITER;      /**< Beginning Minor Loop Link, Major Loop Count, Address offset: 0x1E */
+} DMA_TCD_Type;
+
+/**
+ * @brief eDMA Register Structure.
+ */
+typedef struct {
+			volatile unsigned int CR;           /**< Control Register, Address offset: 0x0 */
+			volatile unsigned int ES;           /**< Error Status Register, Address offset: 0x4 */
+			unsigned char RESERVED_0[4];
+			volatile unsigned int ERQ;          /**< Enable Request Register, Address offset: 0xC */
+			unsigned char RESERVED_1[4];
+			volatile unsigned int EEI;          /**< Enable Error Interrupt Register, Address offset: 0x14 */
+			volatile unsigned char CEEI;        /**< Clear Enable Error Interrupt Register, Address offset: 0x18 */
+			volatile unsigned char SEEI;        /**< Set Enable Error Interrupt Register, Address offset: 0x19 */
+			volatile unsigned char CERQ;        /**< Clear Enable Request Register, Address offset: 0x1A */
+			volatile unsigned char SERQ;        /**< Set Enable Request Register, Address offset: 0x1B */
+			volatile unsigned char CDNE;        /**< Clear DONE Status Bit Register, Address offset: 0x1C */
+			volatile unsigned char SSRT;        /**< Set START Bit Register, Address offset: 0x1D */
+			volatile unsigned char CERR;        /**< Clear Error Register, Address offset: 0x1E */
+			volatile unsigned char CINT;        /**< Clear Interrupt Request Register, Address offset: 0x1F */
+			unsigned char RESERVED_2[4];
+			volatile unsigned int INT;          /**< Interrupt Request Register, Address offset: 0x24 */
+			unsigned char RESERVED_3[4];
+			volatile unsigned int ERR;          /**< Error Register, Address offset: 0x2C */
+			unsigned char RESERVED_4[4];
+			volatile unsigned int HRS;          /**< Hardware Request Status Register, Address offset: 0x34 */
+			unsigned char RESERVED_5[12];
+			volatile unsigned int EARS;         /**< Enable Asynchronous Request in Stop Register, Address offset: 0x44 */
+			unsigned char RESERVED_6[184];
+			volatile unsigned char DCHPRI[DMA_CHANNEL_COUNT];   /**< Channel Priority Registers, Address offset: 0x100 */
+			unsigned char RESERVED_7[3824];
+			DMA_TCD_Type TCD[DMA_CHANNEL_COUNT];                /**< Transfer Control Descriptors, Address offset: 0x1000 + 0x20 * n */
+} DMA_Type;
+
+/**
+ * @brief DMAMUX Register Structure.
+ */
+typedef struct {
+			volatile unsigned char CHCFG[DMA_CHANNEL_COUNT];    /**< Channel Configuration, Address offset: 0x0 */
+} DMAMUX_Type;
+
+/** Peripheral base pointers */
+#define DMA ((DMA_Type *)DMA_BASE_ADDRESS)
+#define DMAMUX ((DMAMUX_Type *)DMAMUX_BASE_ADDRESS)
+
+#endif  /* DMA_REG_H */
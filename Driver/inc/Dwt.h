@@ -0,0 +1,48 @@
+/****************************************************************************************************
+* @file     Dwt.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the DWT cycle counter.
+* @details  This header file contains the function prototypes for enabling and reading the DWT
+*           cycle counter, which counts core clock cycles and is used for timestamps.
+* @version  1.0.0
+* @date     2024-10-22
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef DWT_H
+#define DWT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Dwt_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Reads the cycle counter without a function call ***/
+#define DWT_GET_CYCLES()            (DWT->CYCCNT)
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Enables the DWT cycle counter.
+ *
+ * This function enables trace in the debug monitor, clears the cycle counter and starts it.
+ *
+ * @return void.
+ */
+void Dwt_Init(void);
+
+/*!
+ * @brief Retrieves the current value of the cycle counter.
+ *
+ * @return Number of core clock cycles since Dwt_Init(), wrapping at 2^32.
+ */
+unsigned int Dwt_GetCycles(void);
+
+#endif   /* DWT_H */
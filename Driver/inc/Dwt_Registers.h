@@ -0,0 +1,60 @@
+/****************************************************************************************************
+* @file     Dwt_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for DWT peripheral registers.
+* @details  This header file contains the definitions and structures for the Data Watchpoint and
+*           Trace (DWT) unit of ARM Cortex-M4 microcontrollers, used here for its cycle counter.
+* @version  1.0.0
+* @date     2024-10-22
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef DWT_REG_H
+#define DWT_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral DWT base address ***/
+#define DWT_BASE_ADDRESS                    (0xE0001000u)
+
+/*** Debug Exception and Monitor Control Register address ***/
+#define COREDEBUG_DEMCR_ADDRESS             (0xE000EDFCu)
+
+/*** Bit Shifts ***/
+#define DWT_CTRL_CYCCNTENA_SHIFT            (0u)               /* Enable the cycle counter */
+#define COREDEBUG_DEMCR_TRCENA_SHIFT        (24u)              /* Enable DWT and ITM */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief DWT Register Structure.
+ *
+ * This structure represents the DWT profiling registers.
+ */
+typedef struct {
+			volatile unsigned int CTRL;         /**< Control Register, Address offset: 0x0 */
+			volatile unsigned int CYCCNT;       /**< Cycle Count Register, Address offset: 0x4 */
+			volatile unsigned int CPICNT;       /**< CPI Count Register, Address offset: 0x8 */
+			volatile unsigned int EXCCNT;       /**< Exception Overhead Count Register, Address offset: 0xC */
+			volatile unsigned int SLEEPCNT;     /**< Sleep Count Register, Address offset: 0x10 */
+			volatile unsigned int LSUCNT;       /**< LSU Count Register, Address offset: 0x14 */
+			volatile unsigned int FOLDCNT;      /**< Folded-instruction Count Register, Address offset: 0x18 */
+} DWT_Type;
+
+/** Peripheral DWT base pointer */
+#define DWT ((DWT_Type *)DWT_BASE_ADDRESS)
+
+/** Debug Exception and Monitor Control Register */
+#define COREDEBUG_DEMCR (*(volatile unsigned int *)COREDEBUG_DEMCR_ADDRESS)
+
+#endif  /* DWT_REG_H */
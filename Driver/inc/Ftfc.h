@@ -0,0 +1,131 @@
+/****************************************************************************************************
+* @file     Ftfc.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the FTFC flash driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           programming and erasing the FlexNVM used as D-Flash. Commands are launched and return at
+*           once; the command-complete interrupt reports the result through a callback. The code
+*           runs from the P-Flash, a separate block, so it keeps executing while the D-Flash is busy.
+* @version  1.0.0
+* @date     2024-11-12
+* @note     The D-Flash must not be read while a command runs (read collision). Typical times from
+*           the data sheet: 90 us per phrase, 10 ms per sector erase (130 ms worst case).
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTFC_H
+#define FTFC_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc_Registers.h"
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     FTFC Return Status Type
+ */
+typedef enum
+{
+			FTFC_OK             = 0U,       /**< Operation completed successfully. */
+			FTFC_ERR_PARA       = 1U,       /**< Parameter error: address outside the D-Flash or misaligned */
+			FTFC_ERR_BUSY       = 2U,       /**< A command is still running */
+			FTFC_ERR_ACCESS     = 3U,       /**< Command rejected (ACCERR) */
+			FTFC_ERR_PROTECTION = 4U,       /**< Address protected by FDPROT (FPVIOL) */
+			FTFC_ERR_VERIFY     = 5U,       /**< Command ended with MGSTAT0 set */
+			FTFC_ERR_SUSPENDED  = 6U,       /**< Sector erase stopped by Ftfc_Suspend(), the sector is not blank */
+} Ftfc_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Command complete callback, called from FTFC_IRQHandler with the command result.
+ */
+typedef void (*Ftfc_CallbackType)(Ftfc_ret_t result);
+
+/**
+ * @brief   Configuration structure for the FTFC driver.
+ */
+typedef struct
+{
+			Ftfc_CallbackType       callback;       /*!< Command complete callback, may be NULL */
+} Ftfc_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the FTFC driver.
+ *
+ * This function waits for a command started before the call, e.g. by a debugger, and clears the
+ * error flags.
+ *
+ * @param[in] ConfigPtr Pointer to the FTFC configuration structure.
+ * @return FTFC_OK on success, FTFC_ERR_PARA on parameter error.
+ * @note Enable FTFC_CC_IRQn in the NVIC to receive the callback.
+ */
+Ftfc_ret_t Ftfc_Init(const Ftfc_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Starts programming one phrase of the D-Flash.
+ *
+ * @param[in] address D-Flash command address, FTFC_DFLASH_ADDRESS + offset, 8-byte aligned.
+ * @param[in] DataPtr 8 bytes to program, copied before the call returns.
+ * @return FTFC_OK when the command was launched, FTFC_ERR_PARA, FTFC_ERR_BUSY or the launch error.
+ * @note The phrase must be erased; programming it twice is not allowed.
+ */
+Ftfc_ret_t Ftfc_ProgramPhrase(unsigned int address, const unsigned char * DataPtr);
+
+/*!
+ * @brief Starts erasing one sector of the D-Flash.
+ *
+ * @param[in] address D-Flash command address, FTFC_DFLASH_ADDRESS + offset, sector aligned.
+ * @return FTFC_OK when the command was launched, FTFC_ERR_PARA, FTFC_ERR_BUSY or the launch error.
+ */
+Ftfc_ret_t Ftfc_EraseSector(unsigned int address);
+
+/*!
+ * @brief Tells whether a command is running.
+ *
+ * @return 1 while a command runs, 0 otherwise.
+ */
+unsigned char Ftfc_IsBusy(void);
+
+/*!
+ * @brief Waits for the running command with the interrupt disabled.
+ *
+ * The callback is not called for this command. Used to chain commands where the completion
+ * interrupt cannot run, e.g. from a higher priority interrupt.
+ *
+ * @return Result of the command, FTFC_OK when none was running.
+ */
+Ftfc_ret_t Ftfc_Wait(void);
+
+/*!
+ * @brief Stops the running command as soon as possible.
+ *
+ * A sector erase is suspended and not resumed; it has to be launched again later. A phrase
+ * program cannot be stopped and is waited for. The callback is not called for this command.
+ *
+ * @return Result of the command, FTFC_ERR_SUSPENDED for a suspended erase.
+ */
+Ftfc_ret_t Ftfc_Suspend(void);
+
+/*!
+ * @brief FTFC command complete interrupt handler.
+ *
+ * Disables the interrupt, which stays asserted while the FTFC is idle, and calls the callback.
+ *
+ * @return void.
+ */
+void FTFC_IRQHandler(void);
+
+#endif  /* FTFC_H */
@@ -0,0 +1,85 @@
+/****************************************************************************************************
+* @file     Ftfc_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for FTFC peripheral registers.
+* @details  This header file contains the definitions and structures for the Flash Memory Module
+*           (FTFC) of the S32K144, which programs and erases the P-Flash and the FlexNVM.
+* @version  1.0.0
+* @date     2024-11-12
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTFC_REG_H
+#define FTFC_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral FTFC base address ***/
+#define FTFC_BASE_ADDRESS                   (0x40020000u)
+
+/*** FSTAT - Flash Status Register ***/
+#define FTFC_FSTAT_MGSTAT0_SHIFT            (0u)               /* Command completion status */
+#define FTFC_FSTAT_FPVIOL_SHIFT             (4u)               /* Protection violation (write 1 to clear) */
+#define FTFC_FSTAT_ACCERR_SHIFT             (5u)               /* Access error (write 1 to clear) */
+#define FTFC_FSTAT_RDCOLERR_SHIFT           (6u)               /* Read collision (write 1 to clear) */
+#define FTFC_FSTAT_CCIF_SHIFT               (7u)               /* Command complete, write 1 to launch */
+
+/*** FCNFG - Flash Configuration Register ***/
+#define FTFC_FCNFG_EEERDY_SHIFT             (0u)               /* FlexRAM ready for EEPROM emulation */
+#define FTFC_FCNFG_RAMRDY_SHIFT             (1u)               /* FlexRAM ready as traditional RAM */
+#define FTFC_FCNFG_ERSSUSP_SHIFT            (4u)               /* Erase suspend, still set when the erase was cut short */
+#define FTFC_FCNFG_RDCOLLIE_SHIFT           (6u)               /* Read collision interrupt enable */
+#define FTFC_FCNFG_CCIE_SHIFT               (7u)               /* Command complete interrupt enable */
+
+/*** FCCOB - Command object, byte n is at FCCOB[FTFC_FCCOB_INDEX(n)] ***/
+#define FTFC_FCCOB_INDEX(N)                 (((N) & ~3u) + 3u - ((N) & 3u))
+
+/*** Commands ***/
+#define FTFC_CMD_PROGRAM_PHRASE             (0x07u)            /* Program 8 bytes */
+#define FTFC_CMD_ERASE_SECTOR               (0x09u)            /* Erase one sector */
+
+/*** FlexNVM used as D-Flash ***/
+#define FTFC_DFLASH_ADDRESS                 (0x00800000u)      /* Command address of the first byte */
+#define FTFC_DFLASH_MEMORY                  (0x10000000u)      /* Read address of the first byte */
+#define FTFC_DFLASH_SIZE                    (0x10000u)         /* 64 KB without a FlexRAM partition */
+#define FTFC_DFLASH_SECTOR_SIZE             (2048u)
+#define FTFC_PHRASE_SIZE                    (8u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief FTFC Register Structure.
+ *
+ * This structure represents the FTFC registers.
+ */
+typedef struct {
+			volatile unsigned char FSTAT;       /**< Flash Status Register, Address offset: 0x0 */
+			volatile unsigned char FCNFG;       /**< Flash Configuration Register, Address offset: 0x1 */
+			volatile unsigned char FSEC;        /**< Flash Security Register, Address offset: 0x2 */
+			volatile unsigned char FOPT;        /**< Flash Option Register, Address offset: 0x3 */
+			volatile unsigned char FCCOB[12];   /**< Flash Common Command Object Registers, Address offset: 0x4 */
+			volatile unsigned char FPROT[4];    /**< Program Flash Protection Registers, Address offset: 0x10 */
+			unsigned char RESERVED_0[2];
+			volatile unsigned char FEPROT;      /**< EEPROM Protection Register, Address offset: 0x16 */
+			volatile unsigned char FDPROT;      /**< Data Flash Protection Register, Address offset: 0x17 */
+			unsigned char RESERVED_1[20];
+			volatile unsigned char FCSESTAT;    /**< Flash CSEc Status Register, Address offset: 0x2C */
+			unsigned char RESERVED_2;
+			volatile unsigned char FERSTAT;     /**< Flash Error Status Register, Address offset: 0x2E */
+			volatile unsigned char FERCNFG;     /**< Flash Error Configuration Register, Address offset: 0x2F */
+} FTFC_Type;
+
+/** Peripheral FTFC base pointer */
+#define FTFC ((FTFC_Type *)FTFC_BASE_ADDRESS)
+
+#endif  /* FTFC_REG_H */
@@ -0,0 +1,181 @@
+/****************************************************************************************************
+* @file     Ftm.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the FTM PWM driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           edge- or center-aligned PWM on the FlexTimer modules, with complementary pairs and
+*           dead-time insertion. New duty values are buffered and loaded together at the next
+*           reload point, so an update never produces a glitch inside a PWM period.
+* @version  1.0.0
+* @date     2024-11-02
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTM_H
+#define FTM_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftm_Registers.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define FTM_DUTY_MAX                        (0xFFFFu)          /* 100 % duty */
+#define FTM_NS_PER_SECOND                   (1000000000u)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     FTM Return Status Type
+ */
+typedef enum
+{
+			FTM_OK              = 0U,       /**< Operation completed successfully. */
+			FTM_ERR_PARA        = 1U,       /**< Parameter error or frequency out of range */
+			FTM_ERR_CLOCK       = 2U,       /**< Input clock not running */
+} Ftm_ret_t;
+
+/**
+ * @brief     FTM counter clock.
+ */
+typedef enum
+{
+			FTM_CLK_SYSTEM      = 1U,       /**< FTM input clock (system clock) */
+			FTM_CLK_FIXED       = 2U,       /**< Fixed frequency clock (RTC_CLK) */
+			FTM_CLK_EXTERNAL    = 3U,       /**< PCC functional clock */
+} Ftm_clock_t;
+
+/**
+ * @brief     PWM alignment.
+ */
+typedef enum
+{
+			FTM_ALIGN_EDGE      = 0U,       /**< Edge-aligned, counter counts up */
+			FTM_ALIGN_CENTER    = 1U,       /**< Center-aligned, counter counts up and down */
+} Ftm_align_t;
+
+/**
+ * @brief     PWM output polarity.
+ */
+typedef enum
+{
+			FTM_POLARITY_HIGH   = 0U,       /**< Output high during the duty cycle */
+			FTM_POLARITY_LOW    = 1U,       /**< Output low during the duty cycle */
+} Ftm_polarity_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for one PWM channel.
+ */
+typedef struct
+{
+			unsigned char       channel;            /*!< Channel (0-7); even channel of a complementary pair */
+			Ftm_polarity_t      polarity;           /*!< Output polarity */
+			unsigned char       complementary;      /*!< Drive channel + 1 with the complement, with dead-time */
+			unsigned short      duty;               /*!< Initial duty, 0 to FTM_DUTY_MAX */
+} Ftm_ChannelConfigType;
+
+/**
+ * @brief   Configuration structure for an FTM instance.
+ */
+typedef struct
+{
+			unsigned char                  instance;       /*!< FTM instance (0-3) */
+			Ftm_clock_t                    clockSrc;       /*!< Counter clock */
+			peripheral_clock_source_t      pccClkSrc;      /*!< PCC source when clockSrc is FTM_CLK_EXTERNAL */
+			unsigned int                   fixedClockHz;   /*!< Fixed frequency clock, used with FTM_CLK_FIXED */
+			unsigned char                  prescaler;      /*!< Divide-by-2^prescaler (0-7) */
+			Ftm_align_t                    alignment;      /*!< PWM alignment */
+			unsigned int                   frequencyHz;    /*!< PWM frequency */
+			unsigned int                   deadTimeNs;     /*!< Dead-time of complementary pairs */
+			unsigned char                  reloadDivider;  /*!< Reload point every reloadDivider + 1 periods (0-31) */
+			const Ftm_ChannelConfigType *  channels;       /*!< Channel configurations */
+			unsigned char                  channelCount;   /*!< Number of channel configurations */
+} Ftm_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes an FTM instance for PWM and starts the counter.
+ *
+ * @param[in] ConfigPtr Pointer to the FTM configuration structure.
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ */
+Ftm_ret_t Ftm_Init(const Ftm_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Stops an FTM instance and releases its clock.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return void.
+ */
+void Ftm_Deinit(unsigned char instance);
+
+/*!
+ * @brief Writes the buffered duty of a channel.
+ *
+ * The value takes effect at the reload point after Ftm_LoadAtReload().
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @param[in] channel Channel (0-7).
+ * @param[in] duty Duty, 0 to FTM_DUTY_MAX.
+ * @return FTM_OK on success, FTM_ERR_PARA on parameter error.
+ */
+Ftm_ret_t Ftm_SetDuty(unsigned char instance, unsigned char channel, unsigned short duty);
+
+/*!
+ * @brief Requests the buffered values to be loaded at the next reload point.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return void.
+ */
+void Ftm_LoadAtReload(unsigned char instance);
+
+/*!
+ * @brief Checks and clears the reload flag.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return 1 when a reload point was reached since the last call, 0 otherwise.
+ */
+unsigned char Ftm_TakeReloadFlag(unsigned char instance);
+
+/*!
+ * @brief Changes the PWM frequency, keeping the duties.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @param[in] frequencyHz New PWM frequency.
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ */
+Ftm_ret_t Ftm_SetFrequency(unsigned char instance, unsigned int frequencyHz);
+
+/*!
+ * @brief Recomputes the period after the input clock changed.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ * @note Call this from a Perf post-change callback when the counter runs on the system clock.
+ */
+Ftm_ret_t Ftm_Retune(unsigned char instance);
+
+/*!
+ * @brief Gets the counter input frequency before the prescaler.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return Frequency in Hz, 0 when the clock is not running.
+ */
+unsigned int Ftm_GetInputFreq(unsigned char instance);
+
+#endif  /* FTM_H */
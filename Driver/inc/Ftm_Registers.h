@@ -0,0 +1,137 @@
+/****************************************************************************************************
+* @file     Ftm_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for FTM peripheral registers.
+* @details  This header file contains the definitions and structures for the FlexTimer Modules
+*           (FTM0 - FTM3) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-02
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef FTM_REG_H
+#define FTM_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral FTM base addresses ***/
+#define FTM0_BASE_ADDRESS                   (0x40038000u)
+#define FTM1_BASE_ADDRESS                   (0x40039000u)
+#define FTM2_BASE_ADDRESS                   (0x4003A000u)
+#define FTM3_BASE_ADDRESS                   (0x40026000u)
+
+/*** Sizes ***/
+#define FTM_INSTANCE_COUNT                  (4u)
+#define FTM_CHANNEL_COUNT                   (8u)
+#define FTM_MOD_MAX                         (0xFFFFu)
+
+/*** SC - Status And Control ***/
+#define FTM_SC_PS_SHIFT                     (0u)               /* Prescale Factor Selection */
+#define FTM_SC_CLKS_SHIFT                   (3u)               /* Clock Source Selection */
+#define FTM_SC_CPWMS_SHIFT                  (5u)               /* Center-Aligned PWM Select */
+#define FTM_SC_RIE_SHIFT                    (6u)               /* Reload Point Interrupt Enable */
+#define FTM_SC_RF_SHIFT                     (7u)               /* Reload Flag */
+#define FTM_SC_TOIE_SHIFT                   (8u)               /* Timer Overflow Interrupt Enable */
+#define FTM_SC_TOF_SHIFT                    (9u)               /* Timer Overflow Flag */
+#define FTM_SC_PWMEN_SHIFT                  (16u)              /* Channel n PWM output enable (n = 0-7) */
+
+/*** CnSC - Channel Status And Control ***/
+#define FTM_CnSC_ELSA_SHIFT                 (2u)               /* Edge or Level Select A */
+#define FTM_CnSC_ELSB_SHIFT                 (3u)               /* Edge or Level Select B */
+#define FTM_CnSC_MSA_SHIFT                  (4u)               /* Channel Mode Select A */
+#define FTM_CnSC_MSB_SHIFT                  (5u)               /* Channel Mode Select B */
+#define FTM_CnSC_CHIE_SHIFT                 (6u)               /* Channel Interrupt Enable */
+#define FTM_CnSC_CHF_SHIFT                  (7u)               /* Channel Flag */
+
+/*** MODE - Features Mode Selection ***/
+#define FTM_MODE_FTMEN_SHIFT                (0u)               /* FTM Enable */
+#define FTM_MODE_WPDIS_SHIFT                (2u)               /* Write Protection Disable */
+
+/*** SYNC - Synchronization ***/
+#define FTM_SYNC_CNTMIN_SHIFT               (0u)               /* Reload point at CNTIN */
+#define FTM_SYNC_CNTMAX_SHIFT               (1u)               /* Reload point at MOD */
+
+/*** COMBINE - per channel pair, pair n at bit 8 * n ***/
+#define FTM_COMBINE_PAIR_SHIFT(PAIR)        (8u * (PAIR))
+#define FTM_COMBINE_COMP_SHIFT              (1u)               /* Complement of channel n on n + 1 */
+#define FTM_COMBINE_DTEN_SHIFT              (4u)               /* Dead-time insertion */
+#define FTM_COMBINE_SYNCEN_SHIFT            (5u)               /* Synchronization enable */
+
+/*** DEADTIME - Deadtime Configuration ***/
+#define FTM_DEADTIME_DTVAL_SHIFT            (0u)               /* Deadtime Value */
+#define FTM_DEADTIME_DTVAL_MASK             (0x3Fu)
+#define FTM_DEADTIME_DTPS_SHIFT             (6u)               /* Deadtime Prescaler */
+#define FTM_DEADTIME_DTVALEX_SHIFT          (16u)              /* Extended Deadtime Value */
+#define FTM_DEADTIME_MAX_COUNT              (0x3FFu)           /* DTVALEX:DTVAL */
+
+/*** FMS - Fault Mode Status ***/
+#define FTM_FMS_WPEN_SHIFT                  (6u)               /* Write Protection Enable */
+
+/*** CONF - Configuration ***/
+#define FTM_CONF_LDFQ_SHIFT                 (0u)               /* Load Frequency */
+#define FTM_CONF_LDFQ_MASK                  (0x1Fu)
+
+/*** PWMLOAD ***/
+#define FTM_PWMLOAD_CHSEL_SHIFT             (0u)               /* Channel n select (n = 0-7) */
+#define FTM_PWMLOAD_LDOK_SHIFT              (9u)               /* Load Enable */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief FTM Channel Register Structure.
+ */
+typedef struct {
+			volatile unsigned int CnSC;         /**< Channel Status And Control, Address offset: 0x0 */
+			volatile unsigned int CnV;          /**< Channel Value, Address offset: 0x4 */
+} FTM_Channel_Type;
+
+/**
+ * @brief FTM Register Structure.
+ *
+ * This structure represents the FTM registers up to the half cycle register.
+ */
+typedef struct {
+			volatile unsigned int SC;           /**< Status And Control, Address offset: 0x0 */
+			volatile unsigned int CNT;          /**< Counter, Address offset: 0x4 */
+			volatile unsigned int MOD;          /**< Modulo, Address offset: 0x8 */
+			FTM_Channel_Type CONTROLS[FTM_CHANNEL_COUNT];   /**< Channels, Address offset: 0xC + 0x8 * n */
+			volatile unsigned int CNTIN;        /**< Counter Initial Value, Address offset: 0x4C */
+			volatile unsigned int STATUS;       /**< Capture And Compare Status, Address offset: 0x50 */
+			volatile unsigned int MODE;         /**< Features Mode Selection, Address offset: 0x54 */
+			volatile unsigned int SYNC;         /**< Synchronization, Address offset: 0x58 */
+			volatile unsigned int OUTINIT;      /**< Initial State For Channels Output, Address offset: 0x5C */
+			volatile unsigned int OUTMASK;      /**< Output Mask, Address offset: 0x60 */
+			volatile unsigned int COMBINE;      /**< Function For Linked Channels, Address offset: 0x64 */
+			volatile unsigned int DEADTIME;     /**< Deadtime Configuration, Address offset: 0x68 */
+			volatile unsigned int EXTTRIG;      /**< FTM External Trigger, Address offset: 0x6C */
+			volatile unsigned int POL;          /**< Channels Polarity, Address offset: 0x70 */
+			volatile unsigned int FMS;          /**< Fault Mode Status, Address offset: 0x74 */
+			volatile unsigned int FILTER;       /**< Input Capture Filter Control, Address offset: 0x78 */
+			volatile unsigned int FLTCTRL;      /**< Fault Control, Address offset: 0x7C */
+			volatile unsigned int QDCTRL;       /**< Quadrature Decoder Control And Status, Address offset: 0x80 */
+			volatile unsigned int CONF;         /**< Configuration, Address offset: 0x84 */
+			volatile unsigned int FLTPOL;       /**< FTM Fault Input Polarity, Address offset: 0x88 */
+			volatile unsigned int SYNCONF;      /**< Synchronization Configuration, Address offset: 0x8C */
+			volatile unsigned int INVCTRL;      /**< FTM Inverting Control, Address offset: 0x90 */
+			volatile unsigned int SWOCTRL;      /**< FTM Software Output Control, Address offset: 0x94 */
+			volatile unsigned int PWMLOAD;      /**< FTM PWM Load, Address offset: 0x98 */
+			volatile unsigned int HCR;          /**< Half Cycle Register, Address offset: 0x9C */
+} FTM_Type;
+
+/** Peripheral FTM base pointers */
+#define FTM0 ((FTM_Type *)FTM0_BASE_ADDRESS)
+#define FTM1 ((FTM_Type *)FTM1_BASE_ADDRESS)
+#define FTM2 ((FTM_Type *)FTM2_BASE_ADDRESS)
+#define FTM3 ((FTM_Type *)FTM3_BASE_ADDRESS)
+
+#endif  /* FTM_REG_H */
@@ -27,18 +27,9 @@
 void Gpio_Init(const Gpio_ConfigType* ConfigPtr)
 {
     /* Check parameter */
-		/* Configure the pin as input or output */
-		if (ConfigPtr->GPIO_PinMode == OUTPUT) 
-		{
-			/* Set pin as output */
-			SET_BIT(ConfigPtr->base->PDDR, ENABLEMENT, ConfigPtr->GPIO_PinNumber);
-			//ConfigPtr->base->PDDR |= (ENABLEMENT << ConfigPtr->GPIO_PinNumber);
-		} 
-		else 
-		{
-			/* Set pin as input */
-			CLEAR_BIT(ConfigPtr->base->PDDR, ENABLEMENT, ConfigPtr->GPIO_PinNumber);
-		}
+		/* Configure the pin as output (1) or input (0) */
+		REG_UPDATE(ConfigPtr->base->PDDR, 0u,
+		           FIELD_SET(GPIO_PIN(ConfigPtr->GPIO_PinNumber), (ConfigPtr->GPIO_PinMode == OUTPUT) ? 1u : 0u));
 }
 
 /**
@@ -54,15 +45,17 @@ void Gpio_Init(const Gpio_ConfigType* ConfigPtr)
 void GPIO_WriteToOutputPin(GPIO_Type *pGPIOx, unsigned char PinNumber, unsigned char value)
 {
     /* Check parameter */
+    /* One write to the set or clear register: no read-modify-write of PDOR that an interrupt
+       writing another pin of the port could interleave with */
     if (value) 
 		{
         /* Set pin HIGH */
-        SET_BIT(pGPIOx->PDOR, ENABLEMENT, PinNumber);
+        REG_WRITE(pGPIOx->PSOR, FIELD_SET(GPIO_PIN(PinNumber), 1u));
 		} 
 		else 
 		{
         /* Set pin LOW */
-        CLEAR_BIT(pGPIOx->PDOR, ENABLEMENT, PinNumber);
+        REG_WRITE(pGPIOx->PCOR, FIELD_SET(GPIO_PIN(PinNumber), 1u));
 		}
 }
 
@@ -27,6 +27,9 @@
 #define GPIOD_BASE           (0x400FF0C0u)
 #define GPIOE_BASE           (0x400FF100u)
 
+/** Pin field of PDOR, PSOR, PCOR, PTOR, PDIR, PDDR and PIDR, for FIELD_SET() and REG_UPDATE() */
+#define GPIO_PIN(N)          ((N), 1u, FIELD_RW)
+
 /*==================================================================================================
 *                                STRUCTURES AND OTHER TYPEDEFS
 ==================================================================================================*/
@@ -0,0 +1,217 @@
+/****************************************************************************************************
+* @file     Lpit.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the LPIT driver.
+* @details  This header file contains the definitions, structures, and function prototypes for the
+*           four LPIT timer channels: periodic interrupts with periods derived from the functional
+*           clock, trigger start / stop / reload, and two chained channels used as a 64-bit
+*           free-running counter.
+* @version  1.0.0
+* @date     2024-11-01
+* @note     Each channel timeout is also a trigger output: LPIT channel n paces DMA channel n
+*           through the DMAMUX periodic trigger, and reaches the ADCs through TRGMUX.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPIT_H
+#define LPIT_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpit_Registers.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define LPIT_CHANNEL_MASK(CH)               (1u << (CH))       /* Channel bit for Lpit_Start/StopChannels */
+#define LPIT_US_PER_SECOND                  (1000000u)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     LPIT Return Status Type
+ */
+typedef enum
+{
+			LPIT_OK             = 0U,       /**< Operation completed successfully. */
+			LPIT_ERR_PARA       = 1U,       /**< Parameter error or period out of range */
+			LPIT_ERR_CLOCK      = 2U,       /**< Functional clock not running */
+} Lpit_ret_t;
+
+/**
+ * @brief     LPIT channel operation mode.
+ */
+typedef enum
+{
+			LPIT_MODE_PERIODIC_32      = 0U,   /**< 32-bit periodic counter */
+			LPIT_MODE_DUAL_PERIODIC_16 = 1U,   /**< Dual 16-bit periodic counter */
+			LPIT_MODE_TRIGGER_ACC_32   = 2U,   /**< 32-bit trigger accumulator */
+			LPIT_MODE_INPUT_CAPTURE_32 = 3U,   /**< 32-bit trigger input capture */
+} Lpit_mode_t;
+
+/**
+ * @brief     LPIT trigger source.
+ */
+typedef enum
+{
+			LPIT_TRIGGER_EXTERNAL  = 0U,    /**< External trigger selected by TRGMUX */
+			LPIT_TRIGGER_INTERNAL  = 1U,    /**< Timeout of the channel selected by triggerSelect */
+} Lpit_trigger_src_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Channel timeout callback, called from the channel interrupt handler.
+ */
+typedef void (*Lpit_CallbackType)(unsigned char channel);
+
+/**
+ * @brief   Configuration structure for one LPIT channel.
+ */
+typedef struct
+{
+			Lpit_mode_t         mode;               /*!< Operation mode */
+			unsigned int        periodUs;           /*!< Period in microseconds, 0 to use reloadValue */
+			unsigned int        reloadValue;        /*!< Raw TVAL when periodUs is 0 */
+			unsigned char       chain;              /*!< Count timeouts of the previous channel */
+			unsigned char       interruptEnable;    /*!< Interrupt on timeout */
+			unsigned char       startOnTrigger;     /*!< Start counting on a trigger */
+			unsigned char       stopOnInterrupt;    /*!< Stop after a timeout until the next trigger */
+			unsigned char       reloadOnTrigger;    /*!< Reload the counter on a trigger */
+			Lpit_trigger_src_t  triggerSource;      /*!< Trigger source */
+			unsigned char       triggerSelect;      /*!< Internal trigger channel (0-3) */
+			Lpit_CallbackType   callback;           /*!< Timeout callback, may be NULL */
+} Lpit_ChannelConfigType;
+
+/**
+ * @brief   Configuration structure for the LPIT.
+ */
+typedef struct
+{
+			peripheral_clock_source_t       clkSrc;                          /*!< PCC functional clock source */
+			unsigned char                   runInDoze;                       /*!< Keep counting in STOP / VLPS */
+			unsigned char                   runInDebug;                      /*!< Keep counting when halted by the debugger */
+			const Lpit_ChannelConfigType *  channels[LPIT_CHANNEL_COUNT];    /*!< Channel configurations, NULL when unused */
+} Lpit_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the LPIT.
+ *
+ * This function requests the LPIT clock, enables the module and programs every configured
+ * channel. The channels are left stopped.
+ *
+ * @param[in] ConfigPtr Pointer to the LPIT configuration structure.
+ * @return LPIT_OK on success, LPIT_ERR_PARA or LPIT_ERR_CLOCK on error.
+ * @note Enable LPIT0_ChN_IRQn in the NVIC to receive the callbacks.
+ */
+Lpit_ret_t Lpit_Init(const Lpit_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Stops all channels, disables the module and releases its clock.
+ *
+ * @return void.
+ */
+void Lpit_Deinit(void);
+
+/*!
+ * @brief Starts several channels with one register write.
+ *
+ * Channels started together count in lockstep.
+ *
+ * @param[in] mask Channels to start, see LPIT_CHANNEL_MASK().
+ * @return void.
+ */
+void Lpit_StartChannels(unsigned int mask);
+
+/*!
+ * @brief Stops several channels with one register write.
+ *
+ * @param[in] mask Channels to stop, see LPIT_CHANNEL_MASK().
+ * @return void.
+ */
+void Lpit_StopChannels(unsigned int mask);
+
+/*!
+ * @brief Converts a period to a reload value.
+ *
+ * @param[in] periodUs Period in microseconds.
+ * @param[out] ReloadPtr TVAL giving the period.
+ * @return LPIT_OK on success, LPIT_ERR_PARA when the period is out of range, LPIT_ERR_CLOCK
+ *         when the functional clock is not running.
+ */
+Lpit_ret_t Lpit_UsToReload(unsigned int periodUs, unsigned int * ReloadPtr);
+
+/*!
+ * @brief Changes the period of a channel.
+ *
+ * The new period takes effect after the current one expires.
+ *
+ * @param[in] channel Channel (0-3).
+ * @param[in] periodUs Period in microseconds.
+ * @return LPIT_OK on success, LPIT_ERR_PARA or LPIT_ERR_CLOCK on error.
+ */
+Lpit_ret_t Lpit_SetPeriodUs(unsigned char channel, unsigned int periodUs);
+
+/*!
+ * @brief Reads the current value of a channel, counting down to 0.
+ *
+ * @param[in] channel Channel (0-3).
+ * @return Current timer value.
+ */
+unsigned int Lpit_GetCurrentValue(unsigned char channel);
+
+/*!
+ * @brief Starts a 64-bit free-running counter on two chained channels.
+ *
+ * Channel lowChannel counts the functional clock and channel lowChannel + 1 counts its
+ * timeouts. Both channels are reprogrammed and started.
+ *
+ * @param[in] lowChannel Low channel (0-2).
+ * @return LPIT_OK on success, LPIT_ERR_PARA on parameter error.
+ */
+Lpit_ret_t Lpit_StartCounter64(unsigned char lowChannel);
+
+/*!
+ * @brief Reads the 64-bit free-running counter.
+ *
+ * The high word is read before and after the low word, so a carry between the two reads is
+ * detected and the low word is read again.
+ *
+ * @param[in] lowChannel Low channel passed to Lpit_StartCounter64().
+ * @return Functional clock cycles since Lpit_StartCounter64().
+ */
+uint64 Lpit_GetCounter64(unsigned char lowChannel);
+
+/*!
+ * @brief Gets the LPIT functional clock frequency.
+ *
+ * @return Frequency in Hz, 0 when the clock is not running.
+ */
+unsigned int Lpit_GetClockFreq(void);
+
+/*!
+ * @brief LPIT channel interrupt handlers.
+ *
+ * Clear the timeout flag and call the channel callback.
+ *
+ * @return void.
+ */
+void LPIT0_Ch0_IRQHandler(void);
+void LPIT0_Ch1_IRQHandler(void);
+void LPIT0_Ch2_IRQHandler(void);
+void LPIT0_Ch3_IRQHandler(void);
+
+#endif  /* LPIT_H */
@@ -0,0 +1,81 @@
+/****************************************************************************************************
+* @file     Lpit_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for LPIT peripheral registers.
+* @details  This header file contains the definitions and structures for the Low Power Periodic
+*           Interrupt Timer (LPIT) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-01
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPIT_REG_H
+#define LPIT_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral LPIT0 base address ***/
+#define LPIT0_BASE_ADDRESS                  (0x40037000u)
+
+/*** Number of timer channels ***/
+#define LPIT_CHANNEL_COUNT                  (4u)
+
+/*** MCR - Module Control Register ***/
+#define LPIT_MCR_M_CEN_SHIFT                (0u)               /* Module Clock Enable */
+#define LPIT_MCR_SW_RST_SHIFT               (1u)               /* Software Reset */
+#define LPIT_MCR_DOZE_EN_SHIFT              (2u)               /* Run in Doze (stop) mode */
+#define LPIT_MCR_DBG_EN_SHIFT               (3u)               /* Run in Debug mode */
+
+/*** TCTRL - Timer Control Register ***/
+#define LPIT_TCTRL_T_EN_SHIFT               (0u)               /* Timer Enable */
+#define LPIT_TCTRL_CHAIN_SHIFT              (1u)               /* Chain to the previous channel */
+#define LPIT_TCTRL_MODE_SHIFT               (2u)               /* Timer Operation Mode */
+#define LPIT_TCTRL_TSOT_SHIFT               (16u)              /* Timer Start On Trigger */
+#define LPIT_TCTRL_TSOI_SHIFT               (17u)              /* Timer Stop On Interrupt */
+#define LPIT_TCTRL_TROT_SHIFT               (18u)              /* Timer Reload On Trigger */
+#define LPIT_TCTRL_TRG_SRC_SHIFT            (23u)              /* Trigger Source */
+#define LPIT_TCTRL_TRG_SEL_SHIFT            (24u)              /* Trigger Select */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief LPIT Timer Channel Register Structure.
+ */
+typedef struct {
+			volatile unsigned int TVAL;         /**< Timer Value Register, Address offset: 0x0 */
+			volatile unsigned int CVAL;         /**< Current Timer Value, Address offset: 0x4 */
+			volatile unsigned int TCTRL;        /**< Timer Control Register, Address offset: 0x8 */
+			unsigned char RESERVED_0[4];
+} LPIT_Channel_Type;
+
+/**
+ * @brief LPIT Register Structure.
+ *
+ * This structure represents the LPIT registers.
+ */
+typedef struct {
+			volatile unsigned int VERID;        /**< Version ID Register, Address offset: 0x0 */
+			volatile unsigned int PARAM;        /**< Parameter Register, Address offset: 0x4 */
+			volatile unsigned int MCR;          /**< Module Control Register, Address offset: 0x8 */
+			volatile unsigned int MSR;          /**< Module Status Register, Address offset: 0xC */
+			volatile unsigned int MIER;         /**< Module Interrupt Enable Register, Address offset: 0x10 */
+			volatile unsigned int SETTEN;       /**< Set Timer Enable Register, Address offset: 0x14 */
+			volatile unsigned int CLRTEN;       /**< Clear Timer Enable Register, Address offset: 0x18 */
+			unsigned char RESERVED_0[4];
+			LPIT_Channel_Type TMR[LPIT_CHANNEL_COUNT];   /**< Timer channels, Address offset: 0x20 + 0x10 * n */
+} LPIT_Type;
+
+/** Peripheral LPIT0 base pointer */
+#define LPIT0 ((LPIT_Type *)LPIT0_BASE_ADDRESS)
+
+#endif  /* LPIT_REG_H */
@@ -0,0 +1,222 @@
+/****************************************************************************************************
+* @file     Lptmr.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the LPTMR driver.
+* @details  This header file contains the definitions, structures, and function prototypes for the
+*           Low Power Timer in time-counter mode (e.g. a 1 Hz timebase that runs in VLPS) and in
+*           pulse-counter mode (e.g. counting a 1PPS or 50/60 Hz mains reference without the CPU).
+* @version  1.0.0
+* @date     2024-10-31
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPTMR_H
+#define LPTMR_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lptmr_Registers.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define LPTMR_LPO1K_FREQ_HZ                 (1000u)            /* LPO 1 kHz output */
+#define LPTMR_RTC_CLK_FREQ_HZ               (32768u)           /* Default RTC_CLK (32 kHz crystal or LPO32K) */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     LPTMR Return Status Type
+ */
+typedef enum
+{
+			LPTMR_OK            = 0U,       /**< Operation completed successfully. */
+			LPTMR_ERR_PARA      = 1U,       /**< Parameter error */
+			LPTMR_ERR_BUSY      = 2U,       /**< Timer running, the setting can only change while stopped */
+} Lptmr_ret_t;
+
+/**
+ * @brief     LPTMR counter mode.
+ */
+typedef enum
+{
+			LPTMR_MODE_TIMER    = 0U,       /**< Time counter, counts the prescaled clock */
+			LPTMR_MODE_PULSE    = 1U,       /**< Pulse counter, counts edges on the selected input */
+} Lptmr_mode_t;
+
+/**
+ * @brief     LPTMR prescaler clock.
+ */
+typedef enum
+{
+			LPTMR_CLK_SIRCDIV2  = 0U,       /**< SIRCDIV2_CLK, needs SIRC enabled in stop for VLPS */
+			LPTMR_CLK_LPO1K     = 1U,       /**< LPO 1 kHz, always on */
+			LPTMR_CLK_RTC       = 2U,       /**< RTC_CLK (32 kHz) */
+			LPTMR_CLK_PCC       = 3U,       /**< Clock selected by PCC_LPTMR0[PCS] */
+} Lptmr_clock_t;
+
+/**
+ * @brief     LPTMR prescaler / glitch filter.
+ * @details   In timer mode the clock is divided by 2^(n+1). In pulse mode the glitch filter
+ *            recognizes an input change after 2^n clock edges; LPTMR_PRESCALE_DIV_2 is not
+ *            supported there.
+ */
+typedef enum
+{
+			LPTMR_PRESCALE_DIV_2      = 0U,   /*!< Divide-by-2 */
+			LPTMR_PRESCALE_DIV_4      = 1U,   /*!< Divide-by-4 / glitch filter 2 edges */
+			LPTMR_PRESCALE_DIV_8      = 2U,   /*!< Divide-by-8 / glitch filter 4 edges */
+			LPTMR_PRESCALE_DIV_16     = 3U,   /*!< Divide-by-16 / glitch filter 8 edges */
+			LPTMR_PRESCALE_DIV_32     = 4U,   /*!< Divide-by-32 / glitch filter 16 edges */
+			LPTMR_PRESCALE_DIV_64     = 5U,   /*!< Divide-by-64 / glitch filter 32 edges */
+			LPTMR_PRESCALE_DIV_128    = 6U,   /*!< Divide-by-128 / glitch filter 64 edges */
+			LPTMR_PRESCALE_DIV_256    = 7U,   /*!< Divide-by-256 / glitch filter 128 edges */
+			LPTMR_PRESCALE_DIV_512    = 8U,   /*!< Divide-by-512 / glitch filter 256 edges */
+			LPTMR_PRESCALE_DIV_1024   = 9U,   /*!< Divide-by-1024 / glitch filter 512 edges */
+			LPTMR_PRESCALE_DIV_2048   = 10U,  /*!< Divide-by-2048 / glitch filter 1024 edges */
+			LPTMR_PRESCALE_DIV_4096   = 11U,  /*!< Divide-by-4096 / glitch filter 2048 edges */
+			LPTMR_PRESCALE_DIV_8192   = 12U,  /*!< Divide-by-8192 / glitch filter 4096 edges */
+			LPTMR_PRESCALE_DIV_16384  = 13U,  /*!< Divide-by-16384 / glitch filter 8192 edges */
+			LPTMR_PRESCALE_DIV_32768  = 14U,  /*!< Divide-by-32768 / glitch filter 16384 edges */
+			LPTMR_PRESCALE_DIV_65536  = 15U,  /*!< Divide-by-65536 / glitch filter 32768 edges */
+} Lptmr_prescale_t;
+
+/**
+ * @brief     LPTMR pulse input.
+ */
+typedef enum
+{
+			LPTMR_PIN_CMP0      = 0U,       /**< CMP0 output */
+			LPTMR_PIN_ALT1      = 1U,       /**< LPTMR0_ALT1 pin */
+			LPTMR_PIN_ALT2      = 2U,       /**< LPTMR0_ALT2 pin */
+			LPTMR_PIN_ALT3      = 3U,       /**< LPTMR0_ALT3 pin */
+} Lptmr_pin_t;
+
+/**
+ * @brief     LPTMR pulse input polarity.
+ */
+typedef enum
+{
+			LPTMR_POLARITY_RISING   = 0U,   /**< Count rising edges */
+			LPTMR_POLARITY_FALLING  = 1U,   /**< Count falling edges */
+} Lptmr_polarity_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Compare match callback, called from LPTMR0_IRQHandler.
+ */
+typedef void (*Lptmr_CallbackType)(void);
+
+/**
+ * @brief   Configuration structure for the LPTMR.
+ */
+typedef struct
+{
+			Lptmr_mode_t               mode;              /*!< Time or pulse counter */
+			Lptmr_clock_t              clockSrc;          /*!< Prescaler / glitch filter clock */
+			peripheral_clock_source_t  pccClkSrc;         /*!< PCC source when clockSrc is LPTMR_CLK_PCC */
+			unsigned int               rtcClockHz;        /*!< RTC_CLK frequency, 0 for LPTMR_RTC_CLK_FREQ_HZ */
+			Lptmr_prescale_t           prescaler;         /*!< Prescaler / glitch filter */
+			unsigned char              prescalerBypass;   /*!< Count the clock or input directly */
+			Lptmr_pin_t                pinSelect;         /*!< Pulse input */
+			Lptmr_polarity_t           pinPolarity;       /*!< Pulse input polarity */
+			unsigned short             compareValue;      /*!< Compare value, the period is compareValue + 1 counts */
+			unsigned char              freeRunning;       /*!< Keep counting past the compare value */
+			unsigned char              interruptEnable;   /*!< Interrupt on compare match */
+			Lptmr_CallbackType         callback;          /*!< Compare match callback, may be NULL */
+} Lptmr_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the LPTMR.
+ *
+ * This function requests the LPTMR clock gate, stops the timer and programs the prescaler, the
+ * compare value and the control register. The timer is left stopped.
+ *
+ * @param[in] ConfigPtr Pointer to the LPTMR configuration structure.
+ * @return LPTMR_OK on success, LPTMR_ERR_PARA on parameter error.
+ * @note Enable LPTMR0_IRQn in the NVIC (or as a Sleep wake-up source) to receive the callback.
+ */
+Lptmr_ret_t Lptmr_Init(const Lptmr_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Stops the LPTMR and releases its clock gate.
+ *
+ * @return void.
+ */
+void Lptmr_Deinit(void);
+
+/*!
+ * @brief Starts the LPTMR.
+ *
+ * @return void.
+ */
+void Lptmr_Start(void);
+
+/*!
+ * @brief Stops the LPTMR. The counter and the compare flag are cleared.
+ *
+ * @return void.
+ */
+void Lptmr_Stop(void);
+
+/*!
+ * @brief Changes the compare value.
+ *
+ * @param[in] compareValue New compare value.
+ * @return LPTMR_OK on success, LPTMR_ERR_BUSY when the timer runs and the compare flag is clear.
+ * @note While running, the compare value may only change after a match, e.g. in the callback.
+ */
+Lptmr_ret_t Lptmr_SetCompare(unsigned short compareValue);
+
+/*!
+ * @brief Reads the counter.
+ *
+ * @return Current counter value.
+ */
+unsigned short Lptmr_GetCounter(void);
+
+/*!
+ * @brief Checks the compare flag.
+ *
+ * @return 1 when the counter matched the compare value, 0 otherwise.
+ */
+unsigned char Lptmr_GetCompareFlag(void);
+
+/*!
+ * @brief Clears the compare flag.
+ *
+ * @return void.
+ */
+void Lptmr_ClearCompareFlag(void);
+
+/*!
+ * @brief Gets the counting frequency in time-counter mode.
+ *
+ * @return Frequency of the counter in Hz after the prescaler, 0 in pulse-counter mode.
+ */
+unsigned int Lptmr_GetCountFreq(void);
+
+/*!
+ * @brief LPTMR0 interrupt handler.
+ *
+ * Clears the compare flag and calls the configured callback.
+ *
+ * @return void.
+ */
+void LPTMR0_IRQHandler(void);
+
+#endif  /* LPTMR_H */
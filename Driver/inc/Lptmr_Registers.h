@@ -0,0 +1,65 @@
+/****************************************************************************************************
+* @file     Lptmr_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for LPTMR peripheral registers.
+* @details  This header file contains the definitions and structures for the Low Power Timer
+*           (LPTMR) of the S32K144, which keeps counting in STOP and VLPS.
+* @version  1.0.0
+* @date     2024-10-31
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPTMR_REG_H
+#define LPTMR_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral LPTMR0 base address ***/
+#define LPTMR0_BASE_ADDRESS                 (0x40040000u)
+
+/*** CSR - Control Status Register ***/
+#define LPTMR_CSR_TEN_SHIFT                 (0u)               /* Timer Enable */
+#define LPTMR_CSR_TMS_SHIFT                 (1u)               /* Timer Mode Select */
+#define LPTMR_CSR_TFC_SHIFT                 (2u)               /* Timer Free-Running Counter */
+#define LPTMR_CSR_TPP_SHIFT                 (3u)               /* Timer Pin Polarity */
+#define LPTMR_CSR_TPS_SHIFT                 (4u)               /* Timer Pin Select */
+#define LPTMR_CSR_TIE_SHIFT                 (6u)               /* Timer Interrupt Enable */
+#define LPTMR_CSR_TCF_SHIFT                 (7u)               /* Timer Compare Flag (write 1 to clear) */
+#define LPTMR_CSR_TDRE_SHIFT                (8u)               /* Timer DMA Request Enable */
+
+/*** PSR - Prescale Register ***/
+#define LPTMR_PSR_PCS_SHIFT                 (0u)               /* Prescaler Clock Select */
+#define LPTMR_PSR_PBYP_SHIFT                (2u)               /* Prescaler Bypass */
+#define LPTMR_PSR_PRESCALE_SHIFT            (3u)               /* Prescale Value */
+
+/*** Counter width ***/
+#define LPTMR_CNR_MAX                       (0xFFFFu)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief LPTMR Register Structure.
+ *
+ * This structure represents the LPTMR registers.
+ */
+typedef struct {
+			volatile unsigned int CSR;          /**< Control Status Register, Address offset: 0x0 */
+			volatile unsigned int PSR;          /**< Prescale Register, Address offset: 0x4 */
+			volatile unsigned int CMR;          /**< Compare Register, Address offset: 0x8 */
+			volatile unsigned int CNR;          /**< Counter Register, Address offset: 0xC */
+} LPTMR_Type;
+
+/** Peripheral LPTMR0 base pointer */
+#define LPTMR0 ((LPTMR_Type *)LPTMR0_BASE_ADDRESS)
+
+#endif  /* LPTMR_REG_H */
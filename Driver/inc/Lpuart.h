@@ -0,0 +1,245 @@
+/****************************************************************************************************
+* @file     Lpuart.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the LPUART driver.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           non-blocking serial communication on LPUART0 - LPUART2. Received and transmitted bytes
+*           pass through ring buffers filled and drained in the interrupt, using the FIFO
+*           watermarks; transmission may use a DMA channel instead. The ring buffers are exposed
+*           without copies through Lpuart_WriteBegin() / Lpuart_WriteCommit() and
+*           Lpuart_Peek() / Lpuart_Consume().
+* @version  1.0.0
+* @date     2024-11-04
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPUART_H
+#define LPUART_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpuart_Registers.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define LPUART_BAUD_TOLERANCE_PERCENT       (3u)               /* Largest accepted baud rate error */
+#define LPUART_IDLECFG_MAX                  (7u)               /* 128 idle characters */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     LPUART Return Status Type
+ */
+typedef enum
+{
+			LPUART_OK           = 0U,       /**< Operation completed successfully. */
+			LPUART_ERR_PARA     = 1U,       /**< Parameter error */
+			LPUART_ERR_BAUD     = 2U,       /**< Baud rate not reachable from the functional clock */
+} Lpuart_ret_t;
+
+/**
+ * @brief     Parity.
+ */
+typedef enum
+{
+			LPUART_PARITY_NONE  = 0U,       /**< 8 data bits, no parity */
+			LPUART_PARITY_EVEN  = 1U,       /**< 8 data bits, even parity */
+			LPUART_PARITY_ODD   = 2U,       /**< 8 data bits, odd parity */
+} Lpuart_parity_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Idle line callback.
+ * @details Called from the interrupt when the line went idle after received data, e.g. the end
+ *          of a frame. The received bytes are already in the ring buffer.
+ */
+typedef void (*Lpuart_IdleCallbackType)(unsigned char instance);
+
+/**
+ * @brief   Configuration structure for an LPUART instance.
+ * @note    Buffer sizes must be powers of two, at most 32768 bytes.
+ */
+typedef struct
+{
+			unsigned char                   instance;       /*!< LPUART instance (0-2) */
+			peripheral_clock_source_t       clkSrc;         /*!< PCC functional clock source */
+			unsigned int                    baudRate;       /*!< Baud rate */
+			Lpuart_parity_t                 parity;         /*!< Parity */
+			unsigned char                   twoStopBits;    /*!< Two stop bits instead of one */
+			unsigned char                   rxWatermark;    /*!< Interrupt when more bytes are in the RX FIFO (0-3) */
+			unsigned char                   txWatermark;    /*!< Interrupt when at most this many bytes are in the TX FIFO (0-3) */
+			unsigned char                   idleConfig;     /*!< Idle line after 2^idleConfig characters (0-7) */
+			unsigned char *                 rxBuffer;       /*!< Receive ring storage */
+			unsigned short                  rxBufferSize;   /*!< Receive ring size */
+			unsigned char *                 txBuffer;       /*!< Transmit ring storage */
+			unsigned short                  txBufferSize;   /*!< Transmit ring size */
+			unsigned char                   txDma;          /*!< Transmit with DMA instead of the TX interrupt */
+			unsigned char                   dmaChannel;     /*!< DMA channel used when txDma is set */
+			Lpuart_IdleCallbackType         idleCallback;   /*!< Idle line callback, may be NULL */
+} Lpuart_ConfigType;
+
+/**
+ * @brief   LPUART statistics.
+ */
+typedef struct
+{
+			unsigned int   rxBytes;             /*!< Bytes received */
+			unsigned int   txBytes;             /*!< Bytes transmitted */
+			unsigned int   rxDropped;           /*!< Bytes lost because the receive ring was full */
+			unsigned int   rxErrors;            /*!< Parity, framing, noise and overrun errors */
+} Lpuart_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes an LPUART instance.
+ *
+ * The baud rate settings are derived from the PCC functional clock frequency.
+ *
+ * @param[in] ConfigPtr Pointer to the LPUART configuration structure.
+ * @return LPUART_OK on success, LPUART_ERR_PARA or LPUART_ERR_BAUD on error.
+ * @note Enable LPUARTn_RxTx_IRQn in the NVIC.
+ */
+Lpuart_ret_t Lpuart_Init(const Lpuart_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Disables an LPUART instance and releases its clock.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return void.
+ */
+void Lpuart_Deinit(unsigned char instance);
+
+/*!
+ * @brief Recomputes the baud rate settings after the functional clock changed.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return LPUART_OK on success, LPUART_ERR_PARA or LPUART_ERR_BAUD on error.
+ * @note Call from a Perf post-change callback; a frame on the line during the change may be lost.
+ */
+Lpuart_ret_t Lpuart_Retune(unsigned char instance);
+
+/*!
+ * @brief Copies data into the transmit ring and starts the transmission.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] DataPtr Data to send.
+ * @param[in] length Number of bytes.
+ * @return Number of bytes accepted, less than length when the ring is full.
+ */
+unsigned short Lpuart_Write(unsigned char instance, const unsigned char * DataPtr, unsigned short length);
+
+/*!
+ * @brief Gets contiguous free space in the transmit ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr First free byte.
+ * @return Bytes that can be written at *DataPtr.
+ */
+unsigned short Lpuart_WriteBegin(unsigned char instance, unsigned char ** DataPtr);
+
+/*!
+ * @brief Gets the free space in the transmit ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return Bytes Lpuart_Write() accepts without truncating.
+ */
+unsigned short Lpuart_GetTxFree(unsigned char instance);
+
+/*!
+ * @brief Queues bytes written after Lpuart_WriteBegin() and starts the transmission.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] count Bytes written, at most the value returned by Lpuart_WriteBegin().
+ * @return void.
+ */
+void Lpuart_WriteCommit(unsigned char instance, unsigned short count);
+
+/*!
+ * @brief Checks whether everything queued was sent.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return 1 when the ring is empty and the transmitter is idle, 0 otherwise.
+ */
+unsigned char Lpuart_IsTxIdle(unsigned char instance);
+
+/*!
+ * @brief Gets contiguous received data without copying it.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr First unread byte.
+ * @return Bytes readable at *DataPtr; more may follow after Lpuart_Consume().
+ */
+unsigned short Lpuart_Peek(unsigned char instance, unsigned char ** DataPtr);
+
+/*!
+ * @brief Gets the number of received bytes not consumed yet.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return Unread bytes; larger than the Lpuart_Peek() count when the data wraps the ring.
+ */
+unsigned short Lpuart_GetRxCount(unsigned char instance);
+
+/*!
+ * @brief Releases received bytes.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] count Bytes to release, at most the value returned by Lpuart_Peek().
+ * @return void.
+ */
+void Lpuart_Consume(unsigned char instance, unsigned short count);
+
+/*!
+ * @brief Copies received data out of the receive ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr Destination.
+ * @param[in] maxLength Largest number of bytes to copy.
+ * @return Number of bytes copied.
+ */
+unsigned short Lpuart_Read(unsigned char instance, unsigned char * DataPtr, unsigned short maxLength);
+
+/*!
+ * @brief Retrieves the statistics of an LPUART instance.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return LPUART_OK on success, LPUART_ERR_PARA on parameter error.
+ */
+Lpuart_ret_t Lpuart_GetStats(unsigned char instance, Lpuart_StatsType * StatsPtr);
+
+/*!
+ * @brief LPUART0 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART0_RxTx_IRQHandler(void);
+
+/*!
+ * @brief LPUART1 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART1_RxTx_IRQHandler(void);
+
+/*!
+ * @brief LPUART2 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART2_RxTx_IRQHandler(void);
+
+#endif  /* LPUART_H */
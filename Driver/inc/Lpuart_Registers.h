@@ -0,0 +1,114 @@
+/****************************************************************************************************
+* @file     Lpuart_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for LPUART peripheral registers.
+* @details  This header file contains the definitions and structures for the Low Power Universal
+*           Asynchronous Receiver/Transmitters (LPUART0 - LPUART2) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-04
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LPUART_REG_H
+#define LPUART_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral LPUART base addresses ***/
+#define LPUART0_BASE_ADDRESS                (0x4006A000u)
+#define LPUART1_BASE_ADDRESS                (0x4006B000u)
+#define LPUART2_BASE_ADDRESS                (0x4006C000u)
+
+/*** Sizes ***/
+#define LPUART_INSTANCE_COUNT               (3u)
+#define LPUART_FIFO_DEPTH                   (4u)
+
+/*** GLOBAL - Global Register ***/
+#define LPUART_GLOBAL_RST_SHIFT             (1u)               /* Software reset */
+
+/*** BAUD - Baud Rate Register ***/
+#define LPUART_BAUD_SBR_SHIFT               (0u)               /* Baud rate modulo divisor */
+#define LPUART_BAUD_SBR_MAX                 (0x1FFFu)
+#define LPUART_BAUD_SBNS_SHIFT              (13u)              /* Two stop bits */
+#define LPUART_BAUD_BOTHEDGE_SHIFT          (17u)              /* Sample on both edges, required for OSR 4x - 7x */
+#define LPUART_BAUD_TDMAE_SHIFT             (23u)              /* Transmitter DMA enable */
+#define LPUART_BAUD_OSR_SHIFT               (24u)              /* Oversampling ratio - 1 */
+#define LPUART_BAUD_OSR_MIN                 (3u)               /* 4x */
+#define LPUART_BAUD_OSR_MAX                 (31u)              /* 32x */
+#define LPUART_BAUD_OSR_BOTHEDGE            (7u)               /* Below 8x BOTHEDGE is needed */
+
+/*** STAT - Status Register, flags cleared by writing 1 ***/
+#define LPUART_STAT_PF_SHIFT                (16u)              /* Parity error */
+#define LPUART_STAT_FE_SHIFT                (17u)              /* Framing error */
+#define LPUART_STAT_NF_SHIFT                (18u)              /* Noise */
+#define LPUART_STAT_OR_SHIFT                (19u)              /* Receiver overrun */
+#define LPUART_STAT_IDLE_SHIFT              (20u)              /* Idle line */
+#define LPUART_STAT_RDRF_SHIFT              (21u)              /* Receive data register full */
+#define LPUART_STAT_TC_SHIFT                (22u)              /* Transmission complete */
+#define LPUART_STAT_TDRE_SHIFT              (23u)              /* Transmit data register empty */
+#define LPUART_STAT_ERRORS_MASK             (0x000F0000u)      /* PF, FE, NF, OR */
+
+/*** CTRL - Control Register ***/
+#define LPUART_CTRL_PT_SHIFT                (0u)               /* Odd parity */
+#define LPUART_CTRL_PE_SHIFT                (1u)               /* Parity enable */
+#define LPUART_CTRL_ILT_SHIFT               (2u)               /* Idle count starts after the stop bit */
+#define LPUART_CTRL_M_SHIFT                 (4u)               /* 9-bit mode (8 data + parity) */
+#define LPUART_CTRL_IDLECFG_SHIFT           (8u)               /* Idle characters before IDLE, 2^IDLECFG */
+#define LPUART_CTRL_RE_SHIFT                (18u)              /* Receiver enable */
+#define LPUART_CTRL_TE_SHIFT                (19u)              /* Transmitter enable */
+#define LPUART_CTRL_ILIE_SHIFT              (20u)              /* Idle line interrupt enable */
+#define LPUART_CTRL_RIE_SHIFT               (21u)              /* Receiver interrupt enable */
+#define LPUART_CTRL_TCIE_SHIFT              (22u)              /* Transmission complete interrupt enable */
+#define LPUART_CTRL_TIE_SHIFT               (23u)              /* Transmit interrupt enable */
+#define LPUART_CTRL_ORIE_SHIFT              (27u)              /* Overrun interrupt enable */
+
+/*** FIFO - FIFO Register ***/
+#define LPUART_FIFO_RXFE_SHIFT              (3u)               /* Receive FIFO enable */
+#define LPUART_FIFO_TXFE_SHIFT              (7u)               /* Transmit FIFO enable */
+#define LPUART_FIFO_RXFLUSH_SHIFT           (14u)              /* Receive FIFO flush */
+#define LPUART_FIFO_TXFLUSH_SHIFT           (15u)              /* Transmit FIFO flush */
+
+/*** WATER - Watermark Register ***/
+#define LPUART_WATER_TXWATER_SHIFT          (0u)               /* TDRE while TXCOUNT <= TXWATER */
+#define LPUART_WATER_TXCOUNT_SHIFT          (8u)               /* Words in the transmit FIFO */
+#define LPUART_WATER_RXWATER_SHIFT          (16u)              /* RDRF while RXCOUNT > RXWATER */
+#define LPUART_WATER_RXCOUNT_SHIFT          (24u)              /* Words in the receive FIFO */
+#define LPUART_WATER_COUNT_MASK             (0x7u)
+#define LPUART_WATER_MAX                    (LPUART_FIFO_DEPTH - 1u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief LPUART Register Structure.
+ */
+typedef struct {
+			volatile unsigned int VERID;        /**< Version ID Register, Address offset: 0x0 */
+			volatile unsigned int PARAM;        /**< Parameter Register, Address offset: 0x4 */
+			volatile unsigned int GLOBAL;       /**< Global Register, Address offset: 0x8 */
+			volatile unsigned int PINCFG;       /**< Pin Configuration Register, Address offset: 0xC */
+			volatile unsigned int BAUD;         /**< Baud Rate Register, Address offset: 0x10 */
+			volatile unsigned int STAT;         /**< Status Register, Address offset: 0x14 */
+			volatile unsigned int CTRL;         /**< Control Register, Address offset: 0x18 */
+			volatile unsigned int DATA;         /**< Data Register, Address offset: 0x1C */
+			volatile unsigned int MATCH;        /**< Match Address Register, Address offset: 0x20 */
+			volatile unsigned int MODIR;        /**< Modem IrDA Register, Address offset: 0x24 */
+			volatile unsigned int FIFO;         /**< FIFO Register, Address offset: 0x28 */
+			volatile unsigned int WATER;        /**< Watermark Register, Address offset: 0x2C */
+} LPUART_Type;
+
+/** Peripheral LPUART base pointers */
+#define LPUART0 ((LPUART_Type *)LPUART0_BASE_ADDRESS)
+#define LPUART1 ((LPUART_Type *)LPUART1_BASE_ADDRESS)
+#define LPUART2 ((LPUART_Type *)LPUART2_BASE_ADDRESS)
+
+#endif  /* LPUART_REG_H */
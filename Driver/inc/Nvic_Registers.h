@@ -33,6 +33,10 @@
 #define NVIC_IPR_BASE_ADDRESS                     (0xE000E400u)
 #define NVIC_STIR_BASE_ADDRESS                    (0xE000EF00u)
 
+/** Fields, (shift, width, access) for FIELD_SET() and REG_UPDATE() */
+#define NVIC_IRQ(N)                               ((unsigned int)(N) % 32u, 1u, FIELD_RW)  /* Bit of IRQ N in ISER, ICER, ISPR, ICPR */
+#define NVIC_IP_PRI                               (4u, 4u, FIELD_RW)                       /* Implemented priority bits of one IP byte */
+
 
 /*==================================================================================================
 *                                STRUCTURES AND OTHER TYPEDEFS
@@ -147,6 +151,17 @@ typedef struct {
 } NVIC_IPR_Type;
 
 
+/**
+ * @brief           NVIC Interrupt Priority Registers, byte view
+ *
+ * @details         The priority registers are byte accessible: one byte per interrupt, so a
+ *                  priority is set with a single store that leaves the other three alone.
+ */
+typedef struct {
+    volatile unsigned char IP[240];       /*!< Interrupt Priority 0 - 239,                      Address offset: 0xE000E400u */
+} NVIC_IP_Type;
+
+
 /**
  * @brief           NVIC Software Trigger Interrupt Register
  *
@@ -165,6 +180,7 @@ typedef struct {
 #define NVIC_ICPR                             ((NVIC_ICPR_Type *)NVIC_ICPR_BASE_ADDRESS)
 #define NVIC_IABR                             ((NVIC_IABR_Type *)NVIC_IABR_BASE_ADDRESS)
 #define NVIC_IPR                              ((NVIC_IPR_Type *)NVIC_IPR_BASE_ADDRESS)
+#define NVIC_IP                               ((NVIC_IP_Type *)NVIC_IPR_BASE_ADDRESS)
 #define NVIC_STIR                             ((NVIC_STIR_Type *)NVIC_STIR_BASE_ADDRESS)
 
 #endif /* Nvic_Registers */
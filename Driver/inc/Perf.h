@@ -0,0 +1,180 @@
+/****************************************************************************************************
+* @file     Perf.h
+* @author   Ma Hien Nhan
+* @brief    Header file for runtime performance level (dynamic frequency) control.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           moving the device between HSRUN, RUN and VLPR at runtime. Registered callbacks are told
+*           before and after every change so that SysTick, UART baud rates and PWM periods can be
+*           recomputed for the new clocks.
+* @version  1.0.0
+* @date     2024-10-26
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PERF_H
+#define PERF_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock.h"
+#include "Smc_Registers.h"
+#include "Pmc_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Registered callbacks ***/
+#define PERF_MAX_CALLBACKS                  (8u)               /* Maximum number of callbacks */
+
+/*** Bounded waits for mode and clock switches (polling iterations) ***/
+#define PERF_WAIT_LOOPS                     (200000u)
+
+/*** Frequency limits per power mode (S32K14x data sheet). The slow clock also clocks the flash;
+     the flash controller inserts wait states itself, so respecting this limit is what keeps
+     flash accesses valid in every mode. ***/
+#define PERF_HSRUN_MAX_CORE_HZ              (112000000u)
+#define PERF_HSRUN_MAX_BUS_HZ               (56000000u)
+#define PERF_HSRUN_MAX_SLOW_HZ              (28000000u)
+#define PERF_RUN_MAX_CORE_HZ                (80000000u)
+#define PERF_RUN_MAX_BUS_HZ                 (48000000u)
+#define PERF_RUN_MAX_SLOW_HZ                (26670000u)
+#define PERF_VLPR_MAX_CORE_HZ               (4000000u)
+#define PERF_VLPR_MAX_BUS_HZ                (4000000u)
+#define PERF_VLPR_MAX_SLOW_HZ               (1000000u)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Perf Return Status Type
+ */
+typedef enum
+{
+			PERF_OK             = 0U,       /**< Operation completed successfully. */
+			PERF_ERR_PARA       = 1U,       /**< Parameter error or configuration outside the mode limits */
+			PERF_ERR_FULL       = 2U,       /**< No free callback slot */
+			PERF_ERR_TIMEOUT    = 3U,       /**< Mode or clock switch did not complete */
+} Perf_ret_t;
+
+/**
+ * @brief     Performance levels, ordered from lowest to highest frequency.
+ */
+typedef enum
+{
+			PERF_LEVEL_VLPR     = 0U,       /**< Very-Low-Power Run on SIRC */
+			PERF_LEVEL_RUN      = 1U,       /**< Normal Run */
+			PERF_LEVEL_HSRUN    = 2U,       /**< High Speed Run (112 MHz) */
+} Perf_level_t;
+
+/**
+ * @brief     Callback notification type.
+ */
+typedef enum
+{
+			PERF_NOTIFY_PRE_CHANGE   = 0U,  /**< Clocks are about to change to the given frequencies */
+			PERF_NOTIFY_POST_CHANGE  = 1U,  /**< Clocks changed to the given frequencies */
+} Perf_notify_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Clock frequencies of a performance level.
+ */
+typedef struct
+{
+			unsigned int coreHz;                /*!< Core / system clock */
+			unsigned int busHz;                 /*!< Bus clock */
+			unsigned int slowHz;                /*!< Slow (flash) clock */
+} Perf_FreqType;
+
+/**
+ * @brief   Clock change callback.
+ * @details Example: on PERF_NOTIFY_POST_CHANGE call Systick_Retune(FreqPtr->coreHz / 1000u).
+ */
+typedef void (*Perf_CallbackType)(Perf_notify_t notify, const Perf_FreqType * FreqPtr, void * userData);
+
+/**
+ * @brief   Configuration structure for the performance levels.
+ * @note    One SPLL setting serves RUN and HSRUN; the RUN configuration divides the core clock
+ *          so that it stays within the RUN limits.
+ */
+typedef struct
+{
+			const Scg_Spll_ConfigType *      spllConfig;       /*!< SPLL, relocked when leaving VLPR */
+			const Scg_RunMode_ConfigType *   runConfig;        /*!< RUN level clocks */
+			const Scg_RunMode_ConfigType *   runSircConfig;    /*!< RUN on SIRC, used around VLPR */
+			const Scg_HSRunMode_ConfigType * hsrunConfig;      /*!< HSRUN level clocks */
+			const Scg_VlprMode_ConfigType *  vlprConfig;       /*!< VLPR level clocks */
+			Perf_level_t                     idleLevel;        /*!< Level used when no boost is requested */
+} Perf_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the performance level control.
+ *
+ * This function checks every level against the power mode limits, allows HSRUN and VLPR in the
+ * SMC and loads the HSRUN and VLPR clock control registers. The device must be in RUN mode
+ * with runConfig applied.
+ *
+ * @param[in] ConfigPtr Pointer to the performance configuration structure.
+ * @return PERF_OK on success, PERF_ERR_PARA on parameter error.
+ */
+Perf_ret_t Perf_Init(const Perf_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Registers a clock change callback.
+ *
+ * @param[in] callback Callback function.
+ * @param[in] userData Passed back to the callback.
+ * @return PERF_OK on success, PERF_ERR_PARA or PERF_ERR_FULL on error.
+ */
+Perf_ret_t Perf_RegisterCallback(Perf_CallbackType callback, void * userData);
+
+/*!
+ * @brief Moves to a performance level.
+ *
+ * HSRUN and VLPR are always entered and left through RUN. Callbacks are told before and after
+ * every mode step.
+ *
+ * @param[in] level Target level.
+ * @return PERF_OK on success, PERF_ERR_TIMEOUT when a switch did not complete.
+ */
+Perf_ret_t Perf_SetLevel(Perf_level_t level);
+
+/*!
+ * @brief Retrieves the current performance level.
+ *
+ * @return Current level.
+ */
+Perf_level_t Perf_GetLevel(void);
+
+/*!
+ * @brief Requests HSRUN for a burst of work (animation, communication).
+ *
+ * Requests are counted; the first one boosts to HSRUN. A request that fails is not counted and
+ * must not be released.
+ *
+ * @return PERF_OK on success, the error of Perf_SetLevel() when the boost failed.
+ */
+Perf_ret_t Perf_RequestBoost(void);
+
+/*!
+ * @brief Releases a boost request.
+ *
+ * When the last request is released the device returns to the idle level.
+ *
+ * @return PERF_OK on success, PERF_ERR_TIMEOUT when the switch did not complete.
+ */
+Perf_ret_t Perf_ReleaseBoost(void);
+
+#endif  /* PERF_H */
@@ -0,0 +1,87 @@
+/****************************************************************************************************
+* @file     Pmc.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the PMC low voltage warning driver.
+* @details  This header file contains the definitions, structures, and function prototypes for the
+*           low voltage warning of the Power Management Controller. The warning trips above the
+*           low voltage detect reset, so the interval between the two, set by the hold-up
+*           capacitance and the load, is the time left to save the state.
+* @version  1.0.0
+* @date     2024-11-13
+* @note     The low voltage detect reset (LVDRE) is left at its reset value, enabled. The warning
+*           is reported once; Pmc_ArmWarning() arms it again after the supply has recovered.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PMC_H
+#define PMC_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Pmc_Registers.h"
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     PMC Return Status Type
+ */
+typedef enum
+{
+			PMC_OK              = 0U,       /**< Operation completed successfully. */
+			PMC_ERR_PARA        = 1U,       /**< Parameter error */
+			PMC_ERR_LOW_VOLTAGE = 2U,       /**< Supply still below the warning threshold, not armed */
+} Pmc_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Low voltage warning callback, called from LVD_LVW_IRQHandler.
+ */
+typedef void (*Pmc_CallbackType)(void);
+
+/**
+ * @brief   Configuration structure for the PMC driver.
+ */
+typedef struct
+{
+			Pmc_CallbackType        warningCallback;    /*!< Low voltage warning callback */
+} Pmc_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the low voltage warning.
+ *
+ * @param[in] ConfigPtr Pointer to the PMC configuration structure.
+ * @return PMC_OK on success, PMC_ERR_PARA on parameter error, PMC_ERR_LOW_VOLTAGE when the
+ *         supply is already low.
+ * @note Enable PMC_LVD_IRQn in the NVIC, at a priority that may interrupt everything it saves.
+ */
+Pmc_ret_t Pmc_Init(const Pmc_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Arms the low voltage warning again.
+ *
+ * @return PMC_OK when armed, PMC_ERR_LOW_VOLTAGE while the supply is still low.
+ */
+Pmc_ret_t Pmc_ArmWarning(void);
+
+/*!
+ * @brief Low voltage detect and warning interrupt handler.
+ *
+ * Disables the warning interrupt, so it is reported once, and calls the callback.
+ *
+ * @return void.
+ */
+void LVD_LVW_IRQHandler(void);
+
+#endif  /* PMC_H */
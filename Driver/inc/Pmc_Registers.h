@@ -0,0 +1,67 @@
+/****************************************************************************************************
+* @file     Pmc_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for Power Management Controller (PMC) register definitions.
+* @details  This header file contains the register layout and bit positions of the PMC, which
+*           controls the low voltage detect and the regulator biasing used in low power modes.
+* @version  1.0.0
+* @date     2024-10-26
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PMC_REG_H
+#define PMC_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral PMC base address ***/
+#define PMC_BASE_ADDRESS                    (0x4007D000u)
+
+/* LVDSC1 - Low Voltage Detect Status and Control 1 */
+#define PMC_LVDSC1_LVDRE_SHIFT              (4u)               /* Low Voltage Detect Reset Enable */
+#define PMC_LVDSC1_LVDIE_SHIFT              (5u)               /* Low Voltage Detect Interrupt Enable */
+#define PMC_LVDSC1_LVDACK_SHIFT             (6u)               /* Low Voltage Detect Acknowledge */
+#define PMC_LVDSC1_LVDF_SHIFT               (7u)               /* Low Voltage Detect Flag */
+
+/* LVDSC2 - Low Voltage Detect Status and Control 2 */
+#define PMC_LVDSC2_LVWIE_SHIFT              (5u)               /* Low-Voltage Warning Interrupt Enable */
+#define PMC_LVDSC2_LVWACK_SHIFT             (6u)               /* Low-Voltage Warning Acknowledge */
+#define PMC_LVDSC2_LVWF_SHIFT               (7u)               /* Low-Voltage Warning Flag */
+
+/* REGSC - Regulator Status and Control */
+#define PMC_REGSC_BIASEN_SHIFT              (0u)               /* Bias Enable, required for VLPR/VLPS */
+#define PMC_REGSC_CLKBIASDIS_SHIFT          (1u)               /* Clock Bias Disable */
+#define PMC_REGSC_REGFPM_SHIFT              (2u)               /* Regulator in Full Performance Mode */
+#define PMC_REGSC_LPOSTAT_SHIFT             (6u)               /* LPO Status */
+#define PMC_REGSC_LPODIS_SHIFT              (7u)               /* LPO Disable */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Power Management Controller (PMC) structure.
+ * @details This structure represents the PMC Register Layout Typedef. All registers are 8-bit.
+ */
+typedef struct {
+			volatile unsigned char LVDSC1;                           /**< Low Voltage Detect Status and Control 1, Address offset: 0x0 */
+			volatile unsigned char LVDSC2;                           /**< Low Voltage Detect Status and Control 2, Address offset: 0x1 */
+			volatile unsigned char REGSC;                            /**< Regulator Status and Control, Address offset: 0x2 */
+			unsigned char RESERVED_0[1];
+			volatile unsigned char LPOTRIM;                          /**< Low Power Oscillator Trim, Address offset: 0x4 */
+} PMC_Type;
+
+
+/** Peripheral PMC base pointer */
+#define PMC ((PMC_Type *)PMC_BASE_ADDRESS)
+
+
+#endif /* PMC_REG_H */
@@ -32,57 +32,23 @@
 Port_ret_t Port_Init(const Port_ConfigType* ConfigPtr)
 {
 		Port_ret_t ret = PORT_OK;
-		unsigned int regValue = ConfigPtr->base->PCR[ConfigPtr->pinPortIdx];
 	
 		/* Check parameter */
-		if (ConfigPtr == NULL || ConfigPtr->pinPortIdx >= PORT_PCR_COUNT)
+		if ((ConfigPtr == NULL) || (ConfigPtr->pinPortIdx >= PORT_PCR_COUNT) ||
+		    (ConfigPtr->pullConfig > PORT_PULL_UP) || (ConfigPtr->driveSelect > PORT_HIGH_DRV_STRENGTH))
 		{
 					return PORT_ERR_PARA;  /* Return error if parameters are invalid */
 		}
 		
-		/* 1. Internal resistor pull feature selection. */
-		switch (ConfigPtr->pullConfig)
-		{
-			case PORT_NO_PULL_UP_DOWN:
-				{
-						regValue &= ~(ENABLEMENT << BIT1);
-				}
-				break;
-			case PORT_PULL_DOWN:
-				{
-						regValue &= ~(ENABLEMENT << BIT0);
-						regValue |= (ENABLEMENT << BIT1);
-				}
-				break;
-			case PORT_PULL_UP:
-				{
-						regValue |= (ENABLEMENT << BIT0);
-						regValue |= (ENABLEMENT << BIT1);
-				}
-				break;
-		}
-
-		/* 2. Configures the drive strength.*/
-		if (ConfigPtr->driveSelect == PORT_LOW_DRV_STRENGTH)
-		{
-				regValue &= ~(ENABLEMENT << BIT6);
-		}
-		else if (ConfigPtr->driveSelect == PORT_HIGH_DRV_STRENGTH)
-		{
-				regValue &= ~(ENABLEMENT << BIT6);
-				regValue |= (ENABLEMENT << BIT6);
-		}
-
-		/* 3. Mux selection. */
-		regValue &= ~((ENABLEMENT << BIT8)|(ENABLEMENT << BIT9)|(ENABLEMENT << BIT10));
-		regValue |= (unsigned int) (ConfigPtr->mux << BIT8);
-		
-		/* 4. Interrupt generation condition. */
-		regValue &= ~((ENABLEMENT << BIT16)|(ENABLEMENT << BIT17)|(ENABLEMENT << BIT18)|(ENABLEMENT << BIT19));
-		regValue |= (unsigned int) (ConfigPtr->intConfig << BIT16);
-
-		/* Write the configured value back to the PCR register. */
-		ConfigPtr->base->PCR[ConfigPtr->pinPortIdx] = regValue;
+		/* 1. Internal resistor pull feature selection, 2. drive strength, 3. mux selection and
+		      4. interrupt generation condition, in one write of the PCR register. ISF is written
+		      as 0, so that a pending interrupt flag is not cleared by the configuration. */
+		REG_UPDATE(ConfigPtr->base->PCR[ConfigPtr->pinPortIdx], PORT_PCR_W1C,
+		           FIELD_SET(PORT_PCR_PS, (ConfigPtr->pullConfig == PORT_PULL_UP) ? 1u : 0u),
+		           FIELD_SET(PORT_PCR_PE, (ConfigPtr->pullConfig != PORT_NO_PULL_UP_DOWN) ? 1u : 0u),
+		           FIELD_SET(PORT_PCR_DSE, ConfigPtr->driveSelect),
+		           FIELD_SET(PORT_PCR_MUX, ConfigPtr->mux),
+		           FIELD_SET(PORT_PCR_IRQC, ConfigPtr->intConfig));
 		
 		/* Port Return Status Type */
 		return ret;
@@ -37,6 +37,17 @@
 #define PORTD_BASE                               (0x4004C000u)        /** Peripheral PORTD base address */
 #define PORTE_BASE                               (0x4004D000u)        /** Peripheral PORTC base address */
 
+/** PCR fields, (shift, width, access) for FIELD_SET() and REG_UPDATE() */
+#define PORT_PCR_PS                              (0u, 1u, FIELD_RW)   /** Pull select, 1: pull-up */
+#define PORT_PCR_PE                              (1u, 1u, FIELD_RW)   /** Pull enable */
+#define PORT_PCR_PFE                             (4u, 1u, FIELD_RW)   /** Passive filter enable */
+#define PORT_PCR_DSE                             (6u, 1u, FIELD_RW)   /** Drive strength enable */
+#define PORT_PCR_MUX                             (8u, 3u, FIELD_RW)   /** Pin mux control */
+#define PORT_PCR_LK                              (15u, 1u, FIELD_RW)  /** Lock until the next reset */
+#define PORT_PCR_IRQC                            (16u, 4u, FIELD_RW)  /** Interrupt configuration */
+#define PORT_PCR_ISF                             (24u, 1u, FIELD_W1C) /** Interrupt status flag */
+#define PORT_PCR_W1C                             FIELD_MASK(PORT_PCR_ISF)
+
 
 /*==================================================================================================
 *                                STRUCTURES AND OTHER TYPEDEFS
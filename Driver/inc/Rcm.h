@@ -0,0 +1,57 @@
+/****************************************************************************************************
+* @file     Rcm.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the RCM reset source driver.
+* @details  This header file contains the definitions and function prototypes for reading why the
+*           device was last reset from the Reset Control Module.
+* @version  1.0.0
+* @date     2024-11-16
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef RCM_H
+#define RCM_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Rcm_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Reset causes, as returned by Rcm_GetResetCauses(); more than one may be set ***/
+#define RCM_CAUSE_LVD                       ((unsigned int)ENABLEMENT << RCM_SRS_LVD_SHIFT)
+#define RCM_CAUSE_LOC                       ((unsigned int)ENABLEMENT << RCM_SRS_LOC_SHIFT)
+#define RCM_CAUSE_LOL                       ((unsigned int)ENABLEMENT << RCM_SRS_LOL_SHIFT)
+#define RCM_CAUSE_WDOG                      ((unsigned int)ENABLEMENT << RCM_SRS_WDOG_SHIFT)
+#define RCM_CAUSE_PIN                       ((unsigned int)ENABLEMENT << RCM_SRS_PIN_SHIFT)
+#define RCM_CAUSE_POR                       ((unsigned int)ENABLEMENT << RCM_SRS_POR_SHIFT)
+#define RCM_CAUSE_JTAG                      ((unsigned int)ENABLEMENT << RCM_SRS_JTAG_SHIFT)
+#define RCM_CAUSE_LOCKUP                    ((unsigned int)ENABLEMENT << RCM_SRS_LOCKUP_SHIFT)
+#define RCM_CAUSE_SW                        ((unsigned int)ENABLEMENT << RCM_SRS_SW_SHIFT)
+#define RCM_CAUSE_MDM_AP                    ((unsigned int)ENABLEMENT << RCM_SRS_MDM_AP_SHIFT)
+#define RCM_CAUSE_SACKERR                   ((unsigned int)ENABLEMENT << RCM_SRS_SACKERR_SHIFT)
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Retrieves the sources of the last reset.
+ *
+ * @return RCM_CAUSE_ bits of the most recent reset; a power-on reset also sets RCM_CAUSE_LVD.
+ */
+unsigned int Rcm_GetResetCauses(void);
+
+/*!
+ * @brief Retrieves the sources of every reset since the last power-on, and clears them.
+ *
+ * @return RCM_CAUSE_ bits accumulated since power-on or the previous call.
+ */
+unsigned int Rcm_TakeStickyCauses(void);
+
+#endif  /* RCM_H */
@@ -0,0 +1,67 @@
+/****************************************************************************************************
+* @file     Rcm_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for RCM peripheral registers.
+* @details  This header file contains the definitions and structures for the Reset Control Module
+*           (RCM) of the S32K144, which records the source of every reset.
+* @version  1.0.0
+* @date     2024-11-16
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef RCM_REG_H
+#define RCM_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral RCM base address ***/
+#define RCM_BASE_ADDRESS                    (0x4007F000u)
+
+/*** SRS / SSRS - System Reset Status and Sticky System Reset Status, same layout ***/
+#define RCM_SRS_LVD_SHIFT                   (1u)               /* Low voltage detect */
+#define RCM_SRS_LOC_SHIFT                   (2u)               /* Loss of clock (CMU) */
+#define RCM_SRS_LOL_SHIFT                   (3u)               /* Loss of PLL lock */
+#define RCM_SRS_WDOG_SHIFT                  (5u)               /* Watchdog */
+#define RCM_SRS_PIN_SHIFT                   (6u)               /* External reset pin */
+#define RCM_SRS_POR_SHIFT                   (7u)               /* Power-on */
+#define RCM_SRS_JTAG_SHIFT                  (8u)               /* JTAG generated */
+#define RCM_SRS_LOCKUP_SHIFT                (9u)               /* Core lockup */
+#define RCM_SRS_SW_SHIFT                    (10u)              /* Software, SYSRESETREQ */
+#define RCM_SRS_MDM_AP_SHIFT                (11u)              /* Debugger system reset request */
+#define RCM_SRS_SACKERR_SHIFT               (13u)              /* Stop mode acknowledge error */
+
+/*** SRIE - System Reset Interrupt Enable ***/
+#define RCM_SRIE_DELAY_SHIFT                (0u)               /* Delay before the reset, 2 bits */
+#define RCM_SRIE_GIE_SHIFT                  (7u)               /* Global interrupt enable */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief RCM Register Structure.
+ *
+ * This structure represents the RCM registers.
+ */
+typedef struct {
+			volatile unsigned int VERID;        /**< Version ID Register, Address offset: 0x0 */
+			volatile unsigned int PARAM;        /**< Parameter Register, Address offset: 0x4 */
+			volatile unsigned int SRS;          /**< System Reset Status Register, Address offset: 0x8 */
+			volatile unsigned int RPC;          /**< Reset Pin Control Register, Address offset: 0xC */
+			unsigned int RESERVED_0[2];
+			volatile unsigned int SSRS;         /**< Sticky System Reset Status Register, Address offset: 0x18 */
+			volatile unsigned int SRIE;         /**< System Reset Interrupt Enable Register, Address offset: 0x1C */
+} RCM_Type;
+
+/** Peripheral RCM base pointer */
+#define RCM ((RCM_Type *)RCM_BASE_ADDRESS)
+
+#endif  /* RCM_REG_H */
@@ -0,0 +1,71 @@
+/****************************************************************************************************
+* @file     Scb_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for SCB peripheral registers.
+* @details  This header file contains the definitions and structures for the System Control Block
+*           (SCB) of ARM Cortex-M4 microcontrollers.
+* @version  1.0.0
+* @date     2024-10-30
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SCB_REG_H
+#define SCB_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral SCB base address ***/
+#define SCB_BASE_ADDRESS                    (0xE000ED00u)
+
+/*** ICSR - Interrupt Control and State Register ***/
+#define SCB_ICSR_PENDSVSET_SHIFT            (28u)              /* Set PendSV pending */
+
+/*** SCR - System Control Register ***/
+#define SCB_SCR_SLEEPONEXIT_SHIFT           (1u)               /* Sleep on return from an ISR */
+#define SCB_SCR_SLEEPDEEP_SHIFT             (2u)               /* Deep sleep (STOP / VLPS) on WFI */
+#define SCB_SCR_SEVONPEND_SHIFT             (4u)               /* Pending interrupts wake WFE */
+
+/*** SHPR - System handler priority bytes, index = exception number - 4 ***/
+#define SCB_SHPR_PENDSV_INDEX               (10u)              /* Exception 14 */
+#define SCB_SHPR_SYSTICK_INDEX              (11u)              /* Exception 15 */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief SCB Register Structure.
+ *
+ * This structure represents the SCB registers up to the Coprocessor Access Control Register.
+ */
+typedef struct {
+			volatile unsigned int CPUID;        /**< CPUID Base Register, Address offset: 0x0 */
+			volatile unsigned int ICSR;         /**< Interrupt Control and State Register, Address offset: 0x4 */
+			volatile unsigned int VTOR;         /**< Vector Table Offset Register, Address offset: 0x8 */
+			volatile unsigned int AIRCR;        /**< Application Interrupt and Reset Control Register, Address offset: 0xC */
+			volatile unsigned int SCR;          /**< System Control Register, Address offset: 0x10 */
+			volatile unsigned int CCR;          /**< Configuration and Control Register, Address offset: 0x14 */
+			volatile unsigned char SHPR[12];    /**< System Handler Priority Registers (4-15), Address offset: 0x18 */
+			volatile unsigned int SHCSR;        /**< System Handler Control and State Register, Address offset: 0x24 */
+			volatile unsigned int CFSR;         /**< Configurable Fault Status Register, Address offset: 0x28 */
+			volatile unsigned int HFSR;         /**< HardFault Status Register, Address offset: 0x2C */
+			volatile unsigned int DFSR;         /**< Debug Fault Status Register, Address offset: 0x30 */
+			volatile unsigned int MMFAR;        /**< MemManage Fault Address Register, Address offset: 0x34 */
+			volatile unsigned int BFAR;         /**< BusFault Address Register, Address offset: 0x38 */
+			volatile unsigned int AFSR;         /**< Auxiliary Fault Status Register, Address offset: 0x3C */
+			unsigned char RESERVED_0[72];
+			volatile unsigned int CPACR;        /**< Coprocessor Access Control Register, Address offset: 0x88 */
+} SCB_Type;
+
+/** Peripheral SCB base pointer */
+#define SCB ((SCB_Type *)SCB_BASE_ADDRESS)
+
+#endif  /* SCB_REG_H */
@@ -0,0 +1,70 @@
+/****************************************************************************************************
+* @file     Sim_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for SIM peripheral registers.
+* @details  This header file contains the definitions and structures for the System Integration
+*           Module (SIM) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-03
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SIM_REG_H
+#define SIM_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral SIM base address ***/
+#define SIM_BASE_ADDRESS                    (0x40048000u)
+
+/*** ADCOPT - ADC Options Register, ADC1 fields at ADC0 field + 8 ***/
+#define SIM_ADCOPT_ADC_SHIFT(INSTANCE)      (8u * (INSTANCE))
+#define SIM_ADCOPT_TRGSEL_SHIFT             (0u)               /* Trigger source: 0 PDB, 1 TRGMUX */
+#define SIM_ADCOPT_SWPRETRG_SHIFT           (1u)               /* Software pretrigger select */
+#define SIM_ADCOPT_PRETRGSEL_SHIFT          (4u)               /* Pretrigger source: 0 PDB, 1 TRGMUX, 2 software */
+#define SIM_ADCOPT_FIELDS_MASK              (0x3Fu)            /* All fields of one ADC */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief SIM Register Structure.
+ */
+typedef struct {
+			unsigned char RESERVED_0[4];
+			volatile unsigned int CHIPCTL;      /**< Chip Control Register, Address offset: 0x4 */
+			unsigned char RESERVED_1[4];
+			volatile unsigned int FTMOPT0;      /**< FTM Option Register 0, Address offset: 0xC */
+			volatile unsigned int LPOCLKS;      /**< LPO Clock Select Register, Address offset: 0x10 */
+			unsigned char RESERVED_2[4];
+			volatile unsigned int ADCOPT;       /**< ADC Options Register, Address offset: 0x18 */
+			volatile unsigned int FTMOPT1;      /**< FTM Option Register 1, Address offset: 0x1C */
+			volatile unsigned int MISCTRL0;     /**< Miscellaneous control register 0, Address offset: 0x20 */
+			volatile unsigned int SDID;         /**< System Device Identification Register, Address offset: 0x24 */
+			unsigned char RESERVED_3[24];
+			volatile unsigned int PLATCGC;      /**< Platform Clock Gating Control Register, Address offset: 0x40 */
+			unsigned char RESERVED_4[8];
+			volatile unsigned int FCFG1;        /**< Flash Configuration Register 1, Address offset: 0x4C */
+			unsigned char RESERVED_5[4];
+			volatile unsigned int UIDH;         /**< Unique Identification Register High, Address offset: 0x54 */
+			volatile unsigned int UIDMH;        /**< Unique Identification Register Mid-High, Address offset: 0x58 */
+			volatile unsigned int UIDML;        /**< Unique Identification Register Mid Low, Address offset: 0x5C */
+			volatile unsigned int UIDL;         /**< Unique Identification Register Low, Address offset: 0x60 */
+			unsigned char RESERVED_6[4];
+			volatile unsigned int CLKDIV4;      /**< System Clock Divider Register 4, Address offset: 0x68 */
+			volatile unsigned int MISCTRL1;     /**< Miscellaneous Control register 1, Address offset: 0x6C */
+} SIM_Type;
+
+/** Peripheral SIM base pointer */
+#define SIM ((SIM_Type *)SIM_BASE_ADDRESS)
+
+#endif  /* SIM_REG_H */
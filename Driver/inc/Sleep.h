@@ -0,0 +1,170 @@
+/****************************************************************************************************
+* @file     Sleep.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the low-power sleep manager.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           entering WAIT, STOP or VLPS when the application is idle. The deepest state is chosen
+*           from the time until the next timer, the constraints held by drivers and the peripherals
+*           in use. The SCG clock configuration is restored when the device wakes up.
+* @version  1.0.0
+* @date     2024-10-30
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SLEEP_H
+#define SLEEP_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock.h"
+#include "Nvic.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SLEEP_IDLE_FOREVER                  (0xFFFFFFFFu)      /* No timer pending */
+#define SLEEP_MS_PER_MINUTE                 (60000u)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Sleep Return Status Type
+ */
+typedef enum
+{
+			SLEEP_OK            = 0U,       /**< Operation completed successfully. */
+			SLEEP_ERR_PARA      = 1U,       /**< Parameter error */
+			SLEEP_ERR_COUNT     = 2U,       /**< Constraint removed without being added */
+			SLEEP_ERR_CLOCK     = 3U,       /**< RUN clock not restored after a stop mode */
+} Sleep_ret_t;
+
+/**
+ * @brief     Sleep states, ordered from shallowest to deepest.
+ */
+typedef enum
+{
+			SLEEP_STATE_RUN     = 0U,       /**< Awake, no sleep */
+			SLEEP_STATE_WAIT    = 1U,       /**< Core clock gated, peripherals running */
+			SLEEP_STATE_STOP    = 2U,       /**< STOP1: system and bus clocks gated */
+			SLEEP_STATE_VLPS    = 3U,       /**< Very-Low-Power Stop: only SIRC and LPO available */
+			SLEEP_STATE_COUNT   = 4U,       /**< Number of states */
+} Sleep_state_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Time source.
+ * @details Returns a free-running time in milliseconds that keeps counting in STOP and VLPS,
+ *          e.g. derived from the RTC or the LPTMR.
+ */
+typedef unsigned int (*Sleep_TimeType)(void);
+
+/**
+ * @brief   Configuration structure for the sleep manager.
+ */
+typedef struct
+{
+			Sleep_TimeType                  getTimeMs;                          /*!< Time source */
+			const IRQn_Type *               wakeupSources;                      /*!< Interrupts enabled as wake-up sources */
+			unsigned char                   wakeupCount;                        /*!< Number of wake-up sources */
+			const clock_names_t *           stopBlockers;                       /*!< Peripherals that need the bus clock while requested */
+			unsigned char                   stopBlockerCount;                   /*!< Number of stop blockers */
+			unsigned char                   sircInStop;                         /*!< Keep SIRC running in STOP and VLPS (LPTMR on SIRCDIV2) */
+			unsigned int                    minResidencyMs[SLEEP_STATE_COUNT];  /*!< Shortest idle time worth entering each state */
+			unsigned int                    currentUa[SLEEP_STATE_COUNT];       /*!< Supply current in each state, for the power model */
+			const Scg_RunMode_ConfigType *  stopRunConfig;                      /*!< RUN clock on FIRC or SIRC used across STOP / VLPS, may be NULL */
+			const Clock_ConfigImageType *   restoreImage;                       /*!< Image whose RCCR is restored after STOP / VLPS, set with stopRunConfig */
+} Sleep_ConfigType;
+
+/**
+ * @brief   Sleep statistics.
+ */
+typedef struct
+{
+			unsigned int   timeMs[SLEEP_STATE_COUNT];      /*!< Time spent in each state */
+			unsigned int   entries[SLEEP_STATE_COUNT];     /*!< Number of entries into each state */
+			unsigned int   aborts;                         /*!< VLPS entries aborted by a pending interrupt */
+			unsigned int   wakeupsPerMinute;               /*!< Wake-ups during the last complete minute */
+			unsigned int   averageUa;                      /*!< Average current estimated from currentUa */
+} Sleep_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the sleep manager.
+ *
+ * This function enables the wake-up interrupts and, when requested, keeps SIRC running in the
+ * stop modes. VLPS is only used when PMPROT[AVLP] was set by Perf_Init() or the start-up code.
+ *
+ * @param[in] ConfigPtr Pointer to the sleep configuration structure.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ * @note stopRunConfig and restoreImage are given together: the clock switched away before a stop
+ *       mode must be switched back. stopRunConfig must run on FIRC or SIRC.
+ */
+Sleep_ret_t Sleep_Init(const Sleep_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Forbids states deeper than the given one.
+ *
+ * Drivers call this while a transfer needs clocks that stop in the deeper states.
+ *
+ * @param[in] maxState Deepest state still allowed.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ */
+Sleep_ret_t Sleep_AddConstraint(Sleep_state_t maxState);
+
+/*!
+ * @brief Removes a constraint added with Sleep_AddConstraint().
+ *
+ * @param[in] maxState Deepest state still allowed, as passed to Sleep_AddConstraint().
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA or SLEEP_ERR_COUNT on error.
+ */
+Sleep_ret_t Sleep_RemoveConstraint(Sleep_state_t maxState);
+
+/*!
+ * @brief Selects the deepest state that is safe.
+ *
+ * @param[in] idleMs Time until the next timer expires, SLEEP_IDLE_FOREVER when none is pending.
+ * @return Selected state, SLEEP_STATE_RUN when the idle time is too short for any state.
+ */
+Sleep_state_t Sleep_SelectState(unsigned int idleMs);
+
+/*!
+ * @brief Enters the deepest safe state and returns after the wake-up.
+ *
+ * Interrupts are masked while the state is entered and the clocks are restored, so the
+ * wake-up interrupt runs after the SCG configuration is back.
+ *
+ * @param[in] idleMs Time until the next timer expires, SLEEP_IDLE_FOREVER when none is pending.
+ * @param[out] StatePtr State that was used, SLEEP_STATE_RUN when none; may be NULL.
+ * @return SLEEP_OK on success, SLEEP_ERR_CLOCK when the RUN clock could not be restored after a
+ *         stop mode; the device then keeps running on stopRunConfig.
+ */
+Sleep_ret_t Sleep_Enter(unsigned int idleMs, Sleep_state_t * StatePtr);
+
+/*!
+ * @brief Retrieves the sleep statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ */
+Sleep_ret_t Sleep_GetStats(Sleep_StatsType * StatsPtr);
+
+/*!
+ * @brief Clears the sleep statistics.
+ *
+ * @return void.
+ */
+void Sleep_ResetStats(void);
+
+#endif  /* SLEEP_H */
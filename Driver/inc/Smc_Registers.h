@@ -0,0 +1,85 @@
+/****************************************************************************************************
+* @file     Smc_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for System Mode Controller (SMC) register definitions.
+* @details  This header file contains the register layout and bit positions of the SMC, which
+*           selects the RUN, HSRUN, VLPR and stop power modes.
+* @version  1.0.0
+* @date     2024-10-26
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SMC_REG_H
+#define SMC_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral SMC base address ***/
+#define SMC_BASE_ADDRESS                    (0x4007E000u)
+
+/* PMPROT - Power Mode Protection register (write once after reset) */
+#define SMC_PMPROT_AVLP_SHIFT               (5u)               /* Allow Very-Low-Power Modes */
+#define SMC_PMPROT_AHSRUN_SHIFT             (7u)               /* Allow High Speed Run mode */
+
+/* PMCTRL - Power Mode Control register */
+#define SMC_PMCTRL_STOPM_SHIFT              (0u)               /* Stop Mode Control */
+#define SMC_PMCTRL_STOPM_MASK               (0x7u)
+#define SMC_PMCTRL_RUNM_SHIFT               (5u)               /* Run Mode Control */
+#define SMC_PMCTRL_RUNM_MASK                (0x3u)
+#define SMC_PMCTRL_VLPSA_SHIFT              (3u)               /* Very Low Power Stop Aborted */
+
+/* PMCTRL[RUNM] values */
+#define SMC_RUNM_RUN                        (0u)               /* Normal Run mode */
+#define SMC_RUNM_VLPR                       (2u)               /* Very-Low-Power Run mode */
+#define SMC_RUNM_HSRUN                      (3u)               /* High Speed Run mode */
+
+/* PMCTRL[STOPM] values */
+#define SMC_STOPM_STOP                      (0u)               /* Normal Stop */
+#define SMC_STOPM_VLPS                      (2u)               /* Very-Low-Power Stop */
+
+/* STOPCTRL - Stop Control register */
+#define SMC_STOPCTRL_STOPO_SHIFT            (6u)               /* Stop Option */
+#define SMC_STOPCTRL_STOPO_MASK             (0x3u)
+
+/* STOPCTRL[STOPO] values */
+#define SMC_STOPO_STOP1                     (1u)               /* STOP1: system and bus clocks gated */
+#define SMC_STOPO_STOP2                     (2u)               /* STOP2: only system clock gated */
+
+/* PMSTAT - Power Mode Status register values */
+#define SMC_PMSTAT_RUN                      (0x01u)            /* Current mode is RUN */
+#define SMC_PMSTAT_STOP                     (0x02u)            /* Current mode is STOP */
+#define SMC_PMSTAT_VLPR                     (0x04u)            /* Current mode is VLPR */
+#define SMC_PMSTAT_VLPS                     (0x10u)            /* Current mode is VLPS */
+#define SMC_PMSTAT_HSRUN                    (0x80u)            /* Current mode is HSRUN */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   System Mode Controller (SMC) structure.
+ * @details This structure represents the SMC Register Layout Typedef.
+ */
+typedef struct {
+			volatile unsigned int VERID;                             /**< SMC Version ID Register, Address offset: 0x0 */
+			volatile unsigned int PARAM;                             /**< SMC Parameter Register, Address offset: 0x4 */
+			volatile unsigned int PMPROT;                            /**< Power Mode Protection register, Address offset: 0x8 */
+			volatile unsigned int PMCTRL;                            /**< Power Mode Control register, Address offset: 0xC */
+			volatile unsigned int STOPCTRL;                          /**< Stop Control Register, Address offset: 0x10 */
+			volatile unsigned int PMSTAT;                            /**< Power Mode Status register, Address offset: 0x14 */
+} SMC_Type;
+
+
+/** Peripheral SMC base pointer */
+#define SMC ((SMC_Type *)SMC_BASE_ADDRESS)
+
+
+#endif /* SMC_REG_H */
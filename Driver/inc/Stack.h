@@ -0,0 +1,213 @@
+/****************************************************************************************************
+* @file     Stack.h
+* @author   Ma Hien Nhan
+* @brief    Header file for stack usage monitoring.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           painting stacks with a known pattern and measuring their high-water mark. The lowest
+*           word of every stack holds a canary, so an overflow is detected on the next check.
+*           The main stack (MSP) is painted by Stack_Init() at boot; task stacks are painted by
+*           Os_TaskCreate(). Contexts are registered to be reported by Stack_GetUsage(), e.g.
+*           through the PROTO_CMD_GET_STACK command.
+* @version  1.0.0
+* @date     2024-11-11
+* @note     Interrupts run on the main stack. Without the kernel the main loop shares it; with the
+*           kernel, tasks run on their own stacks and the main stack only holds nested interrupts.
+*           STACK_ISR_WATCH records how deep the main stack was when each interrupt was entered.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef STACK_H
+#define STACK_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Nvic.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Build options ***/
+#ifndef STACK_CONTEXT_MAX
+#define STACK_CONTEXT_MAX               (8u)               /* Registered contexts, main stack included */
+#endif
+#ifndef STACK_ISR_WATCH
+#define STACK_ISR_WATCH                 (0u)               /* 1: record the main stack depth at interrupt entry */
+#endif
+
+/*** Main stack bounds, from the linker script ***/
+#ifndef STACK_MAIN_LIMIT
+#define STACK_MAIN_LIMIT                __StackLimit       /* Lowest address */
+#endif
+#ifndef STACK_MAIN_TOP
+#define STACK_MAIN_TOP                  __StackTop         /* Initial MSP */
+#endif
+
+/*** Painting ***/
+#define STACK_PAINT_PATTERN             (0xA5A5A5A5u)      /* Never written by a used stack word, in practice */
+#define STACK_CANARY                    (0x214B5453u)      /* "STK!", lowest word of a stack */
+#define STACK_PAINT_MARGIN_WORDS        (16u)              /* Left below the SP of Stack_Init() */
+#define STACK_ID_MAIN                   (0u)               /* Context registered by Stack_Init() */
+#define STACK_IRQ_COUNT                 (123u)             /* FTM3_Ovf_Reload_IRQn + 1 */
+
+/*** Instrumentation ***/
+#if (STACK_ISR_WATCH != 0u)
+#define STACK_ISR_ENTER(IRQ)            Stack_IsrEnter((unsigned char)(IRQ))
+#else
+#define STACK_ISR_ENTER(IRQ)            ((void)0)
+#endif
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Stack Return Status Type
+ */
+typedef enum
+{
+			STACK_OK            = 0U,       /**< Operation completed successfully. */
+			STACK_ERR_PARA      = 1U,       /**< Parameter error */
+			STACK_ERR_FULL      = 2U,       /**< STACK_CONTEXT_MAX contexts already registered */
+} Stack_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Usage of one registered stack.
+ */
+typedef struct
+{
+			unsigned int        sizeBytes;      /*!< Stack size */
+			unsigned int        usedBytes;      /*!< High-water mark: deepest use since painting */
+			unsigned char       id;             /*!< Identifier given to Stack_Register() */
+			unsigned char       overflow;       /*!< 1 when the canary was overwritten */
+} Stack_UsageType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Paints a stack: canary in the lowest word, pattern in the others.
+ *
+ * @param[out] BasePtr Stack base, lowest address.
+ * @param[in] words Stack size in words.
+ * @return void.
+ * @note Only for a stack that is not in use.
+ */
+static inline void Stack_Paint(unsigned int * BasePtr, unsigned int words)
+{
+		unsigned int index;
+
+		BasePtr[0] = STACK_CANARY;
+		for (index = 1u; index < words; index++)
+		{
+			BasePtr[index] = STACK_PAINT_PATTERN;
+		}
+}
+
+/*!
+ * @brief Counts the words above the canary that still hold the pattern.
+ *
+ * @param[in] BasePtr Stack base, lowest address.
+ * @param[in] words Stack size in words.
+ * @return Words never used since painting.
+ */
+static inline unsigned int Stack_GetUnusedWords(const unsigned int * BasePtr, unsigned int words)
+{
+		unsigned int index = 1u;
+
+		while ((index < words) && (BasePtr[index] == STACK_PAINT_PATTERN))
+		{
+			index++;
+		}
+		return index - 1u;
+}
+
+/*!
+ * @brief Tests the canary of a stack.
+ *
+ * @param[in] BasePtr Stack base, lowest address.
+ * @return 1 when the canary is intact, 0 after an overflow.
+ */
+static inline unsigned char Stack_CanaryIntact(const unsigned int * BasePtr)
+{
+		return (BasePtr[0] == STACK_CANARY) ? 1u : 0u;
+}
+
+/*!
+ * @brief Paints the free part of the main stack and registers it as STACK_ID_MAIN.
+ *
+ * Call first thing in main(): everything below the caller's frame, less a margin, is painted.
+ * The usage of the registered stacks is served to the serial protocol as PROTO_CMD_GET_STACK.
+ *
+ * @return void.
+ */
+void Stack_Init(void);
+
+/*!
+ * @brief Registers a stack to be reported by Stack_GetUsage() and checked by Stack_Check().
+ *
+ * The stack must already be painted, e.g. a task stack passed to Os_TaskCreate().
+ *
+ * @param[in] id Identifier reported with the usage, chosen by the application.
+ * @param[in] BasePtr Stack base, lowest address.
+ * @param[in] words Stack size in words.
+ * @return STACK_OK on success, STACK_ERR_PARA or STACK_ERR_FULL on error.
+ */
+Stack_ret_t Stack_Register(unsigned char id, const unsigned int * BasePtr, unsigned int words);
+
+/*!
+ * @brief Gets the number of registered contexts.
+ *
+ * @return Registered contexts, the main stack at index 0.
+ */
+unsigned char Stack_GetContextCount(void);
+
+/*!
+ * @brief Measures the usage of a registered stack.
+ *
+ * The pattern is scanned from the bottom, so the time grows with the unused part.
+ *
+ * @param[in] index Context index, below Stack_GetContextCount().
+ * @param[out] UsagePtr Pointer to the usage structure.
+ * @return STACK_OK on success, STACK_ERR_PARA on parameter error.
+ */
+Stack_ret_t Stack_GetUsage(unsigned char index, Stack_UsageType * UsagePtr);
+
+/*!
+ * @brief Tests the canaries of all registered stacks.
+ *
+ * @return Bit n set: the stack of context index n overflowed. 0 when all are intact.
+ */
+unsigned int Stack_Check(void);
+
+#if (STACK_ISR_WATCH != 0u)
+/*!
+ * @brief Records the main stack depth at the entry of an interrupt handler.
+ *
+ * Called by STACK_ISR_ENTER() at the top of the handler.
+ *
+ * @param[in] irq IRQ number.
+ * @return void.
+ */
+void Stack_IsrEnter(unsigned char irq);
+
+/*!
+ * @brief Gets the deepest main stack use seen at the entry of an interrupt handler.
+ *
+ * The value includes the frames of the interrupted code and of the interrupts it preempted.
+ * Adding the handler's own use gives the main stack it needs at its priority.
+ *
+ * @param[in] irq IRQ number.
+ * @return Bytes of main stack in use, 0 when the interrupt was never entered.
+ */
+unsigned int Stack_GetIsrDepth(IRQn_Type irq);
+#endif
+
+#endif  /* STACK_H */
@@ -91,6 +91,18 @@ void Systick_Stop(void);
  */
 unsigned int Systick_GetCounter(void);
 
+/*!
+ * @brief Recomputes the reload value for a new clock frequency.
+ * 
+ * This function keeps the period given to Systick_Init() and recalculates the reload value after
+ * the core clock changed. The running state and the interrupt enable are preserved.
+ * 
+ * @param[in] fSystick New clock source frequency (kHz).
+ * @return void.
+ * @note Call this from a clock change notification, e.g. a Perf post-change callback.
+ */
+void Systick_Retune(unsigned int fSystick);
+
 /*!
  * @brief Delays for a specified number of milliseconds.
  * 
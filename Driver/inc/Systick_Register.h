@@ -25,6 +25,14 @@
 /*** Peripheral SYSTICK base address ***/
 #define SYSTICK_BASE_ADDRESS                    (0xE000E010u)
 
+/*** Fields, (shift, width, access) for FIELD_SET() and REG_UPDATE() ***/
+#define SYST_CSR_ENABLE                         (0u, 1u, FIELD_RW)      /* Counter enable */
+#define SYST_CSR_TICKINT                        (1u, 1u, FIELD_RW)      /* SysTick exception request */
+#define SYST_CSR_CLKSOURCE                      (2u, 1u, FIELD_RW)      /* 1: processor clock */
+#define SYST_CSR_COUNTFLAG                      (16u, 1u, FIELD_RC)     /* Counted to 0, cleared by reading CSR */
+#define SYST_RVR_RELOAD                         (0u, 24u, FIELD_RW)     /* Reload value */
+#define SYST_CVR_CURRENT                        (0u, 24u, FIELD_RW)     /* Current value, any write clears it */
+
 
 /*==================================================================================================
 *                                STRUCTURES AND OTHER TYPEDEFS
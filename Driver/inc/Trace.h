@@ -0,0 +1,170 @@
+/****************************************************************************************************
+* @file     Trace.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the event trace recorder.
+* @details  This header file contains the macros and function prototypes for recording ISR entry
+*           and exit, event dispatch, driver calls and user markers into a circular RAM buffer of
+*           fixed-size records. The buffer keeps the latest TRACE_BUFFER_RECORDS records; it is read
+*           with a debugger and converted by Tools/trace2json.py into a Chrome / Perfetto trace:
+*               (gdb) dump binary value trace.bin Trace_Recorder
+* @version  1.0.0
+* @date     2024-11-07
+* @note     With TRACE_ENABLE at 0 the macros expand to nothing and no RAM is used. Timestamps
+*           need Dwt_Init(); call Trace_Init() again after a core clock change.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TRACE_H
+#define TRACE_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Nvic.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/***  Build options ***/
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                    (0u)
+#endif
+#ifndef TRACE_BUFFER_RECORDS
+#define TRACE_BUFFER_RECORDS            (256u)             /* Power of two, 8 bytes each */
+#endif
+
+/*** Recorder layout, read by Tools/trace2json.py ***/
+#define TRACE_MAGIC                     (0x43525454u)      /* "TTRC" */
+#define TRACE_CALIBRATION_RECORDS       (16u)              /* Records timed by Trace_Init() */
+
+/*** Instrumentation ***/
+#if (TRACE_ENABLE != 0u)
+#define TRACE_ISR_ENTER(IRQ)            Trace_Record(TRACE_TYPE_ISR_ENTER, (unsigned char)(IRQ), 0u)
+#define TRACE_ISR_EXIT(IRQ)             Trace_Record(TRACE_TYPE_ISR_EXIT, (unsigned char)(IRQ), 0u)
+#define TRACE_EVENT(ID, ARG)            Trace_Record(TRACE_TYPE_EVENT, (unsigned char)(ID), (unsigned short)(ARG))
+#define TRACE_CALL_BEGIN(ID)            Trace_Record(TRACE_TYPE_CALL_BEGIN, (unsigned char)(ID), 0u)
+#define TRACE_CALL_END(ID, ARG)         Trace_Record(TRACE_TYPE_CALL_END, (unsigned char)(ID), (unsigned short)(ARG))
+#define TRACE_MARK(ID, ARG)             Trace_Record(TRACE_TYPE_MARK, (unsigned char)(ID), (unsigned short)(ARG))
+#else
+#define TRACE_ISR_ENTER(IRQ)            ((void)0)
+#define TRACE_ISR_EXIT(IRQ)             ((void)0)
+#define TRACE_EVENT(ID, ARG)            ((void)0)
+#define TRACE_CALL_BEGIN(ID)            ((void)0)
+#define TRACE_CALL_END(ID, ARG)         ((void)0)
+#define TRACE_MARK(ID, ARG)             ((void)0)
+#endif
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Record types.
+ */
+typedef enum
+{
+			TRACE_TYPE_ISR_ENTER    = 1U,   /**< Interrupt handler entered, id = IRQ number */
+			TRACE_TYPE_ISR_EXIT     = 2U,   /**< Interrupt handler left, id = IRQ number */
+			TRACE_TYPE_EVENT        = 3U,   /**< Event dispatched, id = Trace_id_t */
+			TRACE_TYPE_CALL_BEGIN   = 4U,   /**< Driver / service call started, id = Trace_id_t */
+			TRACE_TYPE_CALL_END     = 5U,   /**< Driver / service call finished, arg = result */
+			TRACE_TYPE_MARK         = 6U,   /**< User marker, id from TRACE_ID_USER */
+} Trace_type_t;
+
+/**
+ * @brief     Event and call identifiers, named by Tools/trace2json.py from this list.
+ */
+typedef enum
+{
+			TRACE_ID_ALARM_FIRE         = 0U,   /**< Alarm fired, arg = alarm id */
+			TRACE_ID_PROTO_COMMAND      = 1U,   /**< Protocol command executed, arg = command */
+			TRACE_ID_PROTO_PROCESS      = 2U,   /**< Proto_Process(), arg = frames handled */
+			TRACE_ID_LOG_PROCESS        = 3U,   /**< Log_Process(), arg = records sent */
+			TRACE_ID_BRIGHTNESS_STEP    = 4U,   /**< Fade step applied, arg = level */
+			TRACE_ID_ALARM_PROCESS      = 5U,   /**< Alarm_Process() */
+			TRACE_ID_USER               = 128U, /**< First identifier free for application markers */
+} Trace_id_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Trace record, 8 bytes.
+ */
+typedef struct
+{
+			unsigned int        timestamp;      /*!< DWT cycle counter */
+			unsigned char       type;           /*!< Trace_type_t */
+			unsigned char       id;             /*!< IRQ number or Trace_id_t */
+			unsigned short      arg;            /*!< Event argument */
+} Trace_RecordType;
+
+/**
+ * @brief   Recorder: header followed by the record ring, dumped as one block.
+ */
+typedef struct
+{
+			unsigned int        magic;          /*!< TRACE_MAGIC once initialized */
+			unsigned int        capacity;       /*!< Number of records in the ring */
+			volatile unsigned int count;        /*!< Records written since Trace_Init(), the ring holds the last ones */
+			unsigned int        cpuHz;          /*!< Core clock, to convert timestamps */
+			unsigned int        overheadCycles; /*!< Measured cost of one record */
+			volatile unsigned int frozen;       /*!< Recording stopped by Trace_Freeze() */
+			Trace_RecordType    records[TRACE_BUFFER_RECORDS];
+} Trace_RecorderType;
+
+STATIC_ASSERT(sizeof(Trace_RecordType) == 8u, trace_record_size);
+STATIC_ASSERT((TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1u)) == 0u, trace_buffer_power_of_two);
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+#if (TRACE_ENABLE != 0u)
+/*!
+ * @brief Initializes the recorder.
+ *
+ * This function clears the ring, records the core clock and measures the cost of one record
+ * with the cycle counter, so the host can account for it.
+ *
+ * @return void.
+ */
+void Trace_Init(void);
+
+/*!
+ * @brief Stores one record.
+ *
+ * Constant time, callable from any interrupt. Use the TRACE_ macros rather than calling it.
+ *
+ * @param[in] type Record type.
+ * @param[in] id IRQ number or event identifier.
+ * @param[in] arg Event argument.
+ * @return void.
+ */
+void Trace_Record(Trace_type_t type, unsigned char id, unsigned short arg);
+
+/*!
+ * @brief Stops recording, keeping the records that lead to the call.
+ *
+ * Call this when a fault is detected (skipped second, display glitch) and read the buffer later.
+ *
+ * @return void.
+ */
+void Trace_Freeze(void);
+
+/*!
+ * @brief Restarts recording after Trace_Freeze().
+ *
+ * @return void.
+ */
+void Trace_Resume(void);
+#else
+#define Trace_Init()                    ((void)0)
+#define Trace_Freeze()                  ((void)0)
+#define Trace_Resume()                  ((void)0)
+#endif
+
+#endif  /* TRACE_H */
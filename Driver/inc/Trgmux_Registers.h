@@ -0,0 +1,59 @@
+/****************************************************************************************************
+* @file     Trgmux_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for TRGMUX peripheral registers.
+* @details  This header file contains the definitions and structures for the Trigger Multiplexing
+*           Control (TRGMUX) of the S32K144.
+* @version  1.0.0
+* @date     2024-11-03
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TRGMUX_REG_H
+#define TRGMUX_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral TRGMUX base address ***/
+#define TRGMUX_BASE_ADDRESS                 (0x40063000u)
+
+/*** Target registers ***/
+#define TRGMUX_REG_COUNT                    (26u)
+#define TRGMUX_ADC0_INDEX                   (3u)
+#define TRGMUX_ADC1_INDEX                   (4u)
+
+/*** TRGMUXn - four selectors per target, SELn at bit 8 * n ***/
+#define TRGMUX_SEL_SHIFT(N)                 (8u * (N))
+#define TRGMUX_SEL_MASK                     (0x3Fu)
+#define TRGMUX_LK_SHIFT                     (31u)              /* Register locked until reset */
+
+/*** Trigger sources ***/
+#define TRGMUX_SOURCE_LPIT_CH0              (17u)
+#define TRGMUX_SOURCE_LPIT_CH1              (18u)
+#define TRGMUX_SOURCE_LPIT_CH2              (19u)
+#define TRGMUX_SOURCE_LPIT_CH3              (20u)
+#define TRGMUX_SOURCE_LPTMR0                (21u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief TRGMUX Register Structure.
+ */
+typedef struct {
+			volatile unsigned int TRGMUXn[TRGMUX_REG_COUNT];    /**< Target selection, Address offset: 0x4 * n */
+} TRGMUX_Type;
+
+/** Peripheral TRGMUX base pointer */
+#define TRGMUX ((TRGMUX_Type *)TRGMUX_BASE_ADDRESS)
+
+#endif  /* TRGMUX_REG_H */
@@ -0,0 +1,145 @@
+/****************************************************************************************************
+* @file     Wdog.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the WDOG driver.
+* @details  This header file contains the definitions, structures, and function prototypes for the
+*           Watchdog Timer. The watchdog resets the device when it is not refreshed within the
+*           timeout; in window mode a refresh before the window opens resets it too, so a task
+*           stuck refreshing in a tight loop is caught as well. An interrupt may be taken 128 bus
+*           clocks before the reset, to record why it happened.
+* @version  1.0.0
+* @date     2024-11-16
+* @note     The watchdog runs out of reset with an 8 ms timeout unless the startup code disables
+*           it. Call Wdog_Init() early, before the clock configuration: on the LPO the timeout does
+*           not depend on the clocks, so a hung SPLL lock wait is caught too. Without allowUpdate
+*           the configuration is final until the next reset.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef WDOG_H
+#define WDOG_H
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Wdog_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define WDOG_LPO_FREQ_HZ                    (128000u)          /* LPO 128 kHz, always on */
+#define WDOG_PRESCALER                      (256u)             /* Division with prescaler256 */
+
+/*** Bounded waits for the unlock and the reconfiguration (polling iterations) ***/
+#define WDOG_WAIT_LOOPS                     (10000u)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     WDOG Return Status Type
+ */
+typedef enum
+{
+			WDOG_OK             = 0U,       /**< Operation completed successfully. */
+			WDOG_ERR_PARA       = 1U,       /**< Parameter error */
+			WDOG_ERR_TIMEOUT    = 2U,       /**< Unlock or reconfiguration not acknowledged, e.g. updates not allowed */
+} Wdog_ret_t;
+
+/**
+ * @brief     WDOG clock source.
+ */
+typedef enum
+{
+			WDOG_CLK_BUS        = 0U,       /**< Bus clock, changes with the performance level */
+			WDOG_CLK_LPO        = 1U,       /**< LPO 128 kHz, always on */
+			WDOG_CLK_SOSC       = 2U,       /**< SOSC */
+			WDOG_CLK_SIRC       = 3U,       /**< SIRC 8 MHz */
+} Wdog_clock_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Pre-reset callback, called from WDOG_EWM_IRQHandler.
+ * @details The reset follows 128 bus clocks after the interrupt: a few stores, no more.
+ */
+typedef void (*Wdog_CallbackType)(void);
+
+/**
+ * @brief   Configuration structure for the WDOG.
+ */
+typedef struct
+{
+			Wdog_clock_t               clkSrc;            /*!< Counter clock */
+			unsigned short             timeout;           /*!< Reset when the counter reaches this many counts */
+			unsigned short             window;            /*!< Refresh allowed from this count on, 0 for no window */
+			unsigned char              prescaler256;      /*!< Divide the clock by WDOG_PRESCALER */
+			unsigned char              allowUpdate;       /*!< Allow Wdog_Init() again after this one */
+			unsigned char              runInDebug;        /*!< Keep counting while the core is halted */
+			unsigned char              runInWait;         /*!< Keep counting in WAIT and VLPW */
+			unsigned char              runInStop;         /*!< Keep counting in STOP and VLPS */
+			unsigned char              RESERVE1[3];
+			Wdog_CallbackType          callback;          /*!< Pre-reset callback, NULL for no interrupt */
+} Wdog_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the WDOG.
+ *
+ * This function unlocks the watchdog with interrupts masked, writes the timeout, the window
+ * and the control register within the 128 bus clocks allowed, and waits for the new
+ * configuration to take effect. The counter restarts from 0.
+ *
+ * @param[in] ConfigPtr Pointer to the WDOG configuration structure.
+ * @return WDOG_OK on success, WDOG_ERR_PARA on parameter error, WDOG_ERR_TIMEOUT when the
+ *         watchdog did not take the configuration.
+ * @note Enable WDOG_EWM_IRQn in the NVIC, at the highest priority, to receive the callback.
+ */
+Wdog_ret_t Wdog_Init(const Wdog_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Refreshes the WDOG.
+ *
+ * With CMD32EN the refresh is one 32-bit store, so it needs no critical section and costs a few
+ * cycles. In window mode it resets the device when called before the window opens.
+ *
+ * @return void.
+ */
+static inline void Wdog_Refresh(void)
+{
+		WDOG->CNT = WDOG_REFRESH_KEY;
+}
+
+/*!
+ * @brief Retrieves the counter.
+ *
+ * @return Counts since the last refresh.
+ */
+unsigned int Wdog_GetCounter(void);
+
+/*!
+ * @brief Tells whether a refresh is allowed now.
+ *
+ * @return 1 without window mode or once the counter reached the window, 0 before.
+ */
+unsigned char Wdog_IsWindowOpen(void);
+
+/*!
+ * @brief Watchdog and EWM interrupt handler.
+ *
+ * Calls the pre-reset callback. The flag is not cleared: the reset follows.
+ *
+ * @return void.
+ */
+void WDOG_EWM_IRQHandler(void);
+
+#endif  /* WDOG_H */
@@ -0,0 +1,71 @@
+/****************************************************************************************************
+* @file     Wdog_Registers.h
+* @author   Ma Hien Nhan
+* @brief    Header file for WDOG peripheral registers.
+* @details  This header file contains the definitions and structures for the Watchdog Timer (WDOG)
+*           of the S32K144. The watchdog is enabled out of reset, clocked by the 128 kHz LPO,
+*           with a timeout of 1024 counts (8 ms).
+* @version  1.0.0
+* @date     2024-11-16
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef WDOG_REG_H
+#define WDOG_REG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Peripheral WDOG base address ***/
+#define WDOG_BASE_ADDRESS                   (0x40052000u)
+
+/*** CS - Control and Status Register ***/
+#define WDOG_CS_STOP_SHIFT                  (0u)               /* Enable in stop mode */
+#define WDOG_CS_WAIT_SHIFT                  (1u)               /* Enable in wait mode */
+#define WDOG_CS_DBG_SHIFT                   (2u)               /* Enable in debug mode */
+#define WDOG_CS_TST_SHIFT                   (3u)               /* Test mode, 2 bits */
+#define WDOG_CS_UPDATE_SHIFT                (5u)               /* Allow updates after the first configuration */
+#define WDOG_CS_INT_SHIFT                   (6u)               /* Interrupt before the reset */
+#define WDOG_CS_EN_SHIFT                    (7u)               /* Enable */
+#define WDOG_CS_CLK_SHIFT                   (8u)               /* Clock source, 2 bits */
+#define WDOG_CS_RCS_SHIFT                   (10u)              /* Reconfiguration success */
+#define WDOG_CS_ULK_SHIFT                   (11u)              /* Unlocked */
+#define WDOG_CS_PRES_SHIFT                  (12u)              /* 256 prescaler */
+#define WDOG_CS_CMD32EN_SHIFT               (13u)              /* 32-bit refresh and unlock commands */
+#define WDOG_CS_FLG_SHIFT                   (14u)              /* Interrupt flag (write 1 to clear) */
+#define WDOG_CS_WIN_SHIFT                   (15u)              /* Window mode */
+
+/*** CNT - Counter Register: command words, written in one 32-bit access with CMD32EN ***/
+#define WDOG_UNLOCK_KEY                     (0xD928C520u)      /* Unlocks CS, TOVAL and WIN for 128 bus clocks */
+#define WDOG_REFRESH_KEY                    (0xB480A602u)      /* Restarts the counter */
+
+/*** Counter width ***/
+#define WDOG_TOVAL_MAX                      (0xFFFFu)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief WDOG Register Structure.
+ *
+ * This structure represents the WDOG registers.
+ */
+typedef struct {
+			volatile unsigned int CS;           /**< Control and Status Register, Address offset: 0x0 */
+			volatile unsigned int CNT;          /**< Counter Register, Address offset: 0x4 */
+			volatile unsigned int TOVAL;        /**< Timeout Value Register, Address offset: 0x8 */
+			volatile unsigned int WIN;          /**< Window Register, Address offset: 0xC */
+} WDOG_Type;
+
+/** Peripheral WDOG base pointer */
+#define WDOG ((WDOG_Type *)WDOG_BASE_ADDRESS)
+
+#endif  /* WDOG_REG_H */
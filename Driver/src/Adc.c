@@ -0,0 +1,375 @@
+/****************************************************************************************************
+* @file    Adc.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the ADC driver.
+* @details This file configures the ADC converters, runs the calibration, selects the conversion
+*          trigger through SIM and TRGMUX, and streams the results into a circular buffer with a
+*          circular DMA channel.
+* @version 1.0.0
+* @date    2024-11-03
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Adc.h"
+#include "ClockGate.h"
+#include "Dma.h"
+#include "Sim_Registers.h"
+#include "Trgmux_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define ADC_CLOCK_DIVIDER_MAX               (3u)
+#define ADC_AVGS_32                         (3u)               /* AVGS value for 32 samples */
+#define ADC_ADCOPT_TRGMUX                   (1u)               /* TRGSEL / PRETRGSEL: TRGMUX */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Run-time state of an ADC instance.
+ */
+typedef struct
+{
+			const Adc_ConfigType *  config;             /*!< Active configuration, NULL when stopped */
+			unsigned short          readIndex;          /*!< Next result to read */
+} Adc_StateType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static ADC_Type * const Adc_Bases[ADC_INSTANCE_COUNT] = { ADC0, ADC1 };
+static const clock_names_t Adc_Clocks[ADC_INSTANCE_COUNT] = { ADC0_CLK, ADC1_CLK };
+static const unsigned char Adc_DmaSources[ADC_INSTANCE_COUNT] = { DMA_SOURCE_ADC0, DMA_SOURCE_ADC1 };
+static const unsigned char Adc_TrgmuxIndex[ADC_INSTANCE_COUNT] = { TRGMUX_ADC0_INDEX, TRGMUX_ADC1_INDEX };
+
+static Adc_StateType Adc_State[ADC_INSTANCE_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Builds the SC3 value, hardware averaging and continuous mode.
+ */
+static unsigned int Adc_Sc3(const Adc_ConfigType * ConfigPtr)
+{
+		unsigned int sc3 = 0u;
+
+		if (ConfigPtr->average != ADC_AVERAGE_NONE)
+		{
+			sc3 = (((unsigned int)ConfigPtr->average - 1u) << ADC_SC3_AVGS_SHIFT) |
+			      ((unsigned int)ENABLEMENT << ADC_SC3_AVGE_SHIFT);
+		}
+		if (ConfigPtr->trigger == ADC_TRIGGER_CONTINUOUS)
+		{
+			sc3 |= ((unsigned int)ENABLEMENT << ADC_SC3_ADCO_SHIFT);
+		}
+		return sc3;
+}
+
+/*!
+ * @brief Gets the buffer position the DMA writes next.
+ */
+static unsigned short Adc_WriteIndex(const Adc_ConfigType * ConfigPtr)
+{
+		unsigned short remaining = Dma_GetRemaining(ConfigPtr->dmaChannel);
+
+		/* CITER counts down from bufferLength and reloads at the end of the buffer */
+		return (unsigned short)((remaining >= ConfigPtr->bufferLength) ? 0u : ((unsigned int)ConfigPtr->bufferLength - remaining));
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes an ADC instance and its DMA channel.
+ *
+ * @param[in] ConfigPtr Pointer to the ADC configuration structure.
+ * @return ADC_OK on success, ADC_ERR_PARA or ADC_ERR_TIMEOUT on error.
+ * @note Conversions start with Adc_Start().
+ */
+Adc_ret_t Adc_Init(const Adc_ConfigType * ConfigPtr)
+{
+		ADC_Type * adc;
+		Dma_ChannelConfigType dma;
+		unsigned int adcopt;
+		unsigned int sel;
+		Adc_ret_t ret;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= ADC_INSTANCE_COUNT) ||
+		    (ConfigPtr->clkSrc == CLK_SRC_OFF) || (ConfigPtr->clockDivider > ADC_CLOCK_DIVIDER_MAX) ||
+		    (ConfigPtr->resolution > ADC_RESOLUTION_10BIT) || (ConfigPtr->average > ADC_AVERAGE_32) ||
+		    (ConfigPtr->trigger > ADC_TRIGGER_TRGMUX) || (ConfigPtr->trgmuxSource > TRGMUX_SEL_MASK) ||
+		    (ConfigPtr->input >= ADC_SC1_ADCH_DISABLED) || (ConfigPtr->dmaChannel >= DMA_CHANNEL_COUNT) ||
+		    (ConfigPtr->buffer == NULL) || (ConfigPtr->bufferLength < 2u) || (ConfigPtr->bufferLength > ADC_BUFFER_MAX))
+		{
+			return ADC_ERR_PARA;
+		}
+
+		adc = Adc_Bases[ConfigPtr->instance];
+
+		/* 1. Clocks */
+		if (Adc_State[ConfigPtr->instance].config == NULL)
+		{
+			if (ClockGate_Request(Adc_Clocks[ConfigPtr->instance], ConfigPtr->clkSrc) != CLOCKGATE_OK)
+			{
+				return ADC_ERR_PARA;
+			}
+		}
+		Adc_State[ConfigPtr->instance].config = ConfigPtr;
+		Dma_Init();
+
+		/* 2. Converter, stopped */
+		adc->SC1[0] = ADC_SC1_ADCH_DISABLED << ADC_SC1_ADCH_SHIFT;
+		adc->CFG1 = ((unsigned int)ConfigPtr->clockDivider << ADC_CFG1_ADIV_SHIFT) |
+		            ((unsigned int)ConfigPtr->resolution << ADC_CFG1_MODE_SHIFT);
+		adc->CFG2 = (unsigned int)ConfigPtr->sampleTime << ADC_CFG2_SMPLTS_SHIFT;
+
+		if (ConfigPtr->calibrate != 0u)
+		{
+			ret = Adc_Calibrate(ConfigPtr->instance);
+			if (ret != ADC_OK)
+			{
+				Adc_Deinit(ConfigPtr->instance);
+				return ret;
+			}
+		}
+
+		adc->SC2 = ((unsigned int)ENABLEMENT << ADC_SC2_DMAEN_SHIFT) |
+		           ((unsigned int)(ConfigPtr->trigger != ADC_TRIGGER_CONTINUOUS) << ADC_SC2_ADTRG_SHIFT);
+		adc->SC3 = Adc_Sc3(ConfigPtr);
+
+		/* 3. Trigger routing: PDB is the reset default */
+		sel = (ConfigPtr->trigger == ADC_TRIGGER_TRGMUX) ?
+		      ((ADC_ADCOPT_TRGMUX << SIM_ADCOPT_TRGSEL_SHIFT) | (ADC_ADCOPT_TRGMUX << SIM_ADCOPT_PRETRGSEL_SHIFT)) : 0u;
+		adcopt = SIM->ADCOPT & ~(SIM_ADCOPT_FIELDS_MASK << SIM_ADCOPT_ADC_SHIFT(ConfigPtr->instance));
+		SIM->ADCOPT = adcopt | (sel << SIM_ADCOPT_ADC_SHIFT(ConfigPtr->instance));
+		if (ConfigPtr->trigger == ADC_TRIGGER_TRGMUX)
+		{
+			/* SEL0 drives the A channel (SC1[0]) */
+			TRGMUX->TRGMUXn[Adc_TrgmuxIndex[ConfigPtr->instance]] =
+			        ((unsigned int)ConfigPtr->trgmuxSource & TRGMUX_SEL_MASK) << TRGMUX_SEL_SHIFT(0u);
+		}
+
+		/* 4. DMA: result register to the circular buffer, one 16-bit result per request */
+		dma.channel = ConfigPtr->dmaChannel;
+		dma.source = Adc_DmaSources[ConfigPtr->instance];
+		dma.periodicTrigger = 0u;
+		dma.circular = 1u;
+		dma.srcAddr = (unsigned int)&adc->R[0];
+		dma.srcOffset = 0;
+		dma.srcSize = DMA_SIZE_16BIT;
+		dma.srcLastAdjust = 0;
+		dma.destAddr = (unsigned int)ConfigPtr->buffer;
+		dma.destOffset = (short)sizeof(unsigned short);
+		dma.destSize = DMA_SIZE_16BIT;
+		dma.destLastAdjust = -(int)(ConfigPtr->bufferLength * sizeof(unsigned short));
+		dma.minorBytes = sizeof(unsigned short);
+		dma.majorCount = ConfigPtr->bufferLength;
+		if (Dma_ConfigChannel(&dma) != DMA_OK)
+		{
+			Adc_Deinit(ConfigPtr->instance);
+			return ADC_ERR_PARA;
+		}
+		Adc_State[ConfigPtr->instance].readIndex = 0u;
+
+		return ADC_OK;
+}
+
+/*!
+ * @brief Stops an ADC instance and releases its clock.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return void.
+ */
+void Adc_Deinit(unsigned char instance)
+{
+		if ((instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Adc_Stop(instance);
+		Adc_Bases[instance]->SC2 = RESET;
+		Adc_Bases[instance]->SC3 = RESET;
+		(void)ClockGate_Release(Adc_Clocks[instance]);
+		Adc_State[instance].config = NULL;
+}
+
+/*!
+ * @brief Calibrates an ADC instance.
+ *
+ * The calibration runs with software trigger and 32-sample averaging; both are restored
+ * afterwards.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return ADC_OK on success, ADC_ERR_PARA or ADC_ERR_TIMEOUT on error.
+ * @note Conversions must be stopped.
+ */
+Adc_ret_t Adc_Calibrate(unsigned char instance)
+{
+		ADC_Type * adc;
+		unsigned int sc2;
+		unsigned int sc3;
+		unsigned int loops = 0u;
+
+		/* Check parameter */
+		if ((instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return ADC_ERR_PARA;
+		}
+
+		adc = Adc_Bases[instance];
+		sc2 = adc->SC2;
+		sc3 = adc->SC3;
+
+		/* 1. Clear the previous calibration values */
+		adc->CLPS = RESET;
+		adc->CLP3 = RESET;
+		adc->CLP2 = RESET;
+		adc->CLP1 = RESET;
+		adc->CLP0 = RESET;
+		adc->CLPX = RESET;
+		adc->CLP9 = RESET;
+
+		/* 2. Software trigger, 32 samples, then start */
+		adc->SC2 = RESET;
+		adc->SC3 = (ADC_AVGS_32 << ADC_SC3_AVGS_SHIFT) | ((unsigned int)ENABLEMENT << ADC_SC3_AVGE_SHIFT);
+		adc->SC3 |= ((unsigned int)ENABLEMENT << ADC_SC3_CAL_SHIFT);
+
+		while ((((adc->SC3 >> ADC_SC3_CAL_SHIFT) & VALUE_CHECK_BIT) != 0u) && (loops < ADC_CAL_WAIT_LOOPS))
+		{
+			loops++;
+		}
+
+		/* 3. Restore; the result of the calibration conversion is discarded */
+		(void)adc->R[0];
+		adc->SC2 = sc2;
+		adc->SC3 = sc3;
+
+		return (loops < ADC_CAL_WAIT_LOOPS) ? ADC_OK : ADC_ERR_TIMEOUT;
+}
+
+/*!
+ * @brief Starts the conversions, or arms the input for hardware triggers.
+ *
+ * The buffer restarts empty.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return ADC_OK on success, ADC_ERR_PARA on parameter error.
+ */
+Adc_ret_t Adc_Start(unsigned char instance)
+{
+		const Adc_ConfigType * cfg;
+
+		/* Check parameter */
+		if ((instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return ADC_ERR_PARA;
+		}
+
+		cfg = Adc_State[instance].config;
+		Adc_State[instance].readIndex = Adc_WriteIndex(cfg);
+		Dma_StartChannel(cfg->dmaChannel);
+
+		/* Writing SC1A starts a software conversion or arms the hardware trigger */
+		Adc_Bases[instance]->SC1[0] = ((unsigned int)cfg->input & ADC_SC1_ADCH_MASK) << ADC_SC1_ADCH_SHIFT;
+
+		return ADC_OK;
+}
+
+/*!
+ * @brief Stops the conversions.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return void.
+ */
+void Adc_Stop(unsigned char instance)
+{
+		if ((instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Adc_Bases[instance]->SC1[0] = ADC_SC1_ADCH_DISABLED << ADC_SC1_ADCH_SHIFT;
+		Dma_StopChannel(Adc_State[instance].config->dmaChannel);
+}
+
+/*!
+ * @brief Gets the number of results not read yet.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @return Unread results.
+ * @note The reader must keep up: after bufferLength results the old ones are overwritten.
+ */
+unsigned short Adc_GetAvailable(unsigned char instance)
+{
+		const Adc_ConfigType * cfg;
+		unsigned int write;
+		unsigned int read;
+
+		if ((instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		cfg = Adc_State[instance].config;
+		write = Adc_WriteIndex(cfg);
+		read = Adc_State[instance].readIndex;
+
+		return (unsigned short)((write >= read) ? (write - read) : (write + cfg->bufferLength - read));
+}
+
+/*!
+ * @brief Reads results from the circular buffer.
+ *
+ * Only the read position is written here and only the DMA writes the results, so no lock
+ * is needed. Call from one context only.
+ *
+ * @param[in] instance ADC instance (0-1).
+ * @param[out] DataPtr Destination of the results.
+ * @param[in] maxCount Largest number of results to read.
+ * @return Number of results read.
+ */
+unsigned short Adc_Read(unsigned char instance, unsigned short * DataPtr, unsigned short maxCount)
+{
+		const Adc_ConfigType * cfg;
+		unsigned short count;
+		unsigned short index;
+		unsigned short read;
+
+		if ((DataPtr == NULL) || (instance >= ADC_INSTANCE_COUNT) || (Adc_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		cfg = Adc_State[instance].config;
+		count = Adc_GetAvailable(instance);
+		if (count > maxCount)
+		{
+			count = maxCount;
+		}
+
+		read = Adc_State[instance].readIndex;
+		for (index = 0u; index < count; index++)
+		{
+			DataPtr[index] = cfg->buffer[read];
+			read++;
+			if (read >= cfg->bufferLength)
+			{
+				read = 0u;
+			}
+		}
+		Adc_State[instance].readIndex = read;
+
+		return count;
+}
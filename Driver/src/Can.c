@@ -0,0 +1,606 @@
+/****************************************************************************************************
+* @file    Can.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the FlexCAN driver.
+* @details This file configures the module in freeze mode, lays out the message buffers (Rx FIFO
+*          in MB0 - MB7, receive buffers in MB8 - MB11, transmit buffers in MB12 - MB15) and
+*          moves frames between the message buffers and the callbacks in the interrupt, with the
+*          time stamp the hardware wrote into the CS word.
+* @version 1.0.0
+* @date    2024-11-14
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can.h"
+#include "ClockGate.h"
+#include "Cpu.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define CAN_BIT(SHIFT)                 ((unsigned int)ENABLEMENT << (SHIFT))
+#define CAN_CS_CODE(CS)                (((CS) >> CAN_CS_CODE_SHIFT) & CAN_CS_CODE_MASK)
+#define CAN_FIFO_FLAGS                 (CAN_BIT(CAN_IFLAG1_BUF5I_SHIFT) | CAN_BIT(CAN_IFLAG1_BUF6I_SHIFT) | \
+                                        CAN_BIT(CAN_IFLAG1_BUF7I_SHIFT))
+#define CAN_TX_FLAGS                   (((1u << CAN_TX_MB_COUNT) - 1u) << CAN_TX_MB_FIRST)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Run-time state of a FlexCAN instance.
+ */
+typedef struct
+{
+			const Can_ConfigType *      config;         /*!< Active configuration, NULL when stopped */
+			volatile unsigned int       txBusy;         /*!< Transmit message buffers in use, bit n is MBn */
+			volatile unsigned int       rxFrames;
+			volatile unsigned int       txFrames;
+			volatile unsigned int       rxOverruns;
+} Can_StateType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static CAN_Type * const Can_Bases[CAN_INSTANCE_COUNT] = { CAN0, CAN1, CAN2 };
+static const clock_names_t Can_Clocks[CAN_INSTANCE_COUNT] = { FlexCAN0_CLK, FlexCAN1_CLK, FlexCAN2_CLK };
+
+static Can_StateType Can_State[CAN_INSTANCE_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Waits until an MCR bit reads the expected value.
+ */
+static Can_ret_t Can_WaitMcr(const CAN_Type * can, unsigned int shift, unsigned int value)
+{
+		unsigned int loops = 0u;
+
+		while ((((can->MCR >> shift) & VALUE_CHECK_BIT) != value) && (loops < CAN_FREEZE_WAIT_LOOPS))
+		{
+			loops++;
+		}
+
+		return (loops < CAN_FREEZE_WAIT_LOOPS) ? CAN_OK : CAN_ERR_TIMEOUT;
+}
+
+/*!
+ * @brief Computes the CTRL1 bit timing for a bit rate.
+ *
+ * The largest number of time quanta that divides the clock exactly is used, split as
+ * SYNC 1 + PROPSEG + PSEG1 + PSEG2 with PSEG1 = PSEG2 = tq / 4, which puts the sample point near
+ * 75 %. An exact divider keeps the bit time, and so the timer, free of rounding.
+ */
+static Can_ret_t Can_CalcTiming(const Can_ConfigType * ConfigPtr, unsigned int * Ctrl1Ptr)
+{
+		unsigned int clockHz;
+		unsigned int tq;
+		unsigned int presdiv;
+		unsigned int pseg;
+		unsigned int propseg;
+		unsigned int rjw;
+
+		clockHz = Clock_GetFreq((ConfigPtr->clkSrc == CAN_CLK_SYS) ? CLOCK_FREQ_CORE : CLOCK_FREQ_SOSCDIV2);
+		if ((clockHz == 0u) || (ConfigPtr->bitrate == 0u))
+		{
+			return CAN_ERR_BITRATE;
+		}
+
+		for (tq = CAN_TQ_MAX; tq >= CAN_TQ_MIN; tq--)
+		{
+			if ((clockHz % (ConfigPtr->bitrate * tq)) != 0u)
+			{
+				continue;
+			}
+			presdiv = clockHz / (ConfigPtr->bitrate * tq);
+			if ((presdiv == 0u) || (presdiv > (CAN_CTRL1_PRESDIV_MAX + 1u)))
+			{
+				continue;
+			}
+			pseg = tq / 4u;
+			propseg = tq - 1u - (2u * pseg);
+			rjw = (pseg < 4u) ? pseg : 4u;
+			*Ctrl1Ptr = ((presdiv - 1u) << CAN_CTRL1_PRESDIV_SHIFT) | ((rjw - 1u) << CAN_CTRL1_RJW_SHIFT) |
+			            ((pseg - 1u) << CAN_CTRL1_PSEG1_SHIFT) | ((pseg - 1u) << CAN_CTRL1_PSEG2_SHIFT) |
+			            ((propseg - 1u) << CAN_CTRL1_PROPSEG_SHIFT);
+			return CAN_OK;
+		}
+
+		return CAN_ERR_BITRATE;
+}
+
+/*!
+ * @brief Converts an identifier to the ID word of a message buffer.
+ */
+static unsigned int Can_IdWord(unsigned int id, unsigned char extended)
+{
+		return (extended != 0u) ? (id & CAN_ID_EXT_MASK) : ((id & CAN_ID_STD_MASK) << CAN_ID_STD_SHIFT);
+}
+
+/*!
+ * @brief Converts an identifier to a format A Rx FIFO filter element.
+ */
+static unsigned int Can_FifoWord(unsigned int id, unsigned char extended)
+{
+		return (extended != 0u) ? (((id & CAN_ID_EXT_MASK) << CAN_FIFO_EXT_SHIFT) | CAN_BIT(CAN_FIFO_IDE_SHIFT)) :
+		                          ((id & CAN_ID_STD_MASK) << CAN_FIFO_STD_SHIFT);
+}
+
+/*!
+ * @brief Writes the filters, in freeze mode.
+ *
+ * With IRMQ set every receive message buffer and every Rx FIFO filter element has its own mask.
+ * Unused filter elements repeat the first one; without filters every frame is accepted, with
+ * two receive message buffers since these always compare the identifier format.
+ */
+static void Can_SetFilters(CAN_Type * can, const Can_ConfigType * ConfigPtr)
+{
+		static const Can_FilterType acceptStd = { 0u, 0u, 0u };
+		static const Can_FilterType acceptExt = { 0u, 0u, 1u };
+		const Can_FilterType * filter;
+		unsigned int index;
+		unsigned int mb;
+
+		if (ConfigPtr->rxFifo != 0u)
+		{
+			for (index = 0u; index < CAN_FIFO_FILTERS; index++)
+			{
+				filter = (index < ConfigPtr->filterCount) ? &ConfigPtr->filters[index] :
+				         ((ConfigPtr->filterCount != 0u) ? &ConfigPtr->filters[0] : &acceptStd);
+				can->RAMn[(CAN_FIFO_TABLE_MB * CAN_MB_WORDS) + index] = Can_FifoWord(filter->id, filter->extended);
+				/* Remote frames never match; the format only when a filter is given */
+				can->RXIMR[index] = Can_FifoWord(filter->mask, filter->extended) | CAN_BIT(CAN_FIFO_RTR_SHIFT) |
+				                    ((ConfigPtr->filterCount != 0u) ? CAN_BIT(CAN_FIFO_IDE_SHIFT) : 0u);
+			}
+			return;
+		}
+
+		for (index = 0u; index < CAN_RX_MB_COUNT; index++)
+		{
+			mb = CAN_RX_MB_FIRST + index;
+			if (index < ConfigPtr->filterCount)
+			{
+				filter = &ConfigPtr->filters[index];
+			}
+			else if ((ConfigPtr->filterCount == 0u) && (index < 2u))
+			{
+				filter = (index == 0u) ? &acceptStd : &acceptExt;
+			}
+			else
+			{
+				continue;
+			}
+			CAN_MB_ID(can, mb) = Can_IdWord(filter->id, filter->extended);
+			can->RXIMR[mb] = Can_IdWord(filter->mask, filter->extended);
+			CAN_MB_CS(can, mb) = (CAN_CODE_RX_EMPTY << CAN_CS_CODE_SHIFT) |
+			                     ((unsigned int)(filter->extended != 0u) << CAN_CS_IDE_SHIFT);
+			can->IMASK1 |= (1u << mb);
+		}
+}
+
+/*!
+ * @brief Copies a received message buffer and passes it to the callback.
+ *
+ * Reading the CS word locks the message buffer against new frames until the timer is read.
+ */
+static void Can_Receive(unsigned char instance, unsigned int mb)
+{
+		Can_StateType * state = &Can_State[instance];
+		CAN_Type * can = Can_Bases[instance];
+		Can_FrameType frame;
+		unsigned int cs;
+		unsigned int word;
+		unsigned int index;
+
+		cs = CAN_MB_CS(can, mb);
+		frame.extended = (unsigned char)((cs >> CAN_CS_IDE_SHIFT) & VALUE_CHECK_BIT);
+		word = CAN_MB_ID(can, mb);
+		frame.id = (frame.extended != 0u) ? (word & CAN_ID_EXT_MASK) : ((word >> CAN_ID_STD_SHIFT) & CAN_ID_STD_MASK);
+		frame.length = (unsigned char)((cs >> CAN_CS_DLC_SHIFT) & CAN_CS_DLC_MASK);
+		if (frame.length > 8u)
+		{
+			frame.length = 8u;
+		}
+		frame.timestamp = (unsigned short)(cs & CAN_CS_TIMESTAMP_MASK);
+		for (index = 0u; index < 8u; index++)
+		{
+			word = CAN_MB_DATA(can, mb, index >> 2u);
+			frame.data[index] = (unsigned char)(word >> (24u - ((index & 3u) * 8u)));
+		}
+		if (CAN_CS_CODE(cs) == CAN_CODE_RX_OVERRUN)
+		{
+			state->rxOverruns++;
+		}
+		(void)can->TIMER;
+
+		if (((cs >> CAN_CS_RTR_SHIFT) & VALUE_CHECK_BIT) != 0u)
+		{
+			return;
+		}
+		state->rxFrames++;
+		if (state->config->rxCallback != NULL)
+		{
+			state->config->rxCallback(instance, &frame);
+		}
+}
+
+/*!
+ * @brief Common message buffer interrupt handler.
+ */
+static void Can_IrqCommon(unsigned char instance)
+{
+		Can_StateType * state = &Can_State[instance];
+		CAN_Type * can = Can_Bases[instance];
+		unsigned int flags;
+		unsigned int mb;
+		unsigned int cs;
+		unsigned int id;
+
+		if (state->config == NULL)
+		{
+			return;
+		}
+
+		flags = can->IFLAG1 & can->IMASK1;
+
+		/* 1. Rx FIFO: the output is read through MB0, RXFIR completes the read */
+		if (state->config->rxFifo != 0u)
+		{
+			if (((flags >> CAN_IFLAG1_BUF7I_SHIFT) & VALUE_CHECK_BIT) != 0u)
+			{
+				can->IFLAG1 = CAN_BIT(CAN_IFLAG1_BUF7I_SHIFT);
+				state->rxOverruns++;
+			}
+			while (((can->IFLAG1 >> CAN_IFLAG1_BUF5I_SHIFT) & VALUE_CHECK_BIT) != 0u)
+			{
+				Can_Receive(instance, 0u);
+				(void)can->RXFIR;
+				can->IFLAG1 = CAN_BIT(CAN_IFLAG1_BUF5I_SHIFT);
+			}
+			flags &= ~CAN_FIFO_FLAGS;
+		}
+
+		/* 2. Receive and transmit message buffers */
+		for (mb = CAN_RX_MB_FIRST; (mb <= CAN_MB_LAST) && (flags != 0u); mb++)
+		{
+			if (((flags >> mb) & VALUE_CHECK_BIT) == 0u)
+			{
+				continue;
+			}
+			flags &= ~(1u << mb);
+
+			if (mb < CAN_TX_MB_FIRST)
+			{
+				Can_Receive(instance, mb);
+				can->IFLAG1 = (1u << mb);
+				continue;
+			}
+
+			cs = CAN_MB_CS(can, mb);
+			id = CAN_MB_ID(can, mb);
+			id = (((cs >> CAN_CS_IDE_SHIFT) & VALUE_CHECK_BIT) != 0u) ? (id & CAN_ID_EXT_MASK) :
+			     ((id >> CAN_ID_STD_SHIFT) & CAN_ID_STD_MASK);
+			can->IFLAG1 = (1u << mb);
+			state->txBusy &= ~(1u << mb);
+			state->txFrames++;
+			if (state->config->txCallback != NULL)
+			{
+				state->config->txCallback(instance, id, (unsigned short)(cs & CAN_CS_TIMESTAMP_MASK));
+			}
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes a FlexCAN instance.
+ *
+ * The module is reset in freeze mode, the bit timing is derived from the protocol engine clock
+ * with 8 to 16 time quanta per bit and the sample point at 75 %, the filters are written, and the
+ * module joins the bus.
+ *
+ * @param[in] ConfigPtr Pointer to the CAN configuration structure.
+ * @return CAN_OK on success, CAN_ERR_PARA, CAN_ERR_BITRATE or CAN_ERR_TIMEOUT on error.
+ * @note Enable CANn_ORed_0_15_MB_IRQn in the NVIC.
+ */
+Can_ret_t Can_Init(const Can_ConfigType * ConfigPtr)
+{
+		Can_StateType * state;
+		CAN_Type * can;
+		unsigned int ctrl1;
+		unsigned int mcr;
+		unsigned int index;
+		Can_ret_t ret;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= CAN_INSTANCE_COUNT) ||
+		    (ConfigPtr->clkSrc > CAN_CLK_SYS) ||
+		    (ConfigPtr->filterCount > ((ConfigPtr->rxFifo != 0u) ? CAN_FIFO_FILTERS : CAN_RX_MB_COUNT)) ||
+		    ((ConfigPtr->filterCount != 0u) && (ConfigPtr->filters == NULL)))
+		{
+			return CAN_ERR_PARA;
+		}
+
+		ret = Can_CalcTiming(ConfigPtr, &ctrl1);
+		if (ret != CAN_OK)
+		{
+			return ret;
+		}
+
+		state = &Can_State[ConfigPtr->instance];
+		can = Can_Bases[ConfigPtr->instance];
+
+		/* 1. Clock */
+		if (state->config == NULL)
+		{
+			if (ClockGate_Request(Can_Clocks[ConfigPtr->instance], CLK_SRC_OFF) != CLOCKGATE_OK)
+			{
+				return CAN_ERR_PARA;
+			}
+		}
+		state->config = ConfigPtr;
+		state->txBusy = 0u;
+		state->rxFrames = 0u;
+		state->txFrames = 0u;
+		state->rxOverruns = 0u;
+
+		/* 2. The engine clock is selected while the module is disabled */
+		can->MCR |= CAN_BIT(CAN_MCR_MDIS_SHIFT);
+		ret = Can_WaitMcr(can, CAN_MCR_LPMACK_SHIFT, 1u);
+		if (ret == CAN_OK)
+		{
+			can->CTRL1 = (unsigned int)ConfigPtr->clkSrc << CAN_CTRL1_CLKSRC_SHIFT;
+			can->MCR &= ~CAN_BIT(CAN_MCR_MDIS_SHIFT);
+			ret = Can_WaitMcr(can, CAN_MCR_LPMACK_SHIFT, 0u);
+		}
+
+		/* 3. Soft reset, which keeps CTRL1, then freeze mode */
+		if (ret == CAN_OK)
+		{
+			can->MCR |= CAN_BIT(CAN_MCR_SOFTRST_SHIFT);
+			ret = Can_WaitMcr(can, CAN_MCR_SOFTRST_SHIFT, 0u);
+		}
+		if (ret == CAN_OK)
+		{
+			can->MCR |= CAN_BIT(CAN_MCR_FRZ_SHIFT) | CAN_BIT(CAN_MCR_HALT_SHIFT);
+			ret = Can_WaitMcr(can, CAN_MCR_FRZACK_SHIFT, 1u);
+		}
+		if (ret != CAN_OK)
+		{
+			Can_Deinit(ConfigPtr->instance);
+			return ret;
+		}
+
+		/* 4. Message buffers inactive, masks and interrupts cleared */
+		for (index = 0u; index < CAN_RAM_WORDS; index++)
+		{
+			can->RAMn[index] = RESET;
+		}
+		for (index = 0u; index < (sizeof(can->RXIMR) / sizeof(can->RXIMR[0])); index++)
+		{
+			can->RXIMR[index] = RESET;
+		}
+		can->IMASK1 = RESET;
+		can->IFLAG1 = 0xFFFFFFFFu;
+
+		/* 5. Bit timing, mode and message buffer layout */
+		can->CTRL1 = ctrl1 | ((unsigned int)ConfigPtr->clkSrc << CAN_CTRL1_CLKSRC_SHIFT) |
+		             ((unsigned int)(ConfigPtr->loopback != 0u) << CAN_CTRL1_LPB_SHIFT);
+		can->CTRL2 = RESET;
+		mcr = CAN_BIT(CAN_MCR_FRZ_SHIFT) | CAN_BIT(CAN_MCR_HALT_SHIFT) | CAN_BIT(CAN_MCR_IRMQ_SHIFT) |
+		      CAN_BIT(CAN_MCR_AEN_SHIFT) | (CAN_MB_LAST << CAN_MCR_MAXMB_SHIFT);
+		if (ConfigPtr->loopback == 0u)
+		{
+			mcr |= CAN_BIT(CAN_MCR_SRXDIS_SHIFT);
+		}
+		if (ConfigPtr->rxFifo != 0u)
+		{
+			mcr |= CAN_BIT(CAN_MCR_RFEN_SHIFT);
+		}
+		can->MCR = mcr;
+
+		/* 6. Filters, transmit buffers and interrupts */
+		Can_SetFilters(can, ConfigPtr);
+		for (index = CAN_TX_MB_FIRST; index <= CAN_MB_LAST; index++)
+		{
+			CAN_MB_CS(can, index) = CAN_CODE_TX_INACTIVE << CAN_CS_CODE_SHIFT;
+		}
+		can->IMASK1 |= CAN_TX_FLAGS;
+		if (ConfigPtr->rxFifo != 0u)
+		{
+			can->IMASK1 |= CAN_BIT(CAN_IFLAG1_BUF5I_SHIFT) | CAN_BIT(CAN_IFLAG1_BUF7I_SHIFT);
+		}
+
+		/* 7. Leave freeze mode and join the bus */
+		can->MCR &= ~(CAN_BIT(CAN_MCR_FRZ_SHIFT) | CAN_BIT(CAN_MCR_HALT_SHIFT));
+		ret = Can_WaitMcr(can, CAN_MCR_FRZACK_SHIFT, 0u);
+		if (ret == CAN_OK)
+		{
+			ret = Can_WaitMcr(can, CAN_MCR_NOTRDY_SHIFT, 0u);
+		}
+		if (ret != CAN_OK)
+		{
+			Can_Deinit(ConfigPtr->instance);
+		}
+
+		return ret;
+}
+
+/*!
+ * @brief Disables a FlexCAN instance and releases its clock.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return void.
+ */
+void Can_Deinit(unsigned char instance)
+{
+		CAN_Type * can;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (Can_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		can = Can_Bases[instance];
+		can->IMASK1 = RESET;
+		can->MCR |= CAN_BIT(CAN_MCR_MDIS_SHIFT);
+		(void)Can_WaitMcr(can, CAN_MCR_LPMACK_SHIFT, 1u);
+		(void)ClockGate_Release(Can_Clocks[instance]);
+		Can_State[instance].config = NULL;
+}
+
+/*!
+ * @brief Queues a frame for transmission.
+ *
+ * The frame goes into a free transmit message buffer; buffers are sent in identifier priority.
+ * The buffer is claimed in a critical section, so callbacks may send as well.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] FramePtr Frame; the timestamp is ignored.
+ * @return CAN_OK on success, CAN_ERR_PARA or CAN_ERR_BUSY on error.
+ * @note May be called from a receive or transmit callback.
+ */
+Can_ret_t Can_Send(unsigned char instance, const Can_FrameType * FramePtr)
+{
+		Can_StateType * state;
+		CAN_Type * can;
+		unsigned int primask;
+		unsigned int mb;
+		unsigned int index;
+		unsigned int word;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (FramePtr == NULL) || (FramePtr->length > 8u) ||
+		    (Can_State[instance].config == NULL))
+		{
+			return CAN_ERR_PARA;
+		}
+
+		state = &Can_State[instance];
+		can = Can_Bases[instance];
+
+		primask = Cpu_EnterCritical();
+		for (mb = CAN_TX_MB_FIRST; mb <= CAN_MB_LAST; mb++)
+		{
+			if (((state->txBusy >> mb) & VALUE_CHECK_BIT) == 0u)
+			{
+				state->txBusy |= (1u << mb);
+				break;
+			}
+		}
+		Cpu_ExitCritical(primask);
+		if (mb > CAN_MB_LAST)
+		{
+			return CAN_ERR_BUSY;
+		}
+
+		CAN_MB_CS(can, mb) = CAN_CODE_TX_INACTIVE << CAN_CS_CODE_SHIFT;
+		CAN_MB_ID(can, mb) = Can_IdWord(FramePtr->id, FramePtr->extended);
+		for (index = 0u; index < 2u; index++)
+		{
+			word = ((unsigned int)FramePtr->data[(index * 4u) + 0u] << 24u) |
+			       ((unsigned int)FramePtr->data[(index * 4u) + 1u] << 16u) |
+			       ((unsigned int)FramePtr->data[(index * 4u) + 2u] << 8u) |
+			       (unsigned int)FramePtr->data[(index * 4u) + 3u];
+			CAN_MB_DATA(can, mb, index) = word;
+		}
+		CAN_MB_CS(can, mb) = (CAN_CODE_TX_DATA << CAN_CS_CODE_SHIFT) |
+		                     ((unsigned int)FramePtr->length << CAN_CS_DLC_SHIFT) |
+		                     ((FramePtr->extended != 0u) ? (CAN_BIT(CAN_CS_IDE_SHIFT) | CAN_BIT(CAN_CS_SRR_SHIFT)) : 0u);
+
+		return CAN_OK;
+}
+
+/*!
+ * @brief Reads the free-running timer.
+ *
+ * Comparing it with a frame timestamp tells how many bit times ago the frame was on the bus.
+ * Reading the timer also unlocks a receive message buffer, so it is not read between the CS
+ * word and the data of a frame.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return Timer value, counting bit times modulo 2^16.
+ */
+unsigned short Can_GetTimer(unsigned char instance)
+{
+		if (instance >= CAN_INSTANCE_COUNT)
+		{
+			return 0u;
+		}
+
+		return (unsigned short)Can_Bases[instance]->TIMER;
+}
+
+/*!
+ * @brief Retrieves the statistics of a FlexCAN instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return CAN_OK on success, CAN_ERR_PARA on parameter error.
+ */
+Can_ret_t Can_GetStats(unsigned char instance, Can_StatsType * StatsPtr)
+{
+		Can_StateType * state;
+
+		if ((StatsPtr == NULL) || (instance >= CAN_INSTANCE_COUNT))
+		{
+			return CAN_ERR_PARA;
+		}
+
+		state = &Can_State[instance];
+		StatsPtr->rxFrames = state->rxFrames;
+		StatsPtr->txFrames = state->txFrames;
+		StatsPtr->rxOverruns = state->rxOverruns;
+
+		return CAN_OK;
+}
+
+/*!
+ * @brief CAN0 message buffer 0 - 15 interrupt handler.
+ *
+ * @return void.
+ */
+void CAN0_ORed_0_15_MB_IRQHandler(void)
+{
+		STACK_ISR_ENTER(CAN0_ORed_0_15_MB_IRQn);
+		TRACE_ISR_ENTER(CAN0_ORed_0_15_MB_IRQn);
+		Can_IrqCommon(0u);
+		TRACE_ISR_EXIT(CAN0_ORed_0_15_MB_IRQn);
+}
+
+/*!
+ * @brief CAN1 message buffer 0 - 15 interrupt handler.
+ *
+ * @return void.
+ */
+void CAN1_ORed_0_15_MB_IRQHandler(void)
+{
+		STACK_ISR_ENTER(CAN1_ORed_0_15_MB_IRQn);
+		TRACE_ISR_ENTER(CAN1_ORed_0_15_MB_IRQn);
+		Can_IrqCommon(1u);
+		TRACE_ISR_EXIT(CAN1_ORed_0_15_MB_IRQn);
+}
+
+/*!
+ * @brief CAN2 message buffer 0 - 15 interrupt handler.
+ *
+ * @return void.
+ */
+void CAN2_ORed_0_15_MB_IRQHandler(void)
+{
+		STACK_ISR_ENTER(CAN2_ORed_0_15_MB_IRQn);
+		TRACE_ISR_ENTER(CAN2_ORed_0_15_MB_IRQn);
+		Can_IrqCommon(2u);
+		TRACE_ISR_EXIT(CAN2_ORed_0_15_MB_IRQn);
+}
@@ -0,0 +1,545 @@
+/****************************************************************************************************
+* @file    Can_Host.c
+* @author  Ma Hien Nhan
+* @brief   Simulated CAN bus implementing the FlexCAN driver interface on a PC.
+* @details This file connects the instances CAN0 - CAN2 to one in-process bus, so services built
+*          on Can.h can be tested on the host. Every node has its own oscillator error; its
+*          free-running timer counts bit times of its own clock and is resynchronized to the bus
+*          at every start of frame, with up to one time quantum of error, as the protocol engine
+*          does. Frames are arbitrated by identifier, take their real length in bits, and the
+*          callbacks run after a pseudo-random interrupt latency. Reading the timer costs bus
+*          time, so polling it for an edge terminates. Build with CAN_HOST defined, instead of
+*          Can.c; without it this file is empty, so a firmware build that takes every source
+*          compiles only the FlexCAN driver. E.g.
+*              gcc -DCAN_HOST -IDriver/inc -IUtilitie -IMiddleware/inc test.c Driver/src/Can_Host.c
+* @version 1.0.0
+* @date    2024-11-14
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#if defined(CAN_HOST)
+#include "Can.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define CAN_HOST_EVENTS                (64u)              /* Callbacks waiting for their latency */
+#define CAN_HOST_READ_NS               (50u)              /* Bus time spent by a timer read */
+#define CAN_HOST_TQ                    (16u)              /* Time quanta per bit, resync error */
+#define CAN_HOST_STD_BITS              (47u)              /* Standard frame without data, interframe included */
+#define CAN_HOST_EXT_BITS              (67u)              /* Extended frame without data, interframe included */
+#define CAN_HOST_NS_PER_SECOND         (1000000000ll)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Simulated node.
+ */
+typedef struct
+{
+			const Can_ConfigType *      config;         /*!< Active configuration, NULL when stopped */
+			int                         ppb;            /*!< Oscillator error */
+			uint64                      offsetNs;       /*!< Node clock at bus time 0 */
+			uint64                      bitNs;          /*!< Bit time of the node clock */
+			uint64                      edgeNs;         /*!< Node clock at the last timer resynchronization */
+			unsigned int                count;          /*!< Timer at edgeNs */
+			unsigned char               txUsed[CAN_TX_MB_COUNT];
+			Can_FrameType               tx[CAN_TX_MB_COUNT];
+			unsigned int                rxFrames;
+			unsigned int                txFrames;
+			unsigned int                rxOverruns;
+} Can_HostNodeType;
+
+/**
+ * @brief   Callback waiting for its interrupt latency.
+ */
+typedef struct
+{
+			uint64                      time;           /*!< Bus time the interrupt is taken */
+			unsigned char               used;
+			unsigned char               instance;
+			unsigned char               transmit;       /*!< Transmit complete instead of receive */
+			unsigned char               slot;           /*!< Transmit buffer freed at the end of the frame */
+			Can_FrameType               frame;
+} Can_HostEventType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Can_HostNodeType Can_HostNodes[CAN_INSTANCE_COUNT];
+static Can_HostEventType Can_HostEvents[CAN_HOST_EVENTS];
+
+static uint64 Can_HostTime;                  /* Bus time */
+static uint64 Can_HostBusyUntil;             /* End of the frame on the bus */
+static unsigned int Can_HostLatencyNs;
+static unsigned int Can_HostRandom = 0x2545F491u;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Pseudo-random number, xorshift32.
+ */
+static unsigned int Can_HostRand(void)
+{
+		Can_HostRandom ^= Can_HostRandom << 13u;
+		Can_HostRandom ^= Can_HostRandom >> 17u;
+		Can_HostRandom ^= Can_HostRandom << 5u;
+		return Can_HostRandom;
+}
+
+/*!
+ * @brief Clock of a node at a bus time.
+ */
+static uint64 Can_HostClock(const Can_HostNodeType * node, uint64 time)
+{
+		return node->offsetNs + time + (uint64)(((int64)time * node->ppb) / CAN_HOST_NS_PER_SECOND);
+}
+
+/*!
+ * @brief Free-running timer of a node at a node clock value.
+ */
+static unsigned int Can_HostTimer(const Can_HostNodeType * node, uint64 clockNs)
+{
+		/* A receiver resynchronizes up to one time quantum after the bus edge */
+		if (clockNs < node->edgeNs)
+		{
+			return (node->count - 1u) & CAN_TIMER_MASK;
+		}
+		return (node->count + (unsigned int)((clockNs - node->edgeNs) / node->bitNs)) & CAN_TIMER_MASK;
+}
+
+/*!
+ * @brief Tells whether a node accepts a frame.
+ */
+static unsigned char Can_HostAccepts(const Can_ConfigType * ConfigPtr, const Can_FrameType * FramePtr)
+{
+		const Can_FilterType * filter;
+		unsigned char index;
+
+		if (ConfigPtr->filterCount == 0u)
+		{
+			return 1u;
+		}
+		for (index = 0u; index < ConfigPtr->filterCount; index++)
+		{
+			filter = &ConfigPtr->filters[index];
+			if (((filter->extended != 0u) == (FramePtr->extended != 0u)) &&
+			    ((FramePtr->id & filter->mask) == (filter->id & filter->mask)))
+			{
+				return 1u;
+			}
+		}
+		return 0u;
+}
+
+/*!
+ * @brief Queues a callback after the interrupt latency.
+ */
+static void Can_HostPost(unsigned char instance, unsigned char transmit, unsigned char slot,
+                         uint64 endTime, const Can_FrameType * FramePtr)
+{
+		unsigned int index;
+
+		for (index = 0u; index < CAN_HOST_EVENTS; index++)
+		{
+			if (Can_HostEvents[index].used == 0u)
+			{
+				Can_HostEvents[index].used = 1u;
+				Can_HostEvents[index].time = endTime + ((Can_HostLatencyNs != 0u) ? (Can_HostRand() % Can_HostLatencyNs) : 0u);
+				Can_HostEvents[index].instance = instance;
+				Can_HostEvents[index].transmit = transmit;
+				Can_HostEvents[index].slot = slot;
+				Can_HostEvents[index].frame = *FramePtr;
+				return;
+			}
+		}
+		Can_HostNodes[instance].rxOverruns++;
+}
+
+/*!
+ * @brief Starts the highest priority pending frame, when there is one.
+ *
+ * Every node resynchronizes its timer at the start of frame and captures it as the time stamp,
+ * so all time stamps of a frame refer to the same instant on the bus.
+ */
+static void Can_HostArbitrate(void)
+{
+		Can_HostNodeType * node;
+		Can_FrameType frame;
+		uint64 key;
+		uint64 bestKey = 0xFFFFFFFFFFFFFFFFull;
+		uint64 clockNs;
+		uint64 endTime;
+		uint64 wait;
+		unsigned char best = 0xFFu;
+		unsigned char bestSlot = 0u;
+		unsigned char instance;
+		unsigned char slot;
+
+		for (instance = 0u; instance < CAN_INSTANCE_COUNT; instance++)
+		{
+			for (slot = 0u; slot < CAN_TX_MB_COUNT; slot++)
+			{
+				if (Can_HostNodes[instance].txUsed[slot] != 1u)
+				{
+					continue;
+				}
+				frame = Can_HostNodes[instance].tx[slot];
+				/* Base identifier first, then standard before extended */
+				key = (frame.extended != 0u) ? (((uint64)frame.id << 1u) | 1u) :
+				      ((uint64)frame.id << 19u);
+				if (key < bestKey)
+				{
+					bestKey = key;
+					best = instance;
+					bestSlot = slot;
+				}
+			}
+		}
+		if (best == 0xFFu)
+		{
+			return;
+		}
+
+		/* The start of frame is sent on a bit boundary of the transmitter */
+		node = &Can_HostNodes[best];
+		clockNs = Can_HostClock(node, Can_HostTime);
+		if (clockNs >= node->edgeNs)
+		{
+			wait = (clockNs - node->edgeNs) % node->bitNs;
+			if (wait != 0u)
+			{
+				Can_HostBusyUntil = Can_HostTime + (node->bitNs - wait);
+				return;
+			}
+		}
+		frame = node->tx[bestSlot];
+		node->txUsed[bestSlot] = 2u;
+		endTime = Can_HostTime + (((frame.extended != 0u) ? CAN_HOST_EXT_BITS : CAN_HOST_STD_BITS) +
+		                          (8u * (uint64)frame.length)) * node->bitNs;
+		Can_HostBusyUntil = endTime;
+
+		for (instance = 0u; instance < CAN_INSTANCE_COUNT; instance++)
+		{
+			node = &Can_HostNodes[instance];
+			if (node->config == NULL)
+			{
+				continue;
+			}
+			clockNs = Can_HostClock(node, Can_HostTime);
+			if (instance != best)
+			{
+				clockNs += Can_HostRand() % (node->bitNs / CAN_HOST_TQ);
+			}
+			/* Hard synchronization: the bit in progress restarts, the count snaps to the nearest edge */
+			node->count = Can_HostTimer(node, clockNs + (node->bitNs / 2u));
+			node->edgeNs = clockNs;
+			frame.timestamp = (unsigned short)node->count;
+
+			if (instance == best)
+			{
+				Can_HostPost(instance, 1u, bestSlot, endTime, &frame);
+				if (node->config->loopback != 0u)
+				{
+					Can_HostPost(instance, 0u, 0u, endTime, &frame);
+				}
+			}
+			else if ((node->config->loopback == 0u) && (Can_HostAccepts(node->config, &frame) != 0u))
+			{
+				Can_HostPost(instance, 0u, 0u, endTime, &frame);
+			}
+		}
+}
+
+/*!
+ * @brief Runs the earliest callback due at the bus time.
+ */
+static unsigned char Can_HostDispatch(void)
+{
+		Can_HostEventType event;
+		Can_HostNodeType * node;
+		unsigned int index;
+		unsigned int first = CAN_HOST_EVENTS;
+
+		for (index = 0u; index < CAN_HOST_EVENTS; index++)
+		{
+			if ((Can_HostEvents[index].used != 0u) && (Can_HostEvents[index].time <= Can_HostTime) &&
+			    ((first == CAN_HOST_EVENTS) || (Can_HostEvents[index].time < Can_HostEvents[first].time)))
+			{
+				first = index;
+			}
+		}
+		if (first == CAN_HOST_EVENTS)
+		{
+			return 0u;
+		}
+
+		event = Can_HostEvents[first];
+		Can_HostEvents[first].used = 0u;
+		node = &Can_HostNodes[event.instance];
+		if (node->config == NULL)
+		{
+			return 1u;
+		}
+		if (event.transmit != 0u)
+		{
+			node->txUsed[event.slot] = 0u;
+			node->txFrames++;
+			if (node->config->txCallback != NULL)
+			{
+				node->config->txCallback(event.instance, event.frame.id, event.frame.timestamp);
+			}
+		}
+		else
+		{
+			node->rxFrames++;
+			if (node->config->rxCallback != NULL)
+			{
+				node->config->rxCallback(event.instance, &event.frame);
+			}
+		}
+		return 1u;
+}
+
+/*!
+ * @brief Bus time of the next callback, or end when none is due before it.
+ */
+static uint64 Can_HostNextEvent(uint64 end)
+{
+		unsigned int index;
+
+		for (index = 0u; index < CAN_HOST_EVENTS; index++)
+		{
+			if ((Can_HostEvents[index].used != 0u) && (Can_HostEvents[index].time < end))
+			{
+				end = Can_HostEvents[index].time;
+			}
+		}
+		return end;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Connects a FlexCAN instance to the simulated bus.
+ *
+ * @param[in] ConfigPtr Pointer to the CAN configuration structure.
+ * @return CAN_OK on success, CAN_ERR_PARA or CAN_ERR_BITRATE on error.
+ */
+Can_ret_t Can_Init(const Can_ConfigType * ConfigPtr)
+{
+		Can_HostNodeType * node;
+		unsigned char slot;
+
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= CAN_INSTANCE_COUNT) ||
+		    (ConfigPtr->clkSrc > CAN_CLK_SYS) ||
+		    (ConfigPtr->filterCount > ((ConfigPtr->rxFifo != 0u) ? CAN_FIFO_FILTERS : CAN_RX_MB_COUNT)) ||
+		    ((ConfigPtr->filterCount != 0u) && (ConfigPtr->filters == NULL)))
+		{
+			return CAN_ERR_PARA;
+		}
+		if ((ConfigPtr->bitrate == 0u) || ((CAN_HOST_NS_PER_SECOND % ConfigPtr->bitrate) != 0))
+		{
+			return CAN_ERR_BITRATE;
+		}
+
+		node = &Can_HostNodes[ConfigPtr->instance];
+		node->bitNs = (uint64)CAN_HOST_NS_PER_SECOND / ConfigPtr->bitrate;
+		node->edgeNs = Can_HostClock(node, Can_HostTime);
+		node->count = 0u;
+		for (slot = 0u; slot < CAN_TX_MB_COUNT; slot++)
+		{
+			node->txUsed[slot] = 0u;
+		}
+		node->rxFrames = 0u;
+		node->txFrames = 0u;
+		node->rxOverruns = 0u;
+		node->config = ConfigPtr;
+
+		return CAN_OK;
+}
+
+/*!
+ * @brief Disconnects a FlexCAN instance from the simulated bus.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return void.
+ */
+void Can_Deinit(unsigned char instance)
+{
+		if (instance < CAN_INSTANCE_COUNT)
+		{
+			Can_HostNodes[instance].config = NULL;
+		}
+}
+
+/*!
+ * @brief Queues a frame for transmission.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] FramePtr Frame; the timestamp is ignored.
+ * @return CAN_OK on success, CAN_ERR_PARA or CAN_ERR_BUSY on error.
+ */
+Can_ret_t Can_Send(unsigned char instance, const Can_FrameType * FramePtr)
+{
+		Can_HostNodeType * node;
+		unsigned char slot;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (FramePtr == NULL) || (FramePtr->length > 8u) ||
+		    (Can_HostNodes[instance].config == NULL))
+		{
+			return CAN_ERR_PARA;
+		}
+
+		node = &Can_HostNodes[instance];
+		for (slot = 0u; slot < CAN_TX_MB_COUNT; slot++)
+		{
+			if (node->txUsed[slot] == 0u)
+			{
+				node->tx[slot] = *FramePtr;
+				node->txUsed[slot] = 1u;
+				return CAN_OK;
+			}
+		}
+		return CAN_ERR_BUSY;
+}
+
+/*!
+ * @brief Reads the free-running timer of a simulated node.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return Timer value, counting bit times modulo 2^16.
+ */
+unsigned short Can_GetTimer(unsigned char instance)
+{
+		const Can_HostNodeType * node;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (Can_HostNodes[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		node = &Can_HostNodes[instance];
+		Can_HostTime += CAN_HOST_READ_NS;
+		return (unsigned short)Can_HostTimer(node, Can_HostClock(node, Can_HostTime));
+}
+
+/*!
+ * @brief Retrieves the statistics of a simulated node.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return CAN_OK on success, CAN_ERR_PARA on parameter error.
+ */
+Can_ret_t Can_GetStats(unsigned char instance, Can_StatsType * StatsPtr)
+{
+		if ((StatsPtr == NULL) || (instance >= CAN_INSTANCE_COUNT))
+		{
+			return CAN_ERR_PARA;
+		}
+
+		StatsPtr->rxFrames = Can_HostNodes[instance].rxFrames;
+		StatsPtr->txFrames = Can_HostNodes[instance].txFrames;
+		StatsPtr->rxOverruns = Can_HostNodes[instance].rxOverruns;
+
+		return CAN_OK;
+}
+
+/*!
+ * @brief Sets the oscillator of a simulated node.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] ppb Oscillator error in parts per billion.
+ * @param[in] offsetNs Node clock at bus time 0.
+ * @return void.
+ */
+void Can_HostSetNode(unsigned char instance, int ppb, uint64 offsetNs)
+{
+		if (instance < CAN_INSTANCE_COUNT)
+		{
+			Can_HostNodes[instance].ppb = ppb;
+			Can_HostNodes[instance].offsetNs = offsetNs;
+			Can_HostNodes[instance].edgeNs = Can_HostClock(&Can_HostNodes[instance], Can_HostTime);
+		}
+}
+
+/*!
+ * @brief Sets the simulated interrupt latency.
+ *
+ * @param[in] maxNs Largest latency.
+ * @return void.
+ */
+void Can_HostSetLatency(unsigned int maxNs)
+{
+		Can_HostLatencyNs = maxNs;
+}
+
+/*!
+ * @brief Gets the clock of a simulated node at the current bus time.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return Node clock in nanoseconds.
+ */
+uint64 Can_HostNodeNs(unsigned char instance)
+{
+		return (instance < CAN_INSTANCE_COUNT) ? Can_HostClock(&Can_HostNodes[instance], Can_HostTime) : 0u;
+}
+
+/*!
+ * @brief Gets the bus time.
+ *
+ * @return Nanoseconds since the start of the simulation.
+ */
+uint64 Can_HostNow(void)
+{
+		return Can_HostTime;
+}
+
+/*!
+ * @brief Runs the bus for a while, calling the callbacks that fall due.
+ *
+ * @param[in] ns Bus time to advance.
+ * @return void.
+ */
+void Can_HostAdvance(uint64 ns)
+{
+		uint64 end = Can_HostTime + ns;
+		uint64 next;
+
+		while (Can_HostTime < end)
+		{
+			if (Can_HostDispatch() != 0u)
+			{
+				continue;
+			}
+			if (Can_HostTime >= Can_HostBusyUntil)
+			{
+				Can_HostArbitrate();
+			}
+			next = Can_HostNextEvent(end);
+			if ((Can_HostBusyUntil > Can_HostTime) && (Can_HostBusyUntil < next))
+			{
+				next = Can_HostBusyUntil;
+			}
+			if (next > Can_HostTime)
+			{
+				Can_HostTime = next;
+			}
+		}
+		while (Can_HostDispatch() != 0u)
+		{
+		}
+}
+
+#endif  /* CAN_HOST */
@@ -0,0 +1,226 @@
+/****************************************************************************************************
+* @file    ClockGate.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the reference-counted peripheral clock gating manager.
+* @details This file keeps one reference count per PCC slot. The first request selects the
+*          functional clock source while the gate is off and then enables the gate; the last
+*          release gates the clock again.
+* @version 1.0.0
+* @date    2024-10-29
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "ClockGate.h"
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   PCC slot description.
+ */
+typedef struct
+{
+			unsigned char   present;            /*!< Slot exists on the S32K144 */
+			unsigned char   hasPcs;             /*!< Slot has a functional clock source select */
+			unsigned short  uaPerMhz;           /*!< Estimated current per MHz of bus clock */
+} ClockGate_SlotType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+/* S32K144 PCC slot table, indexed by clock_names_t. Current figures are rough estimates. */
+static const ClockGate_SlotType ClockGate_Slots[PCC_SLOT_COUNT] =
+{
+		[FTFC_CLK]     = { 1u, 0u, 10u },
+		[DMAMUX_CLK]   = { 1u, 0u,  2u },
+		[FlexCAN0_CLK] = { 1u, 0u, 20u },
+		[FlexCAN1_CLK] = { 1u, 0u, 20u },
+		[FTM3_CLK]     = { 1u, 1u, 12u },
+		[ADC1_CLK]     = { 1u, 1u, 15u },
+		[FlexCAN2_CLK] = { 1u, 0u, 20u },
+		[LPSPI0_CLK]   = { 1u, 1u,  6u },
+		[LPSPI1_CLK]   = { 1u, 1u,  6u },
+		[LPSPI2_CLK]   = { 1u, 1u,  6u },
+		[PDB1_CLK]     = { 1u, 0u,  4u },
+		[CRC_CLK]      = { 1u, 0u,  2u },
+		[PDB0_CLK]     = { 1u, 0u,  4u },
+		[LPIT0_CLK]    = { 1u, 1u,  5u },
+		[FTM0_CLK]     = { 1u, 1u, 12u },
+		[FTM1_CLK]     = { 1u, 1u, 12u },
+		[FTM2_CLK]     = { 1u, 1u, 12u },
+		[ADC0_CLK]     = { 1u, 1u, 15u },
+		[RTC_CLK]      = { 1u, 0u,  1u },
+		[LPTMR0_CLK]   = { 1u, 1u,  1u },
+		[PORTA_CLK]    = { 1u, 0u,  1u },
+		[PORTB_CLK]    = { 1u, 0u,  1u },
+		[PORTC_CLK]    = { 1u, 0u,  1u },
+		[PORTD_CLK]    = { 1u, 0u,  1u },
+		[PORTE_CLK]    = { 1u, 0u,  1u },
+		[FlexIO_CLK]   = { 1u, 1u, 10u },
+		[EWM_CLK]      = { 1u, 0u,  1u },
+		[LPI2C0_CLK]   = { 1u, 1u,  6u },
+		[LPUART0_CLK]  = { 1u, 1u,  5u },
+		[LPUART1_CLK]  = { 1u, 1u,  5u },
+		[LPUART2_CLK]  = { 1u, 1u,  5u },
+		[CMP0_CLK]     = { 1u, 0u,  3u },
+};
+
+static unsigned char ClockGate_RefCount[PCC_SLOT_COUNT];   /* Users of each slot */
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Request a peripheral clock.
+ *
+ * The first request selects the functional clock source and enables the clock gate. Later
+ * requests only increment the reference count and must ask for the same source.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @param[in] clkSrc Functional clock source, CLK_SRC_OFF for peripherals without one.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA, CLOCKGATE_ERR_SOURCE or CLOCKGATE_ERR_COUNT on error.
+ * @note Call from thread context; the reference counts are not protected against interrupts.
+ */
+ClockGate_ret_t ClockGate_Request(clock_names_t clockName, peripheral_clock_source_t clkSrc)
+{
+		unsigned int slot = (unsigned int)clockName;
+		unsigned int value;
+
+		/* Check parameter */
+		if ((slot >= PCC_SLOT_COUNT) || (ClockGate_Slots[slot].present == 0u) ||
+		    ((ClockGate_Slots[slot].hasPcs == 0u) && (clkSrc != CLK_SRC_OFF)))
+		{
+			return CLOCKGATE_ERR_PARA;
+		}
+
+		value = FIELD_VAL(PCC_PCCn_PCS, clkSrc);
+
+		/* 1. Already running: only count the new user */
+		if (ClockGate_RefCount[slot] != 0u)
+		{
+			if ((PCC->PCCn[slot] & PCC_PCS_MASK) != value)
+			{
+				return CLOCKGATE_ERR_SOURCE;
+			}
+			if (ClockGate_RefCount[slot] >= CLOCKGATE_MAX_REFS)
+			{
+				return CLOCKGATE_ERR_COUNT;
+			}
+			ClockGate_RefCount[slot]++;
+			return CLOCKGATE_OK;
+		}
+
+		/* 2. First user: PCS may only change while the gate is off, and is written with the gate */
+		PCC->PCCn[slot] = RESET;
+		PCC->PCCn[slot] = value | FIELD_VAL(PCC_PCCn_CGC, 1u);
+		ClockGate_RefCount[slot] = 1u;
+
+		return CLOCKGATE_OK;
+}
+
+/*!
+ * @brief Release a peripheral clock.
+ *
+ * The clock gate is disabled when the last user releases the clock.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA or CLOCKGATE_ERR_COUNT on error.
+ * @note The peripheral must be idle before its last user releases it.
+ */
+ClockGate_ret_t ClockGate_Release(clock_names_t clockName)
+{
+		unsigned int slot = (unsigned int)clockName;
+
+		/* Check parameter */
+		if ((slot >= PCC_SLOT_COUNT) || (ClockGate_Slots[slot].present == 0u))
+		{
+			return CLOCKGATE_ERR_PARA;
+		}
+		if (ClockGate_RefCount[slot] == 0u)
+		{
+			return CLOCKGATE_ERR_COUNT;
+		}
+
+		ClockGate_RefCount[slot]--;
+		if (ClockGate_RefCount[slot] == 0u)
+		{
+			/* Last user: gate the clock, keep the source for the next request */
+			PCC->PCCn[slot] &= ((unsigned int) ~(ENABLEMENT << PCC_CGC_SHIFT));
+		}
+
+		return CLOCKGATE_OK;
+}
+
+/*!
+ * @brief Get the reference count of a peripheral clock.
+ *
+ * @param[in] clockName PCC slot of the peripheral.
+ * @return Number of users, 0 for unknown slots.
+ */
+unsigned char ClockGate_GetRefCount(clock_names_t clockName)
+{
+		unsigned int slot = (unsigned int)clockName;
+
+		return (slot < PCC_SLOT_COUNT) ? ClockGate_RefCount[slot] : 0u;
+}
+
+/*!
+ * @brief Report the active clocks and the estimated current draw.
+ *
+ * The current is estimated from per-peripheral figures in uA/MHz at the bus clock and is meant
+ * to compare configurations, not to replace a measurement.
+ *
+ * @param[out] ReportPtr Pointer to the report structure.
+ * @return CLOCKGATE_OK on success, CLOCKGATE_ERR_PARA on parameter error.
+ */
+ClockGate_ret_t ClockGate_GetReport(ClockGate_ReportType * ReportPtr)
+{
+		unsigned int slot;
+		unsigned int word;
+		unsigned int uaPerMhz = 0u;
+
+		/* Check parameter */
+		if (ReportPtr == NULL)
+		{
+			return CLOCKGATE_ERR_PARA;
+		}
+
+		for (word = 0u; word < CLOCKGATE_SET_WORDS; word++)
+		{
+			ReportPtr->active[word] = 0u;
+			ReportPtr->leaked[word] = 0u;
+		}
+		ReportPtr->activeCount = 0u;
+		ReportPtr->leakedCount = 0u;
+
+		/* 1. Read the gates from hardware, so clocks enabled with Clock_SetPccConfig() are seen too */
+		for (slot = 0u; slot < PCC_SLOT_COUNT; slot++)
+		{
+			if ((ClockGate_Slots[slot].present == 0u) ||
+			    (((PCC->PCCn[slot] >> PCC_CGC_SHIFT) & VALUE_CHECK_BIT) == 0u))
+			{
+				continue;
+			}
+
+			ReportPtr->active[slot >> 5u] |= (1u << (slot & 31u));
+			ReportPtr->activeCount++;
+			uaPerMhz += ClockGate_Slots[slot].uaPerMhz;
+
+			if (ClockGate_RefCount[slot] == 0u)
+			{
+				ReportPtr->leaked[slot >> 5u] |= (1u << (slot & 31u));
+				ReportPtr->leakedCount++;
+			}
+		}
+
+		/* 2. Scale by the bus clock in MHz */
+		ReportPtr->currentUa = uaPerMhz * (Clock_GetFreq(CLOCK_FREQ_BUS) / 1000000u);
+
+		return CLOCKGATE_OK;
+}
@@ -0,0 +1,197 @@
+/****************************************************************************************************
+* @file    ClockMgr.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the non-blocking clock bring-up manager.
+* @details This file provides a state machine that starts the SOSC and the SPLL, switches the RUN
+*          mode system clock to the SPLL once it is locked, and selects the fallback configuration
+*          when a step does not complete within its timeout.
+* @version 1.0.0
+* @date    2024-10-24
+* @note    Timeouts use the caller supplied millisecond time, e.g. SysTick running on FIRC.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "ClockMgr.h"
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const ClockMgr_ConfigType * ClockMgr_Config;      /* Active configuration */
+static volatile ClockMgr_state_t   ClockMgr_State = CLOCKMGR_STATE_IDLE;
+static ClockMgr_fault_t            ClockMgr_Fault = CLOCKMGR_FAULT_NONE;
+static unsigned int                ClockMgr_StepStartMs;  /* Time the current step started */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Enters a final state and notifies the application.
+ */
+static void ClockMgr_Finish(ClockMgr_state_t state, ClockMgr_fault_t fault)
+{
+		ClockMgr_State = state;
+		ClockMgr_Fault = fault;
+		if (ClockMgr_Config->notify != NULL)
+		{
+			ClockMgr_Config->notify(state, fault);
+		}
+}
+
+/*!
+ * @brief Selects the fallback configuration after a failed step.
+ */
+static void ClockMgr_Fallback(ClockMgr_fault_t fault)
+{
+		/* The fallback source (FIRC) is already running, so the switch needs no wait */
+		Clock_WriteScgRunModeConfig(ClockMgr_Config->fallbackConfig);
+		ClockMgr_Finish(CLOCKMGR_STATE_RUN_FALLBACK, fault);
+}
+
+/*!
+ * @brief Starts the next step and its timeout.
+ */
+static void ClockMgr_Enter(ClockMgr_state_t state, unsigned int nowMs)
+{
+		ClockMgr_State = state;
+		ClockMgr_StepStartMs = nowMs;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Starts the clock bring-up sequence.
+ *
+ * This function enables the SOSC (or the SPLL directly when it is fed by FIRC) and returns
+ * immediately. The system keeps running on its current clock until ClockMgr_Process() switches.
+ *
+ * @param[in] ConfigPtr Pointer to the clock manager configuration structure.
+ * @param[in] nowMs Current time in milliseconds, used for the timeouts.
+ * @return CLOCKMGR_OK on success, CLOCKMGR_ERR_PARA or CLOCKMGR_ERR_BUSY on error.
+ */
+ClockMgr_ret_t ClockMgr_Start(const ClockMgr_ConfigType * ConfigPtr, unsigned int nowMs)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->spllConfig == NULL) || (ConfigPtr->targetConfig == NULL) ||
+		    (ConfigPtr->fallbackConfig == NULL))
+		{
+			return CLOCKMGR_ERR_PARA;
+		}
+		if ((ConfigPtr->spllConfig->src == CLOCKMGR_SPLL_SRC_SOSC) && (ConfigPtr->soscConfig == NULL))
+		{
+			return CLOCKMGR_ERR_PARA;
+		}
+		if ((ClockMgr_State == CLOCKMGR_STATE_SOSC_STARTUP) || (ClockMgr_State == CLOCKMGR_STATE_SPLL_LOCK) ||
+		    (ClockMgr_State == CLOCKMGR_STATE_SWITCHING))
+		{
+			return CLOCKMGR_ERR_BUSY;
+		}
+
+		ClockMgr_Config = ConfigPtr;
+		ClockMgr_Fault = CLOCKMGR_FAULT_NONE;
+
+		/* 1. Kick off the first oscillator and return */
+		if (ConfigPtr->soscConfig != NULL)
+		{
+			Clock_EnableScgSosc(ConfigPtr->soscConfig);
+			ClockMgr_Enter(CLOCKMGR_STATE_SOSC_STARTUP, nowMs);
+		}
+		else
+		{
+			Clock_EnableScgSpll(ConfigPtr->spllConfig);
+			ClockMgr_Enter(CLOCKMGR_STATE_SPLL_LOCK, nowMs);
+		}
+
+		return CLOCKMGR_OK;
+}
+
+/*!
+ * @brief Advances the clock bring-up sequence.
+ *
+ * Call this from the main loop during initialization, or from SCG_IRQHandler. Every call returns
+ * without waiting.
+ *
+ * @param[in] nowMs Current time in milliseconds.
+ * @return Current state.
+ */
+ClockMgr_state_t ClockMgr_Process(unsigned int nowMs)
+{
+		unsigned int elapsed = nowMs - ClockMgr_StepStartMs;
+
+		switch (ClockMgr_State)
+		{
+			case CLOCKMGR_STATE_SOSC_STARTUP:
+				if (Clock_IsScgSoscValid() != 0u)
+				{
+					/* SOSC is up: start the PLL on top of it */
+					Clock_EnableScgSpll(ClockMgr_Config->spllConfig);
+					ClockMgr_Enter(CLOCKMGR_STATE_SPLL_LOCK, nowMs);
+				}
+				else if (elapsed >= ClockMgr_Config->soscTimeoutMs)
+				{
+					/* Dead or missing crystal */
+					Clock_DisableScgSosc();
+					ClockMgr_Fallback(CLOCKMGR_FAULT_SOSC_TIMEOUT);
+				}
+				break;
+
+			case CLOCKMGR_STATE_SPLL_LOCK:
+				if (Clock_IsScgSpllValid() != 0u)
+				{
+					Clock_WriteScgRunModeConfig(ClockMgr_Config->targetConfig);
+					ClockMgr_Enter(CLOCKMGR_STATE_SWITCHING, nowMs);
+				}
+				else if (elapsed >= ClockMgr_Config->spllTimeoutMs)
+				{
+					Clock_DisableScgSpll();
+					ClockMgr_Fallback(CLOCKMGR_FAULT_SPLL_TIMEOUT);
+				}
+				break;
+
+			case CLOCKMGR_STATE_SWITCHING:
+				if (Clock_GetSysClockSource() == ClockMgr_Config->targetConfig->sys_clk_src)
+				{
+					ClockMgr_Finish(CLOCKMGR_STATE_RUN_TARGET, CLOCKMGR_FAULT_NONE);
+				}
+				else if (elapsed >= ClockMgr_Config->switchTimeoutMs)
+				{
+					ClockMgr_Fallback(CLOCKMGR_FAULT_SWITCH_TIMEOUT);
+				}
+				break;
+
+			case CLOCKMGR_STATE_IDLE:
+			case CLOCKMGR_STATE_RUN_TARGET:
+			case CLOCKMGR_STATE_RUN_FALLBACK:
+			default:
+				/* Nothing to do */
+				break;
+		}
+
+		return ClockMgr_State;
+}
+
+/*!
+ * @brief Retrieves the current state.
+ *
+ * @return Current state.
+ */
+ClockMgr_state_t ClockMgr_GetState(void)
+{
+		return ClockMgr_State;
+}
+
+/*!
+ * @brief Retrieves the fault that caused the fallback.
+ *
+ * @return Fault, CLOCKMGR_FAULT_NONE when none occurred.
+ */
+ClockMgr_fault_t ClockMgr_GetFault(void)
+{
+		return ClockMgr_Fault;
+}
@@ -0,0 +1,34 @@
+/****************************************************************************************************
+* @file    Clock_Cfg.c
+* @author  Ma Hien Nhan
+* @brief   Clock configuration image.
+* @details This file holds the SCG register image built from the CLOCK_CFG_* macros of Clock_Cfg.h.
+*          The image is constant, so it is placed in flash and every field is folded at compile time.
+* @version 1.0.0
+* @date    2024-10-28
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Clock_Cfg.h"
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+const Clock_ConfigImageType Clock_CfgImage =
+{
+		CLOCK_CFG_SOSCDIV_IMAGE,               /* soscDiv */
+		CLOCK_CFG_SOSCCFG_IMAGE,               /* soscCfg */
+		CLOCK_CFG_SIRCDIV_IMAGE,               /* sircDiv */
+		CLOCK_CFG_FIRCDIV_IMAGE,               /* fircDiv */
+		CLOCK_CFG_SPLLDIV_IMAGE,               /* spllDiv */
+		CLOCK_CFG_SPLLCFG_IMAGE,               /* spllCfg */
+		CLOCK_CFG_RCCR_IMAGE,                  /* rccr */
+		CLOCK_CFG_HCCR_IMAGE,                  /* hccr */
+		CLOCK_CFG_VCCR_IMAGE,                  /* vccr */
+		(unsigned char)CLOCK_CFG_SOSC_ENABLE,  /* soscEnable */
+		(unsigned char)CLOCK_CFG_SPLL_ENABLE,  /* spllEnable */
+};
@@ -0,0 +1,229 @@
+/****************************************************************************************************
+* @file    Dma.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the eDMA driver.
+* @details This file provides functions to route peripheral requests through the DMAMUX and to
+*          program the transfer control descriptor of each eDMA channel.
+* @version 1.0.0
+* @date    2024-11-03
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Dma.h"
+#include "ClockGate.h"
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char Dma_Initialized;                   /* DMAMUX clock requested */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Checks whether a channel is idle, its request disabled and no transfer running.
+ */
+static unsigned char Dma_IsIdle(unsigned char channel)
+{
+		return ((((DMA->ERQ >> channel) & VALUE_CHECK_BIT) == 0u) &&
+		        (((DMA->TCD[channel].CSR >> DMA_TCD_CSR_ACTIVE_SHIFT) & VALUE_CHECK_BIT) == 0u)) ? 1u : 0u;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the eDMA controller and the DMAMUX.
+ *
+ * Later calls only return; every driver using DMA calls this first.
+ *
+ * @return void.
+ * @note The eDMA clock itself is enabled out of reset (SIM_PLATCGC).
+ */
+void Dma_Init(void)
+{
+		if (Dma_Initialized != 0u)
+		{
+			return;
+		}
+
+		(void)ClockGate_Request(DMAMUX_CLK, CLK_SRC_OFF);
+
+		/* Fixed priority arbitration, stall while halted by the debugger */
+		DMA->CR = ((unsigned int)ENABLEMENT << DMA_CR_EDBG_SHIFT);
+		DMA->ERQ = RESET;
+		DMA->CERR = (unsigned char)(ENABLEMENT << DMA_CERR_CAER_SHIFT);
+		DMA->CINT = (unsigned char)(ENABLEMENT << DMA_CINT_CAIR_SHIFT);
+
+		Dma_Initialized = 1u;
+}
+
+/*!
+ * @brief Programs a DMA channel and routes its request source.
+ *
+ * The DMAMUX slot is disabled while the descriptor is written and enabled last.
+ *
+ * @param[in] ConfigPtr Pointer to the channel configuration structure.
+ * @return DMA_OK on success, DMA_ERR_PARA or DMA_ERR_BUSY on error.
+ * @note The request is left disabled, see Dma_StartChannel().
+ */
+Dma_ret_t Dma_ConfigChannel(const Dma_ChannelConfigType * ConfigPtr)
+{
+		DMA_TCD_Type * tcd;
+		unsigned int csr;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->channel >= DMA_CHANNEL_COUNT) ||
+		    (ConfigPtr->source > DMAMUX_CHCFG_SOURCE_MASK) ||
+		    ((ConfigPtr->periodicTrigger != 0u) && (ConfigPtr->channel >= DMAMUX_PERIODIC_CHANNEL_COUNT)) ||
+		    (ConfigPtr->majorCount == 0u) || (ConfigPtr->majorCount > DMA_MAJOR_COUNT_MAX) ||
+		    (ConfigPtr->minorBytes == 0u))
+		{
+			return DMA_ERR_PARA;
+		}
+		if (Dma_IsIdle(ConfigPtr->channel) == 0u)
+		{
+			return DMA_ERR_BUSY;
+		}
+
+		/* 1. Detach the request source */
+		DMAMUX->CHCFG[ConfigPtr->channel] = RESET;
+		DMA->CDNE = ConfigPtr->channel;
+
+		/* 2. Transfer control descriptor */
+		tcd = &DMA->TCD[ConfigPtr->channel];
+		tcd->SADDR = ConfigPtr->srcAddr;
+		tcd->SOFF = (unsigned short)ConfigPtr->srcOffset;
+		tcd->ATTR = (unsigned short)(((unsigned int)ConfigPtr->srcSize << DMA_TCD_ATTR_SSIZE_SHIFT) |
+		                             ((unsigned int)ConfigPtr->destSize << DMA_TCD_ATTR_DSIZE_SHIFT));
+		tcd->NBYTES = ConfigPtr->minorBytes;
+		tcd->SLAST = (unsigned int)ConfigPtr->srcLastAdjust;
+		tcd->DADDR = ConfigPtr->destAddr;
+		tcd->DOFF = (unsigned short)ConfigPtr->destOffset;
+		tcd->CITER = ConfigPtr->majorCount;
+		tcd->BITER = ConfigPtr->majorCount;
+		tcd->DLASTSGA = (unsigned int)ConfigPtr->destLastAdjust;
+		csr = (ConfigPtr->circular != 0u) ? 0u : ((unsigned int)ENABLEMENT << DMA_TCD_CSR_DREQ_SHIFT);
+		tcd->CSR = (unsigned short)csr;
+
+		/* 3. Attach the request source */
+		DMAMUX->CHCFG[ConfigPtr->channel] = (unsigned char)((ConfigPtr->source << DMAMUX_CHCFG_SOURCE_SHIFT) |
+		                                    ((unsigned int)(ConfigPtr->periodicTrigger != 0u) << DMAMUX_CHCFG_TRIG_SHIFT) |
+		                                    ((unsigned int)ENABLEMENT << DMAMUX_CHCFG_ENBL_SHIFT));
+
+		return DMA_OK;
+}
+
+/*!
+ * @brief Reloads a one-shot channel with new addresses and count.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @param[in] srcAddr Source address.
+ * @param[in] destAddr Destination address.
+ * @param[in] majorCount Requests per major loop (1 to DMA_MAJOR_COUNT_MAX).
+ * @return DMA_OK on success, DMA_ERR_PARA or DMA_ERR_BUSY on error.
+ */
+Dma_ret_t Dma_SetTransfer(unsigned char channel, unsigned int srcAddr, unsigned int destAddr, unsigned short majorCount)
+{
+		DMA_TCD_Type * tcd;
+
+		/* Check parameter */
+		if ((channel >= DMA_CHANNEL_COUNT) || (majorCount == 0u) || (majorCount > DMA_MAJOR_COUNT_MAX))
+		{
+			return DMA_ERR_PARA;
+		}
+		if (Dma_IsIdle(channel) == 0u)
+		{
+			return DMA_ERR_BUSY;
+		}
+
+		tcd = &DMA->TCD[channel];
+		DMA->CDNE = channel;
+		tcd->SADDR = srcAddr;
+		tcd->DADDR = destAddr;
+		tcd->CITER = majorCount;
+		tcd->BITER = majorCount;
+
+		return DMA_OK;
+}
+
+/*!
+ * @brief Enables the hardware request of a channel.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return void.
+ */
+void Dma_StartChannel(unsigned char channel)
+{
+		if (channel < DMA_CHANNEL_COUNT)
+		{
+			DMA->SERQ = channel;
+		}
+}
+
+/*!
+ * @brief Disables the hardware request of a channel.
+ *
+ * A transfer already running completes its minor loop.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return void.
+ */
+void Dma_StopChannel(unsigned char channel)
+{
+		if (channel < DMA_CHANNEL_COUNT)
+		{
+			DMA->CERQ = channel;
+		}
+}
+
+/*!
+ * @brief Gets the requests left in the current major loop.
+ *
+ * CITER is decremented when a minor loop has been written, so the data before the returned
+ * position is complete.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return Current major count; equals the programmed count before the first request.
+ */
+unsigned short Dma_GetRemaining(unsigned char channel)
+{
+		if (channel >= DMA_CHANNEL_COUNT)
+		{
+			return 0u;
+		}
+
+		return (unsigned short)(DMA->TCD[channel].CITER & DMA_TCD_CITER_MASK);
+}
+
+/*!
+ * @brief Checks whether the major loop of a channel completed.
+ *
+ * @param[in] channel DMA channel (0-15).
+ * @return 1 when done, 0 otherwise.
+ */
+unsigned char Dma_IsDone(unsigned char channel)
+{
+		if (channel >= DMA_CHANNEL_COUNT)
+		{
+			return 0u;
+		}
+
+		return (unsigned char)((DMA->TCD[channel].CSR >> DMA_TCD_CSR_DONE_SHIFT) & VALUE_CHECK_BIT);
+}
+
+/*!
+ * @brief Gets the error status of the controller.
+ *
+ * @return ES register, 0 when no error was recorded.
+ */
+unsigned int Dma_GetErrorStatus(void)
+{
+		return DMA->ES;
+}
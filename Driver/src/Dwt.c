@@ -0,0 +1,45 @@
+/****************************************************************************************************
+* @file    Dwt.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of DWT cycle counter functions.
+* @details This file provides functions to enable and read the DWT cycle counter.
+* @version 1.0.0
+* @date    2024-10-22
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Dwt.h"
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Enables the DWT cycle counter.
+ *
+ * This function enables trace in the debug monitor, clears the cycle counter and starts it.
+ *
+ * @return void.
+ */
+void Dwt_Init(void)
+{
+			/* Step 1. Enable the DWT unit */
+			COREDEBUG_DEMCR |= (ENABLEMENT << COREDEBUG_DEMCR_TRCENA_SHIFT);
+
+			/* Step 2. Clear and start the cycle counter */
+			DWT->CYCCNT = RESET;
+			DWT->CTRL |= (ENABLEMENT << DWT_CTRL_CYCCNTENA_SHIFT);
+}
+
+/*!
+ * @brief Retrieves the current value of the cycle counter.
+ *
+ * @return Number of core clock cycles since Dwt_Init(), wrapping at 2^32.
+ */
+unsigned int Dwt_GetCycles(void)
+{
+			return DWT->CYCCNT;
+}
@@ -0,0 +1,299 @@
+/****************************************************************************************************
+* @file    Ftfc.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the FTFC flash driver.
+* @details This file loads the command object, launches the command and enables the command
+*          complete interrupt. The interrupt is level sensitive on CCIF, so the handler disables it
+*          again before reporting the result.
+* @version 1.0.0
+* @date    2024-11-12
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define FTFC_FSTAT_ERRORS                   (((unsigned int)ENABLEMENT << FTFC_FSTAT_ACCERR_SHIFT) | \
+                                             ((unsigned int)ENABLEMENT << FTFC_FSTAT_FPVIOL_SHIFT) | \
+                                             ((unsigned int)ENABLEMENT << FTFC_FSTAT_RDCOLERR_SHIFT))
+#define FTFC_CCIF                           ((unsigned int)ENABLEMENT << FTFC_FSTAT_CCIF_SHIFT)
+#define FTFC_CCIE                           ((unsigned int)ENABLEMENT << FTFC_FCNFG_CCIE_SHIFT)
+#define FTFC_ERSSUSP                        ((unsigned int)ENABLEMENT << FTFC_FCNFG_ERSSUSP_SHIFT)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Ftfc_ConfigType * Ftfc_Config;             /* Active configuration */
+static volatile unsigned char Ftfc_Busy;                /* Command launched, completion not reported */
+static unsigned char Ftfc_Command;                      /* Command launched last */
+static volatile Ftfc_ret_t Ftfc_LastResult;             /* Result of the command ended last */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Translates the status flags of a finished command.
+ */
+static Ftfc_ret_t Ftfc_Result(unsigned int fstat)
+{
+		if ((fstat & ((unsigned int)ENABLEMENT << FTFC_FSTAT_ACCERR_SHIFT)) != 0u)
+		{
+			return FTFC_ERR_ACCESS;
+		}
+		if ((fstat & ((unsigned int)ENABLEMENT << FTFC_FSTAT_FPVIOL_SHIFT)) != 0u)
+		{
+			return FTFC_ERR_PROTECTION;
+		}
+		if ((fstat & ((unsigned int)ENABLEMENT << FTFC_FSTAT_MGSTAT0_SHIFT)) != 0u)
+		{
+			return FTFC_ERR_VERIFY;
+		}
+		return FTFC_OK;
+}
+
+/*!
+ * @brief Checks that the D-Flash is idle and loads the command and the 24-bit address.
+ */
+static Ftfc_ret_t Ftfc_Prepare(unsigned char command, unsigned int address)
+{
+		if ((Ftfc_Busy != 0u) || ((FTFC->FSTAT & FTFC_CCIF) == 0u))
+		{
+			return FTFC_ERR_BUSY;
+		}
+
+		/* Errors of the previous command block the next launch */
+		FTFC->FSTAT = (unsigned char)FTFC_FSTAT_ERRORS;
+
+		FTFC->FCCOB[FTFC_FCCOB_INDEX(0u)] = command;
+		FTFC->FCCOB[FTFC_FCCOB_INDEX(1u)] = (unsigned char)(address >> 16u);
+		FTFC->FCCOB[FTFC_FCCOB_INDEX(2u)] = (unsigned char)(address >> 8u);
+		FTFC->FCCOB[FTFC_FCCOB_INDEX(3u)] = (unsigned char)address;
+		Ftfc_Command = command;
+		return FTFC_OK;
+}
+
+/*!
+ * @brief Launches the loaded command and enables the completion interrupt.
+ */
+static Ftfc_ret_t Ftfc_Launch(void)
+{
+		Ftfc_ret_t result;
+
+		Ftfc_Busy = 1u;
+		FTFC->FSTAT = (unsigned char)FTFC_CCIF;
+
+		/* A rejected command ends at once with ACCERR or FPVIOL */
+		result = Ftfc_Result(FTFC->FSTAT & FTFC_FSTAT_ERRORS);
+		if (result != FTFC_OK)
+		{
+			Ftfc_Busy = 0u;
+			return result;
+		}
+
+		FTFC->FCNFG |= (unsigned char)FTFC_CCIE;
+		return FTFC_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the FTFC driver.
+ *
+ * This function waits for a command started before the call, e.g. by a debugger, and clears the
+ * error flags.
+ *
+ * @param[in] ConfigPtr Pointer to the FTFC configuration structure.
+ * @return FTFC_OK on success, FTFC_ERR_PARA on parameter error.
+ * @note Enable FTFC_CC_IRQn in the NVIC to receive the callback.
+ */
+Ftfc_ret_t Ftfc_Init(const Ftfc_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if (ConfigPtr == NULL)
+		{
+			return FTFC_ERR_PARA;
+		}
+
+		FTFC->FCNFG &= (unsigned char)~FTFC_CCIE;
+		while ((FTFC->FSTAT & FTFC_CCIF) == 0u)
+		{
+		}
+		FTFC->FSTAT = (unsigned char)FTFC_FSTAT_ERRORS;
+
+		Ftfc_Config = ConfigPtr;
+		Ftfc_Busy = 0u;
+		Ftfc_LastResult = FTFC_OK;
+
+		return FTFC_OK;
+}
+
+/*!
+ * @brief Starts programming one phrase of the D-Flash.
+ *
+ * @param[in] address D-Flash command address, FTFC_DFLASH_ADDRESS + offset, 8-byte aligned.
+ * @param[in] DataPtr 8 bytes to program, copied before the call returns.
+ * @return FTFC_OK when the command was launched, FTFC_ERR_PARA, FTFC_ERR_BUSY or the launch error.
+ * @note The phrase must be erased; programming it twice is not allowed.
+ */
+Ftfc_ret_t Ftfc_ProgramPhrase(unsigned int address, const unsigned char * DataPtr)
+{
+		Ftfc_ret_t result;
+		unsigned int index;
+
+		/* Check parameter */
+		if ((DataPtr == NULL) || (address < FTFC_DFLASH_ADDRESS) ||
+		    (address >= (FTFC_DFLASH_ADDRESS + FTFC_DFLASH_SIZE)) || ((address % FTFC_PHRASE_SIZE) != 0u))
+		{
+			return FTFC_ERR_PARA;
+		}
+
+		result = Ftfc_Prepare(FTFC_CMD_PROGRAM_PHRASE, address);
+		if (result != FTFC_OK)
+		{
+			return result;
+		}
+
+		/* FCCOB4..B: bytes in address order */
+		for (index = 0u; index < FTFC_PHRASE_SIZE; index++)
+		{
+			FTFC->FCCOB[FTFC_FCCOB_INDEX(4u + index)] = DataPtr[index];
+		}
+
+		return Ftfc_Launch();
+}
+
+/*!
+ * @brief Starts erasing one sector of the D-Flash.
+ *
+ * @param[in] address D-Flash command address, FTFC_DFLASH_ADDRESS + offset, sector aligned.
+ * @return FTFC_OK when the command was launched, FTFC_ERR_PARA, FTFC_ERR_BUSY or the launch error.
+ */
+Ftfc_ret_t Ftfc_EraseSector(unsigned int address)
+{
+		Ftfc_ret_t result;
+
+		/* Check parameter */
+		if ((address < FTFC_DFLASH_ADDRESS) || (address >= (FTFC_DFLASH_ADDRESS + FTFC_DFLASH_SIZE)) ||
+		    ((address % FTFC_DFLASH_SECTOR_SIZE) != 0u))
+		{
+			return FTFC_ERR_PARA;
+		}
+
+		result = Ftfc_Prepare(FTFC_CMD_ERASE_SECTOR, address);
+		if (result != FTFC_OK)
+		{
+			return result;
+		}
+
+		return Ftfc_Launch();
+}
+
+/*!
+ * @brief Tells whether a command is running.
+ *
+ * @return 1 while a command runs, 0 otherwise.
+ */
+unsigned char Ftfc_IsBusy(void)
+{
+		return Ftfc_Busy;
+}
+
+/*!
+ * @brief Waits for the running command with the interrupt disabled.
+ *
+ * The callback is not called for this command. Used to chain commands where the completion
+ * interrupt cannot run, e.g. from a higher priority interrupt.
+ *
+ * @return Result of the command, FTFC_OK when none was running.
+ */
+Ftfc_ret_t Ftfc_Wait(void)
+{
+		FTFC->FCNFG &= (unsigned char)~FTFC_CCIE;
+		if (Ftfc_Busy == 0u)
+		{
+			/* Already reported, or the interrupt ran before it was disabled */
+			return Ftfc_LastResult;
+		}
+
+		while ((FTFC->FSTAT & FTFC_CCIF) == 0u)
+		{
+		}
+		Ftfc_LastResult = Ftfc_Result(FTFC->FSTAT);
+		Ftfc_Busy = 0u;
+
+		return Ftfc_LastResult;
+}
+
+/*!
+ * @brief Stops the running command as soon as possible.
+ *
+ * A sector erase is suspended and not resumed; it has to be launched again later. A phrase
+ * program cannot be stopped and is waited for. The callback is not called for this command.
+ *
+ * @return Result of the command, FTFC_ERR_SUSPENDED for a suspended erase.
+ */
+Ftfc_ret_t Ftfc_Suspend(void)
+{
+		Ftfc_ret_t result;
+
+		if ((Ftfc_Busy == 0u) || (Ftfc_Command != FTFC_CMD_ERASE_SECTOR))
+		{
+			return Ftfc_Wait();
+		}
+
+		FTFC->FCNFG |= (unsigned char)FTFC_ERSSUSP;
+		result = Ftfc_Wait();
+
+		/* ERSSUSP still set: the erase stopped before the end; clear it so that it is not resumed */
+		if ((FTFC->FCNFG & FTFC_ERSSUSP) != 0u)
+		{
+			FTFC->FCNFG &= (unsigned char)~FTFC_ERSSUSP;
+			result = FTFC_ERR_SUSPENDED;
+		}
+		Ftfc_LastResult = result;
+
+		return result;
+}
+
+/*!
+ * @brief FTFC command complete interrupt handler.
+ *
+ * Disables the interrupt, which stays asserted while the FTFC is idle, and calls the callback.
+ *
+ * @return void.
+ */
+void FTFC_IRQHandler(void)
+{
+		Ftfc_ret_t result;
+
+		STACK_ISR_ENTER(FTFC_CC_IRQn);
+		TRACE_ISR_ENTER(FTFC_CC_IRQn);
+		FTFC->FCNFG &= (unsigned char)~FTFC_CCIE;
+		if (Ftfc_Busy == 0u)
+		{
+			/* Pending from before Ftfc_Wait() took the command over */
+			TRACE_ISR_EXIT(FTFC_CC_IRQn);
+			return;
+		}
+		result = Ftfc_Result(FTFC->FSTAT);
+		Ftfc_LastResult = result;
+		Ftfc_Busy = 0u;
+
+		if ((Ftfc_Config != NULL) && (Ftfc_Config->callback != NULL))
+		{
+			Ftfc_Config->callback(result);
+		}
+		TRACE_ISR_EXIT(FTFC_CC_IRQn);
+}
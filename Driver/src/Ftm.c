@@ -0,0 +1,453 @@
+/****************************************************************************************************
+* @file    Ftm.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the FTM PWM driver.
+* @details This file provides functions to configure edge- or center-aligned PWM on the FlexTimer
+*          modules. The period and duties are written to the buffered MOD and CnV registers and
+*          loaded by hardware at a reload point, so the outputs never see a partial update.
+* @version 1.0.0
+* @date    2024-11-02
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftm.h"
+#include "ClockGate.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define FTM_PRESCALER_MAX                   (7u)
+#define FTM_CHANNEL_MASK(CH)                (1u << (CH))
+#define FTM_DTPS_DIV1                       (1u)               /* DTPS 0x1: divide by 1 */
+#define FTM_DTPS_DIV4                       (2u)               /* DTPS 0x2: divide by 4 */
+#define FTM_DTPS_DIV16                      (3u)               /* DTPS 0x3: divide by 16 */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Run-time state of an FTM instance.
+ */
+typedef struct
+{
+			const Ftm_ConfigType *  config;                     /*!< Active configuration, NULL when stopped */
+			unsigned int            frequencyHz;                /*!< Current PWM frequency */
+			unsigned int            mod;                        /*!< Current MOD value */
+			unsigned int            chsel;                      /*!< Channels loaded by PWMLOAD */
+			unsigned short          duty[FTM_CHANNEL_COUNT];    /*!< Last duty written to each channel */
+} Ftm_StateType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static FTM_Type * const Ftm_Bases[FTM_INSTANCE_COUNT] = { FTM0, FTM1, FTM2, FTM3 };
+static const clock_names_t Ftm_Clocks[FTM_INSTANCE_COUNT] = { FTM0_CLK, FTM1_CLK, FTM2_CLK, FTM3_CLK };
+
+static Ftm_StateType Ftm_State[FTM_INSTANCE_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Computes MOD for a PWM frequency.
+ *
+ * Edge-aligned: period = (MOD + 1) counts. Center-aligned: period = 2 * MOD counts.
+ * MOD stays below FTM_MOD_MAX so that a 100 % duty can be expressed.
+ */
+static Ftm_ret_t Ftm_CalcMod(unsigned char instance, unsigned int frequencyHz, unsigned int * ModPtr)
+{
+		const Ftm_ConfigType * cfg = Ftm_State[instance].config;
+		unsigned int counterHz;
+		unsigned int mod;
+
+		if (frequencyHz == 0u)
+		{
+			return FTM_ERR_PARA;
+		}
+
+		counterHz = Ftm_GetInputFreq(instance) >> cfg->prescaler;
+		if (counterHz == 0u)
+		{
+			return FTM_ERR_CLOCK;
+		}
+
+		if (cfg->alignment == FTM_ALIGN_CENTER)
+		{
+			mod = (counterHz / frequencyHz) / 2u;
+		}
+		else
+		{
+			mod = counterHz / frequencyHz;
+			mod = (mod != 0u) ? (mod - 1u) : 0u;
+		}
+		if ((mod == 0u) || (mod >= FTM_MOD_MAX))
+		{
+			return FTM_ERR_PARA;
+		}
+
+		*ModPtr = mod;
+		return FTM_OK;
+}
+
+/*!
+ * @brief Converts a duty into a CnV value for the given MOD.
+ */
+static unsigned int Ftm_DutyToCount(const Ftm_ConfigType * ConfigPtr, unsigned int mod, unsigned short duty)
+{
+		unsigned int period = (ConfigPtr->alignment == FTM_ALIGN_CENTER) ? mod : (mod + 1u);
+
+		if (duty == FTM_DUTY_MAX)
+		{
+			return period;                            /* CnV past the period: output always active */
+		}
+		return (period * (unsigned int)duty) >> 16u;
+}
+
+/*!
+ * @brief Computes the DEADTIME register value.
+ *
+ * Dead-time counts the FTM system clock, whatever the counter clock source is.
+ */
+static Ftm_ret_t Ftm_CalcDeadTime(unsigned int deadTimeNs, unsigned int * DeadTimePtr)
+{
+		uint64 counts;
+		unsigned int dtps = FTM_DTPS_DIV1;
+
+		counts = ((uint64)deadTimeNs * Clock_GetFreq(CLOCK_FREQ_CORE) + (FTM_NS_PER_SECOND - 1u)) / FTM_NS_PER_SECOND;
+		if (counts > FTM_DEADTIME_MAX_COUNT)
+		{
+			counts = (counts + 3u) / 4u;
+			dtps = FTM_DTPS_DIV4;
+		}
+		if (counts > FTM_DEADTIME_MAX_COUNT)
+		{
+			counts = (counts + 3u) / 4u;
+			dtps = FTM_DTPS_DIV16;
+		}
+		if (counts > FTM_DEADTIME_MAX_COUNT)
+		{
+			return FTM_ERR_PARA;
+		}
+
+		*DeadTimePtr = (((unsigned int)counts & FTM_DEADTIME_DTVAL_MASK) << FTM_DEADTIME_DTVAL_SHIFT) |
+		               (dtps << FTM_DEADTIME_DTPS_SHIFT) |
+		               (((unsigned int)counts >> 6u) << FTM_DEADTIME_DTVALEX_SHIFT);
+		return FTM_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes an FTM instance for PWM and starts the counter.
+ *
+ * The counter is configured with the clock stopped and started by the last SC write, together
+ * with the channel outputs.
+ *
+ * @param[in] ConfigPtr Pointer to the FTM configuration structure.
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ */
+Ftm_ret_t Ftm_Init(const Ftm_ConfigType * ConfigPtr)
+{
+		FTM_Type * ftm;
+		Ftm_StateType * state;
+		const Ftm_ChannelConfigType * ch;
+		peripheral_clock_source_t pcs;
+		unsigned char index;
+		unsigned int mod;
+		unsigned int cnsc;
+		unsigned int combine = 0u;
+		unsigned int deadtime = 0u;
+		unsigned int pwmen = 0u;
+		Ftm_ret_t ret;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= FTM_INSTANCE_COUNT) ||
+		    (ConfigPtr->clockSrc < FTM_CLK_SYSTEM) || (ConfigPtr->clockSrc > FTM_CLK_EXTERNAL) ||
+		    (ConfigPtr->prescaler > FTM_PRESCALER_MAX) || (ConfigPtr->reloadDivider > FTM_CONF_LDFQ_MASK) ||
+		    ((ConfigPtr->channels == NULL) && (ConfigPtr->channelCount != 0u)))
+		{
+			return FTM_ERR_PARA;
+		}
+		for (index = 0u; index < ConfigPtr->channelCount; index++)
+		{
+			ch = &ConfigPtr->channels[index];
+			if ((ch->channel >= FTM_CHANNEL_COUNT) ||
+			    ((ch->complementary != 0u) && ((ch->channel & 1u) != 0u)))
+			{
+				return FTM_ERR_PARA;
+			}
+		}
+
+		ftm = Ftm_Bases[ConfigPtr->instance];
+		state = &Ftm_State[ConfigPtr->instance];
+
+		/* 1. Interface clock, and functional clock when the counter runs on it */
+		if (state->config == NULL)
+		{
+			pcs = (ConfigPtr->clockSrc == FTM_CLK_EXTERNAL) ? ConfigPtr->pccClkSrc : CLK_SRC_OFF;
+			if (ClockGate_Request(Ftm_Clocks[ConfigPtr->instance], pcs) != CLOCKGATE_OK)
+			{
+				return FTM_ERR_PARA;
+			}
+		}
+		state->config = ConfigPtr;
+
+		/* 2. Period and dead-time need the clock frequencies */
+		ret = Ftm_CalcMod(ConfigPtr->instance, ConfigPtr->frequencyHz, &mod);
+		if ((ret == FTM_OK) && (ConfigPtr->deadTimeNs != 0u))
+		{
+			ret = Ftm_CalcDeadTime(ConfigPtr->deadTimeNs, &deadtime);
+		}
+		if (ret != FTM_OK)
+		{
+			Ftm_Deinit(ConfigPtr->instance);
+			return ret;
+		}
+		state->frequencyHz = ConfigPtr->frequencyHz;
+		state->mod = mod;
+		state->chsel = 0u;
+
+		/* 3. Stop the counter and unlock the registers */
+		ftm->SC = RESET;
+		ftm->MODE = ((unsigned int)ENABLEMENT << FTM_MODE_FTMEN_SHIFT) |
+		            ((unsigned int)ENABLEMENT << FTM_MODE_WPDIS_SHIFT);
+		ftm->CNTIN = RESET;
+		ftm->CNT = RESET;
+		ftm->MOD = mod;
+
+		/* 4. Channels */
+		for (index = 0u; index < ConfigPtr->channelCount; index++)
+		{
+			ch = &ConfigPtr->channels[index];
+			cnsc = ((unsigned int)ENABLEMENT << FTM_CnSC_MSB_SHIFT) |
+			       ((unsigned int)ENABLEMENT << ((ch->polarity == FTM_POLARITY_LOW) ? FTM_CnSC_ELSA_SHIFT : FTM_CnSC_ELSB_SHIFT));
+
+			state->duty[ch->channel] = ch->duty;
+			ftm->CONTROLS[ch->channel].CnSC = cnsc;
+			ftm->CONTROLS[ch->channel].CnV = Ftm_DutyToCount(ConfigPtr, mod, ch->duty);
+			pwmen |= FTM_CHANNEL_MASK(ch->channel);
+			state->chsel |= FTM_CHANNEL_MASK(ch->channel);
+
+			if (ch->complementary != 0u)
+			{
+				/* Channel n + 1 follows channel n, inverted, with dead-time */
+				ftm->CONTROLS[ch->channel + 1u].CnSC = cnsc;
+				pwmen |= FTM_CHANNEL_MASK(ch->channel + 1u);
+				combine |= (((unsigned int)ENABLEMENT << FTM_COMBINE_COMP_SHIFT) |
+				            ((unsigned int)(ConfigPtr->deadTimeNs != 0u) << FTM_COMBINE_DTEN_SHIFT)) <<
+				           FTM_COMBINE_PAIR_SHIFT(ch->channel >> 1u);
+			}
+			combine |= ((unsigned int)ENABLEMENT << FTM_COMBINE_SYNCEN_SHIFT) << FTM_COMBINE_PAIR_SHIFT(ch->channel >> 1u);
+		}
+		ftm->COMBINE = combine;
+		ftm->DEADTIME = deadtime;
+
+		/* 5. Reload point at the start of the period, every reloadDivider + 1 opportunities */
+		ftm->SYNC = (unsigned int)ENABLEMENT <<
+		            ((ConfigPtr->alignment == FTM_ALIGN_CENTER) ? FTM_SYNC_CNTMIN_SHIFT : FTM_SYNC_CNTMAX_SHIFT);
+		ftm->CONF = ((unsigned int)ConfigPtr->reloadDivider & FTM_CONF_LDFQ_MASK) << FTM_CONF_LDFQ_SHIFT;
+		ftm->PWMLOAD = state->chsel << FTM_PWMLOAD_CHSEL_SHIFT;
+
+		/* 6. Start the counter and enable the outputs in one write */
+		ftm->SC = ((unsigned int)ConfigPtr->prescaler << FTM_SC_PS_SHIFT) |
+		          ((unsigned int)ConfigPtr->clockSrc << FTM_SC_CLKS_SHIFT) |
+		          ((unsigned int)ConfigPtr->alignment << FTM_SC_CPWMS_SHIFT) |
+		          (pwmen << FTM_SC_PWMEN_SHIFT);
+
+		return FTM_OK;
+}
+
+/*!
+ * @brief Stops an FTM instance and releases its clock.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return void.
+ */
+void Ftm_Deinit(unsigned char instance)
+{
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Ftm_Bases[instance]->SC = RESET;
+		(void)ClockGate_Release(Ftm_Clocks[instance]);
+		Ftm_State[instance].config = NULL;
+}
+
+/*!
+ * @brief Writes the buffered duty of a channel.
+ *
+ * The value takes effect at the reload point after Ftm_LoadAtReload().
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @param[in] channel Channel (0-7).
+ * @param[in] duty Duty, 0 to FTM_DUTY_MAX.
+ * @return FTM_OK on success, FTM_ERR_PARA on parameter error.
+ */
+Ftm_ret_t Ftm_SetDuty(unsigned char instance, unsigned char channel, unsigned short duty)
+{
+		Ftm_StateType * state;
+
+		/* Check parameter */
+		if ((instance >= FTM_INSTANCE_COUNT) || (channel >= FTM_CHANNEL_COUNT) ||
+		    (Ftm_State[instance].config == NULL) ||
+		    ((Ftm_State[instance].chsel & FTM_CHANNEL_MASK(channel)) == 0u))
+		{
+			return FTM_ERR_PARA;
+		}
+
+		state = &Ftm_State[instance];
+		state->duty[channel] = duty;
+		Ftm_Bases[instance]->CONTROLS[channel].CnV = Ftm_DutyToCount(state->config, state->mod, duty);
+
+		return FTM_OK;
+}
+
+/*!
+ * @brief Requests the buffered values to be loaded at the next reload point.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return void.
+ */
+void Ftm_LoadAtReload(unsigned char instance)
+{
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Ftm_Bases[instance]->PWMLOAD = (Ftm_State[instance].chsel << FTM_PWMLOAD_CHSEL_SHIFT) |
+		                               ((unsigned int)ENABLEMENT << FTM_PWMLOAD_LDOK_SHIFT);
+}
+
+/*!
+ * @brief Checks and clears the reload flag.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return 1 when a reload point was reached since the last call, 0 otherwise.
+ */
+unsigned char Ftm_TakeReloadFlag(unsigned char instance)
+{
+		FTM_Type * ftm;
+		unsigned int sc;
+
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		ftm = Ftm_Bases[instance];
+		sc = ftm->SC;
+		if (((sc >> FTM_SC_RF_SHIFT) & VALUE_CHECK_BIT) == 0u)
+		{
+			return 0u;
+		}
+
+		/* Read with RF set, then write 0 to clear; TOF written back as read is not affected */
+		ftm->SC = sc & ((unsigned int) ~(VALUE_CHECK_BIT << FTM_SC_RF_SHIFT));
+		return 1u;
+}
+
+/*!
+ * @brief Changes the PWM frequency, keeping the duties.
+ *
+ * MOD and every CnV are rewritten and loaded together at the next reload point.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @param[in] frequencyHz New PWM frequency.
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ */
+Ftm_ret_t Ftm_SetFrequency(unsigned char instance, unsigned int frequencyHz)
+{
+		Ftm_StateType * state;
+		FTM_Type * ftm;
+		unsigned char channel;
+		unsigned int mod;
+		Ftm_ret_t ret;
+
+		/* Check parameter */
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return FTM_ERR_PARA;
+		}
+
+		ret = Ftm_CalcMod(instance, frequencyHz, &mod);
+		if (ret != FTM_OK)
+		{
+			return ret;
+		}
+
+		state = &Ftm_State[instance];
+		ftm = Ftm_Bases[instance];
+		state->frequencyHz = frequencyHz;
+		state->mod = mod;
+
+		ftm->MOD = mod;
+		for (channel = 0u; channel < FTM_CHANNEL_COUNT; channel++)
+		{
+			if ((state->chsel & FTM_CHANNEL_MASK(channel)) != 0u)
+			{
+				ftm->CONTROLS[channel].CnV = Ftm_DutyToCount(state->config, mod, state->duty[channel]);
+			}
+		}
+		Ftm_LoadAtReload(instance);
+
+		return FTM_OK;
+}
+
+/*!
+ * @brief Recomputes the period after the input clock changed.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return FTM_OK on success, FTM_ERR_PARA or FTM_ERR_CLOCK on error.
+ * @note Call this from a Perf post-change callback when the counter runs on the system clock.
+ *       The dead-time is not recomputed; size it for the highest system clock.
+ */
+Ftm_ret_t Ftm_Retune(unsigned char instance)
+{
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return FTM_ERR_PARA;
+		}
+
+		return Ftm_SetFrequency(instance, Ftm_State[instance].frequencyHz);
+}
+
+/*!
+ * @brief Gets the counter input frequency before the prescaler.
+ *
+ * @param[in] instance FTM instance (0-3).
+ * @return Frequency in Hz, 0 when the clock is not running.
+ */
+unsigned int Ftm_GetInputFreq(unsigned char instance)
+{
+		const Ftm_ConfigType * cfg;
+
+		if ((instance >= FTM_INSTANCE_COUNT) || (Ftm_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		cfg = Ftm_State[instance].config;
+		switch (cfg->clockSrc)
+		{
+			case FTM_CLK_SYSTEM:
+				return Clock_GetFreq(CLOCK_FREQ_CORE);
+			case FTM_CLK_FIXED:
+				return cfg->fixedClockHz;
+			case FTM_CLK_EXTERNAL:
+				return Clock_GetPccFunctionalFreq(Ftm_Clocks[instance]);
+			default:
+				return 0u;
+		}
+}
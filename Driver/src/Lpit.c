@@ -0,0 +1,404 @@
+/****************************************************************************************************
+* @file    Lpit.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the LPIT driver.
+* @details This file provides functions to configure the four LPIT channels, convert periods into
+*          reload values from the functional clock frequency, and run two chained channels as a
+*          64-bit free-running counter.
+* @version 1.0.0
+* @date    2024-11-01
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpit.h"
+#include "ClockGate.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define LPIT_ALL_CHANNELS                   ((1u << LPIT_CHANNEL_COUNT) - 1u)
+#define LPIT_ENABLE_WAIT_LOOPS              (64u)              /* > 4 functional clocks after M_CEN */
+#define LPIT_MAX_TICKS                      ((uint64)0x100000000u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Lpit_ConfigType * Lpit_Config;             /* Active configuration */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Builds the TCTRL value of a channel, timer disabled.
+ */
+static unsigned int Lpit_ChannelControl(const Lpit_ChannelConfigType * ChannelPtr)
+{
+		return ((unsigned int)(ChannelPtr->chain != 0u) << LPIT_TCTRL_CHAIN_SHIFT) |
+		       ((unsigned int)ChannelPtr->mode << LPIT_TCTRL_MODE_SHIFT) |
+		       ((unsigned int)(ChannelPtr->startOnTrigger != 0u) << LPIT_TCTRL_TSOT_SHIFT) |
+		       ((unsigned int)(ChannelPtr->stopOnInterrupt != 0u) << LPIT_TCTRL_TSOI_SHIFT) |
+		       ((unsigned int)(ChannelPtr->reloadOnTrigger != 0u) << LPIT_TCTRL_TROT_SHIFT) |
+		       ((unsigned int)ChannelPtr->triggerSource << LPIT_TCTRL_TRG_SRC_SHIFT) |
+		       ((unsigned int)ChannelPtr->triggerSelect << LPIT_TCTRL_TRG_SEL_SHIFT);
+}
+
+/*!
+ * @brief Clears the timeout flag of a channel and calls its callback.
+ */
+static void Lpit_IrqCommon(unsigned char channel)
+{
+		LPIT0->MSR = LPIT_CHANNEL_MASK(channel);          /* Write 1 to clear */
+
+		if ((Lpit_Config != NULL) && (Lpit_Config->channels[channel] != NULL) &&
+		    (Lpit_Config->channels[channel]->callback != NULL))
+		{
+			Lpit_Config->channels[channel]->callback(channel);
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the LPIT.
+ *
+ * This function requests the LPIT clock, enables the module and programs every configured
+ * channel. The channels are left stopped.
+ *
+ * @param[in] ConfigPtr Pointer to the LPIT configuration structure.
+ * @return LPIT_OK on success, LPIT_ERR_PARA or LPIT_ERR_CLOCK on error.
+ * @note Enable LPIT0_ChN_IRQn in the NVIC to receive the callbacks.
+ */
+Lpit_ret_t Lpit_Init(const Lpit_ConfigType * ConfigPtr)
+{
+		unsigned char channel;
+		unsigned int loops;
+		unsigned int mier = 0u;
+		unsigned int reload[LPIT_CHANNEL_COUNT];
+		const Lpit_ChannelConfigType * ch;
+		Lpit_ret_t ret;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->clkSrc == CLK_SRC_OFF))
+		{
+			return LPIT_ERR_PARA;
+		}
+		for (channel = 0u; channel < LPIT_CHANNEL_COUNT; channel++)
+		{
+			ch = ConfigPtr->channels[channel];
+			if ((ch != NULL) &&
+			    ((ch->mode > LPIT_MODE_INPUT_CAPTURE_32) || (ch->triggerSelect >= LPIT_CHANNEL_COUNT) ||
+			     ((ch->chain != 0u) && (channel == 0u))))
+			{
+				return LPIT_ERR_PARA;
+			}
+		}
+
+		/* 1. Functional and interface clock */
+		if (Lpit_Config == NULL)
+		{
+			if (ClockGate_Request(LPIT0_CLK, ConfigPtr->clkSrc) != CLOCKGATE_OK)
+			{
+				return LPIT_ERR_PARA;
+			}
+		}
+		Lpit_Config = ConfigPtr;
+
+		/* 2. Reload values need the functional clock frequency */
+		for (channel = 0u; channel < LPIT_CHANNEL_COUNT; channel++)
+		{
+			ch = ConfigPtr->channels[channel];
+			reload[channel] = 0u;
+			if ((ch != NULL) && (ch->periodUs != 0u))
+			{
+				ret = Lpit_UsToReload(ch->periodUs, &reload[channel]);
+				if (ret != LPIT_OK)
+				{
+					Lpit_Deinit();
+					return ret;
+				}
+			}
+			else if (ch != NULL)
+			{
+				reload[channel] = ch->reloadValue;
+			}
+		}
+
+		/* 3. Enable the module and let it synchronize */
+		LPIT0->MCR = ((unsigned int)ENABLEMENT << LPIT_MCR_M_CEN_SHIFT) |
+		             ((unsigned int)(ConfigPtr->runInDoze != 0u) << LPIT_MCR_DOZE_EN_SHIFT) |
+		             ((unsigned int)(ConfigPtr->runInDebug != 0u) << LPIT_MCR_DBG_EN_SHIFT);
+		for (loops = 0u; loops < LPIT_ENABLE_WAIT_LOOPS; loops++)
+		{
+			(void)LPIT0->MCR;
+		}
+
+		/* 4. Stop every channel and clear stale flags */
+		LPIT0->CLRTEN = LPIT_ALL_CHANNELS;
+		LPIT0->MSR = LPIT_ALL_CHANNELS;
+
+		/* 5. Program the channels */
+		for (channel = 0u; channel < LPIT_CHANNEL_COUNT; channel++)
+		{
+			ch = ConfigPtr->channels[channel];
+			if (ch == NULL)
+			{
+				continue;
+			}
+			LPIT0->TMR[channel].TVAL = reload[channel];
+			LPIT0->TMR[channel].TCTRL = Lpit_ChannelControl(ch);
+			if (ch->interruptEnable != 0u)
+			{
+				mier |= LPIT_CHANNEL_MASK(channel);
+			}
+		}
+		LPIT0->MIER = mier;
+
+		return LPIT_OK;
+}
+
+/*!
+ * @brief Stops all channels, disables the module and releases its clock.
+ *
+ * @return void.
+ */
+void Lpit_Deinit(void)
+{
+		if (Lpit_Config == NULL)
+		{
+			return;
+		}
+
+		if (((LPIT0->MCR >> LPIT_MCR_M_CEN_SHIFT) & VALUE_CHECK_BIT) != 0u)
+		{
+			LPIT0->CLRTEN = LPIT_ALL_CHANNELS;
+			LPIT0->MIER = RESET;
+			LPIT0->MCR = RESET;
+		}
+		(void)ClockGate_Release(LPIT0_CLK);
+		Lpit_Config = NULL;
+}
+
+/*!
+ * @brief Starts several channels with one register write.
+ *
+ * Channels started together count in lockstep.
+ *
+ * @param[in] mask Channels to start, see LPIT_CHANNEL_MASK().
+ * @return void.
+ */
+void Lpit_StartChannels(unsigned int mask)
+{
+		LPIT0->SETTEN = mask & LPIT_ALL_CHANNELS;
+}
+
+/*!
+ * @brief Stops several channels with one register write.
+ *
+ * @param[in] mask Channels to stop, see LPIT_CHANNEL_MASK().
+ * @return void.
+ */
+void Lpit_StopChannels(unsigned int mask)
+{
+		LPIT0->CLRTEN = mask & LPIT_ALL_CHANNELS;
+}
+
+/*!
+ * @brief Converts a period to a reload value.
+ *
+ * @param[in] periodUs Period in microseconds.
+ * @param[out] ReloadPtr TVAL giving the period.
+ * @return LPIT_OK on success, LPIT_ERR_PARA when the period is out of range, LPIT_ERR_CLOCK
+ *         when the functional clock is not running.
+ */
+Lpit_ret_t Lpit_UsToReload(unsigned int periodUs, unsigned int * ReloadPtr)
+{
+		unsigned int freq = Lpit_GetClockFreq();
+		uint64 ticks;
+
+		if (ReloadPtr == NULL)
+		{
+			return LPIT_ERR_PARA;
+		}
+		if (freq == 0u)
+		{
+			return LPIT_ERR_CLOCK;
+		}
+
+		/* The timer expires after TVAL + 1 cycles */
+		ticks = ((uint64)freq * periodUs) / LPIT_US_PER_SECOND;
+		if ((ticks == 0u) || (ticks > LPIT_MAX_TICKS))
+		{
+			return LPIT_ERR_PARA;
+		}
+
+		*ReloadPtr = (unsigned int)(ticks - 1u);
+		return LPIT_OK;
+}
+
+/*!
+ * @brief Changes the period of a channel.
+ *
+ * The new period takes effect after the current one expires.
+ *
+ * @param[in] channel Channel (0-3).
+ * @param[in] periodUs Period in microseconds.
+ * @return LPIT_OK on success, LPIT_ERR_PARA or LPIT_ERR_CLOCK on error.
+ */
+Lpit_ret_t Lpit_SetPeriodUs(unsigned char channel, unsigned int periodUs)
+{
+		unsigned int reload;
+		Lpit_ret_t ret;
+
+		if (channel >= LPIT_CHANNEL_COUNT)
+		{
+			return LPIT_ERR_PARA;
+		}
+
+		ret = Lpit_UsToReload(periodUs, &reload);
+		if (ret == LPIT_OK)
+		{
+			LPIT0->TMR[channel].TVAL = reload;
+		}
+		return ret;
+}
+
+/*!
+ * @brief Reads the current value of a channel, counting down to 0.
+ *
+ * @param[in] channel Channel (0-3).
+ * @return Current timer value.
+ */
+unsigned int Lpit_GetCurrentValue(unsigned char channel)
+{
+		return (channel < LPIT_CHANNEL_COUNT) ? LPIT0->TMR[channel].CVAL : 0u;
+}
+
+/*!
+ * @brief Starts a 64-bit free-running counter on two chained channels.
+ *
+ * Channel lowChannel counts the functional clock and channel lowChannel + 1 counts its
+ * timeouts. Both channels are reprogrammed and started.
+ *
+ * @param[in] lowChannel Low channel (0-2).
+ * @return LPIT_OK on success, LPIT_ERR_PARA on parameter error.
+ */
+Lpit_ret_t Lpit_StartCounter64(unsigned char lowChannel)
+{
+		unsigned int pair;
+
+		if ((Lpit_Config == NULL) || (lowChannel >= (LPIT_CHANNEL_COUNT - 1u)))
+		{
+			return LPIT_ERR_PARA;
+		}
+
+		pair = LPIT_CHANNEL_MASK(lowChannel) | LPIT_CHANNEL_MASK(lowChannel + 1u);
+
+		/* 1. Stop both halves */
+		LPIT0->CLRTEN = pair;
+		LPIT0->MIER &= ~pair;
+
+		/* 2. Full-range reloads, high half chained to the low half */
+		LPIT0->TMR[lowChannel].TVAL = 0xFFFFFFFFu;
+		LPIT0->TMR[lowChannel].TCTRL = ((unsigned int)LPIT_MODE_PERIODIC_32 << LPIT_TCTRL_MODE_SHIFT);
+		LPIT0->TMR[lowChannel + 1u].TVAL = 0xFFFFFFFFu;
+		LPIT0->TMR[lowChannel + 1u].TCTRL = ((unsigned int)LPIT_MODE_PERIODIC_32 << LPIT_TCTRL_MODE_SHIFT) |
+		                                    ((unsigned int)ENABLEMENT << LPIT_TCTRL_CHAIN_SHIFT);
+
+		/* 3. Start both with one write */
+		LPIT0->SETTEN = pair;
+
+		return LPIT_OK;
+}
+
+/*!
+ * @brief Reads the 64-bit free-running counter.
+ *
+ * The high word is read before and after the low word, so a carry between the two reads is
+ * detected and the low word is read again.
+ *
+ * @param[in] lowChannel Low channel passed to Lpit_StartCounter64().
+ * @return Functional clock cycles since Lpit_StartCounter64().
+ */
+uint64 Lpit_GetCounter64(unsigned char lowChannel)
+{
+		unsigned int high;
+		unsigned int low;
+		unsigned int check;
+
+		if (lowChannel >= (LPIT_CHANNEL_COUNT - 1u))
+		{
+			return 0u;
+		}
+
+		high = LPIT0->TMR[lowChannel + 1u].CVAL;
+		low = LPIT0->TMR[lowChannel].CVAL;
+		check = LPIT0->TMR[lowChannel + 1u].CVAL;
+		if (check != high)
+		{
+			/* The low half reloaded between the reads */
+			high = check;
+			low = LPIT0->TMR[lowChannel].CVAL;
+		}
+
+		/* Both halves count down from all ones */
+		return ~(((uint64)high << 32u) | low);
+}
+
+/*!
+ * @brief Gets the LPIT functional clock frequency.
+ *
+ * @return Frequency in Hz, 0 when the clock is not running.
+ */
+unsigned int Lpit_GetClockFreq(void)
+{
+		return Clock_GetPccFunctionalFreq(LPIT0_CLK);
+}
+
+/*!
+ * @brief LPIT channel interrupt handlers.
+ *
+ * Clear the timeout flag and call the channel callback.
+ *
+ * @return void.
+ */
+void LPIT0_Ch0_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPIT0_Ch0_IRQn);
+		TRACE_ISR_ENTER(LPIT0_Ch0_IRQn);
+		Lpit_IrqCommon(0u);
+		TRACE_ISR_EXIT(LPIT0_Ch0_IRQn);
+}
+
+void LPIT0_Ch1_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPIT0_Ch1_IRQn);
+		TRACE_ISR_ENTER(LPIT0_Ch1_IRQn);
+		Lpit_IrqCommon(1u);
+		TRACE_ISR_EXIT(LPIT0_Ch1_IRQn);
+}
+
+void LPIT0_Ch2_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPIT0_Ch2_IRQn);
+		TRACE_ISR_ENTER(LPIT0_Ch2_IRQn);
+		Lpit_IrqCommon(2u);
+		TRACE_ISR_EXIT(LPIT0_Ch2_IRQn);
+}
+
+void LPIT0_Ch3_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPIT0_Ch3_IRQn);
+		TRACE_ISR_ENTER(LPIT0_Ch3_IRQn);
+		Lpit_IrqCommon(3u);
+		TRACE_ISR_EXIT(LPIT0_Ch3_IRQn);
+}
@@ -0,0 +1,244 @@
+/****************************************************************************************************
+* @file    Lptmr.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the LPTMR driver.
+* @details This file provides functions to configure the Low Power Timer as a time counter or a
+*          pulse counter. The prescaler and the compare register may only change while the timer
+*          is disabled, so Lptmr_Init() always stops the timer first.
+* @version 1.0.0
+* @date    2024-10-31
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lptmr.h"
+#include "ClockGate.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/* CSR value without the write-1-to-clear compare flag, so read-modify-writes keep the flag */
+#define LPTMR_CSR_KEEP_FLAG(CSR)            ((CSR) & ~((unsigned int)ENABLEMENT << LPTMR_CSR_TCF_SHIFT))
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Lptmr_ConfigType * Lptmr_Config;           /* Active configuration */
+static unsigned char Lptmr_ClockHeld;                   /* LPTMR0_CLK requested from ClockGate */
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the LPTMR.
+ *
+ * This function requests the LPTMR clock gate, stops the timer and programs the prescaler, the
+ * compare value and the control register. The timer is left stopped.
+ *
+ * @param[in] ConfigPtr Pointer to the LPTMR configuration structure.
+ * @return LPTMR_OK on success, LPTMR_ERR_PARA on parameter error.
+ * @note Enable LPTMR0_IRQn in the NVIC (or as a Sleep wake-up source) to receive the callback.
+ */
+Lptmr_ret_t Lptmr_Init(const Lptmr_ConfigType * ConfigPtr)
+{
+		peripheral_clock_source_t pccSrc;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->prescaler > LPTMR_PRESCALE_DIV_65536))
+		{
+			return LPTMR_ERR_PARA;
+		}
+		if ((ConfigPtr->mode == LPTMR_MODE_PULSE) && (ConfigPtr->prescalerBypass == 0u) &&
+		    (ConfigPtr->prescaler == LPTMR_PRESCALE_DIV_2))
+		{
+			return LPTMR_ERR_PARA;
+		}
+
+		/* 1. Interface clock, with the functional clock only when the prescaler uses it */
+		pccSrc = (ConfigPtr->clockSrc == LPTMR_CLK_PCC) ? ConfigPtr->pccClkSrc : CLK_SRC_OFF;
+		if (Lptmr_ClockHeld != 0u)
+		{
+			(void)ClockGate_Release(LPTMR0_CLK);
+			Lptmr_ClockHeld = 0u;
+		}
+		if (ClockGate_Request(LPTMR0_CLK, pccSrc) != CLOCKGATE_OK)
+		{
+			return LPTMR_ERR_PARA;
+		}
+		Lptmr_ClockHeld = 1u;
+		Lptmr_Config = ConfigPtr;
+
+		/* 2. Disable the timer: clears the counter and the compare flag */
+		LPTMR0->CSR = RESET;
+
+		/* 3. Prescaler and compare value, only writable while disabled */
+		LPTMR0->PSR = ((unsigned int)ConfigPtr->clockSrc << LPTMR_PSR_PCS_SHIFT) |
+		              ((unsigned int)(ConfigPtr->prescalerBypass != 0u) << LPTMR_PSR_PBYP_SHIFT) |
+		              ((unsigned int)ConfigPtr->prescaler << LPTMR_PSR_PRESCALE_SHIFT);
+		LPTMR0->CMR = ConfigPtr->compareValue;
+
+		/* 4. Control register, still disabled */
+		LPTMR0->CSR = ((unsigned int)ConfigPtr->mode << LPTMR_CSR_TMS_SHIFT) |
+		              ((unsigned int)(ConfigPtr->freeRunning != 0u) << LPTMR_CSR_TFC_SHIFT) |
+		              ((unsigned int)ConfigPtr->pinPolarity << LPTMR_CSR_TPP_SHIFT) |
+		              ((unsigned int)ConfigPtr->pinSelect << LPTMR_CSR_TPS_SHIFT) |
+		              ((unsigned int)(ConfigPtr->interruptEnable != 0u) << LPTMR_CSR_TIE_SHIFT);
+
+		return LPTMR_OK;
+}
+
+/*!
+ * @brief Stops the LPTMR and releases its clock gate.
+ *
+ * @return void.
+ */
+void Lptmr_Deinit(void)
+{
+		if (Lptmr_ClockHeld != 0u)
+		{
+			LPTMR0->CSR = RESET;
+			(void)ClockGate_Release(LPTMR0_CLK);
+			Lptmr_ClockHeld = 0u;
+		}
+		Lptmr_Config = NULL;
+}
+
+/*!
+ * @brief Starts the LPTMR.
+ *
+ * @return void.
+ */
+void Lptmr_Start(void)
+{
+		LPTMR0->CSR = LPTMR_CSR_KEEP_FLAG(LPTMR0->CSR) | ((unsigned int)ENABLEMENT << LPTMR_CSR_TEN_SHIFT);
+}
+
+/*!
+ * @brief Stops the LPTMR. The counter and the compare flag are cleared.
+ *
+ * @return void.
+ */
+void Lptmr_Stop(void)
+{
+		LPTMR0->CSR = LPTMR_CSR_KEEP_FLAG(LPTMR0->CSR) & ~((unsigned int)ENABLEMENT << LPTMR_CSR_TEN_SHIFT);
+}
+
+/*!
+ * @brief Changes the compare value.
+ *
+ * @param[in] compareValue New compare value.
+ * @return LPTMR_OK on success, LPTMR_ERR_BUSY when the timer runs and the compare flag is clear.
+ * @note While running, the compare value may only change after a match, e.g. in the callback.
+ */
+Lptmr_ret_t Lptmr_SetCompare(unsigned short compareValue)
+{
+		unsigned int csr = LPTMR0->CSR;
+
+		if ((((csr >> LPTMR_CSR_TEN_SHIFT) & VALUE_CHECK_BIT) != 0u) &&
+		    (((csr >> LPTMR_CSR_TCF_SHIFT) & VALUE_CHECK_BIT) == 0u))
+		{
+			return LPTMR_ERR_BUSY;
+		}
+
+		LPTMR0->CMR = compareValue;
+		return LPTMR_OK;
+}
+
+/*!
+ * @brief Reads the counter.
+ *
+ * @return Current counter value.
+ */
+unsigned short Lptmr_GetCounter(void)
+{
+		/* A write latches the counter into CNR */
+		LPTMR0->CNR = RESET;
+		return (unsigned short)(LPTMR0->CNR & LPTMR_CNR_MAX);
+}
+
+/*!
+ * @brief Checks the compare flag.
+ *
+ * @return 1 when the counter matched the compare value, 0 otherwise.
+ */
+unsigned char Lptmr_GetCompareFlag(void)
+{
+		return (unsigned char)((LPTMR0->CSR >> LPTMR_CSR_TCF_SHIFT) & VALUE_CHECK_BIT);
+}
+
+/*!
+ * @brief Clears the compare flag.
+ *
+ * @return void.
+ */
+void Lptmr_ClearCompareFlag(void)
+{
+		/* The flag is set in the value read, so writing it back clears it */
+		LPTMR0->CSR = LPTMR0->CSR;
+}
+
+/*!
+ * @brief Gets the counting frequency in time-counter mode.
+ *
+ * @return Frequency of the counter in Hz after the prescaler, 0 in pulse-counter mode.
+ */
+unsigned int Lptmr_GetCountFreq(void)
+{
+		unsigned int freq;
+
+		if ((Lptmr_Config == NULL) || (Lptmr_Config->mode != LPTMR_MODE_TIMER))
+		{
+			return 0u;
+		}
+
+		switch (Lptmr_Config->clockSrc)
+		{
+			case LPTMR_CLK_SIRCDIV2:
+				freq = Clock_GetFreq(CLOCK_FREQ_SIRCDIV2);
+				break;
+			case LPTMR_CLK_LPO1K:
+				freq = LPTMR_LPO1K_FREQ_HZ;
+				break;
+			case LPTMR_CLK_RTC:
+				freq = (Lptmr_Config->rtcClockHz != 0u) ? Lptmr_Config->rtcClockHz : LPTMR_RTC_CLK_FREQ_HZ;
+				break;
+			case LPTMR_CLK_PCC:
+			default:
+				freq = Clock_GetPccFunctionalFreq(LPTMR0_CLK);
+				break;
+		}
+
+		if (Lptmr_Config->prescalerBypass == 0u)
+		{
+			freq >>= ((unsigned int)Lptmr_Config->prescaler + 1u);
+		}
+
+		return freq;
+}
+
+/*!
+ * @brief LPTMR0 interrupt handler.
+ *
+ * Clears the compare flag and calls the configured callback.
+ *
+ * @return void.
+ */
+void LPTMR0_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPTMR0_IRQn);
+		TRACE_ISR_ENTER(LPTMR0_IRQn);
+		Lptmr_ClearCompareFlag();
+
+		if ((Lptmr_Config != NULL) && (Lptmr_Config->callback != NULL))
+		{
+			Lptmr_Config->callback();
+		}
+		TRACE_ISR_EXIT(LPTMR0_IRQn);
+}
@@ -0,0 +1,710 @@
+/****************************************************************************************************
+* @file    Lpuart.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the LPUART driver.
+* @details This file derives the baud rate settings from the functional clock, and moves bytes
+*          between the FIFOs and the ring buffers in the interrupt. With DMA transmission the
+*          contiguous part of the transmit ring is sent as one DMA transfer and the next one is
+*          started from the transmission complete interrupt.
+* @version 1.0.0
+* @date    2024-11-04
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpuart.h"
+#include "ClockGate.h"
+#include "Dma.h"
+#include "Cpu.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define LPUART_BIT(SHIFT)              ((unsigned int)ENABLEMENT << (SHIFT))
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Run-time state of an LPUART instance.
+ */
+typedef struct
+{
+			const Lpuart_ConfigType *   config;         /*!< Active configuration, NULL when stopped */
+			Ring_Type                   rxRing;         /*!< Producer: interrupt, consumer: application */
+			Ring_Type                   txRing;         /*!< Producer: application, consumer: interrupt */
+			volatile unsigned short     txInFlight;     /*!< Bytes handed to the DMA and not consumed yet */
+			volatile unsigned int       rxBytes;
+			volatile unsigned int       txBytes;
+			volatile unsigned int       rxDropped;
+			volatile unsigned int       rxErrors;
+} Lpuart_StateType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static LPUART_Type * const Lpuart_Bases[LPUART_INSTANCE_COUNT] = { LPUART0, LPUART1, LPUART2 };
+static const clock_names_t Lpuart_Clocks[LPUART_INSTANCE_COUNT] = { LPUART0_CLK, LPUART1_CLK, LPUART2_CLK };
+static const unsigned char Lpuart_DmaTxSources[LPUART_INSTANCE_COUNT] =
+{
+		DMA_SOURCE_LPUART0_TX, DMA_SOURCE_LPUART1_TX, DMA_SOURCE_LPUART2_TX
+};
+
+static Lpuart_StateType Lpuart_State[LPUART_INSTANCE_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Computes the BAUD register for a baud rate.
+ *
+ * Every oversampling ratio from 4x to 32x is tried and the one with the smallest error kept;
+ * on a tie the higher ratio wins for better noise immunity.
+ */
+static Lpuart_ret_t Lpuart_CalcBaud(const Lpuart_ConfigType * ConfigPtr, unsigned int * BaudPtr)
+{
+		unsigned int clockHz = Clock_GetPccFunctionalFreq(Lpuart_Clocks[ConfigPtr->instance]);
+		unsigned int osr;
+		unsigned int sbr;
+		unsigned int actual;
+		unsigned int error;
+		unsigned int bestError = 0xFFFFFFFFu;
+		unsigned int bestOsr = 0u;
+		unsigned int bestSbr = 0u;
+		unsigned int baud;
+
+		if ((clockHz == 0u) || (ConfigPtr->baudRate == 0u))
+		{
+			return LPUART_ERR_BAUD;
+		}
+
+		for (osr = LPUART_BAUD_OSR_MIN; osr <= LPUART_BAUD_OSR_MAX; osr++)
+		{
+			sbr = (clockHz + ((ConfigPtr->baudRate * (osr + 1u)) / 2u)) / (ConfigPtr->baudRate * (osr + 1u));
+			if ((sbr == 0u) || (sbr > LPUART_BAUD_SBR_MAX))
+			{
+				continue;
+			}
+			actual = clockHz / ((osr + 1u) * sbr);
+			error = (actual > ConfigPtr->baudRate) ? (actual - ConfigPtr->baudRate) : (ConfigPtr->baudRate - actual);
+			if (error <= bestError)
+			{
+				bestError = error;
+				bestOsr = osr;
+				bestSbr = sbr;
+			}
+		}
+		if ((bestSbr == 0u) || ((bestError * 100u) > (ConfigPtr->baudRate * LPUART_BAUD_TOLERANCE_PERCENT)))
+		{
+			return LPUART_ERR_BAUD;
+		}
+
+		baud = (bestSbr << LPUART_BAUD_SBR_SHIFT) | (bestOsr << LPUART_BAUD_OSR_SHIFT) |
+		       ((unsigned int)(ConfigPtr->twoStopBits != 0u) << LPUART_BAUD_SBNS_SHIFT) |
+		       ((unsigned int)(ConfigPtr->txDma != 0u) << LPUART_BAUD_TDMAE_SHIFT);
+		if (bestOsr <= LPUART_BAUD_OSR_BOTHEDGE)
+		{
+			baud |= LPUART_BIT(LPUART_BAUD_BOTHEDGE_SHIFT);
+		}
+
+		*BaudPtr = baud;
+		return LPUART_OK;
+}
+
+/*!
+ * @brief Starts or continues the transmission of the transmit ring.
+ *
+ * Called with interrupts of the instance masked: from the interrupt or a critical section.
+ */
+static void Lpuart_StartTx(unsigned char instance)
+{
+		Lpuart_StateType * state = &Lpuart_State[instance];
+		LPUART_Type * uart = Lpuart_Bases[instance];
+		unsigned char * data;
+		unsigned short length;
+
+		if (state->config->txDma == 0u)
+		{
+			if (Ring_GetUsed(&state->txRing) != 0u)
+			{
+				uart->CTRL |= LPUART_BIT(LPUART_CTRL_TIE_SHIFT);
+			}
+			return;
+		}
+
+		if (state->txInFlight != 0u)
+		{
+			return;
+		}
+
+		/* At most half the ring per transfer, so the application can refill the other half */
+		length = Ring_PeekLinear(&state->txRing, &data);
+		if (length > (unsigned short)(state->txRing.size / 2u))
+		{
+			length = (unsigned short)(state->txRing.size / 2u);
+		}
+		if (length > DMA_MAJOR_COUNT_MAX)
+		{
+			length = DMA_MAJOR_COUNT_MAX;
+		}
+		if ((length == 0u) ||
+		    (Dma_SetTransfer(state->config->dmaChannel, (unsigned int)data, (unsigned int)&uart->DATA, length) != DMA_OK))
+		{
+			uart->CTRL &= ~LPUART_BIT(LPUART_CTRL_TCIE_SHIFT);
+			return;
+		}
+
+		state->txInFlight = length;
+		Dma_StartChannel(state->config->dmaChannel);
+		uart->CTRL |= LPUART_BIT(LPUART_CTRL_TCIE_SHIFT);
+}
+
+/*!
+ * @brief Common interrupt handler.
+ */
+static void Lpuart_IrqCommon(unsigned char instance)
+{
+		Lpuart_StateType * state = &Lpuart_State[instance];
+		LPUART_Type * uart = Lpuart_Bases[instance];
+		unsigned int stat;
+		unsigned int ctrl;
+		unsigned char * data;
+		unsigned char byte;
+
+		if (state->config == NULL)
+		{
+			return;
+		}
+
+		stat = uart->STAT;
+		ctrl = uart->CTRL;
+
+		/* 1. Receive errors: count and clear */
+		if ((stat & LPUART_STAT_ERRORS_MASK) != 0u)
+		{
+			uart->STAT = stat & LPUART_STAT_ERRORS_MASK;
+			state->rxErrors++;
+		}
+
+		/* 2. Drain the receive FIFO */
+		while (((uart->WATER >> LPUART_WATER_RXCOUNT_SHIFT) & LPUART_WATER_COUNT_MASK) != 0u)
+		{
+			byte = (unsigned char)uart->DATA;
+			if (Ring_WriteLinear(&state->rxRing, &data) != 0u)
+			{
+				*data = byte;
+				Ring_Commit(&state->rxRing, 1u);
+				state->rxBytes++;
+			}
+			else
+			{
+				state->rxDropped++;
+			}
+		}
+
+		/* 3. Idle line: end of a burst */
+		if (((stat >> LPUART_STAT_IDLE_SHIFT) & VALUE_CHECK_BIT) != 0u)
+		{
+			uart->STAT = LPUART_BIT(LPUART_STAT_IDLE_SHIFT);
+			if (state->config->idleCallback != NULL)
+			{
+				state->config->idleCallback(instance);
+			}
+		}
+
+		/* 4. Interrupt transmission: refill the FIFO up to its depth */
+		if ((((ctrl >> LPUART_CTRL_TIE_SHIFT) & VALUE_CHECK_BIT) != 0u) &&
+		    (((stat >> LPUART_STAT_TDRE_SHIFT) & VALUE_CHECK_BIT) != 0u))
+		{
+			while ((((uart->WATER >> LPUART_WATER_TXCOUNT_SHIFT) & LPUART_WATER_COUNT_MASK) < LPUART_FIFO_DEPTH) &&
+			       (Ring_PeekLinear(&state->txRing, &data) != 0u))
+			{
+				uart->DATA = *data;
+				Ring_Consume(&state->txRing, 1u);
+				state->txBytes++;
+			}
+			if (Ring_GetUsed(&state->txRing) == 0u)
+			{
+				uart->CTRL &= ~LPUART_BIT(LPUART_CTRL_TIE_SHIFT);
+			}
+		}
+
+		/* 5. DMA transmission: the transfer is finished once the line is idle */
+		if ((((ctrl >> LPUART_CTRL_TCIE_SHIFT) & VALUE_CHECK_BIT) != 0u) &&
+		    (((stat >> LPUART_STAT_TC_SHIFT) & VALUE_CHECK_BIT) != 0u) &&
+		    (state->txInFlight != 0u) && (Dma_IsDone(state->config->dmaChannel) != 0u))
+		{
+			Ring_Consume(&state->txRing, state->txInFlight);
+			state->txBytes += state->txInFlight;
+			state->txInFlight = 0u;
+			Lpuart_StartTx(instance);
+		}
+}
+
+/*!
+ * @brief Starts the transmission from thread context.
+ */
+static void Lpuart_Kick(unsigned char instance)
+{
+		unsigned int primask = Cpu_EnterCritical();
+
+		Lpuart_StartTx(instance);
+		Cpu_ExitCritical(primask);
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes an LPUART instance.
+ *
+ * The baud rate settings are derived from the PCC functional clock frequency.
+ *
+ * @param[in] ConfigPtr Pointer to the LPUART configuration structure.
+ * @return LPUART_OK on success, LPUART_ERR_PARA or LPUART_ERR_BAUD on error.
+ * @note Enable LPUARTn_RxTx_IRQn in the NVIC.
+ */
+Lpuart_ret_t Lpuart_Init(const Lpuart_ConfigType * ConfigPtr)
+{
+		Lpuart_StateType * state;
+		LPUART_Type * uart;
+		Dma_ChannelConfigType dma;
+		unsigned int baud;
+		unsigned int ctrl;
+		Lpuart_ret_t ret;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= LPUART_INSTANCE_COUNT) ||
+		    (ConfigPtr->clkSrc == CLK_SRC_OFF) || (ConfigPtr->parity > LPUART_PARITY_ODD) ||
+		    (ConfigPtr->rxWatermark > LPUART_WATER_MAX) || (ConfigPtr->txWatermark > LPUART_WATER_MAX) ||
+		    (ConfigPtr->idleConfig > LPUART_IDLECFG_MAX) ||
+		    ((ConfigPtr->txDma != 0u) && (ConfigPtr->dmaChannel >= DMA_CHANNEL_COUNT)))
+		{
+			return LPUART_ERR_PARA;
+		}
+
+		state = &Lpuart_State[ConfigPtr->instance];
+		uart = Lpuart_Bases[ConfigPtr->instance];
+		if ((Ring_Init(&state->rxRing, ConfigPtr->rxBuffer, ConfigPtr->rxBufferSize) == 0u) ||
+		    (Ring_Init(&state->txRing, ConfigPtr->txBuffer, ConfigPtr->txBufferSize) == 0u))
+		{
+			return LPUART_ERR_PARA;
+		}
+
+		/* 1. Clock */
+		if (state->config == NULL)
+		{
+			if (ClockGate_Request(Lpuart_Clocks[ConfigPtr->instance], ConfigPtr->clkSrc) != CLOCKGATE_OK)
+			{
+				return LPUART_ERR_PARA;
+			}
+		}
+		state->config = ConfigPtr;
+
+		ret = Lpuart_CalcBaud(ConfigPtr, &baud);
+		if (ret != LPUART_OK)
+		{
+			Lpuart_Deinit(ConfigPtr->instance);
+			return ret;
+		}
+
+		state->txInFlight = 0u;
+		state->rxBytes = 0u;
+		state->txBytes = 0u;
+		state->rxDropped = 0u;
+		state->rxErrors = 0u;
+
+		/* 2. Reset the module, then baud rate, FIFOs and watermarks */
+		uart->GLOBAL = LPUART_BIT(LPUART_GLOBAL_RST_SHIFT);
+		uart->GLOBAL = RESET;
+		uart->BAUD = baud;
+		uart->FIFO = LPUART_BIT(LPUART_FIFO_RXFE_SHIFT) | LPUART_BIT(LPUART_FIFO_TXFE_SHIFT) |
+		             LPUART_BIT(LPUART_FIFO_RXFLUSH_SHIFT) | LPUART_BIT(LPUART_FIFO_TXFLUSH_SHIFT);
+		uart->WATER = ((unsigned int)ConfigPtr->txWatermark << LPUART_WATER_TXWATER_SHIFT) |
+		              ((unsigned int)ConfigPtr->rxWatermark << LPUART_WATER_RXWATER_SHIFT);
+
+		/* 3. DMA channel for transmission, addresses set per transfer */
+		if (ConfigPtr->txDma != 0u)
+		{
+			Dma_Init();
+			dma.channel = ConfigPtr->dmaChannel;
+			dma.source = Lpuart_DmaTxSources[ConfigPtr->instance];
+			dma.periodicTrigger = 0u;
+			dma.circular = 0u;
+			dma.srcAddr = (unsigned int)ConfigPtr->txBuffer;
+			dma.srcOffset = 1;
+			dma.srcSize = DMA_SIZE_8BIT;
+			dma.srcLastAdjust = 0;
+			dma.destAddr = (unsigned int)&uart->DATA;
+			dma.destOffset = 0;
+			dma.destSize = DMA_SIZE_8BIT;
+			dma.destLastAdjust = 0;
+			dma.minorBytes = 1u;
+			dma.majorCount = 1u;
+			if (Dma_ConfigChannel(&dma) != DMA_OK)
+			{
+				Lpuart_Deinit(ConfigPtr->instance);
+				return LPUART_ERR_PARA;
+			}
+		}
+
+		/* 4. Frame format, receive interrupts, enable */
+		ctrl = LPUART_BIT(LPUART_CTRL_ILT_SHIFT) |
+		       ((unsigned int)ConfigPtr->idleConfig << LPUART_CTRL_IDLECFG_SHIFT) |
+		       LPUART_BIT(LPUART_CTRL_RIE_SHIFT) | LPUART_BIT(LPUART_CTRL_ILIE_SHIFT) |
+		       LPUART_BIT(LPUART_CTRL_ORIE_SHIFT) |
+		       LPUART_BIT(LPUART_CTRL_RE_SHIFT) | LPUART_BIT(LPUART_CTRL_TE_SHIFT);
+		if (ConfigPtr->parity != LPUART_PARITY_NONE)
+		{
+			/* 9-bit frame: 8 data bits and the parity bit */
+			ctrl |= LPUART_BIT(LPUART_CTRL_M_SHIFT) | LPUART_BIT(LPUART_CTRL_PE_SHIFT) |
+			        ((unsigned int)(ConfigPtr->parity == LPUART_PARITY_ODD) << LPUART_CTRL_PT_SHIFT);
+		}
+		uart->CTRL = ctrl;
+
+		return LPUART_OK;
+}
+
+/*!
+ * @brief Disables an LPUART instance and releases its clock.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return void.
+ */
+void Lpuart_Deinit(unsigned char instance)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Lpuart_Bases[instance]->CTRL = RESET;
+		if (Lpuart_State[instance].config->txDma != 0u)
+		{
+			Dma_StopChannel(Lpuart_State[instance].config->dmaChannel);
+		}
+		(void)ClockGate_Release(Lpuart_Clocks[instance]);
+		Lpuart_State[instance].config = NULL;
+}
+
+/*!
+ * @brief Recomputes the baud rate settings after the functional clock changed.
+ *
+ * BAUD may only be written with the transmitter and receiver disabled.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return LPUART_OK on success, LPUART_ERR_PARA or LPUART_ERR_BAUD on error.
+ * @note Call from a Perf post-change callback; a frame on the line during the change may be lost.
+ */
+Lpuart_ret_t Lpuart_Retune(unsigned char instance)
+{
+		LPUART_Type * uart;
+		unsigned int baud;
+		unsigned int ctrl;
+		unsigned int primask;
+		Lpuart_ret_t ret;
+
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return LPUART_ERR_PARA;
+		}
+
+		ret = Lpuart_CalcBaud(Lpuart_State[instance].config, &baud);
+		if (ret != LPUART_OK)
+		{
+			return ret;
+		}
+
+		uart = Lpuart_Bases[instance];
+		primask = Cpu_EnterCritical();
+		ctrl = uart->CTRL;
+		uart->CTRL = ctrl & ~(LPUART_BIT(LPUART_CTRL_RE_SHIFT) | LPUART_BIT(LPUART_CTRL_TE_SHIFT));
+		uart->BAUD = baud;
+		uart->CTRL = ctrl;
+		Cpu_ExitCritical(primask);
+
+		return LPUART_OK;
+}
+
+/*!
+ * @brief Copies data into the transmit ring and starts the transmission.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] DataPtr Data to send.
+ * @param[in] length Number of bytes.
+ * @return Number of bytes accepted, less than length when the ring is full.
+ */
+unsigned short Lpuart_Write(unsigned char instance, const unsigned char * DataPtr, unsigned short length)
+{
+		Lpuart_StateType * state;
+		unsigned char * dest;
+		unsigned short linear;
+		unsigned short index;
+		unsigned short written = 0u;
+
+		if ((DataPtr == NULL) || (instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		state = &Lpuart_State[instance];
+
+		/* At most two contiguous parts, before and after the wrap */
+		while (written < length)
+		{
+			linear = Ring_WriteLinear(&state->txRing, &dest);
+			if (linear == 0u)
+			{
+				break;
+			}
+			if (linear > (length - written))
+			{
+				linear = (unsigned short)(length - written);
+			}
+			for (index = 0u; index < linear; index++)
+			{
+				dest[index] = DataPtr[written + index];
+			}
+			Ring_Commit(&state->txRing, linear);
+			written = (unsigned short)(written + linear);
+		}
+
+		if (written != 0u)
+		{
+			Lpuart_Kick(instance);
+		}
+		return written;
+}
+
+/*!
+ * @brief Gets contiguous free space in the transmit ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr First free byte.
+ * @return Bytes that can be written at *DataPtr.
+ */
+unsigned short Lpuart_WriteBegin(unsigned char instance, unsigned char ** DataPtr)
+{
+		if ((DataPtr == NULL) || (instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		return Ring_WriteLinear(&Lpuart_State[instance].txRing, DataPtr);
+}
+
+/*!
+ * @brief Gets the free space in the transmit ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return Bytes Lpuart_Write() accepts without truncating.
+ */
+unsigned short Lpuart_GetTxFree(unsigned char instance)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		return Ring_GetFree(&Lpuart_State[instance].txRing);
+}
+
+/*!
+ * @brief Queues bytes written after Lpuart_WriteBegin() and starts the transmission.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] count Bytes written, at most the value returned by Lpuart_WriteBegin().
+ * @return void.
+ */
+void Lpuart_WriteCommit(unsigned char instance, unsigned short count)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL) || (count == 0u))
+		{
+			return;
+		}
+
+		Ring_Commit(&Lpuart_State[instance].txRing, count);
+		Lpuart_Kick(instance);
+}
+
+/*!
+ * @brief Checks whether everything queued was sent.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return 1 when the ring is empty and the transmitter is idle, 0 otherwise.
+ */
+unsigned char Lpuart_IsTxIdle(unsigned char instance)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 1u;
+		}
+
+		return ((Ring_GetUsed(&Lpuart_State[instance].txRing) == 0u) &&
+		        (((Lpuart_Bases[instance]->STAT >> LPUART_STAT_TC_SHIFT) & VALUE_CHECK_BIT) != 0u)) ? 1u : 0u;
+}
+
+/*!
+ * @brief Gets contiguous received data without copying it.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr First unread byte.
+ * @return Bytes readable at *DataPtr; more may follow after Lpuart_Consume().
+ */
+unsigned short Lpuart_Peek(unsigned char instance, unsigned char ** DataPtr)
+{
+		if ((DataPtr == NULL) || (instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		return Ring_PeekLinear(&Lpuart_State[instance].rxRing, DataPtr);
+}
+
+/*!
+ * @brief Gets the number of received bytes not consumed yet.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @return Unread bytes; larger than the Lpuart_Peek() count when the data wraps the ring.
+ */
+unsigned short Lpuart_GetRxCount(unsigned char instance)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return 0u;
+		}
+
+		return Ring_GetUsed(&Lpuart_State[instance].rxRing);
+}
+
+/*!
+ * @brief Releases received bytes.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[in] count Bytes to release, at most the value returned by Lpuart_Peek().
+ * @return void.
+ */
+void Lpuart_Consume(unsigned char instance, unsigned short count)
+{
+		if ((instance >= LPUART_INSTANCE_COUNT) || (Lpuart_State[instance].config == NULL))
+		{
+			return;
+		}
+
+		Ring_Consume(&Lpuart_State[instance].rxRing, count);
+}
+
+/*!
+ * @brief Copies received data out of the receive ring.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] DataPtr Destination.
+ * @param[in] maxLength Largest number of bytes to copy.
+ * @return Number of bytes copied.
+ */
+unsigned short Lpuart_Read(unsigned char instance, unsigned char * DataPtr, unsigned short maxLength)
+{
+		unsigned char * src;
+		unsigned short linear;
+		unsigned short index;
+		unsigned short copied = 0u;
+
+		if (DataPtr == NULL)
+		{
+			return 0u;
+		}
+
+		while (copied < maxLength)
+		{
+			linear = Lpuart_Peek(instance, &src);
+			if (linear == 0u)
+			{
+				break;
+			}
+			if (linear > (maxLength - copied))
+			{
+				linear = (unsigned short)(maxLength - copied);
+			}
+			for (index = 0u; index < linear; index++)
+			{
+				DataPtr[copied + index] = src[index];
+			}
+			Lpuart_Consume(instance, linear);
+			copied = (unsigned short)(copied + linear);
+		}
+
+		return copied;
+}
+
+/*!
+ * @brief Retrieves the statistics of an LPUART instance.
+ *
+ * @param[in] instance LPUART instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return LPUART_OK on success, LPUART_ERR_PARA on parameter error.
+ */
+Lpuart_ret_t Lpuart_GetStats(unsigned char instance, Lpuart_StatsType * StatsPtr)
+{
+		Lpuart_StateType * state;
+
+		if ((StatsPtr == NULL) || (instance >= LPUART_INSTANCE_COUNT))
+		{
+			return LPUART_ERR_PARA;
+		}
+
+		state = &Lpuart_State[instance];
+		StatsPtr->rxBytes = state->rxBytes;
+		StatsPtr->txBytes = state->txBytes;
+		StatsPtr->rxDropped = state->rxDropped;
+		StatsPtr->rxErrors = state->rxErrors;
+
+		return LPUART_OK;
+}
+
+/*!
+ * @brief LPUART0 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART0_RxTx_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPUART0_RxTx_IRQn);
+		TRACE_ISR_ENTER(LPUART0_RxTx_IRQn);
+		Lpuart_IrqCommon(0u);
+		TRACE_ISR_EXIT(LPUART0_RxTx_IRQn);
+}
+
+/*!
+ * @brief LPUART1 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART1_RxTx_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPUART1_RxTx_IRQn);
+		TRACE_ISR_ENTER(LPUART1_RxTx_IRQn);
+		Lpuart_IrqCommon(1u);
+		TRACE_ISR_EXIT(LPUART1_RxTx_IRQn);
+}
+
+/*!
+ * @brief LPUART2 interrupt handler.
+ *
+ * @return void.
+ */
+void LPUART2_RxTx_IRQHandler(void)
+{
+		STACK_ISR_ENTER(LPUART2_RxTx_IRQn);
+		TRACE_ISR_ENTER(LPUART2_RxTx_IRQn);
+		Lpuart_IrqCommon(2u);
+		TRACE_ISR_EXIT(LPUART2_RxTx_IRQn);
+}
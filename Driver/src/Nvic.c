@@ -33,7 +33,7 @@
 void NVIC_EnableInterrupt(IRQn_Type IRQ_number)
 {
 	/* Check parameter */
-	NVIC_ISER->ISER[IRQ_number/32] = (1<<(IRQ_number%32));
+	REG_WRITE(NVIC_ISER->ISER[(unsigned int)IRQ_number / 32u], FIELD_SET(NVIC_IRQ(IRQ_number), 1u));
 }
 
 /**
@@ -52,7 +52,7 @@ void NVIC_EnableInterrupt(IRQn_Type IRQ_number)
 void NVIC_DisableInterrupt(IRQn_Type IRQ_number)
 {
 	/* Check parameter */
-	NVIC_ICER->ICER[IRQ_number/32] = (1<<(IRQ_number%32));
+	REG_WRITE(NVIC_ICER->ICER[(unsigned int)IRQ_number / 32u], FIELD_SET(NVIC_IRQ(IRQ_number), 1u));
 }
 
 /**
@@ -73,7 +73,7 @@ void NVIC_DisableInterrupt(IRQn_Type IRQ_number)
 void NVIC_ClearPendingFlag(IRQn_Type IRQ_number)
 {
 	/* Check parameter */
-	NVIC_ICPR->ICPR[IRQ_number/32] = (1<<(IRQ_number%32));
+	REG_WRITE(NVIC_ICPR->ICPR[(unsigned int)IRQ_number / 32u], FIELD_SET(NVIC_IRQ(IRQ_number), 1u));
 }
 
 
@@ -96,8 +96,8 @@ void NVIC_ClearPendingFlag(IRQn_Type IRQ_number)
  */
 void NVIC_SetPriority(IRQn_Type IRQ_number, unsigned char priority)
 {
-	/* Check parameter */
-	NVIC_IPR->IPR[IRQ_number / 4] = ((priority & 0xFFu) << ((IRQ_number % 4) * 8 + 4));
+	/* One byte store: the priorities of the other three interrupts of the word are not read */
+	NVIC_IP->IP[IRQ_number] = (unsigned char)FIELD_VAL(NVIC_IP_PRI, priority);
 }
 
 
@@ -0,0 +1,432 @@
+/****************************************************************************************************
+* @file    Perf.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of runtime performance level control.
+* @details This file switches the SMC run mode together with the SCG clock control registers and
+*          notifies registered callbacks around every step. VLPR is entered by moving the system
+*          clock to SIRC and stopping the SPLL and FIRC; leaving VLPR restarts and relocks them.
+* @version 1.0.0
+* @date    2024-10-26
+* @note    Call these functions from thread context only; they poll for mode transitions.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Perf.h"
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Registered callback.
+ */
+typedef struct
+{
+			Perf_CallbackType   callback;       /*!< Callback function */
+			void *              userData;       /*!< Passed back to the callback */
+} Perf_CallbackEntryType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Perf_ConfigType *  Perf_Config;                            /* Active configuration */
+static Perf_CallbackEntryType   Perf_Callbacks[PERF_MAX_CALLBACKS];     /* Registered callbacks */
+static unsigned char            Perf_CallbackCount;                     /* Number of callbacks */
+static Perf_level_t             Perf_Level = PERF_LEVEL_RUN;            /* Current level */
+static unsigned int             Perf_BoostCount;                        /* Outstanding boost requests */
+static Perf_FreqType            Perf_LevelFreq[PERF_LEVEL_HSRUN + 1u];  /* Frequencies per level */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Computes the frequencies selected by a clock control register setting.
+ */
+static void Perf_CalcFreq(unsigned int scs, unsigned int coreDiv, unsigned int busDiv, unsigned int slowDiv,
+                          const Scg_Spll_ConfigType * SpllPtr, Perf_FreqType * FreqPtr)
+{
+		unsigned int src;
+
+		switch (scs)
+		{
+			case SOSC_CLK: src = CLOCK_SOSC_FREQ_HZ; break;
+			case SIRC_CLK: src = CLOCK_SIRC_HIGH_FREQ_HZ; break;
+			case FIRC_CLK: src = CLOCK_FIRC_FREQ_HZ; break;
+			case SPLL_CLK: src = Clock_CalcSpllFreq(SpllPtr); break;
+			default: src = 0u; break;
+		}
+
+		FreqPtr->coreHz = src / (coreDiv + 1u);
+		FreqPtr->busHz  = FreqPtr->coreHz / (busDiv + 1u);
+		FreqPtr->slowHz = FreqPtr->coreHz / (slowDiv + 1u);
+}
+
+/*!
+ * @brief Checks frequencies against the limits of a power mode.
+ */
+static unsigned char Perf_WithinLimits(const Perf_FreqType * FreqPtr, unsigned int maxCore,
+                                       unsigned int maxBus, unsigned int maxSlow)
+{
+		return (unsigned char)((FreqPtr->coreHz != 0u) && (FreqPtr->coreHz <= maxCore) &&
+		                       (FreqPtr->busHz <= maxBus) && (FreqPtr->slowHz <= maxSlow));
+}
+
+/*!
+ * @brief Calls every registered callback.
+ */
+static void Perf_Notify(Perf_notify_t notify, const Perf_FreqType * FreqPtr)
+{
+		unsigned char i;
+
+		for (i = 0u; i < Perf_CallbackCount; i++)
+		{
+			Perf_Callbacks[i].callback(notify, FreqPtr, Perf_Callbacks[i].userData);
+		}
+}
+
+/*!
+ * @brief Notifies the frequencies actually in use after a step.
+ */
+static void Perf_NotifyActual(void)
+{
+		Perf_FreqType freq;
+
+		freq.coreHz = Clock_GetFreq(CLOCK_FREQ_CORE);
+		freq.busHz  = Clock_GetFreq(CLOCK_FREQ_BUS);
+		freq.slowHz = Clock_GetFreq(CLOCK_FREQ_SLOW);
+		Perf_Notify(PERF_NOTIFY_POST_CHANGE, &freq);
+}
+
+/*!
+ * @brief Requests a run mode and waits, bounded, until the SMC reports it.
+ */
+static Perf_ret_t Perf_SwitchRunMode(unsigned int runm, unsigned int pmstat)
+{
+		unsigned int loops = PERF_WAIT_LOOPS;
+
+		SMC->PMCTRL = (SMC->PMCTRL & ~(SMC_PMCTRL_RUNM_MASK << SMC_PMCTRL_RUNM_SHIFT)) |
+		              (runm << SMC_PMCTRL_RUNM_SHIFT);
+
+		while (SMC->PMSTAT != pmstat)
+		{
+			if (--loops == 0u)
+			{
+				return PERF_ERR_TIMEOUT;
+			}
+		}
+		return PERF_OK;
+}
+
+/*!
+ * @brief Waits, bounded, until the system clock source matches.
+ */
+static Perf_ret_t Perf_WaitSysClock(system_clock_source_t src)
+{
+		unsigned int loops = PERF_WAIT_LOOPS;
+
+		while (Clock_GetSysClockSource() != src)
+		{
+			if (--loops == 0u)
+			{
+				return PERF_ERR_TIMEOUT;
+			}
+		}
+		return PERF_OK;
+}
+
+/*!
+ * @brief Waits, bounded, until a clock valid flag is set.
+ */
+static Perf_ret_t Perf_WaitValid(unsigned char (*isValid)(void))
+{
+		unsigned int loops = PERF_WAIT_LOOPS;
+
+		while (isValid() == 0u)
+		{
+			if (--loops == 0u)
+			{
+				return PERF_ERR_TIMEOUT;
+			}
+		}
+		return PERF_OK;
+}
+
+/*!
+ * @brief RUN -> HSRUN. The SCG takes the system clock from HCCR.
+ */
+static Perf_ret_t Perf_EnterHsrun(void)
+{
+		Perf_ret_t ret;
+
+		Perf_Notify(PERF_NOTIFY_PRE_CHANGE, &Perf_LevelFreq[PERF_LEVEL_HSRUN]);
+		ret = Perf_SwitchRunMode(SMC_RUNM_HSRUN, SMC_PMSTAT_HSRUN);
+		if (ret == PERF_OK)
+		{
+			ret = Perf_WaitSysClock((system_clock_source_t)Perf_Config->hsrunConfig->sys_clk_src);
+		}
+		if (ret == PERF_OK)
+		{
+			Perf_Level = PERF_LEVEL_HSRUN;
+		}
+		Perf_NotifyActual();
+		return ret;
+}
+
+/*!
+ * @brief HSRUN -> RUN. The SCG takes the system clock from RCCR.
+ */
+static Perf_ret_t Perf_LeaveHsrun(void)
+{
+		Perf_ret_t ret;
+
+		Perf_Notify(PERF_NOTIFY_PRE_CHANGE, &Perf_LevelFreq[PERF_LEVEL_RUN]);
+		ret = Perf_SwitchRunMode(SMC_RUNM_RUN, SMC_PMSTAT_RUN);
+		if (ret == PERF_OK)
+		{
+			Perf_Level = PERF_LEVEL_RUN;
+		}
+		Perf_NotifyActual();
+		return ret;
+}
+
+/*!
+ * @brief RUN -> VLPR. SPLL and FIRC are not allowed in VLPR and are stopped first.
+ */
+static Perf_ret_t Perf_EnterVlpr(void)
+{
+		Perf_ret_t ret;
+
+		Perf_Notify(PERF_NOTIFY_PRE_CHANGE, &Perf_LevelFreq[PERF_LEVEL_VLPR]);
+
+		/* 1. Move the RUN system clock to SIRC so the fast clocks can be stopped */
+		Clock_WriteScgRunModeConfig(Perf_Config->runSircConfig);
+		ret = Perf_WaitSysClock(SIRC_CLK);
+		if (ret == PERF_OK)
+		{
+			/* 2. Stop SPLL and FIRC, bias the regulator for low power */
+			Clock_DisableScgSpll();
+			Clock_DisableScgFirc();
+			PMC->REGSC |= (unsigned char)(ENABLEMENT << PMC_REGSC_BIASEN_SHIFT);
+
+			/* 3. Enter VLPR, the SCG takes the system clock from VCCR */
+			ret = Perf_SwitchRunMode(SMC_RUNM_VLPR, SMC_PMSTAT_VLPR);
+		}
+		if (ret == PERF_OK)
+		{
+			Perf_Level = PERF_LEVEL_VLPR;
+		}
+		Perf_NotifyActual();
+		return ret;
+}
+
+/*!
+ * @brief VLPR -> RUN. FIRC and SPLL are restarted and the RUN configuration reapplied.
+ */
+static Perf_ret_t Perf_LeaveVlpr(void)
+{
+		Perf_ret_t ret;
+
+		Perf_Notify(PERF_NOTIFY_PRE_CHANGE, &Perf_LevelFreq[PERF_LEVEL_RUN]);
+
+		/* 1. Back to RUN, still on SIRC */
+		ret = Perf_SwitchRunMode(SMC_RUNM_RUN, SMC_PMSTAT_RUN);
+		if (ret == PERF_OK)
+		{
+			Perf_Level = PERF_LEVEL_RUN;
+
+			/* 2. Restart FIRC and relock the SPLL */
+			Clock_EnableScgFirc();
+			ret = Perf_WaitValid(Clock_IsScgFircValid);
+		}
+		if (ret == PERF_OK)
+		{
+			Clock_EnableScgSpll(Perf_Config->spllConfig);
+			ret = Perf_WaitValid(Clock_IsScgSpllValid);
+		}
+		if (ret == PERF_OK)
+		{
+			/* 3. Restore the RUN clocks */
+			Clock_WriteScgRunModeConfig(Perf_Config->runConfig);
+			ret = Perf_WaitSysClock(Perf_Config->runConfig->sys_clk_src);
+		}
+		Perf_NotifyActual();
+		return ret;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the performance level control.
+ *
+ * This function checks every level against the power mode limits, allows HSRUN and VLPR in the
+ * SMC and loads the HSRUN and VLPR clock control registers. The device must be in RUN mode
+ * with runConfig applied.
+ *
+ * @param[in] ConfigPtr Pointer to the performance configuration structure.
+ * @return PERF_OK on success, PERF_ERR_PARA on parameter error.
+ */
+Perf_ret_t Perf_Init(const Perf_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->spllConfig == NULL) || (ConfigPtr->runConfig == NULL) ||
+		    (ConfigPtr->runSircConfig == NULL) || (ConfigPtr->hsrunConfig == NULL) ||
+		    (ConfigPtr->vlprConfig == NULL) || (ConfigPtr->idleLevel > PERF_LEVEL_HSRUN) ||
+		    (ConfigPtr->runSircConfig->sys_clk_src != SIRC_CLK))
+		{
+			return PERF_ERR_PARA;
+		}
+
+		/* 1. Frequencies of every level, checked against the power mode limits */
+		Perf_CalcFreq((unsigned int)ConfigPtr->runConfig->sys_clk_src, (unsigned int)ConfigPtr->runConfig->core_div,
+		              (unsigned int)ConfigPtr->runConfig->bus_div, (unsigned int)ConfigPtr->runConfig->slow_div,
+		              ConfigPtr->spllConfig, &Perf_LevelFreq[PERF_LEVEL_RUN]);
+		Perf_CalcFreq((unsigned int)ConfigPtr->hsrunConfig->sys_clk_src, (unsigned int)ConfigPtr->hsrunConfig->core_div,
+		              (unsigned int)ConfigPtr->hsrunConfig->bus_div, (unsigned int)ConfigPtr->hsrunConfig->slow_div,
+		              ConfigPtr->spllConfig, &Perf_LevelFreq[PERF_LEVEL_HSRUN]);
+		Perf_CalcFreq((unsigned int)ConfigPtr->vlprConfig->sys_clk_src, (unsigned int)ConfigPtr->vlprConfig->core_div,
+		              (unsigned int)ConfigPtr->vlprConfig->bus_div, (unsigned int)ConfigPtr->vlprConfig->slow_div,
+		              ConfigPtr->spllConfig, &Perf_LevelFreq[PERF_LEVEL_VLPR]);
+
+		if ((Perf_WithinLimits(&Perf_LevelFreq[PERF_LEVEL_RUN], PERF_RUN_MAX_CORE_HZ, PERF_RUN_MAX_BUS_HZ, PERF_RUN_MAX_SLOW_HZ) == 0u) ||
+		    (Perf_WithinLimits(&Perf_LevelFreq[PERF_LEVEL_HSRUN], PERF_HSRUN_MAX_CORE_HZ, PERF_HSRUN_MAX_BUS_HZ, PERF_HSRUN_MAX_SLOW_HZ) == 0u) ||
+		    (Perf_WithinLimits(&Perf_LevelFreq[PERF_LEVEL_VLPR], PERF_VLPR_MAX_CORE_HZ, PERF_VLPR_MAX_BUS_HZ, PERF_VLPR_MAX_SLOW_HZ) == 0u))
+		{
+			return PERF_ERR_PARA;
+		}
+
+		Perf_Config = ConfigPtr;
+		Perf_Level = PERF_LEVEL_RUN;
+		Perf_BoostCount = 0u;
+
+		/* 2. Allow HSRUN and the very low power modes (PMPROT is write-once after reset) */
+		SMC->PMPROT = (ENABLEMENT << SMC_PMPROT_AHSRUN_SHIFT) | (ENABLEMENT << SMC_PMPROT_AVLP_SHIFT);
+
+		/* 3. Preload the clock control registers used by HSRUN and VLPR */
+		Clock_SetScgHSRunModeConfig(ConfigPtr->hsrunConfig);
+		Clock_SetScgVlprModeConfig(ConfigPtr->vlprConfig);
+
+		return PERF_OK;
+}
+
+/*!
+ * @brief Registers a clock change callback.
+ *
+ * @param[in] callback Callback function.
+ * @param[in] userData Passed back to the callback.
+ * @return PERF_OK on success, PERF_ERR_PARA or PERF_ERR_FULL on error.
+ */
+Perf_ret_t Perf_RegisterCallback(Perf_CallbackType callback, void * userData)
+{
+		/* Check parameter */
+		if (callback == NULL)
+		{
+			return PERF_ERR_PARA;
+		}
+		if (Perf_CallbackCount >= PERF_MAX_CALLBACKS)
+		{
+			return PERF_ERR_FULL;
+		}
+
+		Perf_Callbacks[Perf_CallbackCount].callback = callback;
+		Perf_Callbacks[Perf_CallbackCount].userData = userData;
+		Perf_CallbackCount++;
+		return PERF_OK;
+}
+
+/*!
+ * @brief Moves to a performance level.
+ *
+ * HSRUN and VLPR are always entered and left through RUN. Callbacks are told before and after
+ * every mode step.
+ *
+ * @param[in] level Target level.
+ * @return PERF_OK on success, PERF_ERR_TIMEOUT when a switch did not complete.
+ */
+Perf_ret_t Perf_SetLevel(Perf_level_t level)
+{
+		Perf_ret_t ret = PERF_OK;
+
+		/* Check parameter */
+		if ((Perf_Config == NULL) || (level > PERF_LEVEL_HSRUN))
+		{
+			return PERF_ERR_PARA;
+		}
+
+		while ((ret == PERF_OK) && (Perf_Level != level))
+		{
+			switch (Perf_Level)
+			{
+				case PERF_LEVEL_HSRUN:
+					ret = Perf_LeaveHsrun();
+					break;
+				case PERF_LEVEL_VLPR:
+					ret = Perf_LeaveVlpr();
+					break;
+				case PERF_LEVEL_RUN:
+				default:
+					ret = (level == PERF_LEVEL_HSRUN) ? Perf_EnterHsrun() : Perf_EnterVlpr();
+					break;
+			}
+		}
+
+		return ret;
+}
+
+/*!
+ * @brief Retrieves the current performance level.
+ *
+ * @return Current level.
+ */
+Perf_level_t Perf_GetLevel(void)
+{
+		return Perf_Level;
+}
+
+/*!
+ * @brief Requests HSRUN for a burst of work (animation, communication).
+ *
+ * Requests are counted; the first one boosts to HSRUN. A request that fails is not counted and
+ * must not be released.
+ *
+ * @return PERF_OK on success, the error of Perf_SetLevel() when the boost failed.
+ */
+Perf_ret_t Perf_RequestBoost(void)
+{
+		Perf_ret_t ret = PERF_OK;
+
+		if (Perf_BoostCount == 0u)
+		{
+			ret = Perf_SetLevel(PERF_LEVEL_HSRUN);
+		}
+		if (ret == PERF_OK)
+		{
+			Perf_BoostCount++;
+		}
+
+		return ret;
+}
+
+/*!
+ * @brief Releases a boost request.
+ *
+ * When the last request is released the device returns to the idle level.
+ *
+ * @return PERF_OK on success, PERF_ERR_TIMEOUT when the switch did not complete.
+ */
+Perf_ret_t Perf_ReleaseBoost(void)
+{
+		if (Perf_BoostCount == 0u)
+		{
+			return PERF_ERR_PARA;
+		}
+
+		Perf_BoostCount--;
+		return (Perf_BoostCount == 0u) ? Perf_SetLevel(Perf_Config->idleLevel) : PERF_OK;
+}
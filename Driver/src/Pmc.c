@@ -0,0 +1,98 @@
+/****************************************************************************************************
+* @file    Pmc.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the PMC low voltage warning driver.
+* @details This file enables the low voltage warning interrupt. LVWF is set again as long as the
+*          supply stays below the threshold, so acknowledging it tells whether the supply has
+*          recovered.
+* @version 1.0.0
+* @date    2024-11-13
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Pmc.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define PMC_LVWF                            ((unsigned int)ENABLEMENT << PMC_LVDSC2_LVWF_SHIFT)
+#define PMC_LVWACK                          ((unsigned int)ENABLEMENT << PMC_LVDSC2_LVWACK_SHIFT)
+#define PMC_LVWIE                           ((unsigned int)ENABLEMENT << PMC_LVDSC2_LVWIE_SHIFT)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Pmc_ConfigType * Pmc_Config;               /* Active configuration */
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the low voltage warning.
+ *
+ * @param[in] ConfigPtr Pointer to the PMC configuration structure.
+ * @return PMC_OK on success, PMC_ERR_PARA on parameter error, PMC_ERR_LOW_VOLTAGE when the
+ *         supply is already low.
+ * @note Enable PMC_LVD_IRQn in the NVIC, at a priority that may interrupt everything it saves.
+ */
+Pmc_ret_t Pmc_Init(const Pmc_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->warningCallback == NULL))
+		{
+			return PMC_ERR_PARA;
+		}
+
+		/* The low voltage detect interrupt is not used: below LVD the part is held in reset */
+		PMC->LVDSC1 &= (unsigned char)~((unsigned int)ENABLEMENT << PMC_LVDSC1_LVDIE_SHIFT);
+		Pmc_Config = ConfigPtr;
+
+		return Pmc_ArmWarning();
+}
+
+/*!
+ * @brief Arms the low voltage warning again.
+ *
+ * @return PMC_OK when armed, PMC_ERR_LOW_VOLTAGE while the supply is still low.
+ */
+Pmc_ret_t Pmc_ArmWarning(void)
+{
+		PMC->LVDSC2 = (unsigned char)PMC_LVWACK;
+		if ((PMC->LVDSC2 & PMC_LVWF) != 0u)
+		{
+			return PMC_ERR_LOW_VOLTAGE;
+		}
+
+		PMC->LVDSC2 = (unsigned char)PMC_LVWIE;
+		return PMC_OK;
+}
+
+/*!
+ * @brief Low voltage detect and warning interrupt handler.
+ *
+ * Disables the warning interrupt, so it is reported once, and calls the callback.
+ *
+ * @return void.
+ */
+void LVD_LVW_IRQHandler(void)
+{
+		STACK_ISR_ENTER(PMC_LVD_IRQn);
+		TRACE_ISR_ENTER(PMC_LVD_IRQn);
+
+		/* Acknowledges the flag and clears LVWIE */
+		PMC->LVDSC2 = (unsigned char)PMC_LVWACK;
+
+		if ((Pmc_Config != NULL) && (Pmc_Config->warningCallback != NULL))
+		{
+			Pmc_Config->warningCallback();
+		}
+		TRACE_ISR_EXIT(PMC_LVD_IRQn);
+}
@@ -0,0 +1,44 @@
+/****************************************************************************************************
+* @file    Rcm.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the RCM reset source driver.
+* @details This file reads the reset status registers. SRS only holds the most recent reset; SSRS
+*          accumulates every reset until it is written back, which tells e.g. a watchdog reset
+*          loop from a single one.
+* @version 1.0.0
+* @date    2024-11-16
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Rcm.h"
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Retrieves the sources of the last reset.
+ *
+ * @return RCM_CAUSE_ bits of the most recent reset; a power-on reset also sets RCM_CAUSE_LVD.
+ */
+unsigned int Rcm_GetResetCauses(void)
+{
+		return RCM->SRS;
+}
+
+/*!
+ * @brief Retrieves the sources of every reset since the last power-on, and clears them.
+ *
+ * @return RCM_CAUSE_ bits accumulated since power-on or the previous call.
+ */
+unsigned int Rcm_TakeStickyCauses(void)
+{
+		unsigned int causes = RCM->SSRS;
+
+		/* Write 1 to clear */
+		RCM->SSRS = causes;
+		return causes;
+}
@@ -0,0 +1,442 @@
+/****************************************************************************************************
+* @file    Sleep.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the low-power sleep manager.
+* @details This file selects between WAIT, STOP and VLPS, programs the SMC and the SCB sleep bits,
+*          executes WFI, and restores the RUN system clock after a stop mode. The time spent
+*          in each state is measured with the configured time source.
+* @version 1.0.0
+* @date    2024-10-30
+* @note    On the S32K144 any enabled interrupt of a peripheral that keeps its clock in the stop
+*          mode wakes the device; there is no separate wake-up unit to configure.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Sleep.h"
+#include "ClockGate.h"
+#include "Cpu.h"
+#include "Scb_Registers.h"
+#include "Smc_Registers.h"
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Sleep_ConfigType * Sleep_Config;           /* Active configuration */
+static unsigned char   Sleep_Constraints[SLEEP_STATE_COUNT];  /* Constraint count per deepest allowed state */
+static Sleep_state_t   Sleep_DeepLimit;                 /* Deepest state the configuration supports */
+static Sleep_StatsType Sleep_Stats;
+static unsigned int    Sleep_LastWakeMs;                /* End of the previous sleep */
+static unsigned int    Sleep_MinuteStartMs;             /* Start of the wake-up counting window */
+static unsigned int    Sleep_MinuteWakeups;             /* Wake-ups in the current window */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Checks whether an interrupt can wake the device from STOP and VLPS.
+ */
+static unsigned char Sleep_IsStopWakeup(IRQn_Type irq)
+{
+		return (unsigned char)((irq == RTC_IRQn) || (irq == RTC_Seconds_IRQn) || (irq == LPTMR0_IRQn) ||
+		                       ((irq >= PORTA_IRQn) && (irq <= PORTE_IRQn)));
+}
+
+/*!
+ * @brief Moves the RUN system clock to the stop-safe configuration.
+ *
+ * @return 1 when the clock was switched and must be restored after the wake-up.
+ */
+static unsigned char Sleep_PrepareClocks(void)
+{
+		unsigned int loops;
+
+		if ((Sleep_Config->stopRunConfig == NULL) || (SMC->PMSTAT != SMC_PMSTAT_RUN))
+		{
+			return 0u;
+		}
+
+		Clock_WriteScgRunModeConfig(Sleep_Config->stopRunConfig);
+		for (loops = 0u; Clock_GetSysClockSource() != Sleep_Config->stopRunConfig->sys_clk_src; loops++)
+		{
+			if (loops >= CLOCK_WAIT_LOOPS)
+			{
+				break;
+			}
+		}
+		return 1u;
+}
+
+/*!
+ * @brief Moves the RUN system clock back after a stop mode.
+ *
+ * SOSC and SPLL stay enabled across the stop mode and restart on the wake-up, so only RCCR is
+ * written, once the sources of the image are valid again.
+ *
+ * @return SLEEP_OK on success, SLEEP_ERR_CLOCK when a source or the switch timed out.
+ */
+static Sleep_ret_t Sleep_RestoreClocks(void)
+{
+		const Clock_ConfigImageType * image = Sleep_Config->restoreImage;
+		unsigned int loops;
+
+		for (loops = 0u; (image->soscEnable != 0u) && (Clock_IsScgSoscValid() == 0u); loops++)
+		{
+			if (loops >= CLOCK_WAIT_LOOPS)
+			{
+				return SLEEP_ERR_CLOCK;
+			}
+		}
+		for (loops = 0u; (image->spllEnable != 0u) && (Clock_IsScgSpllValid() == 0u); loops++)
+		{
+			if (loops >= CLOCK_WAIT_LOOPS)
+			{
+				return SLEEP_ERR_CLOCK;
+			}
+		}
+
+		SCG->RCCR = image->rccr;
+		for (loops = 0u; (SCG->CSR & SCG_CSR_SCS_MASK) != (image->rccr & SCG_CSR_SCS_MASK); loops++)
+		{
+			if (loops >= CLOCK_WAIT_LOOPS)
+			{
+				return SLEEP_ERR_CLOCK;
+			}
+		}
+
+		return SLEEP_OK;
+}
+
+/*!
+ * @brief Updates the statistics after a wake-up.
+ */
+static void Sleep_Account(Sleep_state_t state, unsigned int enterMs, unsigned int wakeMs)
+{
+		unsigned int elapsed;
+
+		Sleep_Stats.timeMs[state] += wakeMs - enterMs;
+		Sleep_Stats.entries[state]++;
+		Sleep_LastWakeMs = wakeMs;
+
+		/* Wake-ups per minute, latched once per window */
+		Sleep_MinuteWakeups++;
+		elapsed = wakeMs - Sleep_MinuteStartMs;
+		if (elapsed >= SLEEP_MS_PER_MINUTE)
+		{
+			Sleep_Stats.wakeupsPerMinute = (unsigned int)(((uint64)Sleep_MinuteWakeups * SLEEP_MS_PER_MINUTE) / elapsed);
+			Sleep_MinuteStartMs = wakeMs;
+			Sleep_MinuteWakeups = 0u;
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the sleep manager.
+ *
+ * This function enables the wake-up interrupts and, when requested, keeps SIRC running in the
+ * stop modes. VLPS is only used when PMPROT[AVLP] was set by Perf_Init() or the start-up code.
+ *
+ * @param[in] ConfigPtr Pointer to the sleep configuration structure.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ * @note stopRunConfig and restoreImage are given together: the clock switched away before a stop
+ *       mode must be switched back. stopRunConfig must run on FIRC or SIRC.
+ */
+Sleep_ret_t Sleep_Init(const Sleep_ConfigType * ConfigPtr)
+{
+		unsigned char index;
+		unsigned char stopWakeup = 0u;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->getTimeMs == NULL) ||
+		    ((ConfigPtr->wakeupCount != 0u) && (ConfigPtr->wakeupSources == NULL)) ||
+		    ((ConfigPtr->stopBlockerCount != 0u) && (ConfigPtr->stopBlockers == NULL)))
+		{
+			return SLEEP_ERR_PARA;
+		}
+		if ((ConfigPtr->stopRunConfig == NULL) != (ConfigPtr->restoreImage == NULL))
+		{
+			return SLEEP_ERR_PARA;
+		}
+		if ((ConfigPtr->stopRunConfig != NULL) &&
+		    (ConfigPtr->stopRunConfig->sys_clk_src != FIRC_CLK) && (ConfigPtr->stopRunConfig->sys_clk_src != SIRC_CLK))
+		{
+			return SLEEP_ERR_PARA;
+		}
+
+		Sleep_Config = ConfigPtr;
+
+		/* 1. Enable the wake-up interrupts */
+		for (index = 0u; index < ConfigPtr->wakeupCount; index++)
+		{
+			NVIC_EnableInterrupt(ConfigPtr->wakeupSources[index]);
+			stopWakeup |= Sleep_IsStopWakeup(ConfigPtr->wakeupSources[index]);
+		}
+
+		/* 2. Stop modes need a source that still runs there, VLPS also needs PMPROT[AVLP] */
+		if (stopWakeup == 0u)
+		{
+			Sleep_DeepLimit = SLEEP_STATE_WAIT;
+		}
+		else if (((SMC->PMPROT >> SMC_PMPROT_AVLP_SHIFT) & VALUE_CHECK_BIT) == 0u)
+		{
+			Sleep_DeepLimit = SLEEP_STATE_STOP;
+		}
+		else
+		{
+			Sleep_DeepLimit = SLEEP_STATE_VLPS;
+		}
+
+		/* 3. Keep SIRC for the LPTMR in the stop modes */
+		if (ConfigPtr->sircInStop != 0u)
+		{
+			SCG->SIRCCSR |= ((ENABLEMENT << SCG_SIRCCSR_SIRCSTEN_SHIFT) | (ENABLEMENT << SCG_SIRCCSR_SIRCLPEN_SHIFT));
+		}
+
+		Sleep_ResetStats();
+
+		return SLEEP_OK;
+}
+
+/*!
+ * @brief Forbids states deeper than the given one.
+ *
+ * Drivers call this while a transfer needs clocks that stop in the deeper states.
+ *
+ * @param[in] maxState Deepest state still allowed.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ */
+Sleep_ret_t Sleep_AddConstraint(Sleep_state_t maxState)
+{
+		unsigned int primask;
+
+		if ((maxState >= SLEEP_STATE_COUNT) || (Sleep_Constraints[maxState] == 0xFFu))
+		{
+			return SLEEP_ERR_PARA;
+		}
+
+		primask = Cpu_EnterCritical();
+		Sleep_Constraints[maxState]++;
+		Cpu_ExitCritical(primask);
+
+		return SLEEP_OK;
+}
+
+/*!
+ * @brief Removes a constraint added with Sleep_AddConstraint().
+ *
+ * @param[in] maxState Deepest state still allowed, as passed to Sleep_AddConstraint().
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA or SLEEP_ERR_COUNT on error.
+ */
+Sleep_ret_t Sleep_RemoveConstraint(Sleep_state_t maxState)
+{
+		unsigned int primask;
+		Sleep_ret_t ret = SLEEP_OK;
+
+		if (maxState >= SLEEP_STATE_COUNT)
+		{
+			return SLEEP_ERR_PARA;
+		}
+
+		primask = Cpu_EnterCritical();
+		if (Sleep_Constraints[maxState] == 0u)
+		{
+			ret = SLEEP_ERR_COUNT;
+		}
+		else
+		{
+			Sleep_Constraints[maxState]--;
+		}
+		Cpu_ExitCritical(primask);
+
+		return ret;
+}
+
+/*!
+ * @brief Selects the deepest state that is safe.
+ *
+ * @param[in] idleMs Time until the next timer expires, SLEEP_IDLE_FOREVER when none is pending.
+ * @return Selected state, SLEEP_STATE_RUN when the idle time is too short for any state.
+ */
+Sleep_state_t Sleep_SelectState(unsigned int idleMs)
+{
+		unsigned int state;
+		unsigned char index;
+		Sleep_state_t limit = Sleep_DeepLimit;
+
+		if (Sleep_Config == NULL)
+		{
+			return SLEEP_STATE_RUN;
+		}
+
+		/* 1. Constraints held by drivers */
+		for (state = 0u; state < (unsigned int)limit; state++)
+		{
+			if (Sleep_Constraints[state] != 0u)
+			{
+				limit = (Sleep_state_t)state;
+				break;
+			}
+		}
+
+		/* 2. Stop modes cannot be entered from HSRUN */
+		if ((limit > SLEEP_STATE_WAIT) && (SMC->PMSTAT == SMC_PMSTAT_HSRUN))
+		{
+			limit = SLEEP_STATE_WAIT;
+		}
+
+		/* 3. Peripherals in use that need the bus clock */
+		for (index = 0u; (limit > SLEEP_STATE_WAIT) && (index < Sleep_Config->stopBlockerCount); index++)
+		{
+			if (ClockGate_GetRefCount(Sleep_Config->stopBlockers[index]) != 0u)
+			{
+				limit = SLEEP_STATE_WAIT;
+			}
+		}
+
+		/* 4. Deepest state whose break-even time fits before the next timer */
+		for (state = (unsigned int)limit; state > (unsigned int)SLEEP_STATE_RUN; state--)
+		{
+			if (Sleep_Config->minResidencyMs[state] <= idleMs)
+			{
+				return (Sleep_state_t)state;
+			}
+		}
+
+		return SLEEP_STATE_RUN;
+}
+
+/*!
+ * @brief Enters the deepest safe state and returns after the wake-up.
+ *
+ * Interrupts are masked while the state is entered and the clocks are restored, so the
+ * wake-up interrupt runs after the SCG configuration is back.
+ *
+ * @param[in] idleMs Time until the next timer expires, SLEEP_IDLE_FOREVER when none is pending.
+ * @param[out] StatePtr State that was used, SLEEP_STATE_RUN when none; may be NULL.
+ * @return SLEEP_OK on success, SLEEP_ERR_CLOCK when the RUN clock could not be restored after a
+ *         stop mode; the device then keeps running on stopRunConfig.
+ */
+Sleep_ret_t Sleep_Enter(unsigned int idleMs, Sleep_state_t * StatePtr)
+{
+		unsigned int primask;
+		unsigned int enterMs;
+		unsigned char restore = 0u;
+		Sleep_state_t state;
+		Sleep_ret_t ret = SLEEP_OK;
+
+		primask = Cpu_EnterCritical();
+
+		state = Sleep_SelectState(idleMs);
+		if (StatePtr != NULL)
+		{
+			*StatePtr = state;
+		}
+		if (state == SLEEP_STATE_RUN)
+		{
+			Cpu_ExitCritical(primask);
+			return SLEEP_OK;
+		}
+
+		/* 1. Awake time since the previous wake-up */
+		enterMs = Sleep_Config->getTimeMs();
+		Sleep_Stats.timeMs[SLEEP_STATE_RUN] += enterMs - Sleep_LastWakeMs;
+
+		/* 2. Program the stop mode */
+		if (state == SLEEP_STATE_WAIT)
+		{
+			SCB->SCR &= ~((unsigned int)ENABLEMENT << SCB_SCR_SLEEPDEEP_SHIFT);
+		}
+		else
+		{
+			restore = Sleep_PrepareClocks();
+
+			SMC->STOPCTRL = (SMC_STOPO_STOP1 << SMC_STOPCTRL_STOPO_SHIFT);
+			SMC->PMCTRL = (SMC->PMCTRL & (SMC_PMCTRL_RUNM_MASK << SMC_PMCTRL_RUNM_SHIFT)) |
+			              (((state == SLEEP_STATE_VLPS) ? SMC_STOPM_VLPS : SMC_STOPM_STOP) << SMC_PMCTRL_STOPM_SHIFT);
+			(void)SMC->PMCTRL;                   /* Read back so the write completes before WFI */
+			SCB->SCR |= ((unsigned int)ENABLEMENT << SCB_SCR_SLEEPDEEP_SHIFT);
+		}
+
+		/* 3. Sleep */
+		CPU_DSB();
+		CPU_WFI();
+		CPU_ISB();
+
+		/* 4. Wake-up: the clock restart below is awake time, not sleep time */
+		Sleep_Account(state, enterMs, Sleep_Config->getTimeMs());
+		SCB->SCR &= ~((unsigned int)ENABLEMENT << SCB_SCR_SLEEPDEEP_SHIFT);
+		if ((state == SLEEP_STATE_VLPS) && (((SMC->PMCTRL >> SMC_PMCTRL_VLPSA_SHIFT) & VALUE_CHECK_BIT) != 0u))
+		{
+			Sleep_Stats.aborts++;
+		}
+		if (restore != 0u)
+		{
+			ret = Sleep_RestoreClocks();
+		}
+
+		/* 5. The wake-up interrupt runs now */
+		Cpu_ExitCritical(primask);
+
+		return ret;
+}
+
+/*!
+ * @brief Retrieves the sleep statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return SLEEP_OK on success, SLEEP_ERR_PARA on parameter error.
+ */
+Sleep_ret_t Sleep_GetStats(Sleep_StatsType * StatsPtr)
+{
+		unsigned int state;
+		unsigned int totalMs = 0u;
+		uint64 charge = 0u;
+
+		if ((StatsPtr == NULL) || (Sleep_Config == NULL))
+		{
+			return SLEEP_ERR_PARA;
+		}
+
+		*StatsPtr = Sleep_Stats;
+
+		/* Power model: time-weighted average of the per-state currents */
+		for (state = 0u; state < (unsigned int)SLEEP_STATE_COUNT; state++)
+		{
+			totalMs += Sleep_Stats.timeMs[state];
+			charge += (uint64)Sleep_Stats.timeMs[state] * Sleep_Config->currentUa[state];
+		}
+		StatsPtr->averageUa = (totalMs != 0u) ? (unsigned int)(charge / totalMs) : 0u;
+
+		return SLEEP_OK;
+}
+
+/*!
+ * @brief Clears the sleep statistics.
+ *
+ * @return void.
+ */
+void Sleep_ResetStats(void)
+{
+		unsigned int state;
+		unsigned int now = (Sleep_Config != NULL) ? Sleep_Config->getTimeMs() : 0u;
+
+		for (state = 0u; state < (unsigned int)SLEEP_STATE_COUNT; state++)
+		{
+			Sleep_Stats.timeMs[state] = 0u;
+			Sleep_Stats.entries[state] = 0u;
+		}
+		Sleep_Stats.aborts = 0u;
+		Sleep_Stats.wakeupsPerMinute = 0u;
+		Sleep_Stats.averageUa = 0u;
+
+		Sleep_LastWakeMs = now;
+		Sleep_MinuteStartMs = now;
+		Sleep_MinuteWakeups = 0u;
+}
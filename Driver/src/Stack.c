@@ -0,0 +1,279 @@
+/****************************************************************************************************
+* @file    Stack.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of stack usage monitoring.
+* @details This file keeps a small table of registered stacks. Usage is measured on request by
+*          scanning the painted pattern from the bottom, so monitoring costs nothing at run time
+*          except the optional depth sample at interrupt entry.
+* @version 1.0.0
+* @date    2024-11-11
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Stack.h"
+#include "Proto.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define STACK_USAGE_RESPONSE            (10u)              /* PROTO_CMD_GET_STACK payload */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Registered stack.
+ */
+typedef struct
+{
+			const unsigned int *    base;           /*!< Lowest address */
+			unsigned int            words;          /*!< Size in words */
+			unsigned char           id;             /*!< Application identifier */
+} Stack_ContextType;
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+/* Defined by the linker script */
+extern unsigned int STACK_MAIN_LIMIT[];
+extern unsigned int STACK_MAIN_TOP[];
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Stack_ContextType Stack_Contexts[STACK_CONTEXT_MAX];
+static unsigned char Stack_ContextCount;
+
+#if (STACK_ISR_WATCH != 0u)
+static unsigned short Stack_IsrDepth[STACK_IRQ_COUNT];  /* Deepest main stack use at entry, bytes */
+#endif
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Reads the main stack pointer.
+ */
+static inline unsigned int Stack_GetMsp(void)
+{
+		unsigned int msp;
+
+		__asm volatile ("mrs %0, msp" : "=r" (msp));
+		return msp;
+}
+
+/*!
+ * @brief Writes a little-endian word.
+ */
+static void Stack_PutWord(unsigned char * DataPtr, unsigned int value)
+{
+		DataPtr[0] = (unsigned char)value;
+		DataPtr[1] = (unsigned char)(value >> 8u);
+		DataPtr[2] = (unsigned char)(value >> 16u);
+		DataPtr[3] = (unsigned char)(value >> 24u);
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_STACK, reports the usage of a registered stack.
+ *
+ * Request: context index u8. Response: id u8, overflow u8, size u32, used u32; an index past the
+ * last registered stack is rejected with PROTO_STATUS_BAD_VALUE.
+ */
+static Proto_status_t Stack_HandleGetStack(const unsigned char * Request, unsigned char length,
+                                           unsigned char * Response, unsigned char * ResponseLength)
+{
+		Stack_UsageType usage;
+
+		(void)length;
+
+		if (Stack_GetUsage(Request[0], &usage) != STACK_OK)
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+
+		Response[0] = usage.id;
+		Response[1] = usage.overflow;
+		Stack_PutWord(&Response[2], usage.sizeBytes);
+		Stack_PutWord(&Response[6], usage.usedBytes);
+		*ResponseLength = STACK_USAGE_RESPONSE;
+
+		return PROTO_STATUS_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Paints the free part of the main stack and registers it as STACK_ID_MAIN.
+ *
+ * Call first thing in main(): everything below the caller's frame, less a margin, is painted.
+ * The usage of the registered stacks is served to the serial protocol as PROTO_CMD_GET_STACK.
+ *
+ * @return void.
+ */
+void Stack_Init(void)
+{
+		unsigned int * limit = STACK_MAIN_LIMIT;
+		unsigned int * end = (unsigned int *)Stack_GetMsp() - STACK_PAINT_MARGIN_WORDS;
+		unsigned int words = (unsigned int)(STACK_MAIN_TOP - STACK_MAIN_LIMIT);
+
+		/* Paint up to the live frames only; the words above them are counted as used */
+		Stack_Paint(limit, (unsigned int)(end - limit));
+
+		Stack_ContextCount = 0u;
+		(void)Stack_Register(STACK_ID_MAIN, limit, words);
+		(void)Proto_Register(PROTO_CMD_GET_STACK, Stack_HandleGetStack, 1u, 1u);
+
+#if (STACK_ISR_WATCH != 0u)
+		{
+			unsigned int irq;
+
+			for (irq = 0u; irq < STACK_IRQ_COUNT; irq++)
+			{
+				Stack_IsrDepth[irq] = 0u;
+			}
+		}
+#endif
+}
+
+/*!
+ * @brief Registers a stack to be reported by Stack_GetUsage() and checked by Stack_Check().
+ *
+ * The stack must already be painted, e.g. a task stack passed to Os_TaskCreate().
+ *
+ * @param[in] id Identifier reported with the usage, chosen by the application.
+ * @param[in] BasePtr Stack base, lowest address.
+ * @param[in] words Stack size in words.
+ * @return STACK_OK on success, STACK_ERR_PARA or STACK_ERR_FULL on error.
+ */
+Stack_ret_t Stack_Register(unsigned char id, const unsigned int * BasePtr, unsigned int words)
+{
+		/* Check parameter */
+		if ((BasePtr == NULL) || (words < 2u))
+		{
+			return STACK_ERR_PARA;
+		}
+		if (Stack_ContextCount >= STACK_CONTEXT_MAX)
+		{
+			return STACK_ERR_FULL;
+		}
+
+		Stack_Contexts[Stack_ContextCount].base = BasePtr;
+		Stack_Contexts[Stack_ContextCount].words = words;
+		Stack_Contexts[Stack_ContextCount].id = id;
+		Stack_ContextCount++;
+
+		return STACK_OK;
+}
+
+/*!
+ * @brief Gets the number of registered contexts.
+ *
+ * @return Registered contexts, the main stack at index 0.
+ */
+unsigned char Stack_GetContextCount(void)
+{
+		return Stack_ContextCount;
+}
+
+/*!
+ * @brief Measures the usage of a registered stack.
+ *
+ * The pattern is scanned from the bottom, so the time grows with the unused part.
+ *
+ * @param[in] index Context index, below Stack_GetContextCount().
+ * @param[out] UsagePtr Pointer to the usage structure.
+ * @return STACK_OK on success, STACK_ERR_PARA on parameter error.
+ */
+Stack_ret_t Stack_GetUsage(unsigned char index, Stack_UsageType * UsagePtr)
+{
+		const Stack_ContextType * context;
+
+		/* Check parameter */
+		if ((UsagePtr == NULL) || (index >= Stack_ContextCount))
+		{
+			return STACK_ERR_PARA;
+		}
+
+		context = &Stack_Contexts[index];
+		UsagePtr->id = context->id;
+		UsagePtr->sizeBytes = context->words * 4u;
+		UsagePtr->overflow = (unsigned char)((Stack_CanaryIntact(context->base) != 0u) ? 0u : 1u);
+		if (UsagePtr->overflow != 0u)
+		{
+			UsagePtr->usedBytes = UsagePtr->sizeBytes;
+		}
+		else
+		{
+			UsagePtr->usedBytes = (context->words - 1u - Stack_GetUnusedWords(context->base, context->words)) * 4u;
+		}
+
+		return STACK_OK;
+}
+
+/*!
+ * @brief Tests the canaries of all registered stacks.
+ *
+ * @return Bit n set: the stack of context index n overflowed. 0 when all are intact.
+ */
+unsigned int Stack_Check(void)
+{
+		unsigned int overflowed = 0u;
+		unsigned char index;
+
+		for (index = 0u; index < Stack_ContextCount; index++)
+		{
+			if (Stack_CanaryIntact(Stack_Contexts[index].base) == 0u)
+			{
+				overflowed |= (1u << index);
+			}
+		}
+		return overflowed;
+}
+
+#if (STACK_ISR_WATCH != 0u)
+/*!
+ * @brief Records the main stack depth at the entry of an interrupt handler.
+ *
+ * Called by STACK_ISR_ENTER() at the top of the handler.
+ *
+ * @param[in] irq IRQ number.
+ * @return void.
+ */
+void Stack_IsrEnter(unsigned char irq)
+{
+		unsigned int depth = (unsigned int)STACK_MAIN_TOP - Stack_GetMsp();
+
+		if ((irq < STACK_IRQ_COUNT) && (depth > Stack_IsrDepth[irq]))
+		{
+			Stack_IsrDepth[irq] = (unsigned short)depth;
+		}
+}
+
+/*!
+ * @brief Gets the deepest main stack use seen at the entry of an interrupt handler.
+ *
+ * The value includes the frames of the interrupted code and of the interrupts it preempted.
+ * Adding the handler's own use gives the main stack it needs at its priority.
+ *
+ * @param[in] irq IRQ number.
+ * @return Bytes of main stack in use, 0 when the interrupt was never entered.
+ */
+unsigned int Stack_GetIsrDepth(IRQn_Type irq)
+{
+		if ((unsigned int)irq >= STACK_IRQ_COUNT)
+		{
+			return 0u;
+		}
+		return Stack_IsrDepth[irq];
+}
+#endif
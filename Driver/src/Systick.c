@@ -15,6 +15,12 @@
 #include "Systick.h"
 
 
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Systick_Period;		/* Period of timer (ms) from the last Systick_Init() */
+
+
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
@@ -34,10 +40,12 @@ void Systick_Init(const Systick_ConfigType* ConfigPtr)
 			/*** Step 1. Check parameter ***/
 			
 			/*** Step 2. Configuration for SysTick timer ***/
-				/* Step 2.1. Disable the SysTick timer */
-				SYST->CSR &= ~(ENABLEMENT << BIT0);
+				/* Step 2.1. Disable the SysTick timer and set the timeout interrupt, in one write */
+				REG_UPDATE(SYST->CSR, 0u, FIELD_SET(SYST_CSR_ENABLE, 0u),
+				           FIELD_SET(SYST_CSR_TICKINT, (ConfigPtr->isInterruptEnabled != 0) ? 1u : 0u));
 			
 				/* Step 2.2. Setting the reload value */
+					Systick_Period = ConfigPtr->period;
 					/*! Calculate RVR !*/
 					if(ConfigPtr->period != 0)
 					{
@@ -50,15 +58,6 @@ void Systick_Init(const Systick_ConfigType* ConfigPtr)
 			
 				/* Step 2.3. Clear the current value */
 				SYST->CVR = CLEAR_SYST_CVR;
-
-				/* Step 2.4. Check whether timeout interrupt is set ?*/
-				if (ConfigPtr->isInterruptEnabled != 0) 
-				{
-						SYST->CSR |= (ENABLEMENT << BIT1);  		/* Enable the SysTick interrupt */
-				} else 
-				{
-						SYST->CSR &= ~(ENABLEMENT << BIT1);  		/* Disable the SysTick interrupt */
-				}
 }
 
 /*!
@@ -72,7 +71,7 @@ void Systick_Init(const Systick_ConfigType* ConfigPtr)
 void Systick_Start(void)
 {
 			/* Step 1. Enable the SysTick counter */
-			SYST->CSR |= (ENABLEMENT << BIT0); 	 	/* Set the ENABLE bit to start the timer */
+			REG_UPDATE(SYST->CSR, 0u, FIELD_SET(SYST_CSR_ENABLE, 1u)); 	 	/* Set the ENABLE bit to start the timer */
 }
 
 /*!
@@ -86,7 +85,7 @@ void Systick_Start(void)
 void Systick_Stop(void)
 {
 			/* Step 1. Disable the SysTick counter */
-			SYST->CSR &= ~(ENABLEMENT << BIT0); 	 /* Clear the ENABLE bit to stop the timer */
+			REG_UPDATE(SYST->CSR, 0u, FIELD_SET(SYST_CSR_ENABLE, 0u)); 	 /* Clear the ENABLE bit to stop the timer */
 }
 
 /*!
@@ -118,7 +117,7 @@ void Delay_Timer(unsigned int ms)
 			unsigned int count = 0;			/* Numbers of execute systick timer */
 			while (1)
 			{
-					if ((CHECK_BIT(SYST->CSR, BIT16)))
+					if (FIELD_GET(SYST->CSR, SYST_CSR_COUNTFLAG) != 0u)
 					{
 							count++;
 					}
@@ -129,3 +128,22 @@ void Delay_Timer(unsigned int ms)
 					}
 			}
 }
+
+/*!
+ * @brief Recomputes the reload value for a new clock frequency.
+ * 
+ * This function keeps the period given to Systick_Init() and recalculates the reload value after
+ * the core clock changed. The running state and the interrupt enable are preserved.
+ * 
+ * @param[in] fSystick New clock source frequency (kHz).
+ * @return void.
+ * @note Call this from a clock change notification, e.g. a Perf post-change callback.
+ */
+void Systick_Retune(unsigned int fSystick)
+{
+			if (Systick_Period != 0)
+			{
+				SYST->RVR = Systick_Period * fSystick;		/* Set the RELOAD value register */
+				SYST->CVR = CLEAR_SYST_CVR;					/* Restart the period at the new rate */
+			}
+}
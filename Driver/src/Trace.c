@@ -0,0 +1,117 @@
+/****************************************************************************************************
+* @file    Trace.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the event trace recorder.
+* @details This file writes fixed-size records into a circular buffer inside a short critical
+*          section, so records from nested interrupts never interleave. A record costs a fixed
+*          number of cycles, measured by Trace_Init().
+* @version 1.0.0
+* @date    2024-11-07
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Trace.h"
+
+#if (TRACE_ENABLE != 0u)
+#include "Cpu.h"
+#include "Dwt.h"
+#include "Clock.h"
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+/* Not static: dumped by symbol name from the debugger */
+Trace_RecorderType Trace_Recorder;
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the recorder.
+ *
+ * This function clears the ring, records the core clock and measures the cost of one record
+ * with the cycle counter, so the host can account for it.
+ *
+ * @return void.
+ */
+void Trace_Init(void)
+{
+		unsigned int primask;
+		unsigned int start;
+		unsigned int index;
+
+		Trace_Recorder.magic = 0u;
+		Trace_Recorder.capacity = TRACE_BUFFER_RECORDS;
+		Trace_Recorder.cpuHz = Clock_GetFreq(CLOCK_FREQ_CORE);
+		Trace_Recorder.frozen = 0u;
+		Trace_Recorder.count = 0u;
+
+		/* Time a burst of records with interrupts masked, then discard them */
+		primask = Cpu_EnterCritical();
+		start = DWT_GET_CYCLES();
+		for (index = 0u; index < TRACE_CALIBRATION_RECORDS; index++)
+		{
+			Trace_Record(TRACE_TYPE_MARK, 0u, 0u);
+		}
+		Trace_Recorder.overheadCycles = (DWT_GET_CYCLES() - start) / TRACE_CALIBRATION_RECORDS;
+		Trace_Recorder.count = 0u;
+		Trace_Recorder.magic = TRACE_MAGIC;
+		Cpu_ExitCritical(primask);
+}
+
+/*!
+ * @brief Stores one record.
+ *
+ * Constant time, callable from any interrupt. Use the TRACE_ macros rather than calling it.
+ *
+ * @param[in] type Record type.
+ * @param[in] id IRQ number or event identifier.
+ * @param[in] arg Event argument.
+ * @return void.
+ */
+void Trace_Record(Trace_type_t type, unsigned char id, unsigned short arg)
+{
+		unsigned int primask;
+		Trace_RecordType * record;
+
+		primask = Cpu_EnterCritical();
+		if (Trace_Recorder.frozen == 0u)
+		{
+			record = &Trace_Recorder.records[Trace_Recorder.count & (TRACE_BUFFER_RECORDS - 1u)];
+			record->timestamp = DWT_GET_CYCLES();
+			record->type = (unsigned char)type;
+			record->id = id;
+			record->arg = arg;
+			Trace_Recorder.count++;
+		}
+		Cpu_ExitCritical(primask);
+}
+
+/*!
+ * @brief Stops recording, keeping the records that lead to the call.
+ *
+ * Call this when a fault is detected (skipped second, display glitch) and read the buffer later.
+ *
+ * @return void.
+ */
+void Trace_Freeze(void)
+{
+		Trace_Recorder.frozen = 1u;
+}
+
+/*!
+ * @brief Restarts recording after Trace_Freeze().
+ *
+ * @return void.
+ */
+void Trace_Resume(void)
+{
+		Trace_Recorder.frozen = 0u;
+}
+
+#endif  /* TRACE_ENABLE */
@@ -0,0 +1,162 @@
+/****************************************************************************************************
+* @file    Wdog.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the WDOG driver.
+* @details This file configures the Watchdog Timer. The unlock key opens CS, TOVAL and WIN for
+*          128 bus clocks; the three writes are done with interrupts masked so that they fit, and
+*          RCS tells when the counter clock domain has taken them. Commands are 32-bit (CMD32EN),
+*          so the unlock and the refresh are single stores.
+* @version 1.0.0
+* @date    2024-11-16
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Wdog.h"
+#include "Cpu.h"
+#include "Trace.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define WDOG_BIT(SHIFT)                     ((unsigned int)ENABLEMENT << (SHIFT))
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Wdog_ConfigType * Wdog_Config;             /* Active configuration */
+static unsigned short Wdog_Window;                      /* Window of the active configuration */
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the WDOG.
+ *
+ * This function unlocks the watchdog with interrupts masked, writes the timeout, the window
+ * and the control register within the 128 bus clocks allowed, and waits for the new
+ * configuration to take effect. The counter restarts from 0.
+ *
+ * @param[in] ConfigPtr Pointer to the WDOG configuration structure.
+ * @return WDOG_OK on success, WDOG_ERR_PARA on parameter error, WDOG_ERR_TIMEOUT when the
+ *         watchdog did not take the configuration.
+ * @note Enable WDOG_EWM_IRQn in the NVIC, at the highest priority, to receive the callback.
+ */
+Wdog_ret_t Wdog_Init(const Wdog_ConfigType * ConfigPtr)
+{
+		unsigned int cs;
+		unsigned int primask;
+		unsigned int loops = 0u;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->clkSrc > WDOG_CLK_SIRC) || (ConfigPtr->timeout == 0u) ||
+		    (ConfigPtr->window >= ConfigPtr->timeout))
+		{
+			return WDOG_ERR_PARA;
+		}
+
+		cs = WDOG_BIT(WDOG_CS_EN_SHIFT) | WDOG_BIT(WDOG_CS_CMD32EN_SHIFT) |
+		     ((unsigned int)ConfigPtr->clkSrc << WDOG_CS_CLK_SHIFT);
+		if (ConfigPtr->prescaler256 != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_PRES_SHIFT);
+		}
+		if (ConfigPtr->window != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_WIN_SHIFT);
+		}
+		if (ConfigPtr->allowUpdate != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_UPDATE_SHIFT);
+		}
+		if (ConfigPtr->runInDebug != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_DBG_SHIFT);
+		}
+		if (ConfigPtr->runInWait != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_WAIT_SHIFT);
+		}
+		if (ConfigPtr->runInStop != 0u)
+		{
+			cs |= WDOG_BIT(WDOG_CS_STOP_SHIFT);
+		}
+		if (ConfigPtr->callback != NULL)
+		{
+			cs |= WDOG_BIT(WDOG_CS_INT_SHIFT);
+		}
+
+		Wdog_Config = ConfigPtr;
+		Wdog_Window = ConfigPtr->window;
+
+		/* 1. Unlock and write the configuration within 128 bus clocks */
+		primask = Cpu_EnterCritical();
+		WDOG->CNT = WDOG_UNLOCK_KEY;
+		while (((WDOG->CS & WDOG_BIT(WDOG_CS_ULK_SHIFT)) == 0u) && (loops < WDOG_WAIT_LOOPS))
+		{
+			loops++;
+		}
+		WDOG->TOVAL = ConfigPtr->timeout;
+		WDOG->WIN = ConfigPtr->window;
+		WDOG->CS = cs;
+		Cpu_ExitCritical(primask);
+		if (loops >= WDOG_WAIT_LOOPS)
+		{
+			return WDOG_ERR_TIMEOUT;
+		}
+
+		/* 2. Wait for the counter clock domain to take it */
+		loops = 0u;
+		while (((WDOG->CS & WDOG_BIT(WDOG_CS_RCS_SHIFT)) == 0u) && (loops < WDOG_WAIT_LOOPS))
+		{
+			loops++;
+		}
+
+		return (loops < WDOG_WAIT_LOOPS) ? WDOG_OK : WDOG_ERR_TIMEOUT;
+}
+
+/*!
+ * @brief Retrieves the counter.
+ *
+ * @return Counts since the last refresh.
+ */
+unsigned int Wdog_GetCounter(void)
+{
+		return WDOG->CNT;
+}
+
+/*!
+ * @brief Tells whether a refresh is allowed now.
+ *
+ * @return 1 without window mode or once the counter reached the window, 0 before.
+ */
+unsigned char Wdog_IsWindowOpen(void)
+{
+		return ((Wdog_Window == 0u) || (WDOG->CNT >= Wdog_Window)) ? 1u : 0u;
+}
+
+/*!
+ * @brief Watchdog and EWM interrupt handler.
+ *
+ * Calls the pre-reset callback. The flag is not cleared: the reset follows.
+ *
+ * @return void.
+ */
+void WDOG_EWM_IRQHandler(void)
+{
+		STACK_ISR_ENTER(WDOG_EWM_IRQn);
+		TRACE_ISR_ENTER(WDOG_EWM_IRQn);
+
+		if (((WDOG->CS & WDOG_BIT(WDOG_CS_FLG_SHIFT)) != 0u) && (Wdog_Config != NULL) &&
+		    (Wdog_Config->callback != NULL))
+		{
+			Wdog_Config->callback();
+		}
+		TRACE_ISR_EXIT(WDOG_EWM_IRQn);
+}
@@ -0,0 +1,181 @@
+/****************************************************************************************************
+* @file     Alarm.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the alarm scheduler.
+* @details  This header file contains the definitions, structures, and function prototypes for the
+*           alarm scheduler. Alarms are kept in a binary min-heap ordered by their next fire time,
+*           so only the earliest alarm has to be programmed into the RTC or timer compare.
+* @version  1.0.0
+* @date     2024-10-20
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef ALARM_H
+#define ALARM_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Capacity of the alarm scheduler ***/
+#define ALARM_MAX_COUNT                 (256u)             /* Maximum number of alarms */
+#define ALARM_INVALID_ID                (0xFFFFu)          /* Identifier returned for no alarm */
+#define ALARM_NO_COMPARE                (0xFFFFFFFFu)      /* Passed to setCompare when idle */
+
+/*** Time conversion ***/
+#define ALARM_SECONDS_PER_DAY           (86400u)           /* Seconds in one day */
+#define ALARM_DAYS_PER_WEEK             (7u)               /* Days in one week */
+#define ALARM_EPOCH_WEEKDAY             (4u)               /* 1970-01-01 was a Thursday */
+
+/*** Weekday mask bits (ALARM_TYPE_WEEKDAY) ***/
+#define ALARM_SUNDAY                    (1u << 0)          /* Fire on Sunday */
+#define ALARM_MONDAY                    (1u << 1)          /* Fire on Monday */
+#define ALARM_TUESDAY                   (1u << 2)          /* Fire on Tuesday */
+#define ALARM_WEDNESDAY                 (1u << 3)          /* Fire on Wednesday */
+#define ALARM_THURSDAY                  (1u << 4)          /* Fire on Thursday */
+#define ALARM_FRIDAY                    (1u << 5)          /* Fire on Friday */
+#define ALARM_SATURDAY                  (1u << 6)          /* Fire on Saturday */
+#define ALARM_EVERY_DAY                 (0x7Fu)            /* Fire on every day of the week */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Alarm Return Status Type
+ * @details   This enumeration defines the return status values for alarm operations.
+ */
+typedef enum
+{
+			ALARM_OK            = 0U,       /**< Operation completed successfully. */
+			ALARM_ERR_PARA      = 1U,       /**< Parameter error */
+			ALARM_ERR_FULL      = 2U,       /**< No free alarm slot */
+			ALARM_ERR_NOT_FOUND = 3U,       /**< Alarm identifier is not in use */
+} Alarm_ret_t;
+
+/**
+ * @brief     Alarm Type
+ * @details   This enumeration defines how the next fire time of an alarm is computed.
+ */
+typedef enum
+{
+			ALARM_TYPE_ONE_SHOT   = 0U,     /**< Fires once at an absolute epoch time. */
+			ALARM_TYPE_WEEKDAY    = 1U,     /**< Fires at a time of day on the selected weekdays. */
+			ALARM_TYPE_COUNTDOWN  = 2U,     /**< Fires once after a number of seconds. */
+			ALARM_TYPE_INTERVAL   = 3U,     /**< Fires repeatedly with a fixed period. */
+} Alarm_type_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Alarm notification callback.
+ * @details Called from Alarm_Process() when an alarm fires.
+ */
+typedef void (*Alarm_CallbackType)(unsigned short id, void * userData);
+
+/**
+ * @brief   Compare programming callback.
+ * @details Called whenever the earliest fire time changes, so that the RTC alarm or timer compare
+ *          can be reprogrammed. ALARM_NO_COMPARE is passed when no alarm is pending.
+ */
+typedef void (*Alarm_SetCompareType)(unsigned int fireTime);
+
+/**
+ * @brief   Alarm description.
+ * @details The meaning of time depends on the alarm type:
+ *          - ALARM_TYPE_ONE_SHOT : absolute epoch time (seconds since 1970-01-01).
+ *          - ALARM_TYPE_WEEKDAY  : seconds since midnight.
+ *          - ALARM_TYPE_COUNTDOWN: seconds from now.
+ *          - ALARM_TYPE_INTERVAL : period in seconds, first fire one period from now.
+ */
+typedef struct
+{
+			Alarm_type_t          type;             /*!< Alarm type */
+			unsigned int          time;             /*!< Time value, see details */
+			unsigned char         weekdayMask;      /*!< Weekday mask for ALARM_TYPE_WEEKDAY */
+			unsigned char         RESERVE1[3];
+			Alarm_CallbackType    callback;         /*!< Notification, may be NULL */
+			void *                userData;         /*!< Passed back to the callback */
+} Alarm_EntryType;
+
+/**
+ * @brief   Configuration structure for the alarm scheduler.
+ */
+typedef struct
+{
+			Alarm_SetCompareType  setCompare;       /*!< Programs the RTC/timer compare, may be NULL */
+} Alarm_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the alarm scheduler.
+ *
+ * This function removes all alarms and sets the current scheduler time.
+ *
+ * @param[in] ConfigPtr Pointer to the alarm configuration structure.
+ * @param[in] now Current epoch time in seconds.
+ * @return ALARM_OK on success, ALARM_ERR_PARA on parameter error.
+ */
+Alarm_ret_t Alarm_Init(const Alarm_ConfigType * ConfigPtr, unsigned int now);
+
+/*!
+ * @brief Adds an alarm.
+ *
+ * The first fire time is computed from the time passed to the last Alarm_Init() or
+ * Alarm_Process() call. Complexity is O(log n).
+ *
+ * @param[in] EntryPtr Pointer to the alarm description.
+ * @param[out] IdPtr Identifier of the new alarm.
+ * @return ALARM_OK on success, ALARM_ERR_PARA or ALARM_ERR_FULL on error.
+ */
+Alarm_ret_t Alarm_Add(const Alarm_EntryType * EntryPtr, unsigned short * IdPtr);
+
+/*!
+ * @brief Removes an alarm.
+ *
+ * Complexity is O(log n).
+ *
+ * @param[in] id Identifier returned by Alarm_Add().
+ * @return ALARM_OK on success, ALARM_ERR_NOT_FOUND if the alarm is not in use.
+ */
+Alarm_ret_t Alarm_Remove(unsigned short id);
+
+/*!
+ * @brief Fires every alarm that is due.
+ *
+ * Call this from the RTC alarm / timer compare interrupt, or once per second. When no alarm is
+ * due the cost is a single comparison against the heap root. Each fired alarm costs O(log n);
+ * the recurrence of an alarm is only recomputed when it fires.
+ *
+ * @param[in] now Current epoch time in seconds.
+ * @return void.
+ */
+void Alarm_Process(unsigned int now);
+
+/*!
+ * @brief Returns the earliest pending fire time.
+ *
+ * @param[out] TimePtr Earliest fire time in epoch seconds.
+ * @return ALARM_OK when an alarm is pending, ALARM_ERR_NOT_FOUND otherwise.
+ */
+Alarm_ret_t Alarm_GetNextFireTime(unsigned int * TimePtr);
+
+/*!
+ * @brief Returns the number of alarms in use.
+ *
+ * @return Number of alarms in use.
+ */
+unsigned short Alarm_GetCount(void);
+
+#endif  /* ALARM_H */
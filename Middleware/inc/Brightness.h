@@ -0,0 +1,108 @@
+/****************************************************************************************************
+* @file     Brightness.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the display brightness service.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           setting the display brightness on a perceptual 0-100 scale and fading between levels.
+*           Levels are mapped to PWM duty through a gamma 2.2 table, and every fade step is loaded
+*           by the FTM at a reload point.
+* @version  1.0.0
+* @date     2024-11-02
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef BRIGHTNESS_H
+#define BRIGHTNESS_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftm.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define BRIGHTNESS_LEVEL_MAX            (100u)             /* Full brightness */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Brightness Return Status Type
+ */
+typedef enum
+{
+			BRIGHTNESS_OK       = 0U,       /**< Operation completed successfully. */
+			BRIGHTNESS_ERR_PARA = 1U,       /**< Parameter error */
+			BRIGHTNESS_ERR_PWM  = 2U,       /**< PWM could not be started */
+} Brightness_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the brightness service.
+ * @note    The fade step rate is the reload rate of the PWM:
+ *          frequencyHz / (reloadDivider + 1) of the FTM configuration.
+ */
+typedef struct
+{
+			const Ftm_ConfigType *  pwm;            /*!< PWM driving the display */
+			unsigned char           channel;        /*!< Channel of the display PWM */
+			unsigned char           initialLevel;   /*!< Level applied by Brightness_Init() */
+			unsigned char           RESERVE1[2];
+} Brightness_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the brightness service and starts the PWM.
+ *
+ * @param[in] ConfigPtr Pointer to the brightness configuration structure.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA or BRIGHTNESS_ERR_PWM on error.
+ * @note The PWM period follows Perf level changes through a Perf callback.
+ */
+Brightness_ret_t Brightness_Init(const Brightness_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Sets the brightness at the next reload point, cancelling a fade.
+ *
+ * @param[in] level Brightness, 0 to BRIGHTNESS_LEVEL_MAX.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA on parameter error.
+ */
+Brightness_ret_t Brightness_Set(unsigned char level);
+
+/*!
+ * @brief Starts a fade from the current brightness.
+ *
+ * @param[in] level Target brightness, 0 to BRIGHTNESS_LEVEL_MAX.
+ * @param[in] durationMs Fade duration; 0 sets the level immediately.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA on parameter error.
+ */
+Brightness_ret_t Brightness_FadeTo(unsigned char level, unsigned int durationMs);
+
+/*!
+ * @brief Advances a running fade.
+ *
+ * Call this from the main loop. One step is written per reload point; nothing is done
+ * between reload points.
+ *
+ * @return 1 while a fade is running, 0 otherwise.
+ * @note Polling slower than the reload rate stretches the fade, it never skips a step.
+ */
+unsigned char Brightness_Process(void);
+
+/*!
+ * @brief Gets the current brightness.
+ *
+ * @return Brightness, 0 to BRIGHTNESS_LEVEL_MAX, rounded down during a fade.
+ */
+unsigned char Brightness_GetLevel(void);
+
+#endif  /* BRIGHTNESS_H */
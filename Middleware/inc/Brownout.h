@@ -0,0 +1,139 @@
+/****************************************************************************************************
+* @file     Brownout.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the power-fail time snapshot.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           saving the software clock and the oscillator correction when the supply drops, and for
+*           restoring them at the next boot. On the low voltage warning the snapshot is programmed
+*           into a sector kept blank for it, two phrases, then the dirty settings are journaled
+*           with Kv_Flush() in the time left. Nothing is erased on the warning path: the sector is
+*           erased at boot when it is nearly full.
+* @version  1.0.0
+* @date     2024-11-13
+* @note     The time spent unpowered is unknown without a battery-backed clock, so the restored
+*           time lags by that much until the next synchronization; the hold-up time and the boot
+*           time are added. Usage:
+*               Ftfc_Init(), Calib_Init(), Dwt_Init(), SysTick running
+*               Brownout_Init(&config)          restores the time, before Kv_Process() runs
+*               Pmc_Init(&pmcConfig)            with Brownout_OnWarning() as the callback
+*               main loop: Brownout_Process()
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef BROWNOUT_H
+#define BROWNOUT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define BROWNOUT_RECORD_SIZE            (2u * FTFC_PHRASE_SIZE)
+#define BROWNOUT_SLOTS                  (FTFC_DFLASH_SECTOR_SIZE / BROWNOUT_RECORD_SIZE)
+#define BROWNOUT_SLOTS_MIN              (2u)               /* Erased at boot below: one save, one restore */
+
+/*** Record types ***/
+#define BROWNOUT_TYPE_SAVED             (0x53u)            /* Snapshot taken on the warning */
+#define BROWNOUT_TYPE_CONSUMED          (0x43u)            /* Snapshot restored, or supply recovered */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Brownout Return Status Type
+ */
+typedef enum
+{
+			BROWNOUT_OK         = 0U,       /**< Operation completed successfully. */
+			BROWNOUT_ERR_PARA   = 1U,       /**< Parameter error */
+			BROWNOUT_ERR_FLASH  = 2U,       /**< Sector erase failed, no snapshot can be saved */
+} Brownout_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the power-fail snapshot.
+ */
+typedef struct
+{
+			unsigned int            flashAddress;   /*!< FTFC command address of the sector, outside the Kv ring */
+			const unsigned char *   readPtr;        /*!< Same sector in the memory map */
+			unsigned int            holdupUs;       /*!< Typical time from the warning to the reset */
+			unsigned short          kvPhrases;      /*!< Kv_Flush() budget, 0 to skip the settings */
+			unsigned char           RESERVE1[2];
+} Brownout_ConfigType;
+
+/**
+ * @brief   Power-fail statistics.
+ * @details The cycle counts start when Brownout_OnWarning() is entered; the hold-up time must
+ *          cover them at the slowest flash timing.
+ */
+typedef struct
+{
+			unsigned int   saves;               /*!< Warnings handled since boot */
+			unsigned int   snapshotCycles;      /*!< Last warning: snapshot programmed */
+			unsigned int   totalCycles;         /*!< Last warning: settings journaled too */
+			unsigned int   worstCycles;         /*!< Longest totalCycles */
+			unsigned int   lost;                /*!< Snapshots not saved: sector full or flash error */
+			unsigned char  keysLeft;            /*!< Last warning: settings Kv_Flush() could not write */
+			unsigned char  restored;            /*!< 1 when the time was restored at boot */
+			unsigned char  RESERVE1[2];
+} Brownout_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Restores the snapshot left by the last power failure.
+ *
+ * This function finds the last record of the sector. A snapshot not restored yet sets the
+ * software clock to the saved time plus the hold-up time plus the time since Calib_Init(), and
+ * the oscillator correction to the saved one; then it is marked as restored. The sector is erased
+ * when fewer than BROWNOUT_SLOTS_MIN records fit, which stalls the boot for one sector erase.
+ * The statistics are served to the serial protocol as PROTO_CMD_GET_POWER.
+ *
+ * @param[in] ConfigPtr Pointer to the snapshot configuration structure.
+ * @return BROWNOUT_OK on success, BROWNOUT_ERR_PARA or BROWNOUT_ERR_FLASH on error.
+ * @note The flash must be idle; call before the first Kv_Process().
+ */
+Brownout_ret_t Brownout_Init(const Brownout_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Low voltage warning callback: saves the snapshot, then the dirty settings.
+ *
+ * Stops the flash command in progress, programs the snapshot with polled commands and calls
+ * Kv_Flush(). Takes about (2 + kvPhrases) phrase program times, plus one erase suspend.
+ *
+ * @return void.
+ * @note Runs in LVD_LVW_IRQHandler, above every user of the settings and below SysTick.
+ */
+void Brownout_OnWarning(void);
+
+/*!
+ * @brief Rearms the warning once the supply has recovered.
+ *
+ * The snapshot of a warning that was not followed by a reset is marked as consumed, so that it
+ * is not restored at a later reset. Call from the main loop, next to Kv_Process().
+ *
+ * @return void.
+ */
+void Brownout_Process(void);
+
+/*!
+ * @brief Retrieves the power-fail statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return BROWNOUT_OK on success, BROWNOUT_ERR_PARA on parameter error.
+ */
+Brownout_ret_t Brownout_GetStats(Brownout_StatsType * StatsPtr);
+
+#endif  /* BROWNOUT_H */
@@ -0,0 +1,156 @@
+/****************************************************************************************************
+* @file     Calib.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the clock calibration service.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           measuring the core clock against a reference (SOSC, the RTC 32 kHz clock or an external
+*           1PPS edge) and correcting the tick-to-time conversion of the software clock.
+* @version  1.0.0
+* @date     2024-10-22
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef CALIB_H
+#define CALIB_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Fixed point constants ***/
+#define CALIB_NS_PER_SECOND             (1000000000u)      /* Nanoseconds in one second */
+#define CALIB_PPB_PER_UNIT              (1000000000u)      /* Parts per billion of a ratio of 1 */
+#define CALIB_MAX_PPB                   (1000000)          /* Largest accepted error (1000 ppm) */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Calibration Return Status Type
+ */
+typedef enum
+{
+			CALIB_OK            = 0U,       /**< Operation completed successfully. */
+			CALIB_ERR_PARA      = 1U,       /**< Parameter error */
+			CALIB_ERR_RANGE     = 2U,       /**< Measured error outside CALIB_MAX_PPB, sample rejected */
+} Calib_ret_t;
+
+/**
+ * @brief     Calibration reference
+ * @details   Informative only; the reference is described by its edge frequency.
+ */
+typedef enum
+{
+			CALIB_REF_SOSC      = 0U,       /**< Edges derived from the system oscillator (e.g. LPTMR compare) */
+			CALIB_REF_RTC_32K   = 1U,       /**< Edges derived from the 32 kHz RTC clock */
+			CALIB_REF_1PPS      = 2U,       /**< External one pulse per second edge */
+} Calib_reference_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the calibration service.
+ * @note    The measured counter is normally the DWT cycle counter, so counterFreqHz is the nominal
+ *          core clock. SysTick runs from the same clock, so its error is the same.
+ */
+typedef struct
+{
+			Calib_reference_t reference;            /*!< Reference source */
+			unsigned int      counterFreqHz;        /*!< Nominal frequency of the measured counter (Hz) */
+			unsigned int      refEdgeFreqHz;        /*!< Reference edges per second */
+			unsigned int      windowEdges;          /*!< Reference periods per measurement window */
+			unsigned int      tickPeriodNs;         /*!< Nominal software clock tick (SysTick period, ns) */
+			unsigned char     filterShift;          /*!< Smoothing of successive estimates, 0 = none */
+			unsigned char     RESERVE1[3];
+} Calib_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the calibration service.
+ *
+ * The correction starts at 0 ppb and the software clock at 0 seconds.
+ *
+ * @param[in] ConfigPtr Pointer to the calibration configuration structure.
+ * @return CALIB_OK on success, CALIB_ERR_PARA on parameter error.
+ */
+Calib_ret_t Calib_Init(const Calib_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Records one reference edge.
+ *
+ * Call this from the reference interrupt with the counter value captured as early as possible.
+ * When a measurement window completes, the error estimate and the tick increment are updated.
+ *
+ * @param[in] counterStamp Counter value (e.g. DWT->CYCCNT) at the reference edge.
+ * @return CALIB_OK, or CALIB_ERR_RANGE when a completed window was rejected.
+ */
+Calib_ret_t Calib_OnReferenceEdge(unsigned int counterStamp);
+
+/*!
+ * @brief Restarts the measurement window.
+ *
+ * Call this when the reference was lost, so that a gap is not counted as a long period.
+ *
+ * @return void.
+ */
+void Calib_RestartWindow(void);
+
+/*!
+ * @brief Advances the software clock by one corrected tick.
+ *
+ * Call this from the SysTick interrupt.
+ *
+ * @return void.
+ */
+void Calib_Tick(void);
+
+/*!
+ * @brief Retrieves the software clock.
+ *
+ * Safe from any context: it never waits for Calib_Tick(), even from a higher priority.
+ *
+ * @param[out] SecondsPtr Seconds part.
+ * @param[out] NanosecondsPtr Nanoseconds part, may be NULL.
+ * @return void.
+ */
+void Calib_GetTime(unsigned int * SecondsPtr, unsigned int * NanosecondsPtr);
+
+/*!
+ * @brief Sets the software clock.
+ *
+ * Masks interrupts for a few instructions, so that Calib_Tick() does not write the same buffer.
+ *
+ * @param[in] seconds Seconds part.
+ * @param[in] nanoseconds Nanoseconds part (< 1e9).
+ * @return void.
+ */
+void Calib_SetTime(unsigned int seconds, unsigned int nanoseconds);
+
+/*!
+ * @brief Retrieves the estimated oscillator error.
+ *
+ * @return Error in parts per billion; positive when the oscillator runs fast.
+ */
+int32 Calib_GetPpb(void);
+
+/*!
+ * @brief Sets the oscillator error, e.g. from a value stored in flash.
+ *
+ * @param[in] ppb Error in parts per billion; positive when the oscillator runs fast.
+ * @return CALIB_OK on success, CALIB_ERR_RANGE when outside CALIB_MAX_PPB.
+ */
+Calib_ret_t Calib_SetPpb(int32 ppb);
+
+#endif  /* CALIB_H */
@@ -0,0 +1,144 @@
+/****************************************************************************************************
+* @file     Discipline.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the clock discipline loop.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           steering the software clock of Calib.h to an external time reference (the serial
+*           time sync, 1PPS, GPS or Tsync.h). Every reference gives an offset sample, reference
+*           time minus software clock. Spikes are rejected against the median of the recent
+*           samples; the others feed a proportional-integral loop which slews the clock by changing
+*           the Calib tick-to-time rate, so the time never jumps, unless the offset is above the
+*           step threshold. After a step the frequency is measured from the next sample before the
+*           loop starts. The loop reports its lock state and an error estimate made of the last
+*           offset, the sample jitter and the drift since the last sample.
+* @version  1.0.0
+* @date     2024-11-15
+* @note     The module owns the Calib correction: Calib_OnReferenceEdge() must not run at the same
+*           time. Discipline_AddSample(), Discipline_Process() and Discipline_GetStatus() are called
+*           from the same context, e.g. the main loop.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef DISCIPLINE_H
+#define DISCIPLINE_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Calib.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define DISCIPLINE_HISTORY              (8u)               /* Samples in the median of the spike filter */
+#define DISCIPLINE_REJECT_MAX           (4u)               /* Consecutive spikes taken as a real change */
+#define DISCIPLINE_STEP_COUNT           (3u)               /* Consecutive samples above the step threshold */
+#define DISCIPLINE_LOCK_COUNT           (4u)               /* Consecutive samples below the lock threshold */
+#define DISCIPLINE_JITTER_MIN_NS        (1000u)            /* Floor of the spike threshold */
+#define DISCIPLINE_WANDER_PPB           (100u)             /* Drift assumed for the error estimate */
+#define DISCIPLINE_ERROR_UNKNOWN        (0xFFFFFFFFu)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Discipline Return Status Type
+ */
+typedef enum
+{
+			DISCIPLINE_OK           = 0U,   /**< Sample used */
+			DISCIPLINE_ERR_PARA     = 1U,   /**< Parameter error */
+			DISCIPLINE_REJECTED     = 2U,   /**< Sample taken as a spike */
+			DISCIPLINE_STEPPED      = 3U,   /**< Software clock stepped by the offset */
+} Discipline_ret_t;
+
+/**
+ * @brief     Lock state.
+ */
+typedef enum
+{
+			DISCIPLINE_UNSET        = 0U,   /**< No sample yet, the time is not set */
+			DISCIPLINE_FREQ         = 1U,   /**< Time set, measuring the frequency */
+			DISCIPLINE_TRACKING     = 2U,   /**< Slewing, offset above the lock threshold */
+			DISCIPLINE_LOCKED       = 3U,   /**< Offset below the lock threshold */
+			DISCIPLINE_HOLDOVER     = 4U,   /**< Reference lost, running on the frequency estimate */
+} Discipline_state_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the discipline loop.
+ * @note    The sample interval should be well below the time constant.
+ */
+typedef struct
+{
+			unsigned int    timeConstantS;      /*!< Loop time constant in seconds, 1 - 4096 */
+			unsigned int    stepThresholdNs;    /*!< Offsets above this are stepped, not slewed */
+			unsigned int    lockThresholdNs;    /*!< Locked below this offset */
+			unsigned int    holdoverS;          /*!< Holdover after this long without a sample */
+			unsigned char   outlierFactor;      /*!< Spike when farther from the median than this many jitters */
+			unsigned char   RESERVE1[3];
+} Discipline_ConfigType;
+
+/**
+ * @brief   Loop status.
+ */
+typedef struct
+{
+			Discipline_state_t  state;          /*!< Lock state */
+			int32               offsetNs;       /*!< Last used offset, saturated */
+			unsigned int        jitterNs;       /*!< Mean distance of the samples from their median */
+			int32               freqPpb;        /*!< Estimated oscillator error */
+			unsigned int        errorNs;        /*!< Estimated clock error, DISCIPLINE_ERROR_UNKNOWN before the first sample */
+			unsigned int        samples;        /*!< Samples used */
+			unsigned int        rejected;       /*!< Samples rejected as spikes */
+			unsigned int        steps;          /*!< Clock steps */
+} Discipline_StatusType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the discipline loop.
+ *
+ * The frequency estimate starts from Calib_GetPpb(), e.g. a value restored from flash.
+ *
+ * @param[in] ConfigPtr Pointer to the configuration structure.
+ * @return DISCIPLINE_OK on success, DISCIPLINE_ERR_PARA on parameter error.
+ */
+Discipline_ret_t Discipline_Init(const Discipline_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Feeds one offset sample.
+ *
+ * @param[in] localNs Software clock when the reference was taken, in nanoseconds.
+ * @param[in] offsetNs Reference time minus software clock at that moment.
+ * @return DISCIPLINE_OK, DISCIPLINE_REJECTED or DISCIPLINE_STEPPED, DISCIPLINE_ERR_PARA on error.
+ */
+Discipline_ret_t Discipline_AddSample(uint64 localNs, int64 offsetNs);
+
+/*!
+ * @brief Enters holdover when the reference was lost.
+ *
+ * The phase correction is dropped and the clock runs on the frequency estimate. Call
+ * periodically, e.g. once a second.
+ *
+ * @return void.
+ */
+void Discipline_Process(void);
+
+/*!
+ * @brief Retrieves the loop status.
+ *
+ * @param[out] StatusPtr Pointer to the status structure.
+ * @return DISCIPLINE_OK on success, DISCIPLINE_ERR_PARA on parameter error.
+ */
+Discipline_ret_t Discipline_GetStatus(Discipline_StatusType * StatusPtr);
+
+#endif  /* DISCIPLINE_H */
@@ -0,0 +1,178 @@
+/****************************************************************************************************
+* @file     Kv.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the settings store.
+* @details  This header file contains the definitions, structures, and function prototypes for a
+*           log-structured key-value store in the D-Flash. Every value lives in RAM; a write only
+*           marks the key dirty when the value changed, and Kv_Process() appends the dirty keys to
+*           the flash one phrase at a time in the background. Sectors are used in a ring, so the
+*           erases are spread evenly; the oldest sector is compacted by rewriting its live keys
+*           from RAM before it is erased. Kv_Init() rebuilds the RAM image in one scan.
+*           Intended for the alarm list, the time zone, the brightness and the calibration, each
+*           under its own key.
+* @version  1.0.0
+* @date     2024-11-12
+* @note     Kv_Read(), Kv_Write() and Kv_Process() must be called from the same context, e.g. the
+*           main loop. The FTFC driver is initialized by the application with Kv_OnFlashDone() as
+*           its callback. A record is durable once Kv_IsIdle() returns 1 after the write.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef KV_H
+#define KV_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Ftfc.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Build options ***/
+#ifndef KV_KEY_COUNT
+#define KV_KEY_COUNT                    (16u)              /* Keys 0 .. KV_KEY_COUNT - 1, at most 32 */
+#endif
+#ifndef KV_VALUE_MAX
+#define KV_VALUE_MAX                    (32u)              /* Longest value in bytes */
+#endif
+
+/*** Flash layout ***/
+#define KV_SECTOR_SIZE                  (FTFC_DFLASH_SECTOR_SIZE)
+#define KV_SECTOR_MAX                   (FTFC_DFLASH_SIZE / FTFC_DFLASH_SECTOR_SIZE)
+#define KV_SECTOR_MAGIC                 (0x3153564Bu)      /* "KVS1", first word of a sector in use */
+#define KV_RECORD_MARK                  (0x4Bu)            /* Byte 6 of a record header */
+#define KV_RECORD_BYTES(LEN)            (FTFC_PHRASE_SIZE + (((LEN) + FTFC_PHRASE_SIZE - 1u) & ~(FTFC_PHRASE_SIZE - 1u)))
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Kv Return Status Type
+ */
+typedef enum
+{
+			KV_OK               = 0U,       /**< Operation completed successfully. */
+			KV_ERR_PARA         = 1U,       /**< Parameter error */
+			KV_ERR_NOT_FOUND    = 2U,       /**< Key never written */
+} Kv_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the store.
+ */
+typedef struct
+{
+			unsigned int            flashAddress;   /*!< FTFC command address of the first sector */
+			const unsigned char *   readPtr;        /*!< Same area in the memory map */
+			unsigned char           sectorCount;    /*!< Sectors of the ring, at least 2 */
+} Kv_ConfigType;
+
+/**
+ * @brief   Store statistics.
+ */
+typedef struct
+{
+			unsigned int   records;             /*!< Records appended, relocations included */
+			unsigned int   relocations;         /*!< Records rewritten to free the oldest sector */
+			unsigned int   erases;              /*!< Sectors erased */
+			unsigned int   unchanged;           /*!< Writes dropped because the value did not change */
+			unsigned int   damaged;             /*!< Torn records skipped by Kv_Init() */
+			unsigned int   flashErrors;         /*!< Flash commands that failed */
+} Kv_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Mounts the store.
+ *
+ * This function reads the sector headers, then scans the records of the sectors in use from the
+ * oldest to the newest, so the last valid record of a key wins. Torn records left by a power
+ * loss are skipped; sectors that are neither in use nor blank are erased later by Kv_Process().
+ *
+ * @param[in] ConfigPtr Pointer to the store configuration structure.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ * @note The flash must be idle.
+ */
+Kv_ret_t Kv_Init(const Kv_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Reads a value from RAM.
+ *
+ * @param[in] key Key.
+ * @param[out] DataPtr Value.
+ * @param[in] maxLength Size of DataPtr; a longer value is truncated.
+ * @param[out] LengthPtr Value length, may be NULL.
+ * @return KV_OK on success, KV_ERR_PARA or KV_ERR_NOT_FOUND on error.
+ */
+Kv_ret_t Kv_Read(unsigned char key, unsigned char * DataPtr, unsigned char maxLength, unsigned char * LengthPtr);
+
+/*!
+ * @brief Writes a value.
+ *
+ * The value is copied to RAM and the call returns; an unchanged value is not journaled.
+ *
+ * @param[in] key Key.
+ * @param[in] DataPtr Value.
+ * @param[in] length Value length, at most KV_VALUE_MAX.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ */
+Kv_ret_t Kv_Write(unsigned char key, const unsigned char * DataPtr, unsigned char length);
+
+/*!
+ * @brief Advances the background work by at most one flash command.
+ *
+ * Call from the main loop. Never waits for the flash.
+ *
+ * @return void.
+ */
+void Kv_Process(void);
+
+/*!
+ * @brief Journals the dirty keys at once, for a power failure.
+ *
+ * This function stops the flash command in progress with Ftfc_Suspend(), then finishes the
+ * record in progress and appends the dirty keys in key order with polled commands, until all are
+ * written or maxPhrases phrases are spent. It never erases, and it leaves the last blank sector to
+ * the compaction, so it takes at most maxPhrases phrase program times. Kv_Process() carries on
+ * afterwards; a suspended erase is started again.
+ *
+ * @param[in] maxPhrases Phrases that may be programmed.
+ * @return Number of keys not in the flash yet.
+ * @note The caller may interrupt Kv_Write() and Kv_Process() only when these run under a lock
+ *       that masks it, e.g. SRP_LOCK(MAIN, SETTINGS) with the caller a user of SETTINGS.
+ */
+unsigned char Kv_Flush(unsigned short maxPhrases);
+
+/*!
+ * @brief Tells whether every written value is in the flash.
+ *
+ * @return 1 when nothing is left to journal, 0 otherwise.
+ */
+unsigned char Kv_IsIdle(void);
+
+/*!
+ * @brief FTFC command complete callback.
+ *
+ * @param[in] result Result of the command.
+ * @return void.
+ */
+void Kv_OnFlashDone(Ftfc_ret_t result);
+
+/*!
+ * @brief Retrieves the store statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ */
+Kv_ret_t Kv_GetStats(Kv_StatsType * StatsPtr);
+
+#endif  /* KV_H */
@@ -0,0 +1,163 @@
+/****************************************************************************************************
+* @file     Log.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the deferred binary log.
+* @details  This header file contains the macros and function prototypes for logging from any
+*           context, interrupts included. A log call stores the address of its format string, a
+*           cycle counter timestamp and up to four integer arguments in a RAM ring; formatting is
+*           done on the host by Tools/logdecode.py, which reads the strings from the ELF file.
+*           Log_Process() drains the ring over an LPUART in the background.
+* @version  1.0.0
+* @date     2024-11-06
+* @note     The format strings live in the section ".logstr", which must not be loaded. Add to
+*           the linker script, outside the memory regions:
+*               .logstr 0 (INFO) : { KEEP(*(.logstr*)) }
+*           Only integer conversions are supported (%d %u %x %X %c %p); %s prints a string
+*           stored in flash, looked up in the ELF file. Timestamps need Dwt_Init().
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef LOG_H
+#define LOG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpuart.h"
+#include "Dwt.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Levels ***/
+#define LOG_LEVEL_ERROR                 (0u)
+#define LOG_LEVEL_WARN                  (1u)
+#define LOG_LEVEL_INFO                  (2u)
+#define LOG_LEVEL_DEBUG                 (3u)
+#define LOG_LEVEL_INTERNAL              (7u)               /* Records made by the log itself */
+
+/* Calls above this level are removed at compile time */
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX                   LOG_LEVEL_INFO
+#endif
+
+/*** Record: header word, timestamp word, argument words ***/
+#define LOG_MAX_ARGS                    (4u)
+#define LOG_RECORD_MAX_WORDS            (2u + LOG_MAX_ARGS)
+#define LOG_HEADER_VALID_SHIFT          (31u)              /* Record committed */
+#define LOG_HEADER_LEVEL_SHIFT          (28u)
+#define LOG_HEADER_NARGS_SHIFT          (24u)
+#define LOG_HEADER_ID_MASK              (0x00FFFFFFu)      /* Format string offset in .logstr */
+#define LOG_ID_DROPPED                  (0u)               /* LOG_LEVEL_INTERNAL: argument = records lost */
+
+/*** Output frame: COBS of [LOG_FRAME_TAG] [record words, little-endian] ***/
+#define LOG_FRAME_TAG                   (0xA5u)
+#define LOG_FRAME_MAX                   (1u + (4u * LOG_RECORD_MAX_WORDS))
+
+#define LOG_SECTION                     ".logstr"
+
+#define LOG_HEADER(LEVEL, FMT, NARGS)   (((unsigned int)ENABLEMENT << LOG_HEADER_VALID_SHIFT) | \
+                                         ((unsigned int)(LEVEL) << LOG_HEADER_LEVEL_SHIFT) | \
+                                         ((unsigned int)(NARGS) << LOG_HEADER_NARGS_SHIFT) | \
+                                         ((unsigned int)(FMT) & LOG_HEADER_ID_MASK))
+
+/* Number of variadic arguments, 0 to 4 */
+#define LOG_NARGS(...)                  LOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(Z, A, B, C, D, N, ...)   N
+#define LOG_CAT(A, B)                   LOG_CAT_(A, B)
+#define LOG_CAT_(A, B)                  A##B
+
+/**
+ * @brief Logs a message with up to four integer arguments.
+ *
+ * The format string is not stored in flash; only its .logstr offset reaches the ring.
+ */
+#define LOG(LEVEL, FMT, ...)                                                                        \
+		do                                                                                          \
+		{                                                                                           \
+			if ((LEVEL) <= LOG_LEVEL_MAX)                                                           \
+			{                                                                                       \
+				static const char Log_Fmt[] __attribute__((section(LOG_SECTION))) = FMT;            \
+				LOG_CAT(Log_Write, LOG_NARGS(__VA_ARGS__))(                                         \
+				        LOG_HEADER(LEVEL, Log_Fmt, LOG_NARGS(__VA_ARGS__)), ##__VA_ARGS__);         \
+			}                                                                                       \
+		} while (0)
+
+#define LOG_ERROR(FMT, ...)             LOG(LOG_LEVEL_ERROR, FMT, ##__VA_ARGS__)
+#define LOG_WARN(FMT, ...)              LOG(LOG_LEVEL_WARN, FMT, ##__VA_ARGS__)
+#define LOG_INFO(FMT, ...)              LOG(LOG_LEVEL_INFO, FMT, ##__VA_ARGS__)
+#define LOG_DEBUG(FMT, ...)             LOG(LOG_LEVEL_DEBUG, FMT, ##__VA_ARGS__)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Log Return Status Type
+ */
+typedef enum
+{
+			LOG_OK              = 0U,       /**< Operation completed successfully. */
+			LOG_ERR_PARA        = 1U,       /**< Parameter error */
+} Log_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the log.
+ */
+typedef struct
+{
+			unsigned char       uart;           /*!< LPUART instance, already initialized */
+			unsigned int *      buffer;         /*!< Ring storage */
+			unsigned int        bufferWords;    /*!< Ring size in words, a power of two */
+} Log_ConfigType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the log.
+ *
+ * Log calls made before are dropped silently.
+ *
+ * @param[in] ConfigPtr Pointer to the log configuration structure.
+ * @return LOG_OK on success, LOG_ERR_PARA on parameter error.
+ */
+Log_ret_t Log_Init(const Log_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Sends the committed records over the LPUART.
+ *
+ * Call from the main loop or the lowest priority task. Stops at a record still being written
+ * by an interrupted log call, and when the transmit ring is full.
+ *
+ * @return Number of records sent.
+ */
+unsigned int Log_Process(void);
+
+/*!
+ * @brief Gets the number of records lost because the ring was full.
+ *
+ * @return Records dropped since Log_Init().
+ */
+unsigned int Log_GetDropped(void);
+
+/*!
+ * @brief Stores a record, used by LOG().
+ *
+ * @param[in] header Record header, see LOG_HEADER().
+ * @return void.
+ */
+void Log_Write0(unsigned int header);
+void Log_Write1(unsigned int header, unsigned int arg0);
+void Log_Write2(unsigned int header, unsigned int arg0, unsigned int arg1);
+void Log_Write3(unsigned int header, unsigned int arg0, unsigned int arg1, unsigned int arg2);
+void Log_Write4(unsigned int header, unsigned int arg0, unsigned int arg1, unsigned int arg2, unsigned int arg3);
+
+#endif  /* LOG_H */
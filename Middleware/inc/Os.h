@@ -0,0 +1,303 @@
+/****************************************************************************************************
+* @file     Os.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the preemptive kernel.
+* @details  This header file contains the definitions, structures, and function prototypes for a
+*           small fixed-priority preemptive kernel. The highest priority ready task always runs;
+*           tasks of equal priority share the CPU in round robin, one tick each. Tasks block on
+*           sleeps and event flags. The kernel core is portable; Os_Port.h selects the Cortex-M4
+*           port (SysTick + PendSV) or, with OS_PORT_HOST defined, the Linux ucontext port used to
+*           test scheduling on the host.
+* @version  1.0.0
+* @date     2024-11-08
+* @note     SysTick must be initialized by the application with its interrupt enabled; its period
+*           is the kernel tick. Delay_Timer() busy-waits and must not be used once the kernel runs.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef OS_H
+#define OS_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Priorities: higher value runs first, 0 is reserved for the idle task ***/
+#define OS_PRIORITY_COUNT               (8u)
+#define OS_PRIORITY_IDLE                (0u)
+#define OS_PRIORITY_MAX                 (OS_PRIORITY_COUNT - 1u)
+
+/*** Timeouts in ticks ***/
+#define OS_NO_WAIT                      (0u)
+#define OS_WAIT_FOREVER                 (0xFFFFFFFFu)
+
+/*** Os_EventWait() options ***/
+#define OS_EVENT_ANY                    (0x0u)             /* Any flag of the mask */
+#define OS_EVENT_ALL                    (0x1u)             /* Every flag of the mask */
+#define OS_EVENT_CLEAR                  (0x2u)             /* Clear the matched flags on return */
+
+/*** Smallest stack accepted by Os_TaskCreate(), in words ***/
+#ifndef OS_STACK_MIN_WORDS
+#define OS_STACK_MIN_WORDS              (64u)
+#endif
+
+/*** Stack canary test on every switch; the host port keeps its context at the stack base ***/
+#ifndef OS_STACK_CHECK
+#if defined(OS_PORT_HOST)
+#define OS_STACK_CHECK                  (0u)
+#else
+#define OS_STACK_CHECK                  (1u)
+#endif
+#endif
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Os Return Status Type
+ */
+typedef enum
+{
+			OS_OK               = 0U,       /**< Operation completed successfully. */
+			OS_ERR_PARA         = 1U,       /**< Parameter error */
+			OS_ERR_TIMEOUT      = 2U,       /**< Timeout before the condition was met */
+			OS_ERR_ISR          = 3U,       /**< Blocking call made outside a task */
+} Os_ret_t;
+
+/**
+ * @brief     Task states.
+ */
+typedef enum
+{
+			OS_TASK_READY       = 0U,       /**< Running or waiting for the CPU */
+			OS_TASK_BLOCKED     = 1U,       /**< Sleeping or waiting for event flags */
+			OS_TASK_ENDED       = 2U,       /**< Entry function returned */
+} Os_state_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Task entry function.
+ */
+typedef void (*Os_EntryType)(void * arg);
+
+/**
+ * @brief   Task control block, allocated by the application.
+ * @note    sp must stay the first member, the context switch stores the stack pointer there.
+ */
+typedef struct Os_Task
+{
+			void *                  sp;             /*!< Saved stack pointer */
+			struct Os_Task *        next;           /*!< Ready list link */
+			struct Os_Task *        sleepNext;      /*!< Timeout list link */
+			struct Os_Task *        waitNext;       /*!< Event wait list link */
+			unsigned int            wakeTick;       /*!< Tick at which a sleep or a timeout ends */
+			unsigned int            waitMask;       /*!< Event flags waited for */
+			unsigned int            waitResult;     /*!< Event flags seen when released, 0 on timeout */
+			unsigned char           priority;       /*!< 1 .. OS_PRIORITY_MAX */
+			unsigned char           state;          /*!< Os_state_t */
+			unsigned char           waitOptions;    /*!< OS_EVENT_ options */
+			unsigned char           sleeping;       /*!< In the timeout list */
+			struct Os_Event *       waitEvent;      /*!< Event flags group waited on, NULL when none */
+			unsigned int *          stack;          /*!< Stack base, for stack checks */
+			unsigned int            stackWords;     /*!< Stack size */
+} Os_TaskType;
+
+/**
+ * @brief   Task configuration.
+ */
+typedef struct
+{
+			Os_EntryType            entry;          /*!< Task function */
+			void *                  arg;            /*!< Argument passed to entry */
+			unsigned int *          stack;          /*!< Stack memory, 8-byte aligned */
+			unsigned int            stackWords;     /*!< Stack size in words */
+			unsigned char           priority;       /*!< 1 .. OS_PRIORITY_MAX */
+} Os_TaskConfigType;
+
+/**
+ * @brief   Event flags group.
+ */
+typedef struct Os_Event
+{
+			volatile unsigned int   flags;          /*!< Current flags */
+			Os_TaskType *           waiters;        /*!< Tasks blocked in Os_EventWait() */
+} Os_EventType;
+
+/**
+ * @brief   Kernel configuration.
+ */
+typedef struct
+{
+			void (*idleHook)(void);                 /*!< Called in a loop by the idle task, NULL: WFI */
+			unsigned int *          idleStack;      /*!< Idle task stack */
+			unsigned int            idleStackWords; /*!< Idle task stack size in words */
+			void (*overflowHook)(Os_TaskType * TaskPtr);    /*!< Stack canary of a task overwritten, NULL: halt */
+			void (*tickHook)(void);                 /*!< Called first in every kernel tick, e.g. Calib_Tick(), NULL: none */
+} Os_ConfigType;
+
+/**
+ * @brief   Kernel statistics, in cycles of the port counter (DWT on the target).
+ * @details Switch times are measured from the request to the return of the blocking call in the
+ *          task that is switched in; requests from an interrupt give the interrupt-to-task latency.
+ */
+typedef struct
+{
+			unsigned int            switches;           /*!< Context switches */
+			unsigned int            switchCycles;       /*!< Last task-to-task switch */
+			unsigned int            switchCyclesMax;    /*!< Worst task-to-task switch */
+			unsigned int            latencyCycles;      /*!< Last interrupt-to-task latency */
+			unsigned int            latencyCyclesMax;   /*!< Worst interrupt-to-task latency */
+} Os_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the kernel and creates the idle task.
+ *
+ * @param[in] ConfigPtr Pointer to the kernel configuration structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_Init(const Os_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Creates a task, ready to run.
+ *
+ * May be called before or after Os_Start(). The stack is painted for Stack_GetUsage(); its
+ * lowest word holds the canary tested when the task is switched out.
+ *
+ * @param[out] TaskPtr Task control block.
+ * @param[in] ConfigPtr Pointer to the task configuration structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_TaskCreate(Os_TaskType * TaskPtr, const Os_TaskConfigType * ConfigPtr);
+
+/*!
+ * @brief Starts scheduling with the highest priority task.
+ *
+ * @return Does not return on the target. The host port returns after Os_PortHostStop().
+ */
+void Os_Start(void);
+
+/*!
+ * @brief Advances the kernel time by one tick.
+ *
+ * Called by the port from the SysTick interrupt. Calls the tick hook, wakes the tasks whose
+ * sleep or timeout ended and rotates the tasks of the running priority.
+ *
+ * @return void.
+ */
+void Os_Tick(void);
+
+/*!
+ * @brief Gets the number of ticks since Os_Start().
+ *
+ * @return Tick count, wrapping at 2^32.
+ */
+unsigned int Os_GetTicks(void);
+
+/*!
+ * @brief Gets the running task.
+ *
+ * @return Task control block of the caller, NULL before Os_Start().
+ */
+Os_TaskType * Os_GetCurrent(void);
+
+/*!
+ * @brief Gives the CPU to the next ready task of the same priority.
+ *
+ * @return void.
+ */
+void Os_Yield(void);
+
+/*!
+ * @brief Blocks the calling task for a number of ticks.
+ *
+ * @param[in] ticks Ticks to sleep, 0 yields.
+ * @return OS_OK on success, OS_ERR_ISR when not called from a task.
+ */
+Os_ret_t Os_Sleep(unsigned int ticks);
+
+/*!
+ * @brief Blocks the calling task until a periodic release time.
+ *
+ * The release times do not drift with the execution time of the task. A release time already
+ * in the past returns at once.
+ *
+ * @param[in,out] LastWakePtr Previous release tick, advanced by period.
+ * @param[in] period Period in ticks.
+ * @return OS_OK on success, OS_ERR_PARA or OS_ERR_ISR on error.
+ */
+Os_ret_t Os_SleepUntil(unsigned int * LastWakePtr, unsigned int period);
+
+/*!
+ * @brief Ends the calling task.
+ *
+ * A task whose entry function returns ends the same way.
+ *
+ * @return Does not return.
+ */
+void Os_TaskExit(void);
+
+/*!
+ * @brief Initializes an event flags group with all flags cleared.
+ *
+ * @param[out] EventPtr Event flags group.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventInit(Os_EventType * EventPtr);
+
+/*!
+ * @brief Sets event flags and releases the tasks waiting for them.
+ *
+ * Callable from interrupts. The switch to a released task of higher priority happens when the
+ * last interrupt returns.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] flags Flags to set.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventSet(Os_EventType * EventPtr, unsigned int flags);
+
+/*!
+ * @brief Clears event flags.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] flags Flags to clear.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventClear(Os_EventType * EventPtr, unsigned int flags);
+
+/*!
+ * @brief Waits for event flags.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] mask Flags waited for.
+ * @param[in] options OS_EVENT_ANY or OS_EVENT_ALL, optionally with OS_EVENT_CLEAR.
+ * @param[in] timeout Ticks to wait, OS_NO_WAIT or OS_WAIT_FOREVER.
+ * @param[out] FlagsPtr Flags seen when the condition was met, may be NULL.
+ * @return OS_OK when the condition was met, OS_ERR_TIMEOUT, OS_ERR_PARA or OS_ERR_ISR otherwise.
+ */
+Os_ret_t Os_EventWait(Os_EventType * EventPtr, unsigned int mask, unsigned char options,
+                      unsigned int timeout, unsigned int * FlagsPtr);
+
+/*!
+ * @brief Retrieves the kernel statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_GetStats(Os_StatsType * StatsPtr);
+
+#endif  /* OS_H */
@@ -0,0 +1,132 @@
+/****************************************************************************************************
+* @file     Os_Port.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the kernel port layer.
+* @details  This header file contains the interface between the portable kernel (Os.c) and the
+*           processor: stack frame creation, the first task start, switch requests and critical
+*           sections. Os_Port_Cm4.c implements it for the Cortex-M4F with PendSV; Os_Port_Host.c
+*           implements it with ucontext when OS_PORT_HOST is defined, so the scheduler can be unit
+*           tested on Linux.
+* @version  1.0.0
+* @date     2024-11-08
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef OS_PORT_H
+#define OS_PORT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Os.h"
+
+#if !defined(OS_PORT_HOST)
+#include "Cpu.h"
+#include "Dwt.h"
+#endif
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#if !defined(OS_PORT_HOST)
+/*** Cortex-M4 ***/
+#define OS_ENTER_CRITICAL()             Cpu_EnterCritical()
+#define OS_EXIT_CRITICAL(STATE)         Cpu_ExitCritical(STATE)
+#define OS_PORT_CYCLES()                DWT_GET_CYCLES()
+
+#define OS_PORT_INITIAL_XPSR            (0x01000000u)      /* Thumb state */
+#define OS_PORT_EXC_RETURN_THREAD_PSP   (0xFFFFFFFDu)      /* Thread mode, PSP, no FP frame */
+#define OS_PORT_EXC_RETURN_FTYPE_SHIFT  (4u)               /* 0: the frame holds the FP registers */
+#define OS_PORT_PENDSV_PRIORITY         (0xFFu)            /* Lowest: switch after the last ISR */
+#define OS_PORT_SYSTICK_PRIORITY        (0xFFu)
+#define OS_PORT_BOOT_STACK_WORDS        (64u)              /* Context of Os_Start(), never resumed */
+#else
+/*** Linux host: single threaded, interrupts are simulated with Os_PortHostInterrupt() ***/
+#define OS_ENTER_CRITICAL()             (0u)
+#define OS_EXIT_CRITICAL(STATE)         ((void)(STATE))
+#define OS_PORT_CYCLES()                Os_PortHostCycles()
+#endif
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+/* Read and written by the context switch */
+extern Os_TaskType * volatile Os_Current;               /* Running task */
+extern Os_TaskType * volatile Os_Next;                  /* Task to switch to */
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Builds the initial context of a task on its stack.
+ *
+ * @param[in] StackPtr Stack base.
+ * @param[in] stackWords Stack size in words.
+ * @param[in] entry Task function.
+ * @param[in] arg Argument passed to entry.
+ * @return Initial stack pointer, stored in the task control block.
+ */
+void * Os_PortInitStack(unsigned int * StackPtr, unsigned int stackWords, Os_EntryType entry, void * arg);
+
+/*!
+ * @brief Switches to Os_Next for the first time.
+ *
+ * @return Does not return on the target.
+ */
+void Os_PortStartFirst(void);
+
+/*!
+ * @brief Requests a switch to Os_Next.
+ *
+ * From a task the switch is done as soon as interrupts are unmasked, from an interrupt when the
+ * last nested interrupt returns.
+ *
+ * @return void.
+ */
+void Os_PortRequestSwitch(void);
+
+/*!
+ * @brief Tells whether the caller runs in an interrupt.
+ *
+ * @return 1 in an interrupt, 0 in a task.
+ */
+unsigned char Os_PortInIsr(void);
+
+/*!
+ * @brief Waits for an interrupt, used by the idle task without an idle hook.
+ *
+ * @return void.
+ */
+void Os_PortIdle(void);
+
+#if defined(OS_PORT_HOST)
+/*!
+ * @brief Runs a function as a simulated interrupt.
+ *
+ * A switch requested by the function is done when it returns, as with PendSV.
+ *
+ * @param[in] handler Interrupt handler, e.g. Os_Tick.
+ * @return void.
+ */
+void Os_PortHostInterrupt(void (*handler)(void));
+
+/*!
+ * @brief Leaves the scheduler: Os_Start() returns to its caller.
+ *
+ * @return void.
+ */
+void Os_PortHostStop(void);
+
+/*!
+ * @brief Gets a monotonic time for the statistics.
+ *
+ * @return Nanoseconds, wrapping at 2^32.
+ */
+unsigned int Os_PortHostCycles(void);
+#endif
+
+#endif  /* OS_PORT_H */
@@ -0,0 +1,288 @@
+/****************************************************************************************************
+* @file     Proto.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the serial command protocol.
+* @details  This header file contains the definitions, structures, and function prototypes for a
+*           framed binary protocol on an LPUART. Frames are COBS encoded and end with a zero byte.
+*           A decoded request is
+*               [seq] [cmd] [payload 0..PROTO_MAX_PAYLOAD] [crc16 LSB] [crc16 MSB]
+*           and the response is
+*               [seq] [cmd | PROTO_RESPONSE_FLAG] [status] [payload] [crc16 LSB] [crc16 MSB]
+*           with CRC-16/CCITT-FALSE over every byte before the CRC. A request repeating the
+*           sequence number and command of the previous one is answered again without executing it.
+*           A command is served by the handler that its module registered with Proto_Register(),
+*           if any, otherwise by the command table of the configuration.
+* @version  1.0.0
+* @date     2024-11-05
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PROTO_H
+#define PROTO_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpuart.h"
+#include "Alarm.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Frame layout ***/
+#define PROTO_MAX_PAYLOAD               (32u)              /* Largest request or response payload */
+#define PROTO_REQUEST_OVERHEAD          (4u)               /* seq, cmd, crc16 */
+#define PROTO_RESPONSE_OVERHEAD         (5u)               /* seq, cmd, status, crc16 */
+#define PROTO_MAX_DECODED               (PROTO_MAX_PAYLOAD + PROTO_RESPONSE_OVERHEAD)
+#define PROTO_MAX_ENCODED               (COBS_MAX_ENCODED(PROTO_MAX_DECODED))
+#define PROTO_RESPONSE_FLAG             (0x80u)
+#define PROTO_DELIMITER                 (COBS_DELIMITER)
+
+/*** Alarms set over the protocol ***/
+#define PROTO_ALARM_SLOTS               (8u)               /* Slots addressed by PROTO_CMD_SET_ALARM */
+
+/*** Commands, little-endian payloads ***/
+#define PROTO_CMD_PING                  (0x00u)            /* Any payload, echoed */
+#define PROTO_CMD_GET_TIME              (0x01u)            /* Response: seconds u32, nanoseconds u32 */
+#define PROTO_CMD_SET_TIME              (0x02u)            /* Request: seconds u32, nanoseconds u32 */
+#define PROTO_CMD_SET_ALARM             (0x03u)            /* Request: slot u8, time of day (s) u32, weekday mask u8 */
+#define PROTO_CMD_CLEAR_ALARM           (0x04u)            /* Request: slot u8 */
+#define PROTO_CMD_SET_BRIGHTNESS        (0x05u)            /* Request: level u8, fade (ms) u16 */
+#define PROTO_CMD_GET_STATUS            (0x06u)            /* Response: brightness u8, alarms u16, frames u32 */
+#define PROTO_CMD_GET_STACK             (0x07u)            /* Registered by Stack_Init(). Request: context index u8. Response: id u8, overflow u8, size u32, used u32 */
+#define PROTO_CMD_GET_POWER             (0x08u)            /* Registered by Brownout_Init(). Response: saves u32, snapshot/total/worst cycles u32, lost u32, keys left u8, restored u8 */
+#define PROTO_CMD_GET_RESET             (0x09u)            /* Registered by Supervisor_Init(). Response: causes/sticky causes u32, refreshes u32, refresh/worst check cycles u32, late task u8, expired u8 */
+#define PROTO_CMD_COUNT                 (0x0Au)            /* Size of a complete command table */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Protocol Return Status Type
+ */
+typedef enum
+{
+			PROTO_OK            = 0U,       /**< Operation completed successfully. */
+			PROTO_ERR_PARA      = 1U,       /**< Parameter error */
+} Proto_ret_t;
+
+/**
+ * @brief     Status byte of a response.
+ */
+typedef enum
+{
+			PROTO_STATUS_OK          = 0U,  /**< Command executed */
+			PROTO_STATUS_UNKNOWN     = 1U,  /**< No handler for the command */
+			PROTO_STATUS_BAD_LENGTH  = 2U,  /**< Payload length outside the command limits */
+			PROTO_STATUS_BAD_VALUE   = 3U,  /**< Payload value rejected by the handler */
+			PROTO_STATUS_BUSY        = 4U,  /**< Command cannot run now */
+} Proto_status_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Command handler.
+ * @details Request points into the receive buffer and is only valid during the call. The
+ *          handler writes at most PROTO_MAX_PAYLOAD bytes to Response and sets ResponseLength.
+ */
+typedef Proto_status_t (*Proto_HandlerType)(const unsigned char * Request, unsigned char length,
+                                            unsigned char * Response, unsigned char * ResponseLength);
+
+/**
+ * @brief   Command table entry, indexed by command number.
+ */
+typedef struct
+{
+			Proto_HandlerType   handler;        /*!< Handler, NULL when the command is not supported */
+			unsigned char       minLength;      /*!< Shortest accepted payload */
+			unsigned char       maxLength;      /*!< Longest accepted payload */
+} Proto_CommandType;
+
+/**
+ * @brief   Configuration structure for the protocol.
+ */
+typedef struct
+{
+			unsigned char               uart;           /*!< LPUART instance, already initialized */
+			const Proto_CommandType *   commands;       /*!< Command table */
+			unsigned char               commandCount;   /*!< Entries in the command table */
+			Alarm_CallbackType          alarmCallback;  /*!< Called when a PROTO_CMD_SET_ALARM alarm fires, may be NULL */
+} Proto_ConfigType;
+
+/**
+ * @brief   Protocol statistics.
+ */
+typedef struct
+{
+			unsigned int   frames;              /*!< Valid requests executed */
+			unsigned int   duplicates;          /*!< Repeated requests answered from the last response */
+			unsigned int   crcErrors;           /*!< Frames dropped for a CRC mismatch */
+			unsigned int   framingErrors;       /*!< Frames dropped for bad COBS or length */
+			unsigned int   deferred;            /*!< Responses held back until the transmit ring had room */
+} Proto_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the protocol.
+ *
+ * @param[in] ConfigPtr Pointer to the protocol configuration structure.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_Init(const Proto_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Parses and executes the received frames.
+ *
+ * Frames are decoded in place in the LPUART receive ring; only a frame that wraps the end of
+ * the ring is copied first. Call from the main loop.
+ *
+ * @return Number of requests executed.
+ */
+unsigned int Proto_Process(void);
+
+/*!
+ * @brief Retrieves the protocol statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_GetStats(Proto_StatsType * StatsPtr);
+
+/*!
+ * @brief Registers the handler of a command owned by another module.
+ *
+ * A module serves the command it owns without the protocol knowing about it.
+ * Precedence: a registered handler wins over the entry of the command table, limits included;
+ * registering NULL gives the command back to the table.
+ * Re-init: the registrations are kept in a table of their own that Proto_Init() does not clear,
+ * so a module may register from its Init function before or after Proto_Init(), and they stay
+ * in force when the protocol is initialized again. Call from the main loop context.
+ *
+ * @param[in] cmd Command, below PROTO_CMD_COUNT.
+ * @param[in] handler Handler, NULL to fall back to the command table.
+ * @param[in] minLength Shortest accepted payload.
+ * @param[in] maxLength Longest accepted payload, at most PROTO_MAX_PAYLOAD.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_Register(unsigned char cmd, Proto_HandlerType handler, unsigned char minLength, unsigned char maxLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_PING, echoes the request payload.
+ *
+ * Put it in the command table entry PROTO_CMD_PING.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandlePing(const unsigned char * Request, unsigned char length,
+                                unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_TIME, reports the software clock of Calib.h.
+ *
+ * Put it in the command table entry PROTO_CMD_GET_TIME with a payload length of 0.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandleGetTime(const unsigned char * Request, unsigned char length,
+                                   unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_TIME, sets the software clock of Calib.h.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_TIME with a payload length of 8.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for nanoseconds of 1e9 or more.
+ */
+Proto_status_t Proto_HandleSetTime(const unsigned char * Request, unsigned char length,
+                                   unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_ALARM, sets a weekday alarm of Alarm.h in a slot.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_ALARM with a payload length of 6. An alarm
+ * already in the slot is replaced; the alarm calls alarmCallback of the configuration.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for a bad slot, time or mask,
+ *         PROTO_STATUS_BUSY when the scheduler is full.
+ */
+Proto_status_t Proto_HandleSetAlarm(const unsigned char * Request, unsigned char length,
+                                    unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_CLEAR_ALARM, removes the alarm of a slot.
+ *
+ * Put it in the command table entry PROTO_CMD_CLEAR_ALARM with a payload length of 1. Clearing
+ * an empty slot succeeds.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for a bad slot.
+ */
+Proto_status_t Proto_HandleClearAlarm(const unsigned char * Request, unsigned char length,
+                                      unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_BRIGHTNESS, starts a fade of Brightness.h.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_BRIGHTNESS with a payload length of 3.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE above BRIGHTNESS_LEVEL_MAX,
+ *         PROTO_STATUS_BUSY before Brightness_Init().
+ */
+Proto_status_t Proto_HandleSetBrightness(const unsigned char * Request, unsigned char length,
+                                         unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_STATUS, reports the brightness, the alarm count and the frames.
+ *
+ * Put it in the command table entry PROTO_CMD_GET_STATUS with a payload length of 0.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandleGetStatus(const unsigned char * Request, unsigned char length,
+                                     unsigned char * Response, unsigned char * ResponseLength);
+
+/*!
+ * @brief Computes the CRC-16/CCITT-FALSE of a buffer.
+ *
+ * @param[in] DataPtr Data.
+ * @param[in] length Number of bytes.
+ * @return CRC, polynomial 0x1021, initial value 0xFFFF.
+ */
+unsigned short Proto_Crc16(const unsigned char * DataPtr, unsigned short length);
+
+#endif  /* PROTO_H */
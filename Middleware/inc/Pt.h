@@ -0,0 +1,209 @@
+/****************************************************************************************************
+* @file     Pt.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the stackless coroutine scheduler.
+* @details  This header file contains the macros, structures, and function prototypes for
+*           protothread style coroutines. A coroutine is a function that returns at every wait and
+*           continues at the same line when resumed, so all tasks share one stack and a task costs
+*           12 bytes of RAM. Pt_Run() resumes only the tasks that are ready: yielded, woken by an
+*           event, or whose wake-up tick has come. Pt_Tick() only counts ticks, so the SysTick
+*           interrupt stays a single increment.
+* @version  1.0.0
+* @date     2024-11-09
+* @note     Local variables are not kept across a wait: keep state in static variables or in a
+*           structure around Pt_TaskType. A coroutine body must not contain a switch statement,
+*           and each line holds at most one PT_ wait (the line number is the resume point).
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef PT_H
+#define PT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Utilitie.h"
+
+#if !defined(PT_HOST)
+#include "Cpu.h"
+#endif
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define PT_MAX_TASKS                    (32u)              /* One bit of the ready mask each */
+
+/*** Coroutine return values ***/
+#define PT_WAITING                      (0u)               /* Sleeping or waiting for an event */
+#define PT_YIELDED                      (1u)               /* Ready, resumed after the other ready tasks */
+#define PT_ENDED                        (2u)               /* Finished, not resumed again */
+
+/*** Critical sections: Pt_SetEvent() may run in an interrupt ***/
+#if !defined(PT_HOST)
+#define PT_ENTER_CRITICAL()             Cpu_EnterCritical()
+#define PT_EXIT_CRITICAL(STATE)         Cpu_ExitCritical(STATE)
+#else
+#define PT_ENTER_CRITICAL()             (0u)
+#define PT_EXIT_CRITICAL(STATE)         ((void)(STATE))
+#endif
+
+/*** Coroutine body ***/
+#define PT_BEGIN(PT)                    switch ((PT)->lc) { case 0u:
+#define PT_END(PT)                      } (PT)->lc = 0u; return PT_ENDED
+
+/* Gives the CPU to the other ready tasks */
+#define PT_YIELD(PT)                                                                                \
+		do                                                                                          \
+		{                                                                                           \
+			(PT)->lc = (unsigned short)__LINE__;                                                    \
+			return PT_YIELDED;                                                                      \
+			case __LINE__:;                                                                         \
+		} while (0)
+
+/* Polls a condition once per Pt_Run(); prefer PT_AWAIT_EVENT for conditions set by interrupts */
+#define PT_WAIT_UNTIL(PT, COND)                                                                     \
+		do                                                                                          \
+		{                                                                                           \
+			(PT)->lc = (unsigned short)__LINE__;                                                    \
+			case __LINE__:                                                                          \
+			if (!(COND))                                                                            \
+			{                                                                                       \
+				return PT_YIELDED;                                                                  \
+			}                                                                                       \
+		} while (0)
+
+/* Not resumed before the tick count reaches TICK */
+#define PT_SLEEP_UNTIL(PT, TICK)                                                                    \
+		do                                                                                          \
+		{                                                                                           \
+			(PT)->wakeTick = (TICK);                                                                \
+			(PT)->state = PT_STATE_SLEEP;                                                           \
+			(PT)->lc = (unsigned short)__LINE__;                                                    \
+			return PT_WAITING;                                                                      \
+			case __LINE__:;                                                                         \
+		} while (0)
+
+#define PT_SLEEP(PT, TICKS)             PT_SLEEP_UNTIL(PT, Pt_GetTicks() + (TICKS))
+
+/* Periodic release without drift: the period counts from the previous wake-up tick */
+#define PT_SLEEP_PERIOD(PT, PERIOD)     PT_SLEEP_UNTIL(PT, (PT)->wakeTick + (PERIOD))
+
+/* Not resumed before Pt_SetEvent() sets one of the MASK bits; PT_EVENTS() then holds them */
+#define PT_AWAIT_EVENT(PT, MASK)                                                                    \
+		do                                                                                          \
+		{                                                                                           \
+			(PT)->events = (unsigned char)(MASK);                                                   \
+			(PT)->state = PT_STATE_EVENT;                                                           \
+			(PT)->lc = (unsigned short)__LINE__;                                                    \
+			return PT_WAITING;                                                                      \
+			case __LINE__:;                                                                         \
+		} while (0)
+
+#define PT_EVENTS(PT)                   ((PT)->events)
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Pt Return Status Type
+ */
+typedef enum
+{
+			PT_OK               = 0U,       /**< Operation completed successfully. */
+			PT_ERR_PARA         = 1U,       /**< Parameter error */
+} Pt_ret_t;
+
+/**
+ * @brief     Task states.
+ */
+typedef enum
+{
+			PT_STATE_READY      = 0U,       /**< Resumed by the next Pt_Run() */
+			PT_STATE_SLEEP      = 1U,       /**< Waiting for wakeTick */
+			PT_STATE_EVENT      = 2U,       /**< Waiting for one of the events bits */
+			PT_STATE_ENDED      = 3U,       /**< Returned PT_ENDED */
+} Pt_state_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+struct Pt_Task;
+
+/**
+ * @brief   Coroutine function: returns PT_WAITING, PT_YIELDED or PT_ENDED.
+ */
+typedef unsigned char (*Pt_FuncType)(struct Pt_Task * PT);
+
+/**
+ * @brief   Task, 12 bytes on the target.
+ */
+typedef struct Pt_Task
+{
+			Pt_FuncType             func;           /*!< Coroutine */
+			unsigned int            wakeTick;       /*!< Wake-up tick of the last sleep */
+			unsigned short          lc;             /*!< Line to continue at, 0: start */
+			unsigned char           events;         /*!< Events waited for, then the ones received */
+			unsigned char           state;          /*!< Pt_state_t */
+} Pt_TaskType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the scheduler with a table of tasks, all ready.
+ *
+ * The table order is the priority order: within one Pt_Run() lower indexes run first.
+ *
+ * @param[in] TasksPtr Task table, func set by the caller.
+ * @param[in] count Number of tasks, up to PT_MAX_TASKS.
+ * @return PT_OK on success, PT_ERR_PARA on parameter error.
+ */
+Pt_ret_t Pt_Init(Pt_TaskType * TasksPtr, unsigned char count);
+
+/*!
+ * @brief Resumes every ready task once.
+ *
+ * Call from the main loop; when it returns 0 nothing is ready and the CPU may sleep until
+ * the next interrupt.
+ *
+ * @return Number of tasks resumed.
+ */
+unsigned int Pt_Run(void);
+
+/*!
+ * @brief Advances the tick count, from the SysTick interrupt.
+ *
+ * @return void.
+ */
+void Pt_Tick(void);
+
+/*!
+ * @brief Gets the tick count.
+ *
+ * @return Ticks since Pt_Init(), wrapping at 2^32.
+ */
+unsigned int Pt_GetTicks(void);
+
+/*!
+ * @brief Signals events to the tasks waiting for them.
+ *
+ * Callable from interrupts. Events nobody waits for are discarded by the next Pt_Run().
+ *
+ * @param[in] mask Event bits.
+ * @return void.
+ */
+void Pt_SetEvent(unsigned char mask);
+
+/*!
+ * @brief Gets the ticks until the next sleeping task wakes up.
+ *
+ * @return Ticks, 0 when a task is ready, 0xFFFFFFFF when no task sleeps.
+ */
+unsigned int Pt_GetIdleTicks(void);
+
+#endif  /* PT_H */
@@ -0,0 +1,113 @@
+/****************************************************************************************************
+* @file     Srp.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the stack resource policy.
+* @details  This header file contains the macros for sharing data between interrupts and the main
+*           loop under the stack resource policy. The ceiling of a resource is the highest priority
+*           of its users, computed at compile time from Srp_Cfg.h. Locking raises BASEPRI to that
+*           ceiling only, so interrupts above it keep their latency. A task is blocked at most
+*           once, by one critical section of a lower priority task, before it starts, never after.
+*           This rules out deadlock, and all tasks share one stack.
+* @version  1.0.0
+* @date     2024-11-10
+* @note     Usage, from a task declared as a user of the resource:
+*               unsigned int saved = SRP_LOCK(DISPLAY, FRAME);
+*               ... access the frame buffer ...
+*               SRP_UNLOCK(saved);
+*           Locks nest. Srp_Init() programs the NVIC priorities from the task list.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SRP_H
+#define SRP_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Cpu.h"
+#include "Srp_Cfg.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SRP_PRIORITY_LEVELS             (1u << CPU_NVIC_PRIO_BITS)
+#define SRP_PRIORITY_MAX                (SRP_PRIORITY_LEVELS - 1u)  /* NVIC level 0 cannot be masked by BASEPRI */
+
+/*** Priority conversions: SRP priority, higher runs first, to NVIC level, lower runs first ***/
+#define SRP_NVIC_PRIORITY(PRIO)         (SRP_PRIORITY_LEVELS - (PRIO))
+#define SRP_BASEPRI(PRIO)               (((PRIO) == 0u) ? 0u : (SRP_NVIC_PRIORITY(PRIO) << (8u - CPU_NVIC_PRIO_BITS)))
+
+/*** Users bit of a task, for SRP_RESOURCE_LIST ***/
+#define SRP_USER(NAME)                  (1u << (unsigned int)SRP_TASK_##NAME)
+
+/*** Ceiling: highest priority among the users ***/
+#define SRP_PRIO_BIT(USERS, NAME, IRQ, PRIO) | ((((USERS) & SRP_USER(NAME)) != 0u) ? (1u << (PRIO)) : 0u)
+#define SRP_PRIO_MASK(USERS)            (0u SRP_TASK_LIST(SRP_PRIO_BIT, USERS))
+#define SRP_HIGHEST_BIT(M)              (((M) >= 0x8000u) ? 15u : ((M) >= 0x4000u) ? 14u : ((M) >= 0x2000u) ? 13u : \
+                                         ((M) >= 0x1000u) ? 12u : ((M) >= 0x0800u) ? 11u : ((M) >= 0x0400u) ? 10u : \
+                                         ((M) >= 0x0200u) ? 9u : ((M) >= 0x0100u) ? 8u : ((M) >= 0x0080u) ? 7u :    \
+                                         ((M) >= 0x0040u) ? 6u : ((M) >= 0x0020u) ? 5u : ((M) >= 0x0010u) ? 4u :    \
+                                         ((M) >= 0x0008u) ? 3u : ((M) >= 0x0004u) ? 2u : ((M) >= 0x0002u) ? 1u : 0u)
+#define SRP_CEILING_OF(USERS)           SRP_HIGHEST_BIT(SRP_PRIO_MASK(USERS))
+
+/*** Locking: fails to compile when TASK is not a declared user of RES ***/
+#define SRP_LOCK(TASK, RES)                                                                         \
+		((void)sizeof(char[((SRP_USERS_##RES & SRP_USER(TASK)) != 0u) ? 1 : -1]),                  \
+		 Cpu_RaiseBasepri(SRP_BASEPRI(SRP_CEILING_##RES)))
+#define SRP_UNLOCK(SAVED)               Cpu_SetBasepri(SAVED)
+
+/*** X-macro expansions ***/
+#define SRP_TASK_ENUM(ARG, NAME, IRQ, PRIO)             SRP_TASK_##NAME,
+#define SRP_TASK_PRIORITY(ARG, NAME, IRQ, PRIO)         SRP_PRIORITY_##NAME = (PRIO),
+#define SRP_RESOURCE_ENUM(ARG, NAME, USERS, CS)         SRP_RESOURCE_##NAME,
+#define SRP_RESOURCE_USERS(ARG, NAME, USERS, CS)        SRP_USERS_##NAME = (USERS),
+#define SRP_RESOURCE_CEILING(ARG, NAME, USERS, CS)      SRP_CEILING_##NAME = SRP_CEILING_OF(USERS),
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Tasks, in the order of SRP_TASK_LIST.
+ */
+typedef enum
+{
+			SRP_TASK_LIST(SRP_TASK_ENUM, 0)
+			SRP_TASK_COUNT
+} Srp_task_t;
+
+/**
+ * @brief     Resources, in the order of SRP_RESOURCE_LIST.
+ */
+typedef enum
+{
+			SRP_RESOURCE_LIST(SRP_RESOURCE_ENUM, 0)
+			SRP_RESOURCE_COUNT
+} Srp_resource_t;
+
+/**
+ * @brief     Compile-time task priorities, users and resource ceilings.
+ */
+enum
+{
+			SRP_TASK_LIST(SRP_TASK_PRIORITY, 0)
+			SRP_RESOURCE_LIST(SRP_RESOURCE_USERS, 0)
+			SRP_RESOURCE_LIST(SRP_RESOURCE_CEILING, 0)
+};
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Programs the NVIC priority of every interrupt task.
+ *
+ * Call before the interrupts are enabled.
+ *
+ * @return void.
+ */
+void Srp_Init(void);
+
+#endif  /* SRP_H */
@@ -0,0 +1,54 @@
+/****************************************************************************************************
+* @file     Srp_Cfg.h
+* @author   Ma Hien Nhan
+* @brief    Configuration of the stack resource policy.
+* @details  This header file lists the tasks (interrupts and the main loop) with their priorities
+*           and the shared resources with their users. Srp.h derives the ceiling of every resource
+*           from these lists at compile time. Each list may be replaced by defining it before this
+*           file is included.
+* @version  1.0.0
+* @date     2024-11-10
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SRP_CFG_H
+#define SRP_CFG_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Nvic.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SRP_NO_IRQ                      (0xFFu)            /* Task running in thread mode */
+
+/*
+ * Tasks: X(ARG, name, IRQ, priority)
+ * Priority 0 is the main loop; 1 .. SRP_PRIORITY_MAX are interrupts, higher runs first.
+ */
+#ifndef SRP_TASK_LIST
+#define SRP_TASK_LIST(X, ARG)                                                                       \
+		X(ARG, MAIN,        SRP_NO_IRQ,             0u)     /* Main loop */                         \
+		X(ARG, UART,        LPUART1_RxTx_IRQn,      1u)     /* Command protocol receive */          \
+		X(ARG, BUTTON,      PORTC_IRQn,             2u)     /* Button pin detect */                 \
+		X(ARG, DISPLAY,     LPIT0_Ch0_IRQn,         3u)     /* Display multiplexing */              \
+		X(ARG, TIMEBASE,    LPIT0_Ch1_IRQn,         4u)     /* Seconds tick, shares nothing */      \
+		X(ARG, BROWNOUT,    PMC_LVD_IRQn,           5u)     /* Power-fail save, Kv_Flush() */
+#endif
+
+/*
+ * Resources: X(ARG, name, users, longest critical section in cycles)
+ * The critical section length is only used by the blocking analysis (Tools/srpcheck.c).
+ */
+#ifndef SRP_RESOURCE_LIST
+#define SRP_RESOURCE_LIST(X, ARG)                                                                   \
+		X(ARG, TIME,        SRP_USER(MAIN) | SRP_USER(BUTTON) | SRP_USER(DISPLAY),     120u)       \
+		X(ARG, FRAME,       SRP_USER(MAIN) | SRP_USER(DISPLAY),                        80u)        \
+		X(ARG, SETTINGS,    SRP_USER(MAIN) | SRP_USER(UART) | SRP_USER(BUTTON) | SRP_USER(BROWNOUT), 200u)
+#endif
+
+#endif  /* SRP_CFG_H */
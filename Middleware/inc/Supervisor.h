@@ -0,0 +1,164 @@
+/****************************************************************************************************
+* @file     Supervisor.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the task supervisor feeding the watchdog.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           refreshing the watchdog only while every supervised task is alive. Each task checks
+*           in at least once per deadline; Supervisor_Process() runs once per period from the
+*           main loop and refreshes the watchdog when no task missed its deadline and the window
+*           is open. The first task that misses its deadline stops the refreshes for good and is
+*           recorded in RAM that survives the reset, so the next boot can tell which task hung.
+* @version  1.0.0
+* @date     2024-11-16
+* @note     The record lives in the section ".noinit", which must not be zeroed by the startup
+*           code. Add to the linker script, in the RAM region:
+*               .noinit (NOLOAD) : { KEEP(*(.noinit*)) } > m_data
+*           Usage:
+*               Wdog_Init(&wdogConfig)          first, with Supervisor_OnExpiry() as the callback
+*               Dwt_Init(), clocks, drivers
+*               Supervisor_Init(&config, now)   reads the reason of the last reset
+*               tasks: Supervisor_CheckIn(id)   one byte store
+*               main loop: Supervisor_Process(now)
+*           periodMs must be shorter than the time from the window to the timeout.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Wdog.h"
+#include "Rcm.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Build options ***/
+#ifndef SUPERVISOR_TASK_MAX
+#define SUPERVISOR_TASK_MAX             (8u)               /* Supervised tasks */
+#endif
+
+#define SUPERVISOR_TASK_NONE            (0xFFu)            /* No task missed its deadline */
+#define SUPERVISOR_SECTION              ".noinit"
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Supervisor Return Status Type
+ */
+typedef enum
+{
+			SUPERVISOR_OK           = 0U,   /**< Operation completed successfully. */
+			SUPERVISOR_ERR_PARA     = 1U,   /**< Parameter error */
+} Supervisor_ret_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Configuration structure for the supervisor.
+ */
+typedef struct
+{
+			const unsigned int *    deadlinesMs;    /*!< Longest time between two check-ins, per task id */
+			unsigned char           taskCount;      /*!< Supervised tasks, ids 0 - taskCount-1 */
+			unsigned char           RESERVE1[3];
+			unsigned int            periodMs;       /*!< Time between two checks in Supervisor_Process() */
+} Supervisor_ConfigType;
+
+/**
+ * @brief   Reason of the last reset.
+ */
+typedef struct
+{
+			unsigned int   causes;              /*!< RCM_CAUSE_ bits of the last reset */
+			unsigned int   stickyCauses;        /*!< RCM_CAUSE_ bits of every reset since power-on */
+			unsigned char  task;                /*!< Task that missed its deadline, SUPERVISOR_TASK_NONE */
+			unsigned char  expired;             /*!< 1 when the pre-reset interrupt ran */
+			unsigned char  RESERVE1[2];
+} Supervisor_ResetType;
+
+/**
+ * @brief   Supervisor statistics, in DWT cycles.
+ */
+typedef struct
+{
+			unsigned int   refreshes;           /*!< Watchdog refreshes since boot */
+			unsigned int   refreshCycles;       /*!< Last refresh store */
+			unsigned int   processCycles;       /*!< Last check of every task */
+			unsigned int   processCyclesMax;    /*!< Longest processCycles */
+			unsigned char  late;                /*!< Task that missed its deadline, SUPERVISOR_TASK_NONE */
+			unsigned char  RESERVE1[3];
+} Supervisor_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes the supervisor and reads the reason of the last reset.
+ *
+ * Every task gets a full deadline from now. The record left by the last run is taken when its
+ * check word is valid, and cleared. The reason and the statistics are served to the serial
+ * protocol as PROTO_CMD_GET_RESET.
+ *
+ * @param[in] ConfigPtr Pointer to the supervisor configuration structure.
+ * @param[in] now Current time in milliseconds.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_Init(const Supervisor_ConfigType * ConfigPtr, unsigned int now);
+
+/*!
+ * @brief Checks a task in.
+ *
+ * Safe from any context, interrupts included.
+ *
+ * @param[in] id Task id.
+ * @return void.
+ */
+void Supervisor_CheckIn(unsigned char id);
+
+/*!
+ * @brief Checks the deadlines and refreshes the watchdog.
+ *
+ * Returns after one comparison until periodMs has elapsed since the last check. Call from the
+ * main loop or the lowest priority task, so that a hang anywhere stops the refreshes.
+ *
+ * @param[in] now Current time in milliseconds.
+ * @return void.
+ */
+void Supervisor_Process(unsigned int now);
+
+/*!
+ * @brief Pre-reset callback of the watchdog.
+ *
+ * Marks the record as expired. Pass it as the Wdog_ConfigType callback.
+ *
+ * @return void.
+ */
+void Supervisor_OnExpiry(void);
+
+/*!
+ * @brief Retrieves the reason of the last reset.
+ *
+ * @param[out] ResetPtr Pointer to the reset structure.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_GetLastReset(Supervisor_ResetType * ResetPtr);
+
+/*!
+ * @brief Retrieves the supervisor statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_GetStats(Supervisor_StatsType * StatsPtr);
+
+#endif  /* SUPERVISOR_H */
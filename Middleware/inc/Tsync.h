@@ -0,0 +1,175 @@
+/****************************************************************************************************
+* @file     Tsync.h
+* @author   Ma Hien Nhan
+* @brief    Header file for the time synchronization over CAN.
+* @details  This header file contains the definitions, structures, and function prototypes for
+*           distributing the time of a master clock to the slave clocks on a CAN bus, in two
+*           steps: the master sends SYNC, learns from the transmit time stamp when SYNC was on the
+*           bus, and sends that time in FOLLOW_UP. Every slave captured the same instant with its
+*           receive time stamp, so the interrupt and queueing latencies drop out and only the
+*           fixed propagation delay is left, which is configured. The FlexCAN timer counts bit
+*           times; a capture is converted to the local timebase (e.g. the 64-bit LPIT counter) by
+*           waiting for the next timer edge and stepping back the elapsed bit times. A slave keeps
+*           the master time as a reference point and a rate, both updated by every sync, and
+*           extrapolates between syncs.
+* @version  1.0.0
+* @date     2024-11-14
+* @note     Tsync_OnRx() and Tsync_OnTx() are called by the application from the CAN callbacks
+*           of the instance; Tsync_Process() from the main loop.
+****************************************************************************************************/
+
+/*==================================================================================================
+==================================================================================================*/
+#ifndef TSYNC_H
+#define TSYNC_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Can.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define TSYNC_NS_PER_SECOND             (1000000000u)      /* Nanoseconds in one second */
+#define TSYNC_MAX_PPB                   (1000000)          /* Largest accepted rate difference (1000 ppm) */
+#define TSYNC_EDGE_LOOPS                (1000u)            /* Timer reads while waiting for an edge */
+
+/*** Message layout: byte 0 sequence, bytes 4 - 7 big endian ***/
+#define TSYNC_MSG_LENGTH                (8u)
+#define TSYNC_MSG_SEQ                   (0u)
+#define TSYNC_MSG_VALUE                 (4u)               /* SYNC: seconds, FOLLOW_UP: nanoseconds from them */
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+/**
+ * @brief     Tsync Return Status Type
+ */
+typedef enum
+{
+			TSYNC_OK            = 0U,       /**< Operation completed successfully. */
+			TSYNC_ERR_PARA      = 1U,       /**< Parameter error */
+			TSYNC_ERR_NOT_SYNCED = 2U,      /**< Slave never synchronized, no time */
+			TSYNC_ERR_TIMEOUT   = 3U,       /**< Slave lost the master, time extrapolated */
+} Tsync_ret_t;
+
+/**
+ * @brief     Role on the bus.
+ */
+typedef enum
+{
+			TSYNC_ROLE_MASTER   = 0U,       /**< Sends the time */
+			TSYNC_ROLE_SLAVE    = 1U,       /**< Follows the time */
+} Tsync_role_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Local timebase, a free-running 64-bit counter.
+ */
+typedef uint64 (*Tsync_CounterType)(void);
+
+/**
+ * @brief   Configuration structure for a time synchronization instance.
+ */
+typedef struct
+{
+			unsigned char           instance;       /*!< FlexCAN instance (0-2), one role per instance */
+			Tsync_role_t            role;           /*!< Master or slave */
+			unsigned int            syncId;         /*!< Standard identifier of SYNC */
+			unsigned int            followUpId;     /*!< Standard identifier of FOLLOW_UP */
+			unsigned int            bitrate;        /*!< Bit rate of the instance, 10^9 / bitrate must be whole */
+			Tsync_CounterType       counter;        /*!< Local timebase */
+			unsigned int            counterHz;      /*!< Local timebase frequency */
+			unsigned int            periodMs;       /*!< Master: SYNC period */
+			unsigned int            delayNs;        /*!< Slave: propagation delay from the master */
+			unsigned int            timeoutMs;      /*!< Slave: master lost after this time without sync */
+} Tsync_ConfigType;
+
+/**
+ * @brief   Time synchronization statistics.
+ */
+typedef struct
+{
+			unsigned int   syncs;               /*!< Master: FOLLOW_UP sent, slave: syncs applied */
+			unsigned int   lost;                /*!< Master: SYNC not sent, slave: FOLLOW_UP without SYNC */
+			int            lastOffsetNs;        /*!< Slave: master time - extrapolated time at the last sync */
+			unsigned int   worstOffsetNs;       /*!< Slave: largest |lastOffsetNs| once the rate is known */
+			int            ratePpb;             /*!< Slave: master rate - local rate */
+} Tsync_StatsType;
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+/*!
+ * @brief Initializes a time synchronization instance.
+ *
+ * @param[in] ConfigPtr Pointer to the configuration structure.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error.
+ * @note The FlexCAN instance is initialized by the application, a slave accepting syncId and
+ *       followUpId.
+ */
+Tsync_ret_t Tsync_Init(const Tsync_ConfigType * ConfigPtr);
+
+/*!
+ * @brief Sends SYNC when the period elapsed, on a master.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return void.
+ */
+void Tsync_Process(unsigned char instance);
+
+/*!
+ * @brief Receive callback, to be called for every frame of the instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] FramePtr Received frame.
+ * @return void.
+ */
+void Tsync_OnRx(unsigned char instance, const Can_FrameType * FramePtr);
+
+/*!
+ * @brief Transmit complete callback, to be called for every frame of the instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] id Identifier of the frame.
+ * @param[in] timestamp Transmit time stamp.
+ * @return void.
+ */
+void Tsync_OnTx(unsigned char instance, unsigned int id, unsigned short timestamp);
+
+/*!
+ * @brief Retrieves the synchronized time.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] NsPtr Nanoseconds since the epoch of the master.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA, TSYNC_ERR_NOT_SYNCED or TSYNC_ERR_TIMEOUT on error;
+ *         *NsPtr is valid with TSYNC_OK and TSYNC_ERR_TIMEOUT.
+ */
+Tsync_ret_t Tsync_GetTime(unsigned char instance, uint64 * NsPtr);
+
+/*!
+ * @brief Sets the time of a master.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] ns Nanoseconds since the epoch.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error or on a slave.
+ */
+Tsync_ret_t Tsync_SetTime(unsigned char instance, uint64 ns);
+
+/*!
+ * @brief Retrieves the statistics of an instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error.
+ */
+Tsync_ret_t Tsync_GetStats(unsigned char instance, Tsync_StatsType * StatsPtr);
+
+#endif  /* TSYNC_H */
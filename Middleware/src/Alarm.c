@@ -0,0 +1,410 @@
+/****************************************************************************************************
+* @file    Alarm.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the alarm scheduler.
+* @details Alarms live in a fixed pool. The pool indices are kept in a binary min-heap keyed by the
+*          next fire time, and every pool slot remembers its heap position so that removal is
+*          O(log n). Only the heap root is handed to the compare programming callback.
+* @version 1.0.0
+* @date    2024-10-20
+* @note    The scheduler is not reentrant; call it from one context only.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Alarm.h"
+#include "Trace.h"
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Alarm pool slot.
+ */
+typedef struct
+{
+			Alarm_EntryType   entry;            /*!< Alarm description */
+			unsigned int      nextFire;         /*!< Next fire time in epoch seconds */
+			unsigned short    heapPos;          /*!< Position in the heap, ALARM_INVALID_ID when free */
+			unsigned char     RESERVE1[2];
+} Alarm_SlotType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Alarm_SlotType   Alarm_Slot[ALARM_MAX_COUNT];        /* Alarm pool */
+static unsigned short   Alarm_Heap[ALARM_MAX_COUNT];        /* Min-heap of pool indices */
+static unsigned short   Alarm_FreeList[ALARM_MAX_COUNT];    /* Stack of free pool indices */
+static unsigned short   Alarm_HeapSize;                     /* Number of alarms in the heap */
+static unsigned short   Alarm_FreeCount;                    /* Number of free pool slots */
+static unsigned int     Alarm_Now;                          /* Last known epoch time */
+static unsigned int     Alarm_Programmed;                   /* Fire time handed to setCompare */
+static Alarm_SetCompareType Alarm_SetCompare;               /* Compare programming callback */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Places a pool index at a heap position and records the position in the slot.
+ */
+static void Alarm_HeapPlace(unsigned short pos, unsigned short id)
+{
+		Alarm_Heap[pos] = id;
+		Alarm_Slot[id].heapPos = pos;
+}
+
+/*!
+ * @brief Moves the element at pos towards the root until the heap property holds.
+ */
+static void Alarm_SiftUp(unsigned short pos)
+{
+		unsigned short id = Alarm_Heap[pos];
+		unsigned int key = Alarm_Slot[id].nextFire;
+
+		while (pos > 0u)
+		{
+			unsigned short parent = (unsigned short)((pos - 1u) >> 1);
+			if (Alarm_Slot[Alarm_Heap[parent]].nextFire <= key)
+			{
+				break;
+			}
+			Alarm_HeapPlace(pos, Alarm_Heap[parent]);
+			pos = parent;
+		}
+		Alarm_HeapPlace(pos, id);
+}
+
+/*!
+ * @brief Moves the element at pos towards the leaves until the heap property holds.
+ */
+static void Alarm_SiftDown(unsigned short pos)
+{
+		unsigned short id = Alarm_Heap[pos];
+		unsigned int key = Alarm_Slot[id].nextFire;
+
+		while (1)
+		{
+			unsigned int child = ((unsigned int)pos << 1) + 1u;
+			if (child >= Alarm_HeapSize)
+			{
+				break;
+			}
+			/* Pick the earlier of the two children */
+			if (((child + 1u) < Alarm_HeapSize) &&
+			    (Alarm_Slot[Alarm_Heap[child + 1u]].nextFire < Alarm_Slot[Alarm_Heap[child]].nextFire))
+			{
+				child++;
+			}
+			if (key <= Alarm_Slot[Alarm_Heap[child]].nextFire)
+			{
+				break;
+			}
+			Alarm_HeapPlace(pos, Alarm_Heap[child]);
+			pos = (unsigned short)child;
+		}
+		Alarm_HeapPlace(pos, id);
+}
+
+/*!
+ * @brief Removes the element at a heap position.
+ */
+static void Alarm_HeapRemoveAt(unsigned short pos)
+{
+		unsigned short id = Alarm_Heap[pos];
+
+		Alarm_HeapSize--;
+		Alarm_Slot[id].heapPos = ALARM_INVALID_ID;
+
+		if (pos != Alarm_HeapSize)
+		{
+			/* Move the last element into the hole and restore the heap in either direction */
+			unsigned short moved = Alarm_Heap[Alarm_HeapSize];
+			Alarm_HeapPlace(pos, moved);
+			Alarm_SiftDown(pos);
+			if (Alarm_Slot[moved].heapPos == pos)
+			{
+				Alarm_SiftUp(pos);
+			}
+		}
+}
+
+/*!
+ * @brief Returns the first time of day (seconds since midnight) on a selected weekday that is
+ *        strictly after the given time.
+ */
+static unsigned int Alarm_NextWeekday(unsigned int after, unsigned int timeOfDay, unsigned char mask)
+{
+		unsigned int day = after / ALARM_SECONDS_PER_DAY;
+		unsigned int secondOfDay = after % ALARM_SECONDS_PER_DAY;
+		unsigned int weekday = (day + ALARM_EPOCH_WEEKDAY) % ALARM_DAYS_PER_WEEK;
+		unsigned int k;
+
+		/* k == 7 covers a mask with only today's bit set and the time already passed */
+		for (k = 0u; k <= ALARM_DAYS_PER_WEEK; k++)
+		{
+			unsigned int bit = (weekday + k) % ALARM_DAYS_PER_WEEK;
+			if (((mask >> bit) & VALUE_CHECK_BIT) && ((k > 0u) || (timeOfDay > secondOfDay)))
+			{
+				return ((day + k) * ALARM_SECONDS_PER_DAY) + timeOfDay;
+			}
+		}
+		return ALARM_NO_COMPARE;
+}
+
+/*!
+ * @brief Computes the first fire time of a newly added alarm.
+ */
+static unsigned int Alarm_FirstFire(const Alarm_EntryType * EntryPtr)
+{
+		unsigned int fire;
+
+		switch (EntryPtr->type)
+		{
+			case ALARM_TYPE_ONE_SHOT:
+				fire = EntryPtr->time;
+				break;
+			case ALARM_TYPE_WEEKDAY:
+				fire = Alarm_NextWeekday(Alarm_Now, EntryPtr->time, EntryPtr->weekdayMask);
+				break;
+			case ALARM_TYPE_COUNTDOWN:
+			case ALARM_TYPE_INTERVAL:
+			default:
+				fire = Alarm_Now + EntryPtr->time;
+				break;
+		}
+		return fire;
+}
+
+/*!
+ * @brief Hands the earliest fire time to the compare programming callback when it changed.
+ */
+static void Alarm_UpdateCompare(void)
+{
+		unsigned int next = ALARM_NO_COMPARE;
+
+		if (Alarm_HeapSize != 0u)
+		{
+			next = Alarm_Slot[Alarm_Heap[0]].nextFire;
+		}
+		if ((next != Alarm_Programmed) && (Alarm_SetCompare != NULL))
+		{
+			Alarm_SetCompare(next);
+		}
+		Alarm_Programmed = next;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the alarm scheduler.
+ *
+ * This function removes all alarms and sets the current scheduler time.
+ *
+ * @param[in] ConfigPtr Pointer to the alarm configuration structure.
+ * @param[in] now Current epoch time in seconds.
+ * @return ALARM_OK on success, ALARM_ERR_PARA on parameter error.
+ */
+Alarm_ret_t Alarm_Init(const Alarm_ConfigType * ConfigPtr, unsigned int now)
+{
+		unsigned short i;
+
+		/* Check parameter */
+		if (ConfigPtr == NULL)
+		{
+			return ALARM_ERR_PARA;
+		}
+
+		/* 1. Release every slot, lowest identifiers are handed out first */
+		for (i = 0u; i < ALARM_MAX_COUNT; i++)
+		{
+			Alarm_Slot[i].heapPos = ALARM_INVALID_ID;
+			Alarm_FreeList[i] = (unsigned short)(ALARM_MAX_COUNT - 1u - i);
+		}
+		Alarm_FreeCount = ALARM_MAX_COUNT;
+		Alarm_HeapSize = 0u;
+
+		/* 2. Store the time base and the compare hook */
+		Alarm_Now = now;
+		Alarm_SetCompare = ConfigPtr->setCompare;
+		Alarm_Programmed = 0u;
+		Alarm_UpdateCompare();
+
+		return ALARM_OK;
+}
+
+/*!
+ * @brief Adds an alarm.
+ *
+ * The first fire time is computed from the time passed to the last Alarm_Init() or
+ * Alarm_Process() call. Complexity is O(log n).
+ *
+ * @param[in] EntryPtr Pointer to the alarm description.
+ * @param[out] IdPtr Identifier of the new alarm.
+ * @return ALARM_OK on success, ALARM_ERR_PARA or ALARM_ERR_FULL on error.
+ */
+Alarm_ret_t Alarm_Add(const Alarm_EntryType * EntryPtr, unsigned short * IdPtr)
+{
+		unsigned short id;
+		unsigned int fire;
+
+		/* Check parameter */
+		if ((EntryPtr == NULL) || (IdPtr == NULL) || (EntryPtr->type > ALARM_TYPE_INTERVAL))
+		{
+			return ALARM_ERR_PARA;
+		}
+		if ((EntryPtr->type == ALARM_TYPE_WEEKDAY) &&
+		    (((EntryPtr->weekdayMask & ALARM_EVERY_DAY) == 0u) || (EntryPtr->time >= ALARM_SECONDS_PER_DAY)))
+		{
+			return ALARM_ERR_PARA;
+		}
+		if ((EntryPtr->type == ALARM_TYPE_INTERVAL) && (EntryPtr->time == 0u))
+		{
+			return ALARM_ERR_PARA;
+		}
+		fire = Alarm_FirstFire(EntryPtr);
+		if (fire == ALARM_NO_COMPARE)
+		{
+			return ALARM_ERR_PARA;
+		}
+		if (Alarm_FreeCount == 0u)
+		{
+			return ALARM_ERR_FULL;
+		}
+
+		/* 1. Take a free slot */
+		Alarm_FreeCount--;
+		id = Alarm_FreeList[Alarm_FreeCount];
+		Alarm_Slot[id].entry = *EntryPtr;
+		Alarm_Slot[id].nextFire = fire;
+
+		/* 2. Insert into the heap */
+		Alarm_HeapPlace(Alarm_HeapSize, id);
+		Alarm_HeapSize++;
+		Alarm_SiftUp(Alarm_Slot[id].heapPos);
+
+		Alarm_UpdateCompare();
+		*IdPtr = id;
+		return ALARM_OK;
+}
+
+/*!
+ * @brief Removes an alarm.
+ *
+ * Complexity is O(log n).
+ *
+ * @param[in] id Identifier returned by Alarm_Add().
+ * @return ALARM_OK on success, ALARM_ERR_NOT_FOUND if the alarm is not in use.
+ */
+Alarm_ret_t Alarm_Remove(unsigned short id)
+{
+		/* Check parameter */
+		if ((id >= ALARM_MAX_COUNT) || (Alarm_Slot[id].heapPos == ALARM_INVALID_ID))
+		{
+			return ALARM_ERR_NOT_FOUND;
+		}
+
+		Alarm_HeapRemoveAt(Alarm_Slot[id].heapPos);
+		Alarm_FreeList[Alarm_FreeCount] = id;
+		Alarm_FreeCount++;
+
+		Alarm_UpdateCompare();
+		return ALARM_OK;
+}
+
+/*!
+ * @brief Fires every alarm that is due.
+ *
+ * Call this from the RTC alarm / timer compare interrupt, or once per second. When no alarm is
+ * due the cost is a single comparison against the heap root. Each fired alarm costs O(log n);
+ * the recurrence of an alarm is only recomputed when it fires.
+ *
+ * @param[in] now Current epoch time in seconds.
+ * @return void.
+ */
+void Alarm_Process(unsigned int now)
+{
+		Alarm_Now = now;
+		TRACE_CALL_BEGIN(TRACE_ID_ALARM_PROCESS);
+
+		while ((Alarm_HeapSize != 0u) && (Alarm_Slot[Alarm_Heap[0]].nextFire <= now))
+		{
+			unsigned short id = Alarm_Heap[0];
+			Alarm_SlotType * slot = &Alarm_Slot[id];
+			Alarm_CallbackType callback = slot->entry.callback;
+			void * userData = slot->entry.userData;
+
+			switch (slot->entry.type)
+			{
+				case ALARM_TYPE_WEEKDAY:
+					/* Recompute the recurrence lazily and move the root down */
+					slot->nextFire = Alarm_NextWeekday(now, slot->entry.time, slot->entry.weekdayMask);
+					Alarm_SiftDown(0u);
+					break;
+				case ALARM_TYPE_INTERVAL:
+					/* Skip periods that were missed while the scheduler was not called */
+					slot->nextFire += slot->entry.time;
+					if (slot->nextFire <= now)
+					{
+						slot->nextFire += (((now - slot->nextFire) / slot->entry.time) + 1u) * slot->entry.time;
+					}
+					Alarm_SiftDown(0u);
+					break;
+				case ALARM_TYPE_ONE_SHOT:
+				case ALARM_TYPE_COUNTDOWN:
+				default:
+					/* Release before notifying so the callback may reuse the slot */
+					Alarm_HeapRemoveAt(0u);
+					Alarm_FreeList[Alarm_FreeCount] = id;
+					Alarm_FreeCount++;
+					break;
+			}
+
+			TRACE_EVENT(TRACE_ID_ALARM_FIRE, id);
+			if (callback != NULL)
+			{
+				callback(id, userData);
+			}
+		}
+
+		Alarm_UpdateCompare();
+		TRACE_CALL_END(TRACE_ID_ALARM_PROCESS, Alarm_HeapSize);
+}
+
+/*!
+ * @brief Returns the earliest pending fire time.
+ *
+ * @param[out] TimePtr Earliest fire time in epoch seconds.
+ * @return ALARM_OK when an alarm is pending, ALARM_ERR_NOT_FOUND otherwise.
+ */
+Alarm_ret_t Alarm_GetNextFireTime(unsigned int * TimePtr)
+{
+		/* Check parameter */
+		if (TimePtr == NULL)
+		{
+			return ALARM_ERR_PARA;
+		}
+		if (Alarm_HeapSize == 0u)
+		{
+			return ALARM_ERR_NOT_FOUND;
+		}
+
+		*TimePtr = Alarm_Slot[Alarm_Heap[0]].nextFire;
+		return ALARM_OK;
+}
+
+/*!
+ * @brief Returns the number of alarms in use.
+ *
+ * @return Number of alarms in use.
+ */
+unsigned short Alarm_GetCount(void)
+{
+		return Alarm_HeapSize;
+}
@@ -0,0 +1,250 @@
+/****************************************************************************************************
+* @file    Brightness.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the display brightness service.
+* @details This file maps perceptual brightness levels to PWM duty through a precomputed gamma
+*          table and runs fades as a fixed-point ramp, one step per FTM reload point.
+* @version 1.0.0
+* @date    2024-11-02
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Brightness.h"
+#include "Perf.h"
+#include "Trace.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define BRIGHTNESS_FRAC_SHIFT           (16u)              /* Q16 level during a fade */
+#define BRIGHTNESS_FRAC_MASK            ((1u << BRIGHTNESS_FRAC_SHIFT) - 1u)
+#define BRIGHTNESS_MS_PER_SECOND        (1000u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+/* duty = round(65535 * (level / 100) ^ 2.2), level 0 to 100 */
+static const unsigned short Brightness_Gamma[BRIGHTNESS_LEVEL_MAX + 1u] =
+{
+		    0u,     3u,    12u,    29u,    55u,    90u,   134u,   189u,
+		  253u,   328u,   413u,   510u,   618u,   736u,   867u,  1009u,
+		 1163u,  1329u,  1507u,  1697u,  1900u,  2115u,  2343u,  2584u,
+		 2838u,  3104u,  3384u,  3677u,  3983u,  4303u,  4636u,  4983u,
+		 5343u,  5717u,  6106u,  6508u,  6924u,  7354u,  7798u,  8257u,
+		 8730u,  9217u,  9719u, 10235u, 10766u, 11312u, 11872u, 12448u,
+		13038u, 13643u, 14263u, 14898u, 15548u, 16214u, 16894u, 17590u,
+		18302u, 19028u, 19770u, 20528u, 21301u, 22090u, 22895u, 23715u,
+		24551u, 25403u, 26271u, 27154u, 28054u, 28970u, 29901u, 30849u,
+		31813u, 32793u, 33790u, 34802u, 35831u, 36877u, 37939u, 39017u,
+		40112u, 41223u, 42351u, 43496u, 44657u, 45835u, 47029u, 48241u,
+		49469u, 50714u, 51976u, 53255u, 54551u, 55864u, 57195u, 58542u,
+		59906u, 61287u, 62686u, 64102u, 65535u,
+};
+
+static const Brightness_ConfigType * Brightness_Config;     /* Active configuration */
+static unsigned char Brightness_PerfRegistered;             /* Perf callback registered once */
+
+/* Fade state */
+static int32         Brightness_Position;                   /* Current level (Q16) */
+static int32         Brightness_Target;                     /* Target level (Q16) */
+static int32         Brightness_Step;                       /* Level change per reload point (Q16) */
+static unsigned int  Brightness_StepsLeft;                  /* Reload points until the target */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Converts a Q16 level into a duty, interpolating between table entries.
+ */
+static unsigned short Brightness_LevelToDuty(int32 position)
+{
+		unsigned int index = (unsigned int)position >> BRIGHTNESS_FRAC_SHIFT;
+		unsigned int frac = (unsigned int)position & BRIGHTNESS_FRAC_MASK;
+		unsigned int low;
+		unsigned int high;
+
+		if (index >= BRIGHTNESS_LEVEL_MAX)
+		{
+			return Brightness_Gamma[BRIGHTNESS_LEVEL_MAX];
+		}
+
+		low = Brightness_Gamma[index];
+		high = Brightness_Gamma[index + 1u];
+		return (unsigned short)(low + (((high - low) * frac) >> BRIGHTNESS_FRAC_SHIFT));
+}
+
+/*!
+ * @brief Writes the duty of the current position and loads it at the next reload point.
+ */
+static void Brightness_Apply(void)
+{
+		(void)Ftm_SetDuty(Brightness_Config->pwm->instance, Brightness_Config->channel,
+		                  Brightness_LevelToDuty(Brightness_Position));
+		Ftm_LoadAtReload(Brightness_Config->pwm->instance);
+}
+
+/*!
+ * @brief Keeps the PWM period when the Perf level changes the system clock.
+ */
+static void Brightness_PerfCallback(Perf_notify_t notify, const Perf_FreqType * FreqPtr, void * userData)
+{
+		(void)FreqPtr;
+		(void)userData;
+
+		if ((notify == PERF_NOTIFY_POST_CHANGE) && (Brightness_Config != NULL))
+		{
+			(void)Ftm_Retune(Brightness_Config->pwm->instance);
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the brightness service and starts the PWM.
+ *
+ * @param[in] ConfigPtr Pointer to the brightness configuration structure.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA or BRIGHTNESS_ERR_PWM on error.
+ * @note The PWM period follows Perf level changes through a Perf callback.
+ */
+Brightness_ret_t Brightness_Init(const Brightness_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->pwm == NULL) || (ConfigPtr->initialLevel > BRIGHTNESS_LEVEL_MAX))
+		{
+			return BRIGHTNESS_ERR_PARA;
+		}
+
+		if (Ftm_Init(ConfigPtr->pwm) != FTM_OK)
+		{
+			return BRIGHTNESS_ERR_PWM;
+		}
+
+		Brightness_Config = ConfigPtr;
+		Brightness_StepsLeft = 0u;
+		Brightness_Position = (int32)ConfigPtr->initialLevel << BRIGHTNESS_FRAC_SHIFT;
+		Brightness_Target = Brightness_Position;
+		Brightness_Apply();
+
+		if (Brightness_PerfRegistered == 0u)
+		{
+			if (Perf_RegisterCallback(Brightness_PerfCallback, NULL) == PERF_OK)
+			{
+				Brightness_PerfRegistered = 1u;
+			}
+		}
+
+		return BRIGHTNESS_OK;
+}
+
+/*!
+ * @brief Sets the brightness at the next reload point, cancelling a fade.
+ *
+ * @param[in] level Brightness, 0 to BRIGHTNESS_LEVEL_MAX.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA on parameter error.
+ */
+Brightness_ret_t Brightness_Set(unsigned char level)
+{
+		/* Check parameter */
+		if ((Brightness_Config == NULL) || (level > BRIGHTNESS_LEVEL_MAX))
+		{
+			return BRIGHTNESS_ERR_PARA;
+		}
+
+		Brightness_StepsLeft = 0u;
+		Brightness_Position = (int32)level << BRIGHTNESS_FRAC_SHIFT;
+		Brightness_Target = Brightness_Position;
+		Brightness_Apply();
+
+		return BRIGHTNESS_OK;
+}
+
+/*!
+ * @brief Starts a fade from the current brightness.
+ *
+ * The number of steps is the number of reload points in the duration, so the step size does
+ * not depend on how often Brightness_Process() is called.
+ *
+ * @param[in] level Target brightness, 0 to BRIGHTNESS_LEVEL_MAX.
+ * @param[in] durationMs Fade duration; 0 sets the level immediately.
+ * @return BRIGHTNESS_OK on success, BRIGHTNESS_ERR_PARA on parameter error.
+ */
+Brightness_ret_t Brightness_FadeTo(unsigned char level, unsigned int durationMs)
+{
+		const Ftm_ConfigType * pwm;
+		uint64 steps;
+
+		/* Check parameter */
+		if ((Brightness_Config == NULL) || (level > BRIGHTNESS_LEVEL_MAX))
+		{
+			return BRIGHTNESS_ERR_PARA;
+		}
+
+		pwm = Brightness_Config->pwm;
+		steps = ((uint64)durationMs * pwm->frequencyHz) /
+		        ((uint64)BRIGHTNESS_MS_PER_SECOND * ((unsigned int)pwm->reloadDivider + 1u));
+		if (steps == 0u)
+		{
+			return Brightness_Set(level);
+		}
+		if (steps > 0xFFFFFFFFu)
+		{
+			steps = 0xFFFFFFFFu;
+		}
+
+		/* Start from the first reload point after this call */
+		(void)Ftm_TakeReloadFlag(pwm->instance);
+		Brightness_Target = (int32)level << BRIGHTNESS_FRAC_SHIFT;
+		Brightness_Step = (Brightness_Target - Brightness_Position) / (int32)(unsigned int)steps;
+		Brightness_StepsLeft = (unsigned int)steps;
+
+		return BRIGHTNESS_OK;
+}
+
+/*!
+ * @brief Advances a running fade.
+ *
+ * Call this from the main loop. One step is written per reload point; nothing is done
+ * between reload points.
+ *
+ * @return 1 while a fade is running, 0 otherwise.
+ * @note Polling slower than the reload rate stretches the fade, it never skips a step.
+ */
+unsigned char Brightness_Process(void)
+{
+		if ((Brightness_Config == NULL) || (Brightness_StepsLeft == 0u))
+		{
+			return 0u;
+		}
+
+		if (Ftm_TakeReloadFlag(Brightness_Config->pwm->instance) == 0u)
+		{
+			return 1u;
+		}
+
+		/* The last step lands exactly on the target, whatever the rounding of Brightness_Step */
+		Brightness_StepsLeft--;
+		Brightness_Position = (Brightness_StepsLeft == 0u) ? Brightness_Target :
+		                      (Brightness_Position + Brightness_Step);
+		Brightness_Apply();
+		TRACE_EVENT(TRACE_ID_BRIGHTNESS_STEP, (unsigned int)Brightness_Position >> BRIGHTNESS_FRAC_SHIFT);
+
+		return (Brightness_StepsLeft != 0u) ? 1u : 0u;
+}
+
+/*!
+ * @brief Gets the current brightness.
+ *
+ * @return Brightness, 0 to BRIGHTNESS_LEVEL_MAX, rounded down during a fade.
+ */
+unsigned char Brightness_GetLevel(void)
+{
+		return (unsigned char)((unsigned int)Brightness_Position >> BRIGHTNESS_FRAC_SHIFT);
+}
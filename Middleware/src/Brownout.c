@@ -0,0 +1,406 @@
+/****************************************************************************************************
+* @file    Brownout.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the power-fail time snapshot.
+* @details A record is two phrases: {seconds, nanoseconds}, then {ppb, type, ~type, CRC-16 of the
+*          first 14 bytes}. Records are appended in slot order and the last valid one tells the
+*          state: a SAVED snapshot is restored at boot, then a CONSUMED record is appended. A
+*          record torn by the power loss fails its CRC and the one before it counts.
+* @version 1.0.0
+* @date    2024-11-13
+* @note    The warning interrupt may preempt Brownout_Process() in the middle of a record; each
+*          writer claims its slot first, so the records never overlap. Every phrase is loaded into
+*          the FCCOB and launched under the SETTINGS lock, which masks the warning, and waited for
+*          outside it.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Brownout.h"
+#include "Kv.h"
+#include "Calib.h"
+#include "Pmc.h"
+#include "Dwt.h"
+#include "Cpu.h"
+#include "Srp.h"
+#include "Proto.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Record bytes ***/
+#define BROWNOUT_REC_SECONDS            (0u)
+#define BROWNOUT_REC_NANOSECONDS        (4u)
+#define BROWNOUT_REC_PPB                (8u)
+#define BROWNOUT_REC_TYPE               (12u)
+#define BROWNOUT_REC_TYPE_INV           (13u)
+#define BROWNOUT_REC_CRC                (14u)
+
+#define BROWNOUT_US_PER_SECOND          (1000000u)
+#define BROWNOUT_NS_PER_US              (1000u)
+#define BROWNOUT_POWER_RESPONSE         (22u)              /* PROTO_CMD_GET_POWER payload */
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Brownout_ConfigType * Brownout_Config;     /* Active configuration */
+static Brownout_StatsType Brownout_Stats;
+static volatile unsigned short Brownout_NextSlot;       /* First slot after the last written one */
+static volatile unsigned char Brownout_Warned;          /* Warning handled, supply not back yet */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Reads a little-endian word of the flash.
+ */
+static unsigned int Brownout_ReadWord(const unsigned char * DataPtr)
+{
+		return (unsigned int)DataPtr[0] | ((unsigned int)DataPtr[1] << 8u) |
+		       ((unsigned int)DataPtr[2] << 16u) | ((unsigned int)DataPtr[3] << 24u);
+}
+
+/*!
+ * @brief Writes a little-endian word.
+ */
+static void Brownout_PutWord(unsigned char * DataPtr, unsigned int value)
+{
+		DataPtr[0] = (unsigned char)value;
+		DataPtr[1] = (unsigned char)(value >> 8u);
+		DataPtr[2] = (unsigned char)(value >> 16u);
+		DataPtr[3] = (unsigned char)(value >> 24u);
+}
+
+/*!
+ * @brief Tells whether a slot is blank, valid or neither.
+ *
+ * @return 0 when blank, the record type when valid, 1 otherwise.
+ */
+static unsigned char Brownout_CheckSlot(const unsigned char * RecordPtr)
+{
+		unsigned char blank = 1u;
+		unsigned char index;
+		unsigned char type = RecordPtr[BROWNOUT_REC_TYPE];
+
+		for (index = 0u; index < BROWNOUT_RECORD_SIZE; index++)
+		{
+			if (RecordPtr[index] != 0xFFu)
+			{
+				blank = 0u;
+			}
+		}
+		if (blank != 0u)
+		{
+			return 0u;
+		}
+
+		if ((RecordPtr[BROWNOUT_REC_TYPE_INV] != (unsigned char)~type) ||
+		    ((type != BROWNOUT_TYPE_SAVED) && (type != BROWNOUT_TYPE_CONSUMED)) ||
+		    (Crc16_Compute(RecordPtr, BROWNOUT_REC_CRC) !=
+		     (unsigned short)(RecordPtr[BROWNOUT_REC_CRC] | ((unsigned int)RecordPtr[BROWNOUT_REC_CRC + 1u] << 8u))))
+		{
+			return 1u;
+		}
+		return type;
+}
+
+/*!
+ * @brief Claims the next slot; a torn record is skipped like a written one.
+ *
+ * @return Slot, BROWNOUT_SLOTS when the sector is full.
+ */
+static unsigned short Brownout_Claim(void)
+{
+		unsigned int primask;
+		unsigned short slot;
+
+		primask = Cpu_EnterCritical();
+		slot = Brownout_NextSlot;
+		if (slot < BROWNOUT_SLOTS)
+		{
+			Brownout_NextSlot = (unsigned short)(slot + 1u);
+		}
+		Cpu_ExitCritical(primask);
+
+		return slot;
+}
+
+/*!
+ * @brief Programs a record with the current time into a claimed slot, using polled commands.
+ */
+static Ftfc_ret_t Brownout_WriteRecord(unsigned short slot, unsigned char type)
+{
+		unsigned char record[BROWNOUT_RECORD_SIZE];
+		unsigned int seconds;
+		unsigned int nanoseconds;
+		unsigned int address;
+		unsigned int saved;
+		unsigned short crc;
+		unsigned char index;
+		Ftfc_ret_t result;
+
+		if (slot >= BROWNOUT_SLOTS)
+		{
+			return FTFC_ERR_PARA;
+		}
+
+		Calib_GetTime(&seconds, &nanoseconds);
+		Brownout_PutWord(&record[BROWNOUT_REC_SECONDS], seconds);
+		Brownout_PutWord(&record[BROWNOUT_REC_NANOSECONDS], nanoseconds);
+		Brownout_PutWord(&record[BROWNOUT_REC_PPB], (unsigned int)Calib_GetPpb());
+		record[BROWNOUT_REC_TYPE] = type;
+		record[BROWNOUT_REC_TYPE_INV] = (unsigned char)~type;
+		crc = Crc16_Compute(record, BROWNOUT_REC_CRC);
+		record[BROWNOUT_REC_CRC] = (unsigned char)crc;
+		record[BROWNOUT_REC_CRC + 1u] = (unsigned char)(crc >> 8u);
+
+		address = Brownout_Config->flashAddress + ((unsigned int)slot * BROWNOUT_RECORD_SIZE);
+		for (index = 0u; index < BROWNOUT_RECORD_SIZE; index += FTFC_PHRASE_SIZE)
+		{
+			/* A warning between the FCCOB loads and the launch would launch its own command with
+			 * them; in the warning interrupt itself the lock changes nothing */
+			saved = SRP_LOCK(MAIN, SETTINGS);
+			result = Ftfc_ProgramPhrase(address + index, &record[index]);
+			SRP_UNLOCK(saved);
+			if (result == FTFC_OK)
+			{
+				result = Ftfc_Wait();
+			}
+			if (result != FTFC_OK)
+			{
+				return result;
+			}
+		}
+
+		return FTFC_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_POWER, reports the power-fail statistics.
+ *
+ * Response: saves, snapshot cycles, total cycles, worst cycles and lost, u32 each, then keys
+ * left u8 and restored u8.
+ */
+static Proto_status_t Brownout_HandleGetPower(const unsigned char * Request, unsigned char length,
+                                              unsigned char * Response, unsigned char * ResponseLength)
+{
+		(void)Request;
+		(void)length;
+
+		Brownout_PutWord(&Response[0], Brownout_Stats.saves);
+		Brownout_PutWord(&Response[4], Brownout_Stats.snapshotCycles);
+		Brownout_PutWord(&Response[8], Brownout_Stats.totalCycles);
+		Brownout_PutWord(&Response[12], Brownout_Stats.worstCycles);
+		Brownout_PutWord(&Response[16], Brownout_Stats.lost);
+		Response[20] = Brownout_Stats.keysLeft;
+		Response[21] = Brownout_Stats.restored;
+		*ResponseLength = BROWNOUT_POWER_RESPONSE;
+
+		return PROTO_STATUS_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Restores the snapshot left by the last power failure.
+ *
+ * This function finds the last record of the sector. A snapshot not restored yet sets the
+ * software clock to the saved time plus the hold-up time plus the time since Calib_Init(), and
+ * the oscillator correction to the saved one; then it is marked as restored. The sector is erased
+ * when fewer than BROWNOUT_SLOTS_MIN records fit, which stalls the boot for one sector erase.
+ * The statistics are served to the serial protocol as PROTO_CMD_GET_POWER.
+ *
+ * @param[in] ConfigPtr Pointer to the snapshot configuration structure.
+ * @return BROWNOUT_OK on success, BROWNOUT_ERR_PARA or BROWNOUT_ERR_FLASH on error.
+ * @note The flash must be idle; call before the first Kv_Process().
+ */
+Brownout_ret_t Brownout_Init(const Brownout_ConfigType * ConfigPtr)
+{
+		const unsigned char * last = NULL;
+		const unsigned char * record;
+		unsigned int seconds;
+		unsigned int nanoseconds;
+		unsigned short slot;
+		unsigned char state;
+		Ftfc_ret_t result;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->readPtr == NULL) ||
+		    ((ConfigPtr->flashAddress % FTFC_DFLASH_SECTOR_SIZE) != 0u))
+		{
+			return BROWNOUT_ERR_PARA;
+		}
+
+		Brownout_Config = ConfigPtr;
+		Brownout_Warned = 0u;
+		Brownout_Stats.saves = 0u;
+		Brownout_Stats.snapshotCycles = 0u;
+		Brownout_Stats.totalCycles = 0u;
+		Brownout_Stats.worstCycles = 0u;
+		Brownout_Stats.lost = 0u;
+		Brownout_Stats.keysLeft = 0u;
+		Brownout_Stats.restored = 0u;
+		(void)Proto_Register(PROTO_CMD_GET_POWER, Brownout_HandleGetPower, 0u, 0u);
+
+		/* 1. Last valid record, and the first slot after everything written */
+		Brownout_NextSlot = 0u;
+		for (slot = 0u; slot < BROWNOUT_SLOTS; slot++)
+		{
+			record = &ConfigPtr->readPtr[(unsigned int)slot * BROWNOUT_RECORD_SIZE];
+			state = Brownout_CheckSlot(record);
+			if (state != 0u)
+			{
+				Brownout_NextSlot = (unsigned short)(slot + 1u);
+			}
+			if (state > 1u)
+			{
+				last = record;
+			}
+		}
+
+		/* 2. Saved time + hold-up + boot so far; the time spent unpowered is unknown */
+		if ((last != NULL) && (last[BROWNOUT_REC_TYPE] == BROWNOUT_TYPE_SAVED))
+		{
+			Calib_GetTime(&seconds, &nanoseconds);
+			seconds += Brownout_ReadWord(&last[BROWNOUT_REC_SECONDS]) + (ConfigPtr->holdupUs / BROWNOUT_US_PER_SECOND);
+			nanoseconds += Brownout_ReadWord(&last[BROWNOUT_REC_NANOSECONDS]) +
+			               ((ConfigPtr->holdupUs % BROWNOUT_US_PER_SECOND) * BROWNOUT_NS_PER_US);
+			while (nanoseconds >= CALIB_NS_PER_SECOND)
+			{
+				nanoseconds -= CALIB_NS_PER_SECOND;
+				seconds++;
+			}
+			Calib_SetTime(seconds, nanoseconds);
+			(void)Calib_SetPpb((int32)Brownout_ReadWord(&last[BROWNOUT_REC_PPB]));
+			Brownout_Stats.restored = 1u;
+		}
+
+		/* 3. Keep room for the next warning; an erase also consumes the snapshot */
+		if ((BROWNOUT_SLOTS - Brownout_NextSlot) < BROWNOUT_SLOTS_MIN)
+		{
+			result = Ftfc_EraseSector(ConfigPtr->flashAddress);
+			if (result == FTFC_OK)
+			{
+				result = Ftfc_Wait();
+			}
+			if (result != FTFC_OK)
+			{
+				return BROWNOUT_ERR_FLASH;
+			}
+			Brownout_NextSlot = 0u;
+		}
+		else if (Brownout_Stats.restored != 0u)
+		{
+			(void)Brownout_WriteRecord(Brownout_Claim(), BROWNOUT_TYPE_CONSUMED);
+		}
+		else
+		{
+			/* Nothing to restore */
+		}
+
+		return BROWNOUT_OK;
+}
+
+/*!
+ * @brief Low voltage warning callback: saves the snapshot, then the dirty settings.
+ *
+ * Stops the flash command in progress, programs the snapshot with polled commands and calls
+ * Kv_Flush(). Takes about (2 + kvPhrases) phrase program times, plus one erase suspend.
+ *
+ * @return void.
+ * @note Runs in LVD_LVW_IRQHandler, above every user of the settings and below SysTick.
+ */
+void Brownout_OnWarning(void)
+{
+		unsigned int start = DWT_GET_CYCLES();
+		unsigned int cycles;
+
+		if (Brownout_Config == NULL)
+		{
+			return;
+		}
+
+		/* 1. Time first: an erase of the settings store is suspended, a phrase is waited for */
+		(void)Ftfc_Suspend();
+		if (Brownout_WriteRecord(Brownout_Claim(), BROWNOUT_TYPE_SAVED) != FTFC_OK)
+		{
+			Brownout_Stats.lost++;
+		}
+		Brownout_Stats.snapshotCycles = DWT_GET_CYCLES() - start;
+
+		/* 2. Settings, in the time left */
+		Brownout_Stats.keysLeft = (Brownout_Config->kvPhrases != 0u) ? Kv_Flush(Brownout_Config->kvPhrases) : 0u;
+
+		cycles = DWT_GET_CYCLES() - start;
+		Brownout_Stats.totalCycles = cycles;
+		if (cycles > Brownout_Stats.worstCycles)
+		{
+			Brownout_Stats.worstCycles = cycles;
+		}
+		Brownout_Stats.saves++;
+		Brownout_Warned = 1u;
+}
+
+/*!
+ * @brief Rearms the warning once the supply has recovered.
+ *
+ * The snapshot of a warning that was not followed by a reset is marked as consumed, so that it
+ * is not restored at a later reset. Call from the main loop, next to Kv_Process().
+ *
+ * @return void.
+ */
+void Brownout_Process(void)
+{
+		unsigned short slot;
+
+		if ((Brownout_Config == NULL) || (Brownout_Warned == 0u))
+		{
+			return;
+		}
+
+		/* Wait for the settings store to release the flash */
+		if (Ftfc_IsBusy() != 0u)
+		{
+			return;
+		}
+
+		/* Slot claimed before arming: the snapshot of a new warning lands after it and wins */
+		slot = Brownout_Claim();
+		Brownout_Warned = 0u;
+		if (Pmc_ArmWarning() != PMC_OK)
+		{
+			/* Still low, not armed: nothing can have claimed a slot since */
+			if (slot < BROWNOUT_SLOTS)
+			{
+				Brownout_NextSlot = slot;
+			}
+			Brownout_Warned = 1u;
+			return;
+		}
+		(void)Brownout_WriteRecord(slot, BROWNOUT_TYPE_CONSUMED);
+}
+
+/*!
+ * @brief Retrieves the power-fail statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return BROWNOUT_OK on success, BROWNOUT_ERR_PARA on parameter error.
+ */
+Brownout_ret_t Brownout_GetStats(Brownout_StatsType * StatsPtr)
+{
+		/* Check parameter */
+		if (StatsPtr == NULL)
+		{
+			return BROWNOUT_ERR_PARA;
+		}
+
+		*StatsPtr = Brownout_Stats;
+		return BROWNOUT_OK;
+}
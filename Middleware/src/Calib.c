@@ -0,0 +1,329 @@
+/****************************************************************************************************
+* @file    Calib.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the clock calibration service.
+* @details The core clock is measured by summing counter deltas between reference edges over a
+*          window. The resulting error in ppb is turned into a corrected tick increment, kept in
+*          nanoseconds with a 32-bit binary fraction, so that sub-nanosecond remainders accumulate
+*          instead of being dropped on every tick.
+* @version 1.0.0
+* @date    2024-10-22
+* @note    Calib_Tick() and Calib_OnReferenceEdge() may run in different interrupts. The software
+*          clock is double buffered: Calib_Tick() writes the buffer not in use and publishes it by
+*          incrementing a sequence counter, so a reader never waits for the tick interrupt, even
+*          from a higher priority.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Calib.h"
+
+#if !defined(CALIB_HOST)
+#include "Cpu.h"
+#endif
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define CALIB_FRAC_SHIFT                (32u)                                       /* Q32 fraction */
+#define CALIB_SECOND_Q32                ((uint64)CALIB_NS_PER_SECOND << CALIB_FRAC_SHIFT)
+
+/*** Critical sections: Calib_SetTime() must not be interrupted by Calib_Tick() ***/
+#if !defined(CALIB_HOST)
+#define CALIB_ENTER_CRITICAL()          Cpu_EnterCritical()
+#define CALIB_EXIT_CRITICAL(STATE)      Cpu_ExitCritical(STATE)
+#else
+#define CALIB_ENTER_CRITICAL()          (0u)
+#define CALIB_EXIT_CRITICAL(STATE)      ((void)(STATE))
+#endif
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   One buffer of the software clock.
+ */
+typedef struct
+{
+			unsigned int      seconds;
+			unsigned int      RESERVE1;
+			uint64            subSecond;          /*!< Nanoseconds into the second (ns Q32) */
+} Calib_TimeType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Calib_ConfigType    Calib_Config;              /* Active configuration */
+
+/* Measurement window */
+static unsigned int        Calib_LastStamp;           /* Counter value at the previous edge */
+static uint64              Calib_WindowSum;           /* Counter cycles in the current window */
+static unsigned int        Calib_WindowEdges;         /* Periods counted in the current window */
+static unsigned char       Calib_HaveStamp;           /* Calib_LastStamp is valid */
+static unsigned char       Calib_HaveEstimate;        /* Calib_Ppb holds a measured value */
+
+/* Correction */
+static int32               Calib_Ppb;                 /* Estimated oscillator error */
+static uint64              Calib_Increment[2];        /* Double-buffered tick increment (ns Q32) */
+static volatile unsigned char Calib_IncrementIdx;     /* Buffer used by Calib_Tick() */
+
+/* Software clock: Calib_Time[Calib_Sequence & 1] is the last one published */
+static volatile Calib_TimeType Calib_Time[2];
+static volatile unsigned int Calib_Sequence;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Recomputes the tick increment for the current error and publishes it.
+ *
+ * increment = tickPeriodNs * 1e9 / (1e9 + ppb). The ratio is computed in Q32 first so that no
+ * intermediate product overflows 64 bits.
+ */
+static void Calib_UpdateIncrement(void)
+{
+		uint64 ratioQ32;
+		unsigned char next = (unsigned char)(Calib_IncrementIdx ^ 1u);
+
+		ratioQ32 = CALIB_SECOND_Q32 / (uint64)((int64)CALIB_PPB_PER_UNIT + Calib_Ppb);
+		Calib_Increment[next] = (uint64)Calib_Config.tickPeriodNs * ratioQ32;
+
+		/* Single byte store switches the buffer used by the tick interrupt */
+		Calib_IncrementIdx = next;
+}
+
+/*!
+ * @brief Writes the software clock into the buffer not in use and publishes it.
+ *
+ * The caller must not be interrupted by another writer.
+ */
+static void Calib_Publish(unsigned int seq, unsigned int seconds, uint64 sub)
+{
+		volatile Calib_TimeType * next = &Calib_Time[(seq + 1u) & 1u];
+
+		next->seconds = seconds;
+		next->subSecond = sub;
+
+		/* Single word store switches the buffer used by the readers */
+		Calib_Sequence = seq + 1u;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the calibration service.
+ *
+ * The correction starts at 0 ppb and the software clock at 0 seconds.
+ *
+ * @param[in] ConfigPtr Pointer to the calibration configuration structure.
+ * @return CALIB_OK on success, CALIB_ERR_PARA on parameter error.
+ */
+Calib_ret_t Calib_Init(const Calib_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->counterFreqHz == 0u) || (ConfigPtr->refEdgeFreqHz == 0u) ||
+		    (ConfigPtr->windowEdges == 0u) || (ConfigPtr->tickPeriodNs == 0u) ||
+		    (ConfigPtr->tickPeriodNs >= CALIB_NS_PER_SECOND) || (ConfigPtr->filterShift > 16u))
+		{
+			return CALIB_ERR_PARA;
+		}
+
+		Calib_Config = *ConfigPtr;
+		Calib_Ppb = 0;
+		Calib_HaveEstimate = 0u;
+		Calib_RestartWindow();
+		Calib_UpdateIncrement();
+		Calib_SetTime(0u, 0u);
+
+		return CALIB_OK;
+}
+
+/*!
+ * @brief Records one reference edge.
+ *
+ * Call this from the reference interrupt with the counter value captured as early as possible.
+ * When a measurement window completes, the error estimate and the tick increment are updated.
+ *
+ * @param[in] counterStamp Counter value (e.g. DWT->CYCCNT) at the reference edge.
+ * @return CALIB_OK, or CALIB_ERR_RANGE when a completed window was rejected.
+ */
+Calib_ret_t Calib_OnReferenceEdge(unsigned int counterStamp)
+{
+		uint64 expected;
+		int64 ppb;
+
+		/* 1. The first edge only opens the window */
+		if (Calib_HaveStamp == 0u)
+		{
+			Calib_LastStamp = counterStamp;
+			Calib_HaveStamp = 1u;
+			return CALIB_OK;
+		}
+
+		/* 2. Unsigned subtraction handles the 32-bit counter wrap */
+		Calib_WindowSum += (unsigned int)(counterStamp - Calib_LastStamp);
+		Calib_LastStamp = counterStamp;
+		Calib_WindowEdges++;
+		if (Calib_WindowEdges < Calib_Config.windowEdges)
+		{
+			return CALIB_OK;
+		}
+
+		/* 3. Window complete: error = (measured - expected) / expected */
+		expected = ((uint64)Calib_Config.counterFreqHz * Calib_Config.windowEdges) / Calib_Config.refEdgeFreqHz;
+		ppb = (((int64)Calib_WindowSum - (int64)expected) * (int64)CALIB_PPB_PER_UNIT) / (int64)expected;
+		Calib_WindowSum = 0u;
+		Calib_WindowEdges = 0u;
+
+		if ((ppb > CALIB_MAX_PPB) || (ppb < -CALIB_MAX_PPB))
+		{
+			return CALIB_ERR_RANGE;
+		}
+
+		/* 4. Smooth successive estimates to follow slow temperature drift without jitter */
+		if (Calib_HaveEstimate == 0u)
+		{
+			Calib_Ppb = (int32)ppb;
+			Calib_HaveEstimate = 1u;
+		}
+		else if (Calib_Config.filterShift != 0u)
+		{
+			/* Arithmetic shift rounded to nearest: a division truncates toward 0 and biases the
+			   estimate toward the previous one */
+			Calib_Ppb += (int32)(((ppb - Calib_Ppb) + ((int64)1 << (Calib_Config.filterShift - 1u))) >>
+			                     Calib_Config.filterShift);
+		}
+		else
+		{
+			Calib_Ppb = (int32)ppb;
+		}
+		Calib_UpdateIncrement();
+
+		return CALIB_OK;
+}
+
+/*!
+ * @brief Restarts the measurement window.
+ *
+ * Call this when the reference was lost, so that a gap is not counted as a long period.
+ *
+ * @return void.
+ */
+void Calib_RestartWindow(void)
+{
+		Calib_HaveStamp = 0u;
+		Calib_WindowSum = 0u;
+		Calib_WindowEdges = 0u;
+}
+
+/*!
+ * @brief Advances the software clock by one corrected tick.
+ *
+ * Call this from the SysTick interrupt.
+ *
+ * @return void.
+ */
+void Calib_Tick(void)
+{
+		unsigned int seq = Calib_Sequence;
+		unsigned int seconds = Calib_Time[seq & 1u].seconds;
+		uint64 sub = Calib_Time[seq & 1u].subSecond + Calib_Increment[Calib_IncrementIdx];
+
+		while (sub >= CALIB_SECOND_Q32)
+		{
+			sub -= CALIB_SECOND_Q32;
+			seconds++;
+		}
+		Calib_Publish(seq, seconds, sub);
+}
+
+/*!
+ * @brief Retrieves the software clock.
+ *
+ * Safe from any context: it never waits for Calib_Tick(), even from a higher priority.
+ *
+ * @param[out] SecondsPtr Seconds part.
+ * @param[out] NanosecondsPtr Nanoseconds part, may be NULL.
+ * @return void.
+ */
+void Calib_GetTime(unsigned int * SecondsPtr, unsigned int * NanosecondsPtr)
+{
+		unsigned int seq;
+		unsigned int seconds;
+		uint64 sub;
+
+		/* A reader that interrupted Calib_Tick() reads the buffer published before, without
+		   waiting. A reader interrupted by it retries only when two ticks published during the
+		   read, the second one into the buffer being read. */
+		do
+		{
+			seq = Calib_Sequence;
+			seconds = Calib_Time[seq & 1u].seconds;
+			sub = Calib_Time[seq & 1u].subSecond;
+		} while ((Calib_Sequence - seq) > 1u);
+
+		if (SecondsPtr != NULL)
+		{
+			*SecondsPtr = seconds;
+		}
+		if (NanosecondsPtr != NULL)
+		{
+			*NanosecondsPtr = (unsigned int)(sub >> CALIB_FRAC_SHIFT);
+		}
+}
+
+/*!
+ * @brief Sets the software clock.
+ *
+ * Masks interrupts for a few instructions, so that Calib_Tick() does not write the same buffer.
+ *
+ * @param[in] seconds Seconds part.
+ * @param[in] nanoseconds Nanoseconds part (< 1e9).
+ * @return void.
+ */
+void Calib_SetTime(unsigned int seconds, unsigned int nanoseconds)
+{
+		unsigned int state;
+
+		/* Calib_Tick() would write the same buffer */
+		state = CALIB_ENTER_CRITICAL();
+		Calib_Publish(Calib_Sequence, seconds, (uint64)(nanoseconds % CALIB_NS_PER_SECOND) << CALIB_FRAC_SHIFT);
+		CALIB_EXIT_CRITICAL(state);
+}
+
+/*!
+ * @brief Retrieves the estimated oscillator error.
+ *
+ * @return Error in parts per billion; positive when the oscillator runs fast.
+ */
+int32 Calib_GetPpb(void)
+{
+		return Calib_Ppb;
+}
+
+/*!
+ * @brief Sets the oscillator error, e.g. from a value stored in flash.
+ *
+ * @param[in] ppb Error in parts per billion; positive when the oscillator runs fast.
+ * @return CALIB_OK on success, CALIB_ERR_RANGE when outside CALIB_MAX_PPB.
+ */
+Calib_ret_t Calib_SetPpb(int32 ppb)
+{
+		if ((ppb > CALIB_MAX_PPB) || (ppb < -CALIB_MAX_PPB))
+		{
+			return CALIB_ERR_RANGE;
+		}
+
+		Calib_Ppb = ppb;
+		Calib_HaveEstimate = 1u;
+		Calib_UpdateIncrement();
+		return CALIB_OK;
+}
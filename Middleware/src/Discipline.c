@@ -0,0 +1,455 @@
+/****************************************************************************************************
+* @file    Discipline.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the clock discipline loop.
+* @details This file implements a type II loop in the style of NTP. With the offset theta and the
+*          time constant Tc, the rate correction is theta / Tc (proportional) and the frequency
+*          estimate moves by theta * interval / (4 * Tc^2) per sample (integral), which gives a
+*          damping factor near 1. The frequency is kept in Q16 ppb so that the small integral
+*          steps of a locked loop are not truncated. Calib receives frequency minus phase
+*          correction as its ppb value.
+* @version 1.0.0
+* @date    2024-11-15
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Discipline.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define DISCIPLINE_FREQ_SHIFT           (16u)              /* Q16 ppb */
+#define DISCIPLINE_Q16(PPB)             ((int64)(PPB) * ((int64)1 << DISCIPLINE_FREQ_SHIFT))
+#define DISCIPLINE_JITTER_SHIFT         (3u)               /* Jitter average over 8 samples */
+#define DISCIPLINE_TC_MAX               (4096u)
+#define DISCIPLINE_NS_PER_MS            (1000000)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Discipline_ConfigType Discipline_Config;              /* Active configuration */
+static Discipline_state_t    Discipline_State;
+
+/* Spike filter */
+static int64                 Discipline_History[DISCIPLINE_HISTORY];
+static unsigned char         Discipline_HistoryCount;
+static unsigned char         Discipline_HistoryIdx;
+static unsigned char         Discipline_Rejects;             /* Consecutive spikes */
+static unsigned int          Discipline_Jitter;
+
+/* Loop */
+static int64                 Discipline_FreqQ16;             /* Oscillator error estimate, Q16 ppb */
+static int64                 Discipline_LastOffset;
+static uint64                Discipline_LastLocal;           /* Software clock at the last sample */
+static uint64                Discipline_FreqStart;           /* Software clock when FREQ began */
+static int64                 Discipline_FreqOffset;          /* Offset when FREQ began */
+static unsigned char         Discipline_Above;               /* Consecutive samples above the step threshold */
+static unsigned char         Discipline_Below;               /* Consecutive samples below the lock threshold */
+
+/* Statistics */
+static unsigned int          Discipline_Samples;
+static unsigned int          Discipline_Rejected;
+static unsigned int          Discipline_Steps;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Absolute value.
+ */
+static uint64 Discipline_Abs(int64 value)
+{
+		return (value < 0) ? (uint64)(-value) : (uint64)value;
+}
+
+/*!
+ * @brief Limits a ppb value to the range of Calib.
+ */
+static int32 Discipline_Clamp(int64 ppb)
+{
+		if (ppb > CALIB_MAX_PPB)
+		{
+			return CALIB_MAX_PPB;
+		}
+		if (ppb < -CALIB_MAX_PPB)
+		{
+			return -CALIB_MAX_PPB;
+		}
+		return (int32)ppb;
+}
+
+/*!
+ * @brief Saturates a value to 32 bits.
+ */
+static int32 Discipline_Saturate(int64 value)
+{
+		if (value > (int64)0x7FFFFFFF)
+		{
+			return (int32)0x7FFFFFFF;
+		}
+		if (value < -(int64)0x7FFFFFFF)
+		{
+			return -(int32)0x7FFFFFFF;
+		}
+		return (int32)value;
+}
+
+/*!
+ * @brief Reads the software clock in nanoseconds.
+ */
+static uint64 Discipline_Now(void)
+{
+		unsigned int seconds;
+		unsigned int nanoseconds;
+
+		Calib_GetTime(&seconds, &nanoseconds);
+		return ((uint64)seconds * CALIB_NS_PER_SECOND) + nanoseconds;
+}
+
+/*!
+ * @brief Median of the recent samples, insertion sort of a copy.
+ */
+static int64 Discipline_Median(void)
+{
+		int64 sorted[DISCIPLINE_HISTORY];
+		int64 value;
+		unsigned char index;
+		unsigned char slot;
+
+		for (index = 0u; index < Discipline_HistoryCount; index++)
+		{
+			value = Discipline_History[index];
+			slot = index;
+			while ((slot > 0u) && (sorted[slot - 1u] > value))
+			{
+				sorted[slot] = sorted[slot - 1u];
+				slot--;
+			}
+			sorted[slot] = value;
+		}
+		return sorted[Discipline_HistoryCount / 2u];
+}
+
+/*!
+ * @brief Adds a sample to the spike filter history.
+ */
+static void Discipline_Remember(int64 offsetNs)
+{
+		Discipline_History[Discipline_HistoryIdx] = offsetNs;
+		Discipline_HistoryIdx = (unsigned char)((Discipline_HistoryIdx + 1u) % DISCIPLINE_HISTORY);
+		if (Discipline_HistoryCount < DISCIPLINE_HISTORY)
+		{
+			Discipline_HistoryCount++;
+		}
+}
+
+/*!
+ * @brief Steps the software clock and measures the frequency again.
+ *
+ * The offsets in the history refer to the old time, so they are dropped.
+ */
+static void Discipline_Step(uint64 localNs, int64 offsetNs)
+{
+		uint64 now = Discipline_Now() + (uint64)offsetNs;
+
+		Calib_SetTime((unsigned int)(now / CALIB_NS_PER_SECOND), (unsigned int)(now % CALIB_NS_PER_SECOND));
+		(void)Calib_SetPpb(Discipline_Clamp(Discipline_FreqQ16 >> DISCIPLINE_FREQ_SHIFT));
+
+		Discipline_HistoryCount = 0u;
+		Discipline_HistoryIdx = 0u;
+		Discipline_Above = 0u;
+		Discipline_Below = 0u;
+		Discipline_LastLocal = localNs + (uint64)offsetNs;
+		Discipline_LastOffset = 0;
+		Discipline_FreqStart = Discipline_LastLocal;
+		Discipline_FreqOffset = 0;
+		Discipline_State = DISCIPLINE_FREQ;
+		Discipline_Steps++;
+}
+
+/*!
+ * @brief Runs the proportional-integral update and sets the Calib rate.
+ */
+static void Discipline_Update(uint64 localNs, int64 offsetNs)
+{
+		int64 intervalMs = (int64)(localNs - Discipline_LastLocal) / DISCIPLINE_NS_PER_MS;
+		int64 tc = (int64)Discipline_Config.timeConstantS;
+		int64 divisor = 4 * tc * tc * 1000;
+		int64 product;
+		int64 phasePpb;
+
+		/* An interval beyond the time constant, e.g. after holdover, counts as one time constant */
+		if (intervalMs > (tc * 1000))
+		{
+			intervalMs = tc * 1000;
+		}
+		if (intervalMs > 0)
+		{
+			product = offsetNs * intervalMs;
+			Discipline_FreqQ16 -= DISCIPLINE_Q16(product / divisor) + (DISCIPLINE_Q16(product % divisor) / divisor);
+		}
+		if (Discipline_FreqQ16 > DISCIPLINE_Q16(CALIB_MAX_PPB))
+		{
+			Discipline_FreqQ16 = DISCIPLINE_Q16(CALIB_MAX_PPB);
+		}
+		if (Discipline_FreqQ16 < -DISCIPLINE_Q16(CALIB_MAX_PPB))
+		{
+			Discipline_FreqQ16 = -DISCIPLINE_Q16(CALIB_MAX_PPB);
+		}
+
+		/* A positive offset means the clock is behind: lower the ppb so that it runs faster */
+		phasePpb = offsetNs / tc;
+		(void)Calib_SetPpb(Discipline_Clamp((Discipline_FreqQ16 >> DISCIPLINE_FREQ_SHIFT) - phasePpb));
+
+		/* Lock with hysteresis: unlocked above twice the threshold */
+		if (Discipline_Abs(offsetNs) <= Discipline_Config.lockThresholdNs)
+		{
+			if (Discipline_Below < DISCIPLINE_LOCK_COUNT)
+			{
+				Discipline_Below++;
+			}
+			if (Discipline_Below >= DISCIPLINE_LOCK_COUNT)
+			{
+				Discipline_State = DISCIPLINE_LOCKED;
+			}
+		}
+		else if (Discipline_Abs(offsetNs) > (2u * (uint64)Discipline_Config.lockThresholdNs))
+		{
+			Discipline_Below = 0u;
+			Discipline_State = DISCIPLINE_TRACKING;
+		}
+		else
+		{
+			Discipline_Below = 0u;
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the discipline loop.
+ *
+ * The frequency estimate starts from Calib_GetPpb(), e.g. a value restored from flash.
+ *
+ * @param[in] ConfigPtr Pointer to the configuration structure.
+ * @return DISCIPLINE_OK on success, DISCIPLINE_ERR_PARA on parameter error.
+ */
+Discipline_ret_t Discipline_Init(const Discipline_ConfigType * ConfigPtr)
+{
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->timeConstantS == 0u) ||
+		    (ConfigPtr->timeConstantS > DISCIPLINE_TC_MAX) || (ConfigPtr->outlierFactor == 0u) ||
+		    (ConfigPtr->lockThresholdNs == 0u) || (ConfigPtr->stepThresholdNs <= ConfigPtr->lockThresholdNs) ||
+		    (ConfigPtr->holdoverS == 0u))
+		{
+			return DISCIPLINE_ERR_PARA;
+		}
+
+		Discipline_Config = *ConfigPtr;
+		Discipline_State = DISCIPLINE_UNSET;
+		Discipline_HistoryCount = 0u;
+		Discipline_HistoryIdx = 0u;
+		Discipline_Rejects = 0u;
+		Discipline_Jitter = 0u;
+		Discipline_FreqQ16 = DISCIPLINE_Q16(Calib_GetPpb());
+		Discipline_LastOffset = 0;
+		Discipline_LastLocal = 0u;
+		Discipline_Above = 0u;
+		Discipline_Below = 0u;
+		Discipline_Samples = 0u;
+		Discipline_Rejected = 0u;
+		Discipline_Steps = 0u;
+
+		return DISCIPLINE_OK;
+}
+
+/*!
+ * @brief Feeds one offset sample.
+ *
+ * 1. The first sample sets the time: stepped above the step threshold, otherwise slewed.
+ * 2. A sample farther from the median of the recent ones than outlierFactor times the jitter is
+ *    a spike, unless DISCIPLINE_REJECT_MAX spikes came in a row.
+ * 3. DISCIPLINE_STEP_COUNT samples in a row above the step threshold step the clock; single
+ *    ones are not fed to the loop.
+ * 4. After a step the frequency is measured over one time constant, then the loop runs.
+ *
+ * @param[in] localNs Software clock when the reference was taken, in nanoseconds.
+ * @param[in] offsetNs Reference time minus software clock at that moment.
+ * @return DISCIPLINE_OK, DISCIPLINE_REJECTED or DISCIPLINE_STEPPED, DISCIPLINE_ERR_PARA on error.
+ */
+Discipline_ret_t Discipline_AddSample(uint64 localNs, int64 offsetNs)
+{
+		uint64 deviation;
+		uint64 limit;
+		int64 intervalNs;
+		int64 drift;
+
+		if (Discipline_Config.timeConstantS == 0u)
+		{
+			return DISCIPLINE_ERR_PARA;
+		}
+
+		/* 1. First sample */
+		if (Discipline_State == DISCIPLINE_UNSET)
+		{
+			Discipline_Samples++;
+			if (Discipline_Abs(offsetNs) > Discipline_Config.stepThresholdNs)
+			{
+				Discipline_Step(localNs, offsetNs);
+				return DISCIPLINE_STEPPED;
+			}
+			Discipline_Remember(offsetNs);
+			Discipline_LastLocal = localNs;
+			Discipline_LastOffset = offsetNs;
+			Discipline_FreqStart = localNs;
+			Discipline_FreqOffset = offsetNs;
+			Discipline_State = DISCIPLINE_FREQ;
+			return DISCIPLINE_OK;
+		}
+
+		/* 2. Spike filter */
+		if (Discipline_HistoryCount != 0u)
+		{
+			deviation = Discipline_Abs(offsetNs - Discipline_Median());
+			limit = (uint64)Discipline_Config.outlierFactor *
+			        ((Discipline_Jitter > DISCIPLINE_JITTER_MIN_NS) ? Discipline_Jitter : DISCIPLINE_JITTER_MIN_NS);
+			/* The jitter is learned from the first samples, before any is rejected */
+			if ((deviation > limit) && (Discipline_HistoryCount >= DISCIPLINE_HISTORY))
+			{
+				if (Discipline_Rejects < DISCIPLINE_REJECT_MAX)
+				{
+					Discipline_Rejects++;
+					Discipline_Rejected++;
+					return DISCIPLINE_REJECTED;
+				}
+				/* The reference moved: start the history again from here */
+				Discipline_HistoryCount = 0u;
+				Discipline_HistoryIdx = 0u;
+			}
+			Discipline_Jitter = (unsigned int)((int64)Discipline_Jitter +
+			                    (((int64)deviation - (int64)Discipline_Jitter) >> DISCIPLINE_JITTER_SHIFT));
+		}
+		Discipline_Rejects = 0u;
+		Discipline_Remember(offsetNs);
+		Discipline_Samples++;
+
+		/* 3. Large offsets are stepped once they persist */
+		if (Discipline_Abs(offsetNs) > Discipline_Config.stepThresholdNs)
+		{
+			Discipline_Above++;
+			if (Discipline_Above >= DISCIPLINE_STEP_COUNT)
+			{
+				Discipline_Step(localNs, offsetNs);
+				return DISCIPLINE_STEPPED;
+			}
+			return DISCIPLINE_OK;
+		}
+		Discipline_Above = 0u;
+
+		/* 4. Frequency from the offset drift over one time constant */
+		if (Discipline_State == DISCIPLINE_FREQ)
+		{
+			intervalNs = (int64)(localNs - Discipline_FreqStart);
+			if (intervalNs < ((int64)Discipline_Config.timeConstantS * (int64)CALIB_NS_PER_SECOND))
+			{
+				Discipline_LastLocal = localNs;
+				Discipline_LastOffset = offsetNs;
+				return DISCIPLINE_OK;
+			}
+			drift = ((offsetNs - Discipline_FreqOffset) * (int64)CALIB_PPB_PER_UNIT) / intervalNs;
+			Discipline_FreqQ16 -= DISCIPLINE_Q16(drift);
+			Discipline_State = DISCIPLINE_TRACKING;
+		}
+		else if (Discipline_State == DISCIPLINE_HOLDOVER)
+		{
+			Discipline_State = DISCIPLINE_TRACKING;
+		}
+		else
+		{
+			/* Tracking or locked */
+		}
+
+		Discipline_Update(localNs, offsetNs);
+		Discipline_LastLocal = localNs;
+		Discipline_LastOffset = offsetNs;
+
+		return DISCIPLINE_OK;
+}
+
+/*!
+ * @brief Enters holdover when the reference was lost.
+ *
+ * The phase correction is dropped and the clock runs on the frequency estimate. Call
+ * periodically, e.g. once a second.
+ *
+ * @return void.
+ */
+void Discipline_Process(void)
+{
+		uint64 now;
+
+		if ((Discipline_State != DISCIPLINE_TRACKING) && (Discipline_State != DISCIPLINE_LOCKED))
+		{
+			return;
+		}
+
+		now = Discipline_Now();
+		if ((now > Discipline_LastLocal) &&
+		    ((now - Discipline_LastLocal) > ((uint64)Discipline_Config.holdoverS * CALIB_NS_PER_SECOND)))
+		{
+			(void)Calib_SetPpb(Discipline_Clamp(Discipline_FreqQ16 >> DISCIPLINE_FREQ_SHIFT));
+			Discipline_Below = 0u;
+			Discipline_State = DISCIPLINE_HOLDOVER;
+		}
+}
+
+/*!
+ * @brief Retrieves the loop status.
+ *
+ * The error estimate is the last offset plus the jitter plus DISCIPLINE_WANDER_PPB over the time
+ * since the last sample.
+ *
+ * @param[out] StatusPtr Pointer to the status structure.
+ * @return DISCIPLINE_OK on success, DISCIPLINE_ERR_PARA on parameter error.
+ */
+Discipline_ret_t Discipline_GetStatus(Discipline_StatusType * StatusPtr)
+{
+		uint64 error;
+		uint64 age;
+
+		if (StatusPtr == NULL)
+		{
+			return DISCIPLINE_ERR_PARA;
+		}
+
+		StatusPtr->state = Discipline_State;
+		StatusPtr->offsetNs = Discipline_Saturate(Discipline_LastOffset);
+		StatusPtr->jitterNs = Discipline_Jitter;
+		StatusPtr->freqPpb = Discipline_Clamp(Discipline_FreqQ16 >> DISCIPLINE_FREQ_SHIFT);
+		StatusPtr->samples = Discipline_Samples;
+		StatusPtr->rejected = Discipline_Rejected;
+		StatusPtr->steps = Discipline_Steps;
+
+		if (Discipline_State == DISCIPLINE_UNSET)
+		{
+			StatusPtr->errorNs = DISCIPLINE_ERROR_UNKNOWN;
+		}
+		else
+		{
+			age = Discipline_Now();
+			age = (age > Discipline_LastLocal) ? (age - Discipline_LastLocal) : 0u;
+			error = Discipline_Abs(Discipline_LastOffset) + Discipline_Jitter +
+			        ((age / CALIB_NS_PER_SECOND) * DISCIPLINE_WANDER_PPB);
+			StatusPtr->errorNs = (error < DISCIPLINE_ERROR_UNKNOWN) ? (unsigned int)error : DISCIPLINE_ERROR_UNKNOWN;
+		}
+
+		return DISCIPLINE_OK;
+}
@@ -0,0 +1,782 @@
+/****************************************************************************************************
+* @file    Kv.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the settings store.
+* @details A sector starts with a header phrase {KV_SECTOR_MAGIC, sequence}; the sector with the
+*          highest sequence is the head, where records are appended. A record is a header phrase
+*          {key, length, ~key, ~length, CRC-16 of the value, KV_RECORD_MARK, 0} followed by the
+*          value padded to whole phrases. The complemented fields tell a torn header from a torn
+*          value: after a torn value the scan skips the record, after a torn header it closes
+*          the sector. Compaction only starts when at most one sector is blank, and then only the
+*          keys of the oldest sector are written, so the live data of one sector always fits in
+*          the rest of the head and the last blank sector.
+* @version 1.0.0
+* @date    2024-11-12
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Kv.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define KV_NO_SECTOR                    (0xFFu)
+#define KV_KEY_BIT(KEY)                 (1u << (KEY))
+
+/*** Sector states ***/
+#define KV_SECTOR_FREE                  (0u)               /* Blank, ready to be opened */
+#define KV_SECTOR_USED                  (1u)               /* Valid header, part of the log */
+#define KV_SECTOR_GARBAGE               (2u)               /* To be erased */
+
+/*** Background jobs ***/
+#define KV_JOB_NONE                     (0u)
+#define KV_JOB_RECORD                   (1u)               /* Appending a record to the head */
+#define KV_JOB_OPEN                     (2u)               /* Writing the header of a new head */
+#define KV_JOB_ERASE                    (3u)               /* Erasing a sector */
+
+/*** Record header bytes ***/
+#define KV_HDR_KEY                      (0u)
+#define KV_HDR_LENGTH                   (1u)
+#define KV_HDR_KEY_INV                  (2u)
+#define KV_HDR_LENGTH_INV               (3u)
+#define KV_HDR_CRC                      (4u)
+#define KV_HDR_MARK                     (6u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+STATIC_ASSERT(KV_KEY_COUNT <= 32u, kv_key_count);
+STATIC_ASSERT(KV_VALUE_MAX <= 255u, kv_value_max);
+STATIC_ASSERT((KV_KEY_COUNT * KV_RECORD_BYTES(KV_VALUE_MAX)) <= (KV_SECTOR_SIZE - FTFC_PHRASE_SIZE), kv_live_data_fits_sector);
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Kv_ConfigType * Kv_Config;                 /* Active configuration */
+static Kv_StatsType Kv_Stats;
+
+/* RAM image */
+static unsigned char Kv_Values[KV_KEY_COUNT][KV_VALUE_MAX];
+static unsigned char Kv_Lengths[KV_KEY_COUNT];
+static unsigned char Kv_Location[KV_KEY_COUNT];         /* Sector of the latest record, KV_NO_SECTOR */
+static unsigned int Kv_Present;                         /* Bit n: key n has a value */
+static unsigned int Kv_Dirty;                           /* Bit n: value of key n not in the flash yet */
+
+/* Sectors */
+static unsigned char Kv_SectorState[KV_SECTOR_MAX];
+static unsigned int Kv_SectorSeq[KV_SECTOR_MAX];
+static unsigned char Kv_Head;                           /* Sector appended to, KV_NO_SECTOR when none */
+static unsigned short Kv_HeadOffset;                    /* Next free byte of the head */
+static unsigned int Kv_Seq;                             /* Sequence of the head */
+
+/* Job in progress */
+static unsigned char Kv_Job;
+static unsigned char Kv_JobSector;
+static unsigned char Kv_JobKey;
+static unsigned char Kv_JobRelocation;                  /* Record rewritten by the compaction */
+static unsigned short Kv_JobOffset;                     /* Start of the record in the sector */
+static unsigned short Kv_JobPos;                        /* Bytes already programmed */
+static unsigned short Kv_JobLength;                     /* Bytes to program */
+static unsigned char Kv_Staging[KV_RECORD_BYTES(KV_VALUE_MAX)];
+
+/* Completion, written by Kv_OnFlashDone() in the FTFC interrupt */
+static volatile unsigned char Kv_Waiting;               /* Command launched */
+static volatile unsigned char Kv_Done;                  /* Command finished */
+static volatile Ftfc_ret_t Kv_Result;
+static unsigned char Kv_Polled;                         /* Kv_Flush() running: commands are waited for */
+static unsigned short Kv_PolledPhrases;                 /* Commands waited for by Kv_Flush() */
+
+
+/*==================================================================================================
+*                                    FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Kv_Complete(Ftfc_ret_t result);
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Reads a little-endian word of the flash.
+ */
+static unsigned int Kv_ReadWord(const unsigned char * DataPtr)
+{
+		return (unsigned int)DataPtr[0] | ((unsigned int)DataPtr[1] << 8u) |
+		       ((unsigned int)DataPtr[2] << 16u) | ((unsigned int)DataPtr[3] << 24u);
+}
+
+/*!
+ * @brief Writes a little-endian word.
+ */
+static void Kv_PutWord(unsigned char * DataPtr, unsigned int value)
+{
+		DataPtr[0] = (unsigned char)value;
+		DataPtr[1] = (unsigned char)(value >> 8u);
+		DataPtr[2] = (unsigned char)(value >> 16u);
+		DataPtr[3] = (unsigned char)(value >> 24u);
+}
+
+/*!
+ * @brief Tells whether a flash area reads as erased.
+ */
+static unsigned char Kv_IsErased(const unsigned char * DataPtr, unsigned int length)
+{
+		unsigned int index;
+
+		for (index = 0u; index < length; index++)
+		{
+			if (DataPtr[index] != 0xFFu)
+			{
+				return 0u;
+			}
+		}
+		return 1u;
+}
+
+/*!
+ * @brief Scans the records of a sector into the RAM image.
+ *
+ * @return Offset after the last record, KV_SECTOR_SIZE when a torn header closed the sector.
+ */
+static unsigned short Kv_ScanSector(unsigned char sector)
+{
+		const unsigned char * base = &Kv_Config->readPtr[(unsigned int)sector * KV_SECTOR_SIZE];
+		const unsigned char * header;
+		unsigned int offset = FTFC_PHRASE_SIZE;
+		unsigned char key;
+		unsigned char length;
+		unsigned char index;
+
+		while ((offset + FTFC_PHRASE_SIZE) <= KV_SECTOR_SIZE)
+		{
+			header = &base[offset];
+			if (Kv_IsErased(header, FTFC_PHRASE_SIZE) != 0u)
+			{
+				break;
+			}
+
+			key = header[KV_HDR_KEY];
+			length = header[KV_HDR_LENGTH];
+			if ((header[KV_HDR_KEY_INV] != (unsigned char)~key) || (header[KV_HDR_LENGTH_INV] != (unsigned char)~length) ||
+			    (header[KV_HDR_MARK] != KV_RECORD_MARK) || (key >= KV_KEY_COUNT) || (length > KV_VALUE_MAX) ||
+			    ((offset + KV_RECORD_BYTES(length)) > KV_SECTOR_SIZE))
+			{
+				/* Torn header: the length is unknown, nothing after it can be used */
+				Kv_Stats.damaged++;
+				offset = KV_SECTOR_SIZE;
+				break;
+			}
+
+			if (Crc16_Compute(&header[FTFC_PHRASE_SIZE], length) ==
+			    (unsigned short)(header[KV_HDR_CRC] | ((unsigned int)header[KV_HDR_CRC + 1u] << 8u)))
+			{
+				for (index = 0u; index < length; index++)
+				{
+					Kv_Values[key][index] = header[FTFC_PHRASE_SIZE + index];
+				}
+				Kv_Lengths[key] = length;
+				Kv_Location[key] = sector;
+				Kv_Present |= KV_KEY_BIT(key);
+			}
+			else
+			{
+				/* Torn value: the older record of the key stays valid */
+				Kv_Stats.damaged++;
+			}
+			offset += KV_RECORD_BYTES(length);
+		}
+
+		return (unsigned short)offset;
+}
+
+/*!
+ * @brief Finds the sector in use with the lowest sequence.
+ */
+static unsigned char Kv_Tail(void)
+{
+		unsigned char tail = KV_NO_SECTOR;
+		unsigned char sector;
+
+		for (sector = 0u; sector < Kv_Config->sectorCount; sector++)
+		{
+			if ((Kv_SectorState[sector] == KV_SECTOR_USED) &&
+			    ((tail == KV_NO_SECTOR) || ((int)(Kv_SectorSeq[sector] - Kv_SectorSeq[tail]) < 0)))
+			{
+				tail = sector;
+			}
+		}
+		return tail;
+}
+
+/*!
+ * @brief Counts the sectors in a state.
+ */
+static unsigned char Kv_Count(unsigned char state)
+{
+		unsigned char count = 0u;
+		unsigned char sector;
+
+		for (sector = 0u; sector < Kv_Config->sectorCount; sector++)
+		{
+			if (Kv_SectorState[sector] == state)
+			{
+				count++;
+			}
+		}
+		return count;
+}
+
+/*!
+ * @brief Finds a sector in a state, searching the ring from the one after the head.
+ */
+static unsigned char Kv_Find(unsigned char state)
+{
+		unsigned char start = (Kv_Head == KV_NO_SECTOR) ? 0u : (unsigned char)(Kv_Head + 1u);
+		unsigned char step;
+		unsigned char sector;
+
+		for (step = 0u; step < Kv_Config->sectorCount; step++)
+		{
+			sector = (unsigned char)((start + step) % Kv_Config->sectorCount);
+			if (Kv_SectorState[sector] == state)
+			{
+				return sector;
+			}
+		}
+		return KV_NO_SECTOR;
+}
+
+/*!
+ * @brief Launches the flash command of the current job step.
+ */
+static void Kv_Launch(void)
+{
+		unsigned int address = Kv_Config->flashAddress + ((unsigned int)Kv_JobSector * KV_SECTOR_SIZE);
+		Ftfc_ret_t result;
+
+		Kv_Done = 0u;
+		Kv_Waiting = 1u;
+		if (Kv_Job == KV_JOB_ERASE)
+		{
+			result = Ftfc_EraseSector(address);
+		}
+		else
+		{
+			result = Ftfc_ProgramPhrase(address + Kv_JobOffset + Kv_JobPos, &Kv_Staging[Kv_JobPos]);
+		}
+
+		if (result == FTFC_ERR_BUSY)
+		{
+			/* Flash used by another driver: retried by the next Kv_Process() */
+			Kv_Waiting = 0u;
+		}
+		else if (result != FTFC_OK)
+		{
+			Kv_Waiting = 0u;
+			Kv_Complete(result);
+		}
+		else if (Kv_Polled != 0u)
+		{
+			Kv_Waiting = 0u;
+			Kv_PolledPhrases++;
+			Kv_Complete(Ftfc_Wait());
+		}
+		else
+		{
+			/* Kv_OnFlashDone() reports the end */
+		}
+}
+
+/*!
+ * @brief Accounts for a finished flash command and ends the job after its last step.
+ */
+static void Kv_Complete(Ftfc_ret_t result)
+{
+		if (result != FTFC_OK)
+		{
+			if (result != FTFC_ERR_SUSPENDED)
+			{
+				Kv_Stats.flashErrors++;
+			}
+			if (Kv_Job == KV_JOB_RECORD)
+			{
+				/* The head cannot be trusted past the failed phrase */
+				Kv_HeadOffset = KV_SECTOR_SIZE;
+				Kv_Dirty |= KV_KEY_BIT(Kv_JobKey);
+			}
+			else if (Kv_Job == KV_JOB_OPEN)
+			{
+				Kv_SectorState[Kv_JobSector] = KV_SECTOR_GARBAGE;
+			}
+			else
+			{
+				/* Erase retried later */
+			}
+			Kv_Job = KV_JOB_NONE;
+			return;
+		}
+
+		if (Kv_Job == KV_JOB_ERASE)
+		{
+			Kv_SectorState[Kv_JobSector] = KV_SECTOR_FREE;
+			Kv_Stats.erases++;
+			Kv_Job = KV_JOB_NONE;
+			return;
+		}
+
+		Kv_JobPos += FTFC_PHRASE_SIZE;
+		if (Kv_JobPos < Kv_JobLength)
+		{
+			return;
+		}
+
+		if (Kv_Job == KV_JOB_OPEN)
+		{
+			Kv_Seq++;
+			Kv_SectorSeq[Kv_JobSector] = Kv_Seq;
+			Kv_SectorState[Kv_JobSector] = KV_SECTOR_USED;
+			Kv_Head = Kv_JobSector;
+			Kv_HeadOffset = FTFC_PHRASE_SIZE;
+		}
+		else
+		{
+			Kv_Location[Kv_JobKey] = Kv_JobSector;
+			Kv_Stats.records++;
+			if (Kv_JobRelocation != 0u)
+			{
+				Kv_Stats.relocations++;
+			}
+		}
+		Kv_Job = KV_JOB_NONE;
+}
+
+/*!
+ * @brief Starts erasing a sector.
+ */
+static void Kv_StartErase(unsigned char sector)
+{
+		Kv_Job = KV_JOB_ERASE;
+		Kv_JobSector = sector;
+		Kv_Launch();
+}
+
+/*!
+ * @brief Chooses the next job: erase, compaction, new head or record.
+ */
+static void Kv_Schedule(void)
+{
+		unsigned char freeCount = Kv_Count(KV_SECTOR_FREE);
+		unsigned char garbage = Kv_Find(KV_SECTOR_GARBAGE);
+		unsigned char tail;
+		unsigned char next;
+		unsigned char key;
+		unsigned char length;
+		unsigned char index;
+		unsigned int eligible = Kv_Dirty;
+		unsigned int live = 0u;
+		unsigned short crc;
+
+		/* Kv_Flush() has no time for an erase, nor for a compaction that needs one */
+		if (Kv_Polled != 0u)
+		{
+			garbage = KV_NO_SECTOR;
+		}
+
+		/* 1. Erase when short of blank sectors or when nothing else is to be done */
+		if ((garbage != KV_NO_SECTOR) && ((freeCount <= 1u) || (Kv_Dirty == 0u)))
+		{
+			Kv_StartErase(garbage);
+			return;
+		}
+
+		/* 2. Compaction: rewrite the keys of the oldest sector, then erase it */
+		if ((freeCount <= 1u) && (Kv_Count(KV_SECTOR_USED) >= 2u) && (Kv_Polled == 0u))
+		{
+			tail = Kv_Tail();
+			for (key = 0u; key < KV_KEY_COUNT; key++)
+			{
+				if (Kv_Location[key] == tail)
+				{
+					live |= KV_KEY_BIT(key);
+				}
+			}
+			if (live == 0u)
+			{
+				Kv_SectorState[tail] = KV_SECTOR_GARBAGE;
+				Kv_StartErase(tail);
+				return;
+			}
+			eligible = live;
+		}
+		if (eligible == 0u)
+		{
+			return;
+		}
+
+		/* 3. Open a new head when the record does not fit */
+		key = (unsigned char)__builtin_ctz(eligible);
+		length = Kv_Lengths[key];
+		if ((Kv_Head == KV_NO_SECTOR) || ((Kv_HeadOffset + KV_RECORD_BYTES(length)) > KV_SECTOR_SIZE))
+		{
+			next = Kv_Find(KV_SECTOR_FREE);
+			if ((next == KV_NO_SECTOR) || ((Kv_Polled != 0u) && (freeCount <= 1u)))
+			{
+				/* Kv_Flush() leaves the last blank sector to the compaction */
+				if (garbage != KV_NO_SECTOR)
+				{
+					Kv_StartErase(garbage);
+				}
+				return;
+			}
+			Kv_PutWord(&Kv_Staging[0], KV_SECTOR_MAGIC);
+			Kv_PutWord(&Kv_Staging[4], Kv_Seq + 1u);
+			Kv_Job = KV_JOB_OPEN;
+			Kv_JobSector = next;
+			Kv_JobOffset = 0u;
+			Kv_JobPos = 0u;
+			Kv_JobLength = FTFC_PHRASE_SIZE;
+			Kv_Launch();
+			return;
+		}
+
+		/* 4. Append the record, from a snapshot of the value */
+		crc = Crc16_Compute(Kv_Values[key], length);
+		Kv_Staging[KV_HDR_KEY] = key;
+		Kv_Staging[KV_HDR_LENGTH] = length;
+		Kv_Staging[KV_HDR_KEY_INV] = (unsigned char)~key;
+		Kv_Staging[KV_HDR_LENGTH_INV] = (unsigned char)~length;
+		Kv_Staging[KV_HDR_CRC] = (unsigned char)crc;
+		Kv_Staging[KV_HDR_CRC + 1u] = (unsigned char)(crc >> 8u);
+		Kv_Staging[KV_HDR_MARK] = KV_RECORD_MARK;
+		Kv_Staging[KV_HDR_MARK + 1u] = 0u;
+		for (index = 0u; index < (KV_RECORD_BYTES(length) - FTFC_PHRASE_SIZE); index++)
+		{
+			Kv_Staging[FTFC_PHRASE_SIZE + index] = (index < length) ? Kv_Values[key][index] : 0xFFu;
+		}
+
+		Kv_Job = KV_JOB_RECORD;
+		Kv_JobKey = key;
+		Kv_JobRelocation = ((Kv_Dirty & KV_KEY_BIT(key)) == 0u) ? 1u : 0u;
+		Kv_JobSector = Kv_Head;
+		Kv_JobOffset = Kv_HeadOffset;
+		Kv_JobPos = 0u;
+		Kv_JobLength = (unsigned short)KV_RECORD_BYTES(length);
+		Kv_HeadOffset += Kv_JobLength;
+		Kv_Dirty &= ~KV_KEY_BIT(key);
+		Kv_Launch();
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Mounts the store.
+ *
+ * This function reads the sector headers, then scans the records of the sectors in use from the
+ * oldest to the newest, so the last valid record of a key wins. Torn records left by a power
+ * loss are skipped; sectors that are neither in use nor blank are erased later by Kv_Process().
+ *
+ * @param[in] ConfigPtr Pointer to the store configuration structure.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ * @note The flash must be idle.
+ */
+Kv_ret_t Kv_Init(const Kv_ConfigType * ConfigPtr)
+{
+		const unsigned char * base;
+		unsigned char sector;
+		unsigned char previous;
+		unsigned char next;
+		unsigned char key;
+		unsigned short offset = KV_SECTOR_SIZE;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->readPtr == NULL) || (ConfigPtr->sectorCount < 2u) ||
+		    (ConfigPtr->sectorCount > KV_SECTOR_MAX) || ((ConfigPtr->flashAddress % KV_SECTOR_SIZE) != 0u))
+		{
+			return KV_ERR_PARA;
+		}
+
+		Kv_Config = ConfigPtr;
+		Kv_Present = 0u;
+		Kv_Dirty = 0u;
+		Kv_Head = KV_NO_SECTOR;
+		Kv_HeadOffset = KV_SECTOR_SIZE;
+		Kv_Seq = 0u;
+		Kv_Job = KV_JOB_NONE;
+		Kv_Waiting = 0u;
+		Kv_Done = 0u;
+		Kv_Stats.records = 0u;
+		Kv_Stats.relocations = 0u;
+		Kv_Stats.erases = 0u;
+		Kv_Stats.unchanged = 0u;
+		Kv_Stats.damaged = 0u;
+		Kv_Stats.flashErrors = 0u;
+		for (key = 0u; key < KV_KEY_COUNT; key++)
+		{
+			Kv_Location[key] = KV_NO_SECTOR;
+		}
+
+		/* 1. Sector headers; a blank header over a non-blank sector is an interrupted erase */
+		for (sector = 0u; sector < ConfigPtr->sectorCount; sector++)
+		{
+			base = &ConfigPtr->readPtr[(unsigned int)sector * KV_SECTOR_SIZE];
+			if (Kv_ReadWord(base) == KV_SECTOR_MAGIC)
+			{
+				Kv_SectorState[sector] = KV_SECTOR_USED;
+				Kv_SectorSeq[sector] = Kv_ReadWord(&base[4]);
+			}
+			else if (Kv_IsErased(base, KV_SECTOR_SIZE) != 0u)
+			{
+				Kv_SectorState[sector] = KV_SECTOR_FREE;
+			}
+			else
+			{
+				Kv_SectorState[sector] = KV_SECTOR_GARBAGE;
+			}
+		}
+
+		/* 2. Records, in sequence order: each pass takes the next sector after the previous one */
+		previous = KV_NO_SECTOR;
+		for (;;)
+		{
+			next = KV_NO_SECTOR;
+			for (sector = 0u; sector < ConfigPtr->sectorCount; sector++)
+			{
+				if ((Kv_SectorState[sector] == KV_SECTOR_USED) &&
+				    ((previous == KV_NO_SECTOR) || ((int)(Kv_SectorSeq[sector] - Kv_SectorSeq[previous]) > 0)) &&
+				    ((next == KV_NO_SECTOR) || ((int)(Kv_SectorSeq[sector] - Kv_SectorSeq[next]) < 0)))
+				{
+					next = sector;
+				}
+			}
+			if (next == KV_NO_SECTOR)
+			{
+				break;
+			}
+			offset = Kv_ScanSector(next);
+			previous = next;
+		}
+		if (previous != KV_NO_SECTOR)
+		{
+			Kv_Head = previous;
+			Kv_Seq = Kv_SectorSeq[previous];
+		}
+		Kv_HeadOffset = offset;
+
+		return KV_OK;
+}
+
+/*!
+ * @brief Reads a value from RAM.
+ *
+ * @param[in] key Key.
+ * @param[out] DataPtr Value.
+ * @param[in] maxLength Size of DataPtr; a longer value is truncated.
+ * @param[out] LengthPtr Value length, may be NULL.
+ * @return KV_OK on success, KV_ERR_PARA or KV_ERR_NOT_FOUND on error.
+ */
+Kv_ret_t Kv_Read(unsigned char key, unsigned char * DataPtr, unsigned char maxLength, unsigned char * LengthPtr)
+{
+		unsigned char index;
+
+		/* Check parameter */
+		if ((key >= KV_KEY_COUNT) || ((DataPtr == NULL) && (maxLength != 0u)))
+		{
+			return KV_ERR_PARA;
+		}
+		if ((Kv_Present & KV_KEY_BIT(key)) == 0u)
+		{
+			return KV_ERR_NOT_FOUND;
+		}
+
+		for (index = 0u; (index < Kv_Lengths[key]) && (index < maxLength); index++)
+		{
+			DataPtr[index] = Kv_Values[key][index];
+		}
+		if (LengthPtr != NULL)
+		{
+			*LengthPtr = Kv_Lengths[key];
+		}
+
+		return KV_OK;
+}
+
+/*!
+ * @brief Writes a value.
+ *
+ * The value is copied to RAM and the call returns; an unchanged value is not journaled.
+ *
+ * @param[in] key Key.
+ * @param[in] DataPtr Value.
+ * @param[in] length Value length, at most KV_VALUE_MAX.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ */
+Kv_ret_t Kv_Write(unsigned char key, const unsigned char * DataPtr, unsigned char length)
+{
+		unsigned char same;
+		unsigned char index;
+
+		/* Check parameter */
+		if ((Kv_Config == NULL) || (key >= KV_KEY_COUNT) || (length > KV_VALUE_MAX) || ((DataPtr == NULL) && (length != 0u)))
+		{
+			return KV_ERR_PARA;
+		}
+
+		same = (((Kv_Present & KV_KEY_BIT(key)) != 0u) && (Kv_Lengths[key] == length)) ? 1u : 0u;
+		for (index = 0u; (index < length) && (same != 0u); index++)
+		{
+			same = (Kv_Values[key][index] == DataPtr[index]) ? 1u : 0u;
+		}
+		if (same != 0u)
+		{
+			Kv_Stats.unchanged++;
+			return KV_OK;
+		}
+
+		for (index = 0u; index < length; index++)
+		{
+			Kv_Values[key][index] = DataPtr[index];
+		}
+		Kv_Lengths[key] = length;
+		Kv_Present |= KV_KEY_BIT(key);
+		Kv_Dirty |= KV_KEY_BIT(key);
+
+		return KV_OK;
+}
+
+/*!
+ * @brief Advances the background work by at most one flash command.
+ *
+ * Call from the main loop. Never waits for the flash.
+ *
+ * @return void.
+ */
+void Kv_Process(void)
+{
+		if (Kv_Config == NULL)
+		{
+			return;
+		}
+
+		if (Kv_Waiting != 0u)
+		{
+			if (Kv_Done == 0u)
+			{
+				return;
+			}
+			Kv_Waiting = 0u;
+			Kv_Complete(Kv_Result);
+		}
+
+		if (Kv_Job != KV_JOB_NONE)
+		{
+			Kv_Launch();
+		}
+		else
+		{
+			Kv_Schedule();
+		}
+}
+
+/*!
+ * @brief Journals the dirty keys at once, for a power failure.
+ *
+ * This function stops the flash command in progress with Ftfc_Suspend(), then finishes the
+ * record in progress and appends the dirty keys in key order with polled commands, until all are
+ * written or maxPhrases phrases are spent. It never erases, and it leaves the last blank sector to
+ * the compaction, so it takes at most maxPhrases phrase program times. Kv_Process() carries on
+ * afterwards; a suspended erase is started again.
+ *
+ * @param[in] maxPhrases Phrases that may be programmed.
+ * @return Number of keys not in the flash yet.
+ * @note The caller may interrupt Kv_Write() and Kv_Process() only when these run under a lock
+ *       that masks it, e.g. SRP_LOCK(MAIN, SETTINGS) with the caller a user of SETTINGS.
+ */
+unsigned char Kv_Flush(unsigned short maxPhrases)
+{
+		Ftfc_ret_t result;
+		unsigned short before;
+
+		if (Kv_Config == NULL)
+		{
+			return 0u;
+		}
+
+		/* The completion interrupt cannot run from here: take the command over */
+		if (Kv_Waiting != 0u)
+		{
+			result = (Kv_Done != 0u) ? Kv_Result : Ftfc_Suspend();
+			Kv_Waiting = 0u;
+			Kv_Complete(result);
+		}
+
+		Kv_Polled = 1u;
+		Kv_PolledPhrases = 0u;
+		do
+		{
+			before = Kv_PolledPhrases;
+			if (Kv_Job != KV_JOB_NONE)
+			{
+				Kv_Launch();
+			}
+			else
+			{
+				Kv_Schedule();
+			}
+		} while ((Kv_PolledPhrases != before) && (Kv_PolledPhrases < maxPhrases) &&
+		         ((Kv_Dirty != 0u) || (Kv_Job == KV_JOB_RECORD)));
+		Kv_Polled = 0u;
+
+		return (unsigned char)(__builtin_popcount(Kv_Dirty) + ((Kv_Job == KV_JOB_RECORD) ? 1 : 0));
+}
+
+/*!
+ * @brief Tells whether every written value is in the flash.
+ *
+ * @return 1 when nothing is left to journal, 0 otherwise.
+ */
+unsigned char Kv_IsIdle(void)
+{
+		return ((Kv_Dirty == 0u) && (Kv_Job != KV_JOB_RECORD)) ? 1u : 0u;
+}
+
+/*!
+ * @brief FTFC command complete callback.
+ *
+ * @param[in] result Result of the command.
+ * @return void.
+ */
+void Kv_OnFlashDone(Ftfc_ret_t result)
+{
+		/* Ignore the end of a command launched by another user of the flash */
+		if ((Kv_Waiting != 0u) && (Kv_Done == 0u))
+		{
+			Kv_Result = result;
+			Kv_Done = 1u;
+		}
+}
+
+/*!
+ * @brief Retrieves the store statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return KV_OK on success, KV_ERR_PARA on parameter error.
+ */
+Kv_ret_t Kv_GetStats(Kv_StatsType * StatsPtr)
+{
+		/* Check parameter */
+		if (StatsPtr == NULL)
+		{
+			return KV_ERR_PARA;
+		}
+
+		*StatsPtr = Kv_Stats;
+		return KV_OK;
+}
@@ -0,0 +1,299 @@
+/****************************************************************************************************
+* @file    Log.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the deferred binary log.
+* @details This file reserves ring space with an exclusive load / store pair, so writers in
+*          nested interrupts never block each other. A record becomes visible to the reader when
+*          its header word is written, after the timestamp and the arguments. The reader clears
+*          every word it consumed before it releases the space.
+* @version 1.0.0
+* @date    2024-11-06
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Log.h"
+#include "Cpu.h"
+#include "Trace.h"
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Log_ConfigType * Log_Config;               /* Active configuration */
+static unsigned int * volatile Log_Buffer;              /* Ring storage, NULL before Log_Init() */
+static unsigned int Log_Mask;                           /* Ring size in words - 1 */
+
+static volatile unsigned int Log_Head;                  /* Next word reserved by a writer */
+static volatile unsigned int Log_Tail;                  /* Next word read by Log_Process() */
+static volatile unsigned int Log_Dropped;               /* Records lost, ring full */
+static unsigned int Log_DroppedSent;                    /* Dropped count already reported */
+
+static unsigned char Log_Scratch[COBS_MAX_ENCODED(LOG_FRAME_MAX)];   /* Used when the transmit ring wraps */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Reserves, fills and commits one record.
+ */
+static inline void Log_Put(unsigned int header, const unsigned int * ArgsPtr, unsigned int count)
+{
+		unsigned int * buffer = Log_Buffer;
+		unsigned int words = 2u + count;
+		unsigned int head;
+		unsigned int index;
+
+		if (buffer == NULL)
+		{
+			return;
+		}
+
+		/* 1. Reserve: retried when an interrupt logged in between */
+		do
+		{
+			head = Cpu_LoadExclusive(&Log_Head);
+			if (((head - Log_Tail) + words) > (Log_Mask + 1u))
+			{
+				Cpu_ClearExclusive();
+				do
+				{
+					index = Cpu_LoadExclusive(&Log_Dropped);
+				} while (Cpu_StoreExclusive(index + 1u, &Log_Dropped) != 0u);
+				return;
+			}
+		} while (Cpu_StoreExclusive(head + words, &Log_Head) != 0u);
+
+		/* 2. Fill, then commit with the header */
+		buffer[(head + 1u) & Log_Mask] = DWT_GET_CYCLES();
+		for (index = 0u; index < count; index++)
+		{
+			buffer[(head + 2u + index) & Log_Mask] = ArgsPtr[index];
+		}
+		CPU_COMPILER_BARRIER();
+		buffer[head & Log_Mask] = header;
+}
+
+/*!
+ * @brief Sends one record as a COBS frame.
+ *
+ * @return 1 when sent, 0 when the transmit ring has no room.
+ */
+static unsigned char Log_Send(const unsigned int * WordsPtr, unsigned int words)
+{
+		unsigned char frame[LOG_FRAME_MAX];
+		unsigned char * dest;
+		unsigned short length = 1u;
+		unsigned int index;
+
+		if (Lpuart_GetTxFree(Log_Config->uart) < COBS_MAX_ENCODED(LOG_FRAME_MAX))
+		{
+			return 0u;
+		}
+
+		frame[0] = LOG_FRAME_TAG;
+		for (index = 0u; index < words; index++)
+		{
+			frame[length++] = (unsigned char)WordsPtr[index];
+			frame[length++] = (unsigned char)(WordsPtr[index] >> 8u);
+			frame[length++] = (unsigned char)(WordsPtr[index] >> 16u);
+			frame[length++] = (unsigned char)(WordsPtr[index] >> 24u);
+		}
+
+		if (Lpuart_WriteBegin(Log_Config->uart, &dest) >= COBS_MAX_ENCODED(LOG_FRAME_MAX))
+		{
+			Lpuart_WriteCommit(Log_Config->uart, Cobs_Encode(frame, length, dest));
+		}
+		else
+		{
+			(void)Lpuart_Write(Log_Config->uart, Log_Scratch, Cobs_Encode(frame, length, Log_Scratch));
+		}
+
+		return 1u;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the log.
+ *
+ * Log calls made before are dropped silently.
+ *
+ * @param[in] ConfigPtr Pointer to the log configuration structure.
+ * @return LOG_OK on success, LOG_ERR_PARA on parameter error.
+ */
+Log_ret_t Log_Init(const Log_ConfigType * ConfigPtr)
+{
+		unsigned int index;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->buffer == NULL) || (ConfigPtr->uart >= LPUART_INSTANCE_COUNT) ||
+		    (ConfigPtr->bufferWords < LOG_RECORD_MAX_WORDS) ||
+		    ((ConfigPtr->bufferWords & (ConfigPtr->bufferWords - 1u)) != 0u))
+		{
+			return LOG_ERR_PARA;
+		}
+
+		/* Header words must read as not committed */
+		for (index = 0u; index < ConfigPtr->bufferWords; index++)
+		{
+			ConfigPtr->buffer[index] = 0u;
+		}
+
+		Log_Config = ConfigPtr;
+		Log_Mask = ConfigPtr->bufferWords - 1u;
+		Log_Head = 0u;
+		Log_Tail = 0u;
+		Log_Dropped = 0u;
+		Log_DroppedSent = 0u;
+		CPU_COMPILER_BARRIER();
+		Log_Buffer = ConfigPtr->buffer;
+
+		return LOG_OK;
+}
+
+/*!
+ * @brief Sends the committed records over the LPUART.
+ *
+ * Call from the main loop or the lowest priority task. Stops at a record still being written
+ * by an interrupted log call, and when the transmit ring is full.
+ *
+ * @return Number of records sent.
+ */
+unsigned int Log_Process(void)
+{
+		unsigned int record[LOG_RECORD_MAX_WORDS];
+		unsigned int * buffer = Log_Buffer;
+		unsigned int tail;
+		unsigned int header;
+		unsigned int words;
+		unsigned int index;
+		unsigned int sent = 0u;
+
+		if (buffer == NULL)
+		{
+			return 0u;
+		}
+
+		/* 1. Report lost records first, so the gap shows at the right place */
+		if (Log_Dropped != Log_DroppedSent)
+		{
+			record[0] = LOG_HEADER(LOG_LEVEL_INTERNAL, LOG_ID_DROPPED, 1u);
+			record[1] = DWT_GET_CYCLES();
+			record[2] = Log_Dropped - Log_DroppedSent;
+			if (Log_Send(record, 3u) == 0u)
+			{
+				return 0u;
+			}
+			Log_DroppedSent += record[2];
+		}
+
+		/* 2. Committed records, in reservation order */
+		TRACE_CALL_BEGIN(TRACE_ID_LOG_PROCESS);
+		tail = Log_Tail;
+		while (tail != Log_Head)
+		{
+			header = buffer[tail & Log_Mask];
+			if (((header >> LOG_HEADER_VALID_SHIFT) & VALUE_CHECK_BIT) == 0u)
+			{
+				break;
+			}
+
+			words = 2u + ((header >> LOG_HEADER_NARGS_SHIFT) & 0x7u);
+			for (index = 0u; index < words; index++)
+			{
+				record[index] = buffer[(tail + index) & Log_Mask];
+			}
+			if (Log_Send(record, words) == 0u)
+			{
+				break;
+			}
+
+			/* Free the space: records have different lengths, so any word can be the header of
+			   a later record and must not keep a stale valid bit */
+			for (index = 0u; index < words; index++)
+			{
+				buffer[(tail + index) & Log_Mask] = 0u;
+			}
+			CPU_COMPILER_BARRIER();
+			tail += words;
+			Log_Tail = tail;
+			sent++;
+		}
+		TRACE_CALL_END(TRACE_ID_LOG_PROCESS, sent);
+
+		return sent;
+}
+
+/*!
+ * @brief Gets the number of records lost because the ring was full.
+ *
+ * @return Records dropped since Log_Init().
+ */
+unsigned int Log_GetDropped(void)
+{
+		return Log_Dropped;
+}
+
+/*!
+ * @brief Stores a record without arguments, used by LOG().
+ *
+ * @param[in] header Record header, see LOG_HEADER().
+ * @return void.
+ */
+void Log_Write0(unsigned int header)
+{
+		Log_Put(header, NULL, 0u);
+}
+
+/*!
+ * @brief Stores a record with one argument, used by LOG().
+ */
+void Log_Write1(unsigned int header, unsigned int arg0)
+{
+		Log_Put(header, &arg0, 1u);
+}
+
+/*!
+ * @brief Stores a record with two arguments, used by LOG().
+ */
+void Log_Write2(unsigned int header, unsigned int arg0, unsigned int arg1)
+{
+		unsigned int args[2];
+
+		args[0] = arg0;
+		args[1] = arg1;
+		Log_Put(header, args, 2u);
+}
+
+/*!
+ * @brief Stores a record with three arguments, used by LOG().
+ */
+void Log_Write3(unsigned int header, unsigned int arg0, unsigned int arg1, unsigned int arg2)
+{
+		unsigned int args[3];
+
+		args[0] = arg0;
+		args[1] = arg1;
+		args[2] = arg2;
+		Log_Put(header, args, 3u);
+}
+
+/*!
+ * @brief Stores a record with four arguments, used by LOG().
+ */
+void Log_Write4(unsigned int header, unsigned int arg0, unsigned int arg1, unsigned int arg2, unsigned int arg3)
+{
+		unsigned int args[4];
+
+		args[0] = arg0;
+		args[1] = arg1;
+		args[2] = arg2;
+		args[3] = arg3;
+		Log_Put(header, args, 4u);
+}
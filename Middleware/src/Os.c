@@ -0,0 +1,804 @@
+/****************************************************************************************************
+* @file    Os.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the preemptive kernel.
+* @details This file keeps one FIFO of ready tasks per priority and a bitmap of the non-empty
+*          ones, so the next task is found with a count-leading-zeros. The running task is the
+*          head of the highest non-empty FIFO. Sleeping tasks and timeouts share one list sorted by
+*          wake-up tick, so a tick only looks at its head. All kernel state is changed inside
+*          short critical sections; the processor specific parts are in the port (Os_Port.h).
+* @version 1.0.0
+* @date    2024-11-08
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Os.h"
+#include "Os_Port.h"
+#include "Stack.h"
+
+
+/*==================================================================================================
+*                                       GLOBAL VARIABLES
+==================================================================================================*/
+Os_TaskType * volatile Os_Current;                      /* Running task */
+Os_TaskType * volatile Os_Next;                         /* Task to switch to */
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Os_ConfigType * Os_Config;                 /* Active configuration */
+static Os_TaskType Os_IdleTask;                         /* Runs when no task is ready */
+static Os_TaskType * Os_ReadyHead[OS_PRIORITY_COUNT];   /* Ready FIFO per priority */
+static Os_TaskType * Os_ReadyTail[OS_PRIORITY_COUNT];
+static unsigned int Os_ReadyMask;                       /* Bit n set: priority n has a ready task */
+static Os_TaskType * Os_SleepList;                      /* Blocked with a timeout, earliest first */
+static volatile unsigned int Os_Ticks;                  /* Kernel time */
+static unsigned char Os_Started;                        /* Os_Start() called */
+
+static unsigned int Os_RequestStamp;                    /* Cycle counter at the last switch request */
+static unsigned char Os_RequestFromIsr;                 /* Last switch requested by an interrupt */
+static Os_StatsType Os_Stats;                           /* Statistics */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Appends a task to the FIFO of its priority.
+ */
+static void Os_ReadyAppend(Os_TaskType * TaskPtr)
+{
+		unsigned char priority = TaskPtr->priority;
+
+		TaskPtr->next = NULL;
+		if (Os_ReadyTail[priority] != NULL)
+		{
+			Os_ReadyTail[priority]->next = TaskPtr;
+		}
+		else
+		{
+			Os_ReadyHead[priority] = TaskPtr;
+		}
+		Os_ReadyTail[priority] = TaskPtr;
+		Os_ReadyMask |= (1u << priority);
+}
+
+/*!
+ * @brief Removes a task from the FIFO of its priority.
+ */
+static void Os_ReadyRemove(Os_TaskType * TaskPtr)
+{
+		unsigned char priority = TaskPtr->priority;
+		Os_TaskType ** link = &Os_ReadyHead[priority];
+		Os_TaskType * previous = NULL;
+
+		/* The running task is the head: one step in the common case */
+		while ((*link != NULL) && (*link != TaskPtr))
+		{
+			previous = *link;
+			link = &previous->next;
+		}
+		if (*link == NULL)
+		{
+			return;
+		}
+
+		*link = TaskPtr->next;
+		if (Os_ReadyTail[priority] == TaskPtr)
+		{
+			Os_ReadyTail[priority] = previous;
+		}
+		if (Os_ReadyHead[priority] == NULL)
+		{
+			Os_ReadyMask &= ~(1u << priority);
+		}
+		TaskPtr->next = NULL;
+}
+
+/*!
+ * @brief Moves the head of a priority FIFO to its tail.
+ */
+static void Os_ReadyRotate(unsigned char priority)
+{
+		Os_TaskType * head = Os_ReadyHead[priority];
+
+		if ((head != NULL) && (head->next != NULL))
+		{
+			Os_ReadyHead[priority] = head->next;
+			head->next = NULL;
+			Os_ReadyTail[priority]->next = head;
+			Os_ReadyTail[priority] = head;
+		}
+}
+
+/*!
+ * @brief Inserts a task in the timeout list, sorted by wake-up tick.
+ */
+static void Os_SleepInsert(Os_TaskType * TaskPtr)
+{
+		Os_TaskType ** link = &Os_SleepList;
+
+		/* Signed difference: correct across the tick counter wrap */
+		while ((*link != NULL) && ((int32)((*link)->wakeTick - TaskPtr->wakeTick) <= 0))
+		{
+			link = &(*link)->sleepNext;
+		}
+		TaskPtr->sleepNext = *link;
+		*link = TaskPtr;
+		TaskPtr->sleeping = 1u;
+}
+
+/*!
+ * @brief Removes a task from the timeout list.
+ */
+static void Os_SleepRemove(Os_TaskType * TaskPtr)
+{
+		Os_TaskType ** link = &Os_SleepList;
+
+		if (TaskPtr->sleeping == 0u)
+		{
+			return;
+		}
+		while ((*link != NULL) && (*link != TaskPtr))
+		{
+			link = &(*link)->sleepNext;
+		}
+		if (*link != NULL)
+		{
+			*link = TaskPtr->sleepNext;
+		}
+		TaskPtr->sleepNext = NULL;
+		TaskPtr->sleeping = 0u;
+}
+
+/*!
+ * @brief Removes a task from the wait list of its event flags group.
+ */
+static void Os_WaitRemove(Os_TaskType * TaskPtr)
+{
+		Os_TaskType ** link;
+
+		if (TaskPtr->waitEvent == NULL)
+		{
+			return;
+		}
+		link = &TaskPtr->waitEvent->waiters;
+		while ((*link != NULL) && (*link != TaskPtr))
+		{
+			link = &(*link)->waitNext;
+		}
+		if (*link != NULL)
+		{
+			*link = TaskPtr->waitNext;
+		}
+		TaskPtr->waitNext = NULL;
+		TaskPtr->waitEvent = NULL;
+}
+
+/*!
+ * @brief Makes a blocked task ready again.
+ */
+static void Os_Unblock(Os_TaskType * TaskPtr)
+{
+		Os_SleepRemove(TaskPtr);
+		Os_WaitRemove(TaskPtr);
+		TaskPtr->state = (unsigned char)OS_TASK_READY;
+		Os_ReadyAppend(TaskPtr);
+}
+
+#if (OS_STACK_CHECK != 0u)
+/*!
+ * @brief Reports a task whose stack overflowed; without a hook the system halts.
+ *
+ * Called inside a critical section.
+ */
+static void Os_StackOverflow(Os_TaskType * TaskPtr)
+{
+		if (Os_Config->overflowHook != NULL)
+		{
+			Os_Config->overflowHook(TaskPtr);
+		}
+		else
+		{
+			/* Memory next to the stack is corrupt: stop here, with interrupts masked */
+			for (;;)
+			{
+			}
+		}
+}
+#endif
+
+/*!
+ * @brief Selects the highest priority ready task and requests the switch to it.
+ *
+ * Called inside a critical section.
+ */
+static void Os_Schedule(void)
+{
+		Os_TaskType * best;
+
+		if (Os_Started == 0u)
+		{
+			return;
+		}
+
+		/* The idle task keeps the mask non-zero */
+		best = Os_ReadyHead[31u - (unsigned int)__builtin_clz(Os_ReadyMask)];
+		Os_Next = best;
+		if (best != Os_Current)
+		{
+#if (OS_STACK_CHECK != 0u)
+			/* The boot context of Os_Start() has no stack of its own */
+			if ((Os_Current != NULL) && (Os_Current->stack != NULL) && (Stack_CanaryIntact(Os_Current->stack) == 0u))
+			{
+				Os_StackOverflow(Os_Current);
+			}
+#endif
+			Os_Stats.switches++;
+			Os_RequestStamp = OS_PORT_CYCLES();
+			Os_RequestFromIsr = Os_PortInIsr();
+			Os_PortRequestSwitch();
+		}
+}
+
+/*!
+ * @brief Blocks the running task, with a timeout unless OS_WAIT_FOREVER.
+ *
+ * Called inside a critical section; the switch happens when the section ends.
+ */
+static void Os_Block(unsigned int timeout)
+{
+		Os_TaskType * task = Os_Current;
+
+		Os_ReadyRemove(task);
+		task->state = (unsigned char)OS_TASK_BLOCKED;
+		if (timeout != OS_WAIT_FOREVER)
+		{
+			task->wakeTick = Os_Ticks + timeout;
+			Os_SleepInsert(task);
+		}
+		Os_Schedule();
+}
+
+/*!
+ * @brief Updates the switch statistics in the task that was just switched in.
+ */
+static void Os_Resumed(void)
+{
+		unsigned int cycles = OS_PORT_CYCLES() - Os_RequestStamp;
+
+		if (Os_RequestFromIsr != 0u)
+		{
+			Os_Stats.latencyCycles = cycles;
+			if (cycles > Os_Stats.latencyCyclesMax)
+			{
+				Os_Stats.latencyCyclesMax = cycles;
+			}
+		}
+		else
+		{
+			Os_Stats.switchCycles = cycles;
+			if (cycles > Os_Stats.switchCyclesMax)
+			{
+				Os_Stats.switchCyclesMax = cycles;
+			}
+		}
+}
+
+/*!
+ * @brief Idle task: never blocks.
+ */
+static void Os_IdleEntry(void * arg)
+{
+		(void)arg;
+
+		for (;;)
+		{
+			if (Os_Config->idleHook != NULL)
+			{
+				Os_Config->idleHook();
+			}
+			else
+			{
+				Os_PortIdle();
+			}
+		}
+}
+
+/*!
+ * @brief Tells whether the caller is a task, the only context allowed to block.
+ */
+static unsigned char Os_InTask(void)
+{
+		return ((Os_Started != 0u) && (Os_PortInIsr() == 0u)) ? 1u : 0u;
+}
+
+/*!
+ * @brief Tests the condition of an event wait.
+ */
+static unsigned char Os_EventMet(unsigned int flags, unsigned int mask, unsigned char options)
+{
+		unsigned int match = flags & mask;
+
+		if ((options & OS_EVENT_ALL) != 0u)
+		{
+			return (match == mask) ? 1u : 0u;
+		}
+		return (match != 0u) ? 1u : 0u;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the kernel and creates the idle task.
+ *
+ * @param[in] ConfigPtr Pointer to the kernel configuration structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_Init(const Os_ConfigType * ConfigPtr)
+{
+		unsigned int index;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->idleStack == NULL) || (ConfigPtr->idleStackWords < OS_STACK_MIN_WORDS))
+		{
+			return OS_ERR_PARA;
+		}
+
+		Os_Config = ConfigPtr;
+		Os_Started = 0u;
+		Os_Ticks = 0u;
+		Os_ReadyMask = 0u;
+		Os_SleepList = NULL;
+		Os_Current = NULL;
+		Os_Next = NULL;
+		for (index = 0u; index < OS_PRIORITY_COUNT; index++)
+		{
+			Os_ReadyHead[index] = NULL;
+			Os_ReadyTail[index] = NULL;
+		}
+		Os_Stats.switches = 0u;
+		Os_Stats.switchCycles = 0u;
+		Os_Stats.switchCyclesMax = 0u;
+		Os_Stats.latencyCycles = 0u;
+		Os_Stats.latencyCyclesMax = 0u;
+
+		/* Idle task at the reserved priority */
+		Os_IdleTask.priority = (unsigned char)OS_PRIORITY_IDLE;
+		Os_IdleTask.state = (unsigned char)OS_TASK_READY;
+		Os_IdleTask.sleeping = 0u;
+		Os_IdleTask.waitEvent = NULL;
+		Os_IdleTask.stack = ConfigPtr->idleStack;
+		Os_IdleTask.stackWords = ConfigPtr->idleStackWords;
+		Stack_Paint(ConfigPtr->idleStack, ConfigPtr->idleStackWords);
+		Os_IdleTask.sp = Os_PortInitStack(ConfigPtr->idleStack, ConfigPtr->idleStackWords, Os_IdleEntry, NULL);
+		Os_ReadyAppend(&Os_IdleTask);
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Creates a task, ready to run.
+ *
+ * May be called before or after Os_Start(). The stack is painted for Stack_GetUsage(); its
+ * lowest word holds the canary tested when the task is switched out.
+ *
+ * @param[out] TaskPtr Task control block.
+ * @param[in] ConfigPtr Pointer to the task configuration structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_TaskCreate(Os_TaskType * TaskPtr, const Os_TaskConfigType * ConfigPtr)
+{
+		unsigned int state;
+
+		/* Check parameter */
+		if ((TaskPtr == NULL) || (ConfigPtr == NULL) || (ConfigPtr->entry == NULL) || (ConfigPtr->stack == NULL) ||
+		    (ConfigPtr->stackWords < OS_STACK_MIN_WORDS) || (ConfigPtr->priority == OS_PRIORITY_IDLE) ||
+		    (ConfigPtr->priority > OS_PRIORITY_MAX) || (Os_Config == NULL))
+		{
+			return OS_ERR_PARA;
+		}
+
+		TaskPtr->priority = ConfigPtr->priority;
+		TaskPtr->state = (unsigned char)OS_TASK_READY;
+		TaskPtr->sleeping = 0u;
+		TaskPtr->sleepNext = NULL;
+		TaskPtr->waitNext = NULL;
+		TaskPtr->waitEvent = NULL;
+		TaskPtr->waitResult = 0u;
+		TaskPtr->stack = ConfigPtr->stack;
+		TaskPtr->stackWords = ConfigPtr->stackWords;
+		Stack_Paint(ConfigPtr->stack, ConfigPtr->stackWords);
+		TaskPtr->sp = Os_PortInitStack(ConfigPtr->stack, ConfigPtr->stackWords, ConfigPtr->entry, ConfigPtr->arg);
+
+		state = OS_ENTER_CRITICAL();
+		Os_ReadyAppend(TaskPtr);
+		Os_Schedule();
+		OS_EXIT_CRITICAL(state);
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Starts scheduling with the highest priority task.
+ *
+ * @return Does not return on the target. The host port returns after Os_PortHostStop().
+ */
+void Os_Start(void)
+{
+		if (Os_Config == NULL)
+		{
+			return;
+		}
+
+		Os_Started = 1u;
+		Os_Next = Os_ReadyHead[31u - (unsigned int)__builtin_clz(Os_ReadyMask)];
+		Os_PortStartFirst();
+}
+
+/*!
+ * @brief Advances the kernel time by one tick.
+ *
+ * Called by the port from the SysTick interrupt. Calls the tick hook, wakes the tasks whose
+ * sleep or timeout ended and rotates the tasks of the running priority.
+ *
+ * @return void.
+ */
+void Os_Tick(void)
+{
+		unsigned int state;
+		Os_TaskType * task;
+
+		/* 0. Other users of SysTick, before the kernel work so their period does not jitter */
+		if ((Os_Config != NULL) && (Os_Config->tickHook != NULL))
+		{
+			Os_Config->tickHook();
+		}
+
+		state = OS_ENTER_CRITICAL();
+		Os_Ticks++;
+
+		/* 1. Expired sleeps and timeouts, waitResult stays 0 */
+		while ((Os_SleepList != NULL) && ((int32)(Os_Ticks - Os_SleepList->wakeTick) >= 0))
+		{
+			task = Os_SleepList;
+			Os_Unblock(task);
+		}
+
+		/* 2. Time slice among the tasks of the running priority */
+		task = Os_Current;
+		if ((Os_Started != 0u) && (task != NULL) && (task->state == (unsigned char)OS_TASK_READY) &&
+		    (Os_ReadyHead[task->priority] == task))
+		{
+			Os_ReadyRotate(task->priority);
+		}
+
+		Os_Schedule();
+		OS_EXIT_CRITICAL(state);
+}
+
+/*!
+ * @brief Gets the number of ticks since Os_Start().
+ *
+ * @return Tick count, wrapping at 2^32.
+ */
+unsigned int Os_GetTicks(void)
+{
+		return Os_Ticks;
+}
+
+/*!
+ * @brief Gets the running task.
+ *
+ * @return Task control block of the caller, NULL before Os_Start().
+ */
+Os_TaskType * Os_GetCurrent(void)
+{
+		return (Os_Started != 0u) ? Os_Current : NULL;
+}
+
+/*!
+ * @brief Gives the CPU to the next ready task of the same priority.
+ *
+ * @return void.
+ */
+void Os_Yield(void)
+{
+		unsigned int state;
+
+		if (Os_InTask() == 0u)
+		{
+			return;
+		}
+
+		state = OS_ENTER_CRITICAL();
+		Os_ReadyRotate(Os_Current->priority);
+		Os_Schedule();
+		OS_EXIT_CRITICAL(state);
+}
+
+/*!
+ * @brief Blocks the calling task for a number of ticks.
+ *
+ * @param[in] ticks Ticks to sleep, 0 yields.
+ * @return OS_OK on success, OS_ERR_ISR when not called from a task.
+ */
+Os_ret_t Os_Sleep(unsigned int ticks)
+{
+		unsigned int state;
+
+		if (Os_InTask() == 0u)
+		{
+			return OS_ERR_ISR;
+		}
+		if (ticks == 0u)
+		{
+			Os_Yield();
+			return OS_OK;
+		}
+
+		state = OS_ENTER_CRITICAL();
+		Os_Block(ticks);
+		OS_EXIT_CRITICAL(state);
+		Os_Resumed();
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Blocks the calling task until a periodic release time.
+ *
+ * The release times do not drift with the execution time of the task. A release time already
+ * in the past returns at once.
+ *
+ * @param[in,out] LastWakePtr Previous release tick, advanced by period.
+ * @param[in] period Period in ticks.
+ * @return OS_OK on success, OS_ERR_PARA or OS_ERR_ISR on error.
+ */
+Os_ret_t Os_SleepUntil(unsigned int * LastWakePtr, unsigned int period)
+{
+		unsigned int state;
+		unsigned int wake;
+		unsigned char blocked = 0u;
+
+		/* Check parameter */
+		if ((LastWakePtr == NULL) || (period == 0u) || (period == OS_WAIT_FOREVER))
+		{
+			return OS_ERR_PARA;
+		}
+		if (Os_InTask() == 0u)
+		{
+			return OS_ERR_ISR;
+		}
+
+		wake = *LastWakePtr + period;
+		*LastWakePtr = wake;
+
+		state = OS_ENTER_CRITICAL();
+		if ((int32)(wake - Os_Ticks) > 0)
+		{
+			Os_Block(wake - Os_Ticks);
+			blocked = 1u;
+		}
+		OS_EXIT_CRITICAL(state);
+		if (blocked != 0u)
+		{
+			Os_Resumed();
+		}
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Ends the calling task.
+ *
+ * A task whose entry function returns ends the same way.
+ *
+ * @return Does not return.
+ */
+void Os_TaskExit(void)
+{
+		unsigned int state;
+
+		state = OS_ENTER_CRITICAL();
+		Os_ReadyRemove(Os_Current);
+		Os_Current->state = (unsigned char)OS_TASK_ENDED;
+		Os_Schedule();
+		OS_EXIT_CRITICAL(state);
+
+		/* Not reached: the task is never scheduled again */
+		for (;;)
+		{
+		}
+}
+
+/*!
+ * @brief Initializes an event flags group with all flags cleared.
+ *
+ * @param[out] EventPtr Event flags group.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventInit(Os_EventType * EventPtr)
+{
+		if (EventPtr == NULL)
+		{
+			return OS_ERR_PARA;
+		}
+
+		EventPtr->flags = 0u;
+		EventPtr->waiters = NULL;
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Sets event flags and releases the tasks waiting for them.
+ *
+ * Callable from interrupts. The switch to a released task of higher priority happens when the
+ * last interrupt returns.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] flags Flags to set.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventSet(Os_EventType * EventPtr, unsigned int flags)
+{
+		unsigned int state;
+		unsigned int clear = 0u;
+		Os_TaskType * task;
+		Os_TaskType * next;
+
+		if (EventPtr == NULL)
+		{
+			return OS_ERR_PARA;
+		}
+
+		state = OS_ENTER_CRITICAL();
+		EventPtr->flags |= flags;
+
+		/* Every waiter sees the flags before the clearing ones take them */
+		for (task = EventPtr->waiters; task != NULL; task = next)
+		{
+			next = task->waitNext;
+			if (Os_EventMet(EventPtr->flags, task->waitMask, task->waitOptions) != 0u)
+			{
+				task->waitResult = EventPtr->flags;
+				if ((task->waitOptions & OS_EVENT_CLEAR) != 0u)
+				{
+					clear |= task->waitMask;
+				}
+				Os_Unblock(task);
+			}
+		}
+		EventPtr->flags &= ~clear;
+
+		Os_Schedule();
+		OS_EXIT_CRITICAL(state);
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Clears event flags.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] flags Flags to clear.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_EventClear(Os_EventType * EventPtr, unsigned int flags)
+{
+		unsigned int state;
+
+		if (EventPtr == NULL)
+		{
+			return OS_ERR_PARA;
+		}
+
+		state = OS_ENTER_CRITICAL();
+		EventPtr->flags &= ~flags;
+		OS_EXIT_CRITICAL(state);
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Waits for event flags.
+ *
+ * @param[in] EventPtr Event flags group.
+ * @param[in] mask Flags waited for.
+ * @param[in] options OS_EVENT_ANY or OS_EVENT_ALL, optionally with OS_EVENT_CLEAR.
+ * @param[in] timeout Ticks to wait, OS_NO_WAIT or OS_WAIT_FOREVER.
+ * @param[out] FlagsPtr Flags seen when the condition was met, may be NULL.
+ * @return OS_OK when the condition was met, OS_ERR_TIMEOUT, OS_ERR_PARA or OS_ERR_ISR otherwise.
+ */
+Os_ret_t Os_EventWait(Os_EventType * EventPtr, unsigned int mask, unsigned char options,
+                      unsigned int timeout, unsigned int * FlagsPtr)
+{
+		unsigned int state;
+		unsigned int seen;
+		Os_TaskType * task;
+
+		/* Check parameter */
+		if ((EventPtr == NULL) || (mask == 0u))
+		{
+			return OS_ERR_PARA;
+		}
+		if ((timeout != OS_NO_WAIT) && (Os_InTask() == 0u))
+		{
+			return OS_ERR_ISR;
+		}
+
+		state = OS_ENTER_CRITICAL();
+
+		/* 1. Already met */
+		seen = EventPtr->flags;
+		if (Os_EventMet(seen, mask, options) != 0u)
+		{
+			if ((options & OS_EVENT_CLEAR) != 0u)
+			{
+				EventPtr->flags &= ~mask;
+			}
+			OS_EXIT_CRITICAL(state);
+			if (FlagsPtr != NULL)
+			{
+				*FlagsPtr = seen;
+			}
+			return OS_OK;
+		}
+		if (timeout == OS_NO_WAIT)
+		{
+			OS_EXIT_CRITICAL(state);
+			return OS_ERR_TIMEOUT;
+		}
+
+		/* 2. Block until Os_EventSet() or the timeout releases the task */
+		task = Os_Current;
+		task->waitMask = mask;
+		task->waitOptions = options;
+		task->waitResult = 0u;
+		task->waitEvent = EventPtr;
+		task->waitNext = EventPtr->waiters;
+		EventPtr->waiters = task;
+		Os_Block(timeout);
+		OS_EXIT_CRITICAL(state);
+		Os_Resumed();
+
+		if (task->waitResult == 0u)
+		{
+			return OS_ERR_TIMEOUT;
+		}
+		if (FlagsPtr != NULL)
+		{
+			*FlagsPtr = task->waitResult;
+		}
+
+		return OS_OK;
+}
+
+/*!
+ * @brief Retrieves the kernel statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return OS_OK on success, OS_ERR_PARA on parameter error.
+ */
+Os_ret_t Os_GetStats(Os_StatsType * StatsPtr)
+{
+		unsigned int state;
+
+		if (StatsPtr == NULL)
+		{
+			return OS_ERR_PARA;
+		}
+
+		state = OS_ENTER_CRITICAL();
+		*StatsPtr = Os_Stats;
+		OS_EXIT_CRITICAL(state);
+
+		return OS_OK;
+}
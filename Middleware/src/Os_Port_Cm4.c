@@ -0,0 +1,194 @@
+/****************************************************************************************************
+* @file    Os_Port_Cm4.c
+* @author  Ma Hien Nhan
+* @brief   Cortex-M4F port of the preemptive kernel.
+* @details This file switches tasks in PendSV at the lowest exception priority, so a switch
+*          requested by nested interrupts happens once, when the last one returns. Tasks run in
+*          thread mode on PSP; the handlers keep using MSP. The hardware stacks R0-R3, R12, LR, PC
+*          and xPSR; PendSV saves R4-R11 and EXC_RETURN. S16-S31 are saved only for tasks that
+*          used the FPU (EXC_RETURN bit 4 clear), so integer-only tasks switch without any FPU
+*          cost and lazy stacking of S0-S15 stays effective.
+* @version 1.0.0
+* @date    2024-11-08
+* @note    Measured by Os_GetStats(). By instruction count a switch is about 40 cycles without
+*          the FPU registers and 75 with them, plus the 12 cycle exception entry.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Os_Port.h"
+#include "Scb_Registers.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Words of the initial frame: R4-R11, EXC_RETURN, then the hardware frame ***/
+#define OS_PORT_SOFTWARE_FRAME_WORDS    (9u)
+#define OS_PORT_HARDWARE_FRAME_WORDS    (8u)
+#define OS_PORT_CONTROL_SPSEL           (0x2u)             /* Thread mode uses PSP */
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Os_PortBootStack[OS_PORT_BOOT_STACK_WORDS] __attribute__((aligned(8)));
+static Os_TaskType Os_PortBootTask;                     /* Receives the context of Os_Start() */
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Builds the initial context of a task on its stack.
+ *
+ * @param[in] StackPtr Stack base.
+ * @param[in] stackWords Stack size in words.
+ * @param[in] entry Task function.
+ * @param[in] arg Argument passed to entry.
+ * @return Initial stack pointer, stored in the task control block.
+ */
+void * Os_PortInitStack(unsigned int * StackPtr, unsigned int stackWords, Os_EntryType entry, void * arg)
+{
+		unsigned int * top;
+		unsigned int * sp;
+		unsigned int index;
+
+		/* AAPCS: 8-byte aligned stack at the task entry */
+		top = (unsigned int *)((unsigned int)&StackPtr[stackWords] & ~0x7u);
+		sp = top - (OS_PORT_SOFTWARE_FRAME_WORDS + OS_PORT_HARDWARE_FRAME_WORDS);
+
+		for (index = 0u; index < 8u; index++)
+		{
+			sp[index] = 0u;                                             /* R4-R11 */
+		}
+		sp[8] = OS_PORT_EXC_RETURN_THREAD_PSP;
+		sp[9] = (unsigned int)arg;                                      /* R0 */
+		sp[10] = 0u;                                                    /* R1 */
+		sp[11] = 0u;                                                    /* R2 */
+		sp[12] = 0u;                                                    /* R3 */
+		sp[13] = 0u;                                                    /* R12 */
+		sp[14] = (unsigned int)Os_TaskExit;                             /* LR: entry returns */
+		sp[15] = (unsigned int)entry & ~0x1u;                           /* PC */
+		sp[16] = OS_PORT_INITIAL_XPSR;
+
+		return sp;
+}
+
+/*!
+ * @brief Switches to Os_Next for the first time.
+ *
+ * Thread mode moves to PSP on a small boot stack and PendSV saves that context into a task
+ * control block that is never scheduled, so the first switch is an ordinary one.
+ *
+ * @return Does not return.
+ */
+void Os_PortStartFirst(void)
+{
+		CPU_DISABLE_IRQ();
+		SCB->SHPR[SCB_SHPR_PENDSV_INDEX] = OS_PORT_PENDSV_PRIORITY;
+		SCB->SHPR[SCB_SHPR_SYSTICK_INDEX] = OS_PORT_SYSTICK_PRIORITY;
+
+		Os_Current = &Os_PortBootTask;
+		__asm volatile ("msr psp, %0" : : "r" (&Os_PortBootStack[OS_PORT_BOOT_STACK_WORDS]) : "memory");
+		__asm volatile ("msr control, %0" : : "r" (OS_PORT_CONTROL_SPSEL) : "memory");
+		CPU_ISB();
+
+		Os_PortRequestSwitch();
+		CPU_ENABLE_IRQ();
+
+		/* Not reached: PendSV switches to the first task */
+		for (;;)
+		{
+		}
+}
+
+/*!
+ * @brief Requests a switch to Os_Next.
+ *
+ * From a task the switch is done as soon as interrupts are unmasked, from an interrupt when the
+ * last nested interrupt returns.
+ *
+ * @return void.
+ */
+void Os_PortRequestSwitch(void)
+{
+		SCB->ICSR = (ENABLEMENT << SCB_ICSR_PENDSVSET_SHIFT);
+		CPU_DSB();
+		CPU_ISB();
+}
+
+/*!
+ * @brief Tells whether the caller runs in an interrupt.
+ *
+ * @return 1 in an interrupt, 0 in a task.
+ */
+unsigned char Os_PortInIsr(void)
+{
+		unsigned int ipsr;
+
+		__asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+		return (ipsr != 0u) ? 1u : 0u;
+}
+
+/*!
+ * @brief Waits for an interrupt, used by the idle task without an idle hook.
+ *
+ * @return void.
+ */
+void Os_PortIdle(void)
+{
+		CPU_WFI();
+}
+
+/*!
+ * @brief SysTick interrupt handler: kernel tick.
+ *
+ * Other services on the same tick, such as Calib_Tick() and Pt_Tick(), run from the tickHook
+ * of Os_ConfigType, called first by Os_Tick().
+ *
+ * @return void.
+ */
+void SysTick_Handler(void)
+{
+		Os_Tick();
+}
+
+/*!
+ * @brief PendSV interrupt handler: context switch from Os_Current to Os_Next.
+ *
+ * @return void.
+ */
+__attribute__((naked)) void PendSV_Handler(void)
+{
+		__asm volatile (
+			"   mrs     r0, psp                 \n"
+#if defined(__ARM_FP)
+			"   tst     lr, #0x10               \n"     /* Task used the FPU: save S16-S31 */
+			"   it      eq                      \n"
+			"   vstmdbeq r0!, {s16-s31}         \n"
+#endif
+			"   stmdb   r0!, {r4-r11, lr}       \n"
+			"   cpsid   i                       \n"
+			"   ldr     r1, =Os_Current         \n"
+			"   ldr     r2, [r1]                \n"
+			"   str     r0, [r2]                \n"     /* Os_Current->sp */
+			"   ldr     r3, =Os_Next            \n"
+			"   ldr     r2, [r3]                \n"
+			"   str     r2, [r1]                \n"     /* Os_Current = Os_Next */
+			"   ldr     r0, [r2]                \n"
+			"   cpsie   i                       \n"
+			"   ldmia   r0!, {r4-r11, lr}       \n"
+#if defined(__ARM_FP)
+			"   tst     lr, #0x10               \n"
+			"   it      eq                      \n"
+			"   vldmiaeq r0!, {s16-s31}         \n"
+#endif
+			"   msr     psp, r0                 \n"
+			"   isb                             \n"
+			"   bx      lr                      \n"
+			"   .ltorg                          \n"
+		);
+}
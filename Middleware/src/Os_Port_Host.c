@@ -0,0 +1,200 @@
+/****************************************************************************************************
+* @file    Os_Port_Host.c
+* @author  Ma Hien Nhan
+* @brief   Linux host port of the preemptive kernel.
+* @details This file runs the kernel in one Linux thread with ucontext, so scheduling can be
+*          unit tested on a PC. Interrupts are simulated with Os_PortHostInterrupt(): a switch
+*          requested inside it is done when it returns, as PendSV does on the target. Build Os.c
+*          and this file with OS_PORT_HOST defined; without it this file is empty, so a firmware
+*          build that takes every source compiles only Os_Port_Cm4.c. E.g.
+*              gcc -DOS_PORT_HOST -IUtilitie -IMiddleware/inc test.c Middleware/src/Os.c
+*                  Middleware/src/Os_Port_Host.c
+* @version 1.0.0
+* @date    2024-11-08
+* @note    The ucontext of a task is kept at the base of its stack; host stacks need about
+*          16 KiB per task and 16-byte alignment.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#if defined(OS_PORT_HOST)
+#include "Os_Port.h"
+#include <time.h>
+#include <ucontext.h>
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Host context, stored at the base of the task stack.
+ */
+typedef struct
+{
+			ucontext_t              context;        /*!< Saved registers and stack */
+			Os_EntryType            entry;          /*!< Task function */
+			void *                  arg;            /*!< Argument passed to entry */
+} Os_PortHostContextType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static ucontext_t Os_PortHostMain;                      /* Caller of Os_Start() */
+static unsigned int Os_PortHostIsrNesting;              /* Simulated interrupt depth */
+static unsigned char Os_PortHostPending;                /* Switch requested inside an interrupt */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief First function of every task: runs the entry, then ends the task.
+ */
+static void Os_PortHostTrampoline(void)
+{
+		Os_PortHostContextType * context = (Os_PortHostContextType *)Os_Current->sp;
+
+		context->entry(context->arg);
+		Os_TaskExit();
+}
+
+/*!
+ * @brief Switches from Os_Current to Os_Next.
+ */
+static void Os_PortHostSwitch(void)
+{
+		Os_TaskType * previous = Os_Current;
+		Os_TaskType * next = Os_Next;
+
+		if (previous == next)
+		{
+			return;
+		}
+		Os_Current = next;
+		(void)swapcontext(&((Os_PortHostContextType *)previous->sp)->context,
+		                  &((Os_PortHostContextType *)next->sp)->context);
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Builds the initial context of a task on its stack.
+ *
+ * @param[in] StackPtr Stack base.
+ * @param[in] stackWords Stack size in words.
+ * @param[in] entry Task function.
+ * @param[in] arg Argument passed to entry.
+ * @return Initial stack pointer, stored in the task control block.
+ */
+void * Os_PortInitStack(unsigned int * StackPtr, unsigned int stackWords, Os_EntryType entry, void * arg)
+{
+		Os_PortHostContextType * context = (Os_PortHostContextType *)StackPtr;
+		unsigned char * stack = (unsigned char *)(context + 1);
+
+		(void)getcontext(&context->context);
+		context->context.uc_stack.ss_sp = stack;
+		context->context.uc_stack.ss_size = ((unsigned char *)&StackPtr[stackWords]) - stack;
+		context->context.uc_link = NULL;
+		context->entry = entry;
+		context->arg = arg;
+		makecontext(&context->context, Os_PortHostTrampoline, 0);
+
+		return context;
+}
+
+/*!
+ * @brief Switches to Os_Next for the first time.
+ *
+ * @return After Os_PortHostStop().
+ */
+void Os_PortStartFirst(void)
+{
+		Os_Current = Os_Next;
+		Os_PortHostIsrNesting = 0u;
+		Os_PortHostPending = 0u;
+		(void)swapcontext(&Os_PortHostMain, &((Os_PortHostContextType *)Os_Current->sp)->context);
+}
+
+/*!
+ * @brief Requests a switch to Os_Next.
+ *
+ * @return void.
+ */
+void Os_PortRequestSwitch(void)
+{
+		if (Os_PortHostIsrNesting != 0u)
+		{
+			Os_PortHostPending = 1u;
+			return;
+		}
+		Os_PortHostSwitch();
+}
+
+/*!
+ * @brief Tells whether the caller runs in a simulated interrupt.
+ *
+ * @return 1 in an interrupt, 0 in a task.
+ */
+unsigned char Os_PortInIsr(void)
+{
+		return (Os_PortHostIsrNesting != 0u) ? 1u : 0u;
+}
+
+/*!
+ * @brief Idle without an idle hook: nothing can wake a task on the host, leave the scheduler.
+ *
+ * @return void.
+ */
+void Os_PortIdle(void)
+{
+		Os_PortHostStop();
+}
+
+/*!
+ * @brief Runs a function as a simulated interrupt.
+ *
+ * @param[in] handler Interrupt handler, e.g. Os_Tick.
+ * @return void.
+ */
+void Os_PortHostInterrupt(void (*handler)(void))
+{
+		Os_PortHostIsrNesting++;
+		handler();
+		Os_PortHostIsrNesting--;
+
+		if ((Os_PortHostIsrNesting == 0u) && (Os_PortHostPending != 0u))
+		{
+			Os_PortHostPending = 0u;
+			Os_PortHostSwitch();
+		}
+}
+
+/*!
+ * @brief Leaves the scheduler: Os_Start() returns to its caller.
+ *
+ * @return void.
+ */
+void Os_PortHostStop(void)
+{
+		(void)swapcontext(&((Os_PortHostContextType *)Os_Current->sp)->context, &Os_PortHostMain);
+}
+
+/*!
+ * @brief Gets a monotonic time for the statistics.
+ *
+ * @return Nanoseconds, wrapping at 2^32.
+ */
+unsigned int Os_PortHostCycles(void)
+{
+		struct timespec now;
+
+		(void)clock_gettime(CLOCK_MONOTONIC, &now);
+		return (unsigned int)((unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec);
+}
+
+#endif  /* OS_PORT_HOST */
@@ -0,0 +1,628 @@
+/****************************************************************************************************
+* @file    Proto.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the serial command protocol.
+* @details This file finds frame delimiters in the LPUART receive ring, decodes COBS in place,
+*          checks the CRC and dispatches through a command table indexed by the command number.
+*          Responses are encoded straight into the transmit ring when it has contiguous space, and
+*          held back, with the requests after them, while the ring cannot take the whole frame.
+* @version 1.0.0
+* @date    2024-11-05
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Proto.h"
+#include "Trace.h"
+#include "Calib.h"
+#include "Brightness.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define PROTO_MAX_REQUEST               (PROTO_MAX_PAYLOAD + PROTO_REQUEST_OVERHEAD)
+#define PROTO_NS_PER_SECOND             (1000000000u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Proto_ConfigType * Proto_Config;                   /* Active configuration */
+static Proto_StatsType  Proto_Stats;
+
+/* Receive side */
+static unsigned char    Proto_Scratch[PROTO_MAX_ENCODED];       /* Frame wrapping the end of the ring */
+static unsigned short   Proto_ScratchLength;
+static unsigned char    Proto_Discard;                          /* Dropping an overlong frame */
+
+/* Last response, resent for a repeated request */
+static unsigned char    Proto_Response[PROTO_MAX_DECODED];
+static unsigned char    Proto_ResponseLength;
+static unsigned char    Proto_HaveLast;
+static unsigned char    Proto_LastSeq;
+static unsigned char    Proto_LastCmd;
+static unsigned char    Proto_TxScratch[PROTO_MAX_ENCODED];     /* Used when the transmit ring wraps */
+static unsigned char    Proto_TxPending;                        /* Last response not sent yet */
+
+/* Alarm identifiers of the protocol slots */
+static unsigned short   Proto_AlarmIds[PROTO_ALARM_SLOTS];
+
+/* Handlers registered by the modules that own them */
+static Proto_CommandType Proto_Registered[PROTO_CMD_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Sends the last response, encoded in place in the transmit ring when possible.
+ *
+ * @return 1 when sent, 0 when the transmit ring cannot take the whole frame yet.
+ */
+static unsigned char Proto_Send(void)
+{
+		unsigned char * dest;
+		unsigned short length;
+
+		/* Never queue part of a frame: keep it until the ring has room for all of it */
+		if (Lpuart_GetTxFree(Proto_Config->uart) < COBS_MAX_ENCODED(Proto_ResponseLength))
+		{
+			if (Proto_TxPending == 0u)
+			{
+				Proto_TxPending = 1u;
+				Proto_Stats.deferred++;
+			}
+			return 0u;
+		}
+
+		if (Lpuart_WriteBegin(Proto_Config->uart, &dest) >= COBS_MAX_ENCODED(Proto_ResponseLength))
+		{
+			length = Cobs_Encode(Proto_Response, Proto_ResponseLength, dest);
+			Lpuart_WriteCommit(Proto_Config->uart, length);
+		}
+		else
+		{
+			length = Cobs_Encode(Proto_Response, Proto_ResponseLength, Proto_TxScratch);
+			(void)Lpuart_Write(Proto_Config->uart, Proto_TxScratch, length);
+		}
+		Proto_TxPending = 0u;
+
+		return 1u;
+}
+
+/*!
+ * @brief Writes a 32-bit value, least significant byte first.
+ */
+static void Proto_PutU32(unsigned char * DestPtr, unsigned int value)
+{
+		DestPtr[0] = (unsigned char)value;
+		DestPtr[1] = (unsigned char)(value >> 8u);
+		DestPtr[2] = (unsigned char)(value >> 16u);
+		DestPtr[3] = (unsigned char)(value >> 24u);
+}
+
+/*!
+ * @brief Reads a 32-bit value, least significant byte first.
+ */
+static unsigned int Proto_GetU32(const unsigned char * SrcPtr)
+{
+		return (unsigned int)SrcPtr[0] | ((unsigned int)SrcPtr[1] << 8u) |
+		       ((unsigned int)SrcPtr[2] << 16u) | ((unsigned int)SrcPtr[3] << 24u);
+}
+
+/*!
+ * @brief Decodes, checks and executes one frame.
+ *
+ * @return 1 when a command was executed, 0 otherwise.
+ */
+static unsigned int Proto_HandleFrame(unsigned char * FramePtr, unsigned short encodedLength)
+{
+		const Proto_CommandType * command;
+		unsigned short length;
+		unsigned short crc;
+		unsigned char payloadLength;
+		unsigned char responseLength = 0u;
+		unsigned char seq;
+		unsigned char cmd;
+		Proto_status_t status;
+
+		length = Cobs_Decode(FramePtr, encodedLength);
+		if ((length < PROTO_REQUEST_OVERHEAD) || (length > PROTO_MAX_REQUEST))
+		{
+			Proto_Stats.framingErrors++;
+			return 0u;
+		}
+
+		crc = Proto_Crc16(FramePtr, (unsigned short)(length - 2u));
+		if ((FramePtr[length - 2u] != (unsigned char)crc) || (FramePtr[length - 1u] != (unsigned char)(crc >> 8u)))
+		{
+			Proto_Stats.crcErrors++;
+			return 0u;
+		}
+
+		seq = FramePtr[0];
+		cmd = FramePtr[1];
+		payloadLength = (unsigned char)(length - PROTO_REQUEST_OVERHEAD);
+
+		/* Retry of the last request: answer again, do not execute twice */
+		if ((Proto_HaveLast != 0u) && (seq == Proto_LastSeq) && (cmd == Proto_LastCmd))
+		{
+			Proto_Stats.duplicates++;
+			(void)Proto_Send();                 /* Held back: counted as deferred, sent by Proto_Process() */
+			return 0u;
+		}
+
+		/* Dispatch: a registered handler first, then the command table */
+		if ((cmd < PROTO_CMD_COUNT) && (Proto_Registered[cmd].handler != NULL))
+		{
+			command = &Proto_Registered[cmd];
+		}
+		else
+		{
+			command = (cmd < Proto_Config->commandCount) ? &Proto_Config->commands[cmd] : NULL;
+		}
+		if ((command == NULL) || (command->handler == NULL))
+		{
+			status = PROTO_STATUS_UNKNOWN;
+		}
+		else if ((payloadLength < command->minLength) || (payloadLength > command->maxLength))
+		{
+			status = PROTO_STATUS_BAD_LENGTH;
+		}
+		else
+		{
+			TRACE_EVENT(TRACE_ID_PROTO_COMMAND, cmd);
+			status = command->handler(&FramePtr[2], payloadLength, &Proto_Response[3], &responseLength);
+			if ((status != PROTO_STATUS_OK) || (responseLength > PROTO_MAX_PAYLOAD))
+			{
+				responseLength = 0u;
+			}
+		}
+
+		Proto_Response[0] = seq;
+		Proto_Response[1] = (unsigned char)(cmd | PROTO_RESPONSE_FLAG);
+		Proto_Response[2] = (unsigned char)status;
+		length = (unsigned short)(3u + responseLength);
+		crc = Proto_Crc16(Proto_Response, length);
+		Proto_Response[length] = (unsigned char)crc;
+		Proto_Response[length + 1u] = (unsigned char)(crc >> 8u);
+		Proto_ResponseLength = (unsigned char)(length + 2u);
+
+		Proto_HaveLast = 1u;
+		Proto_LastSeq = seq;
+		Proto_LastCmd = cmd;
+		Proto_Stats.frames++;
+		(void)Proto_Send();                     /* Held back: counted as deferred, sent by Proto_Process() */
+
+		return 1u;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the protocol.
+ *
+ * @param[in] ConfigPtr Pointer to the protocol configuration structure.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_Init(const Proto_ConfigType * ConfigPtr)
+{
+		unsigned char index;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->uart >= LPUART_INSTANCE_COUNT) ||
+		    ((ConfigPtr->commands == NULL) && (ConfigPtr->commandCount != 0u)))
+		{
+			return PROTO_ERR_PARA;
+		}
+
+		Proto_Config = ConfigPtr;
+		Proto_ScratchLength = 0u;
+		Proto_Discard = 0u;
+		Proto_HaveLast = 0u;
+		Proto_TxPending = 0u;
+		for (index = 0u; index < PROTO_ALARM_SLOTS; index++)
+		{
+			Proto_AlarmIds[index] = ALARM_INVALID_ID;
+		}
+		Proto_Stats.frames = 0u;
+		Proto_Stats.duplicates = 0u;
+		Proto_Stats.crcErrors = 0u;
+		Proto_Stats.framingErrors = 0u;
+		Proto_Stats.deferred = 0u;
+
+		return PROTO_OK;
+}
+
+/*!
+ * @brief Parses and executes the received frames.
+ *
+ * Frames are decoded in place in the LPUART receive ring; only a frame that wraps the end of
+ * the ring is copied first. Call from the main loop.
+ *
+ * @return Number of requests executed.
+ */
+unsigned int Proto_Process(void)
+{
+		unsigned char * data;
+		unsigned short span;
+		unsigned short end;
+		unsigned short index;
+		unsigned int executed = 0u;
+
+		if (Proto_Config == NULL)
+		{
+			return 0u;
+		}
+
+		TRACE_CALL_BEGIN(TRACE_ID_PROTO_PROCESS);
+		for (;;)
+		{
+			/* A held back response goes first; the next requests wait in the receive ring */
+			if ((Proto_TxPending != 0u) && (Proto_Send() == 0u))
+			{
+				break;
+			}
+
+			span = Lpuart_Peek(Proto_Config->uart, &data);
+			if (span == 0u)
+			{
+				break;
+			}
+
+			for (end = 0u; (end < span) && (data[end] != PROTO_DELIMITER); end++)
+			{
+			}
+
+			/* 1. Complete frame */
+			if (end < span)
+			{
+				if (Proto_Discard != 0u)
+				{
+					Proto_Discard = 0u;
+					Proto_Stats.framingErrors++;
+				}
+				else if (Proto_ScratchLength != 0u)
+				{
+					if ((Proto_ScratchLength + end) > PROTO_MAX_ENCODED)
+					{
+						Proto_Stats.framingErrors++;
+					}
+					else
+					{
+						for (index = 0u; index < end; index++)
+						{
+							Proto_Scratch[Proto_ScratchLength + index] = data[index];
+						}
+						executed += Proto_HandleFrame(Proto_Scratch, (unsigned short)(Proto_ScratchLength + end));
+					}
+					Proto_ScratchLength = 0u;
+				}
+				else if (end != 0u)
+				{
+					executed += Proto_HandleFrame(data, end);
+				}
+				Lpuart_Consume(Proto_Config->uart, (unsigned short)(end + 1u));
+				continue;
+			}
+
+			/* 2. Frame too long for any request: drop up to the next delimiter */
+			if ((Proto_Discard != 0u) || ((Proto_ScratchLength + span) > PROTO_MAX_ENCODED))
+			{
+				Proto_Discard = 1u;
+				Proto_ScratchLength = 0u;
+				Lpuart_Consume(Proto_Config->uart, span);
+				continue;
+			}
+
+			/* 3. Frame wraps the end of the ring: keep the first part */
+			if (span < Lpuart_GetRxCount(Proto_Config->uart))
+			{
+				for (index = 0u; index < span; index++)
+				{
+					Proto_Scratch[Proto_ScratchLength + index] = data[index];
+				}
+				Proto_ScratchLength = (unsigned short)(Proto_ScratchLength + span);
+				Lpuart_Consume(Proto_Config->uart, span);
+				continue;
+			}
+
+			/* 4. Frame not complete yet */
+			break;
+		}
+		TRACE_CALL_END(TRACE_ID_PROTO_PROCESS, executed);
+
+		return executed;
+}
+
+/*!
+ * @brief Retrieves the protocol statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_GetStats(Proto_StatsType * StatsPtr)
+{
+		if (StatsPtr == NULL)
+		{
+			return PROTO_ERR_PARA;
+		}
+
+		*StatsPtr = Proto_Stats;
+		return PROTO_OK;
+}
+
+/*!
+ * @brief Registers the handler of a command owned by another module.
+ *
+ * A module serves the command it owns without the protocol knowing about it.
+ * Precedence: a registered handler wins over the entry of the command table, limits included;
+ * registering NULL gives the command back to the table.
+ * Re-init: the registrations are kept in a table of their own that Proto_Init() does not clear,
+ * so a module may register from its Init function before or after Proto_Init(), and they stay
+ * in force when the protocol is initialized again. Call from the main loop context.
+ *
+ * @param[in] cmd Command, below PROTO_CMD_COUNT.
+ * @param[in] handler Handler, NULL to fall back to the command table.
+ * @param[in] minLength Shortest accepted payload.
+ * @param[in] maxLength Longest accepted payload, at most PROTO_MAX_PAYLOAD.
+ * @return PROTO_OK on success, PROTO_ERR_PARA on parameter error.
+ */
+Proto_ret_t Proto_Register(unsigned char cmd, Proto_HandlerType handler, unsigned char minLength, unsigned char maxLength)
+{
+		/* Check parameter */
+		if ((cmd >= PROTO_CMD_COUNT) || (maxLength > PROTO_MAX_PAYLOAD) || (minLength > maxLength))
+		{
+			return PROTO_ERR_PARA;
+		}
+
+		Proto_Registered[cmd].handler = handler;
+		Proto_Registered[cmd].minLength = minLength;
+		Proto_Registered[cmd].maxLength = maxLength;
+		return PROTO_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_PING, echoes the request payload.
+ *
+ * Put it in the command table entry PROTO_CMD_PING.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandlePing(const unsigned char * Request, unsigned char length,
+                                unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned char index;
+
+		for (index = 0u; index < length; index++)
+		{
+			Response[index] = Request[index];
+		}
+		*ResponseLength = length;
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_TIME, reports the software clock of Calib.h.
+ *
+ * Put it in the command table entry PROTO_CMD_GET_TIME with a payload length of 0.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandleGetTime(const unsigned char * Request, unsigned char length,
+                                   unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned int seconds;
+		unsigned int nanoseconds;
+
+		(void)Request;
+		(void)length;
+
+		Calib_GetTime(&seconds, &nanoseconds);
+		Proto_PutU32(&Response[0], seconds);
+		Proto_PutU32(&Response[4], nanoseconds);
+		*ResponseLength = 8u;
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_TIME, sets the software clock of Calib.h.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_TIME with a payload length of 8.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for nanoseconds of 1e9 or more.
+ */
+Proto_status_t Proto_HandleSetTime(const unsigned char * Request, unsigned char length,
+                                   unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned int nanoseconds = Proto_GetU32(&Request[4]);
+
+		(void)length;
+		(void)Response;
+		(void)ResponseLength;
+
+		if (nanoseconds >= PROTO_NS_PER_SECOND)
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+
+		Calib_SetTime(Proto_GetU32(&Request[0]), nanoseconds);
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_ALARM, sets a weekday alarm of Alarm.h in a slot.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_ALARM with a payload length of 6. An alarm
+ * already in the slot is replaced; the alarm calls alarmCallback of the configuration.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for a bad slot, time or mask,
+ *         PROTO_STATUS_BUSY when the scheduler is full.
+ */
+Proto_status_t Proto_HandleSetAlarm(const unsigned char * Request, unsigned char length,
+                                    unsigned char * Response, unsigned char * ResponseLength)
+{
+		Alarm_EntryType entry;
+		unsigned char slot = Request[0];
+		unsigned short id;
+
+		(void)length;
+		(void)Response;
+		(void)ResponseLength;
+
+		entry.type = ALARM_TYPE_WEEKDAY;
+		entry.time = Proto_GetU32(&Request[1]);
+		entry.weekdayMask = Request[5];
+		entry.callback = Proto_Config->alarmCallback;
+		entry.userData = NULL;
+		if ((slot >= PROTO_ALARM_SLOTS) || (entry.time >= ALARM_SECONDS_PER_DAY) ||
+		    (entry.weekdayMask == 0u) || ((entry.weekdayMask & ~ALARM_EVERY_DAY) != 0u))
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+
+		if (Proto_AlarmIds[slot] != ALARM_INVALID_ID)
+		{
+			(void)Alarm_Remove(Proto_AlarmIds[slot]);
+			Proto_AlarmIds[slot] = ALARM_INVALID_ID;
+		}
+		if (Alarm_Add(&entry, &id) != ALARM_OK)
+		{
+			return PROTO_STATUS_BUSY;
+		}
+		Proto_AlarmIds[slot] = id;
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_CLEAR_ALARM, removes the alarm of a slot.
+ *
+ * Put it in the command table entry PROTO_CMD_CLEAR_ALARM with a payload length of 1. Clearing
+ * an empty slot succeeds.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE for a bad slot.
+ */
+Proto_status_t Proto_HandleClearAlarm(const unsigned char * Request, unsigned char length,
+                                      unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned char slot = Request[0];
+
+		(void)length;
+		(void)Response;
+		(void)ResponseLength;
+
+		if (slot >= PROTO_ALARM_SLOTS)
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+
+		if (Proto_AlarmIds[slot] != ALARM_INVALID_ID)
+		{
+			(void)Alarm_Remove(Proto_AlarmIds[slot]);
+			Proto_AlarmIds[slot] = ALARM_INVALID_ID;
+		}
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_SET_BRIGHTNESS, starts a fade of Brightness.h.
+ *
+ * Put it in the command table entry PROTO_CMD_SET_BRIGHTNESS with a payload length of 3.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK, PROTO_STATUS_BAD_VALUE above BRIGHTNESS_LEVEL_MAX,
+ *         PROTO_STATUS_BUSY before Brightness_Init().
+ */
+Proto_status_t Proto_HandleSetBrightness(const unsigned char * Request, unsigned char length,
+                                         unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned int fadeMs = (unsigned int)Request[1] | ((unsigned int)Request[2] << 8u);
+
+		(void)length;
+		(void)Response;
+		(void)ResponseLength;
+
+		if (Request[0] > BRIGHTNESS_LEVEL_MAX)
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+		if (Brightness_FadeTo(Request[0], fadeMs) != BRIGHTNESS_OK)
+		{
+			return PROTO_STATUS_BUSY;
+		}
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_STATUS, reports the brightness, the alarm count and the frames.
+ *
+ * Put it in the command table entry PROTO_CMD_GET_STATUS with a payload length of 0.
+ *
+ * @param[in] Request Request payload.
+ * @param[in] length Request payload length.
+ * @param[out] Response Response payload.
+ * @param[out] ResponseLength Response payload length.
+ * @return PROTO_STATUS_OK.
+ */
+Proto_status_t Proto_HandleGetStatus(const unsigned char * Request, unsigned char length,
+                                     unsigned char * Response, unsigned char * ResponseLength)
+{
+		unsigned short alarms = Alarm_GetCount();
+
+		(void)Request;
+		(void)length;
+
+		Response[0] = Brightness_GetLevel();
+		Response[1] = (unsigned char)alarms;
+		Response[2] = (unsigned char)(alarms >> 8u);
+		Proto_PutU32(&Response[3], Proto_Stats.frames);
+		*ResponseLength = 7u;
+
+		return PROTO_STATUS_OK;
+}
+
+/*!
+ * @brief Computes the CRC-16/CCITT-FALSE of a buffer.
+ *
+ * @param[in] DataPtr Data.
+ * @param[in] length Number of bytes.
+ * @return CRC, polynomial 0x1021, initial value 0xFFFF.
+ */
+unsigned short Proto_Crc16(const unsigned char * DataPtr, unsigned short length)
+{
+		return Crc16_Compute(DataPtr, length);
+}
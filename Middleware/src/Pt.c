@@ -0,0 +1,269 @@
+/****************************************************************************************************
+* @file    Pt.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the stackless coroutine scheduler.
+* @details This file keeps one bit per task in a ready, a sleep and an event mask. Pt_Run() only
+*          scans the sleeping tasks when the earliest wake-up tick has come and the event waiters
+*          when an event was signalled, then resumes the ready tasks in table order. A switch
+*          is one indirect call and one jump through the coroutine switch statement.
+* @version 1.0.0
+* @date    2024-11-09
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Pt.h"
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Pt_TaskType * Pt_Tasks;                          /* Task table */
+static unsigned int Pt_ReadyMask;                       /* Tasks resumed by the next Pt_Run() */
+static unsigned int Pt_SleepMask;                       /* Tasks in PT_STATE_SLEEP */
+static unsigned int Pt_EventMask;                       /* Tasks in PT_STATE_EVENT */
+static unsigned int Pt_NextWake;                        /* Earliest wakeTick of the sleeping tasks */
+static volatile unsigned int Pt_Ticks;                  /* Tick count */
+static volatile unsigned char Pt_Pending;               /* Events signalled since the last Pt_Run() */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Makes the tasks waiting for the signalled events ready.
+ */
+static void Pt_ReleaseEvents(unsigned char events)
+{
+		unsigned int waiting = Pt_EventMask;
+		unsigned int index;
+		Pt_TaskType * task;
+
+		while (waiting != 0u)
+		{
+			index = (unsigned int)__builtin_ctz(waiting);
+			waiting &= waiting - 1u;
+			task = &Pt_Tasks[index];
+			if ((task->events & events) != 0u)
+			{
+				task->events &= events;
+				task->state = (unsigned char)PT_STATE_READY;
+				Pt_EventMask &= ~(1u << index);
+				Pt_ReadyMask |= (1u << index);
+			}
+		}
+}
+
+/*!
+ * @brief Makes the sleeping tasks that are due ready and finds the next wake-up tick.
+ */
+static void Pt_ReleaseSleepers(unsigned int now)
+{
+		unsigned int sleeping = Pt_SleepMask;
+		unsigned int next = now + 0x7FFFFFFFu;
+		unsigned int index;
+		Pt_TaskType * task;
+
+		while (sleeping != 0u)
+		{
+			index = (unsigned int)__builtin_ctz(sleeping);
+			sleeping &= sleeping - 1u;
+			task = &Pt_Tasks[index];
+			if ((int32)(now - task->wakeTick) >= 0)
+			{
+				task->state = (unsigned char)PT_STATE_READY;
+				Pt_SleepMask &= ~(1u << index);
+				Pt_ReadyMask |= (1u << index);
+			}
+			else if ((int32)(task->wakeTick - next) < 0)
+			{
+				next = task->wakeTick;
+			}
+		}
+		Pt_NextWake = next;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the scheduler with a table of tasks, all ready.
+ *
+ * The table order is the priority order: within one Pt_Run() lower indexes run first.
+ *
+ * @param[in] TasksPtr Task table, func set by the caller.
+ * @param[in] count Number of tasks, up to PT_MAX_TASKS.
+ * @return PT_OK on success, PT_ERR_PARA on parameter error.
+ */
+Pt_ret_t Pt_Init(Pt_TaskType * TasksPtr, unsigned char count)
+{
+		unsigned char index;
+
+		/* Check parameter */
+		if ((TasksPtr == NULL) || (count == 0u) || (count > PT_MAX_TASKS))
+		{
+			return PT_ERR_PARA;
+		}
+		for (index = 0u; index < count; index++)
+		{
+			if (TasksPtr[index].func == NULL)
+			{
+				return PT_ERR_PARA;
+			}
+			TasksPtr[index].lc = 0u;
+			TasksPtr[index].wakeTick = 0u;
+			TasksPtr[index].events = 0u;
+			TasksPtr[index].state = (unsigned char)PT_STATE_READY;
+		}
+
+		Pt_Tasks = TasksPtr;
+		Pt_ReadyMask = (count == PT_MAX_TASKS) ? 0xFFFFFFFFu : ((1u << count) - 1u);
+		Pt_SleepMask = 0u;
+		Pt_EventMask = 0u;
+		Pt_NextWake = 0u;
+		Pt_Ticks = 0u;
+		Pt_Pending = 0u;
+
+		return PT_OK;
+}
+
+/*!
+ * @brief Resumes every ready task once.
+ *
+ * Call from the main loop; when it returns 0 nothing is ready and the CPU may sleep until
+ * the next interrupt.
+ *
+ * @return Number of tasks resumed.
+ */
+unsigned int Pt_Run(void)
+{
+		unsigned int state;
+		unsigned int now = Pt_Ticks;
+		unsigned char events;
+		unsigned int run;
+		unsigned int index;
+		unsigned int bit;
+		unsigned int resumed = 0u;
+		Pt_TaskType * task;
+
+		if (Pt_Tasks == NULL)
+		{
+			return 0u;
+		}
+
+		/* 1. Take the events signalled since the last call */
+		state = PT_ENTER_CRITICAL();
+		events = Pt_Pending;
+		Pt_Pending = 0u;
+		PT_EXIT_CRITICAL(state);
+
+		if ((events != 0u) && (Pt_EventMask != 0u))
+		{
+			Pt_ReleaseEvents(events);
+		}
+		if ((Pt_SleepMask != 0u) && ((int32)(now - Pt_NextWake) >= 0))
+		{
+			Pt_ReleaseSleepers(now);
+		}
+
+		/* 2. Resume the ready tasks; a yield runs again in the next call */
+		run = Pt_ReadyMask;
+		Pt_ReadyMask = 0u;
+		while (run != 0u)
+		{
+			index = (unsigned int)__builtin_ctz(run);
+			run &= run - 1u;
+			bit = 1u << index;
+			task = &Pt_Tasks[index];
+			resumed++;
+
+			switch (task->func(task))
+			{
+				case PT_YIELDED:
+					task->state = (unsigned char)PT_STATE_READY;
+					Pt_ReadyMask |= bit;
+					break;
+				case PT_ENDED:
+					task->state = (unsigned char)PT_STATE_ENDED;
+					break;
+				default:
+					if (task->state == (unsigned char)PT_STATE_SLEEP)
+					{
+						if ((Pt_SleepMask == 0u) || ((int32)(task->wakeTick - Pt_NextWake) < 0))
+						{
+							Pt_NextWake = task->wakeTick;
+						}
+						Pt_SleepMask |= bit;
+					}
+					else
+					{
+						Pt_EventMask |= bit;
+					}
+					break;
+			}
+		}
+
+		return resumed;
+}
+
+/*!
+ * @brief Advances the tick count, from the SysTick interrupt.
+ *
+ * @return void.
+ */
+void Pt_Tick(void)
+{
+		Pt_Ticks++;
+}
+
+/*!
+ * @brief Gets the tick count.
+ *
+ * @return Ticks since Pt_Init(), wrapping at 2^32.
+ */
+unsigned int Pt_GetTicks(void)
+{
+		return Pt_Ticks;
+}
+
+/*!
+ * @brief Signals events to the tasks waiting for them.
+ *
+ * Callable from interrupts. Events nobody waits for are discarded by the next Pt_Run().
+ *
+ * @param[in] mask Event bits.
+ * @return void.
+ */
+void Pt_SetEvent(unsigned char mask)
+{
+		unsigned int state;
+
+		state = PT_ENTER_CRITICAL();
+		Pt_Pending |= mask;
+		PT_EXIT_CRITICAL(state);
+}
+
+/*!
+ * @brief Gets the ticks until the next sleeping task wakes up.
+ *
+ * @return Ticks, 0 when a task is ready, 0xFFFFFFFF when no task sleeps.
+ */
+unsigned int Pt_GetIdleTicks(void)
+{
+		unsigned int left;
+
+		if ((Pt_ReadyMask != 0u) || (Pt_Pending != 0u))
+		{
+			return 0u;
+		}
+		if (Pt_SleepMask == 0u)
+		{
+			return 0xFFFFFFFFu;
+		}
+
+		left = Pt_NextWake - Pt_Ticks;
+		return ((int32)left > 0) ? left : 0u;
+}
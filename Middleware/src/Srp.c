@@ -0,0 +1,50 @@
+/****************************************************************************************************
+* @file    Srp.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the stack resource policy.
+* @details This file checks the task list at compile time and programs the NVIC priorities from
+*          it; locking itself is inline in Srp.h.
+* @version 1.0.0
+* @date    2024-11-10
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Srp.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Compile-time checks: priority in range, interrupt iff priority above the main loop ***/
+#define SRP_CHECK_TASK(ARG, NAME, IRQ, PRIO)                                                        \
+		STATIC_ASSERT((PRIO) <= SRP_PRIORITY_MAX, srp_priority_range_##NAME);                       \
+		STATIC_ASSERT((((unsigned int)(IRQ) == SRP_NO_IRQ) ? 1u : 0u) == (((PRIO) == 0u) ? 1u : 0u),  \
+		              srp_irq_priority_##NAME);
+
+#define SRP_SET_PRIORITY(ARG, NAME, IRQ, PRIO)                                                      \
+		if ((unsigned int)(IRQ) != SRP_NO_IRQ)                                                      \
+		{                                                                                           \
+			NVIC_SetPriority((IRQn_Type)(IRQ), (unsigned char)SRP_NVIC_PRIORITY(PRIO));             \
+		}
+
+SRP_TASK_LIST(SRP_CHECK_TASK, 0)
+STATIC_ASSERT(SRP_TASK_COUNT <= 32u, srp_task_count);
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Programs the NVIC priority of every interrupt task.
+ *
+ * Call before the interrupts are enabled.
+ *
+ * @return void.
+ */
+void Srp_Init(void)
+{
+		SRP_TASK_LIST(SRP_SET_PRIORITY, 0)
+}
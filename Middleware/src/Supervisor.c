@@ -0,0 +1,286 @@
+/****************************************************************************************************
+* @file    Supervisor.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the task supervisor feeding the watchdog.
+* @details This file keeps one alive flag per task. A check-in is a byte store; the check takes
+*          the flags, so a task is late when it has not checked in for longer than its deadline.
+*          The record of the culprit is written when it is found, long before the reset, so the
+*          pre-reset interrupt only has to mark it expired in the 128 bus clocks it has.
+* @version 1.0.0
+* @date    2024-11-16
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Supervisor.h"
+#include "Dwt.h"
+#include "Proto.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SUPERVISOR_MAGIC                (0x57444F47u)      /* "WDOG" */
+#define SUPERVISOR_RESET_RESPONSE       (22u)              /* PROTO_CMD_GET_RESET payload */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Record kept across the reset, valid when check matches.
+ */
+typedef struct
+{
+			unsigned int   magic;
+			unsigned char  task;
+			unsigned char  expired;
+			unsigned char  RESERVE1[2];
+			unsigned int   check;
+} Supervisor_RecordType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Supervisor_ConfigType * Supervisor_Config;         /* Active configuration */
+static volatile unsigned char Supervisor_Alive[SUPERVISOR_TASK_MAX];    /* Set by check-ins */
+static unsigned int           Supervisor_LastSeen[SUPERVISOR_TASK_MAX]; /* Time of the last check-in seen */
+static unsigned int           Supervisor_LastCheck;
+static Supervisor_ResetType   Supervisor_LastReset;
+static Supervisor_StatsType   Supervisor_Stats;
+static volatile Supervisor_RecordType Supervisor_Record __attribute__((section(SUPERVISOR_SECTION)));
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Check word of a record.
+ */
+static unsigned int Supervisor_Check(unsigned char task, unsigned char expired)
+{
+		return ~(SUPERVISOR_MAGIC ^ (unsigned int)task ^ ((unsigned int)expired << 8u));
+}
+
+/*!
+ * @brief Writes the record.
+ */
+static void Supervisor_WriteRecord(unsigned char task, unsigned char expired)
+{
+		Supervisor_Record.magic = SUPERVISOR_MAGIC;
+		Supervisor_Record.task = task;
+		Supervisor_Record.expired = expired;
+		Supervisor_Record.check = Supervisor_Check(task, expired);
+}
+
+/*!
+ * @brief Writes a little-endian word.
+ */
+static void Supervisor_PutWord(unsigned char * DataPtr, unsigned int value)
+{
+		DataPtr[0] = (unsigned char)value;
+		DataPtr[1] = (unsigned char)(value >> 8u);
+		DataPtr[2] = (unsigned char)(value >> 16u);
+		DataPtr[3] = (unsigned char)(value >> 24u);
+}
+
+/*!
+ * @brief Handler of PROTO_CMD_GET_RESET, reports the last reset and the refresh cost.
+ *
+ * Response: causes, sticky causes, refreshes, refresh cycles and worst check cycles, u32 each,
+ * then the late task u8 and expired u8.
+ */
+static Proto_status_t Supervisor_HandleGetReset(const unsigned char * Request, unsigned char length,
+                                                unsigned char * Response, unsigned char * ResponseLength)
+{
+		(void)Request;
+		(void)length;
+
+		Supervisor_PutWord(&Response[0], Supervisor_LastReset.causes);
+		Supervisor_PutWord(&Response[4], Supervisor_LastReset.stickyCauses);
+		Supervisor_PutWord(&Response[8], Supervisor_Stats.refreshes);
+		Supervisor_PutWord(&Response[12], Supervisor_Stats.refreshCycles);
+		Supervisor_PutWord(&Response[16], Supervisor_Stats.processCyclesMax);
+		Response[20] = Supervisor_LastReset.task;
+		Response[21] = Supervisor_LastReset.expired;
+		*ResponseLength = SUPERVISOR_RESET_RESPONSE;
+
+		return PROTO_STATUS_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes the supervisor and reads the reason of the last reset.
+ *
+ * Every task gets a full deadline from now. The record left by the last run is taken when its
+ * check word is valid, and cleared. The reason and the statistics are served to the serial
+ * protocol as PROTO_CMD_GET_RESET.
+ *
+ * @param[in] ConfigPtr Pointer to the supervisor configuration structure.
+ * @param[in] now Current time in milliseconds.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_Init(const Supervisor_ConfigType * ConfigPtr, unsigned int now)
+{
+		unsigned char id;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->taskCount > SUPERVISOR_TASK_MAX) ||
+		    ((ConfigPtr->taskCount != 0u) && (ConfigPtr->deadlinesMs == NULL)))
+		{
+			return SUPERVISOR_ERR_PARA;
+		}
+
+		/* Reason of the last reset */
+		Supervisor_LastReset.causes = Rcm_GetResetCauses();
+		Supervisor_LastReset.stickyCauses = Rcm_TakeStickyCauses();
+		Supervisor_LastReset.task = SUPERVISOR_TASK_NONE;
+		Supervisor_LastReset.expired = 0u;
+		if ((Supervisor_Record.magic == SUPERVISOR_MAGIC) &&
+		    (Supervisor_Record.check == Supervisor_Check(Supervisor_Record.task, Supervisor_Record.expired)))
+		{
+			Supervisor_LastReset.task = Supervisor_Record.task;
+			Supervisor_LastReset.expired = Supervisor_Record.expired;
+		}
+		Supervisor_WriteRecord(SUPERVISOR_TASK_NONE, 0u);
+
+		for (id = 0u; id < SUPERVISOR_TASK_MAX; id++)
+		{
+			Supervisor_Alive[id] = 0u;
+			Supervisor_LastSeen[id] = now;
+		}
+		Supervisor_Stats.refreshes = 0u;
+		Supervisor_Stats.refreshCycles = 0u;
+		Supervisor_Stats.processCycles = 0u;
+		Supervisor_Stats.processCyclesMax = 0u;
+		Supervisor_Stats.late = SUPERVISOR_TASK_NONE;
+		Supervisor_LastCheck = now;
+		Supervisor_Config = ConfigPtr;
+		(void)Proto_Register(PROTO_CMD_GET_RESET, Supervisor_HandleGetReset, 0u, 0u);
+
+		return SUPERVISOR_OK;
+}
+
+/*!
+ * @brief Checks a task in.
+ *
+ * Safe from any context, interrupts included.
+ *
+ * @param[in] id Task id.
+ * @return void.
+ */
+void Supervisor_CheckIn(unsigned char id)
+{
+		if (id < SUPERVISOR_TASK_MAX)
+		{
+			Supervisor_Alive[id] = 1u;
+		}
+}
+
+/*!
+ * @brief Checks the deadlines and refreshes the watchdog.
+ *
+ * Returns after one comparison until periodMs has elapsed since the last check. Call from the
+ * main loop or the lowest priority task, so that a hang anywhere stops the refreshes.
+ *
+ * @param[in] now Current time in milliseconds.
+ * @return void.
+ */
+void Supervisor_Process(unsigned int now)
+{
+		unsigned int start;
+		unsigned int cycles;
+		unsigned char id;
+
+		if ((Supervisor_Config == NULL) || ((now - Supervisor_LastCheck) < Supervisor_Config->periodMs))
+		{
+			return;
+		}
+		Supervisor_LastCheck = now;
+		start = DWT_GET_CYCLES();
+
+		/* A check-in between the read and the clear is folded into this one */
+		for (id = 0u; id < Supervisor_Config->taskCount; id++)
+		{
+			if (Supervisor_Alive[id] != 0u)
+			{
+				Supervisor_Alive[id] = 0u;
+				Supervisor_LastSeen[id] = now;
+			}
+			else if (((now - Supervisor_LastSeen[id]) > Supervisor_Config->deadlinesMs[id]) &&
+			         (Supervisor_Stats.late == SUPERVISOR_TASK_NONE))
+			{
+				Supervisor_Stats.late = id;
+				Supervisor_WriteRecord(id, 0u);
+			}
+		}
+
+		/* A late task stops the refreshes until the reset */
+		if ((Supervisor_Stats.late == SUPERVISOR_TASK_NONE) && (Wdog_IsWindowOpen() != 0u))
+		{
+			cycles = DWT_GET_CYCLES();
+			Wdog_Refresh();
+			Supervisor_Stats.refreshCycles = DWT_GET_CYCLES() - cycles;
+			Supervisor_Stats.refreshes++;
+		}
+
+		cycles = DWT_GET_CYCLES() - start;
+		Supervisor_Stats.processCycles = cycles;
+		if (cycles > Supervisor_Stats.processCyclesMax)
+		{
+			Supervisor_Stats.processCyclesMax = cycles;
+		}
+}
+
+/*!
+ * @brief Pre-reset callback of the watchdog.
+ *
+ * Marks the record as expired. Pass it as the Wdog_ConfigType callback.
+ *
+ * @return void.
+ */
+void Supervisor_OnExpiry(void)
+{
+		Supervisor_Record.expired = 1u;
+		Supervisor_Record.check = Supervisor_Check(Supervisor_Record.task, 1u);
+}
+
+/*!
+ * @brief Retrieves the reason of the last reset.
+ *
+ * @param[out] ResetPtr Pointer to the reset structure.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_GetLastReset(Supervisor_ResetType * ResetPtr)
+{
+		if (ResetPtr == NULL)
+		{
+			return SUPERVISOR_ERR_PARA;
+		}
+
+		*ResetPtr = Supervisor_LastReset;
+		return SUPERVISOR_OK;
+}
+
+/*!
+ * @brief Retrieves the supervisor statistics.
+ *
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return SUPERVISOR_OK on success, SUPERVISOR_ERR_PARA on parameter error.
+ */
+Supervisor_ret_t Supervisor_GetStats(Supervisor_StatsType * StatsPtr)
+{
+		if (StatsPtr == NULL)
+		{
+			return SUPERVISOR_ERR_PARA;
+		}
+
+		*StatsPtr = Supervisor_Stats;
+		return SUPERVISOR_OK;
+}
@@ -0,0 +1,489 @@
+/****************************************************************************************************
+* @file    Tsync.c
+* @author  Ma Hien Nhan
+* @brief   Implementation of the time synchronization over CAN.
+* @details This file sends SYNC / FOLLOW_UP on a master and follows them on a slave. The CAN
+*          time stamps are converted to the local timebase when the callback runs; a slave updates
+*          its reference point and its rate estimate from every FOLLOW_UP, and the main loop reads
+*          them through a sequence counter.
+* @version 1.0.0
+* @date    2024-11-14
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Tsync.h"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define TSYNC_NS_PER_MS                 (1000000u)
+#define TSYNC_RATE_WEIGHT               (4)                /* Rate estimate smoothing, 1 / weight of a new sample */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Run-time state of an instance.
+ */
+typedef struct
+{
+			const Tsync_ConfigType *    config;         /*!< Active configuration, NULL when stopped */
+			unsigned int                bitNs;          /*!< Bit time in nanoseconds */
+			/* Reference: master time refMaster at local time refLocal, guarded by sequence */
+			volatile unsigned int       sequence;
+			uint64                      refLocal;
+			uint64                      refMaster;
+			int                         ratePpb;
+			volatile unsigned char      synced;
+			unsigned char               rateValid;
+			/* Master */
+			volatile unsigned char      inFlight;       /*!< SYNC queued, FOLLOW_UP not sent yet */
+			unsigned char               seq;
+			unsigned int                syncSeconds;    /*!< Seconds sent in SYNC */
+			uint64                      lastSendNs;
+			/* Slave: SYNC waiting for its FOLLOW_UP */
+			unsigned char               pendValid;
+			unsigned char               pendSeq;
+			unsigned int                pendSeconds;
+			uint64                      pendLocal;
+			/* Statistics */
+			volatile unsigned int       syncs;
+			volatile unsigned int       lost;
+			volatile int                lastOffsetNs;
+			volatile unsigned int       worstOffsetNs;
+} Tsync_StateType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Tsync_StateType Tsync_State[CAN_INSTANCE_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Reads the local timebase in nanoseconds.
+ */
+static uint64 Tsync_LocalNs(const Tsync_ConfigType * ConfigPtr)
+{
+		uint64 count = ConfigPtr->counter();
+
+		return ((count / ConfigPtr->counterHz) * TSYNC_NS_PER_SECOND) +
+		       (((count % ConfigPtr->counterHz) * TSYNC_NS_PER_SECOND) / ConfigPtr->counterHz);
+}
+
+/*!
+ * @brief Converts a CAN time stamp to the local timebase.
+ *
+ * The timer is polled until it steps, which happens on a bit boundary of the bus, so the local
+ * time read right after it is aligned to a timer edge; the bit times since the time stamp are
+ * then subtracted. This takes at most one bit time plus the interrupt latency in bit times,
+ * which must stay below 2^16.
+ */
+static uint64 Tsync_Capture(const Tsync_StateType * state, unsigned short timestamp)
+{
+		unsigned short before;
+		unsigned short now;
+		unsigned int loops = 0u;
+
+		before = Can_GetTimer(state->config->instance);
+		do
+		{
+			now = Can_GetTimer(state->config->instance);
+			loops++;
+		} while ((now == before) && (loops < TSYNC_EDGE_LOOPS));
+
+		return Tsync_LocalNs(state->config) - ((uint64)(unsigned short)(now - timestamp) * state->bitNs);
+}
+
+/*!
+ * @brief Master time at a local time, from a reference point and a rate.
+ */
+static uint64 Tsync_Extrapolate(uint64 local, uint64 refLocal, uint64 refMaster, int ratePpb)
+{
+		int64 elapsed = (int64)(local - refLocal);
+
+		return refMaster + (uint64)(elapsed + ((elapsed * ratePpb) / (int64)TSYNC_NS_PER_SECOND));
+}
+
+/*!
+ * @brief Replaces the reference point.
+ */
+static void Tsync_SetReference(Tsync_StateType * state, uint64 local, uint64 master, int ratePpb)
+{
+		state->sequence++;
+		state->refLocal = local;
+		state->refMaster = master;
+		state->ratePpb = ratePpb;
+		state->sequence++;
+}
+
+/*!
+ * @brief Applies a sync: master time master was on the bus at local time local.
+ *
+ * The rate is measured over the interval since the previous sync and smoothed; the reference
+ * point moves to the new sync, so the time steps by the offset of the extrapolation.
+ */
+static void Tsync_Apply(Tsync_StateType * state, uint64 local, uint64 master)
+{
+		int64 elapsed;
+		int64 offset;
+		int64 rate;
+		int ratePpb = state->ratePpb;
+		unsigned int magnitude;
+
+		if (state->synced != 0u)
+		{
+			elapsed = (int64)(local - state->refLocal);
+			offset = (int64)(master - Tsync_Extrapolate(local, state->refLocal, state->refMaster, state->ratePpb));
+			if (elapsed > 0)
+			{
+				rate = (((int64)(master - state->refMaster) - elapsed) * (int64)TSYNC_NS_PER_SECOND) / elapsed;
+				if ((rate >= -(int64)TSYNC_MAX_PPB) && (rate <= (int64)TSYNC_MAX_PPB))
+				{
+					if (state->rateValid != 0u)
+					{
+						/* Offset of a locked slave: the accuracy of the extrapolation over one period */
+						magnitude = (offset < 0) ? (unsigned int)(-offset) : (unsigned int)offset;
+						if ((magnitude > state->worstOffsetNs) &&
+						    ((state->config->timeoutMs == 0u) || (elapsed <= ((int64)state->config->timeoutMs * TSYNC_NS_PER_MS))))
+						{
+							state->worstOffsetNs = magnitude;
+						}
+						ratePpb += (int)((rate - ratePpb) / TSYNC_RATE_WEIGHT);
+					}
+					else
+					{
+						ratePpb = (int)rate;
+						state->rateValid = 1u;
+					}
+				}
+			}
+			state->lastOffsetNs = (int)offset;
+		}
+
+		Tsync_SetReference(state, local, master, ratePpb);
+		state->synced = 1u;
+		state->syncs++;
+}
+
+/*!
+ * @brief Reads a big endian word.
+ */
+static unsigned int Tsync_GetWord(const unsigned char * DataPtr)
+{
+		return ((unsigned int)DataPtr[0] << 24u) | ((unsigned int)DataPtr[1] << 16u) |
+		       ((unsigned int)DataPtr[2] << 8u) | (unsigned int)DataPtr[3];
+}
+
+/*!
+ * @brief Builds a SYNC or FOLLOW_UP frame.
+ */
+static void Tsync_Build(Can_FrameType * FramePtr, unsigned int id, unsigned char seq, unsigned int value)
+{
+		unsigned char index;
+
+		FramePtr->id = id;
+		FramePtr->extended = 0u;
+		FramePtr->length = TSYNC_MSG_LENGTH;
+		for (index = 0u; index < TSYNC_MSG_LENGTH; index++)
+		{
+			FramePtr->data[index] = 0u;
+		}
+		FramePtr->data[TSYNC_MSG_SEQ] = seq;
+		FramePtr->data[TSYNC_MSG_VALUE + 0u] = (unsigned char)(value >> 24u);
+		FramePtr->data[TSYNC_MSG_VALUE + 1u] = (unsigned char)(value >> 16u);
+		FramePtr->data[TSYNC_MSG_VALUE + 2u] = (unsigned char)(value >> 8u);
+		FramePtr->data[TSYNC_MSG_VALUE + 3u] = (unsigned char)value;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Initializes a time synchronization instance.
+ *
+ * A master starts its time from the local timebase; Tsync_SetTime() moves it.
+ *
+ * @param[in] ConfigPtr Pointer to the configuration structure.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error.
+ * @note The FlexCAN instance is initialized by the application, a slave accepting syncId and
+ *       followUpId.
+ */
+Tsync_ret_t Tsync_Init(const Tsync_ConfigType * ConfigPtr)
+{
+		Tsync_StateType * state;
+
+		/* Check parameter */
+		if ((ConfigPtr == NULL) || (ConfigPtr->instance >= CAN_INSTANCE_COUNT) ||
+		    (ConfigPtr->role > TSYNC_ROLE_SLAVE) || (ConfigPtr->counter == NULL) ||
+		    (ConfigPtr->counterHz == 0u) || (ConfigPtr->bitrate == 0u) ||
+		    ((TSYNC_NS_PER_SECOND % ConfigPtr->bitrate) != 0u) ||
+		    (ConfigPtr->syncId > CAN_ID_STD_MASK) || (ConfigPtr->followUpId > CAN_ID_STD_MASK) ||
+		    (ConfigPtr->syncId == ConfigPtr->followUpId) ||
+		    ((ConfigPtr->role == TSYNC_ROLE_MASTER) && (ConfigPtr->periodMs == 0u)))
+		{
+			return TSYNC_ERR_PARA;
+		}
+
+		state = &Tsync_State[ConfigPtr->instance];
+		state->config = NULL;
+		state->bitNs = TSYNC_NS_PER_SECOND / ConfigPtr->bitrate;
+		state->synced = 0u;
+		state->rateValid = 0u;
+		state->inFlight = 0u;
+		state->seq = 0u;
+		state->pendValid = 0u;
+		state->syncs = 0u;
+		state->lost = 0u;
+		state->lastOffsetNs = 0;
+		state->worstOffsetNs = 0u;
+		Tsync_SetReference(state, 0u, 0u, 0);
+		state->lastSendNs = Tsync_LocalNs(ConfigPtr);
+		if (ConfigPtr->role == TSYNC_ROLE_MASTER)
+		{
+			state->synced = 1u;
+		}
+		state->config = ConfigPtr;
+
+		return TSYNC_OK;
+}
+
+/*!
+ * @brief Sends SYNC when the period elapsed, on a master.
+ *
+ * SYNC carries the seconds of the master time; a SYNC whose transmission did not complete
+ * within one period is given up.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @return void.
+ */
+void Tsync_Process(unsigned char instance)
+{
+		Tsync_StateType * state;
+		Can_FrameType frame;
+		uint64 now;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (Tsync_State[instance].config == NULL) ||
+		    (Tsync_State[instance].config->role != TSYNC_ROLE_MASTER))
+		{
+			return;
+		}
+
+		state = &Tsync_State[instance];
+		now = Tsync_LocalNs(state->config);
+		if ((now - state->lastSendNs) < ((uint64)state->config->periodMs * TSYNC_NS_PER_MS))
+		{
+			return;
+		}
+		state->lastSendNs = now;
+		if (state->inFlight != 0u)
+		{
+			state->inFlight = 0u;
+			state->lost++;
+		}
+
+		state->seq++;
+		state->syncSeconds = (unsigned int)(Tsync_Extrapolate(now, state->refLocal, state->refMaster, 0) / TSYNC_NS_PER_SECOND);
+		Tsync_Build(&frame, state->config->syncId, state->seq, state->syncSeconds);
+		state->inFlight = 1u;
+		if (Can_Send(instance, &frame) != CAN_OK)
+		{
+			state->inFlight = 0u;
+			state->lost++;
+		}
+}
+
+/*!
+ * @brief Receive callback, to be called for every frame of the instance.
+ *
+ * On a slave, SYNC is converted to local time at once and kept until its FOLLOW_UP brings the
+ * master time of the same instant.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] FramePtr Received frame.
+ * @return void.
+ */
+void Tsync_OnRx(unsigned char instance, const Can_FrameType * FramePtr)
+{
+		Tsync_StateType * state;
+		uint64 master;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (FramePtr == NULL) || (Tsync_State[instance].config == NULL) ||
+		    (Tsync_State[instance].config->role != TSYNC_ROLE_SLAVE) ||
+		    (FramePtr->extended != 0u) || (FramePtr->length < TSYNC_MSG_LENGTH))
+		{
+			return;
+		}
+
+		state = &Tsync_State[instance];
+		if (FramePtr->id == state->config->syncId)
+		{
+			state->pendLocal = Tsync_Capture(state, FramePtr->timestamp);
+			state->pendSeq = FramePtr->data[TSYNC_MSG_SEQ];
+			state->pendSeconds = Tsync_GetWord(&FramePtr->data[TSYNC_MSG_VALUE]);
+			state->pendValid = 1u;
+		}
+		else if (FramePtr->id == state->config->followUpId)
+		{
+			if ((state->pendValid == 0u) || (state->pendSeq != FramePtr->data[TSYNC_MSG_SEQ]))
+			{
+				state->lost++;
+				return;
+			}
+			state->pendValid = 0u;
+			master = ((uint64)state->pendSeconds * TSYNC_NS_PER_SECOND) +
+			         Tsync_GetWord(&FramePtr->data[TSYNC_MSG_VALUE]) + state->config->delayNs;
+			Tsync_Apply(state, state->pendLocal, master);
+		}
+		else
+		{
+			/* Not a time synchronization frame */
+		}
+}
+
+/*!
+ * @brief Transmit complete callback, to be called for every frame of the instance.
+ *
+ * On a master, the transmit time stamp of SYNC gives the master time of the instant the slaves
+ * captured, sent right away in FOLLOW_UP as nanoseconds from the seconds of SYNC.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] id Identifier of the frame.
+ * @param[in] timestamp Transmit time stamp.
+ * @return void.
+ */
+void Tsync_OnTx(unsigned char instance, unsigned int id, unsigned short timestamp)
+{
+		Tsync_StateType * state;
+		Can_FrameType frame;
+		uint64 master;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (Tsync_State[instance].config == NULL) ||
+		    (Tsync_State[instance].config->role != TSYNC_ROLE_MASTER) ||
+		    (id != Tsync_State[instance].config->syncId) || (Tsync_State[instance].inFlight == 0u))
+		{
+			return;
+		}
+
+		state = &Tsync_State[instance];
+		master = Tsync_Extrapolate(Tsync_Capture(state, timestamp), state->refLocal, state->refMaster, 0);
+		Tsync_Build(&frame, state->config->followUpId, state->seq,
+		            (unsigned int)(master - ((uint64)state->syncSeconds * TSYNC_NS_PER_SECOND)));
+		state->inFlight = 0u;
+		if (Can_Send(instance, &frame) == CAN_OK)
+		{
+			state->syncs++;
+		}
+		else
+		{
+			state->lost++;
+		}
+}
+
+/*!
+ * @brief Retrieves the synchronized time.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] NsPtr Nanoseconds since the epoch of the master.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA, TSYNC_ERR_NOT_SYNCED or TSYNC_ERR_TIMEOUT on error;
+ *         *NsPtr is valid with TSYNC_OK and TSYNC_ERR_TIMEOUT.
+ */
+Tsync_ret_t Tsync_GetTime(unsigned char instance, uint64 * NsPtr)
+{
+		Tsync_StateType * state;
+		unsigned int seq;
+		uint64 refLocal;
+		uint64 refMaster;
+		uint64 local;
+		int ratePpb;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (NsPtr == NULL) || (Tsync_State[instance].config == NULL))
+		{
+			return TSYNC_ERR_PARA;
+		}
+
+		state = &Tsync_State[instance];
+		if (state->synced == 0u)
+		{
+			return TSYNC_ERR_NOT_SYNCED;
+		}
+
+		/* Retry when a sync updated the reference during the read */
+		do
+		{
+			seq = state->sequence;
+			refLocal = state->refLocal;
+			refMaster = state->refMaster;
+			ratePpb = state->ratePpb;
+			local = Tsync_LocalNs(state->config);
+		} while ((seq & 1u) || (seq != state->sequence));
+
+		*NsPtr = Tsync_Extrapolate(local, refLocal, refMaster, ratePpb);
+		if ((state->config->role == TSYNC_ROLE_SLAVE) && (state->config->timeoutMs != 0u) &&
+		    ((local - refLocal) > ((uint64)state->config->timeoutMs * TSYNC_NS_PER_MS)))
+		{
+			return TSYNC_ERR_TIMEOUT;
+		}
+
+		return TSYNC_OK;
+}
+
+/*!
+ * @brief Sets the time of a master.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[in] ns Nanoseconds since the epoch.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error or on a slave.
+ */
+Tsync_ret_t Tsync_SetTime(unsigned char instance, uint64 ns)
+{
+		Tsync_StateType * state;
+
+		if ((instance >= CAN_INSTANCE_COUNT) || (Tsync_State[instance].config == NULL) ||
+		    (Tsync_State[instance].config->role != TSYNC_ROLE_MASTER))
+		{
+			return TSYNC_ERR_PARA;
+		}
+
+		/* A SYNC in flight carries the old seconds, so its FOLLOW_UP is not sent */
+		state = &Tsync_State[instance];
+		state->inFlight = 0u;
+		Tsync_SetReference(state, Tsync_LocalNs(state->config), ns, 0);
+
+		return TSYNC_OK;
+}
+
+/*!
+ * @brief Retrieves the statistics of an instance.
+ *
+ * @param[in] instance FlexCAN instance (0-2).
+ * @param[out] StatsPtr Pointer to the statistics structure.
+ * @return TSYNC_OK on success, TSYNC_ERR_PARA on parameter error.
+ */
+Tsync_ret_t Tsync_GetStats(unsigned char instance, Tsync_StatsType * StatsPtr)
+{
+		Tsync_StateType * state;
+
+		if ((StatsPtr == NULL) || (instance >= CAN_INSTANCE_COUNT))
+		{
+			return TSYNC_ERR_PARA;
+		}
+
+		state = &Tsync_State[instance];
+		StatsPtr->syncs = state->syncs;
+		StatsPtr->lost = state->lost;
+		StatsPtr->lastOffsetNs = state->lastOffsetNs;
+		StatsPtr->worstOffsetNs = state->worstOffsetNs;
+		StatsPtr->ratePpb = state->ratePpb;
+
+		return TSYNC_OK;
+}
@@ -0,0 +1,351 @@
+/****************************************************************************************************
+* @file    alarmbench.c
+* @author  Ma Hien Nhan
+* @brief   Host benchmark of the alarm scheduler (Alarm) against a scan of every alarm each second.
+* @details This file loads the scheduler with 256 alarms, a quarter of each type: weekday alarms
+*          with random masks and times of day, intervals of 1 s to 1 h, and one-shot and countdown
+*          alarms that add a new one of their kind when they fire. One week is run with one
+*          Alarm_Process() call per second. The same alarms run in a reference that checks every
+*          alarm each second, the approach the scheduler replaces, and both must fire every alarm
+*          the same number of times at the same seconds. The report gives the time per second of
+*          both, the time per second when nothing is due, and the time of Alarm_Add() plus
+*          Alarm_Remove() at 16 to 256 alarms; in the worst case it grows with log n. Build and run from the
+*          repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o alarmbench
+*                  Tools/alarmbench.c Middleware/src/Alarm.c
+*              ./alarmbench [days]
+* @version 1.0.0
+* @date    2024-10-20
+* @note    Host times only compare the two designs and the growth with n.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Alarm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define BENCH_START                     (1730419200u)      /* 2024-11-01 00:00:00, a Friday */
+#define BENCH_DEFAULT_DAYS              (7u)
+#define BENCH_ALARMS                    (ALARM_MAX_COUNT)
+#define BENCH_INTERVAL_MAX              (3600u)            /* Longest interval */
+#define BENCH_COUNTDOWN_MAX             (7200u)            /* Longest countdown */
+#define BENCH_ONE_SHOT_MAX              (86400u)           /* Latest one-shot, from now */
+#define BENCH_OPS                       (200000u)          /* Add and remove pairs per size */
+#define BENCH_IDLE_CALLS                (10000000u)        /* Alarm_Process() calls with nothing due */
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   One alarm of the load, with its count in both schedulers.
+ */
+typedef struct
+{
+			Alarm_type_t      type;
+			unsigned int      time;             /* Weekday: time of day, interval: period */
+			unsigned char     mask;
+			unsigned int      refNext;          /* Reference: next fire, 0 for weekday alarms */
+			unsigned int      fires;            /* Heap scheduler */
+			unsigned long long fireSum;
+			unsigned int      refFires;         /* Reference */
+			unsigned long long refFireSum;
+} Bench_AlarmType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static Bench_AlarmType Bench_Alarm[BENCH_ALARMS];
+static unsigned int    Bench_Now;
+static unsigned int    Bench_Compares;                      /* setCompare calls */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Host monotonic time in nanoseconds.
+ */
+static double Bench_Ns(void)
+{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+/*!
+ * @brief Deterministic delay of the n-th re-added alarm of a tag, the same in both schedulers.
+ */
+static unsigned int Bench_Delay(unsigned int tag, unsigned int n, unsigned int max)
+{
+		unsigned int h = (tag * 2654435761u) ^ (n * 40503u) ^ 0x9E3779B9u;
+
+		h ^= h >> 15;
+		h *= 2246822519u;
+		h ^= h >> 13;
+		return 1u + (h % max);
+}
+
+/*!
+ * @brief Delay of the next one-shot or countdown alarm of a tag.
+ */
+static unsigned int Bench_NextDelay(unsigned int tag, unsigned int n)
+{
+		return Bench_Delay(tag, n, (Bench_Alarm[tag].type == ALARM_TYPE_ONE_SHOT) ?
+		                   BENCH_ONE_SHOT_MAX : BENCH_COUNTDOWN_MAX);
+}
+
+static void Bench_SetCompare(unsigned int fireTime)
+{
+		(void)fireTime;
+		Bench_Compares++;
+}
+
+/*!
+ * @brief Adds the alarm of a tag to the heap scheduler; one-shot and countdown use their n-th delay.
+ */
+static void Bench_Add(unsigned int tag, unsigned int n);
+
+static void Bench_Fire(unsigned short id, void * userData)
+{
+		unsigned int tag = (unsigned int)(size_t)userData;
+		Bench_AlarmType * a = &Bench_Alarm[tag];
+
+		(void)id;
+		a->fires++;
+		a->fireSum += Bench_Now;
+		if ((a->type == ALARM_TYPE_ONE_SHOT) || (a->type == ALARM_TYPE_COUNTDOWN))
+		{
+			Bench_Add(tag, a->fires);
+		}
+}
+
+static void Bench_Add(unsigned int tag, unsigned int n)
+{
+		Bench_AlarmType * a = &Bench_Alarm[tag];
+		Alarm_EntryType entry;
+		unsigned short id;
+
+		entry.type = a->type;
+		entry.time = a->time;
+		entry.weekdayMask = a->mask;
+		entry.callback = Bench_Fire;
+		entry.userData = (void *)(size_t)tag;
+		if (a->type == ALARM_TYPE_ONE_SHOT)
+		{
+			entry.time = Bench_Now + Bench_NextDelay(tag, n);
+		}
+		else if (a->type == ALARM_TYPE_COUNTDOWN)
+		{
+			entry.time = Bench_NextDelay(tag, n);
+		}
+		if (Alarm_Add(&entry, &id) != ALARM_OK)
+		{
+			printf("FAIL: Alarm_Add of alarm %u\n", tag);
+			exit(1);
+		}
+}
+
+/*!
+ * @brief Reference: checks every alarm, every second.
+ */
+static void Bench_RefSecond(unsigned int now)
+{
+		unsigned int tag;
+
+		for (tag = 0u; tag < BENCH_ALARMS; tag++)
+		{
+			Bench_AlarmType * a = &Bench_Alarm[tag];
+			unsigned int fire = 0u;
+
+			if (a->type == ALARM_TYPE_WEEKDAY)
+			{
+				unsigned int weekday = ((now / ALARM_SECONDS_PER_DAY) + ALARM_EPOCH_WEEKDAY) % ALARM_DAYS_PER_WEEK;
+				fire = (((now % ALARM_SECONDS_PER_DAY) == a->time) && (((a->mask >> weekday) & 1u) != 0u)) ? 1u : 0u;
+			}
+			else if (now >= a->refNext)
+			{
+				fire = 1u;
+				if (a->type == ALARM_TYPE_INTERVAL)
+				{
+					a->refNext += a->time;
+				}
+				else
+				{
+					a->refNext = now + Bench_NextDelay(tag, a->refFires + 1u);
+				}
+			}
+			if (fire != 0u)
+			{
+				a->refFires++;
+				a->refFireSum += now;
+			}
+		}
+}
+
+/*!
+ * @brief Time of one Alarm_Add() plus one Alarm_Remove() with n alarms in the heap.
+ *
+ * Random times move an alarm by about one level on average. In the worst case the new alarm is
+ * the earliest, so it sifts up to the root, and removing it sifts the last alarm down again:
+ * both cross every level of the heap.
+ */
+static double Bench_AddRemove(unsigned int n, unsigned int worst)
+{
+		static const Alarm_ConfigType config = { NULL };
+		static unsigned short ids[BENCH_ALARMS];
+		Alarm_EntryType entry = { ALARM_TYPE_ONE_SHOT, 0u, 0u, { 0u, 0u, 0u }, NULL, NULL };
+		unsigned int i;
+		double start;
+
+		(void)Alarm_Init(&config, BENCH_START);
+		for (i = 0u; i < n; i++)
+		{
+			entry.time = BENCH_START + Bench_Delay(i, 0u, 1000000u);
+			(void)Alarm_Add(&entry, &ids[i]);
+		}
+
+		start = Bench_Ns();
+		if (worst != 0u)
+		{
+			for (i = 0u; i < BENCH_OPS; i++)
+			{
+				unsigned short id;
+				entry.time = BENCH_START;
+				(void)Alarm_Add(&entry, &id);
+				(void)Alarm_Remove(id);
+			}
+		}
+		else
+		{
+			for (i = 0u; i < BENCH_OPS; i++)
+			{
+				unsigned int k = Bench_Delay(i, n, n) - 1u;
+				(void)Alarm_Remove(ids[k]);
+				entry.time = BENCH_START + Bench_Delay(i, 1u, 1000000u);
+				(void)Alarm_Add(&entry, &ids[k]);
+			}
+		}
+		return (Bench_Ns() - start) / BENCH_OPS;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const Alarm_ConfigType config = { Bench_SetCompare };
+		unsigned int days = (argc > 1) ? (unsigned int)atoi(argv[1]) : BENCH_DEFAULT_DAYS;
+		unsigned int seconds = days * ALARM_SECONDS_PER_DAY;
+		unsigned int tag;
+		unsigned int s;
+		unsigned int next;
+		unsigned int fired = 0u;
+		unsigned int mismatch = 0u;
+		double heapNs;
+		double refNs;
+		double idleNs = 0.0;
+		double start;
+		unsigned int n;
+
+		srand(1u);
+		Bench_Now = BENCH_START;
+		(void)Alarm_Init(&config, BENCH_START);
+
+		/* 1. The load: a quarter of each type */
+		for (tag = 0u; tag < BENCH_ALARMS; tag++)
+		{
+			Bench_AlarmType * a = &Bench_Alarm[tag];
+
+			a->type = (Alarm_type_t)(tag % 4u);
+			switch (a->type)
+			{
+				case ALARM_TYPE_WEEKDAY:
+					a->time = (unsigned int)rand() % ALARM_SECONDS_PER_DAY;
+					a->mask = (unsigned char)(1u + ((unsigned int)rand() % ALARM_EVERY_DAY));
+					break;
+				case ALARM_TYPE_INTERVAL:
+					a->time = 1u + ((unsigned int)rand() % BENCH_INTERVAL_MAX);
+					a->refNext = BENCH_START + a->time;
+					break;
+				default:
+					a->refNext = BENCH_START + Bench_NextDelay(tag, 0u);
+					break;
+			}
+			Bench_Add(tag, 0u);
+		}
+
+		/* 2. Heap scheduler, one call per second */
+		start = Bench_Ns();
+		for (s = 1u; s <= seconds; s++)
+		{
+			Bench_Now = BENCH_START + s;
+			Alarm_Process(Bench_Now);
+		}
+		heapNs = (Bench_Ns() - start) / seconds;
+
+		/* A second with nothing due, the second before the next fire */
+		if (Alarm_GetNextFireTime(&next) == ALARM_OK)
+		{
+			start = Bench_Ns();
+			for (s = 0u; s < BENCH_IDLE_CALLS; s++)
+			{
+				Alarm_Process(next - 1u);
+			}
+			idleNs = (Bench_Ns() - start) / BENCH_IDLE_CALLS;
+		}
+
+		/* 3. Reference over the same first period */
+		start = Bench_Ns();
+		for (s = 1u; s <= seconds; s++)
+		{
+			Bench_RefSecond(BENCH_START + s);
+		}
+		refNs = (Bench_Ns() - start) / seconds;
+
+		/* 4. Both must fire every alarm at the same seconds */
+		for (tag = 0u; tag < BENCH_ALARMS; tag++)
+		{
+			Bench_AlarmType * a = &Bench_Alarm[tag];
+			fired += a->fires;
+			if ((a->fires != a->refFires) || (a->fireSum != a->refFireSum))
+			{
+				if (mismatch < 5u)
+				{
+					printf("alarm %u type %u: %u fires, reference %u\n", tag, (unsigned int)a->type,
+					       a->fires, a->refFires);
+				}
+				mismatch++;
+			}
+		}
+
+		printf("Alarms            : %u, %u days, %u fires, %u compare updates\n",
+		       BENCH_ALARMS, days, fired, Bench_Compares);
+		printf("Per second        : heap %.1f ns, scan of every alarm %.1f ns (%.1fx)\n",
+		       heapNs, refNs, refNs / heapNs);
+		printf("Nothing due       : heap %.1f ns\n", idleNs);
+		printf("Add + remove      : n     random    worst\n");
+		for (n = 16u; n <= BENCH_ALARMS; n <<= 1)
+		{
+			printf("                    %-5u %5.1f ns %5.1f ns\n", n, Bench_AddRemove(n, 0u), Bench_AddRemove(n - 1u, 1u));
+		}
+
+		if (mismatch != 0u)
+		{
+			printf("FAIL: %u alarms fired differently from the reference\n", mismatch);
+			return 1;
+		}
+		printf("PASS\n");
+		return 0;
+}
@@ -0,0 +1,412 @@
+/****************************************************************************************************
+* @file    bootsim.c
+* @author  Ma Hien Nhan
+* @brief   Host simulation of the boot time with the non-blocking clock manager (ClockMgr).
+* @details This file replaces the SCG accessors used by ClockMgr.c with a model of the oscillator
+*          start-up, the PLL lock and the system clock switch, and runs the same boot work twice:
+*          once after the blocking sequence (Clock_SetScgSoscConfig, Clock_SetScgSpllConfig, then
+*          the RUN switch, all busy waiting) and once on FIRC while ClockMgr_Process() brings the
+*          SPLL up between 10k-cycle slices of the work. The report gives the time from reset to
+*          the first frame on the display and to the final clock, for a nominal, a slow and a dead
+*          crystal. Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o bootsim
+*                  Tools/bootsim.c Driver/src/ClockMgr.c
+*              ./bootsim
+* @version 1.0.0
+* @date    2024-10-24
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "ClockMgr.h"
+#include <stdio.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_FIRC_HZ                     (48000000ull)      /* Reset clock */
+#define SIM_SPLL_HZ                     (80000000ull)      /* Target clock */
+#define SIM_SPLL_LOCK_NS                (1000000ull)       /* PLL lock time */
+#define SIM_SWITCH_NS                   (2000ull)          /* RUN clock switch */
+#define SIM_POLL_NS                     (100ull)           /* One iteration of a busy-wait loop */
+#define SIM_WAIT_POLL_NS                (100000ull)        /* Main loop period while the boot waits */
+#define SIM_SLICE_CYCLES                (10000ull)         /* Work between two ClockMgr_Process() */
+#define SIM_HANG_NS                     (1000000000ull)    /* A busy wait this long never ends */
+#define SIM_NEVER                       (~0ull)
+
+#define SIM_SOSC_TIMEOUT_MS             (30u)
+#define SIM_SPLL_TIMEOUT_MS             (5u)
+#define SIM_SWITCH_TIMEOUT_MS           (1u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   One boot step: CPU work in cycles, or a wait in nanoseconds.
+ */
+typedef struct
+{
+			const char *                     name;
+			unsigned long long               cycles;           /*!< Work at the current core clock */
+			unsigned long long               waitNs;           /*!< Time the step waits for a device */
+} Sim_StepType;
+
+/**
+ * @brief   Crystal scenario.
+ */
+typedef struct
+{
+			const char *                     name;
+			unsigned long long               soscStartNs;      /*!< SIM_NEVER for a dead crystal */
+} Sim_ScenarioType;
+
+/**
+ * @brief   Result of one boot.
+ */
+typedef struct
+{
+			unsigned long long               displayNs;        /*!< Reset to the first frame */
+			unsigned long long               clockNs;          /*!< Reset to the final clock */
+			system_clock_source_t            source;
+} Sim_ResultType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Sim_StepType Sim_Steps[] =
+{
+			{ "ports and GPIO",             20000ull,    0ull         },
+			{ "LPUART and log",             30000ull,    0ull         },
+			{ "Kv mount",                   600000ull,   0ull         },
+			{ "display reset",              0ull,        10000000ull  },
+			{ "display controller init",    200000ull,   0ull         },
+			{ "first frame",                1500000ull,  0ull         },
+};
+
+static const Sim_ScenarioType Sim_Scenarios[] =
+{
+			{ "nominal crystal (4 ms)",     4000000ull   },
+			{ "slow crystal (20 ms)",       20000000ull  },
+			{ "dead crystal",               SIM_NEVER    },
+};
+
+static const Scg_Sosc_ConfigType Sim_SoscConfig = { SCG_RANGE_HCS, SCG_CLOCK_DIV_BY_1, SCG_CLOCK_DIV_BY_1 };
+static const Scg_Spll_ConfigType Sim_SpllConfig = { 0u, 4u, CLOCKMGR_SPLL_SRC_SOSC, SCG_CLOCK_DIV_BY_1, SCG_CLOCK_DIV_BY_1 };
+static const Scg_RunMode_ConfigType Sim_TargetConfig =
+{
+			SPLL_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_1, SLOW_CLK_DIV_BY_3, SCG_CLOCK_DIV_BY_1, SCG_CLOCK_DIV_BY_1
+};
+static const Scg_RunMode_ConfigType Sim_FallbackConfig =
+{
+			FIRC_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_1, SLOW_CLK_DIV_BY_1, SCG_CLOCK_DIV_BY_1, SCG_CLOCK_DIV_BY_1
+};
+
+/*** Model state ***/
+static unsigned long long Sim_Now;                     /* Time since reset in ns */
+static unsigned long long Sim_SoscStartNs;             /* Start-up time of the crystal in this run */
+static unsigned long long Sim_SoscOnAt;                /* SIM_NEVER while disabled */
+static unsigned long long Sim_SpllOnAt;
+static unsigned long long Sim_SwitchAt;
+static system_clock_source_t Sim_Source;
+static system_clock_source_t Sim_Pending;
+static unsigned int Sim_Notified;
+static ClockMgr_state_t Sim_NotifiedState;
+static unsigned long long Sim_NotifiedNs;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Completes a pending clock switch once its time has come.
+ */
+static void Sim_Update(void)
+{
+		if ((Sim_SwitchAt != SIM_NEVER) && (Sim_Now >= Sim_SwitchAt))
+		{
+			Sim_Source = Sim_Pending;
+			Sim_SwitchAt = SIM_NEVER;
+		}
+}
+
+/*!
+ * @brief Runs the CPU for a number of cycles at the current core clock.
+ */
+static void Sim_Run(unsigned long long cycles)
+{
+		unsigned long long hz = (Sim_Source == SPLL_CLK) ? SIM_SPLL_HZ : SIM_FIRC_HZ;
+
+		Sim_Now += (cycles * 1000000000ull) / hz;
+		Sim_Update();
+}
+
+/*!
+ * @brief Advances the time without CPU work.
+ */
+static void Sim_Wait(unsigned long long ns)
+{
+		Sim_Now += ns;
+		Sim_Update();
+}
+
+/*!
+ * @brief Millisecond time base, as SysTick would give it.
+ */
+static unsigned int Sim_Ms(void)
+{
+		return (unsigned int)(Sim_Now / 1000000ull);
+}
+
+/*!
+ * @brief ClockMgr completion notification.
+ */
+static void Sim_Notify(ClockMgr_state_t state, ClockMgr_fault_t fault)
+{
+		(void)fault;
+		Sim_Notified++;
+		Sim_NotifiedState = state;
+		Sim_NotifiedNs = Sim_Now;
+}
+
+/*!
+ * @brief Power-on reset: FIRC running, SOSC and SPLL off.
+ */
+static void Sim_Reset(const Sim_ScenarioType * ScenarioPtr)
+{
+		Sim_Now = 0u;
+		Sim_SoscStartNs = ScenarioPtr->soscStartNs;
+		Sim_SoscOnAt = SIM_NEVER;
+		Sim_SpllOnAt = SIM_NEVER;
+		Sim_SwitchAt = SIM_NEVER;
+		Sim_Source = FIRC_CLK;
+		Sim_Pending = FIRC_CLK;
+		Sim_Notified = 0u;
+		Sim_NotifiedState = CLOCKMGR_STATE_IDLE;
+		Sim_NotifiedNs = SIM_NEVER;
+}
+
+/*!
+ * @brief Boot with the blocking sequence. Returns 0 when a busy wait never ends.
+ */
+static unsigned char Sim_BootBlocking(Sim_ResultType * ResultPtr)
+{
+		unsigned int i;
+
+		Clock_EnableScgSosc(&Sim_SoscConfig);
+		while (Clock_IsScgSoscValid() == 0u)
+		{
+			Sim_Wait(SIM_POLL_NS);
+			if (Sim_Now > SIM_HANG_NS)
+			{
+				return 0u;
+			}
+		}
+		Clock_EnableScgSpll(&Sim_SpllConfig);
+		while (Clock_IsScgSpllValid() == 0u)
+		{
+			Sim_Wait(SIM_POLL_NS);
+		}
+		Clock_WriteScgRunModeConfig(&Sim_TargetConfig);
+		while (Clock_GetSysClockSource() != SPLL_CLK)
+		{
+			Sim_Wait(SIM_POLL_NS);
+		}
+		ResultPtr->clockNs = Sim_Now;
+
+		for (i = 0u; i < (sizeof(Sim_Steps) / sizeof(Sim_Steps[0])); i++)
+		{
+			Sim_Run(Sim_Steps[i].cycles);
+			Sim_Wait(Sim_Steps[i].waitNs);
+		}
+		ResultPtr->displayNs = Sim_Now;
+		ResultPtr->source = Sim_Source;
+		return 1u;
+}
+
+/*!
+ * @brief Boot on FIRC while ClockMgr brings the SPLL up between slices of the work.
+ */
+static unsigned char Sim_BootManaged(Sim_ResultType * ResultPtr, const ClockMgr_ConfigType * ConfigPtr)
+{
+		unsigned int i;
+		ClockMgr_state_t state;
+
+		if (ClockMgr_Start(ConfigPtr, Sim_Ms()) != CLOCKMGR_OK)
+		{
+			return 0u;
+		}
+
+		for (i = 0u; i < (sizeof(Sim_Steps) / sizeof(Sim_Steps[0])); i++)
+		{
+			unsigned long long left = Sim_Steps[i].cycles;
+			unsigned long long waitEnd = 0u;
+
+			while (left != 0u)
+			{
+				unsigned long long slice = (left < SIM_SLICE_CYCLES) ? left : SIM_SLICE_CYCLES;
+				Sim_Run(slice);
+				left -= slice;
+				(void)ClockMgr_Process(Sim_Ms());
+			}
+			waitEnd = Sim_Now + Sim_Steps[i].waitNs;
+			while (Sim_Now < waitEnd)
+			{
+				Sim_Wait(((waitEnd - Sim_Now) < SIM_WAIT_POLL_NS) ? (waitEnd - Sim_Now) : SIM_WAIT_POLL_NS);
+				(void)ClockMgr_Process(Sim_Ms());
+			}
+		}
+		ResultPtr->displayNs = Sim_Now;
+
+		/* The main loop keeps calling ClockMgr_Process() after the boot */
+		state = ClockMgr_GetState();
+		while ((state != CLOCKMGR_STATE_RUN_TARGET) && (state != CLOCKMGR_STATE_RUN_FALLBACK))
+		{
+			if (Sim_Now > SIM_HANG_NS)
+			{
+				return 0u;
+			}
+			Sim_Wait(SIM_WAIT_POLL_NS);
+			state = ClockMgr_Process(Sim_Ms());
+		}
+		ResultPtr->clockNs = Sim_NotifiedNs;
+		ResultPtr->source = Sim_Source;
+		return 1u;
+}
+
+
+/*==================================================================================================
+*                                       SCG MODEL
+==================================================================================================*/
+void Clock_EnableScgSosc(const Scg_Sosc_ConfigType * ConfigPtr)
+{
+		(void)ConfigPtr;
+		Sim_SoscOnAt = Sim_Now;
+}
+
+unsigned char Clock_IsScgSoscValid(void)
+{
+		return (unsigned char)((Sim_SoscOnAt != SIM_NEVER) && (Sim_SoscStartNs != SIM_NEVER)
+		                       && (Sim_Now >= (Sim_SoscOnAt + Sim_SoscStartNs)));
+}
+
+void Clock_DisableScgSosc(void)
+{
+		Sim_SoscOnAt = SIM_NEVER;
+}
+
+void Clock_EnableScgSpll(const Scg_Spll_ConfigType * ConfigPtr)
+{
+		(void)ConfigPtr;
+		Sim_SpllOnAt = Sim_Now;
+}
+
+unsigned char Clock_IsScgSpllValid(void)
+{
+		return (unsigned char)((Sim_SpllOnAt != SIM_NEVER) && (Clock_IsScgSoscValid() != 0u)
+		                       && (Sim_Now >= (Sim_SpllOnAt + SIM_SPLL_LOCK_NS)));
+}
+
+void Clock_DisableScgSpll(void)
+{
+		Sim_SpllOnAt = SIM_NEVER;
+}
+
+void Clock_WriteScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
+{
+		/* The SCG ignores a request for a source that is not valid */
+		if ((ConfigPtr->sys_clk_src != SPLL_CLK) || (Clock_IsScgSpllValid() != 0u))
+		{
+			Sim_Pending = ConfigPtr->sys_clk_src;
+			Sim_SwitchAt = Sim_Now + SIM_SWITCH_NS;
+		}
+}
+
+system_clock_source_t Clock_GetSysClockSource(void)
+{
+		Sim_Update();
+		return Sim_Source;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+		static const ClockMgr_ConfigType config =
+		{
+			&Sim_SoscConfig, &Sim_SpllConfig, &Sim_TargetConfig, &Sim_FallbackConfig,
+			SIM_SOSC_TIMEOUT_MS, SIM_SPLL_TIMEOUT_MS, SIM_SWITCH_TIMEOUT_MS, Sim_Notify
+		};
+		unsigned int s;
+		unsigned int fail = 0u;
+
+		printf("boot work: FIRC %llu MHz, SPLL %llu MHz, ClockMgr polled every %llu cycles\n",
+		       SIM_FIRC_HZ / 1000000ull, SIM_SPLL_HZ / 1000000ull, SIM_SLICE_CYCLES);
+		printf("%-24s %-10s %12s %12s  %s\n", "scenario", "sequence", "display ms", "clock ms", "clock");
+
+		for (s = 0u; s < (sizeof(Sim_Scenarios) / sizeof(Sim_Scenarios[0])); s++)
+		{
+			const Sim_ScenarioType * scenario = &Sim_Scenarios[s];
+			Sim_ResultType blocking = { 0u, 0u, FIRC_CLK };
+			Sim_ResultType managed = { 0u, 0u, FIRC_CLK };
+			unsigned char blockingDone;
+			unsigned char managedDone;
+
+			Sim_Reset(scenario);
+			blockingDone = Sim_BootBlocking(&blocking);
+			if (blockingDone != 0u)
+			{
+				printf("%-24s %-10s %12.3f %12.3f  %s\n", scenario->name, "blocking",
+				       (double)blocking.displayNs * 1e-6, (double)blocking.clockNs * 1e-6,
+				       (blocking.source == SPLL_CLK) ? "SPLL" : "FIRC");
+			}
+			else
+			{
+				printf("%-24s %-10s %12s %12s  %s\n", scenario->name, "blocking", "never", "never", "hangs");
+			}
+
+			Sim_Reset(scenario);
+			managedDone = Sim_BootManaged(&managed, &config);
+			if (managedDone != 0u)
+			{
+				printf("%-24s %-10s %12.3f %12.3f  %s\n", "", "ClockMgr",
+				       (double)managed.displayNs * 1e-6, (double)managed.clockNs * 1e-6,
+				       (managed.source == SPLL_CLK) ? "SPLL" : "FIRC (fallback)");
+			}
+			else
+			{
+				printf("%-24s %-10s %12s %12s  %s\n", "", "ClockMgr", "never", "never", "hangs");
+			}
+
+			/* The managed boot always ends, notifies once, and is never later than the blocking one */
+			if ((managedDone == 0u) || (Sim_Notified != 1u) || (Sim_NotifiedState != ClockMgr_GetState()))
+			{
+				fail++;
+			}
+			else if (scenario->soscStartNs == SIM_NEVER)
+			{
+				if ((managed.source != FIRC_CLK) || (ClockMgr_GetFault() != CLOCKMGR_FAULT_SOSC_TIMEOUT))
+				{
+					fail++;
+				}
+			}
+			else if ((managed.source != SPLL_CLK) || (blockingDone == 0u) || (managed.displayNs > blocking.displayNs))
+			{
+				fail++;
+			}
+		}
+
+		if (fail != 0u)
+		{
+			printf("FAIL\n");
+			return 1;
+		}
+		printf("PASS\n");
+		return 0;
+}
@@ -0,0 +1,189 @@
+/****************************************************************************************************
+* @file    calibsim.c
+* @author  Ma Hien Nhan
+* @brief   Host simulation of the clock calibration service (Calib) on a drifting oscillator.
+* @details This file runs Calib_Tick() from a simulated 1 ms SysTick clocked by an 80 MHz
+*          oscillator that is 42 ppm fast and follows the parabolic temperature curve of a crystal
+*          while the temperature swings between 5 and 45 degrees C. A 1PPS reference edge arrives
+*          every true second and is stamped with the 32-bit cycle counter after a random interrupt
+*          latency. The report compares the estimate with the true error, and the drift of the
+*          software clock from the true time once the first window corrected it, next to the same
+*          clock without correction. Build and run from the repository root:
+*              gcc -O2 -DCALIB_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o calibsim
+*                  Tools/calibsim.c Middleware/src/Calib.c -lm
+*              ./calibsim [hours]
+* @version 1.0.0
+* @date    2024-10-22
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Calib.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_CORE_HZ                     (80000000u)        /* Nominal core clock */
+#define SIM_TICK_CYCLES                 (80000u)           /* SysTick reload, 1 ms nominal */
+#define SIM_TICK_NS                     (1000000u)
+#define SIM_OFFSET_PPB                  (42000.0)          /* Error at the turnover temperature */
+#define SIM_CURVE_PPB                   (-34.0)            /* Per degree squared from the turnover */
+#define SIM_TURNOVER_C                  (25.0)
+#define SIM_SWING_C                     (20.0)             /* Temperature 25 +- 20 degrees */
+#define SIM_SWING_PERIOD_S              (21600.0)          /* One swing every 6 hours */
+#define SIM_LATENCY_CYCLES              (24u)              /* Largest reference interrupt latency */
+#define SIM_WINDOW_EDGES                (16u)
+#define SIM_FILTER_SHIFT                (2u)
+#define SIM_SETTLE_S                    (120u)             /* Excluded from the error statistics */
+#define SIM_DEFAULT_HOURS               (24u)
+
+/*** Pass limits ***/
+#define SIM_LIMIT_PPB                   (600.0)            /* Estimate against the true error */
+#define SIM_LIMIT_US                    (1000.0)           /* Drift of the software clock once settled */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief True oscillator error at a true time.
+ */
+static double Sim_Ppb(double t)
+{
+		double temp = SIM_TURNOVER_C + (SIM_SWING_C * sin((2.0 * M_PI * t) / SIM_SWING_PERIOD_S));
+		double dt = temp - SIM_TURNOVER_C;
+
+		return SIM_OFFSET_PPB + (SIM_CURVE_PPB * dt * dt);
+}
+
+/*!
+ * @brief Software clock in seconds.
+ */
+static double Sim_Clock(void)
+{
+		unsigned int seconds;
+		unsigned int ns;
+
+		Calib_GetTime(&seconds, &ns);
+		return (double)seconds + ((double)ns * 1e-9);
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const Calib_ConfigType config =
+		{
+			CALIB_REF_1PPS, SIM_CORE_HZ, 1u, SIM_WINDOW_EDGES, SIM_TICK_NS, SIM_FILTER_SHIFT, { 0u, 0u, 0u }
+		};
+		unsigned int hours = (argc > 1) ? (unsigned int)atoi(argv[1]) : SIM_DEFAULT_HOURS;
+		unsigned long long ticks = (unsigned long long)hours * 3600000ull;
+		unsigned long long k;
+		unsigned long long cycles = 0u;               /* Oscillator cycles since the start */
+		unsigned int nextEdge = 1u;                   /* True second of the next reference edge */
+		double t = 0.0;                               /* True time of the last tick */
+		double estErrMax = 0.0;
+		double estErrSum2 = 0.0;
+		double clockErrMax = 0.0;
+		double clockErr = 0.0;
+		double lockErr = 0.0;                         /* Clock error at the end of the settling */
+		double rawErr = 0.0;
+		double rawErrMax = 0.0;
+		double ppbMin = 1e9;
+		double ppbMax = -1e9;
+		unsigned int samples = 0u;
+		unsigned int rejected = 0u;
+
+		srand(1u);
+		if (Calib_Init(&config) != CALIB_OK)
+		{
+			printf("FAIL: Calib_Init\n");
+			return 1;
+		}
+
+		for (k = 1u; k <= ticks; k++)
+		{
+			/* 1. True length of this tick, at the frequency of its midpoint */
+			double f = (double)SIM_CORE_HZ * (1.0 + (Sim_Ppb(t + 0.0005) * 1e-9));
+			double tNext = t + ((double)SIM_TICK_CYCLES / f);
+
+			/* 2. Reference edges during the tick, stamped after the interrupt latency */
+			while ((double)nextEdge <= tNext)
+			{
+				unsigned long long stamp = cycles + (unsigned long long)(((double)nextEdge - t) * f);
+				stamp += (unsigned long long)((unsigned int)rand() % (SIM_LATENCY_CYCLES + 1u));
+				if (Calib_OnReferenceEdge((unsigned int)stamp) != CALIB_OK)
+				{
+					rejected++;
+				}
+				nextEdge++;
+			}
+
+			/* 3. The tick */
+			cycles += SIM_TICK_CYCLES;
+			t = tNext;
+			Calib_Tick();
+
+			/* 4. Once per second of software time, compare with the truth */
+			if ((k % 1000u) == 0u)
+			{
+				double truePpb = Sim_Ppb(t);
+				clockErr = Sim_Clock() - t;
+				rawErr = ((double)k * 1e-3) - t;
+				if (fabs(rawErr) > rawErrMax)
+				{
+					rawErrMax = fabs(rawErr);
+				}
+				if (truePpb < ppbMin)
+				{
+					ppbMin = truePpb;
+				}
+				if (truePpb > ppbMax)
+				{
+					ppbMax = truePpb;
+				}
+				if (t >= (double)SIM_SETTLE_S)
+				{
+					double estErr = (double)Calib_GetPpb() - truePpb;
+					if (samples == 0u)
+					{
+						lockErr = clockErr;
+					}
+					estErrSum2 += estErr * estErr;
+					samples++;
+					if (fabs(estErr) > estErrMax)
+					{
+						estErrMax = fabs(estErr);
+					}
+					if (fabs(clockErr - lockErr) > clockErrMax)
+					{
+						clockErrMax = fabs(clockErr - lockErr);
+					}
+				}
+			}
+		}
+
+		printf("%u h, 80 MHz, oscillator %+.0f to %+.0f ppb, window %u s, filter 1/%u, latency 0-%u cycles\n",
+		       hours, ppbMin, ppbMax, SIM_WINDOW_EDGES, 1u << SIM_FILTER_SHIFT, SIM_LATENCY_CYCLES);
+		printf("estimate error : rms %.1f ppb, max %.1f ppb, %u windows rejected\n",
+		       (samples != 0u) ? sqrt(estErrSum2 / samples) : 0.0, estErrMax, rejected);
+		printf("clock error    : %+.1f us after the first window, then drift max %.1f us, end %+.1f us\n",
+		       lockErr * 1e6, clockErrMax * 1e6, (clockErr - lockErr) * 1e6);
+		printf("                 uncorrected max %.1f ms, end %+.1f ms\n", rawErrMax * 1e3, rawErr * 1e3);
+
+		if ((estErrMax > SIM_LIMIT_PPB) || ((clockErrMax * 1e6) > SIM_LIMIT_US) || (rejected != 0u))
+		{
+			printf("FAIL\n");
+			return 1;
+		}
+		printf("PASS\n");
+		return 0;
+}
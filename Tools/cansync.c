@@ -0,0 +1,211 @@
+/****************************************************************************************************
+* @file    cansync.c
+* @author  Ma Hien Nhan
+* @brief   Host test of the time synchronization over CAN (Tsync) on the simulated bus.
+* @details This file puts a master on CAN0 and two slaves on CAN1 and CAN2 of the simulated bus in
+*          Can_Host.c. The node oscillators are off by up to 65 ppm, each node reads a 40 MHz
+*          local counter, the callbacks run after a random interrupt latency, and the slaves load
+*          the bus with frames of higher priority than SYNC, so SYNC waits in the queue for a
+*          random time. Every 100 us of bus time the slave times are compared with the master time
+*          at the same instant; the report gives the mean, the standard deviation and the largest
+*          error of every slave once locked, next to the injected latency. Build and run from the
+*          repository root:
+*              gcc -O2 -DCAN_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o cansync
+*                  Tools/cansync.c Middleware/src/Tsync.c Driver/src/Can_Host.c -lm
+*              ./cansync [seconds] [largest latency in us]
+* @version 1.0.0
+* @date    2024-11-14
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Tsync.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_BITRATE                     (500000u)
+#define SIM_COUNTER_HZ                  (40000000u)        /* LPIT clock */
+#define SIM_NS_PER_COUNT                (25u)
+#define SIM_SYNC_ID                     (0x100u)
+#define SIM_FOLLOW_UP_ID                (0x101u)
+#define SIM_PERIOD_MS                   (100u)
+#define SIM_TIMEOUT_MS                  (1000u)
+#define SIM_DELAY_NS                    (62u)              /* Mean receiver resynchronization lag, half a time quantum */
+#define SIM_STEP_NS                     (100000u)          /* Main loop period */
+#define SIM_WARMUP_NS                   (1000000000ull)    /* Left out of the statistics: first syncs */
+#define SIM_DEFAULT_SECONDS             (60u)
+#define SIM_DEFAULT_LATENCY_US          (20u)
+#define SIM_SLAVES                      (2u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+			unsigned int        samples;
+			double              sum;
+			double              sumSquares;
+			double              worst;
+} Sim_ErrorType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Can_FilterType Sim_Filters[] =
+{
+		{ SIM_SYNC_ID, 0x7FEu, 0u },        /* SYNC and FOLLOW_UP */
+};
+
+static Sim_ErrorType Sim_Errors[SIM_SLAVES];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static uint64 Sim_Counter0(void) { return Can_HostNodeNs(0u) / SIM_NS_PER_COUNT; }
+static uint64 Sim_Counter1(void) { return Can_HostNodeNs(1u) / SIM_NS_PER_COUNT; }
+static uint64 Sim_Counter2(void) { return Can_HostNodeNs(2u) / SIM_NS_PER_COUNT; }
+
+/*!
+ * @brief Sends a load frame when its period elapsed.
+ */
+static void Sim_Load(unsigned char instance, unsigned int id, uint64 periodNs, uint64 * NextPtr)
+{
+		Can_FrameType frame = { 0u };
+
+		if (Can_HostNow() < *NextPtr)
+		{
+			return;
+		}
+		*NextPtr += periodNs;
+		frame.id = id;
+		frame.length = 8u;
+		(void)Can_Send(instance, &frame);
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char * argv[])
+{
+		unsigned int seconds = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : SIM_DEFAULT_SECONDS;
+		unsigned int latencyUs = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 0) : SIM_DEFAULT_LATENCY_US;
+		Can_ConfigType can[CAN_INSTANCE_COUNT];
+		Tsync_ConfigType sync[CAN_INSTANCE_COUNT];
+		Tsync_CounterType counters[CAN_INSTANCE_COUNT] = { Sim_Counter0, Sim_Counter1, Sim_Counter2 };
+		Tsync_StatsType stats;
+		Can_StatsType canStats;
+		Sim_ErrorType * error;
+		uint64 masterNs;
+		uint64 slaveNs;
+		uint64 nextLoad1 = 0u;
+		uint64 nextLoad2 = 0u;
+		uint64 end = (uint64)seconds * 1000000000ull;
+		double value;
+		double mean;
+		unsigned char instance;
+		int failed = 0;
+
+		Can_HostSetNode(0u, 0, 0u);
+		Can_HostSetNode(1u, 40000, 123456789ull);
+		Can_HostSetNode(2u, -65000, 987654321000ull);
+		Can_HostSetLatency(latencyUs * 1000u);
+
+		for (instance = 0u; instance < CAN_INSTANCE_COUNT; instance++)
+		{
+			can[instance].instance = instance;
+			can[instance].clkSrc = CAN_CLK_SOSCDIV2;
+			can[instance].bitrate = SIM_BITRATE;
+			can[instance].loopback = 0u;
+			can[instance].rxFifo = (instance == 2u) ? 1u : 0u;
+			can[instance].filterCount = (instance == 0u) ? 0u : 1u;
+			can[instance].filters = Sim_Filters;
+			can[instance].rxCallback = Tsync_OnRx;
+			can[instance].txCallback = Tsync_OnTx;
+
+			sync[instance].instance = instance;
+			sync[instance].role = (instance == 0u) ? TSYNC_ROLE_MASTER : TSYNC_ROLE_SLAVE;
+			sync[instance].syncId = SIM_SYNC_ID;
+			sync[instance].followUpId = SIM_FOLLOW_UP_ID;
+			sync[instance].bitrate = SIM_BITRATE;
+			sync[instance].counter = counters[instance];
+			sync[instance].counterHz = SIM_COUNTER_HZ;
+			sync[instance].periodMs = SIM_PERIOD_MS;
+			sync[instance].delayNs = SIM_DELAY_NS;
+			sync[instance].timeoutMs = SIM_TIMEOUT_MS;
+
+			if ((Can_Init(&can[instance]) != CAN_OK) || (Tsync_Init(&sync[instance]) != TSYNC_OK))
+			{
+				printf("FAIL: init of instance %u\n", instance);
+				return 1;
+			}
+		}
+		(void)Tsync_SetTime(0u, 1731542400ull * 1000000000ull);
+
+		while (Can_HostNow() < end)
+		{
+			/* Higher priority traffic: SYNC waits behind it */
+			Sim_Load(1u, 0x050u, 1000000u, &nextLoad1);
+			Sim_Load(2u, 0x060u, 3000000u, &nextLoad2);
+			for (instance = 0u; instance < CAN_INSTANCE_COUNT; instance++)
+			{
+				Tsync_Process(instance);
+			}
+			Can_HostAdvance(SIM_STEP_NS);
+
+			if ((Can_HostNow() < SIM_WARMUP_NS) || (Tsync_GetTime(0u, &masterNs) != TSYNC_OK))
+			{
+				continue;
+			}
+			for (instance = 1u; instance < CAN_INSTANCE_COUNT; instance++)
+			{
+				error = &Sim_Errors[instance - 1u];
+				if (Tsync_GetTime(instance, &slaveNs) != TSYNC_OK)
+				{
+					printf("FAIL: slave %u not synchronized at %.3f s\n", instance, (double)Can_HostNow() / 1e9);
+					return 1;
+				}
+				value = (double)(int64)(slaveNs - masterNs);
+				error->samples++;
+				error->sum += value;
+				error->sumSquares += value * value;
+				if (fabs(value) > error->worst)
+				{
+					error->worst = fabs(value);
+				}
+			}
+		}
+
+		printf("bus %u bit/s, SYNC every %u ms, interrupt latency 0 - %u us, %u s\n",
+		       SIM_BITRATE, SIM_PERIOD_MS, latencyUs, seconds);
+		(void)Can_GetStats(0u, &canStats);
+		(void)Tsync_GetStats(0u, &stats);
+		printf("master: %u frames sent, %u syncs, %u lost\n", canStats.txFrames, stats.syncs, stats.lost);
+		for (instance = 1u; instance < CAN_INSTANCE_COUNT; instance++)
+		{
+			error = &Sim_Errors[instance - 1u];
+			(void)Tsync_GetStats(instance, &stats);
+			mean = error->sum / error->samples;
+			printf("slave %u: %u syncs, %u lost, rate %+d ppb, error mean %+.0f ns, std %.0f ns, max %.0f ns, "
+			       "worst at sync %u ns\n",
+			       instance, stats.syncs, stats.lost, stats.ratePpb, mean,
+			       sqrt((error->sumSquares / error->samples) - (mean * mean)), error->worst, stats.worstOffsetNs);
+			if ((stats.syncs == 0u) || (error->worst > 2000.0))
+			{
+				failed = 1;
+			}
+		}
+
+		printf("%s\n", (failed != 0) ? "FAIL" : "PASS");
+		return failed;
+}
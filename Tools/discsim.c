@@ -0,0 +1,206 @@
+/****************************************************************************************************
+* @file    discsim.c
+* @author  Ma Hien Nhan
+* @brief   Host simulation of the clock discipline loop (Discipline) steering Calib.
+* @details This file runs Calib_Tick() from a simulated 1 ms SysTick whose oscillator is 35 ppm
+*          fast, wanders by a random walk and jumps by 2 ppm at the half of the run, like a
+*          temperature change. Once a second a reference sample arrives between two ticks: the true
+*          time plus Gaussian jitter, with a few spikes tens of milliseconds late, as from a
+*          serial link. It is stamped with the software clock plus the part of the tick elapsed, as
+*          read from SYST_CVR, so that the 1 ms tick does not hide the loop. The reference is lost for 15 minutes in the middle of the run. The report
+*          gives the time to lock, the true error of the software clock once locked, the error
+*          at the end of the outage next to the estimate of the loop, and checks that the clock
+*          was stepped only once and never ran backwards. Build and run from the repository root:
+*              gcc -O2 -DCALIB_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o discsim
+*                  Tools/discsim.c Middleware/src/Discipline.c Middleware/src/Calib.c -lm
+*              ./discsim [hours] [jitter in us]
+* @version 1.0.0
+* @date    2024-11-15
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Discipline.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_TICK_NS                     (1000000u)         /* SysTick period */
+#define SIM_PPB                         (35000.0)          /* Oscillator error at the start */
+#define SIM_PPB_JUMP                    (2000.0)           /* Temperature change at the half */
+#define SIM_WANDER_PPB                  (2.0)              /* Random walk per second */
+#define SIM_EPOCH_NS                    (1731628800000000000ull) /* True time at the start */
+#define SIM_SPIKE_PERCENT               (3u)
+#define SIM_SPIKE_NS                    (50000000.0)       /* Largest spike */
+#define SIM_OUTAGE_S                    (900u)
+#define SIM_DEFAULT_HOURS               (4u)
+#define SIM_DEFAULT_JITTER_US           (100u)
+#define SIM_SETTLE_S                    (600u)             /* Left out of the locked statistics after lock */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Gaussian random number, Box-Muller.
+ */
+static double Sim_Gauss(void)
+{
+		double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+		double u2 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+		return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+/*!
+ * @brief Software clock in nanoseconds.
+ */
+static uint64 Sim_Local(void)
+{
+		unsigned int seconds;
+		unsigned int nanoseconds;
+
+		Calib_GetTime(&seconds, &nanoseconds);
+		return ((uint64)seconds * CALIB_NS_PER_SECOND) + nanoseconds;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char * argv[])
+{
+		static const Calib_ConfigType calib = { CALIB_REF_1PPS, 48000000u, 1u, 1u, SIM_TICK_NS, 0u, { 0u } };
+		static const Discipline_ConfigType config = { 64u, 100000000u, 1000000u, 10u, 4u, { 0u } };
+		unsigned int hours = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : SIM_DEFAULT_HOURS;
+		double jitterNs = 1000.0 * ((argc > 2) ? strtod(argv[2], NULL) : SIM_DEFAULT_JITTER_US);
+		double runS = 3600.0 * hours;
+		double outageStart = runS * 0.75;
+		double ppb = SIM_PPB;
+		double tickNs;
+		double elapsed = 0.0;
+		double trueNs = 0.0;                  /* True time of the last tick since SIM_EPOCH_NS */
+		double nextSample = 0.3e9;
+		double nextSecond = 1e9;
+		double error;
+		double sumSquares = 0.0;
+		double worst = 0.0;
+		double lockedAt = -1.0;
+		double sampleNs;
+		double refNs;
+		double outageError = 0.0;
+		unsigned int outageEstimate = 0u;
+		unsigned int count = 0u;
+		unsigned char jumped = 0u;
+		uint64 local;
+		uint64 lastLocal = 0u;
+		int backwards = 0;
+		int failed = 0;
+		Discipline_StatusType status;
+
+		srand(12345u);
+		(void)Calib_Init(&calib);
+		(void)Discipline_Init(&config);
+
+		for (;;)
+		{
+			/* Reference sample: taken before the next tick, stamped with the software clock plus the
+			   part of the tick elapsed, as read from SYST_CVR */
+			tickNs = (double)SIM_TICK_NS / (1.0 + (ppb * 1e-9));
+			if (((trueNs + tickNs) > nextSample) && ((elapsed < outageStart) || (elapsed >= (outageStart + SIM_OUTAGE_S))))
+			{
+				sampleNs = nextSample;
+				local = Sim_Local() + (uint64)(((sampleNs - trueNs) / tickNs) * (double)SIM_TICK_NS *
+				                               1e9 / (1e9 + (double)Calib_GetPpb()));
+				refNs = sampleNs + (jitterNs * Sim_Gauss());
+				if ((unsigned int)(rand() % 100) < SIM_SPIKE_PERCENT)
+				{
+					refNs += SIM_SPIKE_NS * ((double)rand() / (double)RAND_MAX);
+				}
+				(void)Discipline_AddSample(local, (int64)(refNs - (double)(int64)(local - SIM_EPOCH_NS)));
+			}
+			if ((trueNs + tickNs) > nextSample)
+			{
+				nextSample += 1e9;
+			}
+
+			/* One tick of the oscillator */
+			trueNs += tickNs;
+			Calib_Tick();
+			local = Sim_Local();
+			if (local < lastLocal)
+			{
+				backwards++;
+			}
+			lastLocal = local;
+			elapsed = trueNs / 1e9;
+			if (elapsed >= runS)
+			{
+				break;
+			}
+
+			/* Once a second: loop housekeeping, oscillator wander, statistics */
+			if (trueNs < nextSecond)
+			{
+				continue;
+			}
+			nextSecond += 1e9;
+			Discipline_Process();
+			ppb += SIM_WANDER_PPB * Sim_Gauss();
+			if ((jumped == 0u) && (elapsed >= (runS / 2.0)))
+			{
+				ppb += SIM_PPB_JUMP;
+				jumped = 1u;
+			}
+
+			(void)Discipline_GetStatus(&status);
+			error = (double)(int64)(local - SIM_EPOCH_NS) - trueNs;
+			if ((lockedAt < 0.0) && (status.state == DISCIPLINE_LOCKED))
+			{
+				lockedAt = elapsed;
+			}
+			if ((elapsed >= outageStart) && (elapsed < (outageStart + SIM_OUTAGE_S)))
+			{
+				outageError = error;
+				outageEstimate = status.errorNs;
+				continue;
+			}
+			if ((lockedAt >= 0.0) && (elapsed > (lockedAt + SIM_SETTLE_S)) &&
+			    ((elapsed < outageStart) || (elapsed > (outageStart + SIM_OUTAGE_S + SIM_SETTLE_S))))
+			{
+				count++;
+				sumSquares += error * error;
+				if (fabs(error) > worst)
+				{
+					worst = fabs(error);
+				}
+			}
+		}
+
+		(void)Discipline_GetStatus(&status);
+		printf("%u h, 1 ms tick, oscillator %+.0f ppb (+%.0f at %u h), sample jitter %.0f us, %u%% spikes\n",
+		       hours, SIM_PPB, SIM_PPB_JUMP, hours / 2u, jitterNs / 1000.0, SIM_SPIKE_PERCENT);
+		printf("samples %u, rejected %u, steps %u, locked after %.0f s, state %u, freq %+d ppb (true %+.0f)\n",
+		       status.samples, status.rejected, status.steps, lockedAt, (unsigned int)status.state,
+		       (int)status.freqPpb, ppb);
+		printf("locked error: rms %.1f us, max %.1f us over %u s; estimate now %.1f us, jitter %.1f us\n",
+		       sqrt(sumSquares / (count ? count : 1u)) / 1000.0, worst / 1000.0, count,
+		       (double)status.errorNs / 1000.0, (double)status.jitterNs / 1000.0);
+		printf("after %u s holdover: error %.1f us, estimate %.1f us\n",
+		       SIM_OUTAGE_S, outageError / 1000.0, (double)outageEstimate / 1000.0);
+		printf("clock ran backwards %d times\n", backwards);
+
+		if ((status.steps != 1u) || (lockedAt < 0.0) || (backwards != 0) || (worst > 500000.0) ||
+		    (fabs(outageError) > (double)outageEstimate))
+		{
+			failed = 1;
+		}
+		printf("%s\n", (failed != 0) ? "FAIL" : "PASS");
+		return failed;
+}
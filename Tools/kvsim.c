@@ -0,0 +1,589 @@
+/****************************************************************************************************
+* @file    kvsim.c
+* @author  Ma Hien Nhan
+* @brief   Host test of the settings store (Kv) on a simulated D-Flash with power cuts.
+* @details This file replaces the FTFC driver with a simulated flash. Programming a phrase that is
+*          not erased fails the test. Commands take the typical data sheet times, and the command
+*          complete callback is called when the simulated time has passed. Random writes run for a
+*          while, then the power is cut at a random time, every other time during a command. The cut
+*          leaves the phrase partly programmed or the sector partly erased. The store is then mounted
+*          again, and every key must hold a value written since the last time the store was idle.
+*          The blocking of every call is counted, not timed: flash commands launched, waits for the
+*          flash, bytes run through the CRC and bytes copied. The worst counts per function give the
+*          target cycles with the cost model below; Kv_Write() and Kv_Process() fail the test if they
+*          ever wait or launch more than one command. The test also reports the erase count of every
+*          sector and the flash time of Kv_Flush() on a low voltage warning, which comes before
+*          every other cut. Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o kvsim
+*                  Tools/kvsim.c Middleware/src/Kv.c
+*              ./kvsim [power cuts]
+* @note    The cost model is counted from the Cortex-M4 instruction timings of the loops in Kv.c,
+*          with the flash accelerator hitting; it is a bound to compare against, not a measurement.
+* @version 1.0.0
+* @date    2024-11-12
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Kv.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The CRC is counted on its way through: the library function is renamed and wrapped below */
+#define Crc16_Compute                   Sim_Crc16Compute
+#include "../Utilitie/Utilitie.c"
+#undef Crc16_Compute
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_SECTORS                     (4u)
+#define SIM_FLASH_ADDRESS               (FTFC_DFLASH_ADDRESS)
+#define SIM_FLASH_BYTES                 (SIM_SECTORS * KV_SECTOR_SIZE)
+#define SIM_PHRASE_US                   (90u)              /* Program phrase, typical */
+#define SIM_ERASE_US                    (10000u)           /* Erase 2 KB sector, typical */
+#define SIM_STEP_US                     (10u)              /* Main loop period */
+#define SIM_WRITE_PERIOD_US             (5000u)            /* Mean time between two writes */
+#define SIM_RUN_US                      (5000000u)         /* Longest run between two cuts */
+#define SIM_KEYS                        (8u)               /* Keys used by the test */
+#define SIM_KEYS_OFTEN                  (5u)               /* Keys written often */
+#define SIM_HISTORY                     (4096u)            /* Values kept per key between two idle points */
+#define SIM_DEFAULT_CUTS                (100u)
+#define SIM_FLUSH_PHRASES               (24u)              /* Kv_Flush() budget on a low voltage warning */
+
+/* Cost model, CPU cycles */
+#define SIM_CYCLES_CALL                 (80u)              /* Entry, checks, completion and job bookkeeping */
+#define SIM_CYCLES_SECTOR               (10u)              /* One sector of a state scan */
+#define SIM_CYCLES_KEY                  (6u)               /* One key of the dirty or live key scan */
+#define SIM_CYCLES_CRC_BYTE             (16u)              /* Two nibble table steps */
+#define SIM_CYCLES_COPY_BYTE            (4u)               /* Load, compare or store, loop */
+#define SIM_CYCLES_READ_BYTE            (3u)               /* Flash read of the mount scan */
+#define SIM_CYCLES_COMMAND              (60u)              /* Prepare, FCCOB address and data loads, launch */
+
+#define SIM_CALL_WRITE                  (0u)
+#define SIM_CALL_PROCESS                (1u)
+#define SIM_CALL_MOUNT                  (2u)
+#define SIM_CALL_COUNT                  (3u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+			unsigned char       length;
+			unsigned char       data[KV_VALUE_MAX];
+} Sim_ValueType;
+
+typedef struct
+{
+			unsigned int        count;                  /* Acceptable values after a cut */
+			unsigned char       absentOk;               /* Key may still be missing */
+			Sim_ValueType       values[SIM_HISTORY];
+} Sim_KeyType;
+
+typedef struct
+{
+			unsigned int        commands;               /* Program and erase commands launched */
+			unsigned int        phrases;                /* Phrases programmed */
+			unsigned int        waits;                  /* Waits for the flash */
+			unsigned int        crcBytes;               /* Bytes run through the CRC */
+			unsigned int        copyBytes;              /* Bytes compared, staged or copied */
+			unsigned int        cycles;                 /* Target cycles from the cost model */
+} Sim_CostType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned char Sim_Flash[SIM_FLASH_BYTES];
+static unsigned int Sim_EraseCount[SIM_SECTORS];
+static const Ftfc_ConfigType * Sim_FtfcConfig;
+
+/* Command in progress */
+static unsigned char Sim_Busy;
+static unsigned char Sim_IsErase;
+static unsigned int Sim_Offset;
+static unsigned char Sim_Data[FTFC_PHRASE_SIZE];
+static unsigned long long Sim_DoneAt;
+static unsigned long long Sim_Now;                      /* Simulated time, us */
+
+static Sim_KeyType Sim_Keys[SIM_KEYS];
+
+/* Counts of the call in progress and the worst counts per function */
+static Sim_CostType Sim_Call;
+static Sim_CostType Sim_Worst[SIM_CALL_COUNT];
+static unsigned char Sim_Mounting;
+static unsigned long long Sim_CallCount[SIM_CALL_COUNT];
+static const char * const Sim_CallNames[SIM_CALL_COUNT] = { "Kv_Write", "Kv_Process", "Kv_Init" };
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static void Sim_Fail(const char * message)
+{
+		printf("FAIL: %s\n", message);
+		exit(1);
+}
+
+/*!
+ * @brief Starts counting a call.
+ */
+static void Sim_Begin(void)
+{
+		memset(&Sim_Call, 0, sizeof(Sim_Call));
+}
+
+/*!
+ * @brief Ends counting a call: target cycles from the cost model, worst counts per function.
+ *
+ * @param[in] call SIM_CALL_WRITE, SIM_CALL_PROCESS or SIM_CALL_MOUNT.
+ */
+static void Sim_End(unsigned int call)
+{
+		Sim_CostType * worst = &Sim_Worst[call];
+
+		Sim_Call.cycles = SIM_CYCLES_CALL + (Sim_Call.crcBytes * SIM_CYCLES_CRC_BYTE) +
+		                  (Sim_Call.copyBytes * SIM_CYCLES_COPY_BYTE) + (Sim_Call.commands * SIM_CYCLES_COMMAND);
+		if (call == SIM_CALL_PROCESS)
+		{
+			/* Kv_Schedule(): the free and garbage counts and the head lookups, then the key scan */
+			Sim_Call.cycles += (4u * SIM_SECTORS * SIM_CYCLES_SECTOR) + (KV_KEY_COUNT * SIM_CYCLES_KEY);
+		}
+		else if (call == SIM_CALL_MOUNT)
+		{
+			/* Every byte of the store read once, the sectors ordered by sequence */
+			Sim_Call.cycles += (SIM_FLASH_BYTES * SIM_CYCLES_READ_BYTE) + (SIM_SECTORS * SIM_SECTORS * SIM_CYCLES_SECTOR);
+		}
+
+		if ((call != SIM_CALL_MOUNT) && ((Sim_Call.waits != 0u) || (Sim_Call.commands > 1u)))
+		{
+			printf("%s: %u commands, %u waits\n", Sim_CallNames[call], Sim_Call.commands, Sim_Call.waits);
+			Sim_Fail("call blocked on the flash");
+		}
+
+		worst->commands = (Sim_Call.commands > worst->commands) ? Sim_Call.commands : worst->commands;
+		worst->phrases = (Sim_Call.phrases > worst->phrases) ? Sim_Call.phrases : worst->phrases;
+		worst->waits = (Sim_Call.waits > worst->waits) ? Sim_Call.waits : worst->waits;
+		worst->crcBytes = (Sim_Call.crcBytes > worst->crcBytes) ? Sim_Call.crcBytes : worst->crcBytes;
+		worst->copyBytes = (Sim_Call.copyBytes > worst->copyBytes) ? Sim_Call.copyBytes : worst->copyBytes;
+		worst->cycles = (Sim_Call.cycles > worst->cycles) ? Sim_Call.cycles : worst->cycles;
+		Sim_CallCount[call]++;
+}
+
+/*!
+ * @brief Ends the command in progress, with or without the callback.
+ */
+static void Sim_Finish(unsigned char notify)
+{
+		unsigned int index;
+
+		if (Sim_IsErase != 0u)
+		{
+			memset(&Sim_Flash[Sim_Offset], 0xFF, KV_SECTOR_SIZE);
+			Sim_EraseCount[Sim_Offset / KV_SECTOR_SIZE]++;
+		}
+		else
+		{
+			for (index = 0u; index < FTFC_PHRASE_SIZE; index++)
+			{
+				Sim_Flash[Sim_Offset + index] = Sim_Data[index];
+			}
+		}
+		Sim_Busy = 0u;
+		if ((notify != 0u) && (Sim_FtfcConfig != NULL) && (Sim_FtfcConfig->callback != NULL))
+		{
+			Sim_FtfcConfig->callback(FTFC_OK);
+		}
+}
+
+/*!
+ * @brief Ends the command in progress when its time has passed.
+ */
+static void Sim_Advance(void)
+{
+		if ((Sim_Busy != 0u) && (Sim_Now >= Sim_DoneAt))
+		{
+			Sim_Finish(1u);
+		}
+}
+
+/*!
+ * @brief Erase pulses stopped early: every byte anywhere between its old value and 0xFF.
+ */
+static void Sim_PartialErase(void)
+{
+		unsigned int index;
+
+		for (index = 0u; index < KV_SECTOR_SIZE; index++)
+		{
+			Sim_Flash[Sim_Offset + index] |= (unsigned char)rand();
+		}
+}
+
+/*!
+ * @brief Cuts the power: the command in progress is left half done.
+ */
+static void Sim_PowerCut(void)
+{
+		unsigned int index;
+
+		if (Sim_Busy != 0u)
+		{
+			if (Sim_IsErase != 0u)
+			{
+				Sim_PartialErase();
+			}
+			else
+			{
+				/* Programming only clears bits: some of them made it */
+				for (index = 0u; index < FTFC_PHRASE_SIZE; index++)
+				{
+					Sim_Flash[Sim_Offset + index] = Sim_Data[index] | (unsigned char)(rand() & rand());
+				}
+			}
+		}
+		Sim_Busy = 0u;
+}
+
+/*!
+ * @brief Applies a random write to the store and to the model.
+ */
+static void Sim_RandomWrite(void)
+{
+		unsigned char key = (unsigned char)(rand() % SIM_KEYS);
+		Sim_ValueType value;
+		Sim_KeyType * model;
+		unsigned int index;
+
+		/* The upper keys change rarely, like the calibration, and have to be relocated */
+		if ((key >= SIM_KEYS_OFTEN) && ((rand() % 256) != 0))
+		{
+			key = (unsigned char)(key % SIM_KEYS_OFTEN);
+		}
+		model = &Sim_Keys[key];
+
+		/* Often the same value again, to exercise the unchanged-write filter */
+		if (((rand() % 4) == 0) && (model->count > 0u))
+		{
+			value = model->values[model->count - 1u];
+		}
+		else
+		{
+			value.length = (unsigned char)(rand() % (KV_VALUE_MAX + 1u));
+			for (index = 0u; index < value.length; index++)
+			{
+				value.data[index] = (unsigned char)rand();
+			}
+		}
+
+		/* Unchanged-value compare, then the copy into RAM */
+		Sim_Begin();
+		if (Kv_Write(key, value.data, value.length) != KV_OK)
+		{
+			Sim_Fail("Kv_Write rejected a valid value");
+		}
+		Sim_Call.copyBytes = 2u * value.length;
+		Sim_End(SIM_CALL_WRITE);
+
+		if (model->count >= SIM_HISTORY)
+		{
+			Sim_Fail("model history full, store never idle");
+		}
+		model->values[model->count++] = value;
+}
+
+/*!
+ * @brief Store idle: everything written is durable, the model keeps only the last values.
+ */
+static void Sim_Checkpoint(void)
+{
+		unsigned int key;
+
+		for (key = 0u; key < SIM_KEYS; key++)
+		{
+			if (Sim_Keys[key].count > 0u)
+			{
+				Sim_Keys[key].values[0] = Sim_Keys[key].values[Sim_Keys[key].count - 1u];
+				Sim_Keys[key].count = 1u;
+				Sim_Keys[key].absentOk = 0u;
+			}
+		}
+}
+
+/*!
+ * @brief Checks the mounted values against the model and makes them the new baseline.
+ */
+static void Sim_Verify(void)
+{
+		unsigned char data[KV_VALUE_MAX];
+		unsigned char length;
+		unsigned int key;
+		unsigned int index;
+		unsigned int match;
+		Sim_KeyType * model;
+
+		for (key = 0u; key < SIM_KEYS; key++)
+		{
+			model = &Sim_Keys[key];
+			if (Kv_Read((unsigned char)key, data, sizeof(data), &length) != KV_OK)
+			{
+				if (model->absentOk == 0u)
+				{
+					Sim_Fail("durable key lost");
+				}
+				model->count = 0u;
+				continue;
+			}
+
+			match = SIM_HISTORY;
+			for (index = 0u; index < model->count; index++)
+			{
+				if ((model->values[index].length == length) && (memcmp(model->values[index].data, data, length) == 0))
+				{
+					match = index;
+				}
+			}
+			if (match == SIM_HISTORY)
+			{
+				Sim_Fail("mounted value was never written after the last durable one");
+			}
+			model->values[0] = model->values[match];
+			model->count = 1u;
+			model->absentOk = 0u;
+		}
+}
+
+
+/*==================================================================================================
+*                                 SIMULATED FTFC DRIVER
+==================================================================================================*/
+uint16 Crc16_Compute(const uint8 * DataPtr, uint16 length)
+{
+		/* The mount scan copies the value into RAM, Kv_Schedule() stages it behind the header */
+		Sim_Call.crcBytes += length;
+		Sim_Call.copyBytes += (Sim_Mounting != 0u) ? length : KV_RECORD_BYTES(length);
+		return Sim_Crc16Compute(DataPtr, length);
+}
+
+Ftfc_ret_t Ftfc_Init(const Ftfc_ConfigType * ConfigPtr)
+{
+		Sim_FtfcConfig = ConfigPtr;
+		return FTFC_OK;
+}
+
+Ftfc_ret_t Ftfc_ProgramPhrase(unsigned int address, const unsigned char * DataPtr)
+{
+		unsigned int offset = address - SIM_FLASH_ADDRESS;
+		unsigned int index;
+
+		if ((address < SIM_FLASH_ADDRESS) || (offset >= SIM_FLASH_BYTES) || ((offset % FTFC_PHRASE_SIZE) != 0u))
+		{
+			Sim_Fail("program outside the store");
+		}
+		if (Sim_Busy != 0u)
+		{
+			return FTFC_ERR_BUSY;
+		}
+		for (index = 0u; index < FTFC_PHRASE_SIZE; index++)
+		{
+			if (Sim_Flash[offset + index] != 0xFFu)
+			{
+				Sim_Fail("phrase programmed twice");
+			}
+		}
+
+		memcpy(Sim_Data, DataPtr, FTFC_PHRASE_SIZE);
+		Sim_Offset = offset;
+		Sim_IsErase = 0u;
+		Sim_Busy = 1u;
+		Sim_DoneAt = Sim_Now + SIM_PHRASE_US;
+		Sim_Call.commands++;
+		Sim_Call.phrases++;
+		return FTFC_OK;
+}
+
+Ftfc_ret_t Ftfc_EraseSector(unsigned int address)
+{
+		unsigned int offset = address - SIM_FLASH_ADDRESS;
+
+		if ((address < SIM_FLASH_ADDRESS) || (offset >= SIM_FLASH_BYTES) || ((offset % KV_SECTOR_SIZE) != 0u))
+		{
+			Sim_Fail("erase outside the store");
+		}
+		if (Sim_Busy != 0u)
+		{
+			return FTFC_ERR_BUSY;
+		}
+
+		Sim_Offset = offset;
+		Sim_IsErase = 1u;
+		Sim_Busy = 1u;
+		Sim_DoneAt = Sim_Now + SIM_ERASE_US;
+		Sim_Call.commands++;
+		return FTFC_OK;
+}
+
+unsigned char Ftfc_IsBusy(void)
+{
+		return Sim_Busy;
+}
+
+Ftfc_ret_t Ftfc_Wait(void)
+{
+		if (Sim_Busy != 0u)
+		{
+			Sim_Call.waits++;
+			Sim_Now = (Sim_DoneAt > Sim_Now) ? Sim_DoneAt : Sim_Now;
+			Sim_Finish(0u);
+		}
+		return FTFC_OK;
+}
+
+Ftfc_ret_t Ftfc_Suspend(void)
+{
+		if ((Sim_Busy != 0u) && (Sim_IsErase != 0u))
+		{
+			Sim_Call.waits++;
+			Sim_PartialErase();
+			Sim_Busy = 0u;
+			return FTFC_ERR_SUSPENDED;
+		}
+		return Ftfc_Wait();
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const Ftfc_ConfigType ftfcConfig = { Kv_OnFlashDone };
+		static const Kv_ConfigType kvConfig = { SIM_FLASH_ADDRESS, Sim_Flash, SIM_SECTORS };
+		unsigned int cuts = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : SIM_DEFAULT_CUTS;
+		unsigned int cut;
+		unsigned int key;
+		unsigned int sector;
+		unsigned long long runUs;
+		unsigned char busyCut;
+		unsigned long long flushStart;
+		unsigned long long flushUs = 0u;
+		unsigned int flushes = 0u;
+		unsigned long long end;
+		unsigned long long totalUs = 0u;
+		unsigned int writes = 0u;
+		unsigned int records = 0u;
+		unsigned int relocations = 0u;
+		unsigned int erases = 0u;
+		unsigned int unchanged = 0u;
+		unsigned int damaged = 0u;
+		unsigned int minErase;
+		unsigned int maxErase;
+		unsigned int call;
+		Kv_StatsType stats;
+
+		srand(1u);
+		memset(Sim_Flash, 0xFF, sizeof(Sim_Flash));
+		for (key = 0u; key < SIM_KEYS; key++)
+		{
+			Sim_Keys[key].absentOk = 1u;
+		}
+		(void)Ftfc_Init(&ftfcConfig);
+
+		for (cut = 0u; cut <= cuts; cut++)
+		{
+			Sim_Begin();
+			Sim_Mounting = 1u;
+			if (Kv_Init(&kvConfig) != KV_OK)
+			{
+				Sim_Fail("Kv_Init");
+			}
+			Sim_Mounting = 0u;
+			Sim_End(SIM_CALL_MOUNT);
+			Sim_Verify();
+			if (cut == cuts)
+			{
+				break;
+			}
+
+			for (key = 0u; key < SIM_KEYS; key++)
+			{
+				Sim_Keys[key].absentOk = (Sim_Keys[key].count == 0u) ? 1u : 0u;
+			}
+
+			/* Run until a random power cut, every other one during a flash command */
+			runUs = 1u + ((unsigned long long)rand() * rand()) % SIM_RUN_US;
+			end = Sim_Now + runUs;
+			busyCut = (unsigned char)(rand() & 1);
+			while ((Sim_Now < end) || ((busyCut != 0u) && (Sim_Busy == 0u)))
+			{
+				Sim_Now += SIM_STEP_US;
+				Sim_Advance();
+				if ((rand() % (SIM_WRITE_PERIOD_US / SIM_STEP_US)) == 0)
+				{
+					Sim_RandomWrite();
+					writes++;
+				}
+
+				Sim_Begin();
+				Kv_Process();
+				Sim_End(SIM_CALL_PROCESS);
+
+				if (Kv_IsIdle() != 0u)
+				{
+					Sim_Checkpoint();
+				}
+			}
+			totalUs += runUs + (Sim_Now - end);
+			(void)Kv_GetStats(&stats);
+			records += stats.records;
+			relocations += stats.relocations;
+			erases += stats.erases;
+			unchanged += stats.unchanged;
+
+			/* Every other cut comes with a low voltage warning, which flushes the dirty keys */
+			if ((rand() & 1) != 0)
+			{
+				flushStart = Sim_Now;
+				if (Kv_Flush(SIM_FLUSH_PHRASES) == 0u)
+				{
+					Sim_Checkpoint();
+				}
+				flushUs = ((Sim_Now - flushStart) > flushUs) ? (Sim_Now - flushStart) : flushUs;
+				flushes++;
+			}
+			Sim_PowerCut();
+			(void)Kv_Init(&kvConfig);
+			(void)Kv_GetStats(&stats);
+			damaged += stats.damaged;
+		}
+
+		minErase = Sim_EraseCount[0];
+		maxErase = Sim_EraseCount[0];
+		for (sector = 0u; sector < SIM_SECTORS; sector++)
+		{
+			minErase = (Sim_EraseCount[sector] < minErase) ? Sim_EraseCount[sector] : minErase;
+			maxErase = (Sim_EraseCount[sector] > maxErase) ? Sim_EraseCount[sector] : maxErase;
+		}
+
+		printf("power cuts survived        %u over %.1f s of simulated time\n", cuts, (double)totalUs / 1e6);
+		printf("writes                     %u, %u unchanged and not journaled\n", writes, unchanged);
+		printf("records                    %u, %u of them relocations\n", records, relocations);
+		printf("torn records skipped       %u\n", damaged);
+		printf("flushes on warning         %u, longest %llu us of flash time\n", flushes, flushUs);
+		printf("sector erases              %u, per sector min %u max %u\n", erases, minErase, maxErase);
+		printf("worst per call             commands phrases waits crc bytes copy bytes target cycles\n");
+		for (call = 0u; call < SIM_CALL_COUNT; call++)
+		{
+			printf("  %-10s %10llu calls %5u %7u %5u %9u %10u %13u\n", Sim_CallNames[call], Sim_CallCount[call],
+			       Sim_Worst[call].commands, Sim_Worst[call].phrases, Sim_Worst[call].waits, Sim_Worst[call].crcBytes,
+			       Sim_Worst[call].copyBytes, Sim_Worst[call].cycles);
+		}
+		printf("PASS\n");
+		return 0;
+}
@@ -0,0 +1,429 @@
+/****************************************************************************************************
+* @file    logbench.c
+* @author  Ma Hien Nhan
+* @brief   Host check and benchmark of the deferred binary log (Log).
+* @details This file builds the firmware Log.c for the host with the exclusive monitor, the cycle
+*          counter and the LPUART replaced. Log calls with random arguments, most of them with
+*          bit 31 set, are interrupted at random points: between the exclusive load and store by
+*          a nested log call, which must make the store fail and the reservation retry, and
+*          after the reservation by Log_Process(), as when the writer runs below the reader, which
+*          must stop at the record not yet committed. Every frame sent is decoded and checked
+*          against the calls made: each stored record arrives once with its arguments, no other
+*          record arrives, and the dropped-records reports add up to the calls that found the ring
+*          full. The report then gives the host time of a log call and of Log_Process() per
+*          record. Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o logbench
+*                  Tools/logbench.c Utilitie/Utilitie.c
+*              ./logbench [calls]
+* @version 1.0.0
+* @date    2024-11-06
+* @note    Host times only compare costs; target cycles need DWT_GET_CYCLES() around a call.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+/*** Host replacement of Cpu.h ***/
+#define CPU_H
+#define CPU_COMPILER_BARRIER()          __asm volatile ("" : : : "memory")
+#define Cpu_LoadExclusive(ADDR)         Sim_LoadExclusive(ADDR)
+#define Cpu_StoreExclusive(VALUE, ADDR) Sim_StoreExclusive((VALUE), (ADDR))
+#define Cpu_ClearExclusive()            (Sim_Monitor = 0u)
+
+#include "Log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static unsigned int Sim_LoadExclusive(volatile unsigned int * AddrPtr);
+static unsigned int Sim_StoreExclusive(unsigned int value, volatile unsigned int * AddrPtr);
+static unsigned int Sim_Cycles(void);
+static unsigned int Sim_Monitor;
+
+#undef DWT_GET_CYCLES
+#define DWT_GET_CYCLES()                Sim_Cycles()
+
+#include "../Middleware/src/Log.c"
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_UART                        (0u)
+#define SIM_RING_WORDS                  (64u)              /* Small, so it wraps and fills often */
+#define SIM_TX_SIZE                     (1024u)
+#define SIM_DEFAULT_CALLS               (1000000u)
+#define SIM_MAX_NEST                    (8u)
+#define SIM_PREEMPT_STORE               (8u)               /* 1 in N exclusive loads interrupted */
+#define SIM_PREEMPT_READER              (4u)               /* 1 in N reservations interrupted */
+#define SIM_BENCH_CALLS                 (4000000u)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   A log call, as made and as it must arrive.
+ */
+typedef struct
+{
+			unsigned int   header;
+			unsigned int   args[LOG_MAX_ARGS];
+			unsigned char  state;              /*!< 0 not stored, 1 stored, 2 received */
+} Sim_RecordType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int     Sim_Ring[SIM_RING_WORDS];
+static Sim_RecordType * Sim_Records;              /* Indexed by timestamp */
+static unsigned int     Sim_Stamp;                /* Last timestamp issued */
+static Sim_RecordType   Sim_Calls[SIM_MAX_NEST];  /* Log calls in progress, innermost last */
+static unsigned int     Sim_CallStamps[SIM_MAX_NEST];
+static unsigned int     Sim_Depth;
+static unsigned int     Sim_CallCount;
+static unsigned int     Sim_Inject;               /* Preemption enabled */
+static unsigned int     Sim_InIsr;
+
+/* Exclusive monitor statistics */
+static unsigned int     Sim_Loads;
+static unsigned int     Sim_Retries;
+
+/* LPUART transmit side */
+static unsigned char    Sim_Tx[SIM_TX_SIZE];
+static unsigned short   Sim_TxLength;
+static unsigned short   Sim_TxLimit = SIM_TX_SIZE;
+
+/* Checks */
+static unsigned int     Sim_Received;
+static unsigned int     Sim_Garbage;
+static unsigned int     Sim_Duplicates;
+static unsigned int     Sim_DroppedReported;
+static unsigned int     Sim_Pending;             /* Record the reader ran inside */
+static unsigned int     Sim_EarlyReads;          /* Pending record sent before its commit */
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static void Sim_Log(void);
+static void Sim_Drain(void);
+
+/*!
+ * @brief Exclusive load; sometimes a nested log call lands before the store.
+ */
+static unsigned int Sim_LoadExclusive(volatile unsigned int * AddrPtr)
+{
+		unsigned int value = *AddrPtr;
+
+		Sim_Loads++;
+		Sim_Monitor = 1u;
+		if ((Sim_Inject != 0u) && (Sim_InIsr == 0u) && (Sim_Depth < SIM_MAX_NEST) &&
+		    ((rand() % SIM_PREEMPT_STORE) == 0))
+		{
+			Sim_InIsr = 1u;
+			Sim_Log();
+			Sim_InIsr = 0u;
+			Sim_Monitor = 0u;                     /* Exception return clears the monitor */
+		}
+		return value;
+}
+
+/*!
+ * @brief Exclusive store, failed when the monitor was cleared.
+ */
+static unsigned int Sim_StoreExclusive(unsigned int value, volatile unsigned int * AddrPtr)
+{
+		if (Sim_Monitor == 0u)
+		{
+			Sim_Retries++;
+			return 1u;
+		}
+		*AddrPtr = value;
+		Sim_Monitor = 0u;
+		return 0u;
+}
+
+/*!
+ * @brief Cycle counter: gives the innermost log call its unique timestamp.
+ */
+static unsigned int Sim_Cycles(void)
+{
+		unsigned int stamp = ++Sim_Stamp;
+		unsigned int pending;
+
+		if ((Sim_Depth == 0u) || (Sim_CallStamps[Sim_Depth - 1u] != 0u))
+		{
+			return stamp;                         /* Record made by Log_Process() itself */
+		}
+
+		Sim_Records[stamp] = Sim_Calls[Sim_Depth - 1u];
+		Sim_Records[stamp].state = 1u;
+		Sim_CallStamps[Sim_Depth - 1u] = stamp;
+
+		/* The reader runs while this record is reserved but not committed */
+		if ((Sim_Inject != 0u) && (Sim_InIsr == 0u) && ((rand() % SIM_PREEMPT_READER) == 0))
+		{
+			pending = Sim_Pending;
+			Sim_Pending = stamp;
+			Sim_InIsr = 1u;
+			(void)Log_Process();
+			Sim_Drain();
+			Sim_InIsr = 0u;
+			Sim_Pending = pending;
+		}
+		return stamp;
+}
+
+/*!
+ * @brief Random argument, bit 31 set three times in four.
+ */
+static unsigned int Sim_Arg(void)
+{
+		unsigned int value = ((unsigned int)rand() << 16u) ^ (unsigned int)rand();
+
+		return ((rand() % 4) != 0) ? (value | 0x80000000u) : (value & 0x7FFFFFFFu);
+}
+
+/*!
+ * @brief Makes one log call with random arguments.
+ *
+ * The description waits in the call stack until the cycle counter copies it to the record
+ * table at its timestamp.
+ */
+static void Sim_Log(void)
+{
+		Sim_RecordType * record = &Sim_Calls[Sim_Depth];
+		unsigned int nargs = (unsigned int)rand() % (LOG_MAX_ARGS + 1u);
+		unsigned int index;
+
+		Sim_CallCount++;
+		record->header = LOG_HEADER(LOG_LEVEL_INFO, (unsigned int)rand() & 0xFFFFu, nargs);
+		for (index = 0u; index < LOG_MAX_ARGS; index++)
+		{
+			record->args[index] = (index < nargs) ? Sim_Arg() : 0u;
+		}
+		record->state = 0u;
+
+		Sim_CallStamps[Sim_Depth++] = 0u;
+		switch (nargs)
+		{
+			case 0u:  Log_Write0(record->header); break;
+			case 1u:  Log_Write1(record->header, record->args[0]); break;
+			case 2u:  Log_Write2(record->header, record->args[0], record->args[1]); break;
+			case 3u:  Log_Write3(record->header, record->args[0], record->args[1], record->args[2]); break;
+			default:  Log_Write4(record->header, record->args[0], record->args[1], record->args[2], record->args[3]); break;
+		}
+		if (Sim_CallStamps[--Sim_Depth] == 0u)
+		{
+			Sim_DroppedReported--;                /* Ring full: owed one dropped report */
+		}
+}
+
+/*!
+ * @brief Decodes and checks the frames sent since the last call.
+ */
+static void Sim_Drain(void)
+{
+		unsigned short start = 0u;
+		unsigned short end;
+		unsigned short length;
+		unsigned int words[LOG_RECORD_MAX_WORDS];
+		unsigned int count;
+		unsigned int index;
+		Sim_RecordType * record;
+
+		for (end = 0u; end < Sim_TxLength; end++)
+		{
+			if (Sim_Tx[end] != COBS_DELIMITER)
+			{
+				continue;
+			}
+			length = Cobs_Decode(&Sim_Tx[start], (unsigned short)(end - start));
+			count = (length - 1u) / 4u;
+			if ((length < 9u) || (Sim_Tx[start] != LOG_FRAME_TAG) || (((length - 1u) % 4u) != 0u) ||
+			    (count > LOG_RECORD_MAX_WORDS))
+			{
+				Sim_Garbage++;
+				start = (unsigned short)(end + 1u);
+				continue;
+			}
+			for (index = 0u; index < count; index++)
+			{
+				const unsigned char * p = &Sim_Tx[start + 1u + (index * 4u)];
+				words[index] = (unsigned int)p[0] | ((unsigned int)p[1] << 8u) |
+				               ((unsigned int)p[2] << 16u) | ((unsigned int)p[3] << 24u);
+			}
+			start = (unsigned short)(end + 1u);
+
+			if (words[0] == LOG_HEADER(LOG_LEVEL_INTERNAL, LOG_ID_DROPPED, 1u))
+			{
+				Sim_DroppedReported += words[2];
+				continue;
+			}
+			if ((words[1] == 0u) || (words[1] > Sim_Stamp))
+			{
+				Sim_Garbage++;
+				continue;
+			}
+			record = &Sim_Records[words[1]];
+			if (record->state == 2u)
+			{
+				Sim_Duplicates++;
+				continue;
+			}
+			if ((record->state != 1u) || (record->header != words[0]) ||
+			    (count != (2u + ((words[0] >> LOG_HEADER_NARGS_SHIFT) & 0x7u))))
+			{
+				Sim_Garbage++;
+				continue;
+			}
+			for (index = 2u; index < count; index++)
+			{
+				if (words[index] != record->args[index - 2u])
+				{
+					Sim_Garbage++;
+					break;
+				}
+			}
+			if (words[1] == Sim_Pending)
+			{
+				Sim_EarlyReads++;
+			}
+			record->state = 2u;
+			Sim_Received++;
+		}
+		Sim_TxLength = 0u;
+}
+
+/*!
+ * @brief Monotonic time in nanoseconds.
+ */
+static double Sim_NowNs(void)
+{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+
+/*==================================================================================================
+*                                       LPUART STUB
+==================================================================================================*/
+unsigned short Lpuart_GetTxFree(unsigned char instance)
+{
+		(void)instance;
+		return (unsigned short)(Sim_TxLimit - Sim_TxLength);
+}
+
+unsigned short Lpuart_WriteBegin(unsigned char instance, unsigned char ** DataPtr)
+{
+		*DataPtr = &Sim_Tx[Sim_TxLength];
+		return Lpuart_GetTxFree(instance);
+}
+
+void Lpuart_WriteCommit(unsigned char instance, unsigned short count)
+{
+		(void)instance;
+		Sim_TxLength = (unsigned short)(Sim_TxLength + count);
+}
+
+unsigned short Lpuart_Write(unsigned char instance, const unsigned char * DataPtr, unsigned short length)
+{
+		unsigned short index;
+
+		(void)instance;
+		for (index = 0u; index < length; index++)
+		{
+			Sim_Tx[Sim_TxLength++] = DataPtr[index];
+		}
+		return length;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const Log_ConfigType config = { SIM_UART, Sim_Ring, SIM_RING_WORDS };
+		unsigned int calls = (argc > 1) ? (unsigned int)atoi(argv[1]) : SIM_DEFAULT_CALLS;
+		unsigned int call;
+		unsigned int stored = 0u;
+		unsigned int stamp;
+		unsigned int sent = 0u;
+		double startNs;
+		double writeNs;
+		double processNs;
+		int pass;
+
+		/* Nested calls add records: at most one per exclusive load */
+		Sim_Records = calloc((size_t)calls * 4u + 16u, sizeof(Sim_RecordType));
+		srand(1u);
+		if ((Sim_Records == NULL) || (Log_Init(&config) != LOG_OK))
+		{
+			printf("FAIL: init\n");
+			return 1;
+		}
+
+		/* 1. Interrupted writers and readers */
+		Sim_Inject = 1u;
+		for (call = 0u; (call < calls) && (Sim_Stamp < (calls * 3u)); call++)
+		{
+			Sim_Log();
+			if ((rand() % 3) == 0)
+			{
+				Sim_TxLimit = (unsigned short)(((rand() % 2) == 0) ? SIM_TX_SIZE : ((unsigned int)rand() % 64u));
+				(void)Log_Process();
+				Sim_Drain();
+				Sim_TxLimit = SIM_TX_SIZE;
+			}
+		}
+		Sim_Inject = 0u;
+		while (Log_Process() != 0u)
+		{
+			Sim_Drain();
+		}
+		(void)Log_Process();
+		Sim_Drain();
+
+		for (stamp = 1u; stamp <= Sim_Stamp; stamp++)
+		{
+			stored += (Sim_Records[stamp].state != 0u) ? 1u : 0u;
+		}
+		printf("%u log calls, %u of them nested; ring %u words\n", Sim_CallCount, Sim_CallCount - call,
+		       SIM_RING_WORDS);
+		printf("stored %u, received %u, dropped %u (reported %+d), %u exclusive loads, %u retries\n",
+		       stored, Sim_Received, Log_Dropped, (int)Sim_DroppedReported, Sim_Loads, Sim_Retries);
+		printf("bad frames %u, duplicates %u, records read before their commit %u\n",
+		       Sim_Garbage, Sim_Duplicates, Sim_EarlyReads);
+		pass = (Sim_Received == stored) && (Sim_Garbage == 0u) && (Sim_Duplicates == 0u) &&
+		       (Sim_EarlyReads == 0u) && (Sim_DroppedReported == 0u) && (Sim_Retries != 0u);
+
+		/* 2. Host cost of a call with two arguments and of draining it */
+		(void)Log_Init(&config);
+		writeNs = 0.0;
+		processNs = 0.0;
+		for (call = 0u; call < SIM_BENCH_CALLS; call += 8u)
+		{
+			startNs = Sim_NowNs();
+			for (stamp = 0u; stamp < 8u; stamp++)
+			{
+				Log_Write2(LOG_HEADER(LOG_LEVEL_INFO, 0x100u, 2u), call, stamp);
+			}
+			writeNs += Sim_NowNs() - startNs;
+			startNs = Sim_NowNs();
+			sent += Log_Process();
+			processNs += Sim_NowNs() - startNs;
+			Sim_TxLength = 0u;
+		}
+		printf("host: %.1f ns per log call, %.1f ns per record in Log_Process() (COBS included)\n",
+		       writeNs / SIM_BENCH_CALLS, processNs / sent);
+
+		free(Sim_Records);
+		printf(pass ? "PASS\n" : "FAIL\n");
+		return pass ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""Decoder for the deferred binary log (Middleware/inc/Log.h).
+
+The firmware sends each record as a COBS frame ending with a zero byte:
+    [0xA5] [header] [timestamp] [arg0..arg3]
+all words little-endian. The header holds
+    bit 31 valid, bits 30..28 level, bits 27..24 argument count, bits 23..0 format string id
+where the id is the address of the format string in the non-loaded ".logstr" section of the
+ELF file. %s arguments are addresses of strings in flash and are read from the ELF file too.
+
+Examples:
+    logdecode.py firmware.elf --port /dev/ttyUSB0 --baud 115200 --cpu-hz 80000000
+    logdecode.py firmware.elf --file capture.bin
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+FRAME_TAG = 0xA5
+LEVEL_NAMES = {0: "ERROR", 1: "WARN", 2: "INFO", 3: "DEBUG", 7: "LOG"}
+LEVEL_INTERNAL = 7
+ID_DROPPED = 0
+SECTION = ".logstr"
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("bad COBS frame")
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Elf:
+    """Minimal little-endian ELF32 reader: section names, addresses and contents."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("%s: not a little-endian ELF32 file" % path)
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        headers = [struct.unpack_from("<IIIIIIIIII", data, shoff + n * shentsize) for n in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = []
+        for name, kind, flags, addr, offset, size, _, _, _, _ in headers:
+            end = data.index(b"\0", names[4] + name)
+            contents = b"" if kind == SHT_NOBITS else data[offset:offset + size]
+            self.sections.append((data[names[4] + name:end].decode(), flags, addr, contents))
+
+    def section(self, name):
+        for sname, _, addr, contents in self.sections:
+            if sname == name:
+                return addr, contents
+        raise KeyError("section %s not found, check the linker script" % name)
+
+    def string_at(self, address):
+        """Reads a NUL terminated string from a loaded section, None when the address is not in one."""
+        for _, flags, addr, contents in self.sections:
+            if flags & SHF_ALLOC and addr <= address < addr + len(contents):
+                start = address - addr
+                end = contents.find(b"\0", start)
+                return contents[start:end if end >= 0 else len(contents)].decode(errors="replace")
+        return None
+
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|t)?([diouxXcps%])")
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def render(fmt, args, elf):
+    """Formats a C printf string with 32-bit integer arguments."""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, kind = match.groups()
+        if kind == "%":
+            return "%"
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        if kind == "s":
+            text = elf.string_at(value)
+            value, kind = ("<0x%08X>" % value) if text is None else text, "s"
+        elif kind in "di":
+            value = to_signed(value)
+            kind = "d"
+        elif kind == "u":
+            kind = "d"
+        elif kind == "p":
+            value, kind, flags = value, "x", flags + "#"
+        spec = "%" + flags + width + ("." + precision if precision else "") + kind
+        return spec % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, elf, cpu_hz):
+        self.elf = elf
+        self.base, self.strings = elf.section(SECTION)
+        self.cpu_hz = cpu_hz
+        self.last_cycles = None
+        self.high = 0
+
+    def format_string(self, ident):
+        start = ident - self.base
+        if not 0 <= start < len(self.strings):
+            return None
+        return self.strings[start:self.strings.index(b"\0", start)].decode(errors="replace")
+
+    def timestamp(self, cycles):
+        """Cycle counter extended past its 32-bit wrap, in seconds when --cpu-hz is given."""
+        if self.last_cycles is not None and cycles < self.last_cycles:
+            self.high += 1 << 32
+        self.last_cycles = cycles
+        total = self.high + cycles
+        return "%14.6f" % (total / self.cpu_hz) if self.cpu_hz else "%14d" % total
+
+    def decode(self, frame):
+        if len(frame) < 9 or frame[0] != FRAME_TAG or (len(frame) - 1) % 4:
+            return "? bad frame %s" % frame.hex()
+        words = struct.unpack("<%dI" % ((len(frame) - 1) // 4), frame[1:])
+        header, cycles, args = words[0], words[1], words[2:]
+        level = (header >> 28) & 0x7
+        nargs = (header >> 24) & 0xF
+        ident = header & 0xFFFFFF
+        if nargs != len(args):
+            return "? bad argument count %s" % frame.hex()
+        stamp = self.timestamp(cycles)
+        if level == LEVEL_INTERNAL and ident == ID_DROPPED:
+            text = "%d records dropped, log ring full" % args[0]
+        else:
+            fmt = self.format_string(ident)
+            text = ("<unknown id 0x%06X> %s" % (ident, " ".join("0x%X" % a for a in args))
+                    if fmt is None else render(fmt, args, self.elf))
+        return "%s %-5s %s" % (stamp, LEVEL_NAMES.get(level, level), text)
+
+
+def frames(stream):
+    pending = bytearray()
+    while True:
+        chunk = stream()
+        if not chunk:
+            return
+        pending += chunk
+        while 0 in pending:
+            end = pending.index(0)
+            raw = bytes(pending[:end])
+            del pending[:end + 1]
+            if raw:
+                try:
+                    yield cobs_decode(raw)
+                except ValueError:
+                    yield b""
+
+
+def open_port(path, baud):
+    import termios
+    import tty
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = getattr(termios, "B%d" % baud)
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return lambda: os.read(fd, 4096)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF file with the .logstr section")
+    where = parser.add_mutually_exclusive_group(required=True)
+    where.add_argument("--port", help="serial device")
+    where.add_argument("--file", help="raw capture, '-' for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--cpu-hz", type=int, default=0, help="core clock, to print seconds instead of cycles")
+    args = parser.parse_args()
+
+    decoder = Decoder(Elf(args.elf), args.cpu_hz)
+    if args.port:
+        stream = open_port(args.port, args.baud)
+    else:
+        handle = sys.stdin.buffer if args.file == "-" else open(args.file, "rb")
+        stream = lambda: handle.read(4096)
+
+    try:
+        for frame in frames(stream):
+            print(decoder.decode(frame), flush=True)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,352 @@
+/****************************************************************************************************
+* @file    ostest.c
+* @author  Ma Hien Nhan
+* @brief   Host test of the scheduling rules of the preemptive kernel (Os).
+* @details Time only advances by simulated SysTick interrupts: the idle hook raises one whenever
+*          every task is blocked, and the busy tasks raise one per tick of work. Every run is
+*          therefore the same and the checks compare exact tick counts and run orders. Four phases,
+*          each on a freshly initialized kernel: priority preemption, round-robin on a tick,
+*          Os_SleepUntil() periodicity and Os_EventWait() results. Build and run from the
+*          repository root:
+*              gcc -O2 -DOS_PORT_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o ostest
+*                  Tools/ostest.c Middleware/src/Os.c Middleware/src/Os_Port_Host.c
+*              ./ostest
+* @version 1.0.0
+* @date    2024-11-16
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Os.h"
+#include "Os_Port.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define TEST_HOST_STACK_WORDS           (4096u)            /* Os host stacks hold a ucontext */
+#define TEST_TASKS                      (3u)
+#define TEST_TICK_LIMIT                 (1000u)            /* A phase that runs longer is hung */
+
+#define TEST_RR_SLICES                  (6u)               /* Ticks of work per round-robin task */
+#define TEST_PERIOD                     (5u)
+#define TEST_PERIODS                    (8u)
+
+#define TEST_EVENT_A                    (0x01u)
+#define TEST_EVENT_B                    (0x02u)
+#define TEST_EVENT_C                    (0x04u)
+#define TEST_EVENT_D                    (0x08u)
+#define TEST_EVENT_E                    (0x10u)
+#define TEST_EVENT_F                    (0x20u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Test_IdleStack[TEST_HOST_STACK_WORDS] __attribute__((aligned(16)));
+static unsigned int Test_Stacks[TEST_TASKS][TEST_HOST_STACK_WORDS] __attribute__((aligned(16)));
+static Os_TaskType Test_Tasks[TEST_TASKS];
+static Os_EventType Test_Event;
+static unsigned int Test_Running;                          /* Test tasks not yet ended */
+
+/*** Preemption phase ***/
+static unsigned int Test_LowTicks;
+static unsigned int Test_MidSawLow;
+static unsigned int Test_HighWake;
+static unsigned int Test_HighSawLow;
+static unsigned char Test_HighDone;
+static Os_TaskType * Test_IsrCurrent;
+
+/*** Round-robin phase ***/
+static char Test_Order[(2u * TEST_RR_SLICES) + 1u];
+static unsigned int Test_OrderCount;
+
+/*** Periodic phase ***/
+static unsigned int Test_Releases[TEST_PERIODS];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static void Test_Fail(const char * msg)
+{
+		printf("FAIL: %s (tick %u)\n", msg, Os_GetTicks());
+		exit(1);
+}
+
+static void Test_Check(int cond, const char * msg)
+{
+		if (cond == 0)
+		{
+			Test_Fail(msg);
+		}
+}
+
+/* Idle task: time passes while every test task is blocked, the phase ends when they all ended */
+static void Test_IdleHook(void)
+{
+		if (Test_Running == 0u)
+		{
+			Os_PortHostStop();
+		}
+		else if (Os_GetTicks() >= TEST_TICK_LIMIT)
+		{
+			Test_Fail("phase hung");
+		}
+		else
+		{
+			Os_PortHostInterrupt(Os_Tick);
+		}
+}
+
+/* Work of the calling task, one SysTick per tick of work */
+static void Test_Burn(unsigned int ticks)
+{
+		unsigned int i;
+
+		for (i = 0u; i < ticks; i++)
+		{
+			Os_PortHostInterrupt(Os_Tick);
+		}
+}
+
+static void Test_Create(unsigned int index, Os_EntryType entry, void * arg, unsigned char priority)
+{
+		Os_TaskConfigType task;
+
+		task.entry = entry;
+		task.arg = arg;
+		task.stack = Test_Stacks[index];
+		task.stackWords = TEST_HOST_STACK_WORDS;
+		task.priority = priority;
+		Test_Running++;
+		Test_Check(Os_TaskCreate(&Test_Tasks[index], &task) == OS_OK, "task create");
+}
+
+static void Test_Run(void)
+{
+		Os_Start();
+		Test_Check(Test_Running == 0u, "phase stopped early");
+}
+
+static void Test_Start(void)
+{
+		static const Os_ConfigType osConfig = { Test_IdleHook, Test_IdleStack, TEST_HOST_STACK_WORDS,
+		                                        NULL, NULL };
+
+		Test_Running = 0u;
+		Test_Check(Os_Init(&osConfig) == OS_OK, "kernel init");
+		(void)Os_EventInit(&Test_Event);
+}
+
+/*** 1. Priority preemption ***/
+static void Test_SetFromIsr(void)
+{
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_A);
+		Test_IsrCurrent = Os_GetCurrent();
+}
+
+static void Test_HighEntry(void * arg)
+{
+		unsigned int flags = 0u;
+
+		(void)arg;
+		(void)Os_Sleep(3u);
+		Test_HighWake = Os_GetTicks();
+		Test_HighSawLow = Test_LowTicks;
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_A, OS_EVENT_ANY, OS_WAIT_FOREVER, &flags) == OS_OK,
+		           "high event wait");
+		Test_HighDone = 1u;
+		Test_Running--;
+}
+
+static void Test_MidEntry(void * arg)
+{
+		(void)arg;
+		Test_MidSawLow = Test_LowTicks;
+		Test_Running--;
+}
+
+static void Test_LowEntry(void * arg)
+{
+		unsigned int i;
+
+		(void)arg;
+		Test_MidSawLow = 0xFFFFFFFFu;
+		Test_Create(1u, Test_MidEntry, NULL, 2u);
+		Test_Check(Test_MidSawLow == 0u, "higher task created by a lower one did not preempt it");
+		for (i = 0u; i < 6u; i++)
+		{
+			Test_LowTicks++;
+			Test_Burn(1u);
+		}
+		Test_Check(Test_HighWake == 3u, "sleeping higher task not woken at its tick");
+		Test_Check(Test_HighSawLow == 3u, "woken higher task did not preempt the lower one");
+		Test_Check(Test_HighDone == 0u, "higher task released without its event");
+		Os_PortHostInterrupt(Test_SetFromIsr);
+		Test_Check(Test_IsrCurrent == &Test_Tasks[0], "switch inside the interrupt");
+		Test_Check(Test_HighDone == 1u, "no switch on return of the interrupt");
+		Test_Running--;
+}
+
+/*** 2. Round-robin ***/
+static void Test_RoundRobinEntry(void * arg)
+{
+		unsigned int i;
+
+		for (i = 0u; i < TEST_RR_SLICES; i++)
+		{
+			Test_Order[Test_OrderCount] = *(const char *)arg;
+			Test_OrderCount++;
+			Test_Burn(1u);
+		}
+		Test_Running--;
+}
+
+/*** 3. Periodic release ***/
+static void Test_PeriodicEntry(void * arg)
+{
+		unsigned int last;
+		unsigned int i;
+
+		(void)arg;
+		last = Os_GetTicks();
+		Test_Check(Os_SleepUntil(&last, 0u) == OS_ERR_PARA, "zero period accepted");
+		for (i = 0u; i < TEST_PERIODS; i++)
+		{
+			Test_Burn(i % TEST_PERIOD);                    /* Execution time varies, below the period */
+			Test_Check(Os_SleepUntil(&last, TEST_PERIOD) == OS_OK, "sleep until");
+			Test_Releases[i] = Os_GetTicks();
+		}
+		/* Overrun: the release time is already past, no wait and no catch-up slip */
+		Test_Burn(TEST_PERIOD + 2u);
+		Test_Check(Os_SleepUntil(&last, TEST_PERIOD) == OS_OK, "sleep until after overrun");
+		Test_Check(Os_GetTicks() == ((TEST_PERIODS * TEST_PERIOD) + TEST_PERIOD + 2u),
+		           "overrun release waited");
+		Test_Check(last == ((TEST_PERIODS + 1u) * TEST_PERIOD), "overrun release slipped");
+		Test_Running--;
+}
+
+/*** 4. Event flags: the waiter runs above the setter ***/
+static void Test_WaiterEntry(void * arg)
+{
+		unsigned int flags;
+		unsigned int start;
+
+		(void)arg;
+		/* ANY with clear-on-exit: one flag releases, only the waited flags are cleared */
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_D);
+		flags = 0u;
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_A | TEST_EVENT_B, OS_EVENT_ANY | OS_EVENT_CLEAR,
+		                        OS_WAIT_FOREVER, &flags) == OS_OK, "any wait");
+		Test_Check(flags == (TEST_EVENT_B | TEST_EVENT_D), "any wait flags seen");
+		Test_Check(Test_Event.flags == TEST_EVENT_D, "clear on exit cleared other flags");
+
+		/* ALL without clear: released by the last flag only, the flags stay set */
+		flags = 0u;
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_A | TEST_EVENT_C, OS_EVENT_ALL, OS_WAIT_FOREVER,
+		                        &flags) == OS_OK, "all wait");
+		Test_Check(flags == (TEST_EVENT_A | TEST_EVENT_C | TEST_EVENT_D), "all wait flags seen");
+		Test_Check(Test_Event.flags == (TEST_EVENT_A | TEST_EVENT_C | TEST_EVENT_D), "all wait cleared");
+
+		/* Condition already met: no block, clear-on-exit still applies */
+		flags = 0u;
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_A | TEST_EVENT_C, OS_EVENT_ALL | OS_EVENT_CLEAR,
+		                        OS_NO_WAIT, &flags) == OS_OK, "met wait");
+		Test_Check(flags == (TEST_EVENT_A | TEST_EVENT_C | TEST_EVENT_D), "met wait flags seen");
+		Test_Check(Test_Event.flags == TEST_EVENT_D, "met wait clear");
+
+		/* Parameter and no-wait results */
+		Test_Check(Os_EventWait(&Test_Event, 0u, OS_EVENT_ANY, OS_WAIT_FOREVER, NULL) == OS_ERR_PARA,
+		           "empty mask accepted");
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_E, OS_EVENT_ANY, OS_NO_WAIT, NULL) == OS_ERR_TIMEOUT,
+		           "no wait result");
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_A | TEST_EVENT_D, OS_EVENT_ALL, OS_NO_WAIT, NULL)
+		           == OS_ERR_TIMEOUT, "no wait all with one flag missing");
+
+		/* Timeout: exactly the ticks asked for, the flags seen stay untouched */
+		start = Os_GetTicks();
+		flags = 0xFFFFFFFFu;
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_E, OS_EVENT_ANY, 4u, &flags) == OS_ERR_TIMEOUT,
+		           "timeout result");
+		Test_Check(Os_GetTicks() == (start + 4u), "timeout length");
+		Test_Check(flags == 0xFFFFFFFFu, "timeout wrote the flags seen");
+
+		/* Released before the timeout: the pending timeout must not wake a later sleep */
+		Test_Check(Os_EventWait(&Test_Event, TEST_EVENT_F, OS_EVENT_ANY | OS_EVENT_CLEAR, 10u, &flags)
+		           == OS_OK, "wait released before its timeout");
+		Test_Check(Os_GetTicks() == (start + 6u), "release tick");
+		start = Os_GetTicks();
+		(void)Os_Sleep(20u);
+		Test_Check(Os_GetTicks() == (start + 20u), "stale timeout woke a sleep");
+		Test_Running--;
+}
+
+static void Test_SetterEntry(void * arg)
+{
+		(void)arg;
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_B);
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_A);
+		Test_Check(Test_Tasks[0].state == OS_TASK_BLOCKED, "all wait released by one flag");
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_C);
+		/* The waiter is now in its timed waits */
+		Test_Burn(6u);
+		(void)Os_EventSet(&Test_Event, TEST_EVENT_F);
+		Test_Running--;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+		unsigned int i;
+
+		/* 1. Creation, wake-up and an interrupt preempt the lower priority task */
+		Test_Start();
+		Test_Create(2u, Test_HighEntry, NULL, 3u);
+		Test_Create(0u, Test_LowEntry, NULL, 1u);
+		Test_Run();
+		printf("preemption: woken at tick %u, low task at tick %u\n", Test_HighWake, Test_HighSawLow);
+
+		/* 2. Two busy tasks of one priority hand over on every tick */
+		Test_Start();
+		Test_OrderCount = 0u;
+		Test_Create(0u, Test_RoundRobinEntry, (void *)"A", 2u);
+		Test_Create(1u, Test_RoundRobinEntry, (void *)"B", 2u);
+		Test_Run();
+		Test_Order[Test_OrderCount] = '\0';
+		printf("round-robin: %s\n", Test_Order);
+		Test_Check(Test_OrderCount == (2u * TEST_RR_SLICES), "round-robin slices");
+		for (i = 0u; i < Test_OrderCount; i++)
+		{
+			Test_Check(Test_Order[i] == (((i % 2u) == 0u) ? 'A' : 'B'), "round-robin order");
+		}
+
+		/* 3. Periodic release without drift */
+		Test_Start();
+		Test_Create(0u, Test_PeriodicEntry, NULL, 2u);
+		Test_Run();
+		printf("periodic:");
+		for (i = 0u; i < TEST_PERIODS; i++)
+		{
+			printf(" %u", Test_Releases[i]);
+			Test_Check(Test_Releases[i] == ((i + 1u) * TEST_PERIOD), "periodic release");
+		}
+		printf("\n");
+
+		/* 4. Event flags */
+		Test_Start();
+		Test_Create(0u, Test_WaiterEntry, NULL, 3u);
+		Test_Create(1u, Test_SetterEntry, NULL, 2u);
+		Test_Run();
+		printf("events: any, all, clear on exit, no wait, timeout checked at tick %u\n", Os_GetTicks());
+
+		printf("PASS\n");
+		return 0;
+}
@@ -0,0 +1,386 @@
+#!/usr/bin/env python3
+"""Host tool for the serial command protocol (Middleware/inc/Proto.h).
+
+Frames are COBS encoded and end with a zero byte. A request is
+    [seq] [cmd] [payload] [crc16 LE]
+and a response is
+    [seq] [cmd | 0x80] [status] [payload] [crc16 LE]
+with CRC-16/CCITT-FALSE over every byte before the CRC.
+
+Examples:
+    protoctl.py --port /dev/ttyUSB0 get-time
+    protoctl.py --port /dev/ttyUSB0 set-time now
+    protoctl.py --port /dev/ttyUSB0 brightness 60 --fade 500
+    protoctl.py --port /dev/ttyUSB0 stack
+    protoctl.py --port /dev/ttyUSB0 power --mhz 80
+    protoctl.py --port /dev/ttyUSB0 reset --mhz 80
+    protoctl.py --sim bench --count 2000
+    protoctl.py --sim selftest
+
+--sim starts Tools/protosim.c, the firmware Proto.c built for the host behind a pseudo-terminal,
+so the tool and the firmware side of the protocol can be tested end to end without a board.
+Build it first, see the header of protosim.c.
+"""
+
+import argparse
+import os
+import select
+import struct
+import subprocess
+import sys
+import termios
+import time
+import tty
+
+CMD_PING = 0x00
+CMD_GET_TIME = 0x01
+CMD_SET_TIME = 0x02
+CMD_SET_ALARM = 0x03
+CMD_CLEAR_ALARM = 0x04
+CMD_SET_BRIGHTNESS = 0x05
+CMD_GET_STATUS = 0x06
+CMD_GET_STACK = 0x07
+CMD_GET_POWER = 0x08
+CMD_GET_RESET = 0x09
+
+RESPONSE_FLAG = 0x80
+MAX_PAYLOAD = 32
+
+RESET_CAUSES = ((1, "LVD"), (2, "LOC"), (3, "LOL"), (5, "WDOG"), (6, "PIN"), (7, "POR"), (8, "JTAG"),
+                (9, "LOCKUP"), (10, "SW"), (11, "MDM_AP"), (13, "SACKERR"))
+
+STATUS_NAMES = {0: "OK", 1: "UNKNOWN", 2: "BAD_LENGTH", 3: "BAD_VALUE", 4: "BUSY"}
+
+BAUD_RATES = {
+    9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+    57600: termios.B57600, 115200: termios.B115200, 230400: termios.B230400,
+    460800: getattr(termios, "B460800", termios.B230400),
+    921600: getattr(termios, "B921600", termios.B230400),
+    1000000: getattr(termios, "B1000000", termios.B230400),
+}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, same as Proto_Crc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+    out[code_index] = code
+    out.append(0)
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("bad COBS frame")
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def seal(body):
+    return body + struct.pack("<H", crc16(body))
+
+
+def unseal(frame):
+    if len(frame) < 2 or crc16(frame[:-2]) != struct.unpack("<H", frame[-2:])[0]:
+        raise ValueError("CRC mismatch")
+    return frame[:-2]
+
+
+class Link:
+    """Raw serial link on a tty file descriptor."""
+
+    def __init__(self, path, baud):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = BAUD_RATES.get(baud, termios.B115200)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        self.pending = bytearray()
+        self.seq = 0
+
+    def close(self):
+        os.close(self.fd)
+
+    def read_frame(self, timeout):
+        deadline = time.monotonic() + timeout
+        while 0 not in self.pending:
+            left = deadline - time.monotonic()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                return None
+            self.pending += os.read(self.fd, 4096)
+        end = self.pending.index(0)
+        frame = bytes(self.pending[:end])
+        del self.pending[:end + 1]
+        return frame
+
+    def request(self, cmd, payload=b"", timeout=0.5, retries=3):
+        """Sends a request and returns (status, payload); retries reuse the sequence number."""
+        self.seq = (self.seq + 1) & 0xFF
+        frame = cobs_encode(seal(bytes([self.seq, cmd]) + payload))
+        for _ in range(retries):
+            os.write(self.fd, frame)
+            while True:
+                raw = self.read_frame(timeout)
+                if raw is None:
+                    break
+                try:
+                    body = unseal(cobs_decode(raw))
+                except ValueError:
+                    continue
+                if len(body) >= 3 and body[0] == self.seq and body[1] == (cmd | RESPONSE_FLAG):
+                    return body[2], body[3:]
+        raise TimeoutError("no response to command 0x%02X" % cmd)
+
+
+def start_sim(path, baud):
+    """Starts protosim and returns the process and the pty path it prints."""
+    proc = subprocess.Popen([path, str(baud)], stdout=subprocess.PIPE, universal_newlines=True)
+    line = proc.stdout.readline().strip()
+    if not line.startswith("/"):
+        proc.kill()
+        sys.exit("error: %s did not start: %s" % (path, line))
+    return proc, line
+
+
+def selftest(link):
+    """Runs every command against the firmware and checks the answers; returns failed checks."""
+    failures = []
+
+    def expect(name, got, want):
+        print("%-34s %s" % (name, "ok" if got == want else "FAILED (%r, expected %r)" % (got, want)))
+        if got != want:
+            failures.append(name)
+
+    status, out = link.request(CMD_PING, b"\x00\x01\x00echo")
+    expect("ping echoes zeros", (status, out), (0, b"\x00\x01\x00echo"))
+    expect("set-time", link.request(CMD_SET_TIME, struct.pack("<II", 1730419200, 5000000))[0], 0)
+    status, out = link.request(CMD_GET_TIME)
+    sec, ns = struct.unpack("<II", out) if status == 0 else (0, 0)
+    expect("get-time follows set-time", (status, sec - 1730419200 <= 1), (0, True))
+    expect("set-time rejects 1e9 ns", link.request(CMD_SET_TIME, struct.pack("<II", 0, 1000000000))[0], 3)
+    status, out = link.request(CMD_GET_STATUS)
+    alarms = struct.unpack("<BHI", out)[1] if status == 0 else -1
+    expect("set-alarm", link.request(CMD_SET_ALARM, struct.pack("<BIB", 1, 7 * 3600, 0x3E))[0], 0)
+    expect("set-alarm replaces the slot", link.request(CMD_SET_ALARM, struct.pack("<BIB", 1, 8 * 3600, 0x3E))[0], 0)
+    expect("set-alarm rejects 24:00", link.request(CMD_SET_ALARM, struct.pack("<BIB", 2, 86400, 0x7F))[0], 3)
+    expect("set-alarm rejects an empty mask", link.request(CMD_SET_ALARM, struct.pack("<BIB", 2, 60, 0))[0], 3)
+    expect("set-alarm rejects a bad slot", link.request(CMD_SET_ALARM, struct.pack("<BIB", 200, 60, 1))[0], 3)
+    status, out = link.request(CMD_GET_STATUS)
+    expect("status counts one alarm more", (status, struct.unpack("<BHI", out)[1] - alarms), (0, 1))
+    expect("clear-alarm", link.request(CMD_CLEAR_ALARM, bytes([1]))[0], 0)
+    expect("clear-alarm of an empty slot", link.request(CMD_CLEAR_ALARM, bytes([1]))[0], 0)
+    expect("brightness", link.request(CMD_SET_BRIGHTNESS, struct.pack("<BH", 60, 500))[0], 0)
+    expect("brightness rejects 101", link.request(CMD_SET_BRIGHTNESS, struct.pack("<BH", 101, 0))[0], 3)
+    status, out = link.request(CMD_GET_STATUS)
+    level, count, _frames = struct.unpack("<BHI", out) if status == 0 else (0, 0, 0)
+    expect("status after clear and brightness", (status, level, count), (0, 60, alarms))
+    expect("stack index past the end", link.request(CMD_GET_STACK, bytes([99]))[0], 3)
+    expect("power answers 22 bytes", len(link.request(CMD_GET_POWER)[1]), 22)
+    expect("reset answers 22 bytes", len(link.request(CMD_GET_RESET)[1]), 22)
+    expect("bad length", link.request(CMD_GET_TIME, b"x")[0], 2)
+    expect("unknown command", link.request(0x7E)[0], 1)
+
+    # A lost response: the same sequence number is answered again without executing twice
+    link.seq = (link.seq + 1) & 0xFF
+    frame = cobs_encode(seal(bytes([link.seq, CMD_SET_ALARM]) + struct.pack("<BIB", 3, 60, 1)))
+    os.write(link.fd, frame)
+    first = link.read_frame(0.5)
+    os.write(link.fd, frame)
+    again = link.read_frame(0.5)
+    status, out = link.request(CMD_GET_STATUS)
+    expect("retry answered, executed once", (first is not None, first == again, struct.unpack("<BHI", out)[1] - alarms),
+           (True, True, 1))
+    link.request(CMD_CLEAR_ALARM, bytes([3]))
+
+    # A corrupted frame is dropped; the next one is still answered
+    os.write(link.fd, cobs_encode(b"\x01\x00\x12\x34"))
+    expect("bad CRC dropped", link.read_frame(0.2), None)
+
+    # Requests sent back to back fill the transmit ring: every response must arrive whole
+    frames = b"".join(cobs_encode(seal(bytes([seq, CMD_PING]) + bytes(range(1, MAX_PAYLOAD + 1))))
+                      for seq in range(100, 140))
+    os.write(link.fd, frames)
+    answered = 0
+    while True:
+        raw = link.read_frame(0.5)
+        if raw is None:
+            break
+        try:
+            body = unseal(cobs_decode(raw))
+        except ValueError:
+            continue
+        if body[3:] == bytes(range(1, MAX_PAYLOAD + 1)):
+            answered += 1
+    expect("40 pipelined pings, none truncated", answered, 40)
+    link.seq = 140
+    return failures
+
+
+def describe_causes(causes):
+    names = [name for bit, name in RESET_CAUSES if causes & (1 << bit)]
+    return ", ".join(names) if names else "none"
+
+
+def check(status):
+    if status != 0:
+        sys.exit("error: %s" % STATUS_NAMES.get(status, status))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    where = parser.add_mutually_exclusive_group(required=True)
+    where.add_argument("--port", help="serial device")
+    where.add_argument("--sim", action="store_true", help="start the host build of the firmware protocol")
+    parser.add_argument("--protosim", default="./protosim", help="protosim binary for --sim")
+    parser.add_argument("--baud", type=int, default=115200)
+    sub = parser.add_subparsers(dest="command", required=True)
+    sub.add_parser("ping")
+    sub.add_parser("get-time")
+    st = sub.add_parser("set-time")
+    st.add_argument("seconds", help="Unix seconds, or 'now'")
+    sa = sub.add_parser("set-alarm")
+    sa.add_argument("slot", type=int)
+    sa.add_argument("time", help="HH:MM[:SS]")
+    sa.add_argument("--days", type=lambda v: int(v, 0), default=0x7F, help="weekday mask, bit 0 = Sunday")
+    ca = sub.add_parser("clear-alarm")
+    ca.add_argument("slot", type=int)
+    br = sub.add_parser("brightness")
+    br.add_argument("level", type=int)
+    br.add_argument("--fade", type=int, default=0, help="fade duration in ms")
+    sub.add_parser("status")
+    sub.add_parser("stack", help="high-water mark of every registered stack")
+    pw = sub.add_parser("power", help="power-fail save latency")
+    pw.add_argument("--mhz", type=float, default=80.0, help="core clock, to convert cycles")
+    rs = sub.add_parser("reset", help="reason of the last reset, watchdog refresh cost")
+    rs.add_argument("--mhz", type=float, default=80.0, help="core clock, to convert cycles")
+    be = sub.add_parser("bench", help="measure sustained commands per second")
+    be.add_argument("--count", type=int, default=1000)
+    be.add_argument("--size", type=int, default=8, help="ping payload size")
+    sub.add_parser("selftest", help="check every command against the firmware")
+    args = parser.parse_args()
+
+    sim = None
+    if args.sim:
+        sim, path = start_sim(args.protosim, args.baud)
+        link = Link(path, args.baud)
+    else:
+        link = Link(args.port, args.baud)
+
+    try:
+        if args.command == "ping":
+            status, _ = link.request(CMD_PING, b"ping")
+            check(status)
+            print("pong")
+        elif args.command == "get-time":
+            status, out = link.request(CMD_GET_TIME)
+            check(status)
+            sec, ns = struct.unpack("<II", out)
+            print("%s.%09d" % (time.strftime("%Y-%m-%d %H:%M:%S", time.gmtime(sec)), ns))
+        elif args.command == "set-time":
+            now = time.time() if args.seconds == "now" else float(args.seconds)
+            check(link.request(CMD_SET_TIME, struct.pack("<II", int(now), int((now % 1) * 1e9)))[0])
+        elif args.command == "set-alarm":
+            parts = [int(p) for p in args.time.split(":")] + [0]
+            tod = parts[0] * 3600 + parts[1] * 60 + parts[2]
+            check(link.request(CMD_SET_ALARM, struct.pack("<BIB", args.slot, tod, args.days))[0])
+        elif args.command == "clear-alarm":
+            check(link.request(CMD_CLEAR_ALARM, bytes([args.slot]))[0])
+        elif args.command == "brightness":
+            check(link.request(CMD_SET_BRIGHTNESS, struct.pack("<BH", args.level, args.fade))[0])
+        elif args.command == "status":
+            status, out = link.request(CMD_GET_STATUS)
+            check(status)
+            level, alarms, frames = struct.unpack("<BHI", out)
+            print("brightness %d, %d alarms, %d frames" % (level, alarms, frames))
+        elif args.command == "stack":
+            print("%4s %8s %8s %6s" % ("id", "size", "used", "peak"))
+            index = 0
+            while True:
+                status, out = link.request(CMD_GET_STACK, bytes([index]))
+                if status == 3:
+                    break
+                check(status)
+                ident, overflow, size, used = struct.unpack("<BBII", out)
+                print("%4d %8d %8d %5.0f%%%s" % (ident, size, used, 100.0 * used / size,
+                                                 "  OVERFLOW" if overflow else ""))
+                index += 1
+        elif args.command == "power":
+            status, out = link.request(CMD_GET_POWER)
+            check(status)
+            saves, snapshot, total, worst, lost, left, restored = struct.unpack("<IIIIIBB", out)
+            print("time restored at boot  %s" % ("yes" if restored else "no"))
+            print("warnings handled       %d, %d snapshots lost" % (saves, lost))
+            for name, cycles in (("last snapshot", snapshot), ("last save", total), ("worst save", worst)):
+                print("%-22s %d cycles, %.1f us" % (name, cycles, cycles / args.mhz))
+            print("settings left dirty    %d" % left)
+        elif args.command == "reset":
+            status, out = link.request(CMD_GET_RESET)
+            check(status)
+            causes, sticky, refreshes, refresh, worst, task, expired = struct.unpack("<IIIIIBB", out)
+            print("last reset             %s" % describe_causes(causes))
+            print("since power-on         %s" % describe_causes(sticky))
+            print("late task              %s%s" % ("none" if task == 0xFF else task,
+                                                   ", pre-reset interrupt ran" if expired else ""))
+            print("refreshes              %d" % refreshes)
+            for name, cycles in (("last refresh", refresh), ("worst check", worst)):
+                print("%-22s %d cycles, %.2f us" % (name, cycles, cycles / args.mhz))
+        elif args.command == "bench":
+            payload = bytes(range(1, min(args.size, MAX_PAYLOAD) + 1))
+            worst = 0.0
+            start = time.perf_counter()
+            for _ in range(args.count):
+                t0 = time.perf_counter()
+                status, out = link.request(CMD_PING, payload)
+                worst = max(worst, time.perf_counter() - t0)
+                if status != 0 or out != payload:
+                    sys.exit("error: bad echo")
+            elapsed = time.perf_counter() - start
+            print("%d commands in %.3f s: %.0f commands/s, mean %.3f ms, worst %.3f ms" %
+                  (args.count, elapsed, args.count / elapsed, 1e3 * elapsed / args.count, 1e3 * worst))
+        elif args.command == "selftest":
+            failures = selftest(link)
+            print("FAIL" if failures else "PASS")
+            if failures:
+                sys.exit(1)
+    finally:
+        link.close()
+        if sim is not None:
+            sim.terminate()
+            sim.wait()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,396 @@
+/****************************************************************************************************
+* @file    protosim.c
+* @author  Ma Hien Nhan
+* @brief   Host build of the serial command protocol (Proto) behind a pseudo-terminal.
+* @details This file runs the firmware Proto.c, with Calib.c, Alarm.c and the COBS/CRC code of
+*          Utilitie.c, on the master side of a pseudo-terminal and prints the slave path on the
+*          first line of stdout. The LPUART is replaced by two rings with the API of Lpuart.h: the
+*          receive ring is filled from the pty as far as it has room, and the transmit ring is
+*          drained at the line rate, so a response larger than the free space is held back as on
+*          the board. Brightness is stubbed with fixed values, and fixed handlers of
+*          PROTO_CMD_GET_STACK, PROTO_CMD_GET_POWER and PROTO_CMD_GET_RESET are registered in place
+*          of the ones of Stack_Init(), Brownout_Init() and Supervisor_Init().
+*          The protocol statistics are printed to stderr on SIGINT or SIGTERM. protoctl.py --sim
+*          starts this program and talks to it. Build and run from the repository root:
+*              gcc -O2 -DCALIB_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o protosim
+*                  Tools/protosim.c Middleware/src/Proto.c Middleware/src/Calib.c
+*                  Middleware/src/Alarm.c Utilitie/Utilitie.c
+*              ./protosim [baud]
+* @version 1.0.0
+* @date    2024-11-05
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#define _GNU_SOURCE
+#include "Proto.h"
+#include "Calib.h"
+#include "Alarm.h"
+#include "Brightness.h"
+#include "Stack.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_UART                        (1u)
+#define SIM_RX_SIZE                     (256u)             /* Same rings as the board configuration */
+#define SIM_TX_SIZE                     (128u)
+#define SIM_DEFAULT_BAUD                (115200u)
+#define SIM_BITS_PER_BYTE               (10u)              /* 8N1 */
+#define SIM_CORE_HZ                     (80000000u)
+#define SIM_TICK_NS                     (1000000u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+/* LPUART rings */
+static unsigned char         Sim_Rx[SIM_RX_SIZE];
+static unsigned short        Sim_RxHead;
+static unsigned short        Sim_RxTail;
+static unsigned char         Sim_Tx[SIM_TX_SIZE];
+static unsigned short        Sim_TxHead;
+static unsigned short        Sim_TxTail;
+
+/* Stubbed services */
+static unsigned char         Sim_Level;
+static const Stack_UsageType Sim_Stacks[] =
+{
+			{ 4096u, 1320u, 0u, 0u },
+			{ 1024u,  612u, 1u, 0u },
+			{  512u,  512u, 2u, 1u },
+};
+
+static volatile sig_atomic_t Sim_Stop;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Stops the main loop.
+ */
+static void Sim_OnSignal(int sig)
+{
+		(void)sig;
+		Sim_Stop = 1;
+}
+
+/*!
+ * @brief Monotonic time in nanoseconds.
+ */
+static unsigned long long Sim_NowNs(void)
+{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ((unsigned long long)ts.tv_sec * 1000000000ull) + (unsigned long long)ts.tv_nsec;
+}
+
+/*!
+ * @brief Alarm notification, printed like a buzzer.
+ */
+static void Sim_OnAlarm(unsigned short id, void * userData)
+{
+		(void)userData;
+		fprintf(stderr, "alarm %u fired\n", id);
+}
+
+
+/*==================================================================================================
+*                                       LPUART STUB
+==================================================================================================*/
+unsigned short Lpuart_Peek(unsigned char instance, unsigned char ** DataPtr)
+{
+		unsigned short count = (unsigned short)(Sim_RxHead - Sim_RxTail);
+		unsigned short index = (unsigned short)(Sim_RxTail % SIM_RX_SIZE);
+
+		(void)instance;
+		*DataPtr = &Sim_Rx[index];
+		return (count < (SIM_RX_SIZE - index)) ? count : (unsigned short)(SIM_RX_SIZE - index);
+}
+
+unsigned short Lpuart_GetRxCount(unsigned char instance)
+{
+		(void)instance;
+		return (unsigned short)(Sim_RxHead - Sim_RxTail);
+}
+
+void Lpuart_Consume(unsigned char instance, unsigned short count)
+{
+		(void)instance;
+		Sim_RxTail = (unsigned short)(Sim_RxTail + count);
+}
+
+unsigned short Lpuart_GetTxFree(unsigned char instance)
+{
+		(void)instance;
+		return (unsigned short)(SIM_TX_SIZE - (unsigned short)(Sim_TxHead - Sim_TxTail));
+}
+
+unsigned short Lpuart_WriteBegin(unsigned char instance, unsigned char ** DataPtr)
+{
+		unsigned short index = (unsigned short)(Sim_TxHead % SIM_TX_SIZE);
+		unsigned short space = Lpuart_GetTxFree(instance);
+
+		*DataPtr = &Sim_Tx[index];
+		return (space < (SIM_TX_SIZE - index)) ? space : (unsigned short)(SIM_TX_SIZE - index);
+}
+
+void Lpuart_WriteCommit(unsigned char instance, unsigned short count)
+{
+		(void)instance;
+		Sim_TxHead = (unsigned short)(Sim_TxHead + count);
+}
+
+unsigned short Lpuart_Write(unsigned char instance, const unsigned char * DataPtr, unsigned short length)
+{
+		unsigned short index;
+
+		if (length > Lpuart_GetTxFree(instance))
+		{
+			length = Lpuart_GetTxFree(instance);
+		}
+		for (index = 0u; index < length; index++)
+		{
+			Sim_Tx[(unsigned short)(Sim_TxHead + index) % SIM_TX_SIZE] = DataPtr[index];
+		}
+		Sim_TxHead = (unsigned short)(Sim_TxHead + length);
+
+		return length;
+}
+
+
+/*==================================================================================================
+*                                       SERVICE STUBS
+==================================================================================================*/
+Brightness_ret_t Brightness_FadeTo(unsigned char level, unsigned int durationMs)
+{
+		(void)durationMs;
+		if (level > BRIGHTNESS_LEVEL_MAX)
+		{
+			return BRIGHTNESS_ERR_PARA;
+		}
+		Sim_Level = level;
+		return BRIGHTNESS_OK;
+}
+
+unsigned char Brightness_GetLevel(void)
+{
+		return Sim_Level;
+}
+
+static Proto_status_t Sim_HandleGetStack(const unsigned char * Request, unsigned char length,
+                                         unsigned char * Response, unsigned char * ResponseLength)
+{
+		const Stack_UsageType * usage;
+		unsigned char index;
+
+		(void)length;
+
+		if (Request[0] >= (sizeof(Sim_Stacks) / sizeof(Sim_Stacks[0])))
+		{
+			return PROTO_STATUS_BAD_VALUE;
+		}
+		usage = &Sim_Stacks[Request[0]];
+
+		Response[0] = usage->id;
+		Response[1] = usage->overflow;
+		for (index = 0u; index < 4u; index++)
+		{
+			Response[2u + index] = (unsigned char)(usage->sizeBytes >> (index * 8u));
+			Response[6u + index] = (unsigned char)(usage->usedBytes >> (index * 8u));
+		}
+		*ResponseLength = 10u;
+		return PROTO_STATUS_OK;
+}
+
+static Proto_status_t Sim_HandleGetPower(const unsigned char * Request, unsigned char length,
+                                         unsigned char * Response, unsigned char * ResponseLength)
+{
+		static const unsigned int words[5] = { 3u, 15200u, 41800u, 58300u, 0u };
+		unsigned char index;
+
+		(void)Request;
+		(void)length;
+
+		for (index = 0u; index < 20u; index++)
+		{
+			Response[index] = (unsigned char)(words[index / 4u] >> ((index % 4u) * 8u));
+		}
+		Response[20] = 0u;                          /* Keys left */
+		Response[21] = 1u;                          /* Restored */
+		*ResponseLength = 22u;
+		return PROTO_STATUS_OK;
+}
+
+static Proto_status_t Sim_HandleGetReset(const unsigned char * Request, unsigned char length,
+                                         unsigned char * Response, unsigned char * ResponseLength)
+{
+		static const unsigned int words[5] = { 0x20u, 0xA2u, 5120u, 4u, 196u };
+		unsigned char index;
+
+		(void)Request;
+		(void)length;
+
+		for (index = 0u; index < 20u; index++)
+		{
+			Response[index] = (unsigned char)(words[index / 4u] >> ((index % 4u) * 8u));
+		}
+		Response[20] = 2u;                          /* Late task */
+		Response[21] = 1u;                          /* Expired */
+		*ResponseLength = 22u;
+		return PROTO_STATUS_OK;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const Proto_CommandType commands[PROTO_CMD_COUNT] =
+		{
+			{ Proto_HandlePing,          0u, PROTO_MAX_PAYLOAD },
+			{ Proto_HandleGetTime,       0u, 0u },
+			{ Proto_HandleSetTime,       8u, 8u },
+			{ Proto_HandleSetAlarm,      6u, 6u },
+			{ Proto_HandleClearAlarm,    1u, 1u },
+			{ Proto_HandleSetBrightness, 3u, 3u },
+			{ Proto_HandleGetStatus,     0u, 0u },
+			{ NULL,                      0u, 0u },      /* Registered below */
+			{ NULL,                      0u, 0u },      /* Registered below */
+			{ NULL,                      0u, 0u },      /* Registered below */
+		};
+		static const Proto_ConfigType protoConfig = { SIM_UART, commands, PROTO_CMD_COUNT, Sim_OnAlarm };
+		static const Calib_ConfigType calibConfig =
+		{
+			CALIB_REF_1PPS, SIM_CORE_HZ, 1u, 16u, SIM_TICK_NS, 2u, { 0u, 0u, 0u }
+		};
+		static const Alarm_ConfigType alarmConfig = { NULL };
+		unsigned int baud = (argc > 1) ? (unsigned int)atoi(argv[1]) : SIM_DEFAULT_BAUD;
+		unsigned long long lastNs;
+		unsigned long long lineNs = 0u;               /* Time credited to the transmitter */
+		unsigned long long tickNs = 0u;               /* Time credited to the 1 ms tick */
+		unsigned long long byteNs;
+		struct termios attrs;
+		struct pollfd pfd;
+		Proto_StatsType stats;
+		unsigned int seconds;
+		int master;
+		int slave;
+
+		master = posix_openpt(O_RDWR | O_NOCTTY);
+		if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+		{
+			printf("FAIL: no pseudo-terminal\n");
+			return 1;
+		}
+		/* Keep the slave open, so the master does not see a hang-up between two clients */
+		slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+		if ((slave < 0) || (tcgetattr(slave, &attrs) != 0))
+		{
+			printf("FAIL: no pseudo-terminal\n");
+			return 1;
+		}
+		cfmakeraw(&attrs);
+		(void)tcsetattr(slave, TCSANOW, &attrs);
+		(void)fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+		signal(SIGINT, Sim_OnSignal);
+		signal(SIGTERM, Sim_OnSignal);
+
+		/* Stack_Init(), Brownout_Init() and Supervisor_Init() register them on the board */
+		(void)Proto_Register(PROTO_CMD_GET_STACK, Sim_HandleGetStack, 1u, 1u);
+		(void)Proto_Register(PROTO_CMD_GET_POWER, Sim_HandleGetPower, 0u, 0u);
+		(void)Proto_Register(PROTO_CMD_GET_RESET, Sim_HandleGetReset, 0u, 0u);
+		if ((Calib_Init(&calibConfig) != CALIB_OK) || (Proto_Init(&protoConfig) != PROTO_OK))
+		{
+			printf("FAIL: init\n");
+			return 1;
+		}
+		Calib_SetTime((unsigned int)time(NULL), 0u);
+		(void)Alarm_Init(&alarmConfig, (unsigned int)time(NULL));
+
+		printf("%s\n", ptsname(master));
+		fflush(stdout);
+
+		byteNs = (1000000000ull * SIM_BITS_PER_BYTE) / ((baud != 0u) ? baud : SIM_DEFAULT_BAUD);
+		lastNs = Sim_NowNs();
+		pfd.fd = master;
+		pfd.events = POLLIN;
+		while (Sim_Stop == 0)
+		{
+			unsigned long long nowNs;
+			unsigned short room;
+			unsigned short index;
+			ssize_t got;
+
+			(void)poll(&pfd, 1u, ((unsigned short)(Sim_TxHead - Sim_TxTail) != 0u) ? 0 : 1);
+			nowNs = Sim_NowNs();
+			tickNs += nowNs - lastNs;
+			lineNs += nowNs - lastNs;
+			lastNs = nowNs;
+
+			/* 1. SysTick */
+			while (tickNs >= SIM_TICK_NS)
+			{
+				tickNs -= SIM_TICK_NS;
+				Calib_Tick();
+			}
+			Calib_GetTime(&seconds, NULL);
+			Alarm_Process(seconds);
+
+			/* 2. Receiver: as much as the ring takes, the rest waits in the pty */
+			room = (unsigned short)(SIM_RX_SIZE - (unsigned short)(Sim_RxHead - Sim_RxTail));
+			while (room != 0u)
+			{
+				index = (unsigned short)(Sim_RxHead % SIM_RX_SIZE);
+				got = read(master, &Sim_Rx[index], ((unsigned short)(SIM_RX_SIZE - index) < room) ?
+				           (size_t)(SIM_RX_SIZE - index) : (size_t)room);
+				if (got <= 0)
+				{
+					break;
+				}
+				Sim_RxHead = (unsigned short)(Sim_RxHead + (unsigned short)got);
+				room = (unsigned short)(room - (unsigned short)got);
+			}
+
+			/* 3. Main loop of the firmware */
+			(void)Proto_Process();
+
+			/* 4. Transmitter at the line rate */
+			if (Sim_TxHead == Sim_TxTail)
+			{
+				lineNs = 0u;
+			}
+			while ((Sim_TxHead != Sim_TxTail) && (lineNs >= byteNs))
+			{
+				if (write(master, &Sim_Tx[Sim_TxTail % SIM_TX_SIZE], 1u) != 1)
+				{
+					break;
+				}
+				Sim_TxTail++;
+				lineNs -= byteNs;
+			}
+		}
+
+		(void)Proto_GetStats(&stats);
+		fprintf(stderr, "protosim: %u frames, %u duplicates, %u CRC errors, %u framing errors, %u deferred\n",
+		        stats.frames, stats.duplicates, stats.crcErrors, stats.framingErrors, stats.deferred);
+		close(slave);
+		close(master);
+
+		return 0;
+}
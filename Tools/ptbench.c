@@ -0,0 +1,166 @@
+/****************************************************************************************************
+* @file    ptbench.c
+* @author  Ma Hien Nhan
+* @brief   Host benchmark: stackless coroutines (Pt) against the preemptive kernel (Os).
+* @details Two tasks pass an event back and forth; every hand-over is one task switch. The
+*          benchmark prints the time per switch and the RAM per task of both schedulers. Build and
+*          run from the repository root:
+*              gcc -O2 -DPT_HOST -DOS_PORT_HOST -IDriver/inc -IUtilitie -IMiddleware/inc -o ptbench
+*                  Tools/ptbench.c Middleware/src/Pt.c Middleware/src/Os.c Middleware/src/Os_Port_Host.c
+*              ./ptbench
+* @version 1.0.0
+* @date    2024-11-09
+* @note    Host times only compare the two designs; the switch of the Os host port is a
+*          swapcontext() with a signal mask system call, much slower than PendSV on the target.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Pt.h"
+#include "Os.h"
+#include "Os_Port.h"
+#include <stdio.h>
+#include <time.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define BENCH_ROUNDS                    (1000000u)         /* Hand-overs per scheduler */
+#define BENCH_HOST_STACK_WORDS          (4096u)            /* Os host stacks hold a ucontext */
+#define BENCH_EVENT_PING                (0x1u)
+#define BENCH_EVENT_PONG                (0x2u)
+
+/*** Target sizes: Pt_TaskType, and Os_TaskType with the smallest stack and a saved FPU frame ***/
+#define BENCH_TARGET_PT_BYTES           (12u)
+#define BENCH_TARGET_OS_TCB_BYTES       (44u)
+#define BENCH_TARGET_OS_FRAME_BYTES     ((17u + 16u + 18u) * 4u)
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static unsigned int Bench_Count;
+static Pt_TaskType Bench_PtTasks[2];
+static Os_TaskType Bench_OsPing;
+static Os_TaskType Bench_OsPong;
+static Os_EventType Bench_OsEvent;
+static unsigned int Bench_IdleStack[BENCH_HOST_STACK_WORDS] __attribute__((aligned(16)));
+static unsigned int Bench_PingStack[BENCH_HOST_STACK_WORDS] __attribute__((aligned(16)));
+static unsigned int Bench_PongStack[BENCH_HOST_STACK_WORDS] __attribute__((aligned(16)));
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+static double Bench_Now(void)
+{
+		struct timespec now;
+
+		(void)clock_gettime(CLOCK_MONOTONIC, &now);
+		return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+static unsigned char Bench_PtPing(Pt_TaskType * PT)
+{
+		PT_BEGIN(PT);
+		while (Bench_Count < BENCH_ROUNDS)
+		{
+			Pt_SetEvent(BENCH_EVENT_PONG);
+			PT_AWAIT_EVENT(PT, BENCH_EVENT_PING);
+			Bench_Count++;
+		}
+		PT_END(PT);
+}
+
+static unsigned char Bench_PtPong(Pt_TaskType * PT)
+{
+		PT_BEGIN(PT);
+		while (Bench_Count < BENCH_ROUNDS)
+		{
+			PT_AWAIT_EVENT(PT, BENCH_EVENT_PONG);
+			Bench_Count++;
+			Pt_SetEvent(BENCH_EVENT_PING);
+		}
+		PT_END(PT);
+}
+
+static void Bench_OsPingEntry(void * arg)
+{
+		(void)arg;
+		while (Bench_Count < BENCH_ROUNDS)
+		{
+			(void)Os_EventSet(&Bench_OsEvent, BENCH_EVENT_PONG);
+			(void)Os_EventWait(&Bench_OsEvent, BENCH_EVENT_PING, OS_EVENT_CLEAR, OS_WAIT_FOREVER, NULL);
+			Bench_Count++;
+		}
+		Os_PortHostStop();
+}
+
+static void Bench_OsPongEntry(void * arg)
+{
+		(void)arg;
+		for (;;)
+		{
+			(void)Os_EventWait(&Bench_OsEvent, BENCH_EVENT_PONG, OS_EVENT_CLEAR, OS_WAIT_FOREVER, NULL);
+			Bench_Count++;
+			(void)Os_EventSet(&Bench_OsEvent, BENCH_EVENT_PING);
+		}
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+		static const Os_ConfigType osConfig = { NULL, Bench_IdleStack, BENCH_HOST_STACK_WORDS, NULL, NULL };
+		Os_TaskConfigType task;
+		Os_StatsType stats;
+		double start;
+		double ptNs;
+		double osNs;
+
+		/* 1. Coroutines: main loop calling Pt_Run() */
+		Bench_PtTasks[0].func = Bench_PtPing;
+		Bench_PtTasks[1].func = Bench_PtPong;
+		(void)Pt_Init(Bench_PtTasks, 2u);
+		Bench_Count = 0u;
+		start = Bench_Now();
+		while (Pt_Run() != 0u)
+		{
+		}
+		ptNs = (Bench_Now() - start) * 1e9 / Bench_Count;
+
+		/* 2. Preemptive kernel: ping at the higher priority, pong preempts nothing */
+		(void)Os_Init(&osConfig);
+		(void)Os_EventInit(&Bench_OsEvent);
+		task.arg = NULL;
+		task.stackWords = BENCH_HOST_STACK_WORDS;
+		task.entry = Bench_OsPingEntry;
+		task.stack = Bench_PingStack;
+		task.priority = 2u;
+		(void)Os_TaskCreate(&Bench_OsPing, &task);
+		task.entry = Bench_OsPongEntry;
+		task.stack = Bench_PongStack;
+		task.priority = 1u;
+		(void)Os_TaskCreate(&Bench_OsPong, &task);
+		Bench_Count = 0u;
+		start = Bench_Now();
+		Os_Start();
+		osNs = (Bench_Now() - start) * 1e9 / Bench_Count;
+		(void)Os_GetStats(&stats);
+
+		printf("%-28s %12s %12s\n", "", "Pt", "Os");
+		printf("%-28s %12.1f %12.1f\n", "host ns per switch", ptNs, osNs);
+		printf("%-28s %12u %12u\n", "host bytes per task", (unsigned int)sizeof(Pt_TaskType),
+		       (unsigned int)(sizeof(Os_TaskType) + (BENCH_HOST_STACK_WORDS * 4u)));
+		printf("%-28s %12u %12u\n", "target bytes per task", BENCH_TARGET_PT_BYTES,
+		       BENCH_TARGET_OS_TCB_BYTES + (OS_STACK_MIN_WORDS * 4u));
+		printf("%-28s %12s %12u\n", "target context frame bytes", "0", BENCH_TARGET_OS_FRAME_BYTES);
+		printf("Os switches counted by the kernel: %u\n", stats.switches);
+
+		return 0;
+}
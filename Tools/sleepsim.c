@@ -0,0 +1,447 @@
+/****************************************************************************************************
+* @file    sleepsim.c
+* @author  Ma Hien Nhan
+* @brief   Host simulation of the sleep manager (Sleep) against a power model of the S32K144.
+* @details This file compiles Driver/src/Sleep.c against host copies of the SCG, SMC and SCB
+*          registers and runs a digital clock for one hour: the RTC seconds interrupt redraws the
+*          time, a log record is sent on LPUART1 every minute, and a button on PORTC is pressed a
+*          few times a minute. CPU_WFI() advances the simulated time to the next interrupt that can
+*          wake the programmed mode, and the charge is integrated with the supply current of the
+*          mode the device is really in, including the time on FIRC while SOSC and SPLL restart
+*          after a stop mode. The report compares this with the time per state, the wake-ups per
+*          minute and the average current of Sleep_GetStats(), for the stop modes and for WAIT
+*          only. Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o sleepsim Tools/sleepsim.c -lm
+*              ./sleepsim [minutes]
+* @version 1.0.0
+* @date    2024-10-31
+* @note    Sleep.c is included by this file, after its registers and Cpu.h are replaced.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Sleep.h"
+#include "ClockGate.h"
+#include "Scb_Registers.h"
+#include "Smc_Registers.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+/*** Supply current of each mode (typical values, not a measurement) ***/
+#define SIM_RUN_SPLL_UA                 (26000u)           /* RUN, 80 MHz on SPLL */
+#define SIM_RUN_FIRC_UA                 (13000u)           /* RUN, 48 MHz on FIRC, while SPLL restarts */
+#define SIM_WAIT_UA                     (14000u)
+#define SIM_STOP_UA                     (1500u)            /* STOP1 */
+#define SIM_VLPS_UA                     (40u)
+
+/*** Clock restart after a stop mode ***/
+#define SIM_SOSC_RESTART_NS             (1500000ull)
+#define SIM_SPLL_LOCK_NS                (500000ull)        /* After the SOSC is valid */
+#define SIM_POLL_NS                     (60ull)            /* One poll of a CSR on FIRC */
+
+/*** Workload ***/
+#define SIM_SECOND_NS                   (1000000000ull)
+#define SIM_REDRAW_NS                   (1800000ull)       /* Time and colon redraw, every second */
+#define SIM_LOG_NS                      (4000000ull)       /* Log record formatting, every minute */
+#define SIM_LOG_TX_NS                   (9000000ull)       /* LPUART1 transmission of the record */
+#define SIM_BUTTON_NS                   (25000000ull)      /* Menu handling after a press */
+#define SIM_BUTTON_MEAN_NS              (15000000000ull)   /* Mean time between presses */
+#define SIM_DEFAULT_MINUTES             (60u)
+#define SIM_NEVER                       (~0ull)
+
+/*** Pass limit: average current of the model against the simulation ***/
+#define SIM_LIMIT_PERCENT               (10.0)
+
+/*** Host replacement of Cpu.h ***/
+#define CPU_H
+#define CPU_DSB()
+#define CPU_ISB()
+#define CPU_WFI()                       Sim_Wfi()
+#define Cpu_EnterCritical()             (0u)
+#define Cpu_ExitCritical(primask)       ((void)(primask))
+
+/*** Host registers ***/
+#undef SCG
+#undef SMC
+#undef SCB
+#define SCG                             (Sim_Scg())
+#define SMC                             (&Sim_SmcRegs)
+#define SCB                             (&Sim_ScbRegs)
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Result of one run.
+ */
+typedef struct
+{
+			unsigned long long               chargeUaNs[SLEEP_STATE_COUNT];  /*!< Charge integrated per state */
+			unsigned long long               timeNs[SLEEP_STATE_COUNT];      /*!< True time per state */
+			unsigned long long               restoreNs;                      /*!< Time on FIRC after stop modes */
+			unsigned int                     errors;                         /*!< Sleep_Enter() errors */
+} Sim_ResultType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static SCG_Type Sim_ScgRegs;
+static SMC_Type Sim_SmcRegs;
+static SCB_Type Sim_ScbRegs;
+
+static unsigned long long Sim_Now;                     /* Time in ns */
+static unsigned long long Sim_WakeAt;                  /* End of the last stop mode, SIM_NEVER if none */
+static unsigned long long Sim_NextSecond;
+static unsigned long long Sim_NextButton;
+static unsigned long long Sim_TxDone;                  /* SIM_NEVER while LPUART1 is idle */
+static Sleep_state_t Sim_State;                        /* Sleep state the current time is booked to */
+static Sim_ResultType Sim_Result;
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief Supply current in the RUN mode, from the system clock source.
+ */
+static unsigned int Sim_RunUa(void)
+{
+		return (((Sim_ScgRegs.CSR & SCG_CSR_SCS_MASK) >> SCG_RCCR_SCS_SHIFT) == (unsigned int)SPLL_CLK) ?
+		       SIM_RUN_SPLL_UA : SIM_RUN_FIRC_UA;
+}
+
+/*!
+ * @brief Advances the time at a supply current.
+ */
+static void Sim_Advance(unsigned long long ns, unsigned int ua)
+{
+		Sim_Now += ns;
+		Sim_Result.timeNs[Sim_State] += ns;
+		Sim_Result.chargeUaNs[Sim_State] += ns * ua;
+}
+
+/*!
+ * @brief Time passing on the CPU in RUN.
+ */
+static void Sim_Run(unsigned long long ns)
+{
+		Sim_State = SLEEP_STATE_RUN;
+		Sim_Advance(ns, Sim_RunUa());
+}
+
+/*!
+ * @brief SCG access: the system clock follows RCCR once its source is valid.
+ */
+static SCG_Type * Sim_Scg(void);
+
+/*!
+ * @brief Sleep time source: the RTC keeps counting in every mode.
+ */
+static unsigned int Sim_GetTimeMs(void)
+{
+		return (unsigned int)(Sim_Now / 1000000ull);
+}
+
+/*!
+ * @brief WFI: sleeps until the next interrupt that can wake the programmed mode.
+ */
+static void Sim_Wfi(void)
+{
+		unsigned long long wake = (Sim_NextSecond < Sim_NextButton) ? Sim_NextSecond : Sim_NextButton;
+		unsigned int ua;
+
+		if (((Sim_ScbRegs.SCR >> SCB_SCR_SLEEPDEEP_SHIFT) & VALUE_CHECK_BIT) == 0u)
+		{
+			/* WAIT keeps the bus clock: the LPUART1 completion also wakes */
+			Sim_State = SLEEP_STATE_WAIT;
+			ua = SIM_WAIT_UA;
+			if (Sim_TxDone < wake)
+			{
+				wake = Sim_TxDone;
+			}
+		}
+		else
+		{
+			Sim_State = (((Sim_SmcRegs.PMCTRL >> SMC_PMCTRL_STOPM_SHIFT) & SMC_PMCTRL_STOPM_MASK) == SMC_STOPM_VLPS) ?
+			            SLEEP_STATE_VLPS : SLEEP_STATE_STOP;
+			ua = (Sim_State == SLEEP_STATE_VLPS) ? SIM_VLPS_UA : SIM_STOP_UA;
+		}
+
+		Sim_Advance(wake - Sim_Now, ua);
+		if (Sim_State != SLEEP_STATE_WAIT)
+		{
+			Sim_WakeAt = Sim_Now;
+		}
+		/* Awake from here, on FIRC until Sleep_Enter() has restored the SPLL */
+		Sim_State = SLEEP_STATE_RUN;
+}
+
+static SCG_Type * Sim_Scg(void)
+{
+		if ((Sim_ScgRegs.CSR & SCG_CSR_SCS_MASK) != (Sim_ScgRegs.RCCR & SCG_CSR_SCS_MASK))
+		{
+			unsigned int source = (Sim_ScgRegs.RCCR & SCG_CSR_SCS_MASK) >> SCG_RCCR_SCS_SHIFT;
+			if ((source != (unsigned int)SPLL_CLK) || (Clock_IsScgSpllValid() != 0u))
+			{
+				Sim_ScgRegs.CSR = Sim_ScgRegs.RCCR;
+			}
+		}
+		return &Sim_ScgRegs;
+}
+
+/*!
+ * @brief Time spent on FIRC between a stop mode and Sleep_Enter() returning.
+ */
+static void Sim_RestorePoll(void)
+{
+		Sim_Advance(SIM_POLL_NS, Sim_RunUa());
+		Sim_Result.restoreNs += SIM_POLL_NS;
+}
+
+
+/*==================================================================================================
+*                                       SCG, NVIC AND CLOCKGATE MODEL
+==================================================================================================*/
+unsigned char Clock_IsScgSoscValid(void)
+{
+		Sim_RestorePoll();
+		return (unsigned char)((Sim_WakeAt == SIM_NEVER) || (Sim_Now >= (Sim_WakeAt + SIM_SOSC_RESTART_NS)));
+}
+
+unsigned char Clock_IsScgSpllValid(void)
+{
+		Sim_RestorePoll();
+		return (unsigned char)((Sim_WakeAt == SIM_NEVER) ||
+		                       (Sim_Now >= (Sim_WakeAt + SIM_SOSC_RESTART_NS + SIM_SPLL_LOCK_NS)));
+}
+
+void Clock_WriteScgRunModeConfig(const Scg_RunMode_ConfigType * ConfigPtr)
+{
+		Sim_ScgRegs.RCCR = (unsigned int)ConfigPtr->sys_clk_src << SCG_RCCR_SCS_SHIFT;
+}
+
+system_clock_source_t Clock_GetSysClockSource(void)
+{
+		return (system_clock_source_t)((SCG->CSR & SCG_CSR_SCS_MASK) >> SCG_RCCR_SCS_SHIFT);
+}
+
+void NVIC_EnableInterrupt(IRQn_Type IRQ_number)
+{
+		(void)IRQ_number;
+}
+
+unsigned char ClockGate_GetRefCount(clock_names_t clockName)
+{
+		return (unsigned char)((clockName == LPUART1_CLK) && (Sim_TxDone != SIM_NEVER));
+}
+
+
+/*==================================================================================================
+*                                       SLEEP MANAGER
+==================================================================================================*/
+#include "../Driver/src/Sleep.c"
+
+
+/*==================================================================================================
+*                                       SIMULATION
+==================================================================================================*/
+/*!
+ * @brief Next button press, exponentially distributed.
+ */
+static unsigned long long Sim_ButtonGap(void)
+{
+		double u = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+
+		return (unsigned long long)(-(double)SIM_BUTTON_MEAN_NS * log(u));
+}
+
+/*!
+ * @brief Runs the digital clock for a number of minutes.
+ */
+static unsigned char Sim_Execute(const Sleep_ConfigType * ConfigPtr, unsigned int minutes,
+                                 Sleep_StatsType * StatsPtr)
+{
+		static const Clock_ConfigImageType restoreImage =
+		{
+			0u, 0u, 0u, 0u, 0u, 0u, ((unsigned int)SPLL_CLK << SCG_RCCR_SCS_SHIFT), 0u, 0u, 1u, 1u
+		};
+		unsigned long long end = (unsigned long long)minutes * 60ull * SIM_SECOND_NS;
+		unsigned int seconds = 0u;
+		Sleep_ConfigType config = *ConfigPtr;
+
+		srand(7u);
+		Sim_Result = (Sim_ResultType){ { 0u }, { 0u }, 0u, 0u };
+		Sim_Now = 0u;
+		Sim_WakeAt = SIM_NEVER;
+		Sim_NextSecond = SIM_SECOND_NS;
+		Sim_NextButton = Sim_ButtonGap();
+		Sim_TxDone = SIM_NEVER;
+		Sim_State = SLEEP_STATE_RUN;
+		Sim_ScgRegs.RCCR = (unsigned int)SPLL_CLK << SCG_RCCR_SCS_SHIFT;
+		Sim_ScgRegs.CSR = Sim_ScgRegs.RCCR;
+		Sim_SmcRegs.PMSTAT = SMC_PMSTAT_RUN;
+		Sim_SmcRegs.PMPROT = (unsigned int)ENABLEMENT << SMC_PMPROT_AVLP_SHIFT;
+		Sim_SmcRegs.PMCTRL = 0u;
+		Sim_ScbRegs.SCR = 0u;
+
+		if (config.stopRunConfig != NULL)
+		{
+			config.restoreImage = &restoreImage;
+		}
+		if (Sleep_Init(&config) != SLEEP_OK)
+		{
+			return 0u;
+		}
+
+		while (Sim_Now < end)
+		{
+			Sleep_state_t state;
+			unsigned int idleMs;
+
+			/* 1. Interrupt handlers and the work they start */
+			if (Sim_Now >= Sim_TxDone)
+			{
+				Sim_TxDone = SIM_NEVER;
+			}
+			if (Sim_Now >= Sim_NextSecond)
+			{
+				Sim_NextSecond += SIM_SECOND_NS;
+				seconds++;
+				Sim_Run(SIM_REDRAW_NS);
+				if ((seconds % 60u) == 0u)
+				{
+					Sim_Run(SIM_LOG_NS);
+					Sim_TxDone = Sim_Now + SIM_LOG_TX_NS;
+				}
+			}
+			if (Sim_Now >= Sim_NextButton)
+			{
+				Sim_Run(SIM_BUTTON_NS);
+				Sim_NextButton = Sim_Now + Sim_ButtonGap();
+			}
+
+			/* 2. Idle: the next timer is the RTC second */
+			idleMs = (Sim_NextSecond > Sim_Now) ? (unsigned int)((Sim_NextSecond - Sim_Now) / 1000000ull) : 0u;
+			if (Sleep_Enter(idleMs, &state) != SLEEP_OK)
+			{
+				Sim_Result.errors++;
+			}
+			if (state == SLEEP_STATE_RUN)
+			{
+				unsigned long long next = (Sim_NextSecond < Sim_NextButton) ? Sim_NextSecond : Sim_NextButton;
+				Sim_Run(((next < Sim_TxDone) ? next : Sim_TxDone) - Sim_Now);
+			}
+			Sim_WakeAt = SIM_NEVER;
+			Sim_State = SLEEP_STATE_RUN;
+		}
+
+		return (unsigned char)(Sleep_GetStats(StatsPtr) == SLEEP_OK);
+}
+
+/*!
+ * @brief Prints one run and checks the model against the simulation.
+ */
+static unsigned char Sim_Report(const char * name, const Sleep_StatsType * StatsPtr)
+{
+		static const char * const names[SLEEP_STATE_COUNT] = { "RUN", "WAIT", "STOP", "VLPS" };
+		unsigned long long totalNs = 0u;
+		unsigned long long charge = 0u;
+		unsigned int state;
+		double simUa;
+		double errPercent;
+
+		for (state = 0u; state < (unsigned int)SLEEP_STATE_COUNT; state++)
+		{
+			totalNs += Sim_Result.timeNs[state];
+			charge += Sim_Result.chargeUaNs[state];
+		}
+		simUa = (double)charge / (double)totalNs;
+		errPercent = (((double)StatsPtr->averageUa - simUa) * 100.0) / simUa;
+
+		printf("%s\n", name);
+		printf("  %-5s %12s %12s %10s\n", "state", "Sleep ms", "true ms", "entries");
+		for (state = 0u; state < (unsigned int)SLEEP_STATE_COUNT; state++)
+		{
+			printf("  %-5s %12u %12.1f %10u\n", names[state], StatsPtr->timeMs[state],
+			       (double)Sim_Result.timeNs[state] * 1e-6, StatsPtr->entries[state]);
+		}
+		printf("  wake-ups/min %u, clock restore on FIRC %.1f ms, errors %u\n", StatsPtr->wakeupsPerMinute,
+		       (double)Sim_Result.restoreNs * 1e-6, Sim_Result.errors);
+		printf("  average current: Sleep %u uA, simulated %.1f uA (%+.1f %%)\n", StatsPtr->averageUa, simUa, errPercent);
+
+		return (unsigned char)((Sim_Result.errors == 0u) && (errPercent <= SIM_LIMIT_PERCENT) &&
+		                       (errPercent >= -SIM_LIMIT_PERCENT));
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		static const IRQn_Type wakeups[] = { RTC_Seconds_IRQn, PORTC_IRQn, LPUART1_RxTx_IRQn };
+		static const clock_names_t blockers[] = { LPUART1_CLK };
+		static const Scg_RunMode_ConfigType stopRun =
+		{
+			FIRC_CLK, CORE_CLK_DIV_BY_1, BUS_CLK_DIV_BY_2, SLOW_CLK_DIV_BY_2, SCG_CLOCK_DIV_BY_1, SCG_CLOCK_DIV_BY_1
+		};
+		static const Sleep_ConfigType stopConfig =
+		{
+			Sim_GetTimeMs, wakeups, 3u, blockers, 1u, 1u,
+			{ 0u, 0u, 2u, 5u },
+			{ SIM_RUN_SPLL_UA, SIM_WAIT_UA, SIM_STOP_UA, SIM_VLPS_UA },
+			&stopRun, NULL
+		};
+		static const Sleep_ConfigType waitConfig =
+		{
+			Sim_GetTimeMs, wakeups, 3u, blockers, 1u, 1u,
+			{ 0u, 0u, SLEEP_IDLE_FOREVER, SLEEP_IDLE_FOREVER },
+			{ SIM_RUN_SPLL_UA, SIM_WAIT_UA, SIM_STOP_UA, SIM_VLPS_UA },
+			NULL, NULL
+		};
+		unsigned int minutes = (argc > 1) ? (unsigned int)atoi(argv[1]) : SIM_DEFAULT_MINUTES;
+		Sleep_StatsType stats;
+		unsigned char pass = 1u;
+
+		printf("%u min: redraw %.1f ms/s, log %.1f ms + %.1f ms TX/min, button %.1f ms every %.0f s on average\n",
+		       minutes, (double)SIM_REDRAW_NS * 1e-6, (double)SIM_LOG_NS * 1e-6, (double)SIM_LOG_TX_NS * 1e-6,
+		       (double)SIM_BUTTON_NS * 1e-6, (double)SIM_BUTTON_MEAN_NS * 1e-9);
+
+		/* A stop clock without an image to restore is rejected */
+		if (Sleep_Init(&stopConfig) != SLEEP_ERR_PARA)
+		{
+			printf("FAIL: stopRunConfig accepted without restoreImage\n");
+			return 1;
+		}
+
+		if (Sim_Execute(&stopConfig, minutes, &stats) == 0u)
+		{
+			printf("FAIL: Sleep_Init\n");
+			return 1;
+		}
+		pass &= Sim_Report("stop modes allowed", &stats);
+
+		if (Sim_Execute(&waitConfig, minutes, &stats) == 0u)
+		{
+			printf("FAIL: Sleep_Init\n");
+			return 1;
+		}
+		pass &= Sim_Report("WAIT only", &stats);
+
+		if (pass == 0u)
+		{
+			printf("FAIL\n");
+			return 1;
+		}
+		printf("PASS\n");
+		return 0;
+}
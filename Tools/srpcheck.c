@@ -0,0 +1,397 @@
+/****************************************************************************************************
+* @file    srpcheck.c
+* @author  Ma Hien Nhan
+* @brief   Host model of the stack resource policy configured in Srp_Cfg.h.
+* @details Prints the ceiling of every resource, then the worst-case blocking bound and the
+*          response-time bound of every task. Interrupts arrive sporadically, no sooner than their
+*          minimum inter-arrival time, and each must finish within it. Each job locks each of its
+*          resources once, for the configured critical section length. The simulation measures
+*          the blocking and the response time of every job and checks them against the bounds.
+*          It fails on any overrun or deadline miss, and when a job is blocked after it started.
+*          Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o srpcheck Tools/srpcheck.c
+*              ./srpcheck [cycles]
+* @version 1.0.0
+* @date    2024-11-10
+* @note    Times are in CPU cycles and exclude the interrupt entry and exit.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Srp.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define CHECK_DEFAULT_CYCLES            (20000000u)
+#define CHECK_MAX_SEGMENTS              (2u * SRP_RESOURCE_COUNT + 1u)
+#define CHECK_COMPUTE_MAX               (60u)              /* Work between two critical sections */
+#define CHECK_JITTER_DIV                (4u)               /* Arrivals up to period / 4 late */
+
+#define CHECK_TASK_ROW(ARG, NAME, IRQ, PRIO)            { #NAME, (PRIO) },
+#define CHECK_RESOURCE_ROW(ARG, NAME, USERS, CS)        { #NAME, (USERS), SRP_CEILING_OF(USERS), (CS) },
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+			const char *        name;
+			unsigned int        priority;
+} Check_TaskType;
+
+typedef struct
+{
+			const char *        name;
+			unsigned int        users;
+			unsigned int        ceiling;
+			unsigned int        csCycles;
+} Check_ResourceType;
+
+typedef struct
+{
+			unsigned int        cycles;         /*!< Length of the segment */
+			int                 resource;       /*!< Locked resource, -1 for plain work */
+} Check_SegmentType;
+
+typedef struct
+{
+			unsigned char       released;       /*!< Job waiting or running */
+			unsigned char       started;
+			unsigned int        segment;        /*!< Current segment */
+			unsigned int        left;           /*!< Cycles left in the segment */
+			unsigned int        count;          /*!< Segments of the job */
+			unsigned int        blocked;        /*!< Cycles spent behind lower priority work */
+			unsigned int        release;        /*!< Arrival time */
+			unsigned int        savedCeiling;   /*!< System ceiling before the current lock */
+			Check_SegmentType   segments[CHECK_MAX_SEGMENTS];
+} Check_JobType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static const Check_TaskType Check_Tasks[SRP_TASK_COUNT] = { SRP_TASK_LIST(CHECK_TASK_ROW, 0) };
+static const Check_ResourceType Check_Resources[SRP_RESOURCE_COUNT] = { SRP_RESOURCE_LIST(CHECK_RESOURCE_ROW, 0) };
+/* Workload: minimum inter-arrival, which is also the deadline, in cycles; 0 for the main loop */
+static const unsigned int Check_Periods[SRP_TASK_COUNT] =
+{
+			[SRP_TASK_UART]     = 2500u,
+			[SRP_TASK_BUTTON]   = 5000u,
+			[SRP_TASK_DISPLAY]  = 2000u,
+			[SRP_TASK_TIMEBASE] = 1000u,
+			[SRP_TASK_BROWNOUT] = 4000u,
+};
+
+static Check_JobType Check_Jobs[SRP_TASK_COUNT];
+static unsigned int Check_Bound[SRP_TASK_COUNT];
+static unsigned int Check_Observed[SRP_TASK_COUNT];
+static unsigned int Check_Wcet[SRP_TASK_COUNT];
+static unsigned int Check_ResponseBound[SRP_TASK_COUNT];
+static unsigned int Check_Response[SRP_TASK_COUNT];
+static unsigned int Check_NextArrival[SRP_TASK_COUNT];
+static unsigned int Check_Releases[SRP_TASK_COUNT];
+static unsigned int Check_Overruns[SRP_TASK_COUNT];
+static unsigned int Check_Misses[SRP_TASK_COUNT];
+
+
+/*==================================================================================================
+*                                       LOCAL FUNCTIONS
+==================================================================================================*/
+/*!
+ * @brief SRP blocking bound: longest critical section of a lower priority task on a resource
+ *        whose ceiling reaches the task priority.
+ */
+static unsigned int Check_BlockingBound(unsigned int task)
+{
+		unsigned int priority = Check_Tasks[task].priority;
+		unsigned int bound = 0u;
+		unsigned int r;
+		unsigned int t;
+
+		for (r = 0u; r < SRP_RESOURCE_COUNT; r++)
+		{
+			if (Check_Resources[r].ceiling < priority)
+			{
+				continue;
+			}
+			for (t = 0u; t < SRP_TASK_COUNT; t++)
+			{
+				if (((Check_Resources[r].users >> t) & 1u) && (Check_Tasks[t].priority < priority) &&
+				    (Check_Resources[r].csCycles > bound))
+				{
+					bound = Check_Resources[r].csCycles;
+				}
+			}
+		}
+		return bound;
+}
+
+/*!
+ * @brief Longest job of a task: every compute segment at its maximum.
+ */
+static unsigned int Check_JobBound(unsigned int task)
+{
+		unsigned int cycles = CHECK_COMPUTE_MAX;
+		unsigned int r;
+
+		for (r = 0u; r < SRP_RESOURCE_COUNT; r++)
+		{
+			if ((Check_Resources[r].users >> task) & 1u)
+			{
+				cycles += CHECK_COMPUTE_MAX + Check_Resources[r].csCycles;
+			}
+		}
+		return cycles;
+}
+
+/*!
+ * @brief Response-time analysis with SRP blocking:
+ *        R = C + B + sum over higher priorities of ceil(R / T) * C, iterated to a fixed point.
+ *
+ * @return Bound in cycles, 0 when it exceeds the period.
+ */
+static unsigned int Check_ResponseTimeBound(unsigned int task)
+{
+		unsigned int response = Check_Wcet[task] + Check_Bound[task];
+		unsigned int next;
+		unsigned int t;
+
+		for (;;)
+		{
+			next = Check_Wcet[task] + Check_Bound[task];
+			for (t = 0u; t < SRP_TASK_COUNT; t++)
+			{
+				if (Check_Tasks[t].priority > Check_Tasks[task].priority)
+				{
+					next += ((response + Check_Periods[t] - 1u) / Check_Periods[t]) * Check_Wcet[t];
+				}
+			}
+			if (next > Check_Periods[task])
+			{
+				return 0u;
+			}
+			if (next == response)
+			{
+				return response;
+			}
+			response = next;
+		}
+}
+
+static void Check_Release(unsigned int task, unsigned int now)
+{
+		Check_JobType * job = &Check_Jobs[task];
+		unsigned int r;
+
+		job->released = 1u;
+		job->started = 0u;
+		job->segment = 0u;
+		job->blocked = 0u;
+		job->release = now;
+		job->count = 0u;
+		for (r = 0u; r < SRP_RESOURCE_COUNT; r++)
+		{
+			if ((Check_Resources[r].users >> task) & 1u)
+			{
+				job->segments[job->count].cycles = 1u + ((unsigned int)rand() % CHECK_COMPUTE_MAX);
+				job->segments[job->count].resource = -1;
+				job->count++;
+				job->segments[job->count].cycles = Check_Resources[r].csCycles;
+				job->segments[job->count].resource = (int)r;
+				job->count++;
+			}
+		}
+		job->segments[job->count].cycles = 1u + ((unsigned int)rand() % CHECK_COMPUTE_MAX);
+		job->segments[job->count].resource = -1;
+		job->count++;
+		job->left = job->segments[0].cycles;
+		Check_Releases[task]++;
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		unsigned int cycles = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : CHECK_DEFAULT_CYCLES;
+		unsigned int stack[SRP_TASK_COUNT];
+		unsigned int depth = 0u;
+		unsigned int ceiling = 0u;
+		unsigned int now;
+		unsigned int t;
+		unsigned int r;
+		unsigned int best;
+		unsigned int top;
+		int failed = 0;
+		double load = 0.0;
+		Check_JobType * job;
+
+		printf("%-12s %8s %8s %10s\n", "resource", "users", "ceiling", "cs cycles");
+		for (r = 0u; r < SRP_RESOURCE_COUNT; r++)
+		{
+			printf("%-12s %8X %8u %10u\n", Check_Resources[r].name, Check_Resources[r].users,
+			       Check_Resources[r].ceiling, Check_Resources[r].csCycles);
+		}
+
+		srand(1u);
+		for (t = 0u; t < SRP_TASK_COUNT; t++)
+		{
+			if ((Check_Tasks[t].priority != 0u) && (Check_Periods[t] == 0u))
+			{
+				printf("error: no period for %s\n", Check_Tasks[t].name);
+				return 1;
+			}
+			Check_Bound[t] = Check_BlockingBound(t);
+			Check_Wcet[t] = Check_JobBound(t);
+			Check_NextArrival[t] = (Check_Periods[t] != 0u) ? ((unsigned int)rand() % Check_Periods[t]) : 0u;
+		}
+		for (t = 0u; t < SRP_TASK_COUNT; t++)
+		{
+			if (Check_Tasks[t].priority != 0u)
+			{
+				Check_ResponseBound[t] = Check_ResponseTimeBound(t);
+				load += (double)Check_Wcet[t] / (double)Check_Periods[t];
+			}
+		}
+		Check_Release(SRP_TASK_MAIN, 0u);
+
+		for (now = 0u; now < cycles; now++)
+		{
+			/* 1. Sporadic arrivals: the period, plus a random delay */
+			for (t = 0u; t < SRP_TASK_COUNT; t++)
+			{
+				if ((Check_Tasks[t].priority != 0u) && (now == Check_NextArrival[t]))
+				{
+					Check_NextArrival[t] = now + Check_Periods[t] +
+					                       ((unsigned int)rand() % (Check_Periods[t] / CHECK_JITTER_DIV + 1u));
+					if (Check_Jobs[t].released != 0u)
+					{
+						Check_Overruns[t]++;
+					}
+					else
+					{
+						Check_Release(t, now);
+					}
+				}
+			}
+
+			/* 2. Preemption test: above the running task and the system ceiling */
+			best = SRP_TASK_COUNT;
+			for (t = 0u; t < SRP_TASK_COUNT; t++)
+			{
+				if ((Check_Jobs[t].released != 0u) && (Check_Jobs[t].started == 0u) &&
+				    ((best == SRP_TASK_COUNT) || (Check_Tasks[t].priority > Check_Tasks[best].priority)))
+				{
+					best = t;
+				}
+			}
+			if ((best != SRP_TASK_COUNT) &&
+			    ((depth == 0u) || ((Check_Tasks[best].priority > Check_Tasks[stack[depth - 1u]].priority) &&
+			                       (Check_Tasks[best].priority > ceiling))))
+			{
+				Check_Jobs[best].started = 1u;
+				stack[depth++] = best;
+			}
+
+			/* 3. Blocking: released jobs waiting behind lower priority work */
+			top = stack[depth - 1u];
+			for (t = 0u; t < SRP_TASK_COUNT; t++)
+			{
+				if ((Check_Jobs[t].released != 0u) && (Check_Tasks[t].priority > Check_Tasks[top].priority))
+				{
+					if (Check_Jobs[t].started != 0u)
+					{
+						printf("error: %s blocked after it started\n", Check_Tasks[t].name);
+						return 1;
+					}
+					Check_Jobs[t].blocked++;
+				}
+			}
+
+			/* 4. Run one cycle of the task on top of the stack */
+			job = &Check_Jobs[top];
+			if ((job->left == job->segments[job->segment].cycles) && (job->segments[job->segment].resource >= 0))
+			{
+				job->savedCeiling = ceiling;
+				r = (unsigned int)job->segments[job->segment].resource;
+				if (Check_Resources[r].ceiling > ceiling)
+				{
+					ceiling = Check_Resources[r].ceiling;
+				}
+			}
+			job->left--;
+			if (job->left == 0u)
+			{
+				if (job->segments[job->segment].resource >= 0)
+				{
+					ceiling = job->savedCeiling;
+				}
+				job->segment++;
+				if (job->segment < job->count)
+				{
+					job->left = job->segments[job->segment].cycles;
+				}
+				else
+				{
+					job->released = 0u;
+					depth--;
+					if (job->blocked > Check_Observed[top])
+					{
+						Check_Observed[top] = job->blocked;
+					}
+					if ((now + 1u - job->release) > Check_Response[top])
+					{
+						Check_Response[top] = now + 1u - job->release;
+					}
+					if ((top != SRP_TASK_MAIN) && ((now + 1u - job->release) > Check_Periods[top]))
+					{
+						Check_Misses[top]++;
+					}
+					if (top == SRP_TASK_MAIN)
+					{
+						Check_Release(SRP_TASK_MAIN, now + 1u);
+						Check_Jobs[SRP_TASK_MAIN].started = 1u;
+						stack[depth++] = SRP_TASK_MAIN;
+					}
+				}
+			}
+		}
+
+		/* Blocking counts lower priority work only; the response time includes the higher ones */
+		printf("\nworst-case load %.1f %%\n", load * 100.0);
+		printf("%-10s %4s %6s %6s %5s %9s %9s %9s %9s %6s %6s\n", "task", "prio", "period", "jobs", "wcet",
+		       "blocking", "observed", "response", "observed", "misses", "overruns");
+		for (t = 0u; t < SRP_TASK_COUNT; t++)
+		{
+			if (Check_Tasks[t].priority == 0u)
+			{
+				continue;
+			}
+			printf("%-10s %4u %6u %6u %5u %9u %9u %9u %9u %6u %6u\n", Check_Tasks[t].name,
+			       Check_Tasks[t].priority, Check_Periods[t], Check_Releases[t], Check_Wcet[t], Check_Bound[t],
+			       Check_Observed[t], Check_ResponseBound[t], Check_Response[t], Check_Misses[t],
+			       Check_Overruns[t]);
+			if (Check_ResponseBound[t] == 0u)
+			{
+				printf("error: %s is not schedulable\n", Check_Tasks[t].name);
+				failed = 1;
+			}
+			if ((Check_Observed[t] > Check_Bound[t]) || (Check_Response[t] > Check_ResponseBound[t]) ||
+			    (Check_Misses[t] != 0u) || (Check_Overruns[t] != 0u))
+			{
+				printf("error: %s exceeded its bounds\n", Check_Tasks[t].name);
+				failed = 1;
+			}
+		}
+
+		printf(failed ? "FAIL\n" : "PASS\n");
+		return failed;
+}
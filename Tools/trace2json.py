@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Converter from a trace recorder dump (Driver/inc/Trace.h) to Chrome trace-event JSON.
+
+Dump the recorder with the debugger, then open the JSON in chrome://tracing or
+https://ui.perfetto.dev:
+    (gdb) dump binary value trace.bin Trace_Recorder
+    trace2json.py trace.bin -o trace.json
+
+The dump is six header words (magic, capacity, count, cpuHz, overheadCycles, frozen) followed
+by the ring of 8-byte records [timestamp u32] [type u8] [id u8] [arg u16], little-endian.
+Interrupts get one track each; calls and events are drawn on the track of the context they ran
+in, the main loop when no interrupt was active. IRQ and event names are read from Nvic.h and
+Trace.h.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x43525454
+HEADER = struct.Struct("<6I")
+RECORD = struct.Struct("<IBBH")
+
+ISR_ENTER, ISR_EXIT, EVENT, CALL_BEGIN, CALL_END, MARK = range(1, 7)
+MAIN_TID = 0
+IRQ_TID_BASE = 1000
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_INC = os.path.join(HERE, "..", "Driver", "inc")
+
+
+def read_names(path, pattern):
+    try:
+        with open(path) as f:
+            return {int(value): name for name, value in re.findall(pattern, f.read())}
+    except OSError:
+        return {}
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, capacity, count, cpu_hz, overhead, frozen = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit("%s: not a trace recorder dump (magic 0x%08X)" % (path, magic))
+    if len(data) < HEADER.size + capacity * RECORD.size:
+        sys.exit("%s: dump truncated, expected %d records" % (path, capacity))
+    ring = [RECORD.unpack_from(data, HEADER.size + n * RECORD.size) for n in range(capacity)]
+    # Oldest record first: the ring has wrapped once count exceeds the capacity
+    first = count - min(count, capacity)
+    records = [ring[n % capacity] for n in range(first, count)]
+    return records, cpu_hz, overhead, frozen, count - len(records)
+
+
+def convert(records, cpu_hz, irq_names, id_names):
+    scale = 1e6 / cpu_hz if cpu_hz else 1.0
+    events = []
+    durations = {}
+    starts = {}
+    contexts = [MAIN_TID]
+    open_calls = {}
+    high = 0
+    last = None
+    origin = records[0][0] if records else 0
+    for timestamp, kind, ident, arg in records:
+        if last is not None and timestamp < last:
+            high += 1 << 32
+        last = timestamp
+        ts = (high + timestamp - origin) * scale
+        tid = contexts[-1]
+        if kind == ISR_ENTER:
+            tid = IRQ_TID_BASE + ident
+            contexts.append(tid)
+            events.append({"name": irq_names.get(ident, "IRQ %d" % ident), "ph": "B", "ts": ts, "pid": 0, "tid": tid})
+            starts.setdefault(ident, []).append(ts)
+        elif kind == ISR_EXIT:
+            tid = IRQ_TID_BASE + ident
+            if tid not in contexts:
+                continue                # Entered before the oldest record
+            while contexts[-1] != tid:
+                contexts.pop()          # Exit records lost with the overwritten ones
+            contexts.pop()
+            events.append({"name": irq_names.get(ident, "IRQ %d" % ident), "ph": "E", "ts": ts, "pid": 0, "tid": tid})
+            durations.setdefault(ident, []).append(ts - starts[ident].pop())
+        elif kind == CALL_BEGIN:
+            open_calls.setdefault((tid, ident), 0)
+            open_calls[(tid, ident)] += 1
+            events.append({"name": id_names.get(ident, "call %d" % ident), "ph": "B", "ts": ts, "pid": 0, "tid": tid})
+        elif kind == CALL_END:
+            if not open_calls.get((tid, ident)):
+                continue
+            open_calls[(tid, ident)] -= 1
+            events.append({"name": id_names.get(ident, "call %d" % ident), "ph": "E", "ts": ts, "pid": 0, "tid": tid,
+                           "args": {"result": arg}})
+        elif kind in (EVENT, MARK):
+            name = id_names.get(ident, ("mark %d" if kind == MARK else "event %d") % ident)
+            events.append({"name": name, "ph": "i", "s": "t", "ts": ts, "pid": 0, "tid": tid, "args": {"arg": arg}})
+
+    events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": MAIN_TID, "args": {"name": "main loop"}})
+    for ident in starts:
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": IRQ_TID_BASE + ident,
+                       "args": {"name": irq_names.get(ident, "IRQ %d" % ident)}})
+        events.append({"name": "thread_sort_index", "ph": "M", "pid": 0, "tid": IRQ_TID_BASE + ident,
+                       "args": {"sort_index": -ident}})
+    return events, {irq_names.get(ident, "IRQ %d" % ident): values for ident, values in durations.items()}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary dump of Trace_Recorder")
+    parser.add_argument("-o", "--output", help="JSON file, stdout when omitted")
+    parser.add_argument("--inc", default=DEFAULT_INC, help="directory holding Nvic.h and Trace.h")
+    parser.add_argument("--cpu-hz", type=int, help="override the core clock stored in the dump")
+    args = parser.parse_args()
+
+    records, cpu_hz, overhead, frozen, lost = load(args.dump)
+    cpu_hz = args.cpu_hz or cpu_hz
+    irq_names = read_names(os.path.join(args.inc, "Nvic.h"), r"(\w+)_IRQn\s*=\s*(\d+)u")
+    id_names = read_names(os.path.join(args.inc, "Trace.h"), r"TRACE_ID_(\w+)\s*=\s*(\d+)U")
+    events, durations = convert(records, cpu_hz, irq_names, id_names)
+
+    trace = {"traceEvents": events, "displayTimeUnit": "ns",
+             "otherData": {"cpuHz": cpu_hz, "overheadCycles": overhead, "frozen": frozen, "overwritten": lost}}
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump(trace, out, indent=None if args.output else 1)
+    if args.output:
+        out.close()
+
+    # Summary on stderr: the recorder cost and the ISR durations it inflates
+    unit = "us" if cpu_hz else "cycles"
+    print("%d records, %d overwritten, %d cycles per record%s" %
+          (len(records), lost, overhead, " (%.3f us)" % (overhead * 1e6 / cpu_hz) if cpu_hz else ""), file=sys.stderr)
+    for name, values in sorted(durations.items()):
+        print("  %-24s %6d runs, mean %.3f %s, max %.3f %s" %
+              (name, len(values), sum(values) / len(values), unit, max(values), unit), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
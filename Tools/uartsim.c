@@ -0,0 +1,581 @@
+/****************************************************************************************************
+* @file    uartsim.c
+* @author  Ma Hien Nhan
+* @brief   Host loopback simulation of the LPUART driver at 1 Mbaud.
+* @details This file compiles Driver/src/Lpuart.c against a register model of one LPUART whose
+*          transmitter is wired to its own receiver: 4-word FIFOs, the TDRE/RDRF watermarks, TC,
+*          IDLE after 2^IDLECFG characters, overrun, and a DMA channel that refills the transmit
+*          FIFO on TDRE. The application streams a byte pattern through the zero-copy write and
+*          peek/consume calls and checks every received byte. The report gives the sustained
+*          throughput and the interrupt rate for interrupt and DMA transmission, and the CPU load
+*          estimated from the interrupt entries, register accesses and bytes moved with the cycle
+*          costs below. Build and run from the repository root:
+*              gcc -O2 -IDriver/inc -IUtilitie -IMiddleware/inc -o uartsim Tools/uartsim.c
+*                  Utilitie/Utilitie.c
+*              ./uartsim [milliseconds]
+* @version 1.0.0
+* @date    2024-11-05
+* @note    Lpuart.c is included by this file. DATA, STAT and WATER become calls into the model
+*          that return a cell; a read or a write of the cell is told apart at the next access by
+*          a marker bit the driver never writes, and applied to the model then.
+****************************************************************************************************/
+
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+==================================================================================================*/
+#include "Lpuart.h"
+#include "ClockGate.h"
+#include "Dma.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/*==================================================================================================
+*                                      DEFINES AND MACROS
+==================================================================================================*/
+#define SIM_BAUD                        (1000000u)
+#define SIM_CHAR_NS                     (10000ull)         /* 8N1: 10 bits at 1 Mbaud */
+#define SIM_FUNC_HZ                     (48000000u)        /* FIRCDIV2 */
+#define SIM_APP_PERIOD_NS               (50000ull)         /* Main loop polls the rings */
+#define SIM_RING_SIZE                   (256u)
+#define SIM_DEFAULT_MS                  (1000u)
+
+/*** Cortex-M4 cycle costs at 80 MHz (estimates, not a measurement) ***/
+#define SIM_CORE_HZ                     (80000000.0)
+#define SIM_IRQ_CYCLES                  (24u)              /* Exception entry and return */
+#define SIM_ISR_CYCLES                  (40u)              /* Handler body without the loops */
+#define SIM_REG_CYCLES                  (5u)               /* One access over the peripheral bridge */
+#define SIM_BYTE_CYCLES                 (12u)              /* Ring index update and byte copy */
+#define SIM_CALL_CYCLES                 (30u)              /* One driver API call */
+
+/*** Pass limits ***/
+#define SIM_LIMIT_RATE_PERCENT          (99.0)
+
+/*** Register model ***/
+#define SIM_MARK_DATA                   (0x80000000u)      /* DATA read cell, the driver writes 8 bits */
+#define SIM_MARK_STAT                   (0x00000001u)      /* STAT bit 0 is reserved */
+#define SIM_MARK_WATER                  (0x80000000u)      /* WATER bit 31 is reserved */
+
+/*** Host replacement of Cpu.h ***/
+#define CPU_H
+#define Cpu_EnterCritical()             (0u)
+#define Cpu_ExitCritical(primask)       ((void)(primask))
+
+/*** Host registers ***/
+#define LPUART_Type                     Sim_LpuartType
+#undef LPUART0
+#undef LPUART1
+#undef LPUART2
+#define LPUART0                         (&Sim_Uart)
+#define LPUART1                         (&Sim_Uart)
+#define LPUART2                         (&Sim_Uart)
+#define DATA                            DATA_FN()[0]
+#define STAT                            STAT_FN()[0]
+#define WATER                           WATER_FN()[0]
+
+
+/*==================================================================================================
+*                                             ENUMS
+==================================================================================================*/
+typedef enum
+{
+			SIM_PENDING_NONE    = 0U,
+			SIM_PENDING_DATA    = 1U,
+			SIM_PENDING_STAT    = 2U,
+			SIM_PENDING_WATER   = 3U,
+} Sim_pending_t;
+
+
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   LPUART as seen by the driver.
+ */
+typedef struct
+{
+			volatile unsigned int   GLOBAL;
+			volatile unsigned int   BAUD;
+			volatile unsigned int   CTRL;
+			volatile unsigned int   FIFO;
+			volatile unsigned int * (*DATA_FN)(void);
+			volatile unsigned int * (*STAT_FN)(void);
+			volatile unsigned int * (*WATER_FN)(void);
+} Sim_LpuartType;
+
+/**
+ * @brief   Line, FIFO and DMA state behind the registers.
+ */
+typedef struct
+{
+			unsigned char           txFifo[LPUART_FIFO_DEPTH];
+			unsigned char           rxFifo[LPUART_FIFO_DEPTH];
+			unsigned int            txCount;
+			unsigned int            rxCount;
+			unsigned int            txWater;
+			unsigned int            rxWater;
+			unsigned int            flags;            /*!< Sticky STAT flags: IDLE and the errors */
+			unsigned char           shifting;
+			unsigned char           shiftByte;
+			unsigned long long      shiftEnd;
+			unsigned long long      idleAt;           /*!< IDLE sets then, ~0 when not armed */
+			volatile unsigned int   cell;             /*!< Register cell handed to the driver */
+			Sim_pending_t           pending;
+			unsigned char *         dmaSrc;
+			unsigned int            dmaLeft;
+			unsigned char           dmaActive;
+} Sim_ModelType;
+
+/**
+ * @brief   Counters of one run.
+ */
+typedef struct
+{
+			unsigned long long      isrs;
+			unsigned long long      regAccesses;      /*!< DATA, STAT and WATER from the driver */
+			unsigned long long      isrBytes;         /*!< Bytes moved by the CPU in the handler */
+			unsigned long long      calls;            /*!< Driver API calls from the application */
+			unsigned long long      received;
+			unsigned long long      errors;           /*!< Bytes that did not match the pattern */
+} Sim_CountType;
+
+
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+static volatile unsigned int * Sim_DataFn(void);
+static volatile unsigned int * Sim_StatFn(void);
+static volatile unsigned int * Sim_WaterFn(void);
+
+static Sim_LpuartType Sim_Uart = { 0u, 0u, 0u, 0u, Sim_DataFn, Sim_StatFn, Sim_WaterFn };
+static Sim_ModelType Sim_Model;
+static Sim_CountType Sim_Count;
+static unsigned long long Sim_Now;
+static unsigned char Sim_TxBuffer[SIM_RING_SIZE];
+static unsigned char Sim_RxBuffer[SIM_RING_SIZE];
+
+
+/*==================================================================================================
+*                                       REGISTER MODEL
+==================================================================================================*/
+/*!
+ * @brief Current STAT value: watermark flags from the FIFO levels, the others sticky.
+ */
+static unsigned int Sim_Stat(void)
+{
+		unsigned int stat = Sim_Model.flags;
+
+		if (Sim_Model.txCount <= Sim_Model.txWater)
+		{
+			stat |= (1u << LPUART_STAT_TDRE_SHIFT);
+		}
+		if (Sim_Model.rxCount > Sim_Model.rxWater)
+		{
+			stat |= (1u << LPUART_STAT_RDRF_SHIFT);
+		}
+		if ((Sim_Model.txCount == 0u) && (Sim_Model.shifting == 0u))
+		{
+			stat |= (1u << LPUART_STAT_TC_SHIFT);
+		}
+		return stat;
+}
+
+/*!
+ * @brief Applies the access made to the cell handed out last.
+ */
+static void Sim_Sync(void)
+{
+		unsigned int index;
+
+		switch (Sim_Model.pending)
+		{
+			case SIM_PENDING_DATA:
+				if ((Sim_Model.cell & SIM_MARK_DATA) == 0u)
+				{
+					/* Write: into the transmit FIFO, lost when it is full */
+					if (Sim_Model.txCount < LPUART_FIFO_DEPTH)
+					{
+						Sim_Model.txFifo[Sim_Model.txCount++] = (unsigned char)Sim_Model.cell;
+					}
+				}
+				else if (Sim_Model.rxCount != 0u)
+				{
+					/* Read: the oldest received byte leaves the FIFO */
+					for (index = 1u; index < Sim_Model.rxCount; index++)
+					{
+						Sim_Model.rxFifo[index - 1u] = Sim_Model.rxFifo[index];
+					}
+					Sim_Model.rxCount--;
+				}
+				break;
+
+			case SIM_PENDING_STAT:
+				if ((Sim_Model.cell & SIM_MARK_STAT) == 0u)
+				{
+					/* Write 1 to clear */
+					Sim_Model.flags &= ~Sim_Model.cell;
+				}
+				break;
+
+			case SIM_PENDING_WATER:
+				if ((Sim_Model.cell & SIM_MARK_WATER) == 0u)
+				{
+					Sim_Model.txWater = (Sim_Model.cell >> LPUART_WATER_TXWATER_SHIFT) & LPUART_WATER_MAX;
+					Sim_Model.rxWater = (Sim_Model.cell >> LPUART_WATER_RXWATER_SHIFT) & LPUART_WATER_MAX;
+				}
+				break;
+
+			case SIM_PENDING_NONE:
+			default:
+				break;
+		}
+		Sim_Model.pending = SIM_PENDING_NONE;
+}
+
+static volatile unsigned int * Sim_DataFn(void)
+{
+		Sim_Sync();
+		Sim_Count.regAccesses++;
+		Sim_Model.cell = SIM_MARK_DATA | ((Sim_Model.rxCount != 0u) ? Sim_Model.rxFifo[0] : 0u);
+		Sim_Model.pending = SIM_PENDING_DATA;
+		return &Sim_Model.cell;
+}
+
+static volatile unsigned int * Sim_StatFn(void)
+{
+		Sim_Sync();
+		Sim_Count.regAccesses++;
+		Sim_Model.cell = Sim_Stat() | SIM_MARK_STAT;
+		Sim_Model.pending = SIM_PENDING_STAT;
+		return &Sim_Model.cell;
+}
+
+static volatile unsigned int * Sim_WaterFn(void)
+{
+		Sim_Sync();
+		Sim_Count.regAccesses++;
+		Sim_Model.cell = SIM_MARK_WATER | (Sim_Model.txWater << LPUART_WATER_TXWATER_SHIFT) |
+		                 (Sim_Model.txCount << LPUART_WATER_TXCOUNT_SHIFT) |
+		                 (Sim_Model.rxWater << LPUART_WATER_RXWATER_SHIFT) |
+		                 (Sim_Model.rxCount << LPUART_WATER_RXCOUNT_SHIFT);
+		Sim_Model.pending = SIM_PENDING_WATER;
+		return &Sim_Model.cell;
+}
+
+/*!
+ * @brief Checks whether the LPUART requests its interrupt.
+ */
+static unsigned char Sim_IrqPending(void)
+{
+		unsigned int stat = Sim_Stat();
+		unsigned int ctrl = Sim_Uart.CTRL;
+
+		return (unsigned char)(((((ctrl >> LPUART_CTRL_RIE_SHIFT) & 1u) != 0u) && (((stat >> LPUART_STAT_RDRF_SHIFT) & 1u) != 0u)) ||
+		                       ((((ctrl >> LPUART_CTRL_TIE_SHIFT) & 1u) != 0u) && (((stat >> LPUART_STAT_TDRE_SHIFT) & 1u) != 0u)) ||
+		                       ((((ctrl >> LPUART_CTRL_TCIE_SHIFT) & 1u) != 0u) && (((stat >> LPUART_STAT_TC_SHIFT) & 1u) != 0u)) ||
+		                       ((((ctrl >> LPUART_CTRL_ILIE_SHIFT) & 1u) != 0u) && (((stat >> LPUART_STAT_IDLE_SHIFT) & 1u) != 0u)) ||
+		                       ((((ctrl >> LPUART_CTRL_ORIE_SHIFT) & 1u) != 0u) && (((stat >> LPUART_STAT_OR_SHIFT) & 1u) != 0u)));
+}
+
+/*!
+ * @brief Line activity up to the current time: DMA refill, shifter, loopback into the receiver.
+ */
+static void Sim_Line(void)
+{
+		unsigned int index;
+		unsigned char progress = 1u;
+
+		while (progress != 0u)
+		{
+			progress = 0u;
+
+			/* 1. DMA request while TDRE is set */
+			while ((Sim_Model.dmaActive != 0u) && (Sim_Model.dmaLeft != 0u) &&
+			       (((Sim_Uart.BAUD >> LPUART_BAUD_TDMAE_SHIFT) & 1u) != 0u) &&
+			       (Sim_Model.txCount <= Sim_Model.txWater))
+			{
+				Sim_Model.txFifo[Sim_Model.txCount++] = *Sim_Model.dmaSrc++;
+				Sim_Model.dmaLeft--;
+			}
+
+			/* 2. End of the character on the line, received by the loopback */
+			if ((Sim_Model.shifting != 0u) && (Sim_Now >= Sim_Model.shiftEnd))
+			{
+				Sim_Model.shifting = 0u;
+				if (Sim_Model.rxCount < LPUART_FIFO_DEPTH)
+				{
+					Sim_Model.rxFifo[Sim_Model.rxCount++] = Sim_Model.shiftByte;
+				}
+				else
+				{
+					Sim_Model.flags |= (1u << LPUART_STAT_OR_SHIFT);
+				}
+				Sim_Model.idleAt = Sim_Model.shiftEnd +
+				                   (SIM_CHAR_NS << ((Sim_Uart.CTRL >> LPUART_CTRL_IDLECFG_SHIFT) & LPUART_IDLECFG_MAX));
+				progress = 1u;
+			}
+
+			/* 3. Next character, back to back with the previous one */
+			if ((Sim_Model.shifting == 0u) && (Sim_Model.txCount != 0u))
+			{
+				unsigned long long start = (Sim_Model.shiftEnd > Sim_Now) ? Sim_Model.shiftEnd : Sim_Now;
+				Sim_Model.shiftByte = Sim_Model.txFifo[0];
+				for (index = 1u; index < Sim_Model.txCount; index++)
+				{
+					Sim_Model.txFifo[index - 1u] = Sim_Model.txFifo[index];
+				}
+				Sim_Model.txCount--;
+				Sim_Model.shifting = 1u;
+				Sim_Model.shiftEnd = start + SIM_CHAR_NS;
+				Sim_Model.idleAt = ~0ull;
+				progress = 1u;
+			}
+
+			/* 4. Idle line after the configured number of idle characters */
+			if ((Sim_Model.shifting == 0u) && (Sim_Now >= Sim_Model.idleAt))
+			{
+				Sim_Model.flags |= (1u << LPUART_STAT_IDLE_SHIFT);
+				Sim_Model.idleAt = ~0ull;
+			}
+		}
+}
+
+
+/*==================================================================================================
+*                                       CLOCK, CLOCKGATE AND DMA MODEL
+==================================================================================================*/
+unsigned int Clock_GetPccFunctionalFreq(clock_names_t clockName)
+{
+		(void)clockName;
+		return SIM_FUNC_HZ;
+}
+
+ClockGate_ret_t ClockGate_Request(clock_names_t clockName, peripheral_clock_source_t clkSrc)
+{
+		(void)clockName;
+		(void)clkSrc;
+		return CLOCKGATE_OK;
+}
+
+ClockGate_ret_t ClockGate_Release(clock_names_t clockName)
+{
+		(void)clockName;
+		return CLOCKGATE_OK;
+}
+
+void Dma_Init(void)
+{
+}
+
+Dma_ret_t Dma_ConfigChannel(const Dma_ChannelConfigType * ConfigPtr)
+{
+		(void)ConfigPtr;
+		Sim_Model.pending = SIM_PENDING_NONE;          /* &DATA was taken, not accessed */
+		return DMA_OK;
+}
+
+Dma_ret_t Dma_SetTransfer(unsigned char channel, unsigned int srcAddr, unsigned int destAddr, unsigned short majorCount)
+{
+		(void)channel;
+		(void)destAddr;
+		Sim_Model.pending = SIM_PENDING_NONE;          /* &DATA was taken, not accessed */
+		/* The driver passes 32-bit addresses: the upper half comes from the ring storage */
+		Sim_Model.dmaSrc = (unsigned char *)(((uintptr_t)Sim_TxBuffer & ~(uintptr_t)0xFFFFFFFFu) | srcAddr);
+		Sim_Model.dmaLeft = majorCount;
+		return DMA_OK;
+}
+
+void Dma_StartChannel(unsigned char channel)
+{
+		(void)channel;
+		Sim_Model.dmaActive = 1u;
+}
+
+void Dma_StopChannel(unsigned char channel)
+{
+		(void)channel;
+		Sim_Model.dmaActive = 0u;
+}
+
+unsigned char Dma_IsDone(unsigned char channel)
+{
+		(void)channel;
+		return (unsigned char)(Sim_Model.dmaLeft == 0u);
+}
+
+
+/*==================================================================================================
+*                                       LPUART DRIVER
+==================================================================================================*/
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#include "../Driver/src/Lpuart.c"
+#pragma GCC diagnostic pop
+
+#undef DATA
+#undef STAT
+#undef WATER
+
+
+/*==================================================================================================
+*                                       SIMULATION
+==================================================================================================*/
+/*!
+ * @brief Test pattern: a counter modulo a prime, so ring wraps and FIFO shifts show up.
+ */
+static unsigned char Sim_Pattern(unsigned long long index)
+{
+		return (unsigned char)(index % 251u);
+}
+
+/*!
+ * @brief Runs one configuration for a number of milliseconds.
+ */
+static unsigned char Sim_Execute(const char * name, unsigned char txDma, unsigned char txWater,
+                                 unsigned char rxWater, unsigned int ms)
+{
+		Lpuart_ConfigType config =
+		{
+			1u, CLK_SRC_OP_3, SIM_BAUD, LPUART_PARITY_NONE, 0u, rxWater, txWater, 0u,
+			Sim_RxBuffer, SIM_RING_SIZE, Sim_TxBuffer, SIM_RING_SIZE, txDma, 0u, NULL
+		};
+		unsigned long long end = (unsigned long long)ms * 1000000ull;
+		unsigned long long nextApp = 0u;
+		unsigned long long sent = 0u;
+		unsigned long long cycles;
+		Lpuart_StatsType stats;
+		double rate;
+		double load;
+
+		Sim_Model = (Sim_ModelType){ { 0u }, { 0u }, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, ~0ull, 0u, SIM_PENDING_NONE, NULL, 0u, 0u };
+		Sim_Count = (Sim_CountType){ 0u, 0u, 0u, 0u, 0u, 0u };
+		Sim_Now = 0u;
+		Lpuart_Deinit(1u);
+		if (Lpuart_Init(&config) != LPUART_OK)
+		{
+			printf("FAIL: Lpuart_Init\n");
+			return 0u;
+		}
+		Sim_Sync();
+		Sim_Count.regAccesses = 0u;
+
+		while (Sim_Now < end)
+		{
+			unsigned long long next;
+
+			/* 1. Line */
+			Sim_Line();
+
+			/* 2. Interrupt */
+			if (Sim_IrqPending() != 0u)
+			{
+				unsigned long long regs = Sim_Count.regAccesses;
+				unsigned int rxBytes = Lpuart_State[1].rxBytes;
+				unsigned int txBytes = Lpuart_State[1].txBytes;
+				unsigned int moved;
+
+				Lpuart_IrqCommon(1u);
+				Sim_Sync();
+				Sim_Line();
+
+				/* Bytes copied by the CPU; a DMA completion only moves the ring index */
+				moved = Lpuart_State[1].rxBytes - rxBytes;
+				if (txDma == 0u)
+				{
+					moved += Lpuart_State[1].txBytes - txBytes;
+				}
+				Sim_Count.isrs++;
+				Sim_Count.isrBytes += moved;
+				Sim_Now += (unsigned long long)(((double)(SIM_IRQ_CYCLES + SIM_ISR_CYCLES +
+				            ((Sim_Count.regAccesses - regs) * SIM_REG_CYCLES) + (moved * SIM_BYTE_CYCLES)) * 1e9) / SIM_CORE_HZ);
+				continue;
+			}
+
+			/* 3. Application: zero-copy consume and produce */
+			if (Sim_Now >= nextApp)
+			{
+				unsigned char * data;
+				unsigned short length;
+				unsigned short index;
+
+				while ((length = Lpuart_Peek(1u, &data)) != 0u)
+				{
+					for (index = 0u; index < length; index++)
+					{
+						if (data[index] != Sim_Pattern(Sim_Count.received + index))
+						{
+							Sim_Count.errors++;
+						}
+					}
+					Sim_Count.received += length;
+					Lpuart_Consume(1u, length);
+					Sim_Count.calls += 2u;
+				}
+				while ((length = Lpuart_WriteBegin(1u, &data)) != 0u)
+				{
+					for (index = 0u; index < length; index++)
+					{
+						data[index] = Sim_Pattern(sent + index);
+					}
+					sent += length;
+					Lpuart_WriteCommit(1u, length);
+					Sim_Count.calls += 2u;
+				}
+				Sim_Sync();
+				nextApp = Sim_Now + SIM_APP_PERIOD_NS;
+			}
+
+			/* 4. Next event */
+			next = nextApp;
+			if ((Sim_Model.shifting != 0u) && (Sim_Model.shiftEnd < next))
+			{
+				next = Sim_Model.shiftEnd;
+			}
+			if (Sim_Model.idleAt < next)
+			{
+				next = Sim_Model.idleAt;
+			}
+			Sim_Now = (next > Sim_Now) ? next : (Sim_Now + 1u);
+		}
+
+		(void)Lpuart_GetStats(1u, &stats);
+		rate = ((double)Sim_Count.received * 1000.0) / (double)ms;
+		cycles = (Sim_Count.isrs * (SIM_IRQ_CYCLES + SIM_ISR_CYCLES)) + (Sim_Count.regAccesses * SIM_REG_CYCLES) +
+		         (Sim_Count.isrBytes * SIM_BYTE_CYCLES) + (Sim_Count.calls * SIM_CALL_CYCLES);
+		load = ((double)cycles * 100.0) / (SIM_CORE_HZ * ((double)ms / 1000.0));
+
+		printf("%-32s %9.0f B/s %6.2f %% %8.0f irq/s %5.2f B/irq %5.2f reg/B %6.2f %% CPU  err %llu drop %u ovr %u\n",
+		       name, rate, (rate * 100.0) / ((double)SIM_BAUD / 10.0), ((double)Sim_Count.isrs * 1000.0) / (double)ms,
+		       (Sim_Count.isrs != 0u) ? ((double)Sim_Count.isrBytes / (double)Sim_Count.isrs) : 0.0,
+		       (double)Sim_Count.regAccesses / (double)Sim_Count.received, load,
+		       Sim_Count.errors, stats.rxDropped, stats.rxErrors);
+
+		return (unsigned char)((Sim_Count.errors == 0u) && (stats.rxDropped == 0u) && (stats.rxErrors == 0u) &&
+		                       (((rate * 100.0) / ((double)SIM_BAUD / 10.0)) >= SIM_LIMIT_RATE_PERCENT));
+}
+
+
+/*==================================================================================================
+*                                       GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(int argc, char ** argv)
+{
+		unsigned int ms = (argc > 1) ? (unsigned int)atoi(argv[1]) : SIM_DEFAULT_MS;
+		unsigned char pass = 1u;
+
+		printf("%u ms at %u baud 8N1, loopback, rings %u bytes, application every %llu us\n",
+		       ms, SIM_BAUD, SIM_RING_SIZE, SIM_APP_PERIOD_NS / 1000ull);
+		pass &= Sim_Execute("IRQ TX, TX/RX watermark 0/0", 0u, 0u, 0u, ms);
+		pass &= Sim_Execute("IRQ TX, TX/RX watermark 1/2", 0u, 1u, 2u, ms);
+		pass &= Sim_Execute("DMA TX, RX watermark 2", 1u, 1u, 2u, ms);
+
+		if (pass == 0u)
+		{
+			printf("FAIL\n");
+			return 1;
+		}
+		printf("PASS\n");
+		return 0;
+}
@@ -12,6 +12,17 @@
 #include "Utilitie.h"
 
 
+/*==================================================================================================
+*                                       LOCAL VARIABLES
+==================================================================================================*/
+/* CRC-16/CCITT-FALSE, one entry per nibble */
+static const uint16 Crc16_Table[16] =
+{
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu,
+};
+
+
 /*==================================================================================================
 *                                       GLOBAL FUNCTIONS
 ==================================================================================================*/
@@ -32,3 +43,222 @@ void Delay(void)
 {
     for (volatile int i = 0; i < 1000000; i++);  
 }
+
+/**
+ * @brief Ring initialization
+ * @details This function attaches the storage to a ring and empties it.
+ *
+ * @param[in] RingPtr Ring to initialize.
+ * @param[in] buffer Storage.
+ * @param[in] size Storage size, a power of two up to 32768.
+ *
+ * @return 1 on success, 0 when a parameter is invalid.
+**/
+uint8 Ring_Init(Ring_Type * RingPtr, uint8 * buffer, uint16 size)
+{
+    if ((RingPtr == NULL) || (buffer == NULL) || (size == 0u) || (size > 32768u) ||
+        ((size & (uint16)(size - 1u)) != 0u))
+    {
+        return 0u;
+    }
+
+    RingPtr->buffer = buffer;
+    RingPtr->size = size;
+    RingPtr->head = 0u;
+    RingPtr->tail = 0u;
+    return 1u;
+}
+
+/**
+ * @brief Ring fill level
+ *
+ * @param[in] RingPtr Ring.
+ *
+ * @return Bytes written and not consumed yet.
+**/
+uint16 Ring_GetUsed(const Ring_Type * RingPtr)
+{
+    return (uint16)(RingPtr->head - RingPtr->tail);
+}
+
+/**
+ * @brief Ring free space
+ *
+ * @param[in] RingPtr Ring.
+ *
+ * @return Bytes that can still be written.
+**/
+uint16 Ring_GetFree(const Ring_Type * RingPtr)
+{
+    return (uint16)(RingPtr->size - Ring_GetUsed(RingPtr));
+}
+
+/**
+ * @brief Contiguous free space (producer side)
+ * @details The producer writes up to the returned count at *DataPtr and then calls Ring_Commit().
+ *
+ * @param[in] RingPtr Ring.
+ * @param[out] DataPtr First free byte.
+ *
+ * @return Bytes that can be written without wrapping.
+**/
+uint16 Ring_WriteLinear(const Ring_Type * RingPtr, uint8 ** DataPtr)
+{
+    uint16 offset = (uint16)(RingPtr->head & (uint16)(RingPtr->size - 1u));
+    uint16 linear = (uint16)(RingPtr->size - offset);
+    uint16 space = Ring_GetFree(RingPtr);
+
+    *DataPtr = &RingPtr->buffer[offset];
+    return (space < linear) ? space : linear;
+}
+
+/**
+ * @brief Publish written bytes (producer side)
+ *
+ * @param[in] RingPtr Ring.
+ * @param[in] count Bytes written, at most the value returned by Ring_WriteLinear().
+ *
+ * @return void
+**/
+void Ring_Commit(Ring_Type * RingPtr, uint16 count)
+{
+    RingPtr->head = (uint16)(RingPtr->head + count);
+}
+
+/**
+ * @brief Contiguous readable data (consumer side)
+ * @details The consumer reads up to the returned count at *DataPtr and then calls Ring_Consume().
+ *
+ * @param[in] RingPtr Ring.
+ * @param[out] DataPtr First unread byte.
+ *
+ * @return Bytes that can be read without wrapping.
+**/
+uint16 Ring_PeekLinear(const Ring_Type * RingPtr, uint8 ** DataPtr)
+{
+    uint16 offset = (uint16)(RingPtr->tail & (uint16)(RingPtr->size - 1u));
+    uint16 linear = (uint16)(RingPtr->size - offset);
+    uint16 used = Ring_GetUsed(RingPtr);
+
+    *DataPtr = &RingPtr->buffer[offset];
+    return (used < linear) ? used : linear;
+}
+
+/**
+ * @brief Release read bytes (consumer side)
+ *
+ * @param[in] RingPtr Ring.
+ * @param[in] count Bytes read, at most the value returned by Ring_GetUsed().
+ *
+ * @return void
+**/
+void Ring_Consume(Ring_Type * RingPtr, uint16 count)
+{
+    RingPtr->tail = (uint16)(RingPtr->tail + count);
+}
+
+/**
+ * @brief COBS encoding
+ * @details This function encodes a buffer with Consistent Overhead Byte Stuffing, so that the
+ *          output contains no zero byte, and appends the zero delimiter.
+ *
+ * @param[in] SrcPtr Data to encode.
+ * @param[in] length Number of bytes.
+ * @param[out] DestPtr Output, at least COBS_MAX_ENCODED(length) bytes.
+ *
+ * @return Encoded length, delimiter included.
+**/
+uint16 Cobs_Encode(const uint8 * SrcPtr, uint16 length, uint8 * DestPtr)
+{
+    uint16 read;
+    uint16 write = 1u;
+    uint16 codeIndex = 0u;
+    uint8 code = 1u;
+
+    for (read = 0u; read < length; read++)
+    {
+        if (SrcPtr[read] == 0u)
+        {
+            DestPtr[codeIndex] = code;
+            codeIndex = write++;
+            code = 1u;
+            continue;
+        }
+        DestPtr[write++] = SrcPtr[read];
+        code++;
+        if (code == COBS_MAX_CODE)
+        {
+            DestPtr[codeIndex] = code;
+            codeIndex = write++;
+            code = 1u;
+        }
+    }
+    DestPtr[codeIndex] = code;
+    DestPtr[write++] = COBS_DELIMITER;
+
+    return write;
+}
+
+/**
+ * @brief COBS decoding in place
+ * @details This function decodes a COBS frame, delimiter excluded. The write position never
+ *          passes the read position, so the output overwrites the input.
+ *
+ * @param[in,out] DataPtr Encoded frame, replaced by the decoded data.
+ * @param[in] length Encoded length.
+ *
+ * @return Decoded length, 0 when the encoding is invalid.
+**/
+uint16 Cobs_Decode(uint8 * DataPtr, uint16 length)
+{
+    uint16 read = 0u;
+    uint16 write = 0u;
+    uint8 code;
+    uint8 index;
+
+    while (read < length)
+    {
+        code = DataPtr[read++];
+        if (code == 0u)
+        {
+            return 0u;
+        }
+        for (index = 1u; index < code; index++)
+        {
+            if (read >= length)
+            {
+                return 0u;
+            }
+            DataPtr[write++] = DataPtr[read++];
+        }
+        if ((code != COBS_MAX_CODE) && (read < length))
+        {
+            DataPtr[write++] = 0u;
+        }
+    }
+
+    return write;
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE
+ * @details This function computes the CRC of a buffer, one nibble per table lookup.
+ *
+ * @param[in] DataPtr Data.
+ * @param[in] length Number of bytes.
+ *
+ * @return CRC, polynomial 0x1021, initial value 0xFFFF.
+**/
+uint16 Crc16_Compute(const uint8 * DataPtr, uint16 length)
+{
+    uint16 crc = 0xFFFFu;
+    uint16 index;
+
+    for (index = 0u; index < length; index++)
+    {
+        crc = (uint16)((crc << 4u) ^ Crc16_Table[(crc >> 12u) ^ (DataPtr[index] >> 4u)]);
+        crc = (uint16)((crc << 4u) ^ Crc16_Table[(crc >> 12u) ^ (DataPtr[index] & 0x0Fu)]);
+    }
+
+    return crc;
+}
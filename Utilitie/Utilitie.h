@@ -22,12 +22,66 @@ typedef signed int int32;					/* Define int32 use interchangeably for signed int
 typedef unsigned char uint8;			/* Define uint8 use interchangeably for unsigned char */
 typedef unsigned short uint16;	  /* Define uint16 use interchangeably for unsigned short */
 typedef unsigned int uint32;			/* Define uint32 use interchangeably for unsigned int, long */
+typedef signed long long int64;		/* Define int64 use interchangeably for signed long long */
+typedef unsigned long long uint64;	/* Define uint64 use interchangeably for unsigned long long */
 
 /*------------------------ Basic bit masking ------------------------*/
-#define SET_BIT(REG, VALUE, BIT)     ((REG) |= (VALUE << BIT))		/* Set bit in register */
-#define CLEAR_BIT(REG, VALUE, BIT)   ((REG) &= ~(VALUE << BIT))		/* Clear bit in register */
-#define TOGGLE_BIT(REG, VALUE, BIT)   ((REG) ^= (VALUE << BIT))		/* Toggle bit in register */
-#define CHECK_BIT(REG, BIT)   ((REG >> BIT) & 0x01)								/* Check bit in register */
+#define SET_BIT(REG, VALUE, BIT)     ((REG) |= ((VALUE) << (BIT)))		/* Set bit in register */
+#define CLEAR_BIT(REG, VALUE, BIT)   ((REG) &= ~((VALUE) << (BIT)))		/* Clear bit in register */
+#define TOGGLE_BIT(REG, VALUE, BIT)   ((REG) ^= ((VALUE) << (BIT)))		/* Toggle bit in register */
+#define CHECK_BIT(REG, BIT)   (((REG) >> (BIT)) & 0x01)								/* Check bit in register */
+
+/*------------------------ Register field descriptors ------------------------*/
+/* A field is written (SHIFT, WIDTH, ACCESS) in the register header, e.g.
+       #define PORT_PCR_MUX   (8u, 3u, FIELD_RW)
+   REG_UPDATE() folds every FIELD_SET() into one mask and one value: one read and one write of
+   the register, and no code at all for the mask when the values are constants.
+       REG_UPDATE(PORTC->PCR[12], PORT_PCR_W1C, FIELD_SET(PORT_PCR_MUX, 1u), FIELD_SET(PORT_PCR_PE, 0u));
+   Write-1-to-clear flags read as 1 would be cleared by writing the value back: pass their mask
+   as W1C so that they are written as 0. Up to 8 fields per access. */
+#define FIELD_RW    (0u)   									/* Read / write */
+#define FIELD_RO    (1u)   									/* Read only: FIELD_SET() does not compile */
+#define FIELD_W1C   (2u)   									/* Write 1 to clear, part of the register W1C mask */
+#define FIELD_W1S   (3u)   									/* Write 1 to set, 0 has no effect */
+#define FIELD_RC    (4u)   									/* Cleared by reading: write the register with REG_WRITE() */
+
+#define FIELD_SHIFT(F)    FIELD_SHIFT_ F											/* Position of the lowest bit */
+#define FIELD_WIDTH(F)    FIELD_WIDTH_ F											/* Number of bits, 1 - 32 */
+#define FIELD_ACCESS(F)   FIELD_ACCESS_ F										/* FIELD_RW, FIELD_RO, ... */
+#define FIELD_SHIFT_(SHIFT, WIDTH, ACCESS)    (SHIFT)
+#define FIELD_WIDTH_(SHIFT, WIDTH, ACCESS)    (WIDTH)
+#define FIELD_ACCESS_(SHIFT, WIDTH, ACCESS)   (ACCESS)
+
+#define FIELD_MASK(F)       ((0xFFFFFFFFu >> (32u - FIELD_WIDTH(F))) << FIELD_SHIFT(F))		/* Field bits in place */
+#define FIELD_GET(VALUE, F)   (((uint32)(VALUE) & FIELD_MASK(F)) >> FIELD_SHIFT(F))			/* Field of a register value */
+#define FIELD_WRITABLE(F)   ((uint32)(0u * sizeof(char[(FIELD_ACCESS(F) != FIELD_RO) ? 1 : -1])))	/* 0, or a compile error */
+#define FIELD_VAL(F, V)     ((((uint32)(V) << FIELD_SHIFT(F)) & FIELD_MASK(F)) + FIELD_WRITABLE(F))	/* Value in place, truncated to the width */
+#define FIELD_SET(F, V)     (FIELD_MASK(F), FIELD_VAL(F, V))						/* Mask and value of one field */
+
+#define FIELDS_MASK(...)    FIELDS_OR(FIELDS_PAIR_MASK, __VA_ARGS__)			/* Mask of several FIELD_SET() */
+#define FIELDS_VAL(...)     FIELDS_OR(FIELDS_PAIR_VAL, __VA_ARGS__)				/* Value of several FIELD_SET() */
+#define FIELDS_APPLY(VALUE, ...)   (((uint32)(VALUE) & ~FIELDS_MASK(__VA_ARGS__)) | FIELDS_VAL(__VA_ARGS__))	/* Register value with the fields replaced */
+
+#define REG_UPDATE(REG, W1C, ...)   ((REG) = FIELDS_APPLY((REG) & ~(uint32)(W1C), __VA_ARGS__))	/* One read, one write */
+#define REG_WRITE(REG, ...)         ((REG) = FIELDS_VAL(__VA_ARGS__))			/* One write, the other fields 0 */
+
+#define FIELDS_PAIR_MASK(P)   FIELDS_PAIR_MASK_ P
+#define FIELDS_PAIR_VAL(P)    FIELDS_PAIR_VAL_ P
+#define FIELDS_PAIR_MASK_(MASK, VALUE)   (MASK)
+#define FIELDS_PAIR_VAL_(MASK, VALUE)    (VALUE)
+#define FIELDS_CAT(A, B)    FIELDS_CAT_(A, B)
+#define FIELDS_CAT_(A, B)   A##B
+#define FIELDS_COUNT(...)   FIELDS_COUNT_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define FIELDS_COUNT_(A1, A2, A3, A4, A5, A6, A7, A8, N, ...)   N
+#define FIELDS_OR(OP, ...)  FIELDS_CAT(FIELDS_OR_, FIELDS_COUNT(__VA_ARGS__))(OP, __VA_ARGS__)
+#define FIELDS_OR_1(OP, P)        OP(P)
+#define FIELDS_OR_2(OP, P, ...)   (OP(P) | FIELDS_OR_1(OP, __VA_ARGS__))
+#define FIELDS_OR_3(OP, P, ...)   (OP(P) | FIELDS_OR_2(OP, __VA_ARGS__))
+#define FIELDS_OR_4(OP, P, ...)   (OP(P) | FIELDS_OR_3(OP, __VA_ARGS__))
+#define FIELDS_OR_5(OP, P, ...)   (OP(P) | FIELDS_OR_4(OP, __VA_ARGS__))
+#define FIELDS_OR_6(OP, P, ...)   (OP(P) | FIELDS_OR_5(OP, __VA_ARGS__))
+#define FIELDS_OR_7(OP, P, ...)   (OP(P) | FIELDS_OR_6(OP, __VA_ARGS__))
+#define FIELDS_OR_8(OP, P, ...)   (OP(P) | FIELDS_OR_7(OP, __VA_ARGS__))
 
 #define VALUE_CHECK_BIT   (0x01u)																	/* Value check bit in register */
 #define RESET   					(0u)																		/* Reset value */
@@ -103,12 +157,50 @@ typedef unsigned int uint32;			/* Define uint32 use interchangeably for unsigned
 /*------------------------  NULL Definition ------------------------*/
 #define NULL   ((void *) 0)  									/* Definition of NULL as a null pointer constant */
 
+/*------------------------  Compile-time check ------------------------*/
+#define STATIC_ASSERT(COND, NAME)   typedef char static_assert_##NAME[(COND) ? 1 : -1]	/* Fails to compile when COND is false */
+
+/*------------------------  COBS framing ------------------------*/
+#define COBS_MAX_CODE   (0xFFu)   									/* Block of 254 data bytes, no zero follows */
+#define COBS_DELIMITER  (0x00u)   									/* Frame delimiter */
+#define COBS_MAX_ENCODED(LEN)   ((LEN) + ((LEN) / 254u) + 2u)	/* Encoded size with the delimiter */
+
 /*------------------------  Value Number Definition ------------------------*/
 #define VALUE_ZERO   (0u)  						/* Definition of VALUE_ZERO as zero (unsigned) */
 
+/*==================================================================================================
+*                                STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief   Single-producer single-consumer byte ring.
+ * @details head is only written by the producer and tail only by the consumer, so one side may
+ *          run in an interrupt without a lock. Both indexes run freely and wrap at 65536; the
+ *          size must be a power of two, at most 32768.
+ */
+typedef struct
+{
+    uint8 *           buffer;       /*!< Storage */
+    uint16            size;         /*!< Storage size in bytes, a power of two */
+    volatile uint16   head;         /*!< Next byte written by the producer */
+    volatile uint16   tail;         /*!< Next byte read by the consumer */
+} Ring_Type;
+
 /*==================================================================================================
 *                                    FUNCTION PROTOTYPES
 ==================================================================================================*/
 extern void Delay(void);
 
+extern uint8 Ring_Init(Ring_Type * RingPtr, uint8 * buffer, uint16 size);
+extern uint16 Ring_GetUsed(const Ring_Type * RingPtr);
+extern uint16 Ring_GetFree(const Ring_Type * RingPtr);
+extern uint16 Ring_WriteLinear(const Ring_Type * RingPtr, uint8 ** DataPtr);
+extern void Ring_Commit(Ring_Type * RingPtr, uint16 count);
+extern uint16 Ring_PeekLinear(const Ring_Type * RingPtr, uint8 ** DataPtr);
+extern void Ring_Consume(Ring_Type * RingPtr, uint16 count);
+
+extern uint16 Cobs_Encode(const uint8 * SrcPtr, uint16 length, uint8 * DestPtr);
+extern uint16 Cobs_Decode(uint8 * DataPtr, uint16 length);
+
+extern uint16 Crc16_Compute(const uint8 * DataPtr, uint16 length);
+
 #endif /* Utilitie */